@@ -20,6 +20,18 @@
 #include "qtcompat/qtextstreamcompat.h"
 #include "qtcompat/splitbehaviorcompat.h"
 #include "utilsns.h"
+#include "assetarchive.h"
+#include "performancecounters.h"
+#include "tracelogger.h"
+#include "objectcensus.h"
+#include "codecachestore.h"
+#include "catalog.h"
+#include <QDir>
+#include <QProcess>
+#include <QFileSystemWatcher>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QtConcurrent/QtConcurrent>
 
 QTextStream PgModelerCliApp::out(stdout);
 
@@ -69,6 +81,8 @@ const QString PgModelerCliApp::IgnoreImportErrors("--ignore-errors");
 const QString PgModelerCliApp::ImportSystemObjs("--import-sys-objs");
 const QString PgModelerCliApp::ImportExtensionObjs("--import-ext-objs");
 const QString PgModelerCliApp::DebugMode("--debug-mode");
+const QString PgModelerCliApp::ImportStats("--import-stats");
+const QString PgModelerCliApp::ImportJobs("--jobs");
 const QString PgModelerCliApp::FilterObjects("--filter-objects");
 const QString PgModelerCliApp::MatchByName("--match-by-name");
 const QString PgModelerCliApp::ForceChildren("--force-children");
@@ -91,6 +105,18 @@ const QString PgModelerCliApp::NoCascadeDrop("--no-cascade");
 const QString PgModelerCliApp::ForceRecreateObjs("--force-recreate-objs");
 const QString PgModelerCliApp::OnlyUnmodifiable("--only-unmodifiable");
 const QString PgModelerCliApp::CreateConfigs("--create-configs");
+const QString PgModelerCliApp::PackAssets("--pack-assets");
+const QString PgModelerCliApp::Watch("--watch");
+const QString PgModelerCliApp::JsonProgress("--json-progress");
+const QString PgModelerCliApp::MaxMemory("--max-memory");
+const QString PgModelerCliApp::PerfCounters("--perf-counters");
+const QString PgModelerCliApp::Trace("--trace");
+const QString PgModelerCliApp::CodeCache("--code-cache");
+const QString PgModelerCliApp::Benchmark("--benchmark");
+const QString PgModelerCliApp::BenchTables("--tables");
+const QString PgModelerCliApp::BenchColumns("--columns");
+const QString PgModelerCliApp::BenchRels("--relationships");
+const QString PgModelerCliApp::BenchRepeat("--repetitions");
 const QString PgModelerCliApp::MissingOnly("--missing-only");
 
 const QString PgModelerCliApp::TagExpr("<%1");
@@ -114,14 +140,18 @@ attribs_map PgModelerCliApp::short_opts = {
 	{ ZoomFactor, "-zf" },	{ UseTmpNames, "-tn" },	{ DbmMimeType, "-mt" },
 	{ IgnoreImportErrors, "-ie" },	{ ImportSystemObjs, "-is" },	{ ImportExtensionObjs, "-ix" },
 	{ FilterObjects, "-fo" },	{ MatchByName, "-mn" },	{ ForceChildren, "-fc" },
-	{ OnlyMatching, "-om" },	{ DebugMode, "-d" },	{ PartialDiff, "-pd" },
+	{ OnlyMatching, "-om" },	{ DebugMode, "-d" },	{ ImportStats, "-it" },	{ ImportJobs, "-jb" },	{ PartialDiff, "-pd" },
 	{ StartDate, "-st" },	{ EndDate, "-et" },	{ CompareTo, "-ct" },
 	{ SaveDiff, "-sd" },	{ ApplyDiff, "-ad" },	{ NoDiffPreview, "-np" },
 	{ DropClusterObjs, "-dc" },	{ RevokePermissions, "-rv" },	{ DropMissingObjs, "-dm" },
 	{ ForceDropColsConstrs, "-fd" },	{ RenameDb, "-rn" },
 	{ NoSequenceReuse, "-ns" },	{ NoCascadeDrop, "-nd" },	{ ForceRecreateObjs, "-nf" },
 	{ OnlyUnmodifiable, "-nu" },	{ NoIndex, "-ni" },	{ Split, "-sp" },
-	{ SystemWide, "-sw" },	{ CreateConfigs, "-cc" }, { Force, "-ff" }, { MissingOnly, "-mo" }
+	{ SystemWide, "-sw" },	{ CreateConfigs, "-cc" }, { Force, "-ff" }, { MissingOnly, "-mo" },	{ PackAssets, "-pa" },
+	{ Watch, "-wm" },	{ JsonProgress, "-jp" },	{ MaxMemory, "-mm" },	{ PerfCounters, "-pf" },	{ Trace, "-tc" },
+	{ CodeCache, "-gc" },
+	{ Benchmark, "-bm" },	{ BenchTables, "-tb" },	{ BenchColumns, "-cl" },
+	{ BenchRels, "-rl" },	{ BenchRepeat, "-rp" }
 };
 
 map<QString, bool> PgModelerCliApp::long_opts = {
@@ -137,7 +167,7 @@ map<QString, bool> PgModelerCliApp::long_opts = {
 	{ FixTries, true },	{ ZoomFactor, true },	{ UseTmpNames, false },
 	{ DbmMimeType, true },	{ IgnoreImportErrors, false },	{ ImportSystemObjs, false },
 	{ ImportExtensionObjs, false },	{ FilterObjects, true },	{ ForceChildren, true },
-	{ OnlyMatching, false },	{ MatchByName, false },	{ DebugMode, false },
+	{ OnlyMatching, false },	{ MatchByName, false },	{ DebugMode, false },	{ ImportStats, true },	{ ImportJobs, true },
 	{ PartialDiff, false },	{ StartDate, true },	{ EndDate, true },
 	{ CompareTo, true },	{ SaveDiff, false },	{ ApplyDiff, false },
 	{ NoDiffPreview, false },	{ DropClusterObjs, false },	{ RevokePermissions, false },
@@ -145,32 +175,38 @@ map<QString, bool> PgModelerCliApp::long_opts = {
 	{ NoSequenceReuse, false },	{ NoCascadeDrop, false },
 	{ ForceRecreateObjs, false },	{ OnlyUnmodifiable, false },	{ ExportToDict, false },
 	{ NoIndex, false },	{ Split, false },	{ SystemWide, false },
-	{ CreateConfigs, false }, { Force, false }, { MissingOnly, false }
+	{ CreateConfigs, false }, { Force, false }, { MissingOnly, false },	{ PackAssets, false },
+	{ Watch, false },	{ JsonProgress, false },	{ MaxMemory, true },	{ PerfCounters, false },	{ Trace, true },
+	{ CodeCache, false },
+	{ Benchmark, false },	{ BenchTables, true },	{ BenchColumns, true },
+	{ BenchRels, true },	{ BenchRepeat, true }
 };
 
 map<QString, QStringList> PgModelerCliApp::accepted_opts = {
 	{{ Attributes::Connection }, { ConnAlias, Host, Port, User, Passwd, InitialDb }},
-	{{ ExportToFile }, { Input, Output, PgSqlVer, Split }},
-	{{ ExportToPng },  { Input, Output, ShowGrid, ShowDelimiters, PageByPage, ZoomFactor }},
-	{{ ExportToSvg },  { Input, Output, ShowGrid, ShowDelimiters }},
-	{{ ExportToDict }, { Input, Output, Split, NoIndex }},
+	{{ ExportToFile }, { Input, Output, PgSqlVer, Split, ImportJobs, Watch, JsonProgress, MaxMemory, PerfCounters, Trace, CodeCache }},
+	{{ ExportToPng },  { Input, Output, ShowGrid, ShowDelimiters, PageByPage, ZoomFactor, ImportJobs, Watch, JsonProgress, MaxMemory, PerfCounters, Trace }},
+	{{ ExportToSvg },  { Input, Output, ShowGrid, ShowDelimiters, ImportJobs, Watch, JsonProgress, MaxMemory, PerfCounters, Trace }},
+	{{ ExportToDict }, { Input, Output, Split, NoIndex, ImportJobs, Watch, JsonProgress, MaxMemory, PerfCounters, Trace, CodeCache }},
 
 	{{ ExportToDbms }, { Input, PgSqlVer, IgnoreDuplicates, IgnoreErrorCodes,
-											 DropDatabase, DropObjects, Simulate, UseTmpNames }},
+											 DropDatabase, DropObjects, Simulate, UseTmpNames, Watch, JsonProgress, MaxMemory, PerfCounters, Trace, CodeCache }},
 
 	{{ ImportDb }, { InputDb, Output, IgnoreImportErrors, ImportSystemObjs, ImportExtensionObjs,
-									 FilterObjects, OnlyMatching, MatchByName, ForceChildren, DebugMode, ConnAlias,
-									 Host, Port, User, Passwd, InitialDb }},
+									 FilterObjects, OnlyMatching, MatchByName, ForceChildren, DebugMode, ImportStats,
+									 ImportJobs, ConnAlias, Host, Port, User, Passwd, InitialDb, JsonProgress, MaxMemory, PerfCounters, Trace }},
 
 	{{ Diff }, { Input, PgSqlVer, IgnoreDuplicates, IgnoreErrorCodes, CompareTo, PartialDiff, Force,
 							 StartDate, EndDate, SaveDiff, ApplyDiff, NoDiffPreview, DropClusterObjs, RevokePermissions,
 							 DropMissingObjs, ForceDropColsConstrs, RenameDb, NoCascadeDrop,
-							 NoSequenceReuse, ForceRecreateObjs, OnlyUnmodifiable }},
+							 NoSequenceReuse, ForceRecreateObjs, OnlyUnmodifiable, ImportJobs, Watch, JsonProgress, MaxMemory, PerfCounters, Trace, CodeCache }},
 
 	{{ DbmMimeType }, { SystemWide, Force }},
-	{{ FixModel },	{ Input, Output, FixTries }},
+	{{ FixModel },	{ Input, Output, FixTries, ImportJobs, Watch }},
 	{{ ListConns }, {}},
-	{{ CreateConfigs }, {MissingOnly, Force}}
+	{{ CreateConfigs }, {MissingOnly, Force}},
+	{{ PackAssets }, { Input, Output }},
+	{{ Benchmark }, { BenchTables, BenchColumns, BenchRels, BenchRepeat, JsonProgress, PerfCounters, Trace }}
 };
 
 PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv)
@@ -193,6 +229,11 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 		conn_conf = nullptr;
 		rel_conf = nullptr;
 		general_conf = nullptr;
+		json_progress = false;
+		max_memory = 0;
+		mem_budget_warned = false;
+		last_progress = 0;
+		phase_obj_count = 0;
 
 		// We extract the options values only if the help option is not present
 		if(args.size() > 1 && !args.contains(Help) && !args.contains(short_opts[Help]))
@@ -240,6 +281,34 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 			model=new DatabaseModel;
 			xmlparser=model->getXMLParser();
 			silent_mode=(parsed_opts.count(Silent));
+			json_progress=(parsed_opts.count(JsonProgress));
+
+			/* In json progress mode the human readable messages are suppressed so the standard
+			 * output carries only the newline delimited json records */
+			if(json_progress)
+				silent_mode=true;
+
+			//The memory budget is informed in megabytes but handled internally in kilobytes
+			if(parsed_opts.count(MaxMemory))
+				max_memory=parsed_opts[MaxMemory].toLongLong() * 1024;
+
+			/* Enabling the counter recording and the live object census before the operation
+			 * starts so the whole run is covered */
+			if(parsed_opts.count(PerfCounters))
+			{
+				PerformanceCounters::setEnabled(true);
+				ObjectCensus::setEnabled(true);
+				Catalog::setQueryLogEnabled(true);
+			}
+
+			//Starting the structured tracing before the operation so the trace covers all its phases
+			if(parsed_opts.count(Trace))
+				TraceLogger::start(parsed_opts[Trace]);
+
+			/* Enabling the persistent code cache so the definitions of unchanged objects are
+			 * fetched from disk instead of being regenerated by the schema parser */
+			if(parsed_opts.count(CodeCache))
+				CodeCacheStore::setEnabled(true);
 
 			//If the export is to png or svg loads additional configurations
 			if(parsed_opts.count(ExportToPng) || parsed_opts.count(ExportToSvg) || parsed_opts.count(ImportDb))
@@ -260,7 +329,10 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 				BaseObjectView::loadObjectsStyle();
 			}
 
-			if(parsed_opts.count(ExportToDbms) || parsed_opts.count(ImportDb) || parsed_opts.count(Diff))
+			/* Diffing two model files doesn't involve any database so the connection
+			 configuration is skipped entirely in that case */
+			if(parsed_opts.count(ExportToDbms) || parsed_opts.count(ImportDb) ||
+				 (parsed_opts.count(Diff) && !isCompareToModelFile()))
 			{
 				configureConnection(false);
 
@@ -269,7 +341,7 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 					connection.setConnectionParam(Connection::ParamDbName, parsed_opts[InputDb]);
 			}
 
-			if(parsed_opts.count(Diff))
+			if(parsed_opts.count(Diff) && !isCompareToModelFile())
 			{
 				configureConnection(true);
 
@@ -279,12 +351,12 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 				extra_connection.setConnectionParam(Connection::ParamDbName, parsed_opts[CompareTo]);
 			}
 
-			if(!silent_mode && export_hlp && import_hlp && diff_hlp)
+			if((!silent_mode || json_progress) && export_hlp && import_hlp && diff_hlp)
 			{
 				connect(export_hlp, SIGNAL(s_progressUpdated(int,QString)), this, SLOT(updateProgress(int,QString)));
 				connect(export_hlp, SIGNAL(s_errorIgnored(QString,QString,QString)), this, SLOT(printIgnoredError(QString,QString,QString)));
-				connect(import_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString)));
-				connect(diff_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString)));
+				connect(import_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString,ObjectType)));
+				connect(diff_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString,ObjectType)));
 			}
 		}
 	}
@@ -331,6 +403,97 @@ void PgModelerCliApp::printMessage(const QString &txt)
 		printText(txt);
 }
 
+void PgModelerCliApp::printJsonEvent(const QString &event, QJsonObject fields)
+{
+	fields["event"] = event;
+	fields["ts"] = QDateTime::currentDateTime().toString(Qt::ISODateWithMs);
+	printText(QString(QJsonDocument(fields).toJson(QJsonDocument::Compact)));
+}
+
+void PgModelerCliApp::finishJsonPhase()
+{
+	QJsonObject evt;
+
+	if(curr_phase.isEmpty())
+		return;
+
+	evt["phase"] = curr_phase;
+	evt["objects"] = static_cast<int>(phase_obj_count);
+	evt["duration-ms"] = phase_timer.elapsed();
+	evt["mem-peak-kb"] = getMemoryPeak();
+	printJsonEvent("phase-finished", evt);
+
+	curr_phase.clear();
+	last_progress = 0;
+	phase_obj_count = 0;
+}
+
+qint64 PgModelerCliApp::getMemoryPeak()
+{
+	qint64 mem_peak = 0;
+
+#ifdef Q_OS_LINUX
+	/* The process memory high-water mark is exposed by the kernel in the VmHWM
+	 * field of /proc/self/status, in kilobytes */
+	QFile status_file(QString("/proc/self/status"));
+
+	if(status_file.open(QFile::ReadOnly))
+	{
+		QRegExp regexp("VmHWM:\\s*([0-9]+)");
+
+		if(regexp.indexIn(status_file.readAll()) >= 0)
+			mem_peak = regexp.cap(1).toLongLong();
+	}
+#endif
+
+	return mem_peak;
+}
+
+qint64 PgModelerCliApp::getMemoryUsage()
+{
+	qint64 mem_usage = 0;
+
+#ifdef Q_OS_LINUX
+	/* The process current resident memory is exposed by the kernel in the VmRSS
+	 * field of /proc/self/status, in kilobytes */
+	QFile status_file(QString("/proc/self/status"));
+
+	if(status_file.open(QFile::ReadOnly))
+	{
+		QRegExp regexp("VmRSS:\\s*([0-9]+)");
+
+		if(regexp.indexIn(status_file.readAll()) >= 0)
+			mem_usage = regexp.cap(1).toLongLong();
+	}
+#endif
+
+	return mem_usage;
+}
+
+void PgModelerCliApp::checkMemoryBudget()
+{
+	if(max_memory <= 0 || mem_budget_warned)
+		return;
+
+	qint64 mem_usage = getMemoryUsage();
+
+	//The budget can't be checked on systems where the memory usage can't be retrieved
+	if(mem_usage <= 0 || mem_usage <= max_memory)
+		return;
+
+	mem_budget_warned = true;
+
+	if(json_progress)
+	{
+		QJsonObject evt;
+		evt["mem-usage-kb"] = mem_usage;
+		evt["mem-budget-kb"] = max_memory;
+		printJsonEvent("memory-budget-exceeded", evt);
+	}
+	else
+		printText(tr("** WARNING: the process memory usage (%1 KB) exceeded the budget of %2 KB provided through `%3'!").arg(mem_usage).arg(max_memory).arg(MaxMemory));
+}
+
 void PgModelerCliApp::configureConnection(bool extra_conn)
 {
 	QString chr = (extra_conn ? "1" : "");
@@ -411,6 +574,8 @@ void PgModelerCliApp::showMenu()
 	printText(tr("  %1, %2\t\t\t    Compares a model and a database or two databases generating the SQL script to sync the latter in relation to the first.").arg(short_opts[Diff]).arg(Diff));
 	printText(tr("  %1, %2\t\t    Try to fix the structure of the input model file in order to make it loadable again.").arg(short_opts[FixModel]).arg(FixModel));
 	printText(tr("  %1, %2\t\t    Create the pgModeler's configuration folder and files in the user's local storage.").arg(short_opts[CreateConfigs]).arg(CreateConfigs));
+	printText(tr("  %1, %2\t\t    Run a benchmark that generates a synthetic model and measures the main operations over it.").arg(short_opts[Benchmark]).arg(Benchmark));
+	printText(tr("  %1, %2\t\t    Pack the runtime assets under the input directory into a single indexed archive file.").arg(short_opts[PackAssets]).arg(PackAssets));
 #ifndef Q_OS_MAC
 	printText(tr("  %1, %2 [ACTION]\t    Handles the file association to .dbm files. The ACTION can be [%3 | %4].").arg(short_opts[DbmMimeType]).arg(DbmMimeType).arg(Install).arg(Uninstall));
 #endif
@@ -418,11 +583,17 @@ void PgModelerCliApp::showMenu()
 	printText();
 
 	printText(tr("General options: "));
-	printText(tr("  %1, %2 [FILE]\t\t    Input model file (.dbm). This is mandatory for export and fix operations.").arg(short_opts[Input]).arg(Input));
-	printText(tr("  %1, %2 [DBNAME]\t    Input database name. This is mandatory for import operation.").arg(short_opts[InputDb]).arg(InputDb));
+	printText(tr("  %1, %2 [FILE]\t\t    Input model file (.dbm). This is mandatory for export and fix operations. A comma separated list of files (wildcards accepted) can be provided, in this case the output must be a directory and the files are handled in parallel jobs (see %3).").arg(short_opts[Input]).arg(Input).arg(ImportJobs));
+	printText(tr("  %1, %2 [DBNAME]\t    Input database name. This is mandatory for import operation. A comma separated list of databases can be provided to run a batch import, in this case the output must be a directory.").arg(short_opts[InputDb]).arg(InputDb));
 	printText(tr("  %1, %2 [FILE|DIRECTORY]    Output file or directory. This is mandatory for fixing model or exporting to file, png or svg.").arg(short_opts[Output]).arg(Output));
 	printText(tr("  %1, %2\t\t    Force the PostgreSQL syntax to the specified version when generating SQL code. The version string must be in form major.minor.").arg(short_opts[PgSqlVer]).arg(PgSqlVer));
 	printText(tr("  %1, %2\t\t\t    Silent execution. Only critical messages and errors are shown during process.").arg(short_opts[Silent]).arg(Silent));
+	printText(tr("  %1, %2\t\t\t    Stay resident after the operation watching the input model file and re-running the operation whenever the file changes.").arg(short_opts[Watch]).arg(Watch));
+	printText(tr("  %1, %2\t\t    Print the operation progress as a stream of newline delimited JSON records carrying phases, object counts, timings and peak memory usage. Human readable messages are suppressed.").arg(short_opts[JsonProgress]).arg(JsonProgress));
+	printText(tr("  %1, %2 [NUMBER]\t    Memory budget in megabytes. Large intermediate buffers (currently the diff script) are spilled to temporary files and a warning is emitted if the process exceeds the budget.").arg(short_opts[MaxMemory]).arg(MaxMemory));
+	printText(tr("  %1, %2\t\t    Record internal performance counters (schema parsing, code generation, catalog queries) and a live object census during the operation and dump them when it finishes.").arg(short_opts[PerfCounters]).arg(PerfCounters));
+	printText(tr("  %1, %2 [FILE]\t\t    Write a Chrome trace format file with the timing spans of the operation phases. The file can be opened in any trace viewer compatible with that format.").arg(short_opts[Trace]).arg(Trace));
+	printText(tr("  %1, %2\t\t    Cache the generated code definitions on disk across executions. Re-running an operation over a mostly unchanged model reuses the cached code instead of regenerating it.").arg(short_opts[CodeCache]).arg(CodeCache));
 	printText();
 
 	printText(tr("SQL file export options: "));
@@ -468,16 +639,18 @@ void PgModelerCliApp::showMenu()
 	printText(tr("  %1, %2\t\t    Causes the objects matching to be performed over their names instead of their signature ([schema].[name]).").arg(short_opts[MatchByName]).arg(MatchByName));
 	printText(tr("  %1, %2 [OBJECTS]   Forces the importing of children objects related to tables/views/foreign tables matched by the filter(s). The OBJECTS is a comma separated list types.").arg(short_opts[ForceChildren]).arg(ForceChildren));
 	printText(tr("  %1, %2\t\t    Run import in debug mode printing all queries executed in the server.").arg(short_opts[DebugMode]).arg(DebugMode));
+	printText(tr("  %1, %2 [FILE]\t    Save the per phase import statistics (timings and query counts) to the specified file in JSON format.").arg(short_opts[ImportStats]).arg(ImportStats));
+	printText(tr("  %1, %2 [NUMBER]\t    Amount of connections used to retrieve the objects' attributes in parallel (max: %3). In diff mode, also the amount of threads used to compare the objects. In the export and fix modes, the amount of input files processed in parallel.").arg(short_opts[ImportJobs]).arg(ImportJobs).arg(DatabaseImportHelper::MaxParallelConns));
 	printText();
 
 	printText(tr("Diff options: "));
-	printText(tr("  %1, %2 [DBNAME]\t    The database used in the comparison. All the SQL code generated is applied to it.").arg(short_opts[CompareTo]).arg(CompareTo));
+	printText(tr("  %1, %2 [DBNAME]\t    The database used in the comparison. All the SQL code generated is applied to it. A model file (.dbm) can be provided instead, in this case the diff runs completely offline and can only be saved.").arg(short_opts[CompareTo]).arg(CompareTo));
 	printText(tr("  %1, %2\t\t    Toggles the partial diff operation. A set of objects filters should be provided using the import option %3.").arg(short_opts[PartialDiff]).arg(PartialDiff).arg(FilterObjects));
 	printText(tr("  %1, %2\t\t\t    Forces a full diff if the provided filters were not able to retrieve objects for a partial diff operation.").arg(short_opts[Force]).arg(Force));
 	printText(tr("  %1, %2\t\t    Matches all database model objects in which modification date starts in the specified date. (Only for partial diff)").arg(short_opts[StartDate]).arg(StartDate));
 	printText(tr("  %1, %2\t\t    Matches all database model objects in which modification date ends in the specified date. (Only for partial diff)").arg(short_opts[EndDate]).arg(EndDate));
 	printText(tr("  %1, %2\t\t\t    Save the generated diff code to output file.").arg(short_opts[SaveDiff]).arg(SaveDiff));
-	printText(tr("  %1, %2\t\t\t    Apply the generated diff code on the database server.").arg(short_opts[ApplyDiff]).arg(ApplyDiff));
+	printText(tr("  %1, %2\t\t\t    Apply the generated diff code on the database server. Can be combined with `%3' to save and apply the code in a single run.").arg(short_opts[ApplyDiff]).arg(ApplyDiff).arg(SaveDiff));
 	printText(tr("  %1, %2\t\t    Don't preview the generated diff code when applying it to the server.").arg(short_opts[NoDiffPreview]).arg(NoDiffPreview));
 	printText(tr("  %1, %2\t    Drop cluster level objects like roles and tablespaces.").arg(short_opts[DropClusterObjs]).arg(DropClusterObjs));
 	printText(tr("  %1, %2\t\t    Revoke permissions already set on the database. New permissions configured in the input model are still applied.").arg(short_opts[RevokePermissions]).arg(RevokePermissions));
@@ -501,6 +674,13 @@ void PgModelerCliApp::showMenu()
 	printText();
 #endif
 
+	printText(tr("Benchmark options: "));
+	printText(tr("  %1, %2 [NUMBER]\t    Amount of tables in the synthetic model. Default: 100.").arg(short_opts[BenchTables]).arg(BenchTables));
+	printText(tr("  %1, %2 [NUMBER]\t    Amount of columns per table in the synthetic model. Default: 10.").arg(short_opts[BenchColumns]).arg(BenchColumns));
+	printText(tr("  %1, %2 [NUMBER]    Amount of relationships in the synthetic model. Default: 50.").arg(short_opts[BenchRels]).arg(BenchRels));
+	printText(tr("  %1, %2 [NUMBER]\t    Amount of repetitions of each measured step. Default: 5.").arg(short_opts[BenchRepeat]).arg(BenchRepeat));
+	printText();
+
 	printText(tr("Config files creation options: "));
 	printText(tr("  %1, %2 \t\t    Copy only missing configuration files to the user's local storage.").arg(short_opts[MissingOnly]).arg(MissingOnly));
 	printText(tr("  %1, %2 \t\t\t    Forces the recreation of all configuration files. This option implies the backup of the current settings.").arg(short_opts[Force]).arg(Force));
@@ -591,6 +771,415 @@ void PgModelerCliApp::listConnections()
 	}
 }
 
+void PgModelerCliApp::runOperation()
+{
+	if(json_progress)
+	{
+		QJsonObject evt;
+		QString op_name;
+
+		for(auto &opt : { FixModel, ImportDb, Diff, ExportToFile, ExportToPng,
+											ExportToSvg, ExportToDict, ExportToDbms })
+		{
+			if(parsed_opts.count(opt))
+			{
+				//Stripping the leading dashes so the record carries only the operation name
+				op_name = QString(opt).remove(0, 2);
+				break;
+			}
+		}
+
+		evt["operation"] = op_name;
+		printJsonEvent("operation-started", evt);
+		op_timer.start();
+	}
+
+	if(parsed_opts.count(FixModel))
+		fixModel();
+	else if(parsed_opts.count(ImportDb))
+		importDatabase();
+	else if(parsed_opts.count(Diff))
+		diffModelDatabase();
+	else
+		exportModel();
+
+	if(json_progress)
+	{
+		QJsonObject evt;
+
+		finishJsonPhase();
+		evt["duration-ms"] = op_timer.elapsed();
+		evt["mem-peak-kb"] = getMemoryPeak();
+		printJsonEvent("operation-finished", evt);
+	}
+}
+
+void PgModelerCliApp::generateSyntheticModel(unsigned tables_cnt, unsigned cols_cnt, unsigned rels_cnt)
+{
+	QStringList col_types={ "integer", "varchar", "text", "numeric",
+													"boolean", "date", "timestamp", "smallint" };
+	Table *table=nullptr;
+	Column *column=nullptr;
+	Constraint *pk=nullptr;
+	Relationship *rel=nullptr;
+
+	try
+	{
+		model->createSystemObjects(false);
+		model->setName("benchmark_db");
+
+		for(unsigned t=0; t < tables_cnt; t++)
+		{
+			table=new Table;
+			table->setName(QString("table_%1").arg(t));
+			table->setSchema(model->getSchema("public"));
+
+			column=new Column;
+			column->setName("id");
+			column->setType(PgSqlType("serial"));
+			table->addColumn(column);
+
+			for(unsigned c=1; c < cols_cnt; c++)
+			{
+				column=new Column;
+				column->setName(QString("col_%1").arg(c));
+				column->setType(PgSqlType(col_types[c % col_types.size()]));
+				table->addColumn(column);
+			}
+
+			pk=new Constraint;
+			pk->setName(QString("table_%1_pk").arg(t));
+			pk->setConstraintType(ConstraintType::PrimaryKey);
+			pk->addColumn(table->getColumn(0), Constraint::SourceCols);
+			table->addConstraint(pk);
+
+			model->addTable(table);
+		}
+
+		/* The tables are linked sequentially in a wrapping fashion so the relationships
+		 * exercise the connection/column propagation over the whole set of tables */
+		for(unsigned r=0; r < rels_cnt; r++)
+		{
+			rel=new Relationship(BaseRelationship::Relationship1n,
+													 model->getTable(r % tables_cnt),
+													 model->getTable((r + 1) % tables_cnt));
+			rel->setName(QString("rel_%1").arg(r));
+			model->addRelationship(rel);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
+
+void PgModelerCliApp::printBenchmarkStats(const QString &step, vector<qint64> &timings)
+{
+	size_t p99_idx=0;
+	std::sort(timings.begin(), timings.end());
+
+	//Nearest-rank percentile: ceil(N * 99 / 100) converted to a zero based index
+	p99_idx=((timings.size() * 99) + 99) / 100;
+	if(p99_idx > 0) p99_idx--;
+	if(p99_idx >= timings.size()) p99_idx=timings.size() - 1;
+
+	if(json_progress)
+	{
+		QJsonObject evt;
+		evt["step"] = step;
+		evt["runs"] = static_cast<int>(timings.size());
+		evt["min-ms"] = timings.front();
+		evt["median-ms"] = timings[timings.size() / 2];
+		evt["p99-ms"] = timings[p99_idx];
+		evt["max-ms"] = timings.back();
+		printJsonEvent("benchmark", evt);
+	}
+	else
+	{
+		printText(tr("Step `%1': min %2 ms / median %3 ms / p99 %4 ms / max %5 ms (%6 run(s))")
+							.arg(step).arg(timings.front()).arg(timings[timings.size() / 2])
+							.arg(timings[p99_idx]).arg(timings.back()).arg(timings.size()));
+	}
+}
+
+void PgModelerCliApp::runBenchmark()
+{
+	unsigned tables_cnt=100, cols_cnt=10, rels_cnt=50, reps=5;
+	QString tmp_file=GlobalAttributes::getTemporaryFilePath("benchmark.dbm");
+
+	try
+	{
+		if(!parsed_opts[BenchTables].isEmpty())
+			tables_cnt=parsed_opts[BenchTables].toUInt();
+
+		if(!parsed_opts[BenchColumns].isEmpty())
+			cols_cnt=parsed_opts[BenchColumns].toUInt();
+
+		if(!parsed_opts[BenchRels].isEmpty())
+			rels_cnt=parsed_opts[BenchRels].toUInt();
+
+		if(!parsed_opts[BenchRepeat].isEmpty())
+			reps=parsed_opts[BenchRepeat].toUInt();
+
+		if(tables_cnt == 0) tables_cnt=1;
+		if(cols_cnt == 0) cols_cnt=1;
+		if(reps == 0) reps=1;
+
+		//Relationships need at least a pair of tables to be connected
+		if(tables_cnt < 2) rels_cnt=0;
+
+		printMessage(tr("Running benchmark: %1 table(s) x %2 column(s) x %3 relationship(s), %4 repetition(s) per step.")
+								 .arg(tables_cnt).arg(cols_cnt).arg(rels_cnt).arg(reps));
+		printMessage();
+
+		QElapsedTimer step_tm;
+		vector<qint64> timings;
+
+		auto run_step=[&](const QString &step, const std::function<void()> &func)
+		{
+			timings.clear();
+
+			for(unsigned rep=0; rep < reps; rep++)
+			{
+				step_tm.start();
+				func();
+				timings.push_back(step_tm.elapsed());
+			}
+
+			printBenchmarkStats(step, timings);
+		};
+
+		//The model generation runs a single time since the further steps reuse the generated model
+		step_tm.start();
+		generateSyntheticModel(tables_cnt, cols_cnt, rels_cnt);
+		timings.push_back(step_tm.elapsed());
+		printBenchmarkStats("model-generation", timings);
+
+		/* The code caches are invalidated before each run so the repetitions measure
+		 * the real generation cost instead of returning the cached definitions */
+		run_step("xml-code-generation", [&](){
+			model->setCodesInvalidated();
+			model->getCodeDefinition(SchemaParser::XmlDefinition);
+		});
+
+		run_step("sql-code-generation", [&](){
+			model->setCodesInvalidated();
+			model->getCodeDefinition(SchemaParser::SqlDefinition);
+		});
+
+		run_step("model-saving", [&](){
+			model->setCodesInvalidated();
+			model->saveModel(tmp_file, SchemaParser::XmlDefinition);
+		});
+
+		run_step("model-loading", [&](){
+			DatabaseModel aux_model;
+			aux_model.createSystemObjects(false);
+			aux_model.loadModel(tmp_file);
+		});
+
+		//Diffing the generated model against a reloaded copy of itself (no database connection needed)
+		DatabaseModel cmp_model;
+		cmp_model.createSystemObjects(false);
+		cmp_model.loadModel(tmp_file);
+
+		run_step("model-diff", [&](){
+			ModelsDiffHelper aux_diff_hlp;
+			aux_diff_hlp.setModels(model, &cmp_model);
+			aux_diff_hlp.diffModels();
+		});
+
+		QFile::remove(tmp_file);
+		printMessage();
+		printMessage(tr("Benchmark finished."));
+		printMessage();
+	}
+	catch(Exception &e)
+	{
+		QFile::remove(tmp_file);
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
+
+void PgModelerCliApp::resetModel()
+{
+	/* The scene items are destroyed before the model since the graphical
+	 * representations hold references to the objects being displayed */
+	if(scene)
+		scene->clear();
+
+	delete model;
+	objs_xml.clear();
+	member_roles.clear();
+
+	model=new DatabaseModel;
+	xmlparser=model->getXMLParser();
+
+	if(scene)
+	{
+		connect(model, SIGNAL(s_objectAdded(BaseObject *)), this, SLOT(handleObjectAddition(BaseObject *)));
+		connect(model, SIGNAL(s_objectRemoved(BaseObject *)), this, SLOT(handleObjectRemoval(BaseObject *)));
+	}
+}
+
+void PgModelerCliApp::watchInputFile()
+{
+	QFileSystemWatcher watcher;
+	QTimer debounce_tm;
+	QEventLoop evt_loop;
+	QString in_file=parsed_opts[Input];
+
+	/* Modifications are debounced so a sequence of change notifications for the same
+	 * saving (editors usually truncate and rewrite the file) triggers a single run */
+	debounce_tm.setSingleShot(true);
+	debounce_tm.setInterval(1000);
+
+	watcher.addPath(in_file);
+
+	connect(&watcher, &QFileSystemWatcher::fileChanged, this, [&debounce_tm](){
+		debounce_tm.start();
+	});
+
+	connect(&debounce_tm, &QTimer::timeout, this, [&](){
+		/* Applications that save by replacing the file remove the watched path,
+		 * so the input file is registered again once it exists */
+		if(!watcher.files().contains(in_file))
+		{
+			if(!QFileInfo::exists(in_file))
+			{
+				//The file is gone (e.g. saving in progress), retrying until it is recreated
+				debounce_tm.start();
+				return;
+			}
+
+			watcher.addPath(in_file);
+		}
+
+		try
+		{
+			resetModel();
+			runOperation();
+		}
+		catch(Exception &e)
+		{
+			/* In watch mode errors don't abort the process: the messages are printed
+			 * and the operation runs again at the next modification */
+			printText(e.getExceptionsText());
+		}
+	});
+
+	printMessage(tr("Watching the input file for modifications... Press Ctrl+C to quit."));
+	evt_loop.exec();
+}
+
+QString PgModelerCliApp::getJobOutputPath(const QString &input_file)
+{
+	QFileInfo fi(input_file);
+	QDir out_dir(parsed_opts[Output]);
+
+	if(parsed_opts.count(FixModel))
+		return out_dir.filePath(fi.fileName());
+
+	if(parsed_opts.count(ExportToPng))
+		return out_dir.filePath(fi.completeBaseName() + QString(".png"));
+
+	if(parsed_opts.count(ExportToSvg))
+		return out_dir.filePath(fi.completeBaseName() + QString(".svg"));
+
+	/* Data dictionaries and split sql exports write several files, so each
+	 * input model receives its own subdirectory in the output directory */
+	if(parsed_opts.count(ExportToDict) || parsed_opts.count(Split))
+		return out_dir.filePath(fi.completeBaseName());
+
+	return out_dir.filePath(fi.completeBaseName() + QString(".sql"));
+}
+
+void PgModelerCliApp::runParallelJobs()
+{
+	QStringList base_args, failed_files;
+	QList<QProcess *> running;
+	map<QProcess *, QString> job_files;
+	int jobs = QThread::idealThreadCount(), file_idx = 0;
+
+	if(parsed_opts.count(ImportJobs))
+		jobs = parsed_opts[ImportJobs].toInt();
+
+	if(jobs < 1)
+		jobs = 1;
+
+	/* The common options are replicated in each child process, the input/output
+	 * files are defined per job and the jobs amount isn't propagated */
+	for(auto &itr : parsed_opts)
+	{
+		if(itr.first==Input || itr.first==Output || itr.first==ImportJobs)
+			continue;
+
+		base_args.append(itr.first);
+
+		if(!itr.second.isEmpty())
+			base_args.append(itr.second);
+	}
+
+	//The output directory receives one file (or subdirectory) per input model
+	if(!QDir(parsed_opts[Output]).exists())
+		QDir().mkpath(parsed_opts[Output]);
+
+	printMessage(tr("Processing %1 input file(s) in up to %2 parallel job(s)...").arg(input_files.size()).arg(jobs));
+	printMessage(tr("Output directory: %1\n").arg(parsed_opts[Output]));
+
+	while(file_idx < input_files.size() || !running.isEmpty())
+	{
+		//Starting new jobs while there are pending files and free job slots
+		while(running.size() < jobs && file_idx < input_files.size())
+		{
+			QString in_file = input_files[file_idx++];
+			QProcess *proc = new QProcess(this);
+
+			proc->setProgram(QCoreApplication::applicationFilePath());
+			proc->setArguments(QStringList{ base_args } << Input << in_file << Output << getJobOutputPath(in_file));
+			proc->setProcessChannelMode(QProcess::MergedChannels);
+
+			job_files[proc] = in_file;
+			running.append(proc);
+			proc->start();
+		}
+
+		//Reaping the finished jobs and printing their buffered output
+		for(int i=0; i < running.size(); i++)
+		{
+			QProcess *proc = running[i];
+			proc->waitForFinished(100);
+
+			if(proc->state()==QProcess::NotRunning)
+			{
+				bool job_failed = (proc->exitStatus()!=QProcess::NormalExit || proc->exitCode()!=0);
+
+				if(job_failed)
+					failed_files.append(job_files[proc]);
+
+				/* The child output is buffered and printed as a whole when the job finishes,
+				 * avoiding the interleaving of messages of concurrent jobs */
+				if(!silent_mode || job_failed)
+				{
+					printText(tr("== Output of the job for `%1' ==").arg(job_files[proc]));
+					printText(proc->readAllStandardOutput());
+				}
+
+				job_files.erase(proc);
+				running.removeAt(i);
+				i--;
+				delete proc;
+			}
+		}
+	}
+
+	if(!failed_files.isEmpty())
+		throw Exception(tr("The processing of the file(s) `%1' has failed!").arg(failed_files.join(QString("', `"))),
+										ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	printMessage(tr("All jobs successfully ended!\n"));
+}
+
 void PgModelerCliApp::parseOptions(attribs_map &opts)
 {
 	//Loading connections
@@ -633,7 +1222,9 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 				diff = (opts.count(Diff) > 0),
 				create_configs= (opts.count(CreateConfigs) > 0),
 				list_conns = (opts.count(ListConns) > 0),
-				export_dbms = (opts.count(ExportToDbms) > 0);
+				export_dbms = (opts.count(ExportToDbms) > 0),
+				benchmark = (opts.count(Benchmark) > 0),
+				pack_assets = (opts.count(PackAssets) > 0);
 
 		for(auto &itr : accepted_opts)
 		{
@@ -656,22 +1247,25 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 		if(opts.count(ZoomFactor))
 			zoom=opts[ZoomFactor].toDouble()/static_cast<double>(100);
 
+		if(opts.count(MaxMemory) && opts[MaxMemory].toLongLong() <= 0)
+			throw Exception(tr("The value provided to the option `%1' must be a positive integer (megabytes)!").arg(MaxMemory), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
 		if(other_modes_cnt==0 && exp_mode_cnt==0)
 			throw Exception(tr("No operation mode was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		
-		if((exp_mode_cnt > 0 && (fix_model || upd_mime || import_db || diff || create_configs || list_conns)) || (exp_mode_cnt==0 && other_modes_cnt > 1))
+		if((exp_mode_cnt > 0 && (fix_model || upd_mime || import_db || diff || create_configs || list_conns || benchmark || pack_assets)) || (exp_mode_cnt==0 && other_modes_cnt > 1))
 			throw Exception(tr("Multiple operation modes were specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		
 		if(!fix_model && !upd_mime && exp_mode_cnt > 1)
 			throw Exception(tr("Multiple export mode was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		
-		if(!list_conns && !upd_mime && !import_db && !diff && !create_configs && !opts.count(Input))
+		if(!list_conns && !upd_mime && !import_db && !diff && !create_configs && !benchmark && !opts.count(Input))
 			throw Exception(tr("No input file was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 		if(import_db && !opts.count(InputDb))
 			throw Exception(tr("No input database was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-		if(!opts.count(ExportToDbms) && !upd_mime && !list_conns && !diff && !create_configs && !opts.count(Output))
+		if(!opts.count(ExportToDbms) && !upd_mime && !list_conns && !diff && !create_configs && !benchmark && !opts.count(Output))
 			throw Exception(tr("No output file was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		
 		if(!opts.count(ExportToDbms) && !upd_mime && !import_db && !list_conns && !create_configs &&
@@ -703,6 +1297,19 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 			if(!opts.count(CompareTo))
 				throw Exception(tr("No database to be compared was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+			// Comparing against another model file is a pure offline operation with some restrictions
+			if(opts[CompareTo].endsWith(QString(".dbm"), Qt::CaseInsensitive))
+			{
+				if(!opts.count(Input))
+					throw Exception(tr("Comparing to a model file requires an input model file!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+				if(opts.count(ApplyDiff))
+					throw Exception(tr("The diff between two model files can only be saved, not applied!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+				if(opts.count(PartialDiff))
+					throw Exception(tr("Partial diff can't be used when comparing two model files!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			}
+
 			if(!opts.count(SaveDiff) && !opts.count(ApplyDiff))
 				throw Exception(tr("No diff action (save or apply) was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
@@ -754,7 +1361,44 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 		
 		//Converting input and output files to absolute paths to avoid that they are read/written on the app's working dir
 		if(opts.count(Input))
-			opts[Input]=QFileInfo(opts[Input]).absoluteFilePath();
+		{
+			/* The input option accepts a comma separated list of files (wildcards allowed)
+			 * that are distributed across parallel jobs (see runParallelJobs) */
+			for(auto &in_file : opts[Input].split(',', QtCompat::SkipEmptyParts))
+			{
+				QFileInfo fi(in_file);
+
+				if(fi.fileName().contains('*') || fi.fileName().contains('?'))
+				{
+					QDir dir(fi.absolutePath());
+
+					for(auto &match : dir.entryList({ fi.fileName() }, QDir::Files, QDir::Name))
+						input_files.append(dir.absoluteFilePath(match));
+				}
+				else
+					input_files.append(fi.absoluteFilePath());
+			}
+
+			input_files.removeDuplicates();
+
+			if(input_files.isEmpty())
+				throw Exception(tr("No existing input file matches `%1'!").arg(opts[Input]), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+			if(input_files.size() > 1 && !fix_model && (exp_mode_cnt==0 || export_dbms))
+				throw Exception(tr("Multiple input files are accepted only when fixing models or exporting to file, png, svg or data dictionary!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+			if(input_files.size()==1)
+				opts[Input]=input_files.first();
+		}
+
+		if(opts.count(Watch))
+		{
+			if(!opts.count(Input))
+				throw Exception(tr("The option `%1' requires an input model file to be watched!").arg(Watch), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+			if(input_files.size() > 1)
+				throw Exception(tr("The option `%1' can't be used with multiple input files!").arg(Watch), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
 
 		if(opts.count(Output))
 			opts[Output]=QFileInfo(opts[Output]).absoluteFilePath();
@@ -814,33 +1458,132 @@ int PgModelerCliApp::exec()
 		{
 			showVersionInfo();
 
-			if(parsed_opts.count(ListConns))
+			if(input_files.size() > 1)
+				runParallelJobs();
+			else if(parsed_opts.count(ListConns))
 				 listConnections();
-			else if(parsed_opts.count(FixModel))
-				fixModel();
 			else if(parsed_opts.count(DbmMimeType))
 				updateMimeType();
 			else if(parsed_opts.count(CreateConfigs))
 				createConfigurations();
-			else if(parsed_opts.count(ImportDb))
-				importDatabase();
-			else if(parsed_opts.count(Diff))
-				diffModelDatabase();
+			else if(parsed_opts.count(PackAssets))
+				packAssets();
+			else if(parsed_opts.count(Benchmark))
+				runBenchmark();
 			else
-				exportModel();
+			{
+				runOperation();
+
+				//Keeping the process resident re-running the operation at each input file change
+				if(parsed_opts.count(Watch))
+					watchInputFile();
+			}
+
+			//Dumping the counters recorded during the whole operation
+			if(parsed_opts.count(PerfCounters))
+			{
+				if(json_progress)
+				{
+					QJsonObject counters, timings, census;
+
+					for(auto &itr : PerformanceCounters::getCounters())
+						counters[itr.first]=static_cast<double>(itr.second);
+
+					for(auto &itr : PerformanceCounters::getTimings())
+					{
+						QJsonObject timing;
+						timing["total-ms"]=itr.second.first / 1000000.0;
+						timing["calls"]=static_cast<double>(itr.second.second);
+						timings[itr.first]=timing;
+					}
+
+					printJsonEvent("perf-counters", QJsonObject{{"counters", counters}, {"timings", timings}});
+
+					for(auto &itr : ObjectCensus::snapshot())
+					{
+						QJsonObject entry;
+						entry["count"]=static_cast<double>(itr.second.count);
+						entry["bytes"]=static_cast<double>(itr.second.bytes);
+						census[BaseObject::getSchemaName(itr.first)]=entry;
+					}
+
+					printJsonEvent("object-census", QJsonObject{{"types", census}});
+
+					QJsonObject queries;
+
+					for(auto &itr : Catalog::getQueryLog())
+					{
+						QJsonObject entry;
+						entry["fingerprint"]=itr.second.fingerprint;
+						entry["calls"]=static_cast<double>(itr.second.calls);
+						entry["rows"]=static_cast<double>(itr.second.rows);
+						entry["total-ms"]=itr.second.total_nsecs / 1000000.0;
+
+						if(itr.second.server_total_ms > 0)
+							entry["server-ms"]=itr.second.server_total_ms;
+
+						queries[itr.first]=entry;
+					}
+
+					if(!queries.isEmpty())
+						printJsonEvent("catalog-queries", QJsonObject{{"queries", queries}});
+				}
+				else
+				{
+					printText();
+					printText(PerformanceCounters::dump());
+					printText(ObjectCensus::dump());
+
+					if(Catalog::isQueryLogEnabled())
+						printText(Catalog::dumpQueryLog());
+				}
+			}
+
+			TraceLogger::stop();
 		}
 
 		return 0;
 	}
 	catch(Exception &e)
 	{
+		//Finishing the trace file so the spans recorded until the failure remain loadable
+		TraceLogger::stop();
 		throw e;
 	}
 }
 
-void PgModelerCliApp::updateProgress(int progress, QString msg, ObjectType)
+void PgModelerCliApp::updateProgress(int progress, QString msg, ObjectType obj_type)
 {
-	if(progress > 0)
+	//The budget is checked at progress updates so the monitoring piggybacks the existing callbacks
+	checkMemoryBudget();
+
+	if(json_progress)
+	{
+		QJsonObject evt;
+
+		/* A progress percentage lower than the previously reported one indicates
+		 * that the running helper started a new phase of the operation */
+		if(progress < last_progress)
+			finishJsonPhase();
+
+		if(curr_phase.isEmpty())
+		{
+			curr_phase = msg;
+			phase_timer.start();
+		}
+
+		if(obj_type != ObjectType::BaseObject)
+		{
+			phase_obj_count++;
+			evt["object-type"] = BaseObject::getSchemaName(obj_type);
+		}
+
+		evt["percent"] = (progress > 100 ? 100 : progress);
+		evt["message"] = msg;
+		printJsonEvent("progress", evt);
+		last_progress = progress;
+	}
+	else if(progress > 0)
 		printMessage(QString("[%1%] ").arg(progress > 100 ? 100 : progress) + msg);
 	else
 		printMessage(msg);
@@ -917,7 +1660,8 @@ void PgModelerCliApp::handleObjectRemoval(BaseObject *object)
 
 void PgModelerCliApp::extractObjectXML()
 {
-	QString buf, lin, def_xml, end_tag;
+	QString header_buf, lin, def_xml, end_tag;
+	QFile input_file(parsed_opts[Input]);
 	QTextStream ts;
 	QRegExp regexp(QString("^(\\<\\?xml)(.)*(\\<%1)( )*").arg(Attributes::DbModel)),
 
@@ -925,26 +1669,46 @@ void PgModelerCliApp::extractObjectXML()
 			func_signature=QRegExp(QString("(\")(.)+(\\.)(.)+(\\()(.)*(OUT )(.)+(\\))(\")")),
 
 			//[,]OUT [schema].[type]
-			out_param=QRegExp(QString("(,)?(OUT )([a-z]|[0-9]|(\\.)|(\\_)|(\\-)|( )|(\\[)|(\\])|(&quot;))+((\\()([0-9])+(\\)))?"));
+			out_param=QRegExp(QString("(,)?(OUT )([a-z]|[0-9]|(\\.)|(\\_)|(\\-)|( )|(\\[)|(\\])|(&quot;))+((\\()([0-9])+(\\)))?")),
+
+			//Matches a whole role declaration in a single line, marking the end of the model file header
+			role_regexp=QRegExp(QString("(<%1)(.)*(<\\/%2>)").arg(Attributes::Role).arg(Attributes::Role));
 	int start=-1, end=-1;
-	bool open_tag=false, close_tag=false, is_rel=false, short_tag=false, end_extract_rel;
+	bool open_tag=false, close_tag=false, is_rel=false, short_tag=false, end_extract_rel, hdr_end=false;
 
 	printMessage(tr("Extracting objects' XML..."));
 
-	buf.append(UtilsNs::loadFile(parsed_opts[Input]));
+	if(!input_file.open(QFile::ReadOnly))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(parsed_opts[Input]),
+										ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	/* The input file is read incrementally instead of being fully loaded in memory so arbitrarily
+	 * large models can be fixed in bounded memory. Only the file header (everything before the
+	 * first object declaration) is buffered in order to extract the layers information from it */
+	ts.setDevice(&input_file);
+
+	while(!hdr_end && !ts.atEnd())
+	{
+		lin=ts.readLine();
+
+		//The header ends at the first role declaration or, when there is none, at the database declaration
+		hdr_end=(role_regexp.indexIn(lin) >= 0 || lin.contains(QString("<%1").arg(Attributes::Database)));
+
+		if(!hdr_end)
+			header_buf+=lin + QString("\n");
+	}
 
 	//Check if the file contains a valid header (for .dbm file)
-	start=regexp.indexIn(buf);
+	start=regexp.indexIn(header_buf);
 
 	if(start < 0)
 		throw Exception(tr("Invalid input file! It seems that is not a pgModeler generated model or the file is corrupted!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else
 	{
 		//Extracting layers informations from the tag <dbmodel>
-		QRegExp dbm_regexp = QRegExp(TagExpr.arg(Attributes::DbModel)),
-				db_end_regexp =  QRegExp(EndTagExpr.arg(Attributes::Database));
-		int attr_start =-1, attr_end = -1, dbm_start = dbm_regexp.indexIn(buf);
-		QString aux_buf = buf.mid(dbm_start, buf.indexOf(db_end_regexp) - dbm_start),
+		QRegExp dbm_regexp = QRegExp(TagExpr.arg(Attributes::DbModel));
+		int attr_start =-1, attr_end = -1, dbm_start = dbm_regexp.indexIn(header_buf);
+		QString aux_buf = header_buf.mid(dbm_start),
 				layers, active_layers, attr_expr = QString("(%1)( )*(=)(\")");
 		QList<unsigned> act_layers_ids;
 
@@ -968,28 +1732,23 @@ void PgModelerCliApp::extractObjectXML()
 
 		model->setActiveLayers(act_layers_ids);
 
-		//Remove the header entry from buffer
-		buf.remove(start, regexp.matchedLength()+1);
-
-		//Checking if the header ends on a role declaration
-		QRegExp role_regexp = QRegExp(QString("(<%1)(.)*(<\\/%2>)").arg(Attributes::Role).arg(Attributes::Role));
-		end = buf.indexOf(role_regexp);
-
-		// If we found role declarations we clear the header until there
-		if(end >= 0)
-			buf.remove(0, end);
-		else
-			// Instead, we clear the header until the starting of database declaration
-			buf.remove(0, buf.indexOf(QString("<%1").arg(Attributes::Database)));
+		if(!hdr_end)
+		{
+			/* When no object declaration was found during the header scanning the file is corrupted
+			 * beyond the header, so we fall back to extracting from the buffered contents */
+			header_buf.remove(start, regexp.matchedLength()+1);
+			ts.setString(&header_buf);
 
-		buf.remove(QString("<\\%1>").arg(Attributes::DbModel));
-		ts.setString(&buf);
+			if(ts.atEnd())
+				return;
 
-		//Extracts the objects xml line by line
-		while(!ts.atEnd())
-		{
 			lin=ts.readLine();
+		}
 
+		/* Extracts the objects xml line by line. The line that ended the header scanning above is
+		 * the first one processed since it already belongs to an object declaration */
+		while(true)
+		{
 			/*  Special case for empty tags like <language />, they will be converted to
 		  <language></language> in order to be correctly extracted further. Currently only language has this
 		  behaviour, so additional object may be added in the future. */
@@ -1077,6 +1836,11 @@ void PgModelerCliApp::extractObjectXML()
 				def_xml.clear();
 				open_tag=close_tag=is_rel=false;
 			}
+
+			if(ts.atEnd())
+				break;
+
+			lin=ts.readLine();
 		}
 	}
 }
@@ -1666,24 +2430,59 @@ void PgModelerCliApp::exportModel()
 
 void PgModelerCliApp::importDatabase()
 {
-	printMessage(tr("Starting database import..."));
-	printMessage(tr("Input database: %1").arg(connection.getConnectionId(true, true)));
+	QStringList db_names = parsed_opts[InputDb].split(',', QtCompat::SkipEmptyParts);
+	QString out_file;
+	bool batch_mode = db_names.size() > 1;
+
+	/* The amount of connections used to retrieve the objects' attributes of each
+	 * database in parallel (see DatabaseImportHelper::setParallelRetrieval()) */
+	if(parsed_opts.count(ImportJobs))
+		DatabaseImportHelper::setParallelRetrieval(parsed_opts[ImportJobs].toUInt());
+
+	//In batch mode the output is a directory receiving one dbm file per database
+	if(batch_mode && !QDir(parsed_opts[Output]).exists())
+		QDir().mkpath(parsed_opts[Output]);
+
+	for(auto &db_name : db_names)
+	{
+		Connection conn=connection;
+		conn.setConnectionParam(Connection::ParamDbName, db_name);
 
-	ModelWidget *model_wgt = new ModelWidget;
+		printMessage(tr("Starting database import..."));
+		printMessage(tr("Input database: %1").arg(conn.getConnectionId(true, true)));
 
-	importDatabase(model_wgt->getDatabaseModel(), connection);
-	model_wgt->rearrangeSchemasInGrid();
+		ModelWidget *model_wgt = new ModelWidget;
 
-	printMessage(tr("Saving the imported database to file..."));
+		importDatabase(model_wgt->getDatabaseModel(), conn);
+		model_wgt->rearrangeSchemasInGrid();
 
-	model_wgt->getDatabaseModel()->saveModel(parsed_opts[Output], SchemaParser::XmlDefinition);
+		printMessage(tr("Saving the imported database to file..."));
 
-	printMessage(tr("Import successfully ended!\n"));
+		out_file = (batch_mode ?
+									QDir(parsed_opts[Output]).filePath(QString("%1.dbm").arg(db_name)) :
+									parsed_opts[Output]);
+		model_wgt->getDatabaseModel()->saveModel(out_file, SchemaParser::XmlDefinition);
 
-	delete model_wgt;
+		printMessage(tr("Import successfully ended!\n"));
+
+		delete model_wgt;
+	}
 }
 
 void PgModelerCliApp::importDatabase(DatabaseModel *model, Connection conn)
+{
+	try
+	{
+		configureImportHelper(import_hlp, model, conn);
+		finishImport(import_hlp, conn);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void PgModelerCliApp::configureImportHelper(DatabaseImportHelper *imp_hlp, DatabaseModel *model, Connection conn)
 {
 	try
 	{
@@ -1721,18 +2520,43 @@ void PgModelerCliApp::importDatabase(DatabaseModel *model, Connection conn)
 		obj_oids[ObjectType::Database].push_back(db_oid.toUInt());
 		catalog.closeConnection();
 
-		import_hlp->setConnection(conn);
-		import_hlp->setImportOptions(imp_sys_objs,
-																 imp_ext_objs,
-																 true,
-																 parsed_opts.count(IgnoreImportErrors) > 0,
-																 parsed_opts.count(DebugMode) > 0,
-																 !parsed_opts.count(Diff), !parsed_opts.count(Diff));
+		imp_hlp->setConnection(conn);
+		imp_hlp->setImportOptions(imp_sys_objs,
+															imp_ext_objs,
+															true,
+															parsed_opts.count(IgnoreImportErrors) > 0,
+															parsed_opts.count(DebugMode) > 0,
+															!parsed_opts.count(Diff), !parsed_opts.count(Diff));
 
 		model->createSystemObjects(true);
-		import_hlp->setSelectedOIDs(model, obj_oids, col_oids);
-		import_hlp->importDatabase();
-		import_hlp->closeConnection();
+		imp_hlp->setSelectedOIDs(model, obj_oids, col_oids);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void PgModelerCliApp::finishImport(DatabaseImportHelper *imp_hlp, Connection conn)
+{
+	try
+	{
+		imp_hlp->importDatabase();
+
+		//Saving the per phase statistics of the import in JSON format
+		if(parsed_opts.count(ImportStats))
+		{
+			QString stats_file=parsed_opts[ImportStats];
+
+			//In batch imports the database name is appended to avoid overwriting the statistics
+			if(parsed_opts[InputDb].contains(','))
+				stats_file+=QString(".%1").arg(conn.getConnectionParam(Connection::ParamDbName));
+
+			printMessage(tr("Saving import statistics to file `%1'...").arg(stats_file));
+			UtilsNs::saveFile(stats_file, imp_hlp->getImportStatsAsJson().toUtf8());
+		}
+
+		imp_hlp->closeConnection();
 	}
 	catch(Exception &e)
 	{
@@ -1740,73 +2564,176 @@ void PgModelerCliApp::importDatabase(DatabaseModel *model, Connection conn)
 	}
 }
 
+bool PgModelerCliApp::isCompareToModelFile()
+{
+	return parsed_opts[CompareTo].endsWith(QString(".dbm"), Qt::CaseInsensitive);
+}
+
 void PgModelerCliApp::diffModelDatabase()
 {
 	DatabaseModel *model_aux = new DatabaseModel();
 	QString dbname;
 	vector<BaseObject *> filtered_objs;
 
+	//The amount of threads used to compare the objects of the two models in parallel
+	if(parsed_opts.count(ImportJobs))
+		ModelsDiffHelper::setDiffThreads(parsed_opts[ImportJobs].toUInt());
+
 	printMessage(tr("Starting diff process..."));
 
-	if(!parsed_opts[Input].isEmpty())
+	if(isCompareToModelFile())
+	{
 		printMessage(tr("Input model: %1").arg(parsed_opts[Input]));
-	else
-		printMessage(tr("Input database: %1").arg(connection.getConnectionId(true, true)));
+		printMessage(tr("Compare to model: %1").arg(parsed_opts[CompareTo]));
 
-	dbname = extra_connection.getConnectionId(true, true);
-	printMessage(tr("Compare to: %1").arg(dbname));
-
-	if(!parsed_opts[Input].isEmpty())
-	{
 		printMessage(tr("Loading input model..."));
 		loadModel();
 
-		if(parsed_opts.count(PartialDiff))
+		printMessage(tr("Loading the compared model..."));
+		model_aux->createSystemObjects(false);
+		model_aux->loadModel(parsed_opts[CompareTo]);
+
+		/* In a model-to-model diff both sides carry definitions generated by the very same code,
+		 * so pairs of objects with matching content fingerprints are pruned upfront and the deep
+		 * comparison machinery only receives the objects that effectively changed */
+		ModelsDiffHelper::setDirectFingerprintComparison(true);
+	}
+	else
+	{
+		if(!parsed_opts[Input].isEmpty())
+			printMessage(tr("Input model: %1").arg(parsed_opts[Input]));
+		else
+			printMessage(tr("Input database: %1").arg(connection.getConnectionId(true, true)));
+
+		dbname = extra_connection.getConnectionId(true, true);
+		printMessage(tr("Compare to: %1").arg(dbname));
+
+		/* The attribute retrieval of the compared database runs in a separated thread so it can be
+		 * overlapped with the loading/import of the other side of the diff. Only the retrieval is
+		 * parallelized: the object creation touches globally shared state (objects ids, user defined
+		 * types registry) so it's always performed sequentially through finishImport() */
+		DatabaseImportHelper aux_import_hlp;
+		QFuture<void> aux_retr_future;
+		Exception aux_retr_error;
+		bool aux_retr_started = false, aux_retr_failed = false;
+
+		auto retrieve_aux_db=[&](){
+			try
+			{
+				aux_import_hlp.retrieveObjects();
+			}
+			catch(Exception &e)
+			{
+				aux_retr_error = Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+				aux_retr_failed = true;
+			}
+		};
+
+		if(!parsed_opts[Input].isEmpty())
 		{
-			QString search_attr = parsed_opts.count(MatchByName) ? Attributes::Name : Attributes::Signature;
+			/* In partial diffs the filters used to enumerate the objects of the compared database depend
+			 * on the loaded model, so the retrieval can only start after the model loading in that case */
+			if(!parsed_opts.count(PartialDiff))
+			{
+				printMessage(tr("Importing the database `%1'...").arg(dbname));
+				configureImportHelper(&aux_import_hlp, model_aux, extra_connection);
+				aux_retr_started = true;
+				aux_retr_future = QtConcurrent::run(retrieve_aux_db);
+			}
 
-			// Filtering by modification date always forces the signature matching
-			if(start_date.isValid() || end_date.isValid())
-				obj_filters.append(model->getFiltersFromChangelog(start_date, end_date));
+			printMessage(tr("Loading input model..."));
 
-			filtered_objs = model->findObjects(obj_filters, search_attr);
+			try
+			{
+				loadModel();
+			}
+			catch(Exception &e)
+			{
+				//The pending retrieval must finish before the error propagates and the helper is destroyed
+				if(aux_retr_started)
+					aux_retr_future.waitForFinished();
+
+				throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			}
 
-			/* We need to finish the diff if no object was found based on the filters
-			 * this will avoid the diff between an empty database model and a full database model
-			 * which may produce unexpected results like try to recreate all objects from the database
-			 * model that contains objects */
-			if(filtered_objs.empty())
+			if(parsed_opts.count(PartialDiff))
 			{
-				printMessage(tr("No object was retrieved using the provided filter(s)."));
+				QString search_attr = parsed_opts.count(MatchByName) ? Attributes::Name : Attributes::Signature;
+
+				// Filtering by modification date always forces the signature matching
+				if(start_date.isValid() || end_date.isValid())
+					obj_filters.append(model->getFiltersFromChangelog(start_date, end_date));
 
-				if(!parsed_opts.count(Force))
+				filtered_objs = model->findObjects(obj_filters, search_attr);
+
+				/* We need to finish the diff if no object was found based on the filters
+				 * this will avoid the diff between an empty database model and a full database model
+				 * which may produce unexpected results like try to recreate all objects from the database
+				 * model that contains objects */
+				if(filtered_objs.empty())
 				{
-					printMessage(tr("Use the option `%1' to force a full diff in this case.").arg(Force));
-					printMessage(tr("The diff process will not continue!\n"));
-					return;
+					printMessage(tr("No object was retrieved using the provided filter(s)."));
+
+					if(!parsed_opts.count(Force))
+					{
+						printMessage(tr("Use the option `%1' to force a full diff in this case.").arg(Force));
+						printMessage(tr("The diff process will not continue!\n"));
+						return;
+					}
+					else
+						printMessage(tr("Switching to full diff..."));
 				}
 				else
-					printMessage(tr("Switching to full diff..."));
+				{
+					/* Special case: when performing a partial diff between a model and a database
+					 * and in the set of filtered model objects we have one or more many-to-many, inheritance or partitioning
+					 * relationships we need to inject filters to force the retrieval of the all involved tables in those relationships
+					 * from the destination database,this way we avoid the diff try to create everytime all tables
+					 * in the those relationships. */
+					obj_filters.append(ModelsDiffHelper::getRelationshipFilters(filtered_objs, search_attr == Attributes::Signature));
+				}
 			}
-			else
+		}
+		else
+		{
+			printMessage(tr("Importing the database `%1'...").arg(connection.getConnectionId(true, true)));
+			printMessage(tr("Importing the database `%1'...").arg(dbname));
+
+			/* When both sides are databases their retrievals run concurrently (they use independent
+			 * connections) and the creation of the first model overlaps the retrieval of the second */
+			configureImportHelper(import_hlp, model, connection);
+			configureImportHelper(&aux_import_hlp, model_aux, extra_connection);
+			aux_retr_started = true;
+			aux_retr_future = QtConcurrent::run(retrieve_aux_db);
+
+			try
+			{
+				import_hlp->retrieveObjects();
+				finishImport(import_hlp, connection);
+			}
+			catch(Exception &e)
 			{
-				/* Special case: when performing a partial diff between a model and a database
-				 * and in the set of filtered model objects we have one or more many-to-many, inheritance or partitioning
-				 * relationships we need to inject filters to force the retrieval of the all involved tables in those relationships
-				 * from the destination database,this way we avoid the diff try to create everytime all tables
-				 * in the those relationships. */
-				obj_filters.append(ModelsDiffHelper::getRelationshipFilters(filtered_objs, search_attr == Attributes::Signature));
+				//The pending retrieval must finish before the error propagates and the helper is destroyed
+				aux_retr_future.waitForFinished();
+				throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 			}
 		}
-	}
-	else
-	{
-		printMessage(tr("Importing the database `%1'...").arg(connection.getConnectionId(true, true)));
-		importDatabase(model, connection);
-	}
 
-	printMessage(tr("Importing the database `%1'...").arg(dbname));
-	importDatabase(model_aux, extra_connection);
+		if(aux_retr_started)
+		{
+			aux_retr_future.waitForFinished();
+
+			if(aux_retr_failed)
+				throw Exception(aux_retr_error.getErrorMessage(), aux_retr_error.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &aux_retr_error);
+		}
+		else
+		{
+			printMessage(tr("Importing the database `%1'...").arg(dbname));
+			configureImportHelper(&aux_import_hlp, model_aux, extra_connection);
+		}
+
+		finishImport(&aux_import_hlp, extra_connection);
+	}
 
 	diff_hlp->setModels(model, model_aux);
 	diff_hlp->setFilteredObjects(filtered_objs);
@@ -1822,26 +2749,62 @@ void PgModelerCliApp::diffModelDatabase()
 
 	if(!parsed_opts[PgSqlVer].isEmpty())
 		diff_hlp->setPgSQLVersion(parsed_opts[PgSqlVer]);
-	else
+	else if(!isCompareToModelFile())
 	{
 		extra_connection.connect();
 		diff_hlp->setPgSQLVersion(extra_connection.getPgSQLVersion(true));
 		extra_connection.close();
 	}
 
+	/* Under a memory budget the diff script is not accumulated in memory: the helper streams
+	 * each chunk of code to a spill file as soon as it's generated, keeping the memory usage
+	 * flat no matter the size of the resulting script */
+	QFile spill_file;
+	bool spill_diff = (max_memory > 0);
+
+	if(spill_diff)
+	{
+		spill_file.setFileName(GlobalAttributes::getTemporaryFilePath("diff_spill.sql"));
+
+		if(!spill_file.open(QFile::WriteOnly | QFile::Truncate))
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(spill_file.fileName()),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		diff_hlp->setStreamingMode(true);
+		diff_hlp->setOutputDevice(&spill_file);
+	}
+
 	printMessage(tr("Comparing the generated models..."));
 	diff_hlp->diffModels();
 
-	if(diff_hlp->getDiffDefinition().isEmpty())
+	if(spill_diff)
+		spill_file.close();
+
+	if(spill_diff ? !diff_hlp->hasDifferences() : diff_hlp->getDiffDefinition().isEmpty())
 		printMessage(tr("No differences were detected."));
 	else
 	{
 		if(parsed_opts.count(SaveDiff))
 		{
 			printMessage(tr("Saving diff to file `%1'").arg(parsed_opts[Output]));
-			UtilsNs::saveFile(parsed_opts[Output], diff_hlp->getDiffDefinition().toUtf8());
+
+			if(spill_diff)
+			{
+				//The spilled script is copied as-is to the output avoiding reloading it in memory
+				QFile::remove(parsed_opts[Output]);
+
+				if(!QFile::copy(spill_file.fileName(), parsed_opts[Output]))
+					throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(parsed_opts[Output]),
+													ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+			}
+			else
+				UtilsNs::saveFile(parsed_opts[Output], diff_hlp->getDiffDefinition().toUtf8());
 		}
-		else
+
+		/* Saving and applying aren't exclusive: when both actions are specified the diff code is
+		 * saved and then applied in the same run, reusing the in-memory diff instead of requiring
+		 * a second invocation that would import and compare the databases all over again */
+		if(parsed_opts.count(ApplyDiff))
 		{
 			bool apply_diff = true;
 
@@ -1849,13 +2812,25 @@ void PgModelerCliApp::diffModelDatabase()
 			{
 				QString res, buff, line;
 				QTextStream in(stdin), preview;
+				QFile preview_file;
 
-				buff += "\n** Press ENTER to scroll the preview **\n";
-				buff += "\n### DIFF PREVIEW ###\n\n";
-				buff += diff_hlp->getDiffDefinition();
-				buff += "\n### END OF PREVIEW  ###\n\n";
+				out << "\n** Press ENTER to scroll the preview **\n";
+				out << "\n### DIFF PREVIEW ###\n\n";
+				out.flush();
 
-				preview.setString(&buff, QIODevice::ReadOnly);
+				/* When the script was spilled to disk the preview reads it directly from the
+				 * file, otherwise the in-memory definition is paged through a string stream */
+				if(spill_diff)
+				{
+					preview_file.setFileName(spill_file.fileName());
+					preview_file.open(QFile::ReadOnly);
+					preview.setDevice(&preview_file);
+				}
+				else
+				{
+					buff = diff_hlp->getDiffDefinition();
+					preview.setString(&buff, QIODevice::ReadOnly);
+				}
 
 				while(!preview.atEnd())
 				{
@@ -1873,6 +2848,7 @@ void PgModelerCliApp::diffModelDatabase()
 					}
 				}
 
+				out << "\n### END OF PREVIEW  ###\n\n";
 				out << QtCompat::endl;
 				out << tr("** WARNING: You are about to apply the generated diff code to the server. Data can be lost in the process!") << QtCompat::endl;
 
@@ -1896,7 +2872,11 @@ void PgModelerCliApp::diffModelDatabase()
 			if(apply_diff)
 			{
 				printMessage(tr("Applying diff to the database `%1'...").arg(dbname));
-				export_hlp->setExportToDBMSParams(diff_hlp->getDiffDefinition(),
+
+				/* The export helper receives a single sql buffer, so a spilled script needs to
+				 * be reloaded at this point. The buffer lives only during the applying, though:
+				 * the whole diff generation already ran under the budget */
+				export_hlp->setExportToDBMSParams(spill_diff ? QString::fromUtf8(UtilsNs::loadFile(spill_file.fileName())) : diff_hlp->getDiffDefinition(),
 												 &extra_connection,
 												 parsed_opts[CompareTo], parsed_opts.count(IgnoreDuplicates));
 
@@ -1908,6 +2888,9 @@ void PgModelerCliApp::diffModelDatabase()
 		}
 	}
 
+	if(spill_diff)
+		QFile::remove(spill_file.fileName());
+
 	printMessage(tr("Diff successfully ended!\n"));
 }
 
@@ -2245,3 +3228,20 @@ void PgModelerCliApp::createConfigurations()
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
 	}
 }
+
+void PgModelerCliApp::packAssets()
+{
+	try
+	{
+		printMessage(tr("Packing assets..."));
+		printMessage(tr("Source directory: %1").arg(parsed_opts[Input]));
+		printMessage(tr("Output archive: %1").arg(parsed_opts[Output]));
+
+		AssetArchive::packDirectory(parsed_opts[Input], parsed_opts[Output]);
+		printMessage(tr("Assets successfully packed!\n"));
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
@@ -29,6 +29,8 @@
 #include <QObject>
 #include <QTextStream>
 #include <QCoreApplication>
+#include <QJsonObject>
+#include <QElapsedTimer>
 #include "exception.h"
 #include "globalattributes.h"
 #include "widgets/modelwidget.h"
@@ -94,13 +96,46 @@ class PgModelerCliApp: public Application {
 		attribs_map parsed_opts;
 
 		//! \brief Indicates if the cli must run in silent mode
-		bool silent_mode;
+		bool silent_mode,
+
+		/*! \brief Indicates if the progress of the operations must be printed as a stream of
+		newline delimited json records instead of human readable messages (see printJsonEvent) */
+		json_progress;
+
+		//! \brief Measures the duration of the whole operation when in json progress mode
+		QElapsedTimer op_timer,
+
+		//! \brief Measures the duration of the current operation phase when in json progress mode
+		phase_timer;
+
+		/*! \brief Stores the message that opened the current operation phase. An empty value
+		indicates that no phase is running at the moment */
+		QString curr_phase;
+
+		/*! \brief Stores the last reported progress percentage. A percentage lower than the
+		previous one indicates that the running helper started a new phase */
+		int last_progress;
+
+		//! \brief Counts the objects handled in the current operation phase
+		unsigned phase_obj_count;
+
+		/*! \brief Memory budget (in kilobytes) informed through --max-memory. When set, large
+		intermediate buffers are spilled to temporary files and a warning is emitted if the
+		process resident memory exceeds the value. Zero means no budget enforcement */
+		qint64 max_memory;
+
+		//! \brief Indicates that the budget exceeded warning was already emitted
+		bool mem_budget_warned;
 
 		//! \brief Stores the xml code for the objects being fixed
 		QStringList objs_xml,
 
 		//! \brief Stores the object filters for reverse engineering
-		obj_filters;
+		obj_filters,
+
+		/*! \brief Stores the input model files to be processed. When more than one file is
+		provided they are distributed across parallel jobs (see runParallelJobs) */
+		input_files;
 
 		//! \brief Zoom to be applied onto the png export
 		double zoom;
@@ -157,11 +192,25 @@ class PgModelerCliApp: public Application {
 		SystemWide,
 		NoIndex,
 		Split,
+		Watch,
+		JsonProgress,
+		MaxMemory,
+		PerfCounters,
+		Trace,
+		CodeCache,
+
+		Benchmark,
+		BenchTables,
+		BenchColumns,
+		BenchRels,
+		BenchRepeat,
 
 		IgnoreImportErrors,
 		ImportSystemObjs,
 		ImportExtensionObjs,
 		DebugMode,
+		ImportStats,
+		ImportJobs,
 		FilterObjects,
 		OnlyMatching,
 		MatchByName,
@@ -188,6 +237,7 @@ class PgModelerCliApp: public Application {
 
 		CreateConfigs,
 		MissingOnly,
+		PackAssets,
 
 		TagExpr,
 		EndTagExpr,
@@ -241,10 +291,22 @@ class PgModelerCliApp: public Application {
 		void exportModel();
 		void importDatabase();
 		void diffModelDatabase();
+
+		/*! \brief Returns true when the value of the --compare-to option points to a database model
+		file instead of a database name, meaning a model-to-model diff that runs without connections */
+		bool isCompareToModelFile();
 		void updateMimeType();
 		void configureConnection(bool extra_conn);
 		void importDatabase(DatabaseModel *model, Connection conn);
 
+		/*! \brief Enumerates the objects' OIDs in the database accessed by conn applying the configured
+		 * filters and binds the provided helper to the connection/model so the import can be started */
+		void configureImportHelper(DatabaseImportHelper *imp_hlp, DatabaseModel *model, Connection conn);
+
+		/*! \brief Runs the import (or only its creation steps when the attributes were already retrieved)
+		 * through the provided helper, saving the import statistics when requested */
+		void finishImport(DatabaseImportHelper *imp_hlp, Connection conn);
+
 		/*! \brief Prints to the stdout the provided text appending a \n on the string
 		 * even if the silent mode is active. */
 		void printText(const QString &txt = "");
@@ -252,11 +314,69 @@ class PgModelerCliApp: public Application {
 		//! \brief Prints to the stdout only if the silent mode is not active
 		void printMessage(const QString &txt = "");
 
+		/*! \brief Prints to the stdout a single-line json record composed by the provided fields
+		plus the event name and a timestamp. The records form a newline delimited json stream that
+		can be consumed by orchestration tools to track the operation progress */
+		void printJsonEvent(const QString &event, QJsonObject fields);
+
+		/*! \brief Emits the phase-finished json record for the current operation phase, carrying
+		the amount of handled objects, the phase duration and the process memory high-water mark */
+		void finishJsonPhase();
+
+		/*! \brief Returns the process memory usage high-water mark, in kilobytes. Currently the
+		value is retrieved only on Linux (from /proc/self/status), being zero on other systems */
+		qint64 getMemoryPeak();
+
+		/*! \brief Returns the process current resident memory, in kilobytes. Like getMemoryPeak(),
+		the value is retrieved only on Linux, being zero on other systems */
+		qint64 getMemoryUsage();
+
+		/*! \brief Emits a warning (a single time per run) when the process resident memory exceeds
+		the budget informed through --max-memory. Does nothing when no budget is set */
+		void checkMemoryBudget();
+
 		void handleLinuxMimeDatabase(bool uninstall, bool system_wide, bool force);
 		void handleWindowsMimeDatabase(bool uninstall, bool system_wide, bool force);
 		void createConfigurations();
+
+		/*! \brief Packs the runtime assets under the input directory into a single indexed
+		 archive (see AssetArchive) written to the output file */
+		void packAssets();
+
 		void listConnections();
 
+		//! \brief Runs the operation (fix, import, diff or export) selected by the parsed options
+		void runOperation();
+
+		/*! \brief Generates a synthetic model with the provided shape and measures the code
+		generation, saving, loading and diff steps over it, printing timing statistics per step.
+		Used to compare pgModeler versions and hardware configurations in a reproducible way */
+		void runBenchmark();
+
+		//! \brief Builds the synthetic model (tables x columns x relationships) used by the benchmark
+		void generateSyntheticModel(unsigned tables_cnt, unsigned cols_cnt, unsigned rels_cnt);
+
+		//! \brief Prints the timing statistics (min/median/p99/max) of a benchmark step
+		void printBenchmarkStats(const QString &step, vector<qint64> &timings);
+
+		/*! \brief Discards the current database model (and the graphical scene contents when present)
+		recreating it from scratch, so consecutive runs in watch mode don't accumulate leftovers */
+		void resetModel();
+
+		/*! \brief Keeps the process resident watching the input model file and re-running the selected
+		operation whenever the file changes. This way consecutive runs triggered by model savings skip
+		the process startup, the Qt initialization and the schema files loading, all already warm */
+		void watchInputFile();
+
+		/*! \brief Processes the input model files by spawning one child cli process per file, keeping
+		up to --jobs of them running simultaneously. Child processes are used instead of threads since
+		the core libraries keep process wide registries (user defined data types, objects ids) that
+		can't be safely shared by models being handled concurrently */
+		void runParallelJobs();
+
+		//! \brief Returns the output path, inside the output directory, for the input file handled by a job
+		QString getJobOutputPath(const QString &input_file);
+
 	public:
 		PgModelerCliApp(int argc, char **argv);
 		virtual ~PgModelerCliApp();
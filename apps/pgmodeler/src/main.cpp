@@ -18,6 +18,10 @@
 
 #include "pgmodelerapp.h"
 #include "mainwindow.h"
+#include "stallwatchdog.h"
+#include "performancecounters.h"
+#include "schemaparser.h"
+#include "qtcompat/qtextstreamcompat.h"
 
 #ifndef Q_OS_WIN
 #include "execinfo.h"
@@ -96,11 +100,37 @@ int main(int argc, char **argv)
 		signal(SIGSEGV, startCrashHandler);
 		signal(SIGABRT, startCrashHandler);
 
+		/* Enabling the startup phase breakdown when --startup-timings is present. The flag is
+		 * detected on the raw argv since the instrumentation must be armed before the
+		 * application object (and everything it drags in) is constructed */
+		bool startup_timings=false;
+		QElapsedTimer phase_timer;
+
+		for(int i=1; i < argc && !startup_timings; i++)
+			startup_timings=(QString(argv[i])==QString("--startup-timings"));
+
+		if(startup_timings)
+			PerformanceCounters::setEnabled(true);
+
 		PgModelerApp::setAttribute(Qt::AA_UseHighDpiPixmaps);
 		PgModelerApp::setAttribute(Qt::AA_EnableHighDpiScaling);
+
+		phase_timer.start();
 		PgModelerApp app(argc,argv);
+		PerformanceCounters::addTiming("Startup: application init", phase_timer.nsecsElapsed());
+
 		int res=0;
 
+		/* Starting the UI stall watchdog: freezes of the main thread longer than the threshold
+		 * are reported, together with the subsystem that caused them, to the file indicated by
+		 * StallWatchdog::getReportFilePath(). The threshold (milliseconds) can be tuned via the
+		 * environment variable below; setting it to a negative value disables the watchdog */
+		bool wd_thres_ok=false;
+		int wd_threshold=qEnvironmentVariableIntValue("PGMODELER_STALL_THRESHOLD", &wd_thres_ok);
+
+		if(!wd_thres_ok || wd_threshold >= 0)
+			StallWatchdog::start(wd_thres_ok ? wd_threshold : StallWatchdog::DefaultThreshold);
+
 		//Loading the application splash screen
 		QSplashScreen splash;
 		QPixmap pix(QPixmap(QString(":images/images/pgmodeler_splash.png")));
@@ -110,15 +140,33 @@ int main(int argc, char **argv)
 		app.processEvents();
 
 		//Creates the main form
+		phase_timer.restart();
 		MainWindow fmain;
+		PerformanceCounters::addTiming("Startup: main window construction", phase_timer.nsecsElapsed());
+
+		/* Printing the startup phase breakdown (the phases recorded above plus the ones timed
+		 * inside the application/configuration loading code) and turning the counters off so
+		 * the instrumentation doesn't keep accumulating during the session */
+		if(startup_timings)
+		{
+			QTextStream out(stdout);
+			out << PerformanceCounters::dump() << QtCompat::endl;
+			PerformanceCounters::setEnabled(false);
+		}
 
 		fmain.show();
 		splash.finish(&fmain);
 
+		/* Precompiling the shipped schema templates on background workers right after the launch,
+		 * so the first export/diff of the session doesn't pay the tokenization of the whole
+		 * template set serially */
+		SchemaParser::precompileSchemaFiles(GlobalAttributes::getSchemasRootDir());
+
 		//Loading models via command line on MacOSX are disabled until the file association work correclty on that system
 #ifndef Q_OS_MAC
 		QStringList params=app.arguments();
 		params.pop_front();
+		params.removeAll(QString("--startup-timings"));
 
 		//If the user specifies a list of files to be loaded
 		if(!params.isEmpty())
@@ -126,6 +174,7 @@ int main(int argc, char **argv)
 #endif
 
 		res = app.exec();
+		StallWatchdog::stop();
 		app.closeAllWindows();
 
 		return res;
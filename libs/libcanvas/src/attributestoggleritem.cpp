@@ -17,6 +17,7 @@
 */
 
 #include "attributestoggleritem.h"
+#include "objectsscene.h"
 #include <QApplication>
 #include <QDesktopWidget>
 #include <QScreen>
@@ -314,6 +315,11 @@ void AttributesTogglerItem::configureButtons(const QRectF &rect)
 void AttributesTogglerItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
 	QGraphicsItem *parent = this->parentItem();
+	QElapsedTimer paint_timer;
+
+	if(ObjectsScene::isPaintStatsEnabled())
+		paint_timer.start();
+
 	RoundedRectItem::paint(painter, option, widget);
 
 	for(unsigned arr_id = 0; arr_id < 7; arr_id++)
@@ -336,6 +342,9 @@ void AttributesTogglerItem::paint(QPainter *painter, const QStyleOptionGraphicsI
 			painter->restore();
 		}
 	}
+
+	if(paint_timer.isValid())
+		ObjectsScene::registerItemPaintTime("AttributesTogglerItem", paint_timer.nsecsElapsed());
 }
 
 void AttributesTogglerItem::createButtonPolygons()
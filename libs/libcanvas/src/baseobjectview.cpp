@@ -536,6 +536,16 @@ void BaseObjectView::configurePlaceholder()
 	}
 }
 
+void BaseObjectView::requestConfiguration()
+{
+	ObjectsScene *obj_scene=dynamic_cast<ObjectsScene *>(this->scene());
+
+	if(obj_scene && obj_scene->enqueueObjectConfiguration(this))
+		return;
+
+	this->configureObject();
+}
+
 void BaseObjectView::__configureObject()
 {
 	BaseGraphicObject *graph_obj=dynamic_cast<BaseGraphicObject *>(this->getUnderlyingObject());
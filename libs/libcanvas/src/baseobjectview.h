@@ -205,6 +205,13 @@ class BaseObjectView: public QObject, public QGraphicsItemGroup {
 
 		int getLayersCount();
 
+	public slots:
+		/*! \brief Reconfigures the object immediately when it's exposed in some viewport, otherwise the
+		reconfiguration is queued in the parent scene and performed progressively in idle time (see
+		ObjectsScene::enqueueObjectConfiguration()). This keeps mass invalidations (e.g. theme switch,
+		metadata application) from blocking the UI reconfiguring objects that aren't visible */
+		void requestConfiguration();
+
 	protected slots:
 		//! \brief Make the basic object operations
 		void __configureObject();
@@ -21,6 +21,7 @@
 bool BaseTableView::hide_ext_attribs = false;
 bool BaseTableView::hide_tags = false;
 unsigned BaseTableView::attribs_per_page[2] = { 10, 5 };
+unsigned BaseTableView::lod_level = BaseTableView::FullDetailLod;
 
 BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 {
@@ -28,6 +29,7 @@ BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 		throw Exception(ErrorCode::AsgNotAllocattedObject, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
 	pending_geom_update = false;
+	lod_active = false;
 	body=new RoundedRectItem;
 	body->setRoundedCorners(RoundedRectItem::BottomLeftCorner | RoundedRectItem::BottomRightCorner);
 
@@ -121,6 +123,60 @@ bool BaseTableView::isTagsHidden()
 	return hide_tags;
 }
 
+void BaseTableView::setLevelOfDetailZoom(double zoom)
+{
+	if(zoom < FlatShapeLodZoom)
+		lod_level=FlatShapeLod;
+	else if(zoom < TitleOnlyLodZoom)
+		lod_level=TitleOnlyLod;
+	else
+		lod_level=FullDetailLod;
+}
+
+unsigned BaseTableView::getLevelOfDetail()
+{
+	return lod_level;
+}
+
+void BaseTableView::applyLevelOfDetail()
+{
+	QGraphicsItem *sections[]={ columns, ext_attribs, attribs_toggler, tag_item };
+	unsigned idx, cnt=sizeof(sections)/sizeof(QGraphicsItem *);
+
+	if(lod_level==FullDetailLod)
+	{
+		//Restoring the visibility of the children sections saved when the reduced level of detail was activated
+		if(lod_active)
+		{
+			for(idx=0; idx < cnt; idx++)
+				sections[idx]->setVisible(lod_sects_visible[idx]);
+
+			title->setTextsVisible(true);
+			lod_active=false;
+		}
+	}
+	else
+	{
+		/* Saving the current visibility of the children sections so it can be
+		 * restored once the full detail level is reactivated */
+		if(!lod_active)
+		{
+			for(idx=0; idx < cnt; idx++)
+				lod_sects_visible[idx]=sections[idx]->isVisible();
+
+			lod_active=true;
+		}
+
+		/* In the reduced levels of detail the children sections are kept hidden so the scene
+		 * doesn't even traverse their sub-items when repainting the viewport during panning/zooming.
+		 * The body/title rectangles stay visible preserving the overall shape of the table */
+		for(idx=0; idx < cnt; idx++)
+			sections[idx]->setVisible(false);
+
+		title->setTextsVisible(lod_level==TitleOnlyLod);
+	}
+}
+
 QVariant BaseTableView::itemChange(GraphicsItemChange change, const QVariant &value)
 {
 	if(change==ItemSelectedHasChanged)
@@ -70,6 +70,17 @@ class BaseTableView: public BaseObjectView {
 		//! brief Controls the maximum amount of attributes visible per page (columns/references + extended attributes)
 		static unsigned attribs_per_page[2];
 
+		//! \brief Current level of detail in which tables are rendered (see setLevelOfDetailZoom())
+		static unsigned lod_level;
+
+		/*! \brief Indicates that a reduced level of detail is currently applied to this table,
+		 * meaning that the visibility of the children sections was overriden (see applyLevelOfDetail()) */
+		bool lod_active;
+
+		/*! \brief Stores the visibility of the children sections prior to the activation of a reduced
+		 * level of detail so it can be restored once the full detail level is reactivated */
+		bool lod_sects_visible[4];
+
 		//! \brief Polygonal object that defines the table body
 		RoundedRectItem *body,
 
@@ -128,6 +139,15 @@ class BaseTableView: public BaseObjectView {
 		static constexpr unsigned LeftConnPoint=0,
 		RightConnPoint=1;
 
+		//! \brief Levels of detail in which tables can be rendered depending on the canvas zoom
+		static constexpr unsigned FullDetailLod=0,
+		TitleOnlyLod=1,
+		FlatShapeLod=2;
+
+		//! \brief Zoom factors below which the reduced levels of detail are activated
+		static constexpr double TitleOnlyLodZoom=0.25,
+		FlatShapeLodZoom=0.10;
+
 		BaseTableView(BaseTable *base_tab);
 		virtual ~BaseTableView();
 
@@ -147,6 +167,20 @@ class BaseTableView: public BaseObjectView {
 		//! \brief Hides the table tags. This applies to all table instances
 		static void setHideTags(bool value);
 
+		/*! \brief Defines the level of detail applied to all table/view instances based upon the provided zoom factor.
+		 * Below TitleOnlyLodZoom tables are rendered as title-only boxes and below FlatShapeLodZoom as flat rectangles.
+		 * This avoids repainting thousands of invisible sub-items (columns, icons, constraint decorators) when
+		 * panning huge models at low zoom. The new level takes effect on each table via applyLevelOfDetail() */
+		static void setLevelOfDetailZoom(double zoom);
+
+		//! \brief Returns the level of detail currently applied to all table/view instances
+		static unsigned getLevelOfDetail();
+
+		/*! \brief Applies the current level of detail to the table by toggling the visibility of its children
+		 * sections. Hidden children are completely ignored by the scene during repaints. The visibility
+		 * defined by the collapse mode/pagination is saved and restored when back to full detail */
+		void applyLevelOfDetail();
+
 		//! \brief Returns the current visibility state of extended attributes
 		static bool isExtAttributesHidden();
 
@@ -20,7 +20,7 @@
 
 GraphicalView::GraphicalView(View *view) : BaseTableView(view)
 {
-	connect(view, SIGNAL(s_objectModified()), this, SLOT(configureObject()));
+	connect(view, SIGNAL(s_objectModified()), this, SLOT(requestConfiguration()));
 
 	columns=new QGraphicsItemGroup;
 	columns->setZValue(1);
@@ -321,6 +321,11 @@ void GraphicalView::configureObject()
 	BaseObjectView::configureObjectSelection();
 	configureTag();
 	configureSQLDisabledInfo();
+
+	//Reapplying the current level of detail since the reconfiguration restores the children sections' visibility
+	lod_active=false;
+	applyLevelOfDetail();
+
 	requestRelationshipsUpdate();
 
 	if((old_width != 0 && this->bounding_rect.width() != old_width) ||
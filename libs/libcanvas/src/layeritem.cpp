@@ -18,6 +18,7 @@
 
 #include "layeritem.h"
 #include "baseobjectview.h"
+#include "objectsscene.h"
 #include "qtcompat/qfontmetricscompat.h"
 
 LayerItem::LayerItem(QGraphicsItem *parent) : QGraphicsPathItem(parent)
@@ -59,12 +60,22 @@ QColor LayerItem::getTextColor()
 
 void LayerItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	QElapsedTimer paint_timer;
+
+	if(ObjectsScene::isPaintStatsEnabled())
+		paint_timer.start();
+
 	painter->save();
 	QGraphicsPathItem::paint(painter, option, widget);
 	painter->restore();
 
 	if(text.isEmpty())
+	{
+		if(paint_timer.isValid())
+			ObjectsScene::registerItemPaintTime("LayerItem", paint_timer.nsecsElapsed());
+
 		return;
+	}
 
 	QFont font = getDefaultFont();
 	QFontMetrics fm(font);
@@ -89,6 +100,9 @@ void LayerItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 	}
 
 	painter->restore();
+
+	if(paint_timer.isValid())
+		ObjectsScene::registerItemPaintTime("LayerItem", paint_timer.nsecsElapsed());
 }
 
 QFont LayerItem::getDefaultFont()
@@ -17,6 +17,8 @@
 */
 
 #include "objectsscene.h"
+#include "qtcompat/qfontmetricscompat.h"
+#include "performancecounters.h"
 
 bool ObjectsScene::align_objs_grid=false;
 bool ObjectsScene::show_grid=true;
@@ -41,11 +43,17 @@ QColor ObjectsScene::delimiters_color = ObjectsScene::DefaultDelimitersColor;
 bool ObjectsScene::corner_move=true;
 bool ObjectsScene::invert_rangesel_trigger=false;
 
+bool ObjectsScene::paint_stats_enabled=false;
+QMap<QString, qint64> ObjectsScene::item_paint_times;
+
 ObjectsScene::ObjectsScene()
 {		
 	is_layer_rects_visible=is_layer_names_visible=false;
-	moving_objs=move_scene=false;
+	moving_objs=move_scene=batch_population=layer_rects_upd_scheduled=false;
+	layer_members_stale=true;
 	enable_range_sel=true;
+	grid_tile_scale=0;
+	grid_tile_key=0;
 	this->setBackgroundBrush(grid);
 
 	sel_ini_pnt.setX(DNaN);
@@ -74,6 +82,9 @@ ObjectsScene::ObjectsScene()
 		object_move_timer.stop();
 	});
 
+	cfg_queue_timer.setInterval(DeferredCfgInterval);
+	connect(&cfg_queue_timer, SIGNAL(timeout()), this, SLOT(processConfigurationQueue()));
+
 	scene_move_timer.setInterval(SceneMoveTimeout);
 	corner_hover_timer.setInterval(SceneMoveTimeout * 10);
 	object_move_timer.setInterval(SceneMoveTimeout * 10);
@@ -253,7 +264,6 @@ void ObjectsScene::removeLayers(bool reset_obj_layers)
 		return;
 
 	LayerItem *layer_path = nullptr;
-	BaseObjectView *obj_view = nullptr;
 	QString def_layer = layers[DefaultLayer];
 	bool is_active = active_layers.contains(def_layer);
 
@@ -276,15 +286,10 @@ void ObjectsScene::removeLayers(bool reset_obj_layers)
 
 	if(reset_obj_layers)
 	{
-		for(auto &item : this->items())
+		for(auto &obj_view : obj_views)
 		{
-			obj_view = dynamic_cast<BaseObjectView *>(item);
-
-			if(obj_view && !obj_view->parentItem())
-			{
-				obj_view->resetLayers();
-				obj_view->setVisible(is_active);
-			}
+			obj_view->resetLayers();
+			obj_view->setVisible(is_active);
 		}
 	}
 
@@ -310,42 +315,66 @@ void ObjectsScene::setActiveLayers(QStringList act_layers)
 
 void ObjectsScene::setActiveLayers(QList<unsigned> layers_idxs)
 {
-	BaseObjectView *obj_view = nullptr;
+	QList<unsigned> prev_idxs = getActiveLayersIds();
+	unsigned layer_cnt = static_cast<unsigned>(layers.size());
+
 	active_layers.clear();
 
 	if(!layers_idxs.isEmpty())
 	{
 		bool is_in_layer = false;
-		unsigned layer_cnt = static_cast<unsigned>(layers.size());
 		SchemaView *sch_view = nullptr;
+		QSet<BaseObjectView *> toggled_views;
 
-		for(auto &item : this->items())
+		if(layer_members_stale)
 		{
-			obj_view = dynamic_cast<BaseObjectView *>(item);
+			/* The layer assignments changed since the last update (objects added/removed or moved
+			 * between layers) so the visibility of every object view must be recomputed */
+			rebuildLayerMembers();
 
-			if(obj_view && !obj_view->parentItem())
+			for(auto &obj_view : obj_views)
+				toggled_views.insert(obj_view);
+		}
+		else
+		{
+			/* Only the members of the layers that effectively toggled need their visibility
+			 * recomputed. Objects in the untouched layers can't change state since the rest
+			 * of the active set is preserved */
+			for(auto &idx : layers_idxs)
 			{
-				sch_view = dynamic_cast<SchemaView *>(obj_view);
-				is_in_layer = false;
+				if(static_cast<int>(idx) < layer_members.size() && !prev_idxs.contains(idx))
+					toggled_views.unite(layer_members[idx]);
+			}
 
-				for(auto &idx : layers_idxs)
-				{
-					if(obj_view->isInLayer(idx))
-					{
-						is_in_layer = true;
-						break;
-					}
-				}
+			for(auto &idx : prev_idxs)
+			{
+				if(static_cast<int>(idx) < layer_members.size() && !layers_idxs.contains(idx))
+					toggled_views.unite(layer_members[idx]);
+			}
+		}
 
-				if(!obj_view->isVisible() && is_in_layer)
+		for(auto &obj_view : toggled_views)
+		{
+			sch_view = dynamic_cast<SchemaView *>(obj_view);
+			is_in_layer = false;
+
+			for(auto &idx : layers_idxs)
+			{
+				if(obj_view->isInLayer(idx))
 				{
-					if(!sch_view ||
-						 (sch_view && dynamic_cast<Schema *>(sch_view->getUnderlyingObject())->isRectVisible()))
-					 obj_view->setVisible(true);
+					is_in_layer = true;
+					break;
 				}
-				else if(obj_view->isVisible() && !is_in_layer)
-					obj_view->setVisible(false);
 			}
+
+			if(!obj_view->isVisible() && is_in_layer)
+			{
+				if(!sch_view ||
+					 (sch_view && dynamic_cast<Schema *>(sch_view->getUnderlyingObject())->isRectVisible()))
+				 obj_view->setVisible(true);
+			}
+			else if(obj_view->isVisible() && !is_in_layer)
+				obj_view->setVisible(false);
 		}
 
 		for(auto &idx : layers_idxs)
@@ -356,22 +385,53 @@ void ObjectsScene::setActiveLayers(QList<unsigned> layers_idxs)
 	}
 	else
 	{
-		for(auto &item : this->items())
-		{
-			obj_view = dynamic_cast<BaseObjectView *>(item);
-
-			if(obj_view && !obj_view->parentItem())
-				obj_view->setVisible(false);
-		}
+		for(auto &obj_view : obj_views)
+			obj_view->setVisible(false);
 	}
 
 	updateLayerRects();
 	emit s_activeLayersChanged();
 }
 
+void ObjectsScene::rebuildLayerMembers()
+{
+	int layer_cnt = layers.size();
+
+	layer_members.clear();
+	layer_members.resize(layer_cnt);
+
+	for(auto &obj_view : obj_views)
+	{
+		for(auto &layer_id : obj_view->getLayers())
+		{
+			if(static_cast<int>(layer_id) < layer_cnt)
+				layer_members[layer_id].insert(obj_view);
+		}
+	}
+
+	layer_members_stale = false;
+}
+
+void ObjectsScene::scheduleLayerRectsUpdate()
+{
+	if(layer_rects_upd_scheduled)
+		return;
+
+	layer_rects_upd_scheduled=true;
+
+	/* Recalculating the layer rects iterates over all object views so instead of running it
+	 * for each dimension change we schedule a single pass to the next event loop iteration */
+	QTimer::singleShot(0, this, [this](){
+		layer_rects_upd_scheduled=false;
+		updateLayerRects();
+	});
+}
+
 void ObjectsScene::updateLayerRects()
 {
-	if(layers_paths.isEmpty())
+	/* While the scene is being populated in batch the update is postponed,
+	 * a single pass is performed when the batch mode is disabled */
+	if(batch_population || layers_paths.isEmpty())
 		return;
 
 	for(auto &path : layers_paths)
@@ -381,48 +441,42 @@ void ObjectsScene::updateLayerRects()
 		return;
 
 	int idx = 0, act_layer_idx = 0;
-	BaseObjectView *obj_view = nullptr;
 	ObjectType obj_type;
 	QRectF brect;
 	QMap<int, QList<QRectF>> rects;
 	QFontMetricsF fm(LayerItem::getDefaultFont());
 
-	for(auto &item : this->items())
+	for(auto &obj_view : obj_views)
 	{
-		obj_view = dynamic_cast<BaseObjectView *>(item);
+		obj_type = 	obj_view->getUnderlyingObject()->getObjectType();
+
+		/* Schemas and relationship are ignored when determining the paths for the layers
+		 * because since these objects can have big bounding rects it may polute. For now
+		 * only table-like objects and textboxes can display layer boxes. */
+		if(obj_type == ObjectType::Schema ||
+			 obj_type ==ObjectType::BaseRelationship ||
+			 obj_type ==ObjectType::Relationship)
+			continue;
 
-		if(obj_view && !obj_view->parentItem())
+		brect = obj_view->boundingRect();
+		brect.moveTo(obj_view->pos());
+
+		for(auto &layer_id : obj_view->getLayers())
 		{
-			obj_type = 	obj_view->getUnderlyingObject()->getObjectType();
-
-			/* Schemas and relationship are ignored when determining the paths for the layers
-			 * because since these objects can have big bounding rects it may polute. For now
-			 * only table-like objects and textboxes can display layer boxes. */
-			if(obj_type == ObjectType::Schema ||
-				 obj_type ==ObjectType::BaseRelationship ||
-				 obj_type ==ObjectType::Relationship)
+			if(static_cast<int>(layer_id) >= layers.size() ||
+				 !active_layers.contains(layers.at(layer_id)))
 				continue;
 
-			brect = obj_view->boundingRect();
-			brect.moveTo(obj_view->pos());
+			/* We need to adjust the bounding rect dimension in such a way
+			 * to take into account the font height (if the layer names are visible)
+			 * as well as a default padding so the rectangles doesn't have the same size
+			 * of the object's bounding rect */
+			brect.adjust(-LayerItem::LayerPadding,
+									 (is_layer_names_visible ? -fm.height() : -LayerItem::LayerPadding),
+									 LayerItem::LayerPadding,
+									 LayerItem::LayerPadding);
 
-			for(auto &layer_id : obj_view->getLayers())
-			{
-				if(static_cast<int>(layer_id) >= layers.size() ||
-					 !active_layers.contains(layers.at(layer_id)))
-					continue;
-
-				/* We need to adjust the bounding rect dimension in such a way
-				 * to take into account the font height (if the layer names are visible)
-				 * as well as a default padding so the rectangles doesn't have the same size
-				 * of the object's bounding rect */
-				brect.adjust(-LayerItem::LayerPadding,
-										 (is_layer_names_visible ? -fm.height() : -LayerItem::LayerPadding),
-										 LayerItem::LayerPadding,
-										 LayerItem::LayerPadding);
-
-				rects[layer_id].append(brect);
-			}
+			rects[layer_id].append(brect);
 		}
 	}
 
@@ -462,44 +516,41 @@ bool ObjectsScene::isLayerNamesVisible()
 
 void ObjectsScene::validateLayerRemoval(unsigned old_layer)
 {
-	BaseObjectView *obj_view = nullptr;
 	unsigned total_layers = layers.size();
 	QList<unsigned> obj_layers;
 
 	if(old_layer == DefaultLayer || old_layer >= total_layers)
 		return;
 
-	for(auto &item : this->items())
+	for(auto &obj_view : obj_views)
 	{
-		obj_view = dynamic_cast<BaseObjectView *>(item);
-
-		if(obj_view && !obj_view->parentItem())
+		// Remove the object from the layer to be deleted and add it to the default one
+		if(obj_view->isInLayer(old_layer))
 		{
-			// Remove the object from the layer to be deleted and add it to the default one
-			if(obj_view->isInLayer(old_layer))
-			{
-				obj_view->removeFromLayer(old_layer);
-				obj_view->addToLayer(DefaultLayer);
-				obj_view->setVisible(isLayerActive(layers[DefaultLayer]));
-			}
-
-			/* Shifting the remainging layers ids if the layer to be removed is
-			 * >= 1 or < layers.size(). For example, if we have the following layers:
-			 * (0, 1, 2, 3). If the layer 1 is to be deleted, then there's the need to
-			 * shift the ids (2, 3) to (1, 2) since after the delition of the layer 1
-			 * the id 3 is invalid */
-			obj_layers = obj_view->getLayers();
+			obj_view->removeFromLayer(old_layer);
+			obj_view->addToLayer(DefaultLayer);
+			obj_view->setVisible(isLayerActive(layers[DefaultLayer]));
+		}
 
-			for(auto &layer_id : obj_layers)
-			{
-				if(layer_id > old_layer)
-					layer_id--;
-			}
+		/* Shifting the remainging layers ids if the layer to be removed is
+		 * >= 1 or < layers.size(). For example, if we have the following layers:
+		 * (0, 1, 2, 3). If the layer 1 is to be deleted, then there's the need to
+		 * shift the ids (2, 3) to (1, 2) since after the delition of the layer 1
+		 * the id 3 is invalid */
+		obj_layers = obj_view->getLayers();
 
-			obj_view->setLayers(obj_layers);
+		for(auto &layer_id : obj_layers)
+		{
+			if(layer_id > old_layer)
+				layer_id--;
 		}
+
+		obj_view->setLayers(obj_layers);
 	}
 
+	//The removal shifts the remaining layer ids so the per-layer registry is invalid
+	layer_members_stale = true;
+
 	emit s_objectsMovedLayer();
 }
 
@@ -549,6 +600,9 @@ QStringList ObjectsScene::getLayers()
 
 void ObjectsScene::updateActiveLayers()
 {
+	/* Callers use this method after changing the layer assignments of objects,
+	 * so the per-layer registry must be rebuilt and all the visibilities recomputed */
+	layer_members_stale = true;
 	setActiveLayers(active_layers);
 }
 
@@ -641,17 +695,32 @@ void ObjectsScene::setSceneRect(const QRectF &rect)
 
 QRectF ObjectsScene::itemsBoundingRect(bool seek_only_db_objs, bool selected_only)
 {
+	/* Reconfigurations still queued for off-screen objects must be finished first,
+	 * otherwise the dimensions of those objects may be outdated */
+	flushObjectsConfiguration();
+
 	if(!seek_only_db_objs)
 		return QGraphicsScene::itemsBoundingRect();
 	else
 	{
 		QRectF rect=QGraphicsScene::itemsBoundingRect();
-		QList<QGraphicsItem *> items= (selected_only ? this->selectedItems() : this->items());
+
+		/* When dealing with all objects we use the root object views registry instead of
+		 * QGraphicsScene::items() so the tables' sub-items aren't needlessly traversed */
+		QList<QGraphicsItem *> items;
 		double x=rect.width(), y=rect.height(), x2 = -10000, y2 = -10000;
 		BaseObjectView *obj_view=nullptr;
 		QPointF pnt;
 		BaseGraphicObject *graph_obj=nullptr;
 
+		if(selected_only)
+			items=this->selectedItems();
+		else
+		{
+			for(auto &vw : obj_views)
+				items.append(vw);
+		}
+
 		for(auto &item : items)
 		{
 			obj_view=dynamic_cast<BaseObjectView *>(item);
@@ -703,64 +772,70 @@ void ObjectsScene::setGridSize(unsigned size)
 {
 	if(size >= 20 || grid.style()==Qt::NoBrush)
 	{
-		QImage grid_img;
-		double width, height, x, y;
-		int img_w, img_h;
-		QSizeF aux_size;
-		QPrinter printer;
-		QPainter painter;
-		QPen pen;
-
-		configurePrinter(&printer);
-		aux_size=printer.paperSize(QPrinter::Point);
-		aux_size-=page_margins.size();
-
-		//Calculates where the extreme width and height where delimiter lines will be drawn
-		width=aux_size.width()/static_cast<double>(size) * size;
-		height=aux_size.height()/static_cast<double>(size) * size;
-
-		//Calculates the grid pixmpa size
-		img_w=ceil(width/size) * size;
-		img_h=ceil(height/size) * size;
-
 		grid_size=size;
-		grid_img=QImage(img_w, img_h, QImage::Format_ARGB32);
-		grid_img.fill(canvas_color);
-		painter.begin(&grid_img);
+		grid.setTextureImage(renderGridTile(1.0));
+	}
+}
 
-		if(show_grid)
-		{
-			pen.setColor(grid_color);
-			painter.setPen(pen);
+QImage ObjectsScene::renderGridTile(double scale)
+{
+	QImage grid_img;
+	double width, height, x, y;
+	int img_w, img_h;
+	QSizeF aux_size;
+	QPrinter printer;
+	QPainter painter;
+	QPen pen;
 
-			//Draws the grid
-			for(x=0; x < width; x+=size)
-				for(y=0; y < height; y+=size)
-					painter.drawRect(QRectF(QPointF(x,y),QPointF(x + size,y + size)));
-		}
+	configurePrinter(&printer);
+	aux_size=printer.paperSize(QPrinter::Point);
+	aux_size-=page_margins.size();
 
-		//Creates the page delimiter lines
-		if(show_page_delim)
-		{
-			pen.setColor(delimiters_color);
-			pen.setStyle(Qt::DashLine);
-			pen.setWidthF(1.0);
-			painter.setPen(pen);
-			painter.drawLine(width-1, 0,width-1,img_h-1);
-			painter.drawLine(0, height-1,img_w-1,height-1);
-		}
+	//Calculates where the extreme width and height where delimiter lines will be drawn
+	width=aux_size.width()/static_cast<double>(grid_size) * grid_size;
+	height=aux_size.height()/static_cast<double>(grid_size) * grid_size;
+
+	//Calculates the grid pixmpa size
+	img_w=ceil(width/grid_size) * grid_size;
+	img_h=ceil(height/grid_size) * grid_size;
+
+	grid_img=QImage(qRound(img_w * scale), qRound(img_h * scale), QImage::Format_ARGB32);
+	grid_img.fill(canvas_color);
+	painter.begin(&grid_img);
+
+	/* Scaled tiles are drawn with the same scene-unit coordinates, the painter transform
+	 * takes care of producing the device resolution version */
+	painter.scale(scale, scale);
+
+	if(show_grid)
+	{
+		pen.setColor(grid_color);
+		painter.setPen(pen);
 
-		painter.end();
-		grid.setTextureImage(grid_img);
+		//Draws the grid
+		for(x=0; x < width; x+=grid_size)
+			for(y=0; y < height; y+=grid_size)
+				painter.drawRect(QRectF(QPointF(x,y),QPointF(x + grid_size,y + grid_size)));
 	}
+
+	//Creates the page delimiter lines
+	if(show_page_delim)
+	{
+		pen.setColor(delimiters_color);
+		pen.setStyle(Qt::DashLine);
+		pen.setWidthF(1.0);
+		painter.setPen(pen);
+		painter.drawLine(width-1, 0,width-1,img_h-1);
+		painter.drawLine(0, height-1,img_w-1,height-1);
+	}
+
+	painter.end();
+	return grid_img;
 }
 
 void ObjectsScene::showRelationshipLine(bool value, const QPointF &p_start)
 {
-	QList<QGraphicsItem *> items=this->items();
 	QGraphicsItem::GraphicsItemFlags flags;
-	BaseObjectView *object=nullptr;
-	TableObjectView *tab_obj_view=nullptr;
 	BaseGraphicObject *base_obj=nullptr;
 
 	if(!std::isnan(p_start.x()) && !std::isnan(p_start.y()))
@@ -768,20 +843,17 @@ void ObjectsScene::showRelationshipLine(bool value, const QPointF &p_start)
 
 	rel_line->setVisible(value);
 
-	while(!items.isEmpty())
+	/* Only the root object views need their flags adjusted, their children (table objects views)
+	 * can't normally be selected by a single click so they are not traversed here */
+	for(auto &object : obj_views)
 	{
 		//When showing the relationship line all the objects cannot be moved
 		flags=QGraphicsItem::ItemIsSelectable |
 					QGraphicsItem::ItemSendsGeometryChanges;
 
-		object = dynamic_cast<BaseObjectView *>(items.front());
-		tab_obj_view = dynamic_cast<TableObjectView *>(object);
-
-		// Discarding table objects views from checking since they can't be normally be selected by a single click
-		if(object && !tab_obj_view && object->getUnderlyingObject())
+		if(object->getUnderlyingObject())
 		{
-			BaseObject *ul_object = object->getUnderlyingObject();
-			base_obj=dynamic_cast<BaseGraphicObject *>(ul_object);
+			base_obj=dynamic_cast<BaseGraphicObject *>(object->getUnderlyingObject());
 
 			if(!value && base_obj &&
 					base_obj->getObjectType()!=ObjectType::Relationship &&
@@ -795,8 +867,7 @@ void ObjectsScene::showRelationshipLine(bool value, const QPointF &p_start)
 					  QGraphicsItem::ItemSendsGeometryChanges;
 		}
 
-		items.front()->setFlags(flags);
-		items.pop_front();
+		object->setFlags(flags);
 	}
 }
 
@@ -832,6 +903,129 @@ bool ObjectsScene::isShowPageDelimiters()
 	return show_page_delim;
 }
 
+void ObjectsScene::setPaintStatsEnabled(bool value)
+{
+	if(value)
+		item_paint_times.clear();
+
+	paint_stats_enabled=value;
+}
+
+bool ObjectsScene::isPaintStatsEnabled()
+{
+	return paint_stats_enabled;
+}
+
+void ObjectsScene::registerItemPaintTime(const QString &class_name, qint64 nsecs)
+{
+	item_paint_times[class_name]+=nsecs;
+}
+
+void ObjectsScene::drawBackground(QPainter *painter, const QRectF &rect)
+{
+	/* The timer started here is read in drawForeground() so the interval
+	 * covers the painting of all items in the exposed region */
+	if(paint_stats_enabled || PerformanceCounters::isEnabled())
+		frame_timer.start();
+
+	double scl=painter->worldTransform().m11();
+
+	/* When the view is zoomed in, upscaling the shared grid texture is the heaviest part of the
+	 * background pass. In that case the grid is painted through a device resolution tile cached
+	 * per zoom factor, with a compensating brush transform so the paint engine performs a plain
+	 * tiled blit instead of a smooth upscale on every exposed region */
+	if(grid.style()==Qt::TexturePattern &&
+			scl > 1.0 && scl <= MaxCachedGridZoom &&
+			qFuzzyCompare(scl, painter->worldTransform().m22()))
+	{
+		if(grid_tile.isNull() ||
+				!qFuzzyCompare(grid_tile_scale, scl) ||
+				grid_tile_key!=grid.textureImage().cacheKey())
+		{
+			grid_tile=QPixmap::fromImage(renderGridTile(scl));
+			grid_tile_scale=scl;
+			grid_tile_key=grid.textureImage().cacheKey();
+		}
+
+		QBrush brush(grid_tile);
+		brush.setTransform(QTransform::fromScale(1.0/scl, 1.0/scl));
+		painter->fillRect(rect, brush);
+	}
+	else
+		QGraphicsScene::drawBackground(painter, rect);
+}
+
+void ObjectsScene::drawForeground(QPainter *painter, const QRectF &rect)
+{
+	QGraphicsScene::drawForeground(painter, rect);
+
+	//Feeding the frame time to the process-wide counter surface as well
+	if(PerformanceCounters::isEnabled() && frame_timer.isValid())
+		PerformanceCounters::addTiming("ObjectsScene::paintFrame", frame_timer.nsecsElapsed());
+
+	if(!paint_stats_enabled)
+		return;
+
+	double frame_time=(frame_timer.isValid() ? frame_timer.nsecsElapsed() / 1000000.0 : 0);
+	QStringList lines;
+	QMultiMap<qint64, QString> ranking;
+	QFont font=LayerItem::getDefaultFont();
+	QFontMetricsF fm(font);
+	double width=0, py=0;
+	int cnt=0;
+
+	lines.append(QString("Frame time: %1 ms").arg(QString::number(frame_time, 'f', 2)));
+	lines.append(QString("Items painted: %1").arg(this->items(rect, Qt::IntersectsItemBoundingRect).size()));
+	lines.append(QString("Repaint region: %1 x %2 @ %3 , %4")
+							 .arg(qRound(rect.width())).arg(qRound(rect.height()))
+							 .arg(qRound(rect.left())).arg(qRound(rect.top())));
+
+	//Ranking the item classes by their cumulative paint time
+	for(auto itr=item_paint_times.constBegin(); itr!=item_paint_times.constEnd(); itr++)
+		ranking.insert(itr.value(), itr.key());
+
+	if(!ranking.isEmpty())
+		lines.append("Cumulative paint time:");
+
+	QMapIterator<qint64, QString> itr(ranking);
+	itr.toBack();
+
+	while(itr.hasPrevious() && cnt < MaxRankedClasses)
+	{
+		itr.previous();
+		lines.append(QString("  %1: %2 ms").arg(itr.value(),
+								 QString::number(itr.key() / 1000000.0, 'f', 1)));
+		cnt++;
+	}
+
+	for(auto &line : lines)
+	{
+		if(QtCompat::horizontalAdvance(font, line) > width)
+			width=QtCompat::horizontalAdvance(font, line);
+	}
+
+	/* The overlay is drawn in device coordinates so it stays fixed at the
+	 * top-left corner of the viewport regardless of panning/zooming */
+	painter->save();
+	painter->resetTransform();
+	painter->setPen(Qt::NoPen);
+	painter->setBrush(QColor(0, 0, 0, 150));
+	painter->drawRect(QRectF(0, 0, width + (4 * LayerItem::LayerPadding),
+													 (fm.height() * lines.size()) + (2 * LayerItem::LayerPadding)));
+
+	painter->setPen(Qt::white);
+	painter->setFont(font);
+	py=LayerItem::LayerPadding + fm.ascent();
+
+	for(auto &line : lines)
+	{
+		painter->drawText(QPointF(2 * LayerItem::LayerPadding, py), line);
+		py+=fm.height();
+	}
+
+	painter->restore();
+}
+
 void ObjectsScene::setPaperConfiguration(QPrinter::PaperSize paper_sz, QPrinter::Orientation orient, QRectF margins, QSizeF custom_size)
 {
 	ObjectsScene::paper_size=paper_sz;
@@ -954,13 +1148,28 @@ void ObjectsScene::addItem(QGraphicsItem *item)
 
 			// Tables and textboxes are observed for dimension changes so the layers they are in are correctly updated
 			if(tab || txtbox)
-				connect(obj, SIGNAL(s_objectDimensionChanged()), this, SLOT(updateLayerRects()));
+				connect(obj, SIGNAL(s_objectDimensionChanged()), this, SLOT(scheduleLayerRectsUpdate()));
+
+			//Registering the root object view so the scene-wide operations don't need to scan the whole item list
+			if(!item->parentItem())
+			{
+				obj_views.append(obj);
+				layer_members_stale = true;
+			}
 		}
 
 		QGraphicsScene::addItem(item);
 
 		if(tab || txtbox)
 			updateLayerRects();
+
+		/* While the scene is being populated in batch the pending paint events are flushed
+		 * periodically so the portion of the diagram intersecting the viewport shows up
+		 * progressively instead of only after the whole model is constructed. User input
+		 * events are excluded to avoid reentrancy during the load */
+		if(batch_population && obj && !obj_views.isEmpty() &&
+			 (obj_views.size() % BatchRepaintInterval)==0)
+			qApp->processEvents(QEventLoop::ExcludeUserInputEvents);
 	}
 }
 
@@ -982,6 +1191,10 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 		{
 			BaseObject *obj = obj_view->getUnderlyingObject();
 
+			obj_views.removeOne(obj_view);
+			deferred_cfg_views.removeOne(obj_view);
+			layer_members_stale = true;
+
 			if(BaseTable::isBaseTable(obj->getObjectType()) ||
 				 obj->getObjectType() == ObjectType::Textbox)
 				updateLayerRects();
@@ -994,16 +1207,78 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 	}
 }
 
-void ObjectsScene::blockItemsSignals(bool block)
+bool ObjectsScene::isRectVisibleOnViews(const QRectF &rect)
+{
+	for(auto &view : this->views())
+	{
+		if(view->mapToScene(view->viewport()->rect()).boundingRect().intersects(rect))
+			return true;
+	}
+
+	return false;
+}
+
+bool ObjectsScene::enqueueObjectConfiguration(BaseObjectView *object)
 {
-	BaseObjectView *obj_view = nullptr;
+	/* Objects exposed in some viewport are always configured synchronously, the
+	 * deferral applies only to the off-screen ones. Scenes not attached to a view
+	 * (e.g. while exporting in CLI) have no notion of exposure so nothing is deferred */
+	if(!object || this->views().isEmpty() ||
+			isRectVisibleOnViews(object->sceneBoundingRect()))
+		return false;
+
+	if(!deferred_cfg_views.contains(object))
+		deferred_cfg_views.append(object);
 
-	for(auto &item : this->items())
+	if(!cfg_queue_timer.isActive())
+		cfg_queue_timer.start();
+
+	return true;
+}
+
+void ObjectsScene::processConfigurationQueue()
+{
+	BaseObjectView *obj_view=nullptr;
+	int processed=0, idx=0;
+
+	/* First, the queued objects that became exposed since they were enqueued are
+	 * configured so the user never faces an outdated object in the viewport */
+	while(idx < deferred_cfg_views.size() && processed < DeferredCfgBatchSize)
 	{
-		obj_view = dynamic_cast<BaseObjectView *>(item);
-		if(obj_view)
-			obj_view->blockSignals(block);
+		if(isRectVisibleOnViews(deferred_cfg_views[idx]->sceneBoundingRect()))
+		{
+			obj_view=deferred_cfg_views.takeAt(idx);
+			obj_view->configureObject();
+			processed++;
+		}
+		else
+			idx++;
 	}
+
+	//The remaining budget of the batch is spent on the off-screen objects
+	while(!deferred_cfg_views.isEmpty() && processed < DeferredCfgBatchSize)
+	{
+		obj_view=deferred_cfg_views.takeFirst();
+		obj_view->configureObject();
+		processed++;
+	}
+
+	if(deferred_cfg_views.isEmpty())
+		cfg_queue_timer.stop();
+}
+
+void ObjectsScene::flushObjectsConfiguration()
+{
+	while(!deferred_cfg_views.isEmpty())
+		deferred_cfg_views.takeFirst()->configureObject();
+
+	cfg_queue_timer.stop();
+}
+
+void ObjectsScene::blockItemsSignals(bool block)
+{
+	for(auto &obj_view : obj_views)
+		obj_view->blockSignals(block);
 }
 
 void ObjectsScene::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
@@ -1263,6 +1538,10 @@ void ObjectsScene::keyPressEvent(QKeyEvent *event)
 			sel_ini_pnt = brect.center();
 			moving_objs = true;
 
+			//Postponing the full relationship configuration while the objects are being moved
+			RelationshipView::setFastLineUpdate(true);
+			RelationshipView::setPlaceholderLines(selectedItems().size() >= PlaceholderLinesMinObjs);
+
 			/* If the object move timer is not active we need to send the
 			s_objectsMoved() signal in order to alert the classes like ModelWidget to
 			save the current objects' position in the operation history */
@@ -1367,6 +1646,13 @@ void ObjectsScene::mouseMoveEvent(QGraphicsSceneMouseEvent *event)
 
 				emit s_objectsMoved(false);
 				moving_objs=true;
+
+				//Postponing the full relationship configuration while the objects are being dragged
+				RelationshipView::setFastLineUpdate(true);
+
+				/* When a large amount of objects is dragged at once even the line-only updates are
+				 * too expensive, so the relationships degrade to placeholder lines until the drop */
+				RelationshipView::setPlaceholderLines(sel_items_count >= PlaceholderLinesMinObjs);
 			}
 
 			//If the alignment to grid is active, adjust the event scene position
@@ -1596,6 +1882,19 @@ void ObjectsScene::finishObjectsMove(const QPointF &pnt_end)
 	for(auto &obj : schemas)
 		obj->setModified(true);
 
+	/* Finishing the relationship configurations (descriptors/labels placement)
+	 * that were postponed while the objects were being moved */
+	RelationshipView::setFastLineUpdate(false);
+	RelationshipView::setPlaceholderLines(false);
+
+	for(auto &obj_view : obj_views)
+	{
+		rel=dynamic_cast<RelationshipView *>(obj_view);
+
+		if(rel)
+			rel->finishLineConfiguration();
+	}
+
 	emit s_objectsMoved(true);
 	moving_objs=false;
 	sel_ini_pnt.setX(DNaN);
@@ -1606,52 +1905,47 @@ void ObjectsScene::finishObjectsMove(const QPointF &pnt_end)
 
 void ObjectsScene::alignObjectsToGrid()
 {
-	QList<QGraphicsItem *> items=this->items();
 	RelationshipView *rel=nullptr;
 	BaseTableView *tab=nullptr;
 	TextboxView *lab=nullptr;
 	vector<QPointF> points;
 	vector<Schema *> schemas;
-	unsigned i, count, i1, count1;
+	unsigned i1, count1;
 
-	count=items.size();
-	for(i=0; i < count; i++)
+	for(auto &obj_view : obj_views)
 	{
-		if(dynamic_cast<QGraphicsItemGroup *>(items[i]) && !items[i]->parentItem())
+		tab=dynamic_cast<BaseTableView *>(obj_view);
+		rel=dynamic_cast<RelationshipView *>(obj_view);
+
+		if(tab)
+			tab->setPos(this->alignPointToGrid(tab->pos()));
+		else if(rel)
 		{
-			tab=dynamic_cast<BaseTableView *>(items[i]);
-			rel=dynamic_cast<RelationshipView *>(items[i]);
+			//Align the relationship points
+			points=rel->getUnderlyingObject()->getPoints();
+			count1=points.size();
+			for(i1=0; i1 < count1; i1++)
+				points[i1]=this->alignPointToGrid(points[i1]);
 
-			if(tab)
-				tab->setPos(this->alignPointToGrid(tab->pos()));
-			else if(rel)
+			if(count1 > 0)
 			{
-				//Align the relationship points
-				points=rel->getUnderlyingObject()->getPoints();
-				count1=points.size();
-				for(i1=0; i1 < count1; i1++)
-					points[i1]=this->alignPointToGrid(points[i1]);
-
-				if(count1 > 0)
-				{
-					rel->getUnderlyingObject()->setPoints(points);
-					rel->configureLine();
-				}
+				rel->getUnderlyingObject()->setPoints(points);
+				rel->configureLine();
+			}
 
-				//Align the labels
-				for(i1=BaseRelationship::SrcCardLabel;
-					i1<=BaseRelationship::RelNameLabel; i1++)
-				{
-					lab=rel->getLabel(i1);
-					if(lab)
-						lab->setPos(this->alignPointToGrid(lab->pos()));
-				}
+			//Align the labels
+			for(i1=BaseRelationship::SrcCardLabel;
+				i1<=BaseRelationship::RelNameLabel; i1++)
+			{
+				lab=rel->getLabel(i1);
+				if(lab)
+					lab->setPos(this->alignPointToGrid(lab->pos()));
 			}
-			else if(!dynamic_cast<SchemaView *>(items[i]))
-				items[i]->setPos(this->alignPointToGrid(items[i]->pos()));
-			else
-				schemas.push_back(dynamic_cast<Schema *>(dynamic_cast<BaseObjectView *>(items[i])->getUnderlyingObject()));
 		}
+		else if(!dynamic_cast<SchemaView *>(obj_view))
+			obj_view->setPos(this->alignPointToGrid(obj_view->pos()));
+		else
+			schemas.push_back(dynamic_cast<Schema *>(obj_view->getUnderlyingObject()));
 	}
 
 	//Updating schemas dimensions
@@ -1670,6 +1964,38 @@ void ObjectsScene::update()
 	QGraphicsScene::update(this->sceneRect());
 }
 
+void ObjectsScene::setBatchPopulationEnabled(bool value)
+{
+	if(batch_population==value)
+		return;
+
+	batch_population=value;
+
+	//Performing the layer rects update postponed while the batch population was active
+	if(!batch_population)
+		updateLayerRects();
+}
+
+void ObjectsScene::setLevelOfDetailZoom(double zoom)
+{
+	unsigned prev_lod=BaseTableView::getLevelOfDetail();
+	BaseTableView *tab_view=nullptr;
+
+	BaseTableView::setLevelOfDetailZoom(zoom);
+
+	//Avoiding reconfiguring the whole scene when the level of detail stays the same
+	if(BaseTableView::getLevelOfDetail()==prev_lod)
+		return;
+
+	for(auto &obj_view : obj_views)
+	{
+		tab_view=dynamic_cast<BaseTableView *>(obj_view);
+
+		if(tab_view)
+			tab_view->applyLevelOfDetail();
+	}
+}
+
 void ObjectsScene::clearTablesChildrenSelection()
 {
 	for(auto &tab_obj_view : tabs_sel_children)
@@ -58,6 +58,33 @@ class ObjectsScene: public QGraphicsScene {
 
 		vector<BaseObjectView *> removed_objs;
 
+		/*! \brief Registry of the root object views (tables, views, relationships, textboxes and schemas)
+		 * currently in the scene. It is kept in sync by addItem()/removeItem() and used by the operations
+		 * that visit all database objects, avoiding the traversal of the whole item list returned by
+		 * QGraphicsScene::items() which also includes every table sub-item (columns, icons, etc) */
+		QList<BaseObjectView *> obj_views;
+
+		/*! \brief Per-layer registry of the object views, indexed by layer id. It is rebuilt lazily
+		 * (see rebuildLayerMembers()) and allows setActiveLayers() to update the visibility of only
+		 * the members of the layers that effectively toggled instead of visiting the whole scene */
+		QList<QSet<BaseObjectView *>> layer_members;
+
+		/*! \brief Stores the object views with off-screen reconfigurations pending. The queue is drained
+		 * in batches by cfg_queue_timer, exposed objects first, so mass invalidations (e.g. a theme switch)
+		 * don't reconfigure in a single blocking pass items nobody can see (see enqueueObjectConfiguration()) */
+		QList<BaseObjectView *> deferred_cfg_views;
+
+		//! \brief Timer that progressively drains the deferred configuration queue
+		QTimer cfg_queue_timer;
+
+		//! \brief Returns true when the passed rect, in scene coordinates, intersects the visible area of some viewport
+		bool isRectVisibleOnViews(const QRectF &rect);
+
+		/*! \brief Indicates that layer_members no longer reflects the objects' layer assignments and
+		 * must be rebuilt before being used. Set whenever objects enter/leave the scene, move between
+		 * layers or when layers are removed (which shifts the remaining layer ids) */
+		bool layer_members_stale;
+
 		//! \brief Holds the tables/views which have selected children objects
 		QList<BaseTableView *> tabs_sel_children;
 
@@ -73,7 +100,21 @@ class ObjectsScene: public QGraphicsScene {
 
 		static constexpr int SceneMoveStep=20,
 		SceneMoveTimeout=50,
-		SceneMoveThreshold=30;
+		SceneMoveThreshold=30,
+
+		/*! \brief Amount of object views inserted in batch population mode between two
+		flushes of the pending paint events (see addItem()) */
+		BatchRepaintInterval=50,
+
+		/*! \brief Minimum amount of selected items in a drag operation that causes the attached
+		relationships to be drawn as placeholder lines until the objects are dropped
+		(see RelationshipView::setPlaceholderLines()) */
+		PlaceholderLinesMinObjs=25,
+
+		/*! \brief Amount of deferred object reconfigurations performed per tick of cfg_queue_timer
+		as well the interval, in milliseconds, between two ticks (see enqueueObjectConfiguration()) */
+		DeferredCfgBatchSize=50,
+		DeferredCfgInterval=16;
 
 		//! \brief Timer responsible to move the scene
 		QTimer scene_move_timer,
@@ -97,9 +138,40 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Object alignemnt, grid showing, page delimiter showing options
 		static bool align_objs_grid, show_grid, show_page_delim;
 
+		//! \brief Indicates that the paint time statistics collection and overlay are enabled
+		static bool paint_stats_enabled;
+
+		/*! \brief Cumulative paint time, in nanoseconds, per item class. The values are
+		accumulated by the items' paint() methods (see registerItemPaintTime()) */
+		static QMap<QString, qint64> item_paint_times;
+
+		//! \brief Maximum amount of item classes displayed in the paint stats overlay ranking
+		static constexpr int MaxRankedClasses=5;
+
+		/*! \brief Timer used to measure the time spent painting each frame. It is started in
+		drawBackground() and read in drawForeground() (see the paint stats overlay) */
+		QElapsedTimer frame_timer;
+
 		//! \brief Scene grid size
 		static unsigned grid_size;
 
+		//! \brief Maximum zoom factor for which drawBackground() caches a device resolution grid tile
+		static constexpr double MaxCachedGridZoom=4.0;
+
+		/*! \brief Device resolution copy of the grid tile used by drawBackground() when the view is
+		zoomed in, avoiding the upscaling of the shared grid texture on every exposed region.
+		Rebuilt only when the zoom factor or the grid configuration changes */
+		QPixmap grid_tile;
+
+		//! \brief Zoom factor in which the cached grid tile was rendered
+		double grid_tile_scale;
+
+		//! \brief Cache key of the grid texture from which the cached grid tile was derived
+		qint64 grid_tile_key;
+
+		//! \brief Renders the grid/page delimiter tile at the specified scale factor (device pixels per scene unit)
+		static QImage renderGridTile(double scale);
+
 		//! \brief Paper size, used to segmentate the view (via page delimiters) and printing the model
 		static QPrinter::PaperSize paper_size;
 
@@ -122,7 +194,16 @@ class ObjectsScene: public QGraphicsScene {
 		is_layer_rects_visible,
 
 		//! \brief Indicates if the layers names in the rects around the object must be displayed
-		is_layer_names_visible;
+		is_layer_names_visible,
+
+		/*! \brief Indicates that the scene is being populated in batch (see setBatchPopulationEnabled())
+		causing the per insertion layer rects updates to be postponed and the pending paint
+		events to be periodically flushed so the diagram shows up progressively */
+		batch_population,
+
+		/*! \brief Indicates that a layer rects update is already scheduled to happen when
+		the control returns to the event loop (see scheduleLayerRectsUpdate()) */
+		layer_rects_upd_scheduled;
 
 		//! \brief Initial point of selection rectangle
 		QPointF sel_ini_pnt;
@@ -156,6 +237,13 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Brush used to draw the grid over the scene
 		static QBrush grid;
 
+		void drawBackground(QPainter *painter, const QRectF &rect);
+
+		/*! \brief Besides the default foreground drawing, this method draws the paint statistics
+		overlay (frame time, painted items, repaint region and the item classes accumulating
+		more paint time) when the statistics collection is enabled */
+		void drawForeground(QPainter *painter, const QRectF &rect);
+
 		void mousePressEvent(QGraphicsSceneMouseEvent *event);
 		void mouseMoveEvent(QGraphicsSceneMouseEvent *event);
 		void mouseReleaseEvent(QGraphicsSceneMouseEvent *event);
@@ -173,6 +261,11 @@ class ObjectsScene: public QGraphicsScene {
 		 * greater than 0 or less than the maximum of layers minus 1, avoiding references to invalid layer ids. */
 		void validateLayerRemoval(unsigned old_layer);
 
+		/*! \brief Rebuilds the per-layer registry of object views (layer_members) from the current
+		 * layer assignments of the objects in the scene. Called on demand by setActiveLayers()
+		 * when the registry is flagged as stale */
+		void rebuildLayerMembers();
+
 		/*! \brief Add a several layers at once. This method will resolve name conflicts automatically.
 		 * This method removes all the current layers (except the first) and add the new ones.
 		 * The parameter reset_objs_layers is used to define if the objects should be moved to the default
@@ -263,6 +356,15 @@ class ObjectsScene: public QGraphicsScene {
 		static bool isShowGrid();
 		static bool isShowPageDelimiters();
 
+		/*! \brief Enables the collection of paint time statistics as well the overlay that displays
+		 * them on the canvas. The cumulative statistics are reset whenever the collection is enabled */
+		static void setPaintStatsEnabled(bool value);
+		static bool isPaintStatsEnabled();
+
+		/*! \brief Accumulates the time (in nanoseconds) spent by an item class in its paint() method.
+		 * Called by the items' paint() implementations when the paint statistics are enabled */
+		static void registerItemPaintTime(const QString &class_name, qint64 nsecs);
+
 		static void setPaperConfiguration(QPrinter::PaperSize paper_sz, QPrinter::Orientation orient, QRectF margins, QSizeF custom_size=QSizeF(0,0));
 		static void getPaperConfiguration(QPrinter::PaperSize &paper_sz, QPrinter::Orientation &orient, QRectF &margins, QSizeF &custom_size);
 
@@ -273,6 +375,16 @@ class ObjectsScene: public QGraphicsScene {
 		void removeItem(QGraphicsItem *item);
 		void setSceneRect(const QRectF &rect);
 
+		/*! \brief Defines the level of detail of all tables/views in the scene based upon the provided
+		 * zoom factor (see BaseTableView::setLevelOfDetailZoom()). The visibility of the tables' children
+		 * is reconfigured only when the provided zoom causes the level of detail to change */
+		void setLevelOfDetailZoom(double zoom);
+
+		/*! \brief Toggles the batch population mode used while a model is being loaded. In this mode the
+		 * layer rects updates normally triggered by each item insertion/reconfiguration are postponed;
+		 * when the mode is disabled a single update pass is performed */
+		void setBatchPopulationEnabled(bool value);
+
 		//! \brief Aligns the specified point in relation to the grid
 		static QPointF alignPointToGrid(const QPointF &pnt);
 
@@ -289,6 +401,16 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Returns a vector containing all the page rects.
 		vector<QRectF> getPagesForPrinting(const QSizeF &paper_size, const QSizeF &margin, unsigned &h_page_cnt, unsigned &v_page_cnt);
 
+		/*! \brief Queues the reconfiguration of an object view that isn't exposed in any viewport,
+		performing it progressively in idle time. Returns false when the object is currently exposed
+		(or the scene isn't attached to a view), in which case the caller must configure the object
+		synchronously (see BaseObjectView::requestConfiguration()) */
+		bool enqueueObjectConfiguration(BaseObjectView *object);
+
+		/*! \brief Immediately performs all the queued object reconfigurations. Called by the operations
+		that rely on up-to-date geometry of every object view (e.g. itemsBoundingRect()) */
+		void flushObjectsConfiguration();
+
 		bool isRangeSelectionEnabled();
 		bool isRangeSelectionTriggerInverted();
 		bool isRelationshipLineVisible();
@@ -327,6 +449,15 @@ class ObjectsScene: public QGraphicsScene {
 		whenever the user stay with the cursor at corner in a certain amount of time */
 		void enableSceneMove(bool value=true);
 
+		/*! \brief Performs a batch of queued object reconfigurations, prioritizing the objects
+		that became exposed in some viewport since they were queued */
+		void processConfigurationQueue();
+
+		/*! \brief Schedules a single call to updateLayerRects() to happen when the control returns
+		to the event loop, coalescing bursts of dimension changes (e.g. several objects being
+		reconfigured at once) into one layer rects recalculation */
+		void scheduleLayerRectsUpdate();
+
 		//! \brief Moves the scene when the user puts the mouse cursor on one of scene's edges
 		void moveObjectScene();
 
@@ -23,6 +23,8 @@ bool RelationshipView::hide_name_label=false;
 bool RelationshipView::use_curved_lines=true;
 bool RelationshipView::use_crows_foot=false;
 unsigned RelationshipView::line_conn_mode=RelationshipView::ConnectFkToPk;
+bool RelationshipView::fast_line_update=false;
+bool RelationshipView::placeholder_lines=false;
 
 RelationshipView::RelationshipView(BaseRelationship *rel) : BaseObjectView(rel)
 {
@@ -45,6 +47,8 @@ RelationshipView::RelationshipView(BaseRelationship *rel) : BaseObjectView(rel)
 	sel_object=nullptr;
 	sel_object_idx=-1;
 	configuring_line=false;
+	pending_full_cfg=false;
+	ph_line=nullptr;
 	using_placeholders=BaseObjectView::isPlaceholderEnabled();
 
 	descriptor=new QGraphicsPolygonItem;
@@ -128,6 +132,12 @@ RelationshipView::~RelationshipView()
 	this->removeFromGroup(descriptor);
 	delete descriptor;
 
+	if(ph_line)
+	{
+		this->removeFromGroup(ph_line);
+		delete ph_line;
+	}
+
 	for(int i =0; i < 2; i++)
 	{
 		if(cf_descriptors[i])
@@ -196,6 +206,50 @@ unsigned RelationshipView::getLineConnectinMode()
 	return line_conn_mode;
 }
 
+void RelationshipView::setFastLineUpdate(bool value)
+{
+	fast_line_update=value;
+}
+
+bool RelationshipView::isFastLineUpdate()
+{
+	return fast_line_update;
+}
+
+void RelationshipView::setPlaceholderLines(bool value)
+{
+	placeholder_lines=value;
+}
+
+bool RelationshipView::isPlaceholderLines()
+{
+	return placeholder_lines;
+}
+
+void RelationshipView::finishLineConfiguration()
+{
+	if(ph_line && ph_line->isVisible())
+	{
+		/* Restoring the visibility of the line items hidden by the placeholder segment.
+		 * The full configuration below readjusts/destroys them as needed */
+		vector<vector<QGraphicsLineItem *> *> rel_lines = { &lines, &fk_lines, &pk_lines };
+
+		for(auto &line_list : rel_lines)
+		{
+			for(auto &line : *line_list)
+				line->setVisible(true);
+		}
+
+		for(auto &curve : curves)
+			curve->setVisible(true);
+
+		ph_line->setVisible(false);
+	}
+
+	if(pending_full_cfg)
+		configureLine();
+}
+
 QPointF RelationshipView::getConnectionPoint(unsigned table_idx)
 {
 	if(table_idx > 2)
@@ -540,9 +594,9 @@ void RelationshipView::connectTables()
 			if(BaseObjectView::isPlaceholderEnabled())
 				connect(tables[i], SIGNAL(s_relUpdateRequest()), this, SLOT(configureLine()));
 			else
-				connect(tables[i], SIGNAL(s_objectMoved()), this, SLOT(configureLine()));
+				connect(tables[i], SIGNAL(s_objectMoved()), this, SLOT(configureLineOnChange()));
 
-			connect(tables[i], SIGNAL(s_objectDimensionChanged()), this, SLOT(configureLine()));
+			connect(tables[i], SIGNAL(s_objectDimensionChanged()), this, SLOT(configureLineOnChange()));
 		}
 	}
 }
@@ -574,6 +628,20 @@ void RelationshipView::configurePositionInfo()
 	}
 }
 
+void RelationshipView::configureLineOnChange()
+{
+	if(!tables[0] || !tables[1])
+		return;
+
+	QRectF src_rect(tables[0]->pos(), tables[0]->boundingRect().size()),
+			dst_rect(tables[1]->pos(), tables[1]->boundingRect().size());
+
+	if(src_rect == cached_tab_rects[0] && dst_rect == cached_tab_rects[1])
+		return;
+
+	configureLine();
+}
+
 void RelationshipView::configureLine()
 {
 	//Reconnect the tables is the placeholder usage changes
@@ -614,6 +682,54 @@ void RelationshipView::configureLine()
 		configuring_line=true;
 		pen.setCapStyle(Qt::RoundCap);
 
+		//Caching the anchors geometry so redundant geometry notifications are ignored (see configureLineOnChange())
+		for(i=0; i < 2; i++)
+			cached_tab_rects[i]=QRectF(tables[i]->pos(), tables[i]->boundingRect().size());
+
+		/* While a heavy multi-object drag is in progress the whole line is replaced by a single
+		 * placeholder segment between the tables' centers. The detailed line items are hidden on
+		 * the first pass and restored by finishLineConfiguration() when the objects are dropped */
+		if(fast_line_update && placeholder_lines && !base_rel->isSelfRelationship())
+		{
+			if(!ph_line)
+			{
+				ph_line=new QGraphicsLineItem;
+				ph_line->setZValue(-1);
+				this->addToGroup(ph_line);
+			}
+
+			if(!ph_line->isVisible())
+			{
+				vector<vector<QGraphicsLineItem *> *> rel_lines = { &lines, &fk_lines, &pk_lines };
+
+				pen=BaseObjectView::getBorderStyle(Attributes::Relationship);
+				pen.setStyle(Qt::DotLine);
+				pen.setWidthF(pen_mid_width);
+				ph_line->setPen(pen);
+				ph_line->setVisible(true);
+
+				for(auto &line_list : rel_lines)
+				{
+					for(auto &line : *line_list)
+						line->setVisible(false);
+				}
+
+				for(auto &curve : curves)
+					curve->setVisible(false);
+
+				line_circles[0]->setVisible(false);
+				line_circles[1]->setVisible(false);
+			}
+
+			for(i=0; i < 2; i++)
+				conn_points[i]=tables[i]->getCenter();
+
+			ph_line->setLine(QLineF(conn_points[0], conn_points[1]));
+			pending_full_cfg=true;
+			configuring_line=false;
+			return;
+		}
+
 		if(base_rel->isSelfRelationship())
 		{
 			double fnt_factor=font_config[Attributes::Global].font().pointSizeF()/DefaultFontSize,
@@ -1231,6 +1347,18 @@ void RelationshipView::configureLine()
 			}
 		}
 
+		/* While objects are being dragged only the line segments are recomputed, the placement
+		 * of descriptors/labels and the tooltip updates are postponed to the end of the movement
+		 * (see ObjectsScene::finishObjectsMove()) */
+		if(fast_line_update)
+		{
+			pending_full_cfg=true;
+			configuring_line=false;
+			return;
+		}
+
+		pending_full_cfg=false;
+
 		this->configureDescriptor();
 
 		this->configureCrowsFootDescriptors();
@@ -54,12 +54,28 @@ class RelationshipView: public BaseObjectView {
 		makes the line start from the fk columns on receiver table and connecting to the pk columns on reference table */
 		static unsigned line_conn_mode;
 
+		/*! \brief When enabled, configureLine() recomputes only the line segments postponing the
+		placement of descriptors and labels as well as tooltip updates. This flag is activated by
+		ObjectsScene while objects are being dragged so tables with many attached relationships
+		stay responsive during the movement */
+		static bool fast_line_update;
+
+		/*! \brief When enabled together with the fast line update, configureLine() degrades to a single
+		placeholder segment drawn between the tables' center points, hiding the detailed line items.
+		Activated by ObjectsScene while a large amount of objects is being dragged at once. Not related
+		to the table placeholders toggled by the user settings (see BaseObjectView::isPlaceholderEnabled()) */
+		static bool placeholder_lines;
+
 		/*! \brief Indicate that the line is being configured/updated. This flag is used to evict
 		 that the configureLine() method is exceedingly called during the table moving. */
 		bool configuring_line,
 
 		//! \brief Indicates if the instance is configured to use placeholders
-		using_placeholders;
+		using_placeholders,
+
+		/*! \brief Indicates that the last call to configureLine() was done in fast mode thus the
+		descriptors/labels placement is pending (see finishLineConfiguration()) */
+		pending_full_cfg;
 
 		//! \brief Stores the graphical representation for labels
 		TextboxView *labels[3];
@@ -74,6 +90,11 @@ class RelationshipView: public BaseObjectView {
 		attribute stores the middle point between the connection points of each table */
 		QPointF conn_points[2];
 
+		/*! \brief Stores the geometry (position + dimension) of the participant tables observed by the
+		last full execution of configureLine(). Geometry-driven notifications re-route the line only
+		when at least one endpoint differs from these cached anchors (see configureLineOnChange()) */
+		QRectF cached_tab_rects[2];
+
 		//! \brief Graphical representation for the user added points
 		vector<QGraphicsPolygonItem *> graph_points;
 
@@ -92,6 +113,10 @@ class RelationshipView: public BaseObjectView {
 		//! \brief Relationship descriptor (lozenge -> (1,n)-(1,n) relationship, triangle -> inheritance)
 		QGraphicsPolygonItem *descriptor;
 
+		/*! \brief Cheap single-segment line shown in place of the detailed line items while a heavy
+		multi-object drag is in progress (see placeholder_lines). Allocated on demand */
+		QGraphicsLineItem *ph_line;
+
 		//! \brief Stores the current hovered child object
 		QGraphicsItem *sel_object;
 
@@ -157,6 +182,12 @@ class RelationshipView: public BaseObjectView {
 		//! \brief Makes the comple relationship configuration
 		void configureObject();
 
+		/*! \brief Reconfigures the line in response to geometry notifications of the participant tables.
+		The tables emit several move/dimension signals for the same effective geometry (and a relationship
+		whose both endpoints are dragged in the same selection is notified once per endpoint), so the
+		expensive routing in configureLine() runs only when an endpoint anchor effectively changed */
+		void configureLineOnChange();
+
 	public:
 		static constexpr unsigned ConnectCenterPoints=0,
 		ConnectFkToPk=1,
@@ -198,6 +229,25 @@ class RelationshipView: public BaseObjectView {
 		//! \brief Returns the line connection mode used for the relationships
 		static unsigned getLineConnectinMode();
 
+		/*! \brief Toggles the fast line update mode in which only the line segments are recomputed
+		by configureLine(). While disabling it the postponed configurations must be finished by
+		calling finishLineConfiguration() on the affected relationships */
+		static void setFastLineUpdate(bool value);
+
+		//! \brief Returns the current state of the fast line update mode
+		static bool isFastLineUpdate();
+
+		/*! \brief Toggles the placeholder line mode in which the whole relationship line is replaced
+		by a single segment between the tables' centers while objects are being dragged. Only effective
+		when the fast line update mode is also enabled */
+		static void setPlaceholderLines(bool value);
+
+		//! \brief Returns the current state of the placeholder line mode
+		static bool isPlaceholderLines();
+
+		//! \brief Performs a full line configuration if the last one was postponed by the fast update mode
+		void finishLineConfiguration();
+
 		/*! \brief Returns the connection point for the specified table. The connection point is
 		 where the relationship is connected on envolved tables. The point returned deffers depending on the
 		 line connection mode used.	*/
@@ -18,6 +18,8 @@
 
 #include "roundedrectitem.h"
 
+QMap<QString, QVector<QPointF>> RoundedRectItem::corner_arcs;
+
 RoundedRectItem::RoundedRectItem(QGraphicsItem *parent) :  QGraphicsRectItem(parent)
 {
 	radius=5;
@@ -105,22 +107,37 @@ void RoundedRectItem::createPolygon()
 
 QVector<QPointF> RoundedRectItem::calculatePoints(QPointF start_pnt, double start_angle, double end_angle)
 {
-	QVector<QPointF> points;
-	QLineF lin;
-	double inc=(start_angle > end_angle ? -10 : 10), ang=start_angle;
-	bool end=false;
+	QString key=QString("%1:%2:%3").arg(radius).arg(start_angle).arg(end_angle);
 
-	while(!end)
+	/* The arc points depend only on the radius and on the angle range so they are computed
+	 * around the origin only once and shared by all instances, being just translated to
+	 * the corner position when used */
+	if(!corner_arcs.contains(key))
 	{
-		lin.setP1(start_pnt);
-		lin.setLength(radius);
-		lin.setAngle(ang);
-		points.append(lin.p2());
-		ang+=inc;
-
-		end=((inc > 0 && ang > end_angle) ||
-			 (inc < 0 && ang < end_angle));
+		QVector<QPointF> arc;
+		QLineF lin;
+		double inc=(start_angle > end_angle ? -10 : 10), ang=start_angle;
+		bool end=false;
+
+		while(!end)
+		{
+			lin.setP1(QPointF(0,0));
+			lin.setLength(radius);
+			lin.setAngle(ang);
+			arc.append(lin.p2());
+			ang+=inc;
+
+			end=((inc > 0 && ang > end_angle) ||
+				 (inc < 0 && ang < end_angle));
+		}
+
+		corner_arcs[key]=arc;
 	}
 
+	QVector<QPointF> points=corner_arcs[key];
+
+	for(auto &pnt : points)
+		pnt+=start_pnt;
+
 	return points;
 }
@@ -27,9 +27,15 @@
 
 #include <QGraphicsRectItem>
 #include <QPainter>
+#include <QMap>
 
 class RoundedRectItem: public QGraphicsRectItem {
 	private:
+		/*! \brief Stores the corner arc points shared by all instances. The arcs depend only
+		on the radius and on the angle range so there's no need to recompute them for
+		each item (see calculatePoints()) */
+		static QMap<QString, QVector<QPointF>> corner_arcs;
+
 		//! \brief Rect border radius
 		double radius;
 
@@ -21,7 +21,8 @@
 
 SchemaView::SchemaView(Schema *schema) : BaseObjectView(schema)
 {
-	connect(schema, SIGNAL(s_objectModified()), this, SLOT(configureObject()));
+	connect(schema, SIGNAL(s_objectModified()), this, SLOT(scheduleConfiguration()));
+	cfg_scheduled=false;
 
 	sch_name=new QGraphicsSimpleTextItem;
 	sch_name->setZValue(1);
@@ -167,6 +168,23 @@ void SchemaView::moveTo(QPointF new_pos)
 		child->moveBy(dx, dy);
 }
 
+void SchemaView::scheduleConfiguration()
+{
+	if(cfg_scheduled)
+		return;
+
+	cfg_scheduled=true;
+
+	/* The geometry recalculation iterates over all children so instead of running it for
+	 * each modification we schedule a single pass to the next event loop iteration. This
+	 * avoids stalling the UI when a burst of modifications arrives, for instance, when
+	 * dozens of selected children are moved or reconfigured at once */
+	QTimer::singleShot(0, this, [this](){
+		cfg_scheduled=false;
+		configureObject();
+	});
+}
+
 void SchemaView::configureObject()
 {
 	Schema *schema=dynamic_cast<Schema *>(this->getUnderlyingObject());
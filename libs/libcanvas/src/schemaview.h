@@ -45,6 +45,10 @@ class SchemaView: public BaseObjectView
 		//! \brief Indicates if all children objects are selected
 		bool all_selected;
 
+		/*! \brief Indicates that a geometry reconfiguration is already scheduled to happen
+		 * when the control returns to the event loop (see scheduleConfiguration()) */
+		bool cfg_scheduled;
+
 		//! \brief Stores the views and tables that belongs to this schema
 		QList<BaseObjectView *> children;
 
@@ -59,6 +63,12 @@ class SchemaView: public BaseObjectView
 
 		QVariant itemChange(GraphicsItemChange change, const QVariant &value);
 
+	private slots:
+		/*! \brief Schedules a single call to configureObject() to happen when the control returns
+		 * to the event loop. This coalesces bursts of modifications on the underlying schema
+		 * (e.g. several children being moved at once) into one bounding box recalculation */
+		void scheduleConfiguration();
+
 	public:
 		SchemaView(Schema *schema);
 		virtual ~SchemaView();
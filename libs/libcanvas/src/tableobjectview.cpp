@@ -17,8 +17,10 @@
 */
 
 #include "tableobjectview.h"
+#include "objectsscene.h"
 
 bool TableObjectView::hide_sch_name_usr_type = false;
+QPolygonF TableObjectView::desc_polygons[4];
 const QString TableObjectView::TypeSeparator=QString(" ");
 const QString TableObjectView::ConstrSeparator=QString(" ");
 const QString TableObjectView::TextUnique=QString("uq");
@@ -35,6 +37,11 @@ TableObjectView::TableObjectView(TableObject *object) : BaseObjectView(object)
 	descriptor=nullptr;
 	fake_selection=false;
 
+	/* The rendered output of the item is cached in device coordinates so panning/scrolling
+	 * the canvas blits pixmaps instead of re-rasterizing the vector contents of every row.
+	 * The cache is dropped automatically on zoom changes and on update() calls */
+	this->setCacheMode(DeviceCoordinateCache);
+
 	for(unsigned i=0; i < 3; i++)
 		lables[i]=new QGraphicsSimpleTextItem;
 
@@ -52,6 +59,54 @@ TableObjectView::~TableObjectView()
 	delete obj_selection;
 }
 
+void TableObjectView::createDescriptorPolygons()
+{
+	if(!desc_polygons[PkDescPolygon].isEmpty())
+		return;
+
+	QPolygonF *pol = nullptr;
+	double factor = BaseObjectView::getFontFactor() * BaseObjectView::getScreenDpiFactor();
+
+	pol = &desc_polygons[PkDescPolygon];
+	pol->append(QPointF(2,0)); pol->append(QPointF(0,2)); pol->append(QPointF(0,7));
+	pol->append(QPointF(2,9)); pol->append(QPointF(3,8)); pol->append(QPointF(3,6));
+	pol->append(QPointF(4,6)); pol->append(QPointF(5,7)); pol->append(QPointF(6,6));
+	pol->append(QPointF(7,5)); pol->append(QPointF(9,7)); pol->append(QPointF(9,3));
+	pol->append(QPointF(3,3)); pol->append(QPointF(3,1));
+
+	pol = &desc_polygons[FkDescPolygon];
+	pol->append(QPointF(0,3)); pol->append(QPointF(0,6)); pol->append(QPointF(4,6));
+	pol->append(QPointF(4,9)); pol->append(QPointF(5,9)); pol->append(QPointF(9,5));
+	pol->append(QPointF(9,4)); pol->append(QPointF(5,0)); pol->append(QPointF(4,0));
+	pol->append(QPointF(4,3));
+
+	pol = &desc_polygons[UqDescPolygon];
+	pol->append(QPointF(4,0)); pol->append(QPointF(0,4)); pol->append(QPointF(0,5));
+	pol->append(QPointF(4,9)); pol->append(QPointF(5,9)); pol->append(QPointF(9,5));
+	pol->append(QPointF(9,4)); pol->append(QPointF(5,0));
+
+	pol = &desc_polygons[TabObjDescPolygon];
+	pol->append(QPointF(5,0)); pol->append(QPointF(0,5)); pol->append(QPointF(4,9));
+	pol->append(QPointF(9,9)); pol->append(QPointF(9,4));
+
+	if(factor!=1.0)
+	{
+		for(unsigned idx = PkDescPolygon; idx <= TabObjDescPolygon; idx++)
+			TextPolygonItem::resizePolygon(desc_polygons[idx],
+																		 desc_polygons[idx].boundingRect().width() * factor,
+																		 desc_polygons[idx].boundingRect().height() * factor);
+	}
+}
+
+void TableObjectView::setLabelFormat(unsigned lbl_id, const QTextCharFormat &fmt)
+{
+	if(lables[lbl_id]->font() != fmt.font())
+		lables[lbl_id]->setFont(fmt.font());
+
+	if(lables[lbl_id]->brush() != fmt.foreground())
+		lables[lbl_id]->setBrush(fmt.foreground());
+}
+
 void TableObjectView::configureDescriptor(ConstraintType constr_type)
 {
 	ObjectType obj_type=ObjectType::BaseObject;
@@ -110,35 +165,24 @@ void TableObjectView::configureDescriptor(ConstraintType constr_type)
 		{
 			QGraphicsPolygonItem *desc=dynamic_cast<QGraphicsPolygonItem *>(descriptor);
 
+			createDescriptorPolygons();
+
 			if(constr_type==ConstraintType::PrimaryKey)
 			{
 				attrib=Attributes::PkColumn;
-				pol.append(QPointF(2,0)); pol.append(QPointF(0,2)); pol.append(QPointF(0,7));
-				pol.append(QPointF(2,9)); pol.append(QPointF(3,8)); pol.append(QPointF(3,6));
-				pol.append(QPointF(4,6)); pol.append(QPointF(5,7)); pol.append(QPointF(6,6));
-				pol.append(QPointF(7,5)); pol.append(QPointF(9,7)); pol.append(QPointF(9,3));
-				pol.append(QPointF(3,3)); pol.append(QPointF(3,1));
+				pol=desc_polygons[PkDescPolygon];
 			}
 			else if(constr_type==ConstraintType::ForeignKey)
 			{
 				attrib=Attributes::FkColumn;
-				pol.append(QPointF(0,3)); pol.append(QPointF(0,6)); pol.append(QPointF(4,6));
-				pol.append(QPointF(4,9)); pol.append(QPointF(5,9)); pol.append(QPointF(9,5));
-				pol.append(QPointF(9,4)); pol.append(QPointF(5,0)); pol.append(QPointF(4,0));
-				pol.append(QPointF(4,3));
+				pol=desc_polygons[FkDescPolygon];
 			}
 			else if(constr_type==ConstraintType::Unique)
 			{
 				attrib=Attributes::UqColumn;
-				pol.append(QPointF(4,0)); pol.append(QPointF(0,4)); pol.append(QPointF(0,5));
-				pol.append(QPointF(4,9)); pol.append(QPointF(5,9)); pol.append(QPointF(9,5));
-				pol.append(QPointF(9,4)); pol.append(QPointF(5,0));
+				pol=desc_polygons[UqDescPolygon];
 			}
 
-			if(factor!=1.0)
-				TextPolygonItem::resizePolygon(pol, pol.boundingRect().width() * factor,
-																						pol.boundingRect().height()  * factor);
-
 			desc->setPolygon(pol);
 			desc->setBrush(this->getFillStyle(attrib));
 
@@ -151,15 +195,9 @@ void TableObjectView::configureDescriptor(ConstraintType constr_type)
 	{
 		TableObject *tab_obj=dynamic_cast<TableObject *>(this->getUnderlyingObject());
 		QGraphicsPolygonItem *desc=dynamic_cast<QGraphicsPolygonItem *>(descriptor);
-		QPolygonF pol;
 
-		pol.append(QPointF(5,0)); pol.append(QPointF(0,5)); pol.append(QPointF(4,9));
-		pol.append(QPointF(9,9)); pol.append(QPointF(9,4));
-
-		if(factor!=1.0)
-			TextPolygonItem::resizePolygon(pol,	pol.boundingRect().width() * factor ,	pol.boundingRect().height() * factor);
-
-		desc->setPolygon(pol);
+		createDescriptorPolygons();
+		desc->setPolygon(desc_polygons[TabObjDescPolygon]);
 		desc->setBrush(this->getFillStyle(tab_obj->getSchemaName()));
 
 		pen = this->getBorderStyle(tab_obj->getSchemaName());
@@ -279,8 +317,7 @@ void TableObjectView::configureObject()
 		font.setStrikeOut(sql_disabled);
 		fmt.setFont(font);
 
-		lables[0]->setFont(fmt.font());
-		lables[0]->setBrush(fmt.foreground());
+		setLabelFormat(0, fmt);
 		lables[0]->setPos(px, 0);
 		px+=lables[0]->boundingRect().width();
 
@@ -297,8 +334,7 @@ void TableObjectView::configureObject()
 				lables[1]->setText(TypeSeparator + tab_obj->getSchemaName());
 		}
 
-		lables[1]->setFont(fmt.font());
-		lables[1]->setBrush(fmt.foreground());
+		setLabelFormat(1, fmt);
 		lables[1]->setPos(px, 0);
 		px+=lables[1]->boundingRect().width() + (3 * HorizSpacing);
 
@@ -426,8 +462,7 @@ void TableObjectView::configureObject()
 		if(!tab_obj->getComment().isEmpty())
 			atribs_tip += QString("\n---\n%1").arg(tab_obj->getComment());
 
-		lables[2]->setFont(fmt.font());
-		lables[2]->setBrush(fmt.foreground());
+		setLabelFormat(2, fmt);
 		lables[2]->setPos(px, 0);
 
 		calculateBoundingRect();
@@ -455,8 +490,7 @@ void TableObjectView::configureObject(Reference reference)
 		else
 			lables[0]->setText(reference.getTable()->getName() + ".");
 
-		lables[0]->setFont(fmt.font());
-		lables[0]->setBrush(fmt.foreground());
+		setLabelFormat(0, fmt);
 		lables[0]->setPos(px, 0);
 		px+=lables[0]->boundingRect().width();
 
@@ -471,8 +505,7 @@ void TableObjectView::configureObject(Reference reference)
 				lables[1]->setText("*");
 		}
 
-		lables[1]->setFont(fmt.font());
-		lables[1]->setBrush(fmt.foreground());
+		setLabelFormat(1, fmt);
 		lables[1]->setPos(px, 0);
 		px+=lables[1]->boundingRect().width();
 	}
@@ -489,8 +522,7 @@ void TableObjectView::configureObject(Reference reference)
 		}
 
 		lables[0]->setText(str_aux);
-		lables[0]->setFont(fmt.font());
-		lables[0]->setBrush(fmt.foreground());
+		setLabelFormat(0, fmt);
 		lables[1]->setText("");
 		lables[0]->setPos(px, 0);
 		px+=lables[0]->boundingRect().width();
@@ -509,8 +541,7 @@ void TableObjectView::configureObject(Reference reference)
 		str_aux=QString(" (") + str_aux + QString(") ");
 		fmt=font_config[Attributes::Alias];
 		lables[2]->setText(str_aux);
-		lables[2]->setFont(fmt.font());
-		lables[2]->setBrush(fmt.foreground());
+		setLabelFormat(2, fmt);
 		lables[2]->setPos(px, 0);
 	}
 	else
@@ -535,8 +566,7 @@ void TableObjectView::configureObject(const SimpleColumn &col)
 	else
 		lables[0]->setText(col.name);
 
-	lables[0]->setFont(fmt.font());
-	lables[0]->setBrush(fmt.foreground());
+	setLabelFormat(0, fmt);
 	lables[0]->setPos(px, 0);
 	px+=lables[0]->boundingRect().width() + (4 * HorizSpacing);
 
@@ -549,8 +579,7 @@ void TableObjectView::configureObject(const SimpleColumn &col)
 		else
 			lables[1]->setText(formatUserTypeName(PgSqlType::parseString(col.type)));
 
-		lables[1]->setFont(fmt.font());
-		lables[1]->setBrush(fmt.foreground());
+		setLabelFormat(1, fmt);
 		lables[1]->setPos(px, 0);
 		px+=lables[1]->boundingRect().width() + (4 * HorizSpacing);
 	}
@@ -602,6 +631,10 @@ void TableObjectView::calculateBoundingRect()
 
 	for(unsigned i = 0; i < 3; i++)
 		lables[i]->setPos(lables[i]->pos().x(), py);
+
+	/* Explicitly invalidating the cached rendering of the item since the descriptor and labels
+	 * are painted manually in paint() and don't notify their changes to the scene */
+	this->update();
 }
 
 QGraphicsItem *TableObjectView::getChildObject(unsigned obj_idx)
@@ -730,6 +763,11 @@ void TableObjectView::configureObjectSelection()
 
 void TableObjectView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	QElapsedTimer paint_timer;
+
+	if(ObjectsScene::isPaintStatsEnabled())
+		paint_timer.start();
+
 	painter->save();
 	painter->translate(descriptor->pos());
 	descriptor->paint(painter, option, widget);
@@ -751,6 +789,9 @@ void TableObjectView::paint(QPainter *painter, const QStyleOptionGraphicsItem *o
 		painter->translate(obj_selection->pos());
 		obj_selection->paint(painter, option, widget);
 	}
+
+	if(paint_timer.isValid())
+		ObjectsScene::registerItemPaintTime("TableObjectView", paint_timer.nsecsElapsed());
 }
 
 QRectF TableObjectView::boundingRect() const
@@ -35,6 +35,20 @@ class TableObjectView: public BaseObjectView {
 
 		static bool hide_sch_name_usr_type;
 
+		//! \brief Indexes of the descriptor polygons shared by all instances (see desc_polygons)
+		static constexpr unsigned PkDescPolygon = 0,
+		FkDescPolygon = 1,
+		UqDescPolygon = 2,
+		TabObjDescPolygon = 3;
+
+		/*! \brief Stores the descriptor polygons shared by all instances. They are created
+		 only once (see createDescriptorPolygons()) avoiding the same shapes to be rebuilt
+		 and rescaled for every column/constraint during scene population */
+		static QPolygonF desc_polygons[4];
+
+		//! \brief Creates the shared descriptor polygons if they aren't created yet
+		static void createDescriptorPolygons();
+
 		//! \brief Table object descriptor
 		QGraphicsItem *descriptor;
 
@@ -49,6 +63,14 @@ class TableObjectView: public BaseObjectView {
 		 has a constraint */
 		void configureDescriptor(ConstraintType constr_type=BaseType::Null);
 
+		/*! \brief Applies the font and brush of the provided char format to one of the labels
+		 skipping the assignments when the attributes are already in place. QGraphicsSimpleTextItem
+		 reshapes its text whenever a font is assigned and schedules a repaint whenever a brush is
+		 assigned even if the values are unchanged, so since the rows are fully reconfigured on every
+		 state change of the parent table this makes the expensive text layout run only when the text
+		 or the font effectively change (setText() already ignores identical texts internally) */
+		void setLabelFormat(unsigned lbl_id, const QTextCharFormat &fmt);
+
 		QVariant itemChange(GraphicsItemChange, const QVariant &value)
 		{
 			return value;
@@ -17,9 +17,15 @@
 */
 
 #include "tabletitleview.h"
+#include "objectsscene.h"
 
 TableTitleView::TableTitleView() : BaseObjectView(nullptr)
 {
+	texts_visible=true;
+
+	//Caching the rendered title (box + texts) so canvas panning blits a pixmap instead of redrawing it
+	this->setCacheMode(DeviceCoordinateCache);
+
 	schema_name=new QGraphicsSimpleTextItem;
 	schema_name->setZValue(1);
 
@@ -148,17 +154,42 @@ void TableTitleView::resizeTitle(double width, double height)
 	}
 
 	this->bounding_rect.setSize(QSizeF(box->boundingRect().width(), box->boundingRect().height()));
+
+	/* Explicitly invalidating the cached rendering of the title since the box and texts
+	 * are painted manually in paint() and don't notify their changes to the scene */
+	this->update();
+}
+
+void TableTitleView::setTextsVisible(bool value)
+{
+	if(texts_visible!=value)
+	{
+		texts_visible=value;
+		this->update();
+	}
 }
 
 void TableTitleView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	QElapsedTimer paint_timer;
+
+	if(ObjectsScene::isPaintStatsEnabled())
+		paint_timer.start();
+
 	box->paint(painter, option, widget);
 
-	painter->setFont(schema_name->font());
-	painter->setPen(schema_name->brush().color());
-	painter->drawText(schema_name->pos(), schema_name->text());
+	//Under the lowest level of detail only the title box is painted
+	if(texts_visible)
+	{
+		painter->setFont(schema_name->font());
+		painter->setPen(schema_name->brush().color());
+		painter->drawText(schema_name->pos(), schema_name->text());
+
+		painter->setFont(obj_name->font());
+		painter->setPen(obj_name->brush().color());
+		painter->drawText(obj_name->pos(), obj_name->text());
+	}
 
-	painter->setFont(obj_name->font());
-	painter->setPen(obj_name->brush().color());
-	painter->drawText(obj_name->pos(), obj_name->text());
+	if(paint_timer.isValid())
+		ObjectsScene::registerItemPaintTime("TableTitleView", paint_timer.nsecsElapsed());
 }
@@ -43,6 +43,10 @@ class TableTitleView: public BaseObjectView
 		QGraphicsSimpleTextItem *obj_name,
 		*schema_name;
 
+		/*! \brief Indicates if the object/schema name texts should be painted. This flag is
+		disabled by the reduced levels of detail (see BaseTableView::applyLevelOfDetail()) */
+		bool texts_visible;
+
 		void configureObject(void){}
 
 	public:
@@ -52,6 +56,9 @@ class TableTitleView: public BaseObjectView
 		void configureObject(BaseGraphicObject *object);
 		void resizeTitle(double width, double height);
 
+		//! \brief Toggles the painting of the object/schema name texts keeping only the title box visible
+		void setTextsVisible(bool value);
+
 		virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr);
 };
 
@@ -20,7 +20,7 @@
 
 TableView::TableView(PhysicalTable *table) : BaseTableView(table)
 {
-	connect(table, SIGNAL(s_objectModified()), this, SLOT(configureObject()));
+	connect(table, SIGNAL(s_objectModified()), this, SLOT(requestConfiguration()));
 	this->configureObject();
 }
 
@@ -258,6 +258,11 @@ void TableView::configureObject()
 	configureTag();
 	configureSQLDisabledInfo();
 
+	/* Reapplying the current level of detail since the reconfiguration above
+	 * restores the natural visibility of the children sections */
+	lod_active=false;
+	applyLevelOfDetail();
+
 	if((old_width!=0 && this->bounding_rect.width()!=old_width) ||
 			(old_height!=0 && this->bounding_rect.height()!=old_height))
 		emit s_objectDimensionChanged();
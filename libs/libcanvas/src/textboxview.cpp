@@ -21,7 +21,7 @@
 
 TextboxView::TextboxView(Textbox *txtbox, bool override_style) : BaseObjectView(txtbox)
 {
-	connect(txtbox, SIGNAL(s_objectModified()), this, SLOT(configureObject()));
+	connect(txtbox, SIGNAL(s_objectModified()), this, SLOT(requestConfiguration()));
 
 	text_item = new TextPolygonItem;
 	this->addToGroup(text_item);
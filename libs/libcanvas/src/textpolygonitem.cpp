@@ -17,6 +17,7 @@
 */
 
 #include "textpolygonitem.h"
+#include "objectsscene.h"
 
 TextPolygonItem::TextPolygonItem(QGraphicsItem *parent) : QGraphicsPolygonItem(parent)
 {
@@ -70,10 +71,18 @@ QFont TextPolygonItem::getFont()
 
 void TextPolygonItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
+	QElapsedTimer paint_timer;
+
+	if(ObjectsScene::isPaintStatsEnabled())
+		paint_timer.start();
+
 	QGraphicsPolygonItem::paint(painter, option, widget);
 
 	painter->translate(text_item->pos());
 	text_item->paint(painter, option, widget);
+
+	if(paint_timer.isValid())
+		ObjectsScene::registerItemPaintTime("TextPolygonItem", paint_timer.nsecsElapsed());
 }
 
 void TextPolygonItem::resizePolygon(QPolygonF &pol, double width, double height)
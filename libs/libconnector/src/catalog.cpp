@@ -18,7 +18,11 @@
 #include "catalog.h"
 #include "coreutilsns.h"
 #include "utilsns.h"
+#include "performancecounters.h"
 #include "qtcompat/splitbehaviorcompat.h"
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QMultiMap>
 
 const QString Catalog::QueryList("list");
 const QString Catalog::QueryAttribs("attribs");
@@ -34,7 +38,31 @@ const QString Catalog::GetExtensionObjsSql("SELECT d.objid AS oid, e.extname AS
 																					 LEFT JOIN pg_extension AS e ON e.oid = d.refobjid \
 																					 WHERE objid > 0 AND refobjid > 0 AND deptype='e'\
 																					 ORDER BY extname;");
+const QString Catalog::GetObjectsXminsSql("SELECT oid, xmin::text::bigint AS xmin FROM pg_class \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_proc \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_type \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_namespace \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_constraint \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_trigger \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_rewrite \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_operator \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_cast \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_conversion \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_language \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_collation \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_opclass \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_opfamily \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_extension \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_event_trigger \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_foreign_data_wrapper \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_foreign_server \
+UNION ALL SELECT oid, xmin::text::bigint FROM pg_policy");
 attribs_map Catalog::catalog_queries;
+QMutex Catalog::catalog_qry_mtx;
+bool Catalog::query_log_enabled=false;
+bool Catalog::query_log_explain=false;
+std::map<QString, Catalog::QueryLogEntry> Catalog::query_log;
+QMutex Catalog::query_log_mtx;
 
 map<ObjectType, QString> Catalog::oid_fields=
 { {ObjectType::Database, "oid"}, {ObjectType::Role, "oid"}, {ObjectType::Schema,"oid"},
@@ -80,6 +108,23 @@ map<ObjectType, QString> Catalog::name_fields=
 	{ObjectType::Procedure, "proname"}
 };
 
+/* Object types whose attributes catalog queries accept the pushdown of compiled name filters,
+ * flagging the ones that project the "schema" column (namespace oid) needed to compose schema
+ * qualified names under signature matching. Types absent from this map (table children objects,
+ * casts, transforms and sequences) keep relying on the explicit oid selection only */
+map<ObjectType, bool> Catalog::name_flt_pushdown_types=
+{ {ObjectType::Schema, false}, {ObjectType::Role, false}, {ObjectType::Tablespace, false},
+	{ObjectType::Language, false}, {ObjectType::EventTrigger, false}, {ObjectType::ForeignDataWrapper, false},
+	{ObjectType::ForeignServer, false}, {ObjectType::Extension, true},
+	{ObjectType::Function, true}, {ObjectType::Aggregate, true},
+	{ObjectType::Procedure, true}, {ObjectType::Operator, true},
+	{ObjectType::OpClass, true}, {ObjectType::OpFamily, true},
+	{ObjectType::Collation, true}, {ObjectType::Conversion, true},
+	{ObjectType::Domain, true}, {ObjectType::Type, true},
+	{ObjectType::Table, true}, {ObjectType::View, true},
+	{ObjectType::ForeignTable, true}
+};
+
 Catalog::Catalog()
 {
 	match_signature = true;
@@ -346,6 +391,33 @@ unsigned Catalog::getLastSysObjectOID()
 	return last_sys_oid;
 }
 
+std::map<unsigned, unsigned> Catalog::getObjectsXmins()
+{
+	try
+	{
+		ResultSet res;
+		std::map<unsigned, unsigned> xmins;
+
+		connection.executeDMLCommand(GetObjectsXminsSql, res);
+
+		if(res.accessTuple(ResultSet::FirstTuple))
+		{
+			do
+			{
+				xmins[static_cast<unsigned>(res.getColumnIntValue(0))]=
+						static_cast<unsigned>(res.getColumnIntValue(1));
+			}
+			while(res.accessTuple(ResultSet::NextTuple));
+		}
+
+		return xmins;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 bool Catalog::isSystemObject(unsigned oid)
 {
 	return (oid <= last_sys_oid);
@@ -372,15 +444,23 @@ bool Catalog::isExtensionObject(unsigned oid, const QString &ext_name)
 
 void Catalog::loadCatalogQuery(const QString &qry_id)
 {
-	if(catalog_queries.count(qry_id)==0)
-		catalog_queries[qry_id] = UtilsNs::loadFile(GlobalAttributes::getSchemaFilePath(GlobalAttributes::CatalogSchemasDir, qry_id));
+	QString buffer;
+
+	{
+		QMutexLocker locker(&catalog_qry_mtx);
 
-	schparser.loadBuffer(catalog_queries[qry_id]);
+		if(catalog_queries.count(qry_id)==0)
+			catalog_queries[qry_id] = UtilsNs::loadCachedFile(GlobalAttributes::getSchemaFilePath(GlobalAttributes::CatalogSchemasDir, qry_id));
+
+		buffer=catalog_queries[qry_id];
+	}
+
+	schparser.loadBuffer(buffer);
 }
 
 QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, bool single_result, attribs_map attribs)
 {
-	QString sql, custom_filter;
+	QString sql, custom_filter, name_flt_pred;
 
 	/* Escaping apostrophe (') in the attributes values to avoid SQL errors
 	 * due to support to this char in the middle of objects' names */
@@ -409,6 +489,26 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 	{
 		attribs[Attributes::UseSignature] = match_signature ? Attributes::True : "";
 		attribs[Attributes::NameFilter] = obj_filters[obj_type];
+
+		/* Pushing the compiled name filter down to the attributes query so only matching rows are
+		 * transferred by bulk retrievals. The pushdown is skipped when an explicit oid list is
+		 * present (the selection is already resolved, e.g. dependency fetches during imports) and
+		 * for the types whose attributes queries don't support it (see name_flt_pushdown_types) */
+		if(qry_type==QueryAttribs && attribs.count(Attributes::FilterOids)==0 &&
+				name_flt_pushdown_types.count(obj_type))
+		{
+			QString name_expr="_flt_res.name";
+
+			name_flt_pred=obj_filters[obj_type];
+			name_flt_pred.replace(QChar('\''), QString("''"));
+
+			/* Under signature matching the name is schema qualified the same way the listing
+			 * queries do when {use-signature} is set */
+			if(match_signature && name_flt_pushdown_types[obj_type])
+				name_expr=QString("(SELECT _ns.nspname FROM pg_namespace AS _ns WHERE _ns.oid = _flt_res.schema) || '.' || %1").arg(name_expr);
+
+			name_flt_pred=QString("(%1)::text ~* E'%2'").arg(name_expr).arg(name_flt_pred);
+		}
 	}
 
 	// If there's a name filter configured for the object type
@@ -451,6 +551,14 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 			sql.insert(order_by_idx, QString(" AND (%1) ").arg(custom_filter));
 	}
 
+	/* Applying the pushed down name filter by wrapping the query in a subselect, since the
+	 * predicate references the projected name/schema columns instead of the inner aliases */
+	if(!name_flt_pred.isEmpty())
+	{
+		if(sql.endsWith(';'))	sql.remove(sql.size()-1, 1);
+		sql=QString("SELECT * FROM (%1) AS _flt_res WHERE %2").arg(sql).arg(name_flt_pred);
+	}
+
 	//Append a LIMIT clause when the single_result is set
 	if(single_result)
 	{
@@ -463,9 +571,26 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 
 void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type, ResultSet &result, bool single_result, attribs_map attribs)
 {
+	PerformanceCounters::ScopedTimer perf_timer("Catalog::executeCatalogQuery");
+
 	try
 	{
-		connection.executeDMLCommand(getCatalogQuery(qry_type, obj_type, single_result, attribs), result);
+		/* The query is executed through a server-side prepared statement keyed by the query type and
+		object type: refresh cycles re-running the same catalog query (same filter shape) reuse the
+		statement and skip the parsing of the full query text on the server */
+		QString stmt_id=QString("%1_%2%3").arg(qry_type).arg(BaseObject::getSchemaName(obj_type)).arg(single_result ? "_single" : ""),
+				sql=getCatalogQuery(qry_type, obj_type, single_result, attribs);
+
+		if(!query_log_enabled)
+			connection.executePreparedCommand(stmt_id, sql, result);
+		else
+		{
+			QElapsedTimer qry_timer;
+
+			qry_timer.start();
+			connection.executePreparedCommand(stmt_id, sql, result);
+			registerQueryLogEntry(stmt_id, sql, result.getTupleCount(), qry_timer.nsecsElapsed());
+		}
 	}
 	catch(Exception &e)
 	{
@@ -474,6 +599,103 @@ void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type,
 	}
 }
 
+void Catalog::registerQueryLogEntry(const QString &qry_id, const QString &sql, int rows, qint64 nsecs)
+{
+	double server_ms=0;
+
+	if(query_log_explain)
+	{
+		/* The server side timing is captured on a best effort basis: failures (e.g. the
+		 server lacking permissions to run EXPLAIN) don't disturb the catalog reading */
+		try
+		{
+			ResultSet expl_res;
+
+			connection.executeDMLCommand(QString("EXPLAIN (ANALYZE, FORMAT JSON) %1").arg(sql), expl_res);
+
+			if(expl_res.accessTuple(ResultSet::FirstTuple))
+			{
+				QRegExp exec_time_regexp("\\\"Execution Time\\\":\\s*([0-9.]+)");
+
+				if(exec_time_regexp.indexIn(QString(expl_res.getColumnValue(0))) >= 0)
+					server_ms=exec_time_regexp.cap(1).toDouble();
+			}
+		}
+		catch(Exception &){}
+	}
+
+	QMutexLocker locker(&query_log_mtx);
+	QueryLogEntry &entry=query_log[qry_id];
+
+	entry.calls++;
+	entry.rows+=rows;
+	entry.total_nsecs+=nsecs;
+	entry.server_total_ms+=server_ms;
+
+	if(entry.fingerprint.isEmpty())
+		entry.fingerprint=QString(QCryptographicHash::hash(sql.toUtf8(), QCryptographicHash::Md5).toHex()).left(12);
+}
+
+void Catalog::setQueryLogEnabled(bool value, bool capture_server_timing)
+{
+	query_log_enabled=value;
+	query_log_explain=(value && capture_server_timing);
+}
+
+bool Catalog::isQueryLogEnabled()
+{
+	return query_log_enabled;
+}
+
+std::map<QString, Catalog::QueryLogEntry> Catalog::getQueryLog()
+{
+	QMutexLocker locker(&query_log_mtx);
+	return query_log;
+}
+
+void Catalog::clearQueryLog()
+{
+	QMutexLocker locker(&query_log_mtx);
+	query_log.clear();
+}
+
+QString Catalog::dumpQueryLog()
+{
+	std::map<QString, QueryLogEntry> log=getQueryLog();
+	QMultiMap<qint64, QString> ranking;
+	QString report;
+
+	if(log.empty())
+		return QString("No catalog queries logged.\n");
+
+	for(auto &itr : log)
+	{
+		QString line=QString("  %1 [%2]: calls=%3 rows=%4 total=%5 ms")
+								 .arg(itr.first).arg(itr.second.fingerprint)
+								 .arg(itr.second.calls).arg(itr.second.rows)
+								 .arg(QString::number(itr.second.total_nsecs / 1000000.0, 'f', 2));
+
+		if(itr.second.server_total_ms > 0)
+			line+=QString(" server=%1 ms").arg(QString::number(itr.second.server_total_ms, 'f', 2));
+
+		ranking.insert(itr.second.total_nsecs, line);
+	}
+
+	report=QString("Catalog queries:\n");
+
+	//Listing the queries from the most to the least time consuming
+	QMapIterator<qint64, QString> itr(ranking);
+	itr.toBack();
+
+	while(itr.hasPrevious())
+	{
+		itr.previous();
+		report+=itr.value() + QString("\n");
+	}
+
+	return report;
+}
+
 unsigned Catalog::getObjectCount(ObjectType obj_type, const QString &sch_name, const QString &tab_name, attribs_map extra_attribs)
 {
 	try
@@ -526,43 +748,85 @@ void Catalog::getObjectsOIDs(map<ObjectType, vector<unsigned> > &obj_oids, map<u
 	{
 		vector<ObjectType> types=BaseObject::getObjectTypes(true, { ObjectType::Database, ObjectType::Relationship, ObjectType::BaseRelationship,
 																																ObjectType::Textbox, ObjectType::Tag, ObjectType::Column, ObjectType::Permission,
-																																ObjectType::GenericSql });
-		attribs_map attribs, col_attribs, sch_names;
-		vector<attribs_map> tab_attribs;
-		unsigned tab_oid=0;
+																																ObjectType::GenericSql }),
+				sel_types;
+		vector<attribs_map> objects;
+		map<unsigned, attribs_map> tables;
+		ObjectType obj_type;
+		unsigned oid=0;
 
 		for(ObjectType type : types)
 		{
-			/* We retrieve the object's attributes only if there're no filters configured
+			/* We retrieve the object's oids only if there're no filters configured
 			 * for the current type or in case of having filters, the type is registered in one of the
 			 * two filter structures */
 			if((obj_filters.empty() && extra_filter_conds.empty()) ||
 				 (!obj_filters.empty() && obj_filters.count(type) != 0) ||
 				 (!extra_filter_conds.empty() && TableObject::isTableObject(type) && extra_filter_conds.count(type) != 0))
-				attribs = getObjectsNames(type, "", "", extra_attribs);
+				sel_types.push_back(type);
+		}
 
-			for(auto &attr : attribs)
+		if(sel_types.empty())
+			return;
+
+		/* Enumerating the oids of all selected types in a single round-trip instead of
+		 * running one catalog query per type, which hurts badly on high latency links */
+		objects = getObjectsNames(sel_types, "", "", extra_attribs);
+
+		for(auto &attribs : objects)
+		{
+			obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
+			oid=attribs[Attributes::Oid].toUInt();
+			obj_oids[obj_type].push_back(oid);
+
+			/* Store the tables' names and schemas (returned as parent by the list queries)
+			 * so their columns can be enumerated below */
+			if(obj_type==ObjectType::Table)
+				tables[oid]=attribs;
+		}
+
+		if(!tables.empty())
+		{
+			ResultSet res;
+			QString sql, select_kw=QString("SELECT"), tab_oid_attr=QString("table_oid");
+			QStringList queries;
+			attribs_map col_attribs;
+			map<unsigned, attribs_map>::iterator itr=tables.begin();
+
+			/* The columns of the tables are also enumerated in batches, joining the per-table
+			 * column queries through UNION and demultiplexing the results by the parent table oid */
+			while(itr!=tables.end())
 			{
-				obj_oids[type].push_back(attr.first.toUInt());
+				col_attribs=extra_attribs;
+				col_attribs[Attributes::Schema]=itr->second[Attributes::Parent];
+				col_attribs[Attributes::Table]=itr->second[Attributes::Name];
 
-				//Store the schemas names in order to retrieve the tables' columns correctly
-				if(type==ObjectType::Schema)
-					sch_names[attr.first]=attr.second;
-				else if(type==ObjectType::Table)
-				{
-					//Get the full set of attributes of the table
-					tab_oid=attr.first.toUInt();
-					tab_attribs=getObjectsAttributes(type, "", "", { tab_oid });
+				sql=getCatalogQuery(QueryList, ObjectType::Column, false, col_attribs);
 
-					//Retrieve the oid and names of the table's columns
-					col_attribs=getObjectsNames(ObjectType::Column, sch_names[tab_attribs[0][Attributes::Schema]], attr.second);
+				//Injecting the parent table oid in order to demultiplex the final result
+				sql.replace(sql.indexOf(select_kw), select_kw.size(),
+										QString("%1 %2 AS %3, ").arg(select_kw).arg(itr->first).arg(tab_oid_attr));
+				queries.push_back(sql);
+				itr++;
 
-					for(auto &col_attr : col_attribs)
-						col_oids[tab_oid].push_back(col_attr.first.toUInt());
+				//Limiting the amount of tables per statement to avoid huge queries on big databases
+				if(queries.size()==100 || itr==tables.end())
+				{
+					sql = QChar('(') +  queries.join(QString(") UNION ALL (")) + QChar(')');
+					sql += QString(" ORDER BY %1, oid").arg(tab_oid_attr);
+					queries.clear();
+					connection.executeDMLCommand(sql, res);
+
+					if(res.accessTuple(ResultSet::FirstTuple))
+					{
+						do
+						{
+							col_oids[res.getColumnValue(tab_oid_attr).toUInt()].push_back(res.getColumnValue(Attributes::Oid).toUInt());
+						}
+						while(res.accessTuple(ResultSet::NextTuple));
+					}
 				}
 			}
-
-			attribs.clear();
 		}
 	}
 	catch(Exception &e)
@@ -665,6 +929,74 @@ vector<attribs_map> Catalog::getObjectsNames(vector<ObjectType> obj_types, const
 	}
 }
 
+map<int, vector<attribs_map>> Catalog::getObjectsNames(vector<ObjectType> obj_types, const vector<QStringList> &parents, attribs_map extra_attribs)
+{
+	try
+	{
+		ResultSet res;
+		map<int, vector<attribs_map>> objects;
+		QString sql, select_kw=QString("SELECT"), parent_idx_attr=QString("parent_idx");
+		QStringList queries;
+		attribs_map attribs, aux_attribs;
+		QString obj_type_attr = QString(Attributes::ObjectType).replace('-', '_'),
+				parent_type_attr = QString(Attributes::ParentType).replace('-', '_');
+
+		for(unsigned idx=0; idx < parents.size(); idx++)
+		{
+			aux_attribs=extra_attribs;
+			aux_attribs[Attributes::Schema]=parents[idx].at(0);
+			aux_attribs[Attributes::Table]=parents[idx].at(1);
+
+			for(auto &obj_type : obj_types)
+			{
+				sql=getCatalogQuery(QueryList, obj_type, false, aux_attribs);
+
+				if(sql.isEmpty())
+					continue;
+
+				/* Injecting the parent index and the object type code in order to
+				 * demultiplex the final result */
+				sql.replace(sql.indexOf(select_kw), select_kw.size(),
+										QString("%1 %2 AS %3, %4 AS object_type, ")
+										.arg(select_kw).arg(idx).arg(parent_idx_attr).arg(enum_cast(obj_type)));
+				queries.push_back(sql);
+			}
+
+			/* Limiting the amount of queries per statement to avoid huge commands on big databases.
+			 * The queries of a parent are never split between statements since the flush happens
+			 * only after all its child types were enumerated */
+			if(!queries.isEmpty() && (queries.size() >= 100 || idx==parents.size() - 1))
+			{
+				sql = QChar('(') +  queries.join(QString(") UNION ALL (")) + QChar(')');
+				sql += QString(" ORDER BY %1, oid, object_type").arg(parent_idx_attr);
+				queries.clear();
+				connection.executeDMLCommand(sql, res);
+
+				if(res.accessTuple(ResultSet::FirstTuple))
+				{
+					do
+					{
+						attribs[Attributes::Oid]=res.getColumnValue(Attributes::Oid);
+						attribs[Attributes::Name]=res.getColumnValue(Attributes::Name);
+						attribs[Attributes::ObjectType]=res.getColumnValue(obj_type_attr);
+						attribs[Attributes::Parent]=res.getColumnValue(Attributes::Parent);
+						attribs[Attributes::ParentType]=res.getColumnValue(parent_type_attr);
+						objects[res.getColumnValue(parent_idx_attr).toInt()].push_back(attribs);
+						attribs.clear();
+					}
+					while(res.accessTuple(ResultSet::NextTuple));
+				}
+			}
+		}
+
+		return objects;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 attribs_map Catalog::getAttributes(const QString &obj_name, ObjectType obj_type, attribs_map extra_attribs)
 {
 	try
@@ -677,7 +1009,13 @@ attribs_map Catalog::getAttributes(const QString &obj_name, ObjectType obj_type,
 		executeCatalogQuery(QueryAttribs, obj_type, res, true, extra_attribs);
 
 		if(res.accessTuple(ResultSet::FirstTuple))
-			obj_attribs=changeAttributeNames(res.getTupleValues());
+		{
+			QStringList attr_names;
+			vector<bool> bool_attrs;
+
+			getTranslatedColNames(res, attr_names, bool_attrs);
+			obj_attribs=extractTupleAttribs(res, attr_names, bool_attrs);
+		}
 
 		/* Insert the object type as an attribute of the query result to facilitate the
 		import process on the classes that uses the Catalog */
@@ -692,31 +1030,52 @@ attribs_map Catalog::getAttributes(const QString &obj_name, ObjectType obj_type,
 }
 
 vector<attribs_map> Catalog::getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs)
+{
+	try
+	{
+		vector<attribs_map> obj_attribs;
+
+		getMultipleAttributes(obj_type, extra_attribs, [&obj_attribs](attribs_map &&tuple){
+			obj_attribs.push_back(std::move(tuple));
+		});
+
+		return obj_attribs;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs, const std::function<void(attribs_map&&)> &consumer)
 {
 	try
 	{
 		ResultSet res;
 		attribs_map tuple;
-		vector<attribs_map> obj_attribs;
 
 		executeCatalogQuery(QueryAttribs, obj_type, res, false, extra_attribs);
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
+			QStringList attr_names;
+			vector<bool> bool_attrs;
+
+			//The translated attribute names are computed only once per resultset
+			getTranslatedColNames(res, attr_names, bool_attrs);
+
 			do
 			{
-				tuple=changeAttributeNames(res.getTupleValues());
+				tuple=extractTupleAttribs(res, attr_names, bool_attrs);
 
 				/* Insert the object type as an attribute of the query result to facilitate the
 				import process on the classes that uses the Catalog */
 				tuple[Attributes::ObjectType]=QString("%1").arg(enum_cast(obj_type));
 
-				obj_attribs.push_back(tuple);
+				consumer(std::move(tuple));
 				tuple.clear();
 			}
 			while(res.accessTuple(ResultSet::NextTuple));
 		}
-
-		return obj_attribs;
 	}
 	catch(Exception &e)
 	{
@@ -741,10 +1100,16 @@ vector<attribs_map> Catalog::getMultipleAttributes(const QString &catalog_sch, a
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
+			QStringList attr_names;
+			vector<bool> bool_attrs;
+
+			//The translated attribute names are computed only once per resultset
+			getTranslatedColNames(res, attr_names, bool_attrs);
+
 			do
 			{
-				tuple=changeAttributeNames(res.getTupleValues());
-				obj_attribs.push_back(tuple);
+				tuple=extractTupleAttribs(res, attr_names, bool_attrs);
+				obj_attribs.push_back(std::move(tuple));
 				tuple.clear();
 			}
 			while(res.accessTuple(ResultSet::NextTuple));
@@ -823,6 +1188,46 @@ attribs_map Catalog::changeAttributeNames(const attribs_map &attribs)
 	return new_attribs;
 }
 
+void Catalog::getTranslatedColNames(ResultSet &res, QStringList &attr_names, vector<bool> &bool_attrs)
+{
+	QString attr_name;
+	int col_cnt=res.getColumnCount();
+
+	attr_names.clear();
+	bool_attrs.clear();
+
+	for(int col=0; col < col_cnt; col++)
+	{
+		attr_name=res.getColumnName(col);
+		bool_attrs.push_back(attr_name.endsWith(BoolField));
+
+		if(bool_attrs.back())
+			attr_name.remove(BoolField);
+
+		attr_name.replace('_','-');
+		attr_names.append(attr_name);
+	}
+}
+
+attribs_map Catalog::extractTupleAttribs(ResultSet &res, const QStringList &attr_names, const vector<bool> &bool_attrs)
+{
+	attribs_map tuple;
+	QByteArray value;
+
+	for(int col=0; col < attr_names.size(); col++)
+	{
+		//The value is only a view over the resultset storage, no copy is made at this point
+		value=res.getColumnBuffer(col);
+
+		if(bool_attrs[col])
+			tuple[attr_names[col]]=(PgSqlFalse==value ? QString() : Attributes::True);
+		else
+			tuple[attr_names[col]]=QString::fromUtf8(value.constData(), value.size());
+	}
+
+	return tuple;
+}
+
 QString Catalog::createOidFilter(const vector<unsigned> &oids)
 {
 	QString filter;
@@ -837,6 +1242,24 @@ QString Catalog::createOidFilter(const vector<unsigned> &oids)
 }
 
 vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, const QString &schema, const QString &table, const vector<unsigned> &filter_oids, attribs_map extra_attribs)
+{
+	try
+	{
+		vector<attribs_map> obj_attribs;
+
+		getObjectsAttributes(obj_type, schema, table, filter_oids, [&obj_attribs](attribs_map &&tuple){
+			obj_attribs.push_back(std::move(tuple));
+		}, extra_attribs);
+
+		return obj_attribs;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::getObjectsAttributes(ObjectType obj_type, const QString &schema, const QString &table, const vector<unsigned> &filter_oids, const std::function<void(attribs_map&&)> &consumer, attribs_map extra_attribs)
 {
 	try
 	{
@@ -854,7 +1277,7 @@ vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, const QSt
 		if(obj_type != ObjectType::Column)
 			extra_attribs[Attributes::Comment]=getCommentQuery(oid_fields[obj_type], is_shared_obj);
 
-		return getMultipleAttributes(obj_type, extra_attribs);
+		getMultipleAttributes(obj_type, extra_attribs, consumer);
 	}
 	catch(Exception &e)
 	{
@@ -863,6 +1286,30 @@ vector<attribs_map> Catalog::getObjectsAttributes(ObjectType obj_type, const QSt
 	}
 }
 
+map<unsigned, vector<attribs_map>> Catalog::getColumnsAttributes(const vector<unsigned> &table_oids, attribs_map extra_attribs)
+{
+	try
+	{
+		map<unsigned, vector<attribs_map>> cols_attribs;
+
+		if(!table_oids.empty())
+			extra_attribs[Attributes::TableOids]=createOidFilter(table_oids);
+
+		//Demultiplexing the retrieved rows through the parent table oid present in each tuple
+		getMultipleAttributes(ObjectType::Column, extra_attribs, [&cols_attribs](attribs_map &&attribs){
+			unsigned tab_oid=attribs.at(Attributes::Table).toUInt();
+			cols_attribs[tab_oid].push_back(std::move(attribs));
+		});
+
+		return cols_attribs;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e,
+						QString("catalog: %1").arg(BaseObject::getSchemaName(ObjectType::Column)));
+	}
+}
+
 attribs_map Catalog::getObjectAttributes(ObjectType obj_type, unsigned oid, const QString sch_name, const QString tab_name, attribs_map extra_attribs)
 {
 	try
@@ -31,8 +31,23 @@ This class is the basis for the reverse engineering feature.
 #include "tableobject.h"
 #include <QTextStream>
 #include <QApplication>
+#include <QMutex>
+#include <functional>
 
 class Catalog {
+	public:
+		//! \brief Aggregated statistics of a single catalog query recorded by the query log
+		struct QueryLogEntry {
+			//! \brief md5 fingerprint of the last query text generated for the query id
+			QString fingerprint;
+
+			//! \brief Executions, accumulated returned rows and client side wall time
+			qint64 calls=0, rows=0, total_nsecs=0;
+
+			//! \brief Accumulated server side execution time captured through EXPLAIN ANALYZE
+			double server_total_ms=0;
+		};
+
 	private:
 		SchemaParser schparser;
 
@@ -45,6 +60,10 @@ class Catalog {
 		//! \brief Query used to retrieve extension objects.
 		GetExtensionObjsSql,
 
+		/*! \brief Query used to retrieve the oid and xmin (id of the last transaction that modified the entry)
+		 * of the rows in the main per-database catalog tables (see getObjectsXmins()) */
+		GetObjectsXminsSql,
+
 		//! \brief This pattern matches the PostgreSQL array values in format [n:n]={a,b,c,d,...} or {a,b,c,d,...}
 		ArrayPattern,
 
@@ -88,9 +107,36 @@ class Catalog {
 		 * filter (see setObjectFilter) */
 		parent_aliases;
 
+		/*! \brief This map stores the object types whose attributes catalog queries accept the pushdown of compiled
+		name filters, indicating for each one if the projected "schema" column (namespace oid) is available to compose
+		the schema qualified name under signature matching (see getCatalogQuery()). Types absent from this map (table
+		children objects, casts, transforms and sequences) keep relying on the explicit oid selection only */
+		static map<ObjectType, bool> name_flt_pushdown_types;
+
 		//! \brief Store the cached catalog queries
 		static attribs_map catalog_queries;
 
+		/*! \brief Controls the concurrent access to the catalog queries cache since distinct
+		 * catalog instances may load queries simultaneously (see DatabaseImportHelper::retrieveUserObjectsParallel) */
+		static QMutex catalog_qry_mtx;
+
+		//! \brief Indicates that the executed catalog queries are being logged (see setQueryLogEnabled())
+		static bool query_log_enabled,
+
+		//! \brief Indicates that the logging also captures the server side timing through EXPLAIN ANALYZE
+		query_log_explain;
+
+		//! \brief Aggregated statistics of the executed catalog queries keyed by query id
+		static std::map<QString, QueryLogEntry> query_log;
+
+		//! \brief Controls the concurrent access to the query log
+		static QMutex query_log_mtx;
+
+		/*! \brief Aggregates an execution into the query log. When the server timing capture is
+		 enabled the query is re-executed under EXPLAIN ANALYZE (best effort) to record the
+		 server side execution time */
+		void registerQueryLogEntry(const QString &qry_id, const QString &sql, int rows, qint64 nsecs);
+
 		//! \brief Connection used to query the pg_catalog
 		Connection connection;
 
@@ -133,6 +179,18 @@ class Catalog {
 		the resultant attribs_map will be passed to XMLParser/SchemaParser which understands bool values as 1 (one) or '' (empty) */
 		attribs_map changeAttributeNames(const attribs_map &attribs);
 
+		/*! \brief Fills the provided lists with the translated attribute name of each resultset column
+		(underscores replaced by dashes, _bool suffix stripped) and the indication of which columns are
+		the boolean ones. Since the names only depend on the resultset layout they are computed once
+		and reused for every tuple (see extractTupleAttribs) */
+		void getTranslatedColNames(ResultSet &res, QStringList &attr_names, vector<bool> &bool_attrs);
+
+		/*! \brief Extracts the attributes of the resultset's current tuple using the translated names
+		produced by getTranslatedColNames(). The column values are read through zero-copy views over the
+		resultset storage (see ResultSet::getColumnBuffer) so each value is decoded into its definitive
+		QString only once, instead of being copied by getTupleValues() and again by changeAttributeNames() */
+		attribs_map extractTupleAttribs(ResultSet &res, const QStringList &attr_names, const vector<bool> &bool_attrs);
+
 		//! \brief Returns a attribute set for the specified object type and name
 		attribs_map getAttributes(const QString &obj_name, ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
@@ -201,6 +259,12 @@ class Catalog {
 		//! \brief Returns the last system object oid registered on the database
 		unsigned getLastSysObjectOID();
 
+		/*! \brief Returns a map of oid -> xmin (id of the last transaction that modified the catalog entry)
+		for the rows of the main per-database catalog tables. The xmin works as a cheap change watermark:
+		a differing value means the object was modified since the previous reading
+		(see DatabaseImportHelper::setDeltaMode) */
+		std::map<unsigned, unsigned> getObjectsXmins();
+
 		//! \brief Returns if the specified oid is amongst the system objects' oids
 		bool isSystemObject(unsigned oid);
 
@@ -234,9 +298,20 @@ class Catalog {
 		the specified list of types.	A schema name can be specified in order to filter only objects of the specifed schema */
 		vector<attribs_map> getObjectsNames(vector<ObjectType> obj_types, const QString &sch_name="", const QString &tab_name="", attribs_map extra_attribs=attribs_map(), bool sort_results=false);
 
+		/*! \brief Batched variant of the listing above: retrieves the objects of the specified types for several
+		parent tables in a single server round-trip, joining the per-parent catalog queries through UNION ALL
+		(at most 100 queries per statement). Each entry of the parents vector holds the schema and the name of
+		a parent table, the returned map is keyed by the index of the parent in that vector */
+		map<int, vector<attribs_map>> getObjectsNames(vector<ObjectType> obj_types, const vector<QStringList> &parents, attribs_map extra_attribs=attribs_map());
+
 		//! \brief Returns a set of multiple attributes (several tuples) for the specified object type
 		vector<attribs_map> getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Streaming variant of getMultipleAttributes(). Instead of materializing the whole
+		resultset, each tuple is handed to the consumer as soon as it is decoded so the caller can
+		process the attributes with a bounded amount of memory */
+		void getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs, const std::function<void(attribs_map&&)> &consumer);
+
 		/*! \brief Returns a set of multiple attributes (several tuples) for the specified catalog schema file.
 		 * This version of the method differs from the one in which the user need to provide the object type.
 		 * This one, the user is responsible to provide all attributes that will be parsed together with the
@@ -248,9 +323,20 @@ class Catalog {
 		and by table name (only when retriving child objects for a specific table) */
 		vector<attribs_map> getObjectsAttributes(ObjectType obj_type, const QString &schema="", const QString &table="", const vector<unsigned> &filter_oids={}, attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Streaming variant of getObjectsAttributes(). The tuples are handed one by one to the
+		consumer as they are decoded instead of being accumulated in a vector, keeping the memory
+		footprint independent from the amount of objects of the type */
+		void getObjectsAttributes(ObjectType obj_type, const QString &schema, const QString &table, const vector<unsigned> &filter_oids, const std::function<void(attribs_map&&)> &consumer, attribs_map extra_attribs=attribs_map());
+
 		//! \brief Returns the attributes for the object specified by its type and OID
 		attribs_map getObjectAttributes(ObjectType obj_type, unsigned oid, const QString sch_name="", const QString tab_name="", attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Returns the attributes of the columns of all the tables whose oids are specified,
+		fetched in a single set-returning round trip instead of one catalog query per table. The
+		resulting map is keyed by the table oid, each entry holding the attribute sets of that table's
+		columns. An empty oid set retrieves the columns of all tables visible by the current filter */
+		map<unsigned, vector<attribs_map>> getColumnsAttributes(const vector<unsigned> &table_oids, attribs_map extra_attribs=attribs_map());
+
 		/*! \brief Returns the OID of the named object. User can filter items by schema (if the object type is suitable to accept schema)
 		and by table name (only when retriving child objects for a specific table). The method will raise an exception if the catalog query
 		used returns more than one result. A zero OID is returned when no suitable object is found. */
@@ -291,6 +377,25 @@ class Catalog {
 		//! \brief Returns the object schema names that are able to be filtered
 		static QStringList getFilterableObjectNames();
 
+		/*! \brief Enables/disables the logging of the executed catalog queries. While enabled, every
+		 query execution is aggregated per query id recording call count, returned rows, client wall
+		 time and text fingerprint. When 'capture_server_timing' is set each query is also re-executed
+		 under EXPLAIN ANALYZE so the server side execution time is accumulated, which roughly doubles
+		 the catalog traffic and should be used only when investigating server side outliers */
+		static void setQueryLogEnabled(bool value, bool capture_server_timing=false);
+
+		//! \brief Returns the current status of the catalog query log
+		static bool isQueryLogEnabled();
+
+		//! \brief Returns a copy of the query log aggregated so far
+		static std::map<QString, QueryLogEntry> getQueryLog();
+
+		//! \brief Discards all the query log entries
+		static void clearQueryLog();
+
+		//! \brief Returns a plain text report of the query log sorted by accumulated client wall time
+		static QString dumpQueryLog();
+
 		//! \brief Performs the copy between two catalogs
 		void operator = (const Catalog &catalog);
 };
@@ -18,10 +18,18 @@
 
 #include "connection.h"
 #include <QTextStream>
+#include <QThread>
 #include <iostream>
 #include "attributes.h"
 #include "globalattributes.h"
 #include "qtcompat/qtextstreamcompat.h"
+#include "qtcompat/splitbehaviorcompat.h"
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#else
+#include <sys/select.h>
+#endif
 
 const QString Connection::SslDisable=QString("disable");
 const QString Connection::SslAllow=QString("allow");
@@ -57,11 +65,18 @@ bool Connection::print_sql=false;
 bool Connection::silence_conn_err=true;
 QStringList Connection::notices;
 
+std::map<QString, std::vector<PGconn *>> Connection::conn_pool;
+QMutex Connection::pool_mtx;
+bool Connection::pooling_enabled=true;
+std::atomic<quint64> Connection::cmd_exec_count{0};
+
 Connection::Connection()
 {
 	connection=nullptr;
-	auto_browse_db=false;	
+	auto_browse_db=false;
 	cmd_exec_timeout=0;
+	async_pending=false;
+	next_prep_stmt_id=0;
 
 	for(unsigned idx=OpValidation; idx <= OpDiff; idx++)
 		default_for_oper[idx]=false;
@@ -131,12 +146,15 @@ void Connection::setAutoBrowseDB(bool value)
 
 void Connection::generateConnectionString()
 {
-	QString value, param_str = QString("%1=%2 ");
+	connection_str=generateConnectionString(connection_params);
+}
 
-	//Scans the parameter map concatening the params (itr->first) / values (itr->second)
-	connection_str.clear();
+QString Connection::generateConnectionString(const attribs_map &params)
+{
+	QString conn_str, value, param_str = QString("%1=%2 ");
 
-	for(auto &itr : connection_params)
+	//Scans the parameter map concatening the params (itr->first) / values (itr->second)
+	for(auto &itr : params)
 	{
 		if(itr.first!=ParamAlias)
 		{
@@ -151,19 +169,21 @@ void Connection::generateConnectionString()
 			if(!value.isEmpty())
 			{
 				if(itr.first==ParamDbName)
-					connection_str.prepend(param_str.arg(itr.first).arg(value));
+					conn_str.prepend(param_str.arg(itr.first).arg(value));
 				else if(itr.first!=ParamOthers)
-					connection_str+=param_str.arg(itr.first).arg(value);
+					conn_str+=param_str.arg(itr.first).arg(value);
 				else
-					connection_str+=value;
+					conn_str+=value;
 			}
 		}
 	}
 
-	if(!connection_str.contains(ParamDbName) ||
-		 (!connection_str.contains(ParamServerFqdn) &&
-			!connection_str.contains(ParamServerIp)))
-		connection_str.clear();
+	if(!conn_str.contains(ParamDbName) ||
+		 (!conn_str.contains(ParamServerFqdn) &&
+			!conn_str.contains(ParamServerIp)))
+		conn_str.clear();
+
+	return conn_str;
 }
 
 void Connection::noticeProcessor(void *, const char *message)
@@ -222,6 +242,269 @@ bool Connection::isConnErrorSilenced()
 	return silence_conn_err;
 }
 
+void Connection::setConnectionPooling(bool value)
+{
+	pooling_enabled=value;
+
+	if(!value)
+		clearConnectionPool();
+}
+
+bool Connection::isConnectionPoolingEnabled()
+{
+	return pooling_enabled;
+}
+
+void Connection::clearConnectionPool()
+{
+	QMutexLocker lock(&pool_mtx);
+
+	for(auto &itr : conn_pool)
+	{
+		for(PGconn *conn : itr.second)
+			PQfinish(conn);
+	}
+
+	conn_pool.clear();
+}
+
+quint64 Connection::getExecutedCmdCount()
+{
+	return cmd_exec_count;
+}
+
+void Connection::refreshConnectionPool()
+{
+	std::map<QString, std::vector<PGconn *>> parked;
+
+	/* The parked descriptors are stolen from the pool so the keepalive round-trips run
+	without holding the mutex that connect()/close() contend on. A connection opened in
+	the meantime simply performs a fresh handshake */
+	{
+		QMutexLocker lock(&pool_mtx);
+		parked.swap(conn_pool);
+	}
+
+	for(auto &itr : parked)
+	{
+		std::vector<PGconn *> alive;
+
+		for(PGconn *conn : itr.second)
+		{
+			//The empty query is the cheapest complete round-trip libpq can issue
+			PGresult *res=PQexec(conn, "");
+			bool healthy=(res && PQresultStatus(res)==PGRES_EMPTY_QUERY &&
+										PQstatus(conn)==CONNECTION_OK);
+
+			if(res)
+				PQclear(res);
+
+			if(healthy)
+				alive.push_back(conn);
+			else
+				PQfinish(conn);
+		}
+
+		if(alive.empty())
+			continue;
+
+		QMutexLocker lock(&pool_mtx);
+		std::vector<PGconn *> &pool=conn_pool[itr.first];
+
+		for(PGconn *conn : alive)
+		{
+			if(pool.size() >= MaxPoolConnCount)
+				PQfinish(conn);
+			else
+				pool.push_back(conn);
+		}
+	}
+}
+
+PGconn *Connection::takePooledConnection()
+{
+	QMutexLocker lock(&pool_mtx);
+	auto itr=conn_pool.find(connection_str);
+	PGconn *conn=nullptr;
+
+	while(itr!=conn_pool.end() && !itr->second.empty())
+	{
+		conn=itr->second.back();
+		itr->second.pop_back();
+
+		/* Health check: consuming pending input detects broken sockets while the status check
+		detects sessions that were terminated by the server meanwhile */
+		if(PQconsumeInput(conn)!=0 && PQstatus(conn)==CONNECTION_OK)
+			return conn;
+
+		PQfinish(conn);
+		conn=nullptr;
+	}
+
+	return nullptr;
+}
+
+bool Connection::poolCurrentConnection()
+{
+	/* Descriptors with a bad status, an open transaction or an in-flight asynchronous
+	command can't be safely handed to another borrower, so they aren't pooled */
+	if(!pooling_enabled || async_pending ||
+			PQstatus(connection)!=CONNECTION_OK ||
+			PQtransactionStatus(connection)!=PQTRANS_IDLE)
+		return false;
+
+	QMutexLocker lock(&pool_mtx);
+	std::vector<PGconn *> &pool=conn_pool[connection_str];
+
+	if(pool.size() >= MaxPoolConnCount)
+		return false;
+
+	pool.push_back(connection);
+	return true;
+}
+
+PGconn *Connection::establishConnection()
+{
+	QString host_param=(!connection_params.count(ParamServerFqdn) || connection_params.at(ParamServerFqdn).isEmpty() ?
+												ParamServerIp : ParamServerFqdn);
+	QStringList hosts=connection_params[host_param].split(QChar(','), QtCompat::SkipEmptyParts),
+			ports=connection_params[ParamPort].split(QChar(','), QtCompat::SkipEmptyParts);
+
+	/* With a single candidate host there is nothing to race, so the establishment is
+	delegated to libpq which honors connect_timeout by itself */
+	if(hosts.size() <= 1)
+		return PQconnectdb(connection_str.toStdString().c_str());
+
+	struct Candidate {
+		PGconn *conn;
+		PostgresPollingStatusType status;
+	};
+
+	std::vector<Candidate> candidates;
+	QString last_error;
+	int timeout_secs=connection_params[ParamConnTimeout].toInt(),
+			next_host=0;
+	qint64 now=QDateTime::currentMSecsSinceEpoch(),
+			next_start=now,
+			deadline=(timeout_secs > 0 ? now + (timeout_secs * 1000) : 0);
+
+	while(true)
+	{
+		now=QDateTime::currentMSecsSinceEpoch();
+
+		/* Starts the attempt to the next candidate host once the stagger delay of the previous
+		one elapsed, or immediately when every attempt started so far has already failed */
+		while(next_host < hosts.size() && (now >= next_start || candidates.empty()))
+		{
+			attribs_map params=connection_params;
+			params[host_param]=hosts[next_host].trimmed();
+
+			//Ports are paired with hosts positionally only when one port is given per host
+			if(ports.size()==hosts.size())
+				params[ParamPort]=ports[next_host].trimmed();
+
+			PGconn *conn=PQconnectStart(generateConnectionString(params).toStdString().c_str());
+
+			if(conn && PQstatus(conn)!=CONNECTION_BAD)
+				candidates.push_back({conn, PGRES_POLLING_WRITING});
+			else
+			{
+				if(conn)
+				{
+					last_error=PQerrorMessage(conn);
+					PQfinish(conn);
+				}
+			}
+
+			next_host++;
+			next_start=now + HappyEyeballsDelay;
+		}
+
+		//Waits (briefly) for any of the in-flight sockets to become ready
+		fd_set rfds, wfds;
+		int max_fd=-1;
+
+		FD_ZERO(&rfds);
+		FD_ZERO(&wfds);
+
+		for(auto &cand : candidates)
+		{
+			int sock=PQsocket(cand.conn);
+
+			if(cand.status==PGRES_POLLING_READING)
+				FD_SET(sock, &rfds);
+			else
+				FD_SET(sock, &wfds);
+
+			if(sock > max_fd)
+				max_fd=sock;
+		}
+
+		if(max_fd >= 0)
+		{
+			timeval tv={0, 50 * 1000};
+			select(max_fd + 1, &rfds, &wfds, nullptr, &tv);
+		}
+		else
+			QThread::msleep(10);
+
+		//Advances the handshake of every ready candidate
+		for(auto itr=candidates.begin(); itr!=candidates.end();)
+		{
+			int sock=PQsocket(itr->conn);
+			bool ready=(itr->status==PGRES_POLLING_READING ? FD_ISSET(sock, &rfds) : FD_ISSET(sock, &wfds));
+
+			if(!ready)
+			{
+				itr++;
+				continue;
+			}
+
+			itr->status=PQconnectPoll(itr->conn);
+
+			if(itr->status==PGRES_POLLING_OK)
+			{
+				//The first completed handshake wins and the remaining attempts are discarded
+				PGconn *winner=itr->conn;
+
+				for(auto &cand : candidates)
+				{
+					if(cand.conn!=winner)
+						PQfinish(cand.conn);
+				}
+
+				return winner;
+			}
+			else if(itr->status==PGRES_POLLING_FAILED)
+			{
+				last_error=PQerrorMessage(itr->conn);
+				PQfinish(itr->conn);
+				itr=candidates.erase(itr);
+			}
+			else
+				itr++;
+		}
+
+		//All candidates were tried and failed
+		if(candidates.empty() && next_host >= hosts.size())
+			break;
+
+		//The overall timeout expired: the pending attempts are discarded
+		if(deadline > 0 && now >= deadline)
+		{
+			for(auto &cand : candidates)
+				PQfinish(cand.conn);
+
+			last_error=QT_TR_NOOP("timeout expired");
+			break;
+		}
+	}
+
+	throw Exception(Exception::getErrorMessage(ErrorCode::ConnectionNotStablished)
+					.arg(last_error), ErrorCode::ConnectionNotStablished,
+					__PRETTY_FUNCTION__, __FILE__, __LINE__);
+}
+
 void Connection::connect()
 {
 	/* If the connection string is not established indicates that the user
@@ -242,8 +525,32 @@ void Connection::connect()
 		}
 	}
 
-	//Try to connect to the database
-	connection=PQconnectdb(connection_str.toStdString().c_str());
+	//Reusing a warm descriptor for the same server/database when available
+	if(pooling_enabled)
+	{
+		connection=takePooledConnection();
+
+		if(connection)
+		{
+			//Scrubs any session state (GUCs, temp tables, prepared statements) left by the previous borrower
+			PGresult *res=PQexec(connection, "DISCARD ALL");
+			bool scrubbed=(PQresultStatus(res)==PGRES_COMMAND_OK);
+
+			PQclear(res);
+
+			if(!scrubbed)
+			{
+				PQfinish(connection);
+				connection=nullptr;
+			}
+		}
+	}
+
+	/* Tries to connect to the database. When several candidate hosts are configured
+	the attempts are raced concurrently (see establishConnection()) */
+	if(!connection)
+		connection=establishConnection();
+
 	last_cmd_execution=QDateTime::currentDateTime();
 
 	/* If the connection descriptor has not been allocated or if the connection state
@@ -270,12 +577,17 @@ void Connection::close()
 {
 	if(connection)
 	{
-		//Finalizes the connection if the status is OK
-		if(PQstatus(connection) == CONNECTION_OK)
+		//Parks the descriptor on the pool for reuse, finalizing it when pooling isn't possible
+		if(!poolCurrentConnection() && PQstatus(connection) == CONNECTION_OK)
 			PQfinish(connection);
 
 		connection=nullptr;
 		last_cmd_execution=QDateTime();
+		async_pending=false;
+
+		/* Prepared statements are bound to the finished/parked session. Parked descriptors
+		are scrubbed with DISCARD ALL upon reuse, which drops them server-side too */
+		prepared_stmts.clear();
 	}
 }
 
@@ -405,7 +717,7 @@ QStringList Connection::getNotices()
 	return notices;
 }
 
-void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
+void Connection::executeDMLCommand(const QString &sql, ResultSet &result, bool binary_results)
 {
 	ResultSet *new_res=nullptr;
 	PGresult *sql_res=nullptr;
@@ -416,9 +728,14 @@ void Connection::executeDMLCommand(const QString &sql, ResultSet &result)
 
 	validateConnectionStatus();
 	notices.clear();
+	cmd_exec_count++;
 
 	//Alocates a new result to receive the resultset returned by the sql command
-	sql_res=PQexec(connection, sql.toStdString().c_str());
+	if(binary_results)
+		//Requesting the resultset in binary format avoids the server-side text rendering of every cell
+		sql_res=PQexecParams(connection, sql.toStdString().c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+	else
+		sql_res=PQexec(connection, sql.toStdString().c_str());
 
 	//Prints the SQL to stdout when the flag is active
 	if(print_sql)
@@ -457,6 +774,7 @@ void Connection::executeDDLCommand(const QString &sql)
 
 	validateConnectionStatus();
 	notices.clear();
+	cmd_exec_count++;
 	sql_res=PQexec(connection, sql.toStdString().c_str());
 
 	//Prints the SQL to stdout when the flag is active
@@ -481,6 +799,535 @@ void Connection::executeDDLCommand(const QString &sql)
 	PQclear(sql_res);
 }
 
+void Connection::executePipelinedCommands(const QStringList &cmds, int &exec_cnt)
+{
+	exec_cnt=0;
+
+	//Raise an error in case the user try to operate on a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Raise an error if there is an asynchronous command with a pending resultset
+	if(async_pending)
+		throw Exception(ErrorCode::AsyncCmdAlreadyDispatched, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+
+#ifdef LIBPQ_HAS_PIPELINING
+	PGresult *sql_res=nullptr;
+	ExecStatusType status;
+	QString error_msg, error_extra;
+	bool failed=false;
+
+	if(PQenterPipelineMode(connection)==0)
+	{
+		//If the connection refuses the pipeline mode the commands are executed in the traditional way
+		for(auto &cmd : cmds)
+		{
+			executeDDLCommand(cmd);
+			exec_cnt++;
+		}
+
+		return;
+	}
+
+	for(auto &cmd : cmds)
+	{
+		/* In pipeline mode the commands are dispatched through the extended query protocol without
+		 * waiting for the result of the previous ones, so the whole batch travels to the server at once */
+		if(PQsendQuery(connection, cmd.toStdString().c_str())==0)
+		{
+			error_msg=PQerrorMessage(connection);
+			failed=true;
+			break;
+		}
+
+		//Prints the SQL to stdout when the flag is active
+		if(print_sql)
+		{
+			QTextStream out(stdout);
+			out << QString("\n---\n") << cmd << QtCompat::endl;
+		}
+	}
+
+	//Marks the end of the batch and flushes the queued commands to the server
+	PQpipelineSync(connection);
+
+	/* Reaping the results of the queued commands. A failed command makes the server
+	 * discard the remaining ones of the batch (PGRES_PIPELINE_ABORTED) */
+	while(true)
+	{
+		sql_res=PQgetResult(connection);
+
+		//A null result is just the separator between the results of two queued commands
+		if(!sql_res)
+			continue;
+
+		status=PQresultStatus(sql_res);
+
+		if(status==PGRES_PIPELINE_SYNC)
+		{
+			PQclear(sql_res);
+			break;
+		}
+
+		if(status==PGRES_FATAL_ERROR || status==PGRES_BAD_RESPONSE)
+		{
+			//Only the first failure is reported since the subsequent ones are consequence of the aborted pipeline
+			if(!failed)
+			{
+				error_msg=PQresultErrorMessage(sql_res);
+				error_extra=PQresultErrorField(sql_res, PG_DIAG_SQLSTATE);
+				failed=true;
+			}
+		}
+		else if(status!=PGRES_PIPELINE_ABORTED && !failed)
+			exec_cnt++;
+
+		PQclear(sql_res);
+	}
+
+	PQexitPipelineMode(connection);
+
+	if(failed)
+	{
+		/* The commands queued between two synchronization points run in a single implicit
+		 * transaction, so a failure also rolls back the commands executed before it */
+		exec_cnt=0;
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(error_msg),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, error_extra);
+	}
+#else
+	/* The installed libpq doesn't expose the pipeline api (available since PostgreSQL 14),
+	 * so the commands are executed with one synchronous round-trip each */
+	for(auto &cmd : cmds)
+	{
+		executeDDLCommand(cmd);
+		exec_cnt++;
+	}
+#endif
+}
+
+int Connection::executeCopyFrom(const QString &copy_cmd, const std::function<QByteArray()> &chunk_provider)
+{
+	PGresult *sql_res=nullptr;
+	QByteArray chunk;
+	int copied_rows=0;
+
+	//Raise an error in case the user try to operate on a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Raise an error if there is an asynchronous command with a pending resultset
+	if(async_pending)
+		throw Exception(ErrorCode::AsyncCmdAlreadyDispatched, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+	cmd_exec_count++;
+	sql_res=PQexec(connection, copy_cmd.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_cmd << QtCompat::endl;
+	}
+
+	//Raise an error in case the command doesn't put the connection in copy-in state
+	if(PQresultStatus(sql_res)!=PGRES_COPY_IN)
+	{
+		QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+		PQclear(sql_res);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	PQclear(sql_res);
+
+	/* Streaming the data chunks returned by the provider. An empty buffer
+	 * signals that there is no more data to be copied */
+	while(!(chunk=chunk_provider()).isEmpty())
+	{
+		if(PQputCopyData(connection, chunk.data(), chunk.size()) < 0)
+		{
+			//Aborting the copy operation so the server discards the partially sent data
+			PQputCopyEnd(connection, PQerrorMessage(connection));
+
+			throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+							.arg(PQerrorMessage(connection)),
+							ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		}
+	}
+
+	if(PQputCopyEnd(connection, nullptr) < 0)
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	/* Retrieving the final command status. The server reports the errors raised
+	 * while processing the copied rows (e.g. constraint violations) only here */
+	while((sql_res=PQgetResult(connection)))
+	{
+		if(PQresultStatus(sql_res)==PGRES_FATAL_ERROR || PQresultStatus(sql_res)==PGRES_BAD_RESPONSE)
+		{
+			QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+			PQclear(sql_res);
+
+			//Discarding any remaining results so the connection returns to the idle state
+			while((sql_res=PQgetResult(connection)))
+				PQclear(sql_res);
+
+			throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+							.arg(PQerrorMessage(connection)),
+							ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+		}
+
+		copied_rows=QString(PQcmdTuples(sql_res)).toInt();
+		PQclear(sql_res);
+	}
+
+	return copied_rows;
+}
+
+int Connection::executeCopyTo(const QString &copy_cmd, const std::function<void(const QByteArray &)> &chunk_handler)
+{
+	PGresult *sql_res=nullptr;
+	char *row_buf=nullptr;
+	int buf_len=0, copied_rows=0;
+
+	//Raise an error in case the user try to operate on a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Raise an error if there is an asynchronous command with a pending resultset
+	if(async_pending)
+		throw Exception(ErrorCode::AsyncCmdAlreadyDispatched, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+	cmd_exec_count++;
+	sql_res=PQexec(connection, copy_cmd.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_cmd << QtCompat::endl;
+	}
+
+	//Raise an error in case the command doesn't put the connection in copy-out state
+	if(PQresultStatus(sql_res)!=PGRES_COPY_OUT)
+	{
+		QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+		PQclear(sql_res);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	PQclear(sql_res);
+
+	/* Consuming one row buffer at a time so the memory usage stays proportional
+	 * to a single row instead of to the whole resultset */
+	while((buf_len=PQgetCopyData(connection, &row_buf, 0)) > 0)
+	{
+		chunk_handler(QByteArray(row_buf, buf_len));
+		PQfreemem(row_buf);
+		copied_rows++;
+	}
+
+	if(buf_len==-2)
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Retrieving the final command status
+	while((sql_res=PQgetResult(connection)))
+	{
+		if(PQresultStatus(sql_res)==PGRES_FATAL_ERROR || PQresultStatus(sql_res)==PGRES_BAD_RESPONSE)
+		{
+			QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+			PQclear(sql_res);
+
+			while((sql_res=PQgetResult(connection)))
+				PQclear(sql_res);
+
+			throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+							.arg(PQerrorMessage(connection)),
+							ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+		}
+
+		PQclear(sql_res);
+	}
+
+	return copied_rows;
+}
+
+void Connection::executePreparedCommand(const QString &stmt_id, const QString &sql, ResultSet &result)
+{
+	ResultSet *new_res=nullptr;
+	PGresult *sql_res=nullptr;
+
+	//Raise an error in case the user try to operate on a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+
+	auto itr=prepared_stmts.find(stmt_id);
+
+	//Avoids an unbounded growth of session-level statements
+	if(itr==prepared_stmts.end() && prepared_stmts.size() >= MaxPreparedStmts)
+	{
+		sql_res=PQexec(connection, "DEALLOCATE ALL");
+		PQclear(sql_res);
+		prepared_stmts.clear();
+	}
+
+	//Prepares the statement upon the first execution or when its query text has changed
+	if(itr==prepared_stmts.end() || itr->second.second!=sql)
+	{
+		QString stmt_name=QString("pgmodeler_stmt_%1").arg(next_prep_stmt_id++);
+
+		//Discards the outdated version of the statement on the server
+		if(itr!=prepared_stmts.end())
+		{
+			sql_res=PQexec(connection, (QString("DEALLOCATE ") + itr->second.first).toStdString().c_str());
+			PQclear(sql_res);
+			prepared_stmts.erase(itr);
+		}
+
+		sql_res=PQprepare(connection, stmt_name.toStdString().c_str(), sql.toStdString().c_str(), 0, nullptr);
+
+		//Raise an error in case the statement preparation is not sucessful
+		if(strlen(PQerrorMessage(connection)) > 0)
+		{
+			QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+			PQclear(sql_res);
+
+			throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+							.arg(PQerrorMessage(connection)),
+							ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+		}
+
+		PQclear(sql_res);
+		itr=prepared_stmts.insert({stmt_id, std::make_pair(stmt_name, sql)}).first;
+	}
+
+	sql_res=PQexecPrepared(connection, itr->second.first.toStdString().c_str(), 0, nullptr, nullptr, nullptr, 0);
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << sql << QtCompat::endl;
+	}
+
+	//Raise an error in case the command sql execution is not sucessful
+	if(strlen(PQerrorMessage(connection)) > 0)
+	{
+		QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+		PQclear(sql_res);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	//Generates the resultset based on the sql result descriptor
+	new_res=new ResultSet(sql_res);
+
+	//Copy the new resultset to the parameter resultset
+	result=*(new_res);
+
+	//Deallocate the new resultset
+	delete new_res;
+	PQclear(sql_res);
+}
+
+void Connection::sendDMLCommand(const QString &sql, bool single_row_mode)
+{
+	//Raise an error in case the user try to operate on a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Raise an error if the result of a previously dispatched command wasn't consumed yet
+	if(async_pending)
+		throw Exception(ErrorCode::AsyncCmdAlreadyDispatched, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+
+	//Dispatches the command returning immediately, without waiting the server processes it
+	if(PQsendQuery(connection, sql.toStdString().c_str())==0)
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	/* In single-row mode the server streams the resultset one tuple at a time, each one
+	retrievable through getNextAsyncResult() as soon as it arrives */
+	if(single_row_mode)
+		PQsetSingleRowMode(connection);
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << sql << QtCompat::endl;
+	}
+
+	async_pending=true;
+}
+
+bool Connection::isResultReady()
+{
+	//Raise an error in case the user try to operate on a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Raise an error in case there is no dispatched command to check
+	if(!async_pending)
+		throw Exception(ErrorCode::OprNoPendingAsyncCmd, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	//Consumes the data already available on the socket
+	if(PQconsumeInput(connection)==0)
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	}
+
+	return PQisBusy(connection)==0;
+}
+
+void Connection::getAsyncResult(ResultSet &result)
+{
+	ResultSet *new_res=nullptr;
+	PGresult *sql_res=nullptr, *aux_res=nullptr;
+
+	//Sleeps on the connection socket until the server response is fully received
+	while(!isResultReady())
+	{
+		fd_set input_fds;
+		int socket=PQsocket(connection);
+
+		FD_ZERO(&input_fds);
+		FD_SET(socket, &input_fds);
+		select(socket + 1, &input_fds, nullptr, nullptr, nullptr);
+	}
+
+	/* Drains the result queue since commands dispatched via PQsendQuery can produce several
+	resultsets. Like in PQexec only the last one is preserved */
+	while((aux_res=PQgetResult(connection)))
+	{
+		if(sql_res)
+			PQclear(sql_res);
+
+		sql_res=aux_res;
+	}
+
+	async_pending=false;
+
+	//Raise an error in case the command sql execution is not sucessful
+	if(strlen(PQerrorMessage(connection)) > 0)
+	{
+		QString field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+		PQclear(sql_res);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	//Generates the resultset based on the sql result descriptor
+	new_res=new ResultSet(sql_res);
+
+	//Copy the new resultset to the parameter resultset
+	result=*(new_res);
+
+	//Deallocate the new resultset
+	delete new_res;
+	PQclear(sql_res);
+}
+
+bool Connection::getNextAsyncResult(ResultSet &result)
+{
+	PGresult *sql_res=nullptr;
+	int res_state=0;
+
+	//Sleeps on the connection socket until the next partial resultset is fully received
+	while(!isResultReady())
+	{
+		fd_set input_fds;
+		int socket=PQsocket(connection);
+
+		FD_ZERO(&input_fds);
+		FD_SET(socket, &input_fds);
+		select(socket + 1, &input_fds, nullptr, nullptr, nullptr);
+	}
+
+	sql_res=PQgetResult(connection);
+
+	//A null result indicates that all the resultsets of the command were consumed
+	if(!sql_res)
+	{
+		async_pending=false;
+		return false;
+	}
+
+	res_state=PQresultStatus(sql_res);
+
+	if(res_state==PGRES_FATAL_ERROR || res_state==PGRES_BAD_RESPONSE)
+	{
+		QString msg=QString(PQresultErrorMessage(sql_res)),
+				field=QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+
+		PQclear(sql_res);
+
+		//Drains the remaining results so the connection is left ready for new commands
+		while((sql_res=PQgetResult(connection)))
+			PQclear(sql_res);
+
+		async_pending=false;
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(msg), ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, field);
+	}
+
+	/* The ownership of the sql result is transferred to the parameter resultset instead of
+	copying it, since in single-row mode a copy per retrieved tuple would defeat the purpose
+	of the streaming */
+	ResultSet aux_res(sql_res);
+
+	result.clearResultSet();
+	result.sql_result=aux_res.sql_result;
+	result.current_tuple=aux_res.current_tuple;
+	result.empty_result=aux_res.empty_result;
+	result.is_res_copied=false;
+
+	//Avoids the destruction of the transferred sql result when the auxiliary resultset goes out of scope
+	aux_res.is_res_copied=true;
+
+	return true;
+}
+
 void Connection::setDefaultForOperation(unsigned op_id, bool value)
 {
 	if(op_id > OpNone)
@@ -30,6 +30,11 @@
 #include "attribsmap.h"
 #include <QRegExp>
 #include <QDateTime>
+#include <QMutex>
+#include <map>
+#include <vector>
+#include <atomic>
+#include <functional>
 
 class Connection {
 	private:
@@ -52,6 +57,49 @@ class Connection {
 		errors related to the exceeded timeout */
 		unsigned cmd_exec_timeout;
 
+		/*! \brief Indicates that a command dispatched via sendDMLCommand() is in-flight and
+		its resultset wasn't retrieved yet (see getAsyncResult()) */
+		bool async_pending;
+
+		/*! \brief Statements already prepared on the current session, keyed by the caller supplied
+		statement id. Each entry holds the server-side statement name and the query text it was
+		prepared with, the latter used to detect when a re-preparation is needed
+		(see executePreparedCommand()) */
+		std::map<QString, std::pair<QString, QString>> prepared_stmts;
+
+		//! \brief Sequential generator for the server-side prepared statement names
+		unsigned next_prep_stmt_id;
+
+		//! \brief Maximum amount of statements kept prepared per session
+		static constexpr unsigned MaxPreparedStmts=64;
+
+		/*! \brief Warm connection descriptors parked by close() for later reuse, keyed by
+		connection string. Avoids paying the TLS/auth handshake again when import, diff and
+		export helpers open several connections to the same server in sequence */
+		static std::map<QString, std::vector<PGconn *>> conn_pool;
+
+		//! \brief Controls the concurrent access to the connection pool
+		static QMutex pool_mtx;
+
+		//! \brief Indicates if warm connection reuse is enabled (default is true)
+		static bool pooling_enabled;
+
+		/*! \brief Counts the commands executed by all connections of the process. Used by the
+		instrumentation code to attribute query counts to operation phases (see getExecutedCmdCount()) */
+		static std::atomic<quint64> cmd_exec_count;
+
+		//! \brief Maximum amount of warm descriptors kept on the pool per server/database
+		static constexpr unsigned MaxPoolConnCount=4;
+
+		/*! \brief Takes a healthy warm descriptor for the current connection string from the pool.
+		Unhealthy descriptors found in the way are finished. Returns nullptr when none is available */
+		PGconn *takePooledConnection();
+
+		/*! \brief Parks the current descriptor on the pool instead of finishing it. Returns false
+		when the descriptor can't be pooled (pooling disabled, bad connection status, open
+		transaction, pending asynchronous command or full pool) */
+		bool poolCurrentConnection();
+
 		/*! \brief List of notices generated during the command execution
 		The list is filled only if notice_enabled is true */
 		static QStringList notices;
@@ -59,6 +107,21 @@ class Connection {
 		//! \brief Generates the connection string based on the parameter map
 		void generateConnectionString();
 
+		//! \brief Generates a connection string from an arbitrary parameter map (see generateConnectionString())
+		static QString generateConnectionString(const attribs_map &params);
+
+		/*! \brief Delay (in milliseconds) before each additional candidate host attempt is
+		started when racing the connection establishment (happy-eyeballs) */
+		static constexpr int HappyEyeballsDelay=250;
+
+		/*! \brief Establishes the connection asynchronously (PQconnectStart/PQconnectPoll) racing
+		concurrent attempts when the host parameter lists several candidates, happy-eyeballs style:
+		the attempt to the next host is started HappyEyeballsDelay ms after the previous one instead
+		of waiting its full timeout. The first attempt that completes the handshake wins and the
+		remaining ones are finished, so a dead or unroutable host no longer serializes in front of a
+		healthy one. Raises an error when every candidate fails or the configured timeout expires */
+		PGconn *establishConnection();
+
 		/*! \brief This static method disable the notice messages when executing commands.
 		By default all connections are created with notice disabled. To enable it the user
 		must call Connection::setNoticeEnabled(). Note: connections already stablished
@@ -160,6 +223,28 @@ class Connection {
 		//! \brief Returns the current state for silence connection errors
 		static bool isConnErrorSilenced();
 
+		/*! \brief Toggles the reuse of warm server connections. When enabled (the default) close()
+		parks healthy, transaction-free descriptors on a per-server pool and connect() reuses them
+		(after a `DISCARD ALL' to scrub any session state) instead of performing a new handshake.
+		Disabling the pooling discards all parked descriptors */
+		static void setConnectionPooling(bool value);
+
+		//! \brief Returns the current state of the connection pooling
+		static bool isConnectionPoolingEnabled();
+
+		//! \brief Finishes all warm descriptors currently parked on the pool
+		static void clearConnectionPool();
+
+		/*! \brief Runs a keepalive round-trip on every warm descriptor parked on the pool,
+		finishing the ones that turned out dead. Besides the health check, the round-trip resets
+		server-side idle timeouts so the descriptors stay reusable. The round-trips block, thus
+		this method is meant to be invoked periodically from a worker thread */
+		static void refreshConnectionPool();
+
+		/*! \brief Returns the total amount of commands executed by all connections of the process.
+		Taking the difference between two readings gives the amount of queries ran in between */
+		static quint64 getExecutedCmdCount();
+
 		/*! \brief Sets one connection parameter. This method can only be called before
 		 the connection to the database */
 		void setConnectionParam(const QString &param, const QString &value);
@@ -224,14 +309,72 @@ class Connection {
 		bool isAutoBrowseDB();
 
 		/*! \brief Executes a DML command on the server using the opened connection.
-		 Its mandatory to specify the object to receive the returned resultset. */
-		void executeDMLCommand(const QString &sql, ResultSet &result);
+		 Its mandatory to specify the object to receive the returned resultset.
+		 When binary_results is true the command is executed through PQexecParams requesting
+		 the resultset in binary format, so the typed accessors of ResultSet can read the
+		 column values without text parsing (see ResultSet::getColumnOidValue and related) */
+		void executeDMLCommand(const QString &sql, ResultSet &result, bool binary_results=false);
+
+		/*! \brief Executes a DML command through a server-side prepared statement. The statement is
+		 prepared upon the first execution and reused while the query text bound to stmt_id stays
+		 the same, so repeated executions skip the server-side parsing of the full command text
+		 (see Catalog::executeCatalogQuery). When the text bound to stmt_id changes the statement
+		 is transparently re-prepared */
+		void executePreparedCommand(const QString &stmt_id, const QString &sql, ResultSet &result);
 
 		/*! \brief Executes a DDL command on the server using the opened connection.
 		 The user don't need to specify the resultset since the commando executed is intended
 		 to be an data definition one  */
 		void executeDDLCommand(const QString &sql);
 
+		/*! \brief Executes a batch of DDL/utility commands using the libpq pipeline mode, queueing
+		 all of them before waiting for the server replies so the whole batch pays a single network
+		 round-trip. The parameter exec_cnt receives the amount of commands whose effects persisted
+		 on the server. Since the batch runs in a single implicit transaction, a failure discards the
+		 queued commands, rolls back the already executed ones (exec_cnt is zeroed) and an error is
+		 raised carrying the SQLSTATE of the first failure. When the installed libpq doesn't expose
+		 the pipeline api (available since PostgreSQL 14) the commands are executed with one
+		 round-trip each */
+		void executePipelinedCommands(const QStringList &cmds, int &exec_cnt);
+
+		/*! \brief Executes a COPY ... FROM STDIN command streaming to the server the data chunks
+		 returned by chunk_provider. The provider is called repeatedly and must return the next
+		 portion of the copy payload (one or more lines in the format expected by the command),
+		 returning an empty buffer to signal the end of the data. Since the rows travel through
+		 the copy protocol instead of individual INSERT commands the per-row parsing/planning
+		 overhead on the server is eliminated, which makes this the preferred path for bulk data
+		 loads. Returns the amount of rows effectively copied */
+		int executeCopyFrom(const QString &copy_cmd, const std::function<QByteArray()> &chunk_provider);
+
+		/*! \brief Executes a COPY ... TO STDOUT command handing each row buffer sent by the server
+		 to chunk_handler as soon as it arrives. The rows are consumed incrementally so the memory
+		 usage stays proportional to a single row instead of to the whole resultset. Returns the
+		 amount of rows effectively copied */
+		int executeCopyTo(const QString &copy_cmd, const std::function<void(const QByteArray &)> &chunk_handler);
+
+		/*! \brief Dispatches a DML command on the server without blocking while it is processed.
+		 Only one command can be in-flight per connection at a time, its resultset must be consumed
+		 via getAsyncResult() or getNextAsyncResult() before dispatching a new one. To overlap several
+		 commands over the network the caller must dispatch each one on its own connection.
+		 When single_row_mode is true the resultset is streamed by the server one row at a time and
+		 must be consumed through successive getNextAsyncResult() calls, avoiding the full
+		 materialization of huge resultsets in memory */
+		void sendDMLCommand(const QString &sql, bool single_row_mode=false);
+
+		/*! \brief Returns true when the resultset of the command dispatched via sendDMLCommand()
+		 can be retrieved by getAsyncResult() without blocking */
+		bool isResultReady();
+
+		/*! \brief Retrieves the resultset of the command dispatched via sendDMLCommand(), sleeping
+		 on the connection socket until the server response is fully received */
+		void getAsyncResult(ResultSet &result);
+
+		/*! \brief Retrieves the next partial resultset of the command dispatched via sendDMLCommand().
+		 In single-row mode each retrieved resultset holds a single tuple, so the rows can be consumed
+		 incrementally while the server is still sending the remaining ones. Returns false when all the
+		 resultsets of the command were consumed */
+		bool getNextAsyncResult(ResultSet &result);
+
 		//! \brief Toggles the default status for the connect in the specified operation (OP_??? constants).
 		void setDefaultForOperation(unsigned op_id, bool value);
 
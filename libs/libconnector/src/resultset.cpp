@@ -17,6 +17,7 @@
 */
 
 #include "resultset.h"
+#include <QtEndian>
 
 ResultSet::ResultSet()
 {
@@ -168,6 +169,41 @@ char *ResultSet::getColumnValue(int column_idx)
 	return PQgetvalue(sql_result, current_tuple, column_idx);
 }
 
+void ResultSet::getColumnValues(int column_idx, QStringList &values)
+{
+	validateColumnIndex(column_idx);
+
+	int tup_cnt=PQntuples(sql_result);
+
+	values.clear();
+	values.reserve(tup_cnt);
+
+	for(int tup=0; tup < tup_cnt; tup++)
+	{
+		if(PQgetisnull(sql_result, tup, column_idx))
+			values.append(QString());
+		else
+			values.append(QString::fromUtf8(PQgetvalue(sql_result, tup, column_idx),
+											PQgetlength(sql_result, tup, column_idx)));
+	}
+}
+
+QByteArray ResultSet::getColumnBuffer(const QString &column_name)
+{
+	int column_idx=validateColumnName(column_name);
+
+	return QByteArray::fromRawData(PQgetvalue(sql_result, current_tuple, column_idx),
+								   PQgetlength(sql_result, current_tuple, column_idx));
+}
+
+QByteArray ResultSet::getColumnBuffer(int column_idx)
+{
+	validateColumnIndex(column_idx);
+
+	return QByteArray::fromRawData(PQgetvalue(sql_result, current_tuple, column_idx),
+								   PQgetlength(sql_result, current_tuple, column_idx));
+}
+
 bool ResultSet::isColumnValueNull(int column_idx)
 {
 	validateColumnIndex(column_idx);
@@ -200,6 +236,148 @@ int ResultSet::getColumnSize(int column_idx)
 	return PQgetlength(sql_result, current_tuple, column_idx);
 }
 
+unsigned ResultSet::getColumnOidValue(const QString &column_name)
+{
+	return getColumnOidValue(validateColumnName(column_name));
+}
+
+unsigned ResultSet::getColumnOidValue(int column_idx)
+{
+	validateColumnIndex(column_idx);
+
+	char *value=PQgetvalue(sql_result, current_tuple, column_idx);
+
+	//In binary format oids are transmitted as 4 byte big-endian integers
+	if(PQfformat(sql_result, column_idx)==1)
+		return qFromBigEndian<quint32>(reinterpret_cast<const uchar *>(value));
+
+	return QString(value).toUInt();
+}
+
+bool ResultSet::getColumnBoolValue(const QString &column_name)
+{
+	return getColumnBoolValue(validateColumnName(column_name));
+}
+
+bool ResultSet::getColumnBoolValue(int column_idx)
+{
+	validateColumnIndex(column_idx);
+
+	char *value=PQgetvalue(sql_result, current_tuple, column_idx);
+
+	//In binary format booleans are transmitted as a single byte
+	if(PQfformat(sql_result, column_idx)==1)
+		return (*value != 0);
+
+	return (*value == 't');
+}
+
+long long ResultSet::getColumnIntValue(const QString &column_name)
+{
+	return getColumnIntValue(validateColumnName(column_name));
+}
+
+long long ResultSet::getColumnIntValue(int column_idx)
+{
+	validateColumnIndex(column_idx);
+
+	char *value=PQgetvalue(sql_result, current_tuple, column_idx);
+
+	if(PQfformat(sql_result, column_idx)==1)
+	{
+		const uchar *bytes=reinterpret_cast<const uchar *>(value);
+
+		/* In binary format integers are transmitted as big-endian values whose width
+		depends on the column type (smallint, integer or bigint) */
+		switch(PQgetlength(sql_result, current_tuple, column_idx))
+		{
+			case 2: return qFromBigEndian<qint16>(bytes);
+			case 4: return qFromBigEndian<qint32>(bytes);
+			case 8: return qFromBigEndian<qint64>(bytes);
+
+			//Raise an error in case the column isn't of an integer type
+			default:
+				throw Exception(ErrorCode::RefInvalidTupleColumn, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+		}
+	}
+
+	return QString(value).toLongLong();
+}
+
+QStringList ResultSet::getColumnArrayValue(const QString &column_name)
+{
+	return getColumnArrayValue(validateColumnName(column_name));
+}
+
+QStringList ResultSet::getColumnArrayValue(int column_idx)
+{
+	QStringList elems;
+
+	validateColumnIndex(column_idx);
+
+	if(isColumnValueNull(column_idx))
+		return elems;
+
+	char *value=PQgetvalue(sql_result, current_tuple, column_idx);
+
+	if(PQfformat(sql_result, column_idx)==1)
+	{
+		/* Binary array wire format: number of dimensions, null bitmap flag and element type oid,
+		followed by one (dimension, lower bound) pair per dimension and the elements themselves,
+		each one a 4 byte length (-1 for null) followed by the element payload */
+		const uchar *bytes=reinterpret_cast<const uchar *>(value);
+		int ndims=qFromBigEndian<qint32>(bytes), elem_cnt=1, elem_len=0;
+
+		if(ndims==0)
+			return elems;
+
+		for(int dim=0; dim < ndims; dim++)
+			elem_cnt*=qFromBigEndian<qint32>(bytes + 12 + (dim * 8));
+
+		bytes+=12 + (ndims * 8);
+
+		for(int elem=0; elem < elem_cnt; elem++)
+		{
+			elem_len=qFromBigEndian<qint32>(bytes);
+			bytes+=4;
+
+			//Null elements carry a -1 length and no payload
+			if(elem_len < 0)
+				elems.append(QString());
+			else
+			{
+				elems.append(QString::fromUtf8(reinterpret_cast<const char *>(bytes), elem_len));
+				bytes+=elem_len;
+			}
+		}
+	}
+	else
+	{
+		//In text format the array comes as `{elem,elem,...}'
+		QString list=QString(value);
+
+		list.remove(0, 1);
+		list.chop(1);
+
+		if(!list.isEmpty())
+		{
+			elems=list.split(',');
+
+			//Unquoting elements that carry special characters
+			for(auto &elem : elems)
+			{
+				if(elem.startsWith('"') && elem.endsWith('"'))
+				{
+					elem.remove(0, 1);
+					elem.chop(1);
+				}
+			}
+		}
+	}
+
+	return elems;
+}
+
 attribs_map ResultSet::getTupleValues()
 {
 	attribs_map tup_vals;
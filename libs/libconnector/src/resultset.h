@@ -32,6 +32,7 @@ It the resultset contains data the user must call ResultSet::accessTuple() to ac
 #include <libpq-fe.h>
 #include <cstdlib>
 #include <iostream>
+#include <QStringList>
 
 //This constant is defined on PostgreSQL source code src/catalog/pg_type.h
 #define BYTEAOID 17
@@ -79,10 +80,44 @@ class ResultSet {
 		char *getColumnValue(const QString &column_name);
 		char *getColumnValue(int column_idx);
 
+		/*! \brief Fills 'values' with the textual values of the whole specified column in one pass,
+		 one entry per tuple, regardless of the current navigation state. Null values are appended as
+		 null QStrings (see QString::isNull()) so they remain distinguishable from empty strings.
+		 This columnar access avoids the per-cell navigation and validation overhead of
+		 getColumnValue() when filling large result grids */
+		void getColumnValues(int column_idx, QStringList &values);
+
+		/*! \brief Returns a zero-copy view of the column value in the current tuple. The returned
+		 QByteArray only wraps the buffer owned by the underlying resultset storage (see
+		 QByteArray::fromRawData), so the view must not outlive this resultset */
+		QByteArray getColumnBuffer(const QString &column_name);
+		QByteArray getColumnBuffer(int column_idx);
+
 		//! \brief Returns the data allocated size of a column (searching by name or index)
 		int getColumnSize(const QString &column_name);
 		int getColumnSize(int column_idx);
 
+		/*! \brief Returns the value of an oid column. When the resultset is in binary format
+		 (see Connection::executeDMLCommand) the value is read straight from the wire representation,
+		 otherwise it falls back to parsing the textual value */
+		unsigned getColumnOidValue(const QString &column_name);
+		unsigned getColumnOidValue(int column_idx);
+
+		//! \brief Returns the value of a boolean column (see getColumnOidValue for the format handling)
+		bool getColumnBoolValue(const QString &column_name);
+		bool getColumnBoolValue(int column_idx);
+
+		/*! \brief Returns the value of a smallint/integer/bigint column
+		 (see getColumnOidValue for the format handling) */
+		long long getColumnIntValue(const QString &column_name);
+		long long getColumnIntValue(int column_idx);
+
+		/*! \brief Returns the elements of an array column whose elements have a textual
+		 representation (name[], text[] and similars). Null elements are returned as empty strings
+		 (see getColumnOidValue for the format handling) */
+		QStringList getColumnArrayValue(const QString &column_name);
+		QStringList getColumnArrayValue(int column_idx);
+
 		//! \brief Returns all the column names / values for the current tuple.
 		attribs_map getTupleValues();
 
@@ -53,6 +53,7 @@ HEADERS += src/textbox.h \
 	   src/tablespace.h \
 	   src/trigger.h \
 	   src/baseobject.h \
+	   src/objectcensus.h \
 	   src/rule.h \
 	   src/sequence.h \
 	   src/conversion.h \
@@ -144,6 +145,7 @@ SOURCES +=  src/textbox.cpp \
 	    src/cast.cpp \
 	    src/aggregate.cpp \
 	    src/baseobject.cpp \
+	    src/objectcensus.cpp \
 	    src/relationship.cpp \
 	    src/basetable.cpp \
 	    src/operatorfamily.cpp \
@@ -18,6 +18,8 @@
 
 #include "baseobject.h"
 #include "coreutilsns.h"
+#include "memorypool.h"
+#include "objectcensus.h"
 #include <QApplication>
 
 const QByteArray BaseObject::special_chars = QByteArray("'_-.@ $:()/<>+*\\=~!#%^&|?{}[]`;");
@@ -74,16 +76,39 @@ const QString BaseObject::objs_sql[BaseObject::ObjectTypeCount]={
 	 are respectively assigned to objects of classes Role, Tablespace
 	 DatabaseModel, Schema, Tag */
 unsigned BaseObject::global_id=5000;
+unsigned BaseObject::signature_change_count=0;
 
 QString BaseObject::pgsql_ver=PgSqlVersions::DefaulVersion;
 bool BaseObject::use_cached_code=true;
 bool BaseObject::escape_comments=true;
 
+void *BaseObject::operator new(std::size_t size)
+{
+	void *ptr=MemoryPool::allocate(size);
+
+	//The census tracks the object with its most derived size (see ObjectCensus)
+	if(ObjectCensus::isEnabled())
+		ObjectCensus::registerObject(ptr, size);
+
+	return ptr;
+}
+
+void BaseObject::operator delete(void *ptr, std::size_t size)
+{
+	if(ObjectCensus::isEnabled())
+		ObjectCensus::unregisterObject(ptr);
+
+	MemoryPool::deallocate(ptr, size);
+}
+
 BaseObject::BaseObject()
 {
 	object_id=BaseObject::global_id++;
 	is_protected=system_obj=sql_disabled=false;
 	code_invalidated=true;
+	search_attribs_updated=false;
+	search_attribs_epoch=0;
+	cached_signature_epoch=0;
 	obj_type=ObjectType::BaseObject;
 	schema=nullptr;
 	owner=nullptr;
@@ -112,6 +137,11 @@ unsigned BaseObject::getGlobalId()
 	return global_id;
 }
 
+unsigned BaseObject::getSignatureChangeCount()
+{
+	return signature_change_count;
+}
+
 void BaseObject::setEscapeComments(bool value)
 {
 	escape_comments = value;
@@ -376,6 +406,15 @@ void BaseObject::setName(const QString &name)
 	}
 
 	aux_name.remove('"');
+
+	/* Renaming an object already attached to a database model invalidates the
+	 * signature indexes kept by the model (see DatabaseModel::getObject()) */
+	if(database && this->obj_name!=aux_name)
+		signature_change_count++;
+
+	/* The cache is cleared unconditionally since for detached objects the global
+	 * counter isn't bumped and the epoch check wouldn't expire the cached value */
+	cached_signature.clear();
 	setCodeInvalidated(this->obj_name!=aux_name);
 	this->obj_name=aux_name;
 }
@@ -527,6 +566,11 @@ void BaseObject::setSchema(BaseObject *schema)
 	else if(!acceptsSchema())
 		throw Exception(ErrorCode::AsgInvalidSchemaObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	//Moving an attached object to another schema also changes its signature (see setName())
+	if(database && this->schema!=schema)
+		signature_change_count++;
+
+	cached_signature.clear();
 	setCodeInvalidated(this->schema != schema);
 	this->schema=schema;
 }
@@ -608,7 +652,21 @@ QString BaseObject::getAlias()
 
 QString BaseObject::getSignature(bool format)
 {
-	return this->getName(format, true);
+	//The unformatted form skips quoting/formatting entirely, being cheap enough for hashing
+	if(!format)
+		return this->getName(false, true);
+
+	/* The formatted signature is memoized under the same epoch scheme used by the search
+	 * attributes: any rename or schema move of attached objects bumps the global counter,
+	 * expiring all the cached signatures at once (needed since renaming the schema changes
+	 * this object's signature without touching the object itself) */
+	if(cached_signature.isEmpty() || cached_signature_epoch!=signature_change_count)
+	{
+		cached_signature=this->getName(true, true);
+		cached_signature_epoch=signature_change_count;
+	}
+
+	return cached_signature;
 }
 
 QString BaseObject::getComment()
@@ -737,6 +795,19 @@ QString BaseObject::getCodeDefinition(unsigned def_type, bool reduced_form)
 {
 	QString code_def;
 
+	/* The reduced xml form of an object is embedded in the code of every object referencing it
+	 * (schema, owner, tablespace and so on), thus when the cached copy is valid it is served right
+	 * away. The parallel code generation also relies on this fast path being read-only: the reduced
+	 * caches of shared objects are populated serially before the worker threads start (see
+	 * DatabaseModel::generateCodeInParallel()) */
+	if(def_type==SchemaParser::XmlDefinition && reduced_form)
+	{
+		code_def=getCachedCode(def_type, reduced_form);
+
+		if(!code_def.isEmpty())
+			return code_def;
+	}
+
 	if((def_type==SchemaParser::SqlDefinition &&
 		obj_type!=ObjectType::BaseObject && obj_type!=ObjectType::BaseRelationship &&
 		obj_type!=ObjectType::BaseTable && obj_type!=ObjectType::Textbox) ||
@@ -1096,6 +1167,11 @@ void BaseObject::operator = (BaseObject &obj)
 
 void BaseObject::setCodeInvalidated(bool value)
 {
+	/* Any change that invalidates the code also outdates the memoized search attributes,
+	 regardless of the cached code support being enabled */
+	if(value)
+		search_attribs_updated=false;
+
 	if(use_cached_code && value!=code_invalidated)
 	{
 		if(value)
@@ -1117,6 +1193,25 @@ void BaseObject::configureSearchAttributes()
 	search_attribs[Attributes::Tablespace] = tablespace ? tablespace->getName(false) : "";
 	search_attribs[Attributes::Owner] = owner ? owner->getName(false) : "";
 	search_attribs[Attributes::Comment] = comment;
+	search_attribs_updated=true;
+	search_attribs_epoch=signature_change_count;
+}
+
+bool BaseObject::isSearchAttribsUpdated()
+{
+	/* An epoch mismatch means that some object in the model was renamed since the last
+	 update, possibly changing this object's signature or referenced names */
+	return (search_attribs_updated && search_attribs_epoch==signature_change_count);
+}
+
+QString BaseObject::getSearchAttribute(const QString &attr_name)
+{
+	attribs_map::iterator itr=search_attribs.find(attr_name);
+
+	if(itr==search_attribs.end())
+		return QString();
+
+	return itr->second;
 }
 
 bool BaseObject::isCodeInvalidated()
@@ -105,6 +105,11 @@ class BaseObject {
 		 used each with a custom different numbering range (see cited classes declaration). */
 		static unsigned global_id;
 
+		/*! \brief This counter is incremented whenever an object attached to a database model has
+		 its name or schema changed. Database models use it to detect that their signature
+		 lookup indexes became stale (see DatabaseModel::getObject()) */
+		static unsigned signature_change_count;
+
 		/*! \brief Stores the unique identifier for the object. This id is nothing else
 		 than the current value of global_id. This identifier is used
 		 to know the chronological order of the creation of each object in the model
@@ -195,6 +200,24 @@ class BaseObject {
 		 * searching mechanism to match patters */
 		search_attribs;
 
+		//! \brief Indicates that the memoized search attributes are up to date (see configureSearchAttributes)
+		bool search_attribs_updated;
+
+		/*! \brief Value of the global signature change counter when the search attributes were last
+		 updated. A mismatch with the current counter denotes renames elsewhere in the model that may
+		 have changed this object's signature or the names of referenced objects */
+		unsigned search_attribs_epoch;
+
+		/*! \brief Caches the formatted signature returned by getSignature(). Diff, validation and
+		 searching call that method in tight loops, so the name formatting/quoting is performed only
+		 when some name in the model actually changed. The cache is cleared by setName()/setSchema()
+		 and also expires under the same epoch scheme used by the search attributes, covering renames
+		 of the schema the object belongs to */
+		QString cached_signature;
+
+		//! \brief Value of the global signature change counter when the signature was cached
+		unsigned cached_signature_epoch;
+
 		/*! \brief Type of object, may have one of the values ​​of the enum ObjectType
 		 It was used a numeric type to avoid the use excessive of RTTI. */
 		ObjectType obj_type;
@@ -254,6 +277,13 @@ class BaseObject {
 		BaseObject();
 		virtual ~BaseObject(void){}
 
+		/*! \brief Model objects are allocated through the pooled allocator (see MemoryPool) since loading
+		 a model creates tens of thousands of small objects. Released blocks are kept in free lists for
+		 reuse, drastically reducing the heap traffic when big models are opened and closed. The sized
+		 operator delete receives the most derived object size thanks to the virtual destructor */
+		void *operator new(std::size_t size);
+		void operator delete(void *ptr, std::size_t size);
+
 		//! \brief Returns the reference to the database that owns the object
 		BaseObject *getDatabase();
 
@@ -293,6 +323,9 @@ class BaseObject {
 		//! \brief Returns the current value of the global object id counter
 		static unsigned getGlobalId();
 
+		//! \brief Returns the current value of the global signature change counter
+		static unsigned getSignatureChangeCount();
+
 		static void setEscapeComments(bool value);
 
 		static bool isEscapeComments();
@@ -516,6 +549,13 @@ class BaseObject {
 		//! \brief Returns the set of attributes used by the search mechanism
 		attribs_map getSearchAttributes();
 
+		/*! \brief Returns whether the memoized search attributes are still up to date. They become
+		 outdated when the object's code is invalidated or when any object in the model is renamed */
+		bool isSearchAttribsUpdated();
+
+		//! \brief Returns the value of a single search attribute avoiding a copy of the whole set
+		QString getSearchAttribute(const QString &attr_name);
+
 		friend class DatabaseModel;
 		friend class ModelValidationHelper;
 		friend class DatabaseImportHelper;
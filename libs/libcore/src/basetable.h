@@ -79,6 +79,11 @@ class BaseTable: public BaseGraphicObject {
 		//! \brief Removes the specified object from table
 		virtual void removeObject(BaseObject *obj)=0;
 
+		/*! \brief Invalidates the child object name lookup indexes. The default implementation does
+		 nothing, PhysicalTable reimplements it to expire its name lookup indexes. This method is
+		 called whenever a child object is renamed (see TableObject::setName()) */
+		virtual void invalidateChildNamesIndexes(void){}
+
 		/*! \brief Gets the the count for the specified object type. The boolean parameter indicates
 		 that objects added by relationship must be counted */
 		virtual unsigned getObjectCount(ObjectType obj_type, bool inc_added_by_rel=true)=0;
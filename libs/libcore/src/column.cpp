@@ -52,8 +52,9 @@ void Column::setName(const QString &name)
 		//The current column name will be used as the old name
 		prev_name=this->obj_name;
 
-		//Tries to define the new name to column
-		BaseObject::setName(name);
+		/* Tries to define the new name to column. The TableObject implementation is used
+		 so the parent table child name indexes are properly expired by the renaming */
+		TableObject::setName(name);
 
 		/* Case no error is raised stored the old name on the
 		 respective column attribute */
@@ -25,14 +25,129 @@
 #include "qtcompat/qtextstreamcompat.h"
 #include <random>
 #include "utilsns.h"
+#include "performancecounters.h"
+#include "tracelogger.h"
+#include "taskscheduler.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QMutex>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <set>
 
 unsigned DatabaseModel::dbmodel_id=2000;
+bool DatabaseModel::stream_loading_enabled=false;
+
+void DatabaseModel::setStreamLoadingEnabled(bool value)
+{
+	stream_loading_enabled=value;
+}
+
+bool DatabaseModel::isStreamLoadingEnabled()
+{
+	return stream_loading_enabled;
+}
+
+bool DatabaseModel::parallel_code_gen=false;
+
+void DatabaseModel::setParallelCodeGeneration(bool value)
+{
+	parallel_code_gen=value;
+}
+
+bool DatabaseModel::isParallelCodeGeneration()
+{
+	return parallel_code_gen;
+}
+
+bool DatabaseModel::model_cache_enabled=false;
+const QByteArray DatabaseModel::ModelCacheMagic("pgmodeler-dbm-cache");
+const quint32 DatabaseModel::ModelCacheVersion=1;
+const QByteArray DatabaseModel::CompressedModelMagic("pgmodeler-dbmz");
+const QString DatabaseModel::SplitModelManifest("dbmodel.manifest");
+const QString DatabaseModel::SplitModelRootFile("dbmodel.xml");
+
+void DatabaseModel::setModelCacheEnabled(bool value)
+{
+	model_cache_enabled=value;
+}
+
+bool DatabaseModel::isModelCacheEnabled()
+{
+	return model_cache_enabled;
+}
+
+QString DatabaseModel::getModelCacheFilename(const QString &filename)
+{
+	return filename + GlobalAttributes::ModelCacheExt;
+}
+
+bool DatabaseModel::isCompressedModelFile(const QString &filename)
+{
+	QFile input(filename);
+
+	if(!input.open(QFile::ReadOnly))
+		return false;
+
+	return input.read(CompressedModelMagic.size())==CompressedModelMagic;
+}
+
+void DatabaseModel::saveModelCache(const QString &filename, const QByteArray &xml_buf, const QByteArray &file_buf)
+{
+	QFile cache_file(getModelCacheFilename(filename));
+
+	/* The cache is a best-effort optimization so failures when writing it
+	 * must never abort the model saving that has already succeeded */
+	if(!cache_file.open(QFile::WriteOnly))
+		return;
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	stream << ModelCacheMagic;
+	stream << ModelCacheVersion;
+	stream << GlobalAttributes::PgModelerVersion;
+	stream << QCryptographicHash::hash(file_buf.isEmpty() ? xml_buf : file_buf, QCryptographicHash::Sha256);
+	stream << qCompress(xml_buf);
+}
+
+QByteArray DatabaseModel::loadModelCache(const QString &filename)
+{
+	QFile cache_file(getModelCacheFilename(filename)),
+			model_file(filename);
+	QByteArray magic, xml_hash, comp_xml;
+	QString pgm_version;
+	quint32 version=0;
+
+	if(!cache_file.open(QFile::ReadOnly) || !model_file.open(QFile::ReadOnly))
+		return QByteArray();
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	stream >> magic;
+	stream >> version;
+	stream >> pgm_version;
+	stream >> xml_hash;
+	stream >> comp_xml;
+
+	if(stream.status()!=QDataStream::Ok ||
+			magic!=ModelCacheMagic || version!=ModelCacheVersion)
+		return QByteArray();
+
+	/* The cache is considered stale when the checksum stored on it doesn't match the
+	 * current contents of the dbm file (modified by other means, e.g., another tool) */
+	if(QCryptographicHash::hash(model_file.readAll(), QCryptographicHash::Sha256)!=xml_hash)
+		return QByteArray();
+
+	return qUncompress(comp_xml);
+}
 
 DatabaseModel::DatabaseModel()
 {
 	this->model_wgt=nullptr;
 	object_id=DatabaseModel::dbmodel_id++;
 	obj_type=ObjectType::Database;
+	sig_change_count=0;
 
 	layers.append(tr("Default layer"));
 	active_layers.push_back(0);
@@ -55,7 +170,7 @@ DatabaseModel::DatabaseModel()
 
 	conn_limit=-1;
 	last_zoom=1;
-	loading_model=invalidated=append_at_eod=prepend_at_bod=false;
+	loading_model=invalidated=append_at_eod=prepend_at_bod=bulk_insertion=false;
 	attributes[Attributes::Encoding]="";
 	attributes[Attributes::TemplateDb]="";
 	attributes[Attributes::ConnLimit]="";
@@ -237,6 +352,46 @@ void DatabaseModel::addObject(BaseObject *object, int obj_idx)
 	}
 }
 
+void DatabaseModel::addObjects(const vector<BaseObject *> &objects)
+{
+	vector<BaseObject *> added_objs;
+
+	if(objects.empty())
+		return;
+
+	/* Batch insertion mode: the per-object code validation in __addObject() is skipped since
+	 the batch is assumed to be pre-validated by the caller, and the individual notifications
+	 are aggregated into a single s_objectsAdded() emission once the whole batch lands */
+	bulk_insertion=true;
+	added_objs.reserve(objects.size());
+
+	try
+	{
+		for(auto &object : objects)
+		{
+			addObject(object);
+			added_objs.push_back(object);
+		}
+	}
+	catch(Exception &e)
+	{
+		bulk_insertion=false;
+
+		//Notifying the objects inserted before the failure so the observers don't go out of sync
+		if(!added_objs.empty())
+		{
+			emit s_objectsAdded(added_objs);
+			this->setInvalidated(true);
+		}
+
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+
+	bulk_insertion=false;
+	emit s_objectsAdded(added_objs);
+	this->setInvalidated(true);
+}
+
 void DatabaseModel::removeObject(BaseObject *object, int obj_idx)
 {
 	ObjectType obj_type;
@@ -317,6 +472,9 @@ void DatabaseModel::removeObject(BaseObject *object, int obj_idx)
 
 void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 {
+	/* Structural mutation choke point: the write lock blocks until the threads holding the
+	 * shared read lock (see lockForConcurrentRead()) release it */
+	QWriteLocker wlocker(&model_rw_lock);
 	int idx;
 	ObjectType obj_type;
 	vector<BaseObject *> *obj_list=nullptr;
@@ -396,16 +554,20 @@ void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 		throw Exception(str_aux,ErrorCode::AsgDuplicatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	}
 
-	try
-	{
-		if(obj_type==ObjectType::Textbox || obj_type==ObjectType::BaseRelationship)
-			object->getCodeDefinition(SchemaParser::XmlDefinition);
-		else
-			object->getCodeDefinition(SchemaParser::SqlDefinition);
-	}
-	catch(Exception &e)
+	//In batch insertions the objects are pre-validated, so the code generation checking is skipped
+	if(!bulk_insertion)
 	{
-		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+		try
+		{
+			if(obj_type==ObjectType::Textbox || obj_type==ObjectType::BaseRelationship)
+				object->getCodeDefinition(SchemaParser::XmlDefinition);
+			else
+				object->getCodeDefinition(SchemaParser::SqlDefinition);
+		}
+		catch(Exception &e)
+		{
+			throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+		}
 	}
 
 	obj_list=getObjectList(object->getObjectType());
@@ -425,13 +587,31 @@ void DatabaseModel::__addObject(BaseObject *object, int obj_idx)
 			obj_list->push_back(object);
 	}
 
+	//Keeping the signature index up-to-date avoiding a full rebuild on the next lookup
+	if(obj_sig_idx_valid[obj_type])
+	{
+		QString signature=object->getSignature().remove('"');
+
+		if(!obj_sig_index[obj_type].contains(signature))
+			obj_sig_index[obj_type].insert(signature, object);
+	}
+
 	object->setDatabase(this);
-	emit s_objectAdded(object);
-	this->setInvalidated(true);
+
+	/* In batch insertions the per-object notification and invalidation are suppressed:
+	 addObjects() emits a single aggregated notification when the whole batch lands */
+	if(!bulk_insertion)
+	{
+		emit s_objectAdded(object);
+		this->setInvalidated(true);
+	}
 }
 
 void DatabaseModel::__removeObject(BaseObject *object, int obj_idx, bool check_refs)
 {
+	//Structural mutation choke point, see the note in __addObject()
+	QWriteLocker wlocker(&model_rw_lock);
+
 	if(!object)
 		throw Exception(ErrorCode::RemNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	else
@@ -492,11 +672,36 @@ void DatabaseModel::__removeObject(BaseObject *object, int obj_idx, bool check_r
 				if(Permission::acceptsPermission(obj_type))
 					removePermissions(object);
 
+				//Detaching the permission from the per-object permission index
+				if(obj_type==ObjectType::Permission)
+				{
+					Permission *perm=dynamic_cast<Permission *>(object);
+					vector<Permission *> &obj_perms=perm_index[perm->getObject()];
+
+					obj_perms.erase(std::remove(obj_perms.begin(), obj_perms.end(), perm), obj_perms.end());
+
+					if(obj_perms.empty())
+						perm_index.erase(perm->getObject());
+				}
+
 				obj_list->erase(obj_list->begin() + obj_idx);
+
+				if(obj_sig_idx_valid[obj_type])
+				{
+					QString signature=object->getSignature().remove('"');
+
+					/* If the removed object isn't the one indexed under its own signature it means
+					 * the index entry became stale (silent signature change), so we just invalidate it */
+					if(obj_sig_index[obj_type].value(signature, nullptr)==object)
+						obj_sig_index[obj_type].remove(signature);
+					else
+						obj_sig_idx_valid[obj_type]=false;
+				}
 			}
 		}
 
 		object->setDatabase(nullptr);
+		invalidateClosureCaches();
 		emit s_objectRemoved(object);
 	}
 }
@@ -549,40 +754,110 @@ vector<BaseObject *> DatabaseModel::getObjects(BaseObject *schema)
 	return sel_list;
 }
 
+void DatabaseModel::rebuildSignatureIndex(ObjectType obj_type)
+{
+	vector<BaseObject *> *obj_list=getObjectList(obj_type);
+	QString signature;
+
+	if(!obj_list)
+		return;
+
+	QHash<QString, BaseObject *> &index=obj_sig_index[obj_type];
+
+	index.clear();
+	index.reserve(obj_list->size());
+
+	for(auto &object : *obj_list)
+	{
+		signature=object->getSignature().remove('"');
+
+		//In case of duplicated signatures the first object in the list prevails
+		if(!index.contains(signature))
+			index.insert(signature, object);
+	}
+
+	obj_sig_idx_valid[obj_type]=true;
+}
+
+void DatabaseModel::prepareForConcurrentReads()
+{
+	QWriteLocker wlocker(&model_rw_lock);
+
+	/* Discarding all the indexes at once when some attached object was renamed since they
+	 * were built, mirroring the staleness check performed by getObject() */
+	if(sig_change_count!=BaseObject::getSignatureChangeCount())
+	{
+		obj_sig_idx_valid.clear();
+		sig_change_count=BaseObject::getSignatureChangeCount();
+	}
+
+	for(auto &itr : obj_lists)
+	{
+		if(!obj_sig_idx_valid[itr.first])
+			rebuildSignatureIndex(itr.first);
+	}
+}
+
+void DatabaseModel::lockForConcurrentRead()
+{
+	model_rw_lock.lockForRead();
+}
+
+void DatabaseModel::unlockConcurrentRead()
+{
+	model_rw_lock.unlock();
+}
+
 BaseObject *DatabaseModel::getObject(const QString &name, ObjectType obj_type, int &obj_idx)
 {
 	BaseObject *object=nullptr;
 	vector<BaseObject *> *obj_list=nullptr;
-	vector<BaseObject *>::iterator itr, itr_end;
-	bool found=false;
 	QString aux_name1;
 
 	obj_list=getObjectList(obj_type);
 
 	if(!obj_list)
 		throw Exception(ErrorCode::ObtObjectInvalidType,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-	else
+
+	obj_idx=-1;
+	aux_name1=QString(name).remove('"');
+
+	/* A change in the global signature counter means that some object attached to a model
+	 * was renamed or moved to another schema, in that case all indexes are discarded at once */
+	if(sig_change_count!=BaseObject::getSignatureChangeCount())
 	{
-		QString signature;
+		obj_sig_idx_valid.clear();
+		sig_change_count=BaseObject::getSignatureChangeCount();
+	}
 
-		itr=obj_list->begin();
-		itr_end=obj_list->end();
-		obj_idx=-1;
-		aux_name1=QString(name).remove('"');
+	if(!obj_sig_idx_valid[obj_type])
+		rebuildSignatureIndex(obj_type);
 
-		while(itr!=itr_end && !found)
-		{
-			signature=(*itr)->getSignature().remove("\"");
-			found=(signature==aux_name1);
-			if(!found) itr++;
-		}
+	object=obj_sig_index[obj_type].value(aux_name1, nullptr);
 
-		if(found)
-		{
-			object=(*itr);
+	/* Verifying that the retrieved object still owns the queried signature. A mismatch
+	 * means the index entry became stale (silent signature change) forcing a rebuild */
+	if(object && object->getSignature().remove('"')!=aux_name1)
+	{
+		rebuildSignatureIndex(obj_type);
+		object=obj_sig_index[obj_type].value(aux_name1, nullptr);
+	}
+
+	if(object)
+	{
+		auto itr=std::find(obj_list->begin(), obj_list->end(), object);
+
+		if(itr!=obj_list->end())
 			obj_idx=(itr - obj_list->begin());
+		else
+		{
+			//The indexed object is not in the list anymore (stale entry), rebuilding and retrying
+			rebuildSignatureIndex(obj_type);
+			object=obj_sig_index[obj_type].value(aux_name1, nullptr);
+
+			if(object)
+				obj_idx=(std::find(obj_list->begin(), obj_list->end(), object) - obj_list->begin());
 		}
-		else obj_idx=-1;
 	}
 
 	return object;
@@ -778,6 +1053,7 @@ void DatabaseModel::destroyObjects()
 		delete perm;
 
 	permissions.clear();
+	perm_index.clear();
 
 	for(auto &inv_obj : invalid_special_objs)
 		delete inv_obj;
@@ -794,6 +1070,10 @@ void DatabaseModel::destroyObjects()
 		for(auto type : rem_obj_types)
 			getObjectList(type)->clear();
 	}
+
+	obj_sig_index.clear();
+	obj_sig_idx_valid.clear();
+	invalidateClosureCaches();
 }
 
 void DatabaseModel::addTable(Table *table, int obj_idx)
@@ -1520,6 +1800,49 @@ void DatabaseModel::disconnectRelationships()
 		Relationship *rel=nullptr;
 		vector<BaseObject *>::reverse_iterator ritr_rel, ritr_rel_end;
 
+		/* Disconnecting relationships destroys relationship-added objects, so any memoized
+		 * dependency/reference closure may hold dangling pointers from this point on */
+		invalidateClosureCaches();
+
+		//The relationships must be disconnected from the last to the first
+		ritr_rel=relationships.rbegin();
+		ritr_rel_end=relationships.rend();
+
+		while(ritr_rel!=ritr_rel_end)
+		{
+			base_rel=dynamic_cast<BaseRelationship *>(*ritr_rel);
+			ritr_rel++;
+			base_rel->blockSignals(loading_model);
+
+			if(base_rel->getObjectType()==ObjectType::Relationship)
+			{
+				rel=dynamic_cast<Relationship *>(base_rel);
+				rel->disconnectRelationship();
+			}
+			else
+				base_rel->disconnectRelationship();
+
+			base_rel->blockSignals(false);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
+
+void DatabaseModel::disconnectRelationships(const vector<BaseObject *> &rels)
+{
+	try
+	{
+		BaseRelationship *base_rel=nullptr;
+		Relationship *rel=nullptr;
+		vector<BaseObject *>::reverse_iterator ritr_rel, ritr_rel_end;
+
+		/* Disconnecting relationships destroys relationship-added objects, so any memoized
+		 * dependency/reference closure may hold dangling pointers from this point on */
+		invalidateClosureCaches();
+
 		//The relationships must be disconnected from the last to the first
 		ritr_rel=relationships.rbegin();
 		ritr_rel_end=relationships.rend();
@@ -1528,6 +1851,11 @@ void DatabaseModel::disconnectRelationships()
 		{
 			base_rel=dynamic_cast<BaseRelationship *>(*ritr_rel);
 			ritr_rel++;
+
+			//Relationships outside the provided list stay connected
+			if(std::find(rels.begin(), rels.end(), base_rel)==rels.end())
+				continue;
+
 			base_rel->blockSignals(loading_model);
 
 			if(base_rel->getObjectType()==ObjectType::Relationship)
@@ -1547,8 +1875,63 @@ void DatabaseModel::disconnectRelationships()
 	}
 }
 
+vector<BaseObject *> DatabaseModel::getAffectedRelationships(const vector<BaseObject *> &inv_rels)
+{
+	vector<BaseObject *> aff_rels;
+	map<BaseTable *, bool> aff_tables;
+	BaseRelationship *base_rel=nullptr;
+	Relationship *rel=nullptr;
+	bool inserted=true;
+
+	//Seeds the affected set with the invalidated relationships and the tables they link
+	for(auto &obj : inv_rels)
+	{
+		base_rel=dynamic_cast<BaseRelationship *>(obj);
+		aff_rels.push_back(obj);
+		aff_tables[base_rel->getTable(BaseRelationship::SrcTable)]=true;
+		aff_tables[base_rel->getTable(BaseRelationship::DstTable)]=true;
+
+		rel=dynamic_cast<Relationship *>(base_rel);
+		if(rel && rel->getGeneratedTable())
+			aff_tables[rel->getGeneratedTable()]=true;
+	}
+
+	/* Expands the set until a fixpoint: any relationship touching an affected table may
+	 receive or provide propagated columns, so it (and its tables) joins the set too */
+	while(inserted)
+	{
+		inserted=false;
+
+		for(auto &obj : relationships)
+		{
+			base_rel=dynamic_cast<BaseRelationship *>(obj);
+
+			if(base_rel->getObjectType()!=ObjectType::Relationship ||
+					std::find(aff_rels.begin(), aff_rels.end(), obj)!=aff_rels.end())
+				continue;
+
+			if(aff_tables.count(base_rel->getTable(BaseRelationship::SrcTable)) ||
+					aff_tables.count(base_rel->getTable(BaseRelationship::DstTable)))
+			{
+				rel=dynamic_cast<Relationship *>(base_rel);
+				aff_rels.push_back(obj);
+				aff_tables[base_rel->getTable(BaseRelationship::SrcTable)]=true;
+				aff_tables[base_rel->getTable(BaseRelationship::DstTable)]=true;
+
+				if(rel && rel->getGeneratedTable())
+					aff_tables[rel->getGeneratedTable()]=true;
+
+				inserted=true;
+			}
+		}
+	}
+
+	return aff_rels;
+}
+
 void DatabaseModel::validateRelationships()
 {
+	TraceLogger::Span trace_span("DatabaseModel::validateRelationships");
 	vector<BaseObject *>::iterator itr, itr_end, itr_ant;
 	Relationship *rel=nullptr;
 	BaseRelationship *base_rel=nullptr;
@@ -1626,12 +2009,25 @@ void DatabaseModel::validateRelationships()
 
 			if(found_inval_rel)
 			{
-				//Disconnects all the relationship
-				disconnectRelationships();
+				vector<BaseObject *> aff_rels=getAffectedRelationships(vet_rel_inv);
+
+				/* Disconnects only the relationships affected by the invalidated ones. The
+					 unaffected ones stay connected keeping their propagated columns, which avoids
+					 a full column re-propagation over the whole model. Relationships that happen
+					 to be invalidated by this partial reconnection are caught by the next
+					 iterations of the outer validation loop */
+				disconnectRelationships(aff_rels);
+
+				/* Merges the two lists (valid and invalid relationships) restricted to the
+					 affected set, taking care to insert the invalid ones at the end of the list */
+				rels.clear();
+
+				for(auto &obj : vet_rel)
+				{
+					if(std::find(aff_rels.begin(), aff_rels.end(), obj)!=aff_rels.end())
+						rels.push_back(obj);
+				}
 
-				/* Merges the two lists (valid and invalid relationships),
-					 taking care to insert the invalid ones at the end of the list */
-				rels=vet_rel;
 				rels.insert(rels.end(), vet_rel_inv.begin(), vet_rel_inv.end());
 				vet_rel.clear();
 				vet_rel_inv.clear();
@@ -3004,6 +3400,7 @@ void DatabaseModel::addPermission(Permission *perm)
 							ErrorCode::RefObjectInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 		permissions.push_back(perm);
+		perm_index[perm->getObject()].push_back(perm);
 		perm->setDatabase(this);
 	}
 	catch(Exception &e)
@@ -3061,30 +3458,21 @@ void DatabaseModel::removePermissions(BaseObject *object)
 		else
 		{ itr++; idx++; }
 	}
+
+	perm_index.erase(object);
 }
 
 void DatabaseModel::getPermissions(BaseObject *object, vector<Permission *> &perms)
 {
-	vector<BaseObject *>::iterator itr, itr_end;
-	Permission *perm=nullptr;
-
 	if(!object)
 		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	itr=permissions.begin();
-	itr_end=permissions.end();
+	map<BaseObject *, vector<Permission *>>::iterator itr=perm_index.find(object);
 
 	perms.clear();
 
-	while(itr!=itr_end)
-	{
-		perm=dynamic_cast<Permission *>(*itr);
-
-		if(perm->getObject()==object)
-			perms.push_back(perm);
-
-		itr++;
-	}
+	if(itr!=perm_index.end())
+		perms=itr->second;
 }
 
 int DatabaseModel::getPermissionIndex(Permission *perm, bool exact_match)
@@ -3116,22 +3504,20 @@ int DatabaseModel::getPermissionIndex(Permission *perm, bool exact_match)
 		}
 		else
 		{
-			BaseObject *object=nullptr;
 			Role *role=nullptr;
 			unsigned count, i;
 			bool ref_role=false;
+			map<BaseObject *, vector<Permission *>>::iterator idx_itr=perm_index.find(perm->getObject());
 
-			object=perm->getObject();
-
-			while(itr!=itr_end)
+			/* Since the per-object index groups the permissions by the object they refer to,
+			 * only the permissions over the same object of the specified one need to be checked */
+			if(idx_itr!=perm_index.end())
 			{
-				perm_aux=dynamic_cast<Permission *>(*itr);
-
-				/* When the object of the auxiliary permission is the same as the
-		   specified permission it will be check if the existant roles are
-		   the same on both permissions */
-				if(object==perm_aux->getObject())
+				for(auto &obj_perm : idx_itr->second)
 				{
+					perm_aux=obj_perm;
+
+					//Checking if the existent roles are the same on both permissions
 					count=perm->getRoleCount();
 
 					for(i=0; i < count && !ref_role; i++)
@@ -3139,16 +3525,14 @@ int DatabaseModel::getPermissionIndex(Permission *perm, bool exact_match)
 						role=perm->getRole(i);
 						ref_role=perm_aux->isRoleExists(role);
 					}
-				}
 
-				//If the permissions references the same roles but one is a REVOKE and other GRANT they a considered different
-				if(perm==perm_aux || (ref_role && perm->isRevoke()==perm_aux->isRevoke()))
-				{
-					perm_idx=itr-permissions.begin();
-					break;
+					//If the permissions references the same roles but one is a REVOKE and other GRANT they a considered different
+					if(perm==perm_aux || (ref_role && perm->isRevoke()==perm_aux->isRevoke()))
+					{
+						perm_idx=std::find(permissions.begin(), permissions.end(), perm_aux)-permissions.begin();
+						break;
+					}
 				}
-
-				itr++;
 			}
 		}
 	}
@@ -3220,202 +3604,267 @@ void DatabaseModel::configureDatabase(attribs_map &attribs)
 	setBasicAttributes(this);
 }
 
-void DatabaseModel::loadModel(const QString &filename)
+void DatabaseModel::configureModelAttributes(attribs_map &attribs, map<ObjectType, QString> &def_objs, bool &protected_model)
 {
-	if(!filename.isEmpty())
-	{
-		QString dtd_file, str_aux, elem_name;
-		ObjectType obj_type;
-		attribs_map attribs;
-		BaseObject *object=nullptr;
-		bool protected_model=false, found_inh_rel = false;
-		QStringList pos_str;
-		map<ObjectType, QString> def_objs;
+	QStringList pos_str;
 
-		//Configuring the path to the base path for objects DTD
-		dtd_file=GlobalAttributes::getSchemasRootDir() +
-						 GlobalAttributes::DirSeparator +
-						 GlobalAttributes::XMLSchemaDir +
-						 GlobalAttributes::DirSeparator +
-						 GlobalAttributes::ObjectDTDDir +
-						 GlobalAttributes::DirSeparator;
+	setObjectListsCapacity(attribs[Attributes::MaxObjCount].toUInt());
 
-		try
-		{
-			loading_model=true;
-			xmlparser.restartParser();
+	this->author=attribs[Attributes::ModelAuthor];
+
+	pos_str=attribs[Attributes::LastPosition].split(',');
+
+	if(pos_str.size()>=2)
+		this->last_pos=QPoint(pos_str[0].toUInt(),pos_str[1].toUInt());
+
+	this->last_zoom=attribs[Attributes::LastZoom].toDouble();
+	if(this->last_zoom <= 0) this->last_zoom=1;
 
-			//Loads the root DTD
-			xmlparser.setDTDFile(dtd_file + GlobalAttributes::RootDTD +
-								 GlobalAttributes::ObjectDTDExt,
-								 GlobalAttributes::RootDTD);
+	this->is_template = attribs[Attributes::IsTemplate] == Attributes::True;
+	this->allow_conns = (attribs[Attributes::AllowConns].isEmpty() ||
+											 attribs[Attributes::AllowConns] == Attributes::True);
 
-			//Loads the file validating it against the root DTD
-			xmlparser.loadXMLFile(filename);
+	persist_changelog = attribs[Attributes::UseChangelog] == Attributes::True;
 
-			//Gets the basic model information
-			xmlparser.getElementAttributes(attribs);
+	/* Compatibility with models created prior the multiple layers features:
+	 * We need to replace semi-colon by comma in the attribute Layers in order to split the
+	 * string correctly, otherwise, the model will have only one layer no matter the amount of
+	 * layers created preivously (in an older version) */
+	layers = attribs[Attributes::Layers].replace(';',',').split(',', QtCompat::SkipEmptyParts);
+	attribs[Attributes::ActiveLayers].replace(';',',');
 
-			setObjectListsCapacity(attribs[Attributes::MaxObjCount].toUInt());
+	layer_name_colors = attribs[Attributes::LayerNameColors].split(',', QtCompat::SkipEmptyParts);
+	layer_rect_colors = attribs[Attributes::LayerRectColors].split(',', QtCompat::SkipEmptyParts);
 
-			this->author=attribs[Attributes::ModelAuthor];
+	is_layer_names_visible = attribs[Attributes::ShowLayerNames] == Attributes::True;
+	is_layer_rects_visible = attribs[Attributes::ShowLayerRects] == Attributes::True;
 
-			pos_str=attribs[Attributes::LastPosition].split(',');
+	/*  Compatibility with models created prior the layers features:
+	 * If the layer rect colors is empty (probably a model generated in an older version)
+	 * we create random colors as fallback */
 
-			if(pos_str.size()>=2)
-				this->last_pos=QPoint(pos_str[0].toUInt(),pos_str[1].toUInt());
+	// Forcing the creation of the default layer is not present
+	if(layers.isEmpty())
+		layers.push_back(tr("Default layer"));
 
-			this->last_zoom=attribs[Attributes::LastZoom].toDouble();
-			if(this->last_zoom <= 0) this->last_zoom=1;
+	if(layer_rect_colors.isEmpty())
+	{
+		random_device rand_seed;
+		default_random_engine rand_num_engine;
+		uniform_int_distribution<unsigned> dist(0,255);
 
-			this->is_template = attribs[Attributes::IsTemplate] == Attributes::True;
-			this->allow_conns = (attribs[Attributes::AllowConns].isEmpty() ||
-													 attribs[Attributes::AllowConns] == Attributes::True);
+		layer_name_colors.clear();
+		rand_num_engine.seed(rand_seed());
 
-			persist_changelog = attribs[Attributes::UseChangelog] == Attributes::True;
+		for(int i =0; i <= layers.size(); i++)
+		{
+			layer_rect_colors.append(QColor(dist(rand_num_engine),
+																			dist(rand_num_engine),
+																			dist(rand_num_engine)).name());
 
-			/* Compatibility with models created prior the multiple layers features:
-			 * We need to replace semi-colon by comma in the attribute Layers in order to split the
-			 * string correctly, otherwise, the model will have only one layer no matter the amount of
-			 * layers created preivously (in an older version) */
-			layers = attribs[Attributes::Layers].replace(';',',').split(',', QtCompat::SkipEmptyParts);
-			attribs[Attributes::ActiveLayers].replace(';',',');
+			layer_name_colors.append(QColor(0,0,0).name());
+		}
+	}
 
-			layer_name_colors = attribs[Attributes::LayerNameColors].split(',', QtCompat::SkipEmptyParts);
-			layer_rect_colors = attribs[Attributes::LayerRectColors].split(',', QtCompat::SkipEmptyParts);
+	/* Compatibility with models created prior the layers features:
+	 * If the "active-layers" is absent we make the default layer always visible */
+	active_layers.clear();
 
-			is_layer_names_visible = attribs[Attributes::ShowLayerNames] == Attributes::True;
-			is_layer_rects_visible = attribs[Attributes::ShowLayerRects] == Attributes::True;
+	for(auto &layer_id : attribs[Attributes::ActiveLayers].split(',', QtCompat::SkipEmptyParts))
+	{
+		if(layer_id.toInt() >= layers.size())
+			continue;
 
-			/*  Compatibility with models created prior the layers features:
-			 * If the layer rect colors is empty (probably a model generated in an older version)
-			 * we create random colors as fallback */
+		active_layers.push_back(layer_id.toInt());
+	}
 
-			// Forcing the creation of the default layer is not present
-			if(layers.isEmpty())
-				layers.push_back(tr("Default layer"));
+	if(active_layers.isEmpty())
+		active_layers.push_back(0);
 
-			if(layer_rect_colors.isEmpty())
-			{
-				random_device rand_seed;
-				default_random_engine rand_num_engine;
-				uniform_int_distribution<unsigned> dist(0,255);
+	/* Perfoming size validations between the layer color lists and the layers lists
+	 * The excessive items from both list are removed until their sizes matches
+	 * the layers list */
+	while(layer_name_colors.size() > layers.size())
+		layer_name_colors.removeLast();
 
-				layer_name_colors.clear();
-				rand_num_engine.seed(rand_seed());
+	while(layer_rect_colors.size() > layers.size())
+		layer_rect_colors.removeLast();
 
-				for(int i =0; i <= layers.size(); i++)
-				{
-					layer_rect_colors.append(QColor(dist(rand_num_engine),
-																					dist(rand_num_engine),
-																					dist(rand_num_engine)).name());
+	protected_model=(attribs[Attributes::Protected]==Attributes::True);
 
-					layer_name_colors.append(QColor(0,0,0).name());
-				}
+	def_objs[ObjectType::Schema]=attribs[Attributes::DefaultSchema];
+	def_objs[ObjectType::Role]=attribs[Attributes::DefaultOwner];
+	def_objs[ObjectType::Collation]=attribs[Attributes::DefaultCollation];
+	def_objs[ObjectType::Tablespace]=attribs[Attributes::DefaultTablespace];
+}
+
+void DatabaseModel::loadModelElement(bool &found_inh_rel, double progress)
+{
+	QString elem_name=xmlparser.getElementName();
+
+	//Indentifies the object type to be load according to the current element on the parser
+	ObjectType obj_type=getObjectType(elem_name);
+
+	if(elem_name == Attributes::Changelog)
+	{
+		attribs_map entry_attr;
+		xmlparser.savePosition();
+
+		if(xmlparser.accessElement(XmlParser::ChildElement))
+		{
+			do
+			{
+				xmlparser.getElementAttributes(entry_attr);
+				addChangelogEntry(entry_attr[Attributes::Signature], entry_attr[Attributes::Type],
+													entry_attr[Attributes::Action], entry_attr[Attributes::Date]);
 			}
+			while(xmlparser.accessElement(XmlParser::NextElement));
+		}
 
-			/* Compatibility with models created prior the layers features:
-			 * If the "active-layers" is absent we make the default layer always visible */
-			active_layers.clear();
+		xmlparser.restorePosition();
+	}
+	else if(obj_type==ObjectType::Database)
+	{
+		attribs_map attribs;
+		xmlparser.getElementAttributes(attribs);
+		configureDatabase(attribs);
+	}
+	else
+	{
+		try
+		{
+			//Saves the current position of the parser before create any object
+			xmlparser.savePosition();
+			BaseObject *object=createObject(obj_type);
 
-			for(auto &layer_id : attribs[Attributes::ActiveLayers].split(',', QtCompat::SkipEmptyParts))
+			if(object)
 			{
-				if(layer_id.toInt() >= layers.size())
-					continue;
+				if(!dynamic_cast<TableObject *>(object) && obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship)
+					addObject(object);
+
+				/* If there is at least one inheritance relationship we need to flag this situation
+				 in order to do an addtional rel. validation in the end of loading */
+				if(!found_inh_rel && object->getObjectType()==ObjectType::Relationship &&
+						dynamic_cast<Relationship *>(object)->getRelationshipType()==BaseRelationship::RelationshipGen)
+					found_inh_rel=true;
 
-				active_layers.push_back(layer_id.toInt());
+				emit s_objectLoaded(progress,
+									tr("Loading: `%1' (%2)")
+									.arg(object->getName())
+									.arg(object->getTypeName()),
+									enum_cast(obj_type));
 			}
 
-			if(active_layers.isEmpty())
-				active_layers.push_back(0);
+			xmlparser.restorePosition();
+		}
+		catch(Exception &e)
+		{
+			QString info_adicional=QString(QObject::tr("%1 (line: %2)")).arg(xmlparser.getLoadedFilename()).arg(xmlparser.getCurrentElement()->line);
+			throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, info_adicional);
+		}
+	}
+}
 
-			/* Perfoming size validations between the layer color lists and the layers lists
-			 * The excessive items from both list are removed until their sizes matches
-			 * the layers list */
-			while(layer_name_colors.size() > layers.size())
-				layer_name_colors.removeLast();
+void DatabaseModel::loadModel(const QString &filename)
+{
+	TraceLogger::Span trace_span("DatabaseModel::loadModel");
 
-			while(layer_rect_colors.size() > layers.size())
-				layer_rect_colors.removeLast();
+	//Directories hold models in the split fragment format
+	if(QFileInfo(filename).isDir())
+	{
+		loadSplitModelDefinition(filename);
+		return;
+	}
 
-			protected_model=(attribs[Attributes::Protected]==Attributes::True);
+	if(!filename.isEmpty())
+	{
+		QString dtd_file, str_aux;
+		attribs_map attribs;
+		BaseObject *object=nullptr;
+		bool protected_model=false, found_inh_rel = false;
+		map<ObjectType, QString> def_objs;
+
+		//Configuring the path to the base path for objects DTD
+		dtd_file=GlobalAttributes::getSchemasRootDir() +
+						 GlobalAttributes::DirSeparator +
+						 GlobalAttributes::XMLSchemaDir +
+						 GlobalAttributes::DirSeparator +
+						 GlobalAttributes::ObjectDTDDir +
+						 GlobalAttributes::DirSeparator;
 
-			def_objs[ObjectType::Schema]=attribs[Attributes::DefaultSchema];
-			def_objs[ObjectType::Role]=attribs[Attributes::DefaultOwner];
-			def_objs[ObjectType::Collation]=attribs[Attributes::DefaultCollation];
-			def_objs[ObjectType::Tablespace]=attribs[Attributes::DefaultTablespace];
+		try
+		{
+			loading_model=true;
+			xmlparser.restartParser();
 
-			if(xmlparser.accessElement(XmlParser::ChildElement))
+			/* Compressed models must be fully inflated before the parsing, so they
+			always take the buffered loading path below */
+			bool compressed_model=isCompressedModelFile(filename);
+
+			if(stream_loading_enabled && !compressed_model)
+			{
+				/* In streaming mode the document tree is never fully built in memory, instead each
+				 * second level element subtree is materialized and parsed separately, keeping the
+				 * memory usage proportional to a single object no matter the size of the file */
+				XmlParser::streamXMLFile(filename,
+				[&](attribs_map &root_attribs){
+					attribs=root_attribs;
+					configureModelAttributes(attribs, def_objs, protected_model);
+				},
+				[&](const QString &elem_buf, const QString &, double progress){
+					xmlparser.restartParser();
+					xmlparser.loadXMLBuffer(elem_buf);
+					loadModelElement(found_inh_rel, progress);
+				});
+			}
+			else
 			{
-				do
-				{
-					if(xmlparser.getElementType()==XML_ELEMENT_NODE)
-					{
-						elem_name=xmlparser.getElementName();
+				QByteArray cached_xml;
 
-						//Indentifies the object type to be load according to the current element on the parser
-						obj_type=getObjectType(elem_name);
-
-						if(elem_name == Attributes::Changelog)
-						{
-							attribs_map entry_attr;
-							xmlparser.savePosition();
+				if(model_cache_enabled)
+					cached_xml=loadModelCache(filename);
 
-							if(xmlparser.accessElement(XmlParser::ChildElement))
-							{
-								do
-								{
-									xmlparser.getElementAttributes(entry_attr);
-									addChangelogEntry(entry_attr[Attributes::Signature], entry_attr[Attributes::Type],
-																		entry_attr[Attributes::Action], entry_attr[Attributes::Date]);
-								}
-								while(xmlparser.accessElement(XmlParser::NextElement));
-							}
+				if(!cached_xml.isEmpty())
+				{
+					/* The binary cache sidecar matches the dbm file so the xml is loaded straight
+					 * from it, skipping the disk reading and the DTD validation of the document */
+					xmlparser.loadXMLBuffer(QString::fromUtf8(cached_xml));
+				}
+				else if(compressed_model)
+				{
+					/* The compressed definition is inflated straight into the parser buffer.
+					 * Like in the binary cache path above, the xml was produced by pgModeler
+					 * itself so the DTD validation is skipped */
+					QByteArray file_buf=UtilsNs::loadFile(filename);
+					xmlparser.loadXMLBuffer(QString::fromUtf8(qUncompress(file_buf.mid(CompressedModelMagic.size()))));
+				}
+				else
+				{
+					//Loads the root DTD
+					xmlparser.setDTDFile(dtd_file + GlobalAttributes::RootDTD +
+										 GlobalAttributes::ObjectDTDExt,
+										 GlobalAttributes::RootDTD);
 
-							xmlparser.restorePosition();
-						}
-						else if(obj_type==ObjectType::Database)
-						{
-							xmlparser.getElementAttributes(attribs);
-							configureDatabase(attribs);
-						}
-						else
-						{
-							try
-							{
-								//Saves the current position of the parser before create any object
-								xmlparser.savePosition();
-								object=createObject(obj_type);
+					//Loads the file validating it against the root DTD
+					xmlparser.loadXMLFile(filename);
+				}
 
-								if(object)
-								{
-									if(!dynamic_cast<TableObject *>(object) && obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship)
-										addObject(object);
-
-									/* If there is at least one inheritance relationship we need to flag this situation
-									 in order to do an addtional rel. validation in the end of loading */
-									if(!found_inh_rel && object->getObjectType()==ObjectType::Relationship &&
-											dynamic_cast<Relationship *>(object)->getRelationshipType()==BaseRelationship::RelationshipGen)
-										found_inh_rel=true;
-
-									emit s_objectLoaded((xmlparser.getCurrentBufferLine()/static_cast<double>(xmlparser.getBufferLineCount()))*100,
-														tr("Loading: `%1' (%2)")
-														.arg(object->getName())
-														.arg(object->getTypeName()),
-														enum_cast(obj_type));
-								}
+				//Gets the basic model information
+				xmlparser.getElementAttributes(attribs);
+				configureModelAttributes(attribs, def_objs, protected_model);
 
-								xmlparser.restorePosition();
-							}
-							catch(Exception &e)
-							{
-								QString info_adicional=QString(QObject::tr("%1 (line: %2)")).arg(xmlparser.getLoadedFilename()).arg(xmlparser.getCurrentElement()->line);
-								throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, info_adicional);
-							}
+				if(xmlparser.accessElement(XmlParser::ChildElement))
+				{
+					do
+					{
+						if(xmlparser.getElementType()==XML_ELEMENT_NODE)
+						{
+							loadModelElement(found_inh_rel,
+															 (xmlparser.getCurrentBufferLine()/static_cast<double>(xmlparser.getBufferLineCount()))*100);
 						}
 					}
+					while(xmlparser.accessElement(XmlParser::NextElement));
 				}
-				while(xmlparser.accessElement(XmlParser::NextElement));
 			}
 
 			this->BaseObject::setProtected(protected_model);
@@ -3485,6 +3934,133 @@ void DatabaseModel::loadModel(const QString &filename)
 	}
 }
 
+void DatabaseModel::loadModelFromBuffer(const QString &xml_buf)
+{
+	attribs_map attribs;
+	map<ObjectType, QString> def_objs;
+	BaseObject *object=nullptr;
+	bool protected_model=false, found_inh_rel=false;
+
+	try
+	{
+		loading_model=true;
+		xmlparser.restartParser();
+
+		/* The buffer comes straight from the code generator (see captureSnapshot()) or from
+		 * fragments written by pgModeler itself (see loadSplitModelDefinition()), so the DTD
+		 * validation performed by loadModel() for files on disk is skipped here */
+		xmlparser.loadXMLBuffer(xml_buf);
+
+		xmlparser.getElementAttributes(attribs);
+		configureModelAttributes(attribs, def_objs, protected_model);
+
+		if(xmlparser.accessElement(XmlParser::ChildElement))
+		{
+			do
+			{
+				if(xmlparser.getElementType()==XML_ELEMENT_NODE)
+				{
+					loadModelElement(found_inh_rel,
+													 (xmlparser.getCurrentBufferLine()/static_cast<double>(xmlparser.getBufferLineCount()))*100);
+				}
+			}
+			while(xmlparser.accessElement(XmlParser::NextElement));
+		}
+
+		this->BaseObject::setProtected(protected_model);
+
+		//Validating default objects
+		for(auto &itr : def_objs)
+		{
+			if(!itr.second.isEmpty())
+			{
+				object=this->getObject(itr.second, itr.first);
+
+				if(!object)
+					throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
+									.arg(this->getName())
+									.arg(this->getTypeName())
+									.arg(itr.second)
+									.arg(BaseObject::getTypeName(itr.first)),
+									ErrorCode::AsgDuplicatedPermission,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+				this->setDefaultObject(object);
+			}
+			else
+				this->setDefaultObject(nullptr, itr.first);
+		}
+
+		loading_model=false;
+
+		//If there are relationship make a relationship validation to recreate any special object left behind
+		if(!relationships.empty())
+		{
+			emit s_objectLoaded(100, tr("Validating relationships..."), enum_cast(ObjectType::Relationship));
+			storeSpecialObjectsXML();
+			disconnectRelationships();
+			validateRelationships();
+		}
+
+		this->setInvalidated(false);
+		emit s_objectLoaded(100, tr("Validating relationships..."), enum_cast(ObjectType::Relationship));
+
+		//Doing another relationship validation when there are inheritances to avoid incomplete tables
+		if(found_inh_rel)
+		{
+			emit s_objectLoaded(100, tr("Validating relationships..."), enum_cast(ObjectType::Relationship));
+			validateRelationships();
+		}
+
+		updateTablesFKRelationships();
+		emit s_objectLoaded(100, tr("Rendering database model..."), enum_cast(ObjectType::BaseObject));
+		this->setObjectsModified();
+	}
+	catch(Exception &e)
+	{
+		QString extra_info;
+		loading_model=false;
+
+		if(xmlparser.getCurrentElement())
+			extra_info=QString(QObject::tr("(line: %1)")).arg(xmlparser.getCurrentElement()->line);
+
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, extra_info);
+	}
+}
+
+QString DatabaseModel::captureSnapshot()
+{
+	/* The exclusive lock freezes the structural state of the model during the serialization.
+	 * The snapshot cost is a single code generation pass instead of an object graph clone,
+	 * so the editing lockout is limited to this window */
+	QWriteLocker wlocker(&model_rw_lock);
+
+	try
+	{
+		return this->getCodeDefinition(SchemaParser::XmlDefinition);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+DatabaseModel *DatabaseModel::materializeSnapshot(const QString &xml_buf)
+{
+	DatabaseModel *model=nullptr;
+
+	try
+	{
+		model=new DatabaseModel;
+		model->loadModelFromBuffer(xml_buf);
+		return model;
+	}
+	catch(Exception &e)
+	{
+		delete model;
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 BaseObject *DatabaseModel::createObject(ObjectType obj_type)
 {
 	BaseObject *object=nullptr;
@@ -3744,6 +4320,11 @@ void DatabaseModel::setLoadingModel(bool value)
 void DatabaseModel::setCancelSaving(bool value)
 {
 	cancel_saving = value;
+
+	/* Flagging the token as well so a template evaluation in progress (schema parser)
+	 * aborts instead of running to completion before noticing the flag */
+	if(value)
+		codegen_cancel_token.requestCancel();
 }
 
 void DatabaseModel::setObjectListsCapacity(unsigned capacity)
@@ -7445,53 +8026,58 @@ void DatabaseModel::validateRelationships(TableObject *object, Table *parent_tab
 {
 	try
 	{
-		bool revalidate_rels=false, ref_tab_inheritance=false;
-		Relationship *rel=nullptr;
-		vector<BaseObject *>::iterator itr, itr_end;
-		ObjectType obj_type;
-
-		if(object && parent_tab)
+		if(isRelValidationRequired(object, parent_tab))
 		{
-			obj_type=object->getObjectType();
+			storeSpecialObjectsXML();
+			disconnectRelationships();
+			validateRelationships();
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
 
-			/* Relationship validation condition:
-			> Case the object is a column and its reference by the parent table primary key
-			> Case the parent table is a partition and a column is being removed
-			> Case the object is a constraint and its a table primary key */
-			revalidate_rels=((obj_type==ObjectType::Column &&
-												(parent_tab->isConstraintRefColumn(dynamic_cast<Column *>(object), ConstraintType::PrimaryKey) ||
-												 parent_tab->isPartition() || parent_tab->isPartitioned())) ||
-											 (obj_type==ObjectType::Constraint &&
-												dynamic_cast<Constraint *>(object)->getConstraintType()==ConstraintType::PrimaryKey));
-
-			/* Additional validation for columns: checks if the parent table participates on a
-			generalization/copy as destination table */
-			if(obj_type==ObjectType::Column)
-			{
-				itr=relationships.begin();
-				itr_end=relationships.end();
+bool DatabaseModel::isRelValidationRequired(TableObject *object, Table *parent_tab)
+{
+	bool revalidate_rels=false, ref_tab_inheritance=false;
+	Relationship *rel=nullptr;
+	vector<BaseObject *>::iterator itr, itr_end;
+	ObjectType obj_type;
 
-				while(itr!=itr_end && !ref_tab_inheritance)
-				{
-					rel=dynamic_cast<Relationship *>(*itr);
-					itr++;
-					ref_tab_inheritance=(rel->getRelationshipType()==Relationship::RelationshipGen &&
-															 rel->getReferenceTable()==parent_tab);
-				}
-			}
+	if(object && parent_tab)
+	{
+		obj_type=object->getObjectType();
+
+		/* Relationship validation condition:
+		> Case the object is a column and its reference by the parent table primary key
+		> Case the parent table is a partition and a column is being removed
+		> Case the object is a constraint and its a table primary key */
+		revalidate_rels=((obj_type==ObjectType::Column &&
+											(parent_tab->isConstraintRefColumn(dynamic_cast<Column *>(object), ConstraintType::PrimaryKey) ||
+											 parent_tab->isPartition() || parent_tab->isPartitioned())) ||
+										 (obj_type==ObjectType::Constraint &&
+											dynamic_cast<Constraint *>(object)->getConstraintType()==ConstraintType::PrimaryKey));
+
+		/* Additional validation for columns: checks if the parent table participates on a
+		generalization/copy as destination table */
+		if(obj_type==ObjectType::Column)
+		{
+			itr=relationships.begin();
+			itr_end=relationships.end();
 
-			if(revalidate_rels || ref_tab_inheritance)
+			while(itr!=itr_end && !ref_tab_inheritance)
 			{
-				storeSpecialObjectsXML();
-				disconnectRelationships();
-				validateRelationships();
+				rel=dynamic_cast<Relationship *>(*itr);
+				itr++;
+				ref_tab_inheritance=(rel->getRelationshipType()==Relationship::RelationshipGen &&
+														 rel->getReferenceTable()==parent_tab);
 			}
 		}
 	}
-	catch(Exception &e)
-	{
-		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
-	}
+
+	return revalidate_rels || ref_tab_inheritance;
 }
 
 QString DatabaseModel::__getCodeDefinition(unsigned def_type)
@@ -7596,8 +8182,118 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type)
 	return this->getCodeDefinition(def_type, true);
 }
 
+void DatabaseModel::generateCodeInParallel(map<unsigned, BaseObject *> &objects_map, unsigned def_type)
+{
+	map<BaseObject *, vector<BaseObject *>> obj_groups;
+	vector<vector<BaseObject *>> tasks;
+	TableObject *tab_obj=nullptr;
+	BaseObject *group_key=nullptr;
+	ObjectType obj_type;
+	Exception error;
+	bool has_error=false;
+	QMutex error_mtx;
+
+	if(def_type==SchemaParser::XmlDefinition)
+	{
+		/* The xml code of almost every object embeds the reduced form of the objects it references
+		 * (its schema, owner, tablespace, the function of a trigger and so on). Those shared reduced
+		 * definitions are generated serially here so the worker threads only read the already populated
+		 * caches (see BaseObject::getCodeDefinition(unsigned,bool)) instead of racing to write them */
+		vector<ObjectType> shared_types={ ObjectType::Schema, ObjectType::Tablespace, ObjectType::Role,
+																			ObjectType::Collation, ObjectType::Language, ObjectType::Function,
+																			ObjectType::Operator, ObjectType::OpClass, ObjectType::OpFamily,
+																			ObjectType::ForeignDataWrapper, ObjectType::ForeignServer, ObjectType::Tag };
+
+		for(auto &type : shared_types)
+		{
+			for(auto &object : *getObjectList(type))
+				object->getCodeDefinition(def_type, true);
+		}
+	}
+
+	/* Objects are grouped by their parent table (or by themselves when they aren't table children)
+	 * since generating the code of a table also generates the one of its children. Processing a whole
+	 * group in a single thread avoids two threads writing concurrently to the same object's
+	 * attributes/code cache */
+	for(auto &obj_itr : objects_map)
+	{
+		obj_type=obj_itr.second->getObjectType();
+
+		/* The database itself and system objects are cheap to generate so they stay in the main
+		 * thread. Constraints are ignored because the stitching loop regenerates their code
+		 * unconditionally (see the inc_addedbyrel flag in Constraint::getCodeDefinition()).
+		 * In xml mode relationships stay out too: their code embeds the xml of columns and
+		 * constraints owned by the participant tables, which would break the confinement of
+		 * the table groups */
+		if(obj_itr.second==this || obj_itr.second->isSystemObject() ||
+				obj_type==ObjectType::Constraint ||
+				(def_type==SchemaParser::XmlDefinition &&
+				 (obj_type==ObjectType::Relationship || obj_type==ObjectType::BaseRelationship)))
+			continue;
+
+		tab_obj=dynamic_cast<TableObject *>(obj_itr.second);
+		group_key=(tab_obj && tab_obj->getParentTable() ? tab_obj->getParentTable() : obj_itr.second);
+		obj_groups[group_key].push_back(obj_itr.second);
+	}
+
+	tasks.reserve(obj_groups.size());
+
+	for(auto &grp_itr : obj_groups)
+		tasks.push_back(std::move(grp_itr.second));
+
+	std::atomic<size_t> next_idx{0};
+	QList<QFuture<void>> futures;
+
+	auto worker=[&](){
+		size_t idx=0;
+
+		while((idx=next_idx++) < tasks.size() && !cancel_saving && !has_error)
+		{
+			for(auto &object : tasks[idx])
+			{
+				if(cancel_saving || has_error)
+					return;
+
+				try
+				{
+					// Populates the object's code cache so the stitching loop just reuses it
+					object->getCodeDefinition(def_type);
+				}
+				catch(Exception &e)
+				{
+					QMutexLocker lock(&error_mtx);
+
+					if(!has_error)
+					{
+						error=Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+						has_error=true;
+					}
+				}
+			}
+		}
+	};
+
+	/* The groups are pulled from a shared index by workers running on the shared scheduler
+	 * pool, so concurrent helpers split the cores instead of oversubscribing them. The calling
+	 * thread drains the queue too: even when the pool is saturated (e.g. this method was
+	 * reached from a task already running on the pool) the generation always completes */
+	int worker_cnt=qMin(TaskScheduler::getMaxThreadCount(), static_cast<int>(tasks.size()));
+
+	for(int th=0; th < worker_cnt - 1; th++)
+		futures.append(QtConcurrent::run(&TaskScheduler::getThreadPool(), worker));
+
+	worker();
+
+	for(auto &future : futures)
+		future.waitForFinished();
+
+	if(has_error)
+		throw error;
+}
+
 QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 {
+	PerformanceCounters::ScopedTimer perf_timer("DatabaseModel::getCodeDefinition");
 	attribs_map attribs_aux;
 	unsigned general_obj_cnt, gen_defs_count;
 	BaseObject *object=nullptr;
@@ -7612,6 +8308,13 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 	try
 	{
 		cancel_saving = false;
+
+		/* A fresh token is installed on every run since canceled tokens can't be reset.
+		 * The model's parser evaluates the final database-level template, by far the
+		 * longest single evaluation of the generation */
+		codegen_cancel_token=TaskScheduler::CancelToken();
+		schparser.setCancelToken(codegen_cancel_token);
+
 		objects_map=getCreationOrder(def_type);
 		general_obj_cnt=objects_map.size();
 		gen_defs_count=0;
@@ -7634,6 +8337,16 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 			attribs_aux[Attributes::Changelog] = getChangelogDefinition();
 		}
 
+		if(parallel_code_gen && QThread::idealThreadCount() > 1)
+			generateCodeInParallel(objects_map, def_type);
+
+		/* The object and permission definitions are accumulated in local buffers reserved
+		 upfront, avoiding a map lookup per object and the reallocation churn of growing a
+		 multi-megabyte string in small steps. They are moved to the attribute map once the
+		 whole script is assembled */
+		QString objs_def, perms_def;
+		objs_def.reserve(general_obj_cnt * 512);
+
 		for(auto &obj_itr : objects_map)
 		{
 			if(cancel_saving)
@@ -7645,22 +8358,22 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 			if(obj_type==ObjectType::Type && def_type==SchemaParser::SqlDefinition)
 			{
 				usr_type=dynamic_cast<Type *>(object);
-				attribs_aux[attrib]+=usr_type->getCodeDefinition(def_type);
+				objs_def+=usr_type->getCodeDefinition(def_type);
 			}
 			else if(obj_type==ObjectType::Database)
 			{
 				if(def_type==SchemaParser::SqlDefinition)
 					attribs_aux[this->getSchemaName()] += this->__getCodeDefinition(def_type);
 				else
-					attribs_aux[attrib]+=this->__getCodeDefinition(def_type);
+					objs_def+=this->__getCodeDefinition(def_type);
 			}
 			else if(obj_type==ObjectType::Permission)
 			{
-				attribs_aux[Attributes::Permission]+=dynamic_cast<Permission *>(object)->getCodeDefinition(def_type);
+				perms_def+=dynamic_cast<Permission *>(object)->getCodeDefinition(def_type);
 			}
 			else if(obj_type==ObjectType::Constraint)
 			{
-				attribs_aux[attrib]+=dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true);
+				objs_def+=dynamic_cast<Constraint *>(object)->getCodeDefinition(def_type, true);
 			}
 			else if(obj_type==ObjectType::Role || obj_type==ObjectType::Tablespace ||  obj_type==ObjectType::Schema)
 			{
@@ -7684,15 +8397,15 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 						search_path+=QString(",") + object->getName(true);
 
 					//Generates the code definition and concatenates to the others
-					attribs_aux[attrib_aux]+=object->getCodeDefinition(def_type);
+					if(attrib_aux==attrib)
+						objs_def+=object->getCodeDefinition(def_type);
+					else
+						attribs_aux[attrib_aux]+=object->getCodeDefinition(def_type);
 				}
 			}
-			else
+			else if(!object->isSystemObject())
 			{
-				if(object->isSystemObject())
-					attribs_aux[attrib]+="";
-				else
-					attribs_aux[attrib]+=object->getCodeDefinition(def_type);
+				objs_def+=object->getCodeDefinition(def_type);
 			}
 
 			gen_defs_count++;
@@ -7708,6 +8421,8 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 			}
 		}
 
+		attribs_aux[attrib]=std::move(objs_def);
+		attribs_aux[Attributes::Permission]=std::move(perms_def);
 		attribs_aux[Attributes::SearchPath]=search_path;
 		attribs_aux[Attributes::ModelAuthor]=author;
 		attribs_aux[Attributes::PgModelerVersion]=GlobalAttributes::PgModelerVersion;
@@ -7757,6 +8472,144 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 	return def;
 }
 
+void DatabaseModel::getSQLDefinitionStreamed(const std::function<void(const QString &)> &output_fn)
+{
+	attribs_map attribs_aux;
+	map<unsigned, BaseObject *> objects_map;
+	vector<BaseObject *> perm_objs;
+	BaseObject *object=nullptr;
+	ObjectType obj_type;
+	QString def, chunk, search_path=QString("pg_catalog,public"),
+			msg=tr("Generating %1 code: `%2' (%3)"),
+			marker_fmt=QString("\x1f<%1>\x1f"),
+			objs_marker=marker_fmt.arg(Attributes::Objects),
+			perms_marker=marker_fmt.arg(Attributes::Permission);
+	unsigned general_obj_cnt=0, gen_defs_count=0;
+	int pos=-1, start=-1;
+
+	try
+	{
+		cancel_saving=false;
+		objects_map=getCreationOrder(SchemaParser::SqlDefinition);
+		general_obj_cnt=objects_map.size();
+
+		attribs_aux[Attributes::Schema]="";
+		attribs_aux[Attributes::Tablespace]="";
+		attribs_aux[Attributes::Role]="";
+		attribs_aux[this->getSchemaName()]="";
+		attribs_aux[Attributes::Function]=(!functions.empty() ? Attributes::True : "");
+		attribs_aux[Attributes::ShellTypes]=configureShellTypes(false);
+
+		/* First pass: the wrapper attributes that must be known before the script header can be
+		 * rendered (schema definitions and the search path) are gathered here. Roles, tablespaces
+		 * and the database itself are not part of the generated script (they are handled separately
+		 * by the export process), mimicking getCodeDefinition() called with export_file=false */
+		for(auto &obj_itr : objects_map)
+		{
+			object=obj_itr.second;
+
+			if(object->getObjectType()!=ObjectType::Schema ||
+				 object->getName()==QString("public") || object->getName()==QString("pg_catalog"))
+				continue;
+
+			search_path+=QString(",") + object->getName(true);
+			attribs_aux[Attributes::Schema]+=object->getCodeDefinition(SchemaParser::SqlDefinition);
+		}
+
+		/* The huge sections (objects and permissions) are replaced by markers in the rendered wrapper.
+		 * The wrapper is then split at the markers and the sections are generated and forwarded one
+		 * object at a time, keeping the memory bounded (same technique used by the streamed diff) */
+		attribs_aux[Attributes::Objects]=objs_marker;
+		attribs_aux[Attributes::Permission]=(getObjectList(ObjectType::Permission)->empty() ? QString() : perms_marker);
+		attribs_aux[Attributes::SearchPath]=search_path;
+		attribs_aux[Attributes::ModelAuthor]=author;
+		attribs_aux[Attributes::PgModelerVersion]=GlobalAttributes::PgModelerVersion;
+		attribs_aux[Attributes::ExportToFile]="";
+
+		def=schparser.getCodeDefinition(Attributes::DbModel, attribs_aux, SchemaParser::SqlDefinition);
+
+		if(prepend_at_bod)
+			output_fn(QString("-- Prepended SQL commands --\n") + this->prepended_sql + Attributes::DdlEndToken);
+
+		//Forwarding the script header (everything that precedes the objects section)
+		pos=def.indexOf(objs_marker);
+		output_fn(def.mid(0, pos));
+		start=pos + objs_marker.size();
+
+		//Second pass: generating and forwarding the objects' definitions in creation order
+		for(auto &obj_itr : objects_map)
+		{
+			if(cancel_saving)
+				return;
+
+			object=obj_itr.second;
+			obj_type=object->getObjectType();
+
+			if(obj_type==ObjectType::Permission)
+			{
+				perm_objs.push_back(object);
+				continue;
+			}
+
+			gen_defs_count++;
+
+			if(object->isSystemObject() ||
+				 obj_type==ObjectType::Role || obj_type==ObjectType::Tablespace ||
+				 obj_type==ObjectType::Schema || obj_type==ObjectType::Database)
+				continue;
+
+			if(obj_type==ObjectType::Constraint)
+				chunk=dynamic_cast<Constraint *>(object)->getCodeDefinition(SchemaParser::SqlDefinition, true);
+			else
+				chunk=object->getCodeDefinition(SchemaParser::SqlDefinition);
+
+			if(!chunk.isEmpty())
+				output_fn(chunk);
+
+			if(!object->isSQLDisabled())
+			{
+				emit s_objectLoaded((gen_defs_count/static_cast<double>(general_obj_cnt)) * 100,
+									msg.arg(QString("SQL"))
+									.arg(object->getName())
+									.arg(object->getTypeName()),
+									enum_cast(object->getObjectType()));
+			}
+		}
+
+		//Forwarding the section between the objects and the permissions followed by each permission
+		if(!perm_objs.empty())
+		{
+			pos=def.indexOf(perms_marker, start);
+			output_fn(def.mid(start, pos - start));
+			start=pos + perms_marker.size();
+
+			for(auto &perm : perm_objs)
+			{
+				if(cancel_saving)
+					return;
+
+				chunk=perm->getCodeDefinition(SchemaParser::SqlDefinition);
+
+				if(!chunk.isEmpty())
+					output_fn(chunk);
+			}
+		}
+
+		//Forwarding the script tail
+		output_fn(def.mid(start));
+
+		if(append_at_eod)
+			output_fn(QString("-- Appended SQL commands --\n") + this->appended_sql + QChar('\n') + Attributes::DdlEndToken);
+
+		configureShellTypes(true);
+	}
+	catch(Exception &e)
+	{
+		configureShellTypes(true);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type, bool incl_relnn_objs, bool incl_rel1n_constrs)
 {
 	BaseObject *object=nullptr;
@@ -7792,6 +8645,11 @@ map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type, b
 
 	for(auto &obj_type : obj_types_vect)
 	{
+		/* Cooperative cancellation: the partial map is returned right away, the callers abort
+		 * by checking cancel_saving themselves (see getCodeDefinition()) */
+		if(cancel_saving)
+			return objects_map;
+
 		//For SQL definition, only the textbox and base relationship does not enters to the code generation list
 		if(def_type==SchemaParser::SqlDefinition &&
 			 (obj_type==ObjectType::Textbox || obj_type==ObjectType::BaseRelationship))
@@ -7836,6 +8694,9 @@ map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type, b
 
 	for(auto &obj : aux_tables)
 	{
+		if(cancel_saving)
+			return objects_map;
+
 		table = dynamic_cast<PhysicalTable *>(obj);
 
 		for(auto &obj : *table->getObjectList(ObjectType::Constraint))
@@ -7889,6 +8750,9 @@ map<unsigned, BaseObject *> DatabaseModel::getCreationOrder(unsigned def_type, b
 
 		while(itr!=itr_end)
 		{
+			if(cancel_saving)
+				return objects_map;
+
 			object=(*itr);
 			itr++;
 
@@ -8185,7 +9049,65 @@ void DatabaseModel::saveModel(const QString &filename, unsigned def_type)
 	try
 	{
 		if(!cancel_saving)
-			UtilsNs::saveFile(filename, this->getCodeDefinition(def_type).toUtf8());
+		{
+			//Directories receive the model in the split fragment format
+			if(def_type==SchemaParser::XmlDefinition && QFileInfo(filename).isDir())
+				saveSplitModelDefinition(filename);
+			else
+			{
+				QByteArray buffer=this->getCodeDefinition(def_type).toUtf8();
+
+				if(def_type==SchemaParser::XmlDefinition)
+					writeModelBuffer(filename, buffer);
+				else
+					UtilsNs::saveFile(filename, buffer);
+			}
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileNotWrittenInvalidDefinition).arg(filename),
+										ErrorCode::FileNotWrittenInvalidDefinition,__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void DatabaseModel::writeModelBuffer(const QString &filename, const QByteArray &buffer)
+{
+	try
+	{
+		QByteArray file_buf=buffer;
+
+		/* Files with the compressed model extension are deflated before the writing, prefixed
+		 * by a magic token that makes them recognizable on loading no matter the extension */
+		if(filename.endsWith(GlobalAttributes::CompressedDbModelExt, Qt::CaseInsensitive))
+			file_buf=CompressedModelMagic + qCompress(buffer);
+
+		/* When the generated definition matches the bytes already on disk the whole writing
+		 * (including the fsync and the sidecar refresh) is skipped. Together with the per-object
+		 * code caches, that only regenerate the xml of the objects modified since the last
+		 * generation, this keeps the saving cost proportional to the edit instead of to the
+		 * size of the model */
+		QFile existing(filename);
+
+		if(existing.open(QFile::ReadOnly) &&
+				existing.size()==file_buf.size() && existing.readAll()==file_buf)
+		{
+			//The cache sidecar is still materialized when it doesn't exist yet
+			if(model_cache_enabled && !QFile::exists(getModelCacheFilename(filename)))
+				saveModelCache(filename, buffer, file_buf);
+
+			return;
+		}
+
+		existing.close();
+
+		/* The atomic replace guarantees the dbm file always holds a complete definition,
+		 * even if the process dies in the middle of the writing */
+		UtilsNs::saveFileAtomic(filename, file_buf);
+
+		//Refreshing the binary cache sidecar so the next loading of the file can skip the xml reading/validation
+		if(model_cache_enabled)
+			saveModelCache(filename, buffer, file_buf);
 	}
 	catch(Exception &e)
 	{
@@ -8222,6 +9144,45 @@ bool DatabaseModel::saveSplitCustomSQL(bool save_appended, const QString &path,
 	return false;
 }
 
+void DatabaseModel::saveFilesAsync(vector<std::pair<QString, QByteArray>> &files)
+{
+	if(files.empty())
+		return;
+
+	if(files.size() > 1 && QThread::idealThreadCount() > 1)
+	{
+		QMutex err_mtx;
+		vector<Exception> errors;
+
+		/* The files are written by worker threads. Since Exception can't cross the
+		 QtConcurrent boundary the errors are collected and the first one is rethrown
+		 once all the workers are done */
+		QtConcurrent::blockingMap(files, [&err_mtx, &errors](std::pair<QString, QByteArray> &file){
+			try
+			{
+				UtilsNs::saveFile(file.first, file.second);
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&err_mtx);
+				errors.push_back(e);
+			}
+		});
+
+		files.clear();
+
+		if(!errors.empty())
+			throw Exception(errors[0].getErrorMessage(), errors[0].getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &errors[0]);
+	}
+	else
+	{
+		for(auto &file : files)
+			UtilsNs::saveFile(file.first, file.second);
+
+		files.clear();
+	}
+}
+
 void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 {
 	QFileInfo fi(path);
@@ -8246,12 +9207,21 @@ void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 	unsigned 	gen_defs_idx = 0, general_obj_cnt = 0;
 	attribs_map attribs;
 
+	/* Files are not written right away, instead they are queued and flushed in batches
+	 * through saveFilesAsync() which spreads the disk writes over worker threads */
+	vector<std::pair<QString, QByteArray>> pending_files;
+
 	try
 	{
 		cancel_saving = false;
 		general_obj_cnt = objects.size();
 		shell_types = configureShellTypes(false);
 
+		/* Pre-generating the SQL code of all objects over the worker threads so the
+		 * sequential naming/ordering loop below only hits warm per-object code caches */
+		if(parallel_code_gen && QThread::idealThreadCount() > 1)
+			generateCodeInParallel(objects, SchemaParser::SqlDefinition);
+
 		/* We try to save prepended code as the first script. In case of success increment the script index
 		 * to keep generating the other scripts in the right order */
 		if(saveSplitCustomSQL(false, path, QString::number(idx).rightJustified(pad_size, '0')))
@@ -8286,7 +9256,7 @@ void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 									enum_cast(ObjectType::Type));
 
 				buffer.append(shell_types.toUtf8());
-				UtilsNs::saveFile(path + GlobalAttributes::DirSeparator + filename, buffer);
+				pending_files.push_back(std::make_pair(path + GlobalAttributes::DirSeparator + filename, buffer));
 				buffer.clear();
 				shell_types.clear();
 			}
@@ -8349,9 +9319,13 @@ void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 								.arg(filename),
 								enum_cast(obj->getObjectType()));
 
-			UtilsNs::saveFile(path + GlobalAttributes::DirSeparator + filename, buffer);
+			pending_files.push_back(std::make_pair(path + GlobalAttributes::DirSeparator + filename, buffer));
 			buffer.clear();
 
+			//Flushing a batch of queued files to disk in parallel
+			if(pending_files.size() >= 128)
+				saveFilesAsync(pending_files);
+
 			/* If the current object is the database itself, we need to save the sessionopts
 			 * right before the saving of the database creation script */
 			if(obj == this)
@@ -8360,27 +9334,185 @@ void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 				attribs[Attributes::SearchPath] = sch_names.join(',');
 				attribs[Attributes::Function] = !functions.empty() ? Attributes::True : "";
 
-				filename = QString("%1_%2.sql")
-									 .arg(QString::number(idx++).rightJustified(pad_size, '0'))
-									 .arg(Attributes::SessionOpts);
+				filename = QString("%1_%2.sql")
+									 .arg(QString::number(idx++).rightJustified(pad_size, '0'))
+									 .arg(Attributes::SessionOpts);
+
+				emit s_objectLoaded((gen_defs_idx/static_cast<double>(general_obj_cnt)) * 100, tr("Saving session options file `%1'.").arg(filename),
+														enum_cast(ObjectType::Database));
+
+				buffer.append(schparser.getCodeDefinition(Attributes::SessionOpts, attribs, SchemaParser::SqlDefinition).toUtf8());
+				pending_files.push_back(std::make_pair(path + GlobalAttributes::DirSeparator + filename, buffer));
+				buffer.clear();
+			}
+		}
+
+		//Flushing the remaining queued files
+		saveFilesAsync(pending_files);
+
+		// Saving the prepended sql file
+		saveSplitCustomSQL(true, path, QString::number(idx).rightJustified(pad_size, '0'));
+		configureShellTypes(true);
+
+		/* Single end-of-run durability barrier: the files above are written without any
+		 * per-file flush, so the synchronization cost is paid only once for the whole run */
+		UtilsNs::syncFileSystem(path);
+	}
+	catch (Exception &e)
+	{
+		configureShellTypes(true);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+}
+
+void DatabaseModel::saveSplitModelDefinition(const QString &path)
+{
+	QFileInfo fi(path);
+	QDir dir(path);
+
+	if(fi.exists() && !fi.isDir())
+		throw Exception(Exception::getErrorMessage(ErrorCode::InvOutputDirectory).arg(path),
+										ErrorCode::InvOutputDirectory,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	if(!fi.exists())
+		QDir().mkpath(path);
+
+	try
+	{
+		QString xml_def=this->getCodeDefinition(SchemaParser::XmlDefinition);
+		QStringList manifest_lines;
+		std::set<QString> used_files;
+		vector<std::pair<QString, QByteArray>> pending_files;
+		QRegExp schema_regexp("<schema\\s+name=\"([^\"]+)\""),
+				name_regexp("\\sname=\"([^\"]+)\""),
+				name_fmt_regexp("(?!\\-)(\\W)");
+
+		/* Fragments are written only when their content differs from the file already on
+		 * disk, so incremental saves touch only the files of the objects really changed */
+		auto queue_fragment=[&](const QString &filename, const QByteArray &buf){
+			QString full_path=path + GlobalAttributes::DirSeparator + filename;
+			QFile existing(full_path);
+
+			if(existing.open(QFile::ReadOnly) && existing.readAll()==buf)
+				return;
+
+			pending_files.push_back(std::make_pair(full_path, buf));
+
+			//Flushing a batch of queued files to disk in parallel
+			if(pending_files.size() >= 128)
+				saveFilesAsync(pending_files);
+		};
+
+		XmlParser::streamXMLBuffer(xml_def.toUtf8(),
+		[&](attribs_map &root_attribs){
+			/* The root fragment holds an empty document carrying only the model attributes.
+			 * The object fragments are stitched back inside it when the directory is loaded */
+			QString root_buf=QString("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<dbmodel"), value;
+
+			for(auto &attr : root_attribs)
+			{
+				value=attr.second;
+				value.replace("&","&amp;").replace("<","&lt;").replace(">","&gt;").replace("\"","&quot;");
+				root_buf+=QString(" %1=\"%2\"").arg(attr.first).arg(value);
+			}
+
+			root_buf+=QString(">\n</dbmodel>\n");
+			queue_fragment(SplitModelRootFile, root_buf.toUtf8());
+		},
+		[&](const QString &elem_buf, const QString &elem_name, double){
+			QString schema, name, base, filename;
+			unsigned seq=1;
+
+			/* The schema a fragment belongs to is taken from the reduced schema element embedded
+			 * on the object's code (or from the element itself when it defines a schema), and is
+			 * recorded on the manifest to support the partial loading by schema */
+			if(schema_regexp.indexIn(elem_buf) >= 0)
+				schema=schema_regexp.cap(1);
+
+			if(name_regexp.indexIn(elem_buf) >= 0)
+				name=name_regexp.cap(1);
+
+			QStringList name_parts={ elem_name };
+
+			if(!schema.isEmpty() && schema!=name)
+				name_parts.append(schema);
+
+			if(!name.isEmpty())
+				name_parts.append(name);
+
+			base=name_parts.join(QChar('_'));
+			base.replace('"', "").replace(name_fmt_regexp, "_");
+			filename=base + QString(".xml");
+
+			//Disambiguating colliding names (e.g. overloaded functions)
+			while(used_files.count(filename))
+				filename=QString("%1_%2.xml").arg(base).arg(++seq);
+
+			used_files.insert(filename);
+			manifest_lines.append(schema.isEmpty() ? filename : filename + QChar('\t') + schema);
+			queue_fragment(filename, (elem_buf + QChar('\n')).toUtf8());
+		});
+
+		//Flushing the remaining queued files
+		saveFilesAsync(pending_files);
+
+		//The manifest defines the loading order of the fragments
+		UtilsNs::saveFileAtomic(path + GlobalAttributes::DirSeparator + SplitModelManifest,
+														(manifest_lines.join(QChar('\n')) + QChar('\n')).toUtf8());
+
+		//Removing stale fragments of objects that no longer exist on the model
+		used_files.insert(SplitModelRootFile);
+
+		for(auto &entry : dir.entryList({ QString("*.xml") }, QDir::Files))
+		{
+			if(!used_files.count(entry))
+				QFile::remove(path + GlobalAttributes::DirSeparator + entry);
+		}
+
+		/* Single end-of-run durability barrier for the fragments written above. The manifest
+		 * itself was already synced by the atomic write that replaced it */
+		UtilsNs::syncFileSystem(path);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+	}
+}
+
+void DatabaseModel::loadSplitModelDefinition(const QString &path, const QStringList &schemas)
+{
+	TraceLogger::Span trace_span("DatabaseModel::loadSplitModelDefinition");
 
-				emit s_objectLoaded((gen_defs_idx/static_cast<double>(general_obj_cnt)) * 100, tr("Saving session options file `%1'.").arg(filename),
-														enum_cast(ObjectType::Database));
+	try
+	{
+		QString root_buf=QString::fromUtf8(UtilsNs::loadFile(path + GlobalAttributes::DirSeparator + SplitModelRootFile)),
+				manifest=QString::fromUtf8(UtilsNs::loadFile(path + GlobalAttributes::DirSeparator + SplitModelManifest)),
+				xml_buf, filename, schema;
+		int root_end=root_buf.lastIndexOf(QString("</dbmodel>"));
 
-				buffer.append(schparser.getCodeDefinition(Attributes::SessionOpts, attribs, SchemaParser::SqlDefinition).toUtf8());
-				UtilsNs::saveFile( path + GlobalAttributes::DirSeparator + filename, buffer);
-				buffer.clear();
-			}
+		//The object fragments are stitched inside the root document fragment, in manifest order
+		xml_buf=root_buf.left(root_end < 0 ? root_buf.size() : root_end);
+
+		for(auto &line : manifest.split(QChar('\n'), QtCompat::SkipEmptyParts))
+		{
+			filename=line.section(QChar('\t'), 0, 0);
+			schema=line.section(QChar('\t'), 1, 1);
+
+			/* In partial mode only the fragments of the selected schemas plus the
+			 * schema-less/global ones are loaded */
+			if(!schemas.isEmpty() && !schema.isEmpty() && !schemas.contains(schema))
+				continue;
+
+			xml_buf+=QString::fromUtf8(UtilsNs::loadFile(path + GlobalAttributes::DirSeparator + filename));
+			xml_buf+=QChar('\n');
 		}
 
-		// Saving the prepended sql file
-		saveSplitCustomSQL(true, path, QString::number(idx).rightJustified(pad_size, '0'));
-		configureShellTypes(true);
+		xml_buf+=QString("</dbmodel>\n");
+		loadModelFromBuffer(xml_buf);
 	}
-	catch (Exception &e)
+	catch(Exception &e)
 	{
-		configureShellTypes(true);
-		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
@@ -8843,8 +9975,84 @@ void DatabaseModel::getTransformDependencies(BaseObject *object, vector<BaseObje
 	}
 }
 
+void DatabaseModel::partitionBySchema(vector<vector<BaseObject *>> &shards, vector<BaseObject *> &boundary_objs)
+{
+	map<BaseObject *, vector<BaseObject *>> schema_shards;
+	vector<BaseObject *> deps;
+	BaseObject *schema=nullptr, *dep_schema=nullptr;
+	bool crosses_schemas=false;
+
+	shards.clear();
+	boundary_objs.clear();
+
+	for(auto &type : BaseObject::getObjectTypes(false, { ObjectType::Database }))
+	{
+		for(auto &object : *getObjectList(type))
+		{
+			schema=object->getSchema();
+
+			//Objects that aren't owned by a schema always belong to the shared boundary set
+			if(!schema)
+			{
+				boundary_objs.push_back(object);
+				continue;
+			}
+
+			/* Objects with direct dependencies on other schemas are boundary objects too,
+			since processing them touches more than one shard */
+			crosses_schemas=false;
+			deps.clear();
+			getObjectDependecies(object, deps);
+
+			for(auto &dep : deps)
+			{
+				dep_schema=dep->getSchema();
+
+				if(dep!=object && dep_schema && dep_schema!=schema)
+				{
+					crosses_schemas=true;
+					break;
+				}
+			}
+
+			if(crosses_schemas)
+				boundary_objs.push_back(object);
+			else
+				schema_shards[schema].push_back(object);
+		}
+	}
+
+	//Shards and the boundary set expose their objects in creation order
+	auto id_comp=[](BaseObject *obj1, BaseObject *obj2){ return obj1->getObjectId() < obj2->getObjectId(); };
+
+	std::sort(boundary_objs.begin(), boundary_objs.end(), id_comp);
+
+	for(auto &itr : schema_shards)
+	{
+		std::sort(itr.second.begin(), itr.second.end(), id_comp);
+		shards.push_back(itr.second);
+	}
+}
+
 void DatabaseModel::getObjectDependecies(BaseObject *object, vector<BaseObject *> &deps, bool inc_indirect_deps)
 {
+	/* Top level calls (empty result list) are memoized: when the model hasn't changed since
+	 * the closure was computed the cached copy is returned right away. Recursive calls keep
+	 * accumulating in the caller's list and are not cached individually */
+	bool top_level_call=(object && deps.empty());
+
+	if(top_level_call)
+	{
+		QMutexLocker locker(&closure_cache_mtx);
+		auto cache_itr=dep_closure_cache.find(std::make_pair(object, inc_indirect_deps));
+
+		if(cache_itr!=dep_closure_cache.end())
+		{
+			deps=cache_itr->second;
+			return;
+		}
+	}
+
 	//Case the object is allocated and is not included in the dependecies list
 	if(object && std::find(deps.begin(), deps.end(), object)==deps.end())
 	{
@@ -8954,6 +10162,12 @@ void DatabaseModel::getObjectDependecies(BaseObject *object, vector<BaseObject *
 				getProcedureDependencies(object, deps, inc_indirect_deps);
 		}
 	}
+
+	if(top_level_call)
+	{
+		QMutexLocker locker(&closure_cache_mtx);
+		dep_closure_cache[std::make_pair(object, inc_indirect_deps)]=deps;
+	}
 }
 
 void DatabaseModel::getViewReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode)
@@ -10414,6 +11628,21 @@ void DatabaseModel::__getObjectReferences(BaseObject *object, vector<BaseObject
 	vector<BaseObject *> refs_aux;
 	vector<BaseObject *>::iterator end;
 
+	//Top level calls are memoized the same way as in getObjectDependecies()
+	bool top_level_call=(object && refs.empty());
+
+	if(top_level_call)
+	{
+		QMutexLocker locker(&closure_cache_mtx);
+		auto cache_itr=ref_closure_cache.find(std::make_pair(object, exclude_perms));
+
+		if(cache_itr!=ref_closure_cache.end())
+		{
+			refs=cache_itr->second;
+			return;
+		}
+	}
+
 	getObjectReferences(object, refs_aux, exclude_perms);
 
 	if(!refs_aux.empty())
@@ -10426,6 +11655,12 @@ void DatabaseModel::__getObjectReferences(BaseObject *object, vector<BaseObject
 		for(BaseObject *obj : refs_aux)
 			__getObjectReferences(obj, refs, exclude_perms);
 	}
+
+	if(top_level_call)
+	{
+		QMutexLocker locker(&closure_cache_mtx);
+		ref_closure_cache[std::make_pair(object, exclude_perms)]=refs;
+	}
 }
 
 void DatabaseModel::setObjectsModified(vector<BaseObject *> &objects)
@@ -10507,6 +11742,41 @@ void DatabaseModel::setCodesInvalidated(vector<ObjectType> types)
 	}
 }
 
+void DatabaseModel::setCodesInvalidated(BaseObject *object)
+{
+	vector<BaseObject *> stack, refs;
+	map<BaseObject *, bool> visited;
+	BaseObject *obj=nullptr;
+
+	if(!object)
+		return;
+
+	/* Traverses the dependency graph starting from the changed object so only it and
+	 * its transitive dependents have the cached code discarded */
+	stack.push_back(object);
+
+	while(!stack.empty())
+	{
+		obj=stack.back();
+		stack.pop_back();
+
+		if(visited.count(obj))
+			continue;
+
+		visited[obj]=true;
+		obj->setCodeInvalidated(true);
+
+		refs.clear();
+		getObjectReferences(obj, refs, false, true);
+
+		for(auto &ref : refs)
+		{
+			if(!visited.count(ref))
+				stack.push_back(ref);
+		}
+	}
+}
+
 BaseObject *DatabaseModel::getObjectPgSQLType(PgSqlType type)
 {
 	switch(type.getUserTypeConfig())
@@ -10718,7 +11988,7 @@ vector<BaseObject *> DatabaseModel::findObjects(const QString &pattern, vector<O
 	ObjectType obj_type;
 	QRegExp regexp;
 	BaseObject *object = nullptr;
-	attribs_map srch_attribs;
+	QString srch_value;
 
 	//Configuring the regex style
 	regexp.setPattern(pattern);
@@ -10784,16 +12054,37 @@ vector<BaseObject *> DatabaseModel::findObjects(const QString &pattern, vector<O
 		}
 	}
 
+	/* Removing duplicated entries from the searching list beforehand. This is needed so the
+	 parallel refreshing of search attributes below never touches the same object twice and
+	 it is harmless to the results since the final list is sorted/deduplicated by address */
+	std::sort(objs.begin(), objs.end());
+	objs.erase(std::unique(objs.begin(), objs.end()), objs.end());
+
+	/* Refreshing the outdated search attributes in parallel. Building the attributes
+	 (specially the formatted signature) is the most expensive step of the search, so on
+	 big models it is spread over all cores while the matching itself stays sequential */
+	if(objs.size() > 500 && QThread::idealThreadCount() > 1)
+	{
+		QtConcurrent::blockingMap(objs, [](BaseObject *obj){
+			if(!obj->isSearchAttribsUpdated())
+				obj->configureSearchAttributes();
+		});
+	}
+
 	//Try to find  the objects on the configured list
 	while(!objs.empty())
 	{
 		object = objs.back();
-		object->configureSearchAttributes();
-		srch_attribs = object->getSearchAttributes();
 
-		if((exact_match && pattern == srch_attribs[search_attr]) ||
-			 (exact_match && regexp.exactMatch(srch_attribs[search_attr])) ||
-			 (!exact_match && regexp.indexIn(srch_attribs[search_attr]) >= 0))
+		//Rebuilding the search attributes only when they are outdated
+		if(!object->isSearchAttribsUpdated())
+			object->configureSearchAttributes();
+
+		srch_value = object->getSearchAttribute(search_attr);
+
+		if((exact_match && pattern == srch_value) ||
+			 (exact_match && regexp.exactMatch(srch_value)) ||
+			 (!exact_match && regexp.indexIn(srch_value) >= 0))
 			list.push_back(object);
 
 		objs.pop_back();
@@ -10807,9 +12098,19 @@ vector<BaseObject *> DatabaseModel::findObjects(const QString &pattern, vector<O
 	return list;
 }
 
+void DatabaseModel::invalidateClosureCaches()
+{
+	QMutexLocker locker(&closure_cache_mtx);
+	dep_closure_cache.clear();
+	ref_closure_cache.clear();
+}
+
 void DatabaseModel::setInvalidated(bool value)
 {
 	this->invalidated=value;
+
+	if(value)
+		invalidateClosureCaches();
 }
 
 bool DatabaseModel::isInvalidated()
@@ -11264,7 +12565,12 @@ void DatabaseModel::loadObjectsMetadata(const QString &filename, unsigned option
 	BaseRelationship *rel=nullptr;
 	Schema *schema=nullptr;
 	Tag *tag=nullptr;
+	BaseGraphicObject *graph_obj=nullptr;
+	vector<BaseObject *> changed_objs, aux_objs;
+	QStringList layer_ids;
+	QPointF cur_pnt;
 	int progress=0;
+	bool obj_changed=false;
 	bool load_db_attribs=false, load_objs_pos=false, load_objs_prot=false,
 			load_objs_sqldis=false, load_textboxes=false, load_tags=false,
 			load_custom_sql=false, load_custom_colors=false, load_fadeout=false,
@@ -11423,27 +12729,40 @@ void DatabaseModel::loadObjectsMetadata(const QString &filename, unsigned option
 							emit s_objectLoaded(progress, tr("Loading metadata for object `%1' (%2)")
 																	.arg(object->getName()).arg(object->getTypeName()), enum_cast(obj_type));
 
+							/* Entries that match the current state of the object are treated as no-ops and
+							 * skipped below so they don't flag the object for a redundant scene update */
+							obj_changed=false;
+
 							if(!object->isSystemObject() &&
 								 ((!attribs[Attributes::Protected].isEmpty() && load_objs_prot) ||
 									(!attribs[Attributes::SqlDisabled].isEmpty() && load_objs_sqldis)))
 							{
-								if(!attribs[Attributes::Protected].isEmpty())
+								if(!attribs[Attributes::Protected].isEmpty() &&
+									 object->isProtected()!=(attribs[Attributes::Protected]==Attributes::True))
 									object->setProtected(attribs[Attributes::Protected]==Attributes::True);
 
-								if(!attribs[Attributes::SqlDisabled].isEmpty())
+								if(!attribs[Attributes::SqlDisabled].isEmpty() &&
+									 object->isSQLDisabled()!=(attribs[Attributes::SqlDisabled]==Attributes::True))
 									object->setSQLDisabled(attribs[Attributes::SqlDisabled]==Attributes::True);
 							}
 							else if(BaseTable::isBaseTable(obj_type) && load_tags && !attribs[Attributes::Tag].isEmpty())
 							{
 								tag=getTag(attribs[Attributes::Tag]);
 
-								if(tag)
+								if(tag && dynamic_cast<BaseTable *>(object)->getTag()!=tag)
+								{
 									dynamic_cast<BaseTable *>(object)->setTag(tag);
+									obj_changed=true;
+								}
 							}
 							else if((BaseTable::isBaseTable(obj_type) || obj_type == ObjectType::Textbox) &&
 											load_objs_z_value && !attribs[Attributes::ZValue].isEmpty())
 							{
-								dynamic_cast<BaseTable *>(object)->setZValue(attribs[Attributes::ZValue].toInt());
+								if(dynamic_cast<BaseTable *>(object)->getZValue()!=attribs[Attributes::ZValue].toInt())
+								{
+									dynamic_cast<BaseTable *>(object)->setZValue(attribs[Attributes::ZValue].toInt());
+									obj_changed=true;
+								}
 							}
 							else if(obj_type==ObjectType::Database && load_custom_sql)
 							{
@@ -11454,11 +12773,27 @@ void DatabaseModel::loadObjectsMetadata(const QString &filename, unsigned option
 									this->setPrependAtBOD(attribs[Attributes::PrependAtBod]==Attributes::True);
 							}
 
-							if(load_objs_aliases && !attribs[Attributes::Alias].isEmpty())
+							if(load_objs_aliases && !attribs[Attributes::Alias].isEmpty() &&
+								 object->getAlias()!=attribs[Attributes::Alias])
+							{
 								object->setAlias(attribs[Attributes::Alias]);
+								obj_changed=true;
+							}
 
 							if(load_objs_layers_cfg && BaseGraphicObject::isGraphicObject(obj_type) && !attribs[Attributes::Layers].isEmpty())
-								dynamic_cast<BaseGraphicObject *>(object)->setLayers(attribs[Attributes::Layers].split(',', QtCompat::SkipEmptyParts));
+							{
+								graph_obj=dynamic_cast<BaseGraphicObject *>(object);
+								layer_ids.clear();
+
+								for(auto &layer_id : graph_obj->getLayers())
+									layer_ids.append(QString::number(layer_id));
+
+								if(layer_ids.join(',')!=attribs[Attributes::Layers])
+								{
+									graph_obj->setLayers(attribs[Attributes::Layers].split(',', QtCompat::SkipEmptyParts));
+									obj_changed=true;
+								}
+							}
 
 							if(xmlparser.accessElement(XmlParser::ChildElement))
 							{
@@ -11514,46 +12849,85 @@ void DatabaseModel::loadObjectsMetadata(const QString &filename, unsigned option
 								rel=dynamic_cast<BaseRelationship *>(object);
 								schema=dynamic_cast<Schema *>(object);
 
-								if(!rel && !schema && !points.empty() && load_objs_pos)
+								if(!rel && !schema && !points.empty() && load_objs_pos &&
+									 dynamic_cast<BaseGraphicObject *>(object)->getPosition()!=points[0])
+								{
 									dynamic_cast<BaseGraphicObject *>(object)->setPosition(points[0]);
+									obj_changed=true;
+								}
 								else if(rel)
 								{
 									if(load_custom_colors)
 									{
-										if(attribs[Attributes::CustomColor]==Attributes::None)
-											rel->setCustomColor(Qt::transparent);
-										else
-											rel->setCustomColor(QColor(attribs[Attributes::CustomColor]));
+										QColor color=(attribs[Attributes::CustomColor]==Attributes::None ?
+																		QColor(Qt::transparent) : QColor(attribs[Attributes::CustomColor]));
+
+										if(rel->getCustomColor()!=color)
+										{
+											rel->setCustomColor(color);
+											obj_changed=true;
+										}
 									}
 
 									if(load_objs_pos)
 									{
-										rel->setPoints(points);
+										if(rel->getPoints()!=points)
+										{
+											rel->setPoints(points);
+											obj_changed=true;
+										}
 
 										for(unsigned id=BaseRelationship::SrcCardLabel; id <= BaseRelationship::RelNameLabel; id++)
 										{
-											rel->setLabelDistance(id, labels_pos[id]);
+											cur_pnt=rel->getLabelDistance(id);
+
+											/* NaN distances denote an automatically positioned label so a pair
+											 * of them on both sides makes the entry a no-op */
+											if(cur_pnt!=labels_pos[id] &&
+												 (!std::isnan(cur_pnt.x()) || !std::isnan(labels_pos[id].x())))
+											{
+												rel->setLabelDistance(id, labels_pos[id]);
+												obj_changed=true;
+											}
+
 											labels_pos[id]=QPointF(DNaN, DNaN);
 										}
 									}
 								}
 								else if(schema)
 								{
-									if(load_custom_colors)
+									if(load_custom_colors && schema->getFillColor()!=QColor(attribs[Attributes::CustomColor]))
+									{
 										schema->setFillColor(QColor(attribs[Attributes::CustomColor]));
+										obj_changed=true;
+									}
 
-									schema->setRectVisible(attribs[Attributes::RectVisible]==Attributes::True);
+									if(schema->isRectVisible()!=(attribs[Attributes::RectVisible]==Attributes::True))
+									{
+										schema->setRectVisible(attribs[Attributes::RectVisible]==Attributes::True);
+										obj_changed=true;
+									}
 								}
 
-								if(load_fadeout)
+								if(load_fadeout &&
+									 dynamic_cast<BaseGraphicObject *>(object)->isFadedOut()!=(attribs[Attributes::FadedOut]==Attributes::True))
+								{
 									dynamic_cast<BaseGraphicObject *>(object)->setFadedOut(attribs[Attributes::FadedOut]==Attributes::True);
+									obj_changed=true;
+								}
 
-								if(load_collapse_mode && base_tab)
+								if(load_collapse_mode && base_tab &&
+									 base_tab->getCollapseMode()!=static_cast<CollapseMode>(attribs[Attributes::CollapseMode].toUInt()))
+								{
 									base_tab->setCollapseMode(static_cast<CollapseMode>(attribs[Attributes::CollapseMode].toUInt()));
+									obj_changed=true;
+								}
 							}
 
 							points.clear();
 
+							if(obj_changed)
+								changed_objs.push_back(object);
 						}
 						else if(!object)
 						{
@@ -11570,7 +12944,45 @@ void DatabaseModel::loadObjectsMetadata(const QString &filename, unsigned option
 		}
 
 		emit s_objectLoaded(100, tr("Metadata file successfully loaded!"), enum_cast(ObjectType::BaseObject));
-		setObjectsModified();
+
+		/* Only the objects effectively changed by the metadata are flagged for redraw instead of
+		 * invalidating the whole scene. The relationships, labels and schemas attached to them are
+		 * included since their lines and rectangles must be rearranged to follow the new layout */
+		for(auto &obj : changed_objs)
+		{
+			base_tab=dynamic_cast<BaseTable *>(obj);
+			rel=dynamic_cast<BaseRelationship *>(obj);
+
+			if(base_tab)
+			{
+				for(auto &base_rel : getRelationships(base_tab))
+				{
+					aux_objs.push_back(base_rel);
+
+					for(unsigned id=BaseRelationship::SrcCardLabel; id <= BaseRelationship::RelNameLabel; id++)
+					{
+						if(base_rel->getLabel(id))
+							aux_objs.push_back(base_rel->getLabel(id));
+					}
+				}
+
+				if(base_tab->getSchema())
+					aux_objs.push_back(base_tab->getSchema());
+			}
+			else if(rel)
+			{
+				for(unsigned id=BaseRelationship::SrcCardLabel; id <= BaseRelationship::RelNameLabel; id++)
+				{
+					if(rel->getLabel(id))
+						aux_objs.push_back(rel->getLabel(id));
+				}
+			}
+		}
+
+		changed_objs.insert(changed_objs.end(), aux_objs.begin(), aux_objs.end());
+		std::sort(changed_objs.begin(), changed_objs.end());
+		changed_objs.erase(std::unique(changed_objs.begin(), changed_objs.end()), changed_objs.end());
+		setObjectsModified(changed_objs);
 	}
 	catch(Exception &e)
 	{
@@ -11907,11 +13319,9 @@ TableClass *DatabaseModel::createPhysicalTable()
 
 void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, bool split)
 {
-	int idx = 0;
-	BaseObject *object = nullptr;
 	vector<BaseObject *> objects;
 	map<QString, BaseObject *> objs_map;
-	QString styles, id, index, items, buffer;
+	QString styles, id, index;
 	attribs_map attribs, aux_attribs;
 	QStringList index_list;
 	QString dict_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, GlobalAttributes::DataDictSchemaDir),
@@ -11960,25 +13370,66 @@ void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, boo
 		// Otherwise we create a separated stylesheet file
 		datadict[Attributes::Styles + QString(".css")] = styles;
 
-	// Generating individual data dictionaries
-	for(auto &itr : objs_map)
-	{
-		object = itr.second;
+	/* The per-table dictionaries are independent from each other, so they are produced over
+	 * worker threads (the same scheme used by saveSplitDataDictionary()) and assembled below
+	 * in alphabetical order. Each worker uses its own parser instance and touches only the
+	 * attributes of its own table */
+	int page_cnt = index_list.size();
+	vector<int> positions;
+	vector<QString> obj_dicts(page_cnt);
+	QMutex err_mtx;
+	vector<Exception> errors;
+
+	for(int pos = 0; pos < page_cnt; pos++)
+		positions.push_back(pos);
+
+	QtConcurrent::blockingMap(positions, [&](int pos){
+		try
+		{
+			attribs_map page_attribs, aux_attribs;
+			SchemaParser parser;
+
+			aux_attribs[Attributes::Index] = browsable ? Attributes::True : "";
+			aux_attribs[Attributes::Previous] = pos - 1 >= 0 ? index_list.at(pos - 1) : "";
+			aux_attribs[Attributes::Next] = pos + 1 <= page_cnt - 1 ? index_list.at(pos + 1) : "";
+
+			obj_dicts[pos] = dynamic_cast<BaseTable *>(objs_map.at(index_list.at(pos)))->getDataDictionary(split, aux_attribs);
+
+			// If the generation is configured to be splitted we generate a complete HTML file for the current table
+			if(split && !obj_dicts[pos].isEmpty())
+			{
+				page_attribs[Attributes::Styles] = "";
+				page_attribs[Attributes::Index] = "";
+				page_attribs[Attributes::Split] = Attributes::True;
+				page_attribs[Attributes::Year] = QString::number(QDate::currentDate().year());
+				page_attribs[Attributes::Objects] = obj_dicts[pos];
+
+				parser.ignoreEmptyAttributes(true);
+				obj_dicts[pos] = parser.getCodeDefinition(dict_sch_file, page_attribs);
+			}
+		}
+		catch(Exception &e)
+		{
+			QMutexLocker locker(&err_mtx);
+			errors.push_back(e);
+		}
+	});
 
-		// Generate the individual data dictionaries
-		aux_attribs[Attributes::Index] = browsable ? Attributes::True : "";
-		aux_attribs[Attributes::Previous] = idx - 1 >= 0 ? index_list.at(idx - 1) : "";
-		aux_attribs[Attributes::Next] = (++idx <= index_list.size() - 1) ? index_list.at(idx) : "";
-		attribs[Attributes::Objects] += dynamic_cast<BaseTable *>(object)->getDataDictionary(split, aux_attribs);
+	if(!errors.empty())
+		throw Exception(errors[0].getErrorMessage(), errors[0].getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &errors[0]);
 
-		// If the generation is configured to be splitted we generate a complete HTML file for the current table
-		if(split && !attribs[Attributes::Objects].isEmpty())
+	for(int pos = 0; pos < page_cnt; pos++)
+	{
+		if(split)
 		{
-			id = itr.first + QString(".html");
-			schparser.ignoreEmptyAttributes(true);			
-			datadict[id] = schparser.getCodeDefinition(dict_sch_file, attribs);
-			attribs[Attributes::Objects].clear();
+			if(obj_dicts[pos].isEmpty())
+				continue;
+
+			id = index_list.at(pos) + QString(".html");
+			datadict[id] = obj_dicts[pos];
 		}
+		else
+			attribs[Attributes::Objects] += obj_dicts[pos];
 	}
 
 	// If the data dictionary is browsable we proceed with the index generation
@@ -12017,6 +13468,140 @@ void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, boo
 	}
 }
 
+void DatabaseModel::saveSplitDataDictionary(const QString &path, bool browsable)
+{
+	BaseObject *object = nullptr;
+	vector<BaseObject *> objects;
+	map<QString, BaseObject *> objs_map;
+	QString id, index, styles;
+	QStringList index_list;
+	QMutex err_mtx;
+	vector<Exception> errors;
+	vector<std::pair<QString, QByteArray>> pending_files;
+	QString dict_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, GlobalAttributes::DataDictSchemaDir),
+			style_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Styles),
+			item_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Item),
+			index_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Index);
+
+	objects.assign(tables.begin(), tables.end());
+	objects.insert(objects.end(), foreign_tables.begin(), foreign_tables.end());
+	objects.insert(objects.end(), views.begin(), views.end());
+	objects.insert(objects.end(), relationships.begin(), relationships.end());
+
+	// Placing the objects in alphabectical order
+	for(auto &obj : objects)
+	{
+		// Retrieving the generated table if the current object is a relationship (n-n)
+		if(obj->getObjectType() == ObjectType::Relationship)
+		{
+			Relationship *rel = dynamic_cast<Relationship *>(obj);
+
+			if(!rel->getGeneratedTable())
+				continue;
+
+			obj = rel->getGeneratedTable();
+		}
+
+		id = obj->getSignature().remove(QChar('"'));
+		objs_map[id] = obj;
+		index_list.push_back(id);
+	}
+
+	index_list.sort();
+
+	// The stylesheet always goes into a separated file in split mode
+	attribs_map style_attribs;
+	styles = schparser.getCodeDefinition(style_sch_file, style_attribs);
+	pending_files.push_back(std::make_pair(path + GlobalAttributes::DirSeparator + Attributes::Styles + QString(".css"), styles.toUtf8()));
+
+	/* Generating the per-table pages over the worker threads. Each page is independent and
+	 each worker uses its own parser instances, so the pages can be produced concurrently
+	 and written as soon as a batch is ready, without accumulating the whole dictionary */
+	int page_cnt = index_list.size(), flushed = 0;
+	vector<int> positions;
+	vector<QString> pages(page_cnt);
+
+	for(int pos = 0; pos < page_cnt; pos++)
+		positions.push_back(pos);
+
+	QtConcurrent::blockingMap(positions, [&](int pos){
+		try
+		{
+			attribs_map attribs, aux_attribs;
+			SchemaParser parser;
+
+			aux_attribs[Attributes::Index] = browsable ? Attributes::True : "";
+			aux_attribs[Attributes::Previous] = pos - 1 >= 0 ? index_list.at(pos - 1) : "";
+			aux_attribs[Attributes::Next] = pos + 1 <= page_cnt - 1 ? index_list.at(pos + 1) : "";
+
+			attribs[Attributes::Styles] = "";
+			attribs[Attributes::Index] = "";
+			attribs[Attributes::Split] = Attributes::True;
+			attribs[Attributes::Year] = QString::number(QDate::currentDate().year());
+			attribs[Attributes::Objects] = dynamic_cast<BaseTable *>(objs_map.at(index_list.at(pos)))->getDataDictionary(true, aux_attribs);
+
+			parser.ignoreEmptyAttributes(true);
+			pages[pos] = parser.getCodeDefinition(dict_sch_file, attribs);
+		}
+		catch(Exception &e)
+		{
+			QMutexLocker locker(&err_mtx);
+			errors.push_back(e);
+		}
+	});
+
+	if(!errors.empty())
+		throw Exception(errors[0].getErrorMessage(), errors[0].getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &errors[0]);
+
+	for(int pos = 0; pos < page_cnt; pos++)
+	{
+		if(cancel_saving)
+			return;
+
+		object = objs_map.at(index_list.at(pos));
+		pending_files.push_back(std::make_pair(path + GlobalAttributes::DirSeparator + index_list.at(pos) + QString(".html"),
+																					 pages[pos].toUtf8()));
+		pages[pos].clear();
+		flushed++;
+
+		emit s_objectLoaded((flushed/static_cast<double>(page_cnt)) * 100,
+							tr("Saving data dictionary of `%1' (%2).").arg(object->getName()).arg(object->getTypeName()),
+							enum_cast(object->getObjectType()));
+
+		//Flushing a batch of queued pages to disk in parallel
+		if(pending_files.size() >= 128)
+			saveFilesAsync(pending_files);
+	}
+
+	// If the data dictionary is browsable we proceed with the index generation
+	if(browsable)
+	{
+		attribs_map idx_attribs, aux_attribs;
+
+		idx_attribs[BaseObject::getSchemaName(ObjectType::Table)] = "";
+		idx_attribs[BaseObject::getSchemaName(ObjectType::View)] = "";
+		idx_attribs[BaseObject::getSchemaName(ObjectType::ForeignTable)] = "";
+		idx_attribs[Attributes::Year] = QString::number(QDate::currentDate().year());
+
+		// Generating the index items
+		for(auto &item : index_list)
+		{
+			aux_attribs[Attributes::Split] = Attributes::True;
+			aux_attribs[Attributes::Item] = item;
+			idx_attribs[objs_map[item]->getSchemaName()] += schparser.getCodeDefinition(item_sch_file, aux_attribs);
+		}
+
+		idx_attribs[Attributes::Name] = this->obj_name;
+		idx_attribs[Attributes::Split] = Attributes::True;
+		schparser.ignoreEmptyAttributes(true);
+		index = schparser.getCodeDefinition(index_sch_file, idx_attribs);
+		pending_files.push_back(std::make_pair(path + GlobalAttributes::DirSeparator + Attributes::Index + QString(".html"), index.toUtf8()));
+	}
+
+	//Flushing the remaining queued pages
+	saveFilesAsync(pending_files);
+}
+
 void DatabaseModel::saveDataDictionary(const QString &path, bool browsable, bool split)
 {
 	try
@@ -12035,6 +13620,12 @@ void DatabaseModel::saveDataDictionary(const QString &path, bool browsable, bool
 
 			if(!finfo.exists())
 				dir.mkpath(path);
+
+			/* In split mode the pages are generated in parallel and written as they become
+			 * ready instead of being accumulated in memory */
+			cancel_saving = false;
+			saveSplitDataDictionary(path, browsable);
+			return;
 		}
 
 		getDataDictionary(datadict, browsable, split);
@@ -12042,9 +13633,6 @@ void DatabaseModel::saveDataDictionary(const QString &path, bool browsable, bool
 
 		for(auto &itr : datadict)
 		{
-			if(split)
-				filename = path + GlobalAttributes::DirSeparator + itr.first;
-
 			buffer.append(itr.second.toUtf8());
 			UtilsNs::saveFile(filename, buffer);
 			buffer.clear();
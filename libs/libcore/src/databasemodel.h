@@ -31,6 +31,11 @@ Additionally, this class, saves, loads and generates the XML/SQL definition of a
 #include <QObject>
 #include <QStringList>
 #include <QDateTime>
+#include <QHash>
+#include <QReadWriteLock>
+#include <QMutex>
+#include <functional>
+#include "taskscheduler.h"
 #include "baseobject.h"
 #include "table.h"
 #include "function.h"
@@ -79,6 +84,46 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 * to return the list according to the provided type */
 		map<ObjectType, vector<BaseObject *> *> obj_lists;
 
+		/*! \brief Signature lookup indexes (signature -> object) used to avoid linear scans over the
+		 object lists in getObject(). The indexes are built lazily per object type (see
+		 rebuildSignatureIndex()) and kept in sync by __addObject()/__removeObject(). Renames of
+		 objects attached to the model are detected through BaseObject::getSignatureChangeCount() */
+		map<ObjectType, QHash<QString, BaseObject *>> obj_sig_index;
+
+		//! \brief Object types whose signature index is currently up-to-date
+		map<ObjectType, bool> obj_sig_idx_valid;
+
+		//! \brief Value of BaseObject::getSignatureChangeCount() by the time the indexes were built
+		unsigned sig_change_count;
+
+		/*! \brief Indexes the permissions by the object they are granting privileges upon. This avoids
+		 scanning the whole permissions list in getPermissions()/getPermissionIndex() on models holding
+		 thousands of grants. The index is keyed by plain pointers since a permission's target object
+		 is fixed at construction, being kept in sync by addPermission(), removePermissions() and
+		 __removeObject() */
+		map<BaseObject *, vector<Permission *>> perm_index;
+
+		/*! \brief Memoized transitive closures computed by getObjectDependecies() and
+		 __getObjectReferences(), keyed by the queried object and the method's boolean flag
+		 (inc_indirect_deps / exclude_perms respectively). The caches are dropped as a whole
+		 whenever the model changes (see invalidateClosureCaches()) so repeated closure queries
+		 over an unchanged model cost O(result) instead of a full graph traversal */
+		map<std::pair<BaseObject *, bool>, vector<BaseObject *>> dep_closure_cache, ref_closure_cache;
+
+		/*! \brief Guards the model structure for the concurrent read contract (see
+		 lockForConcurrentRead()). The structural mutation choke points (__addObject()/
+		 __removeObject()) acquire it for writing while reader threads acquire it for reading,
+		 so readers never observe a half-updated object list or lookup index */
+		mutable QReadWriteLock model_rw_lock;
+
+		/*! \brief Serializes the accesses to the memoized dependency/reference closures so
+		 they stay consistent when several reader threads query the model at once */
+		mutable QMutex closure_cache_mtx;
+
+		/*! \brief Discards the memoized dependency/reference closures. Called whenever objects are
+		 added to or removed from the model as well when the model is flagged as invalidated */
+		void invalidateClosureCaches();
+
 		static unsigned dbmodel_id;
 
 		//! \brief Constants used to access the tuple columns in the internal changelog
@@ -138,6 +183,12 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 *  This is only used by the export helper to cancel a running export to file process */
 		cancel_saving;
 
+		/*! \brief Cancellation token propagated to the model's schema parser by
+		 getCodeDefinition() so even a single long template evaluation (the final
+		 database-level one can span megabytes of attributes) reacts to setCancelSaving()
+		 with bounded latency */
+		TaskScheduler::CancelToken codegen_cancel_token;
+
 		//! \brief Vectors that stores all the objects types
 		vector<BaseObject *> textboxes,
 		relationships,
@@ -190,7 +241,12 @@ class DatabaseModel:  public QObject, public BaseObject {
 		append_at_eod,
 
 		//! \brief Indicates that prepended SQL commands must be put at the very beginning of model definition
-		prepend_at_bod;
+		prepend_at_bod,
+
+		/*! \brief Indicates that a batch insertion is in progress (see addObjects()). While set,
+		__addObject() skips the per-object code validation and signal emission, which are handled
+		in an aggregated fashion by the batch insertion itself */
+		bulk_insertion;
 
 		//! \brief Stores the last position on the model where the user was editing objects
 		QPoint last_pos;
@@ -237,6 +293,68 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Set the initial capacity of the objects list for a optimized memory usage
 		void setObjectListsCapacity(unsigned capacity);
 
+		/*! \brief Rebuilds the signature lookup index of the specified object type from the
+		 * related object list. In case of duplicated signatures the first object in the list
+		 * prevails, reproducing the behavior of the former linear scan */
+		void rebuildSignatureIndex(ObjectType obj_type);
+
+		/*! \brief Configures the model's basic attributes from the attribute set extracted from the
+		 * root element of a dbm document (see loadModel()). The maps def_objs/protected_model receive
+		 * the default objects names and the protection flag to be applied after all objects are loaded */
+		void configureModelAttributes(attribs_map &attribs, map<ObjectType, QString> &def_objs, bool &protected_model);
+
+		/*! \brief Creates and configures a single model object assuming that the xmlparser is positioned
+		 * on a second level element of a dbm document (changelog, database or any other model object).
+		 * The flag found_inh_rel is set when an inheritance relationship is created so loadModel() can
+		 * perform an additional relationship validation. The progress value is emitted through s_objectLoaded */
+		void loadModelElement(bool &found_inh_rel, double progress);
+
+		//! \brief Indicates whether loadModel() must read files in streaming mode (see setStreamLoadingEnabled())
+		static bool stream_loading_enabled;
+
+		//! \brief Indicates whether getCodeDefinition() must pre-generate SQL code in parallel (see setParallelCodeGeneration())
+		static bool parallel_code_gen;
+
+		//! \brief Indicates whether load/save operations must use the binary cache sidecar (see setModelCacheEnabled())
+		static bool model_cache_enabled;
+
+		//! \brief Magic token that identifies the binary cache sidecar files (see saveModelCache())
+		static const QByteArray ModelCacheMagic;
+
+		//! \brief Current version of the binary cache sidecar format
+		static const quint32 ModelCacheVersion;
+
+		//! \brief Returns the path of the binary cache sidecar related to the provided model file
+		static QString getModelCacheFilename(const QString &filename);
+
+		/*! \brief Writes the binary cache sidecar of the model file. The sidecar stores the format version,
+		 * the checksum of the xml definition and the xml itself in compressed form. The file_buf parameter
+		 * holds the bytes actually written to the model file when they differ from the xml (compressed
+		 * models), since the staleness checksum is computed over the file contents. Failures here are
+		 * silently ignored since the cache is a best-effort optimization */
+		static void saveModelCache(const QString &filename, const QByteArray &xml_buf, const QByteArray &file_buf=QByteArray());
+
+		/*! \brief Returns the xml definition stored in the binary cache sidecar of the provided model file.
+		 * An empty buffer is returned when the sidecar is missing, has an incompatible version or its
+		 * checksum doesn't match the current contents of the model file (meaning the xml was modified
+		 * by other means and the cache is stale) */
+		static QByteArray loadModelCache(const QString &filename);
+
+		//! \brief Magic bytes that prefix compressed database model (dbmz) files
+		static const QByteArray CompressedModelMagic;
+
+		/*! \brief Returns true when the provided file starts with CompressedModelMagic, meaning it holds
+		 * a compressed model definition no matter its extension */
+		static bool isCompressedModelFile(const QString &filename);
+
+		/*! \brief Pre-generates, using all the available CPU cores, the SQL or XML code of the objects in the provided
+		 * creation order map. Objects are grouped so that a table and its children are always processed by the same thread,
+		 * this way the code cache of each object is populated without race conditions. In xml mode the reduced definitions
+		 * of shared objects (schemas, roles, and alike) are generated serially upfront since they are embedded in the code
+		 * of the objects referencing them. After this call getCodeDefinition() reuses the cached code while stitching the
+		 * definitions in creation order */
+		void generateCodeInParallel(map<unsigned, BaseObject *> &objects_map, unsigned def_type);
+
 		void getViewReferences(BaseObject *object, vector<BaseObject *> &refs, bool exclusion_mode);
 		void getPhysicalTableReferences(BaseObject *object, vector<BaseObject *> &refs, bool &refer, bool exclusion_mode);
 		void getFunctionReferences(BaseObject *object, vector<BaseObject *> &refs, bool &refer, bool exclusion_mode);
@@ -287,6 +405,16 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 * to the filename. Returns true when the file could be saved. */
 		bool saveSplitCustomSQL(bool save_appended, const QString &path, const QString &file_prefix);
 
+		/*! \brief Writes the provided filename/contents pairs to disk, spreading the writes over
+		 worker threads when there is more than one file and multiple cores available. The list is
+		 cleared upon return. Raises an exception if the writing of any file fails */
+		void saveFilesAsync(vector<std::pair<QString, QByteArray>> &files);
+
+		/*! \brief Streaming counterpart of getDataDictionary()/saveDataDictionary() for the split
+		 mode. Per-table pages are generated over worker threads and written to the output path in
+		 batches as they become ready instead of accumulating the whole dictionary in memory */
+		void saveSplitDataDictionary(const QString &path, bool browsable);
+
 	protected:
 		//! \brief Set the layer names (only to be written in the XML definition)
 		void setLayers(const QStringList &layers);
@@ -357,9 +485,42 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Returns the complete object list according to the type
 		vector<BaseObject *> *getObjectList(ObjectType obj_type);
 
+		/*! \brief Prepares the model to be read from multiple threads at once by materializing
+		 every lazily built lookup structure (currently the signature indexes), so reader threads
+		 never trigger an index rebuild — a mutation — while holding the shared lock. Must be
+		 called from the thread that owns the model before the reader threads are spawned */
+		void prepareForConcurrentReads();
+
+		/*! \brief Acquires the model's shared read lock. Concurrent read contract: once
+		 prepareForConcurrentReads() was called, any number of threads may hold the read lock
+		 and use the lookup/traversal API concurrently — getObject(), getObjectIndex(),
+		 getObjectList(), getObjectCount(), getObjects(), getPermissions(),
+		 getObjectDependecies() and getObjectReferences() — without cloning the model or
+		 serializing the accesses externally: structural mutations block on the write lock taken
+		 by __addObject()/__removeObject() until every reader releases the shared lock. Two
+		 caveats bound the contract: (1) renaming an object (or otherwise changing its
+		 signature) invalidates the prepared indexes and must not happen while readers are
+		 active; (2) methods that fill per-object code caches (the objects' getCodeDefinition())
+		 are only safe when each object is visited by a single thread, the way the parallel
+		 code generation partitions them */
+		void lockForConcurrentRead();
+
+		//! \brief Releases the model's shared read lock
+		void unlockConcurrentRead();
+
 		//! \brief Disconnects all the relationships in a ordered way
 		void disconnectRelationships();
 
+		/*! \brief Disconnects, in a ordered way, only the relationships present in the provided list.
+		 Relationships outside the list stay connected and keep their propagated columns untouched */
+		void disconnectRelationships(const vector<BaseObject *> &rels);
+
+		/*! \brief Returns the minimal set of table-table relationships affected by the invalidated ones.
+		 Since column propagation flows through the linked tables the affected set is the transitive
+		 closure of the invalidated relationships over shared tables (including tables generated by n-n
+		 relationships). Relationships outside the returned set needn't be revalidated */
+		vector<BaseObject *> getAffectedRelationships(const vector<BaseObject *> &inv_rels);
+
 		/*! \brief Detects and stores the XML for special objects (that is referencing columns created
 		 by relationship) in order to be reconstructed in a posterior moment */
 		void storeSpecialObjectsXML();
@@ -386,6 +547,13 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Adds an object to the model
 		void addObject(BaseObject *object, int obj_idx=-1);
 
+		/*! \brief Adds a batch of pre-validated objects to the model. Unlike repeated addObject() calls,
+		 the per-object code validation is skipped (the caller is responsible for passing consistent
+		 objects, e.g. the ones created from a xml/database import) and the individual s_objectAdded()
+		 notifications are replaced by a single s_objectsAdded() emitted when the whole batch lands.
+		 The model is flagged as invalidated only once at the end of the insertion. */
+		void addObjects(const vector<BaseObject *> &objects);
+
 		//! \brief Removes an object from the model
 		void removeObject(BaseObject *object, int obj_idx=-1);
 
@@ -397,6 +565,48 @@ class DatabaseModel:  public QObject, public BaseObject {
 		destroyObjects() or delete the entire model */
 		void loadModel(const QString &filename);
 
+		/*! \brief Loads the database model from a xml buffer produced by captureSnapshot() (or read from a
+		 * dbm file). Since the buffer comes straight from the code generator no DTD validation is performed.
+		 * The error handling is the same of loadModel() */
+		void loadModelFromBuffer(const QString &xml_buf);
+
+		/*! \brief Captures a consistent snapshot of the model in its xml form. The model is exclusively locked
+		 * only while the xml is being generated, so once this method returns the user can keep editing the
+		 * model while a background operation consumes the snapshot through materializeSnapshot(). This bounds
+		 * the editing lockout to the serialization window instead of the whole duration of long running
+		 * operations like diffs and validations */
+		QString captureSnapshot();
+
+		/*! \brief Materializes an independent model instance from a buffer returned by captureSnapshot().
+		 * The returned model is owned by the caller and shares no state with the original one, thus it can be
+		 * freely consumed and destroyed in a background thread while the original keeps being edited */
+		static DatabaseModel *materializeSnapshot(const QString &xml_buf);
+
+		/*! \brief Enables the streaming model loading mode. In that mode loadModel() reads the dbm file
+		 * through a SAX-like reader (see XmlParser::streamXMLFile()) keeping in memory only one object
+		 * subtree at a time instead of the whole document tree, which drastically reduces the peak memory
+		 * usage for huge models. Note: in this mode the document is not validated against the root DTD. */
+		static void setStreamLoadingEnabled(bool value);
+
+		//! \brief Indicates whether the streaming model loading mode is enabled
+		static bool isStreamLoadingEnabled();
+
+		/*! \brief Enables the parallel code generation mode. In that mode getCodeDefinition() uses a thread
+		 * pool to pre-generate the SQL/XML code of the model's objects before stitching the definitions in
+		 * creation order, speeding up the export and saving of huge models on multicore machines */
+		static void setParallelCodeGeneration(bool value);
+
+		//! \brief Indicates whether the parallel code generation mode is enabled
+		static bool isParallelCodeGeneration();
+
+		/*! \brief Enables the binary cache sidecar of model files. When enabled, saveModel() writes next to
+		 * the dbm file a versioned binary snapshot (see ModelCacheExt) and loadModel() loads the xml from
+		 * it when its checksum matches the dbm file, skipping the disk reading and the DTD validation */
+		static void setModelCacheEnabled(bool value);
+
+		//! \brief Indicates whether the binary cache sidecar of model files is enabled
+		static bool isModelCacheEnabled();
+
 		//! \brief Sets the database encoding
 		void setEncoding(EncodingType encod);
 
@@ -474,11 +684,38 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Saves the specified code definition for the model on the specified filename
 		void saveModel(const QString &filename, unsigned def_type);
 
+		/*! \brief Writes a xml definition buffer (see getCodeDefinition()) to the provided dbm file,
+		 * atomically replacing its previous contents and refreshing the binary cache sidecar. Since it
+		 * doesn't touch the model instance it can run on a worker thread while the user keeps editing,
+		 * the buffer working as a snapshot of the model at the moment it was generated */
+		static void writeModelBuffer(const QString &filename, const QByteArray &buffer);
+
 		/*! \brief Saves the model's SQL code definition by creating separated files for each object
 		 * The provided path must be a directory. If it does not exists then the method will create
 		 * it prior to the generation of the files. */
 		void saveSplitSQLDefinition(const QString &path);
 
+		/*! \brief Saves the model as a directory of per-object xml fragments plus a manifest
+		 * (see SplitModelManifest) that records the loading order and the schema each fragment
+		 * belongs to. Fragments whose content didn't change since the last save aren't rewritten,
+		 * so saving after a small edit touches only the affected files instead of a monolithic
+		 * dbm file, and the directory diffs nicely under version control. Fragment files no
+		 * longer referenced by the manifest are removed */
+		void saveSplitModelDefinition(const QString &path);
+
+		/*! \brief Loads a model saved in the split directory format (see saveSplitModelDefinition()).
+		 * When a non empty schema name list is provided only the fragments that belong to those
+		 * schemas, plus the schema-less/global ones, are loaded. Partial loading expects the
+		 * selected schemas to be self contained: an object referencing an unloaded schema raises
+		 * an error, in which case the model must be loaded whole */
+		void loadSplitModelDefinition(const QString &path, const QStringList &schemas={});
+
+		//! \brief Name of the manifest file of split model directories
+		static const QString SplitModelManifest;
+
+		//! \brief Name of the root document fragment of split model directories
+		static const QString SplitModelRootFile;
+
 		/*! \brief Returns the complete SQL/XML defintion for the entire model (including all the other objects).
 		 The parameter 'export_file' is used to format the generated code in a way that can be saved
 		 in na SQL file and executed later on the DBMS server. This parameter is only used for SQL definition. */
@@ -487,6 +724,12 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Returns the complete SQL/XML definition for the entire model (including all the other objects).
 		virtual QString getCodeDefinition(unsigned def_type) final;
 
+		/*! \brief Generates the SQL definition of the entire model in chunks, forwarding each generated
+		 piece to output_fn in the exact order it would appear in the script returned by getCodeDefinition().
+		 This keeps the memory usage bounded to a few object definitions instead of accumulating the whole
+		 script and allows the consumer (e.g. the DBMS export) to overlap execution with generation */
+		void getSQLDefinitionStreamed(const std::function<void(const QString &)> &output_fn);
+
 		//! \brief Returns the code definition only for the database (excluding the definition of the other objects)
 		QString __getCodeDefinition(unsigned def_type);
 
@@ -746,6 +989,11 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Validates the relationship to reflect the modifications on the column/constraint of the passed table
 		void validateRelationships(TableObject *object, Table *parent_tab);
 
+		/*! \brief Returns true when a modification on the passed column/constraint demands a model-wide
+		 relationship revalidation (see validateRelationships(TableObject*,Table*)). This is used by the
+		 operation list to postpone a single revalidation to the end of chained undo/redo executions */
+		bool isRelValidationRequired(TableObject *object, Table *parent_tab);
+
 		/*! \brief Checks if from the passed relationship some redundacy is found. Redundancy generates infinite column
 		 propagation over the tables. This method raises an error when found some. */
 		void checkRelationshipRedundancy(Relationship *rel);
@@ -755,6 +1003,15 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 the informed object, e.g., a schema linked to a table that is referenced in a view */
 		void getObjectDependecies(BaseObject *objeto, vector<BaseObject *> &vet_deps, bool inc_indirect_deps=false);
 
+		/*! \brief Splits the model objects into per-schema shards that can be processed independently by
+		concurrent consumers (validation, code generation, diff), plus a shared boundary set. Each shard
+		holds, in creation order, the objects owned by one schema whose direct dependencies stay within
+		that same schema. Objects without a schema (roles, tablespaces, languages, relationships and
+		alike) and objects with cross-schema dependencies are placed on boundary_objs, also in creation
+		order. Models with mostly independent schemas produce shards of near-equal processing cost and a
+		small boundary set */
+		void partitionBySchema(vector<vector<BaseObject *>> &shards, vector<BaseObject *> &boundary_objs);
+
 		/*! \brief Recursive version of getObjectDependencies. Returns all the dependencies of the specified object but
 		additionally its children objects (for schemas, tables or views) as well permissions.
 		This method is less efficient than the non recursive version and is used only as an auxiliary operation for
@@ -781,6 +1038,11 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 graphical objects to be marked */
 		void setCodesInvalidated(vector<ObjectType> types={});
 
+		/*! \brief Marks as code invalidated only the provided object and its direct/indirect dependents, determined
+		 by walking the dependency graph through getObjectReferences(). This is a cheaper alternative to the type
+		 based version above since a change in a single object will not force the code regeneration of unrelated ones */
+		void setCodesInvalidated(BaseObject *object);
+
 		/*! \brief Updates the user type names which belongs to the passed schema. This method must be executed whenever
 		 the schema is renamed to propagate the new name to the user types on the PgSQLTypes list. Additionally
 		 the previous schema name must be informed in order to rename the types correctly */
@@ -868,6 +1130,9 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Signal emitted when a new object is added to the model
 		void s_objectAdded(BaseObject *object);
 
+		//! \brief Signal emitted when a batch of objects is added to the model (see addObjects())
+		void s_objectsAdded(vector<BaseObject *> objects);
+
 		//! \brief Signal emitted when an object is removed from the model
 		void s_objectRemoved(BaseObject *object);
 
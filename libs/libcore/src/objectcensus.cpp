@@ -0,0 +1,107 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "objectcensus.h"
+#include <QMutexLocker>
+#include <QMultiMap>
+
+std::atomic_bool ObjectCensus::enabled{false};
+std::unordered_map<void *, std::size_t> ObjectCensus::live_objs;
+QMutex ObjectCensus::census_mtx;
+
+void ObjectCensus::setEnabled(bool value)
+{
+	if(!value)
+	{
+		QMutexLocker locker(&census_mtx);
+		enabled.store(false, std::memory_order_relaxed);
+		live_objs.clear();
+	}
+	else
+		enabled.store(true, std::memory_order_relaxed);
+}
+
+bool ObjectCensus::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void ObjectCensus::registerObject(void *ptr, std::size_t size)
+{
+	QMutexLocker locker(&census_mtx);
+	live_objs[ptr]=size;
+}
+
+void ObjectCensus::unregisterObject(void *ptr)
+{
+	QMutexLocker locker(&census_mtx);
+	live_objs.erase(ptr);
+}
+
+std::map<ObjectType, ObjectCensus::TypeStats> ObjectCensus::snapshot()
+{
+	std::map<ObjectType, TypeStats> stats;
+	QMutexLocker locker(&census_mtx);
+
+	for(auto &itr : live_objs)
+	{
+		/* The tracked pointers always refer to BaseObject instances (see BaseObject::operator new),
+		 so the type tag can be read directly from the object */
+		ObjectType obj_type=static_cast<BaseObject *>(itr.first)->getObjectType();
+
+		stats[obj_type].count++;
+		stats[obj_type].bytes+=static_cast<qint64>(itr.second);
+	}
+
+	return stats;
+}
+
+QString ObjectCensus::dump()
+{
+	std::map<ObjectType, TypeStats> stats=snapshot();
+	QMultiMap<qint64, QString> ranking;
+	QString report;
+	qint64 total_count=0, total_bytes=0;
+
+	for(auto &itr : stats)
+	{
+		ranking.insert(itr.second.bytes,
+									 QString("  %1: count=%2 bytes=%3")
+									 .arg(BaseObject::getSchemaName(itr.first))
+									 .arg(itr.second.count).arg(itr.second.bytes));
+		total_count+=itr.second.count;
+		total_bytes+=itr.second.bytes;
+	}
+
+	if(ranking.isEmpty())
+		return QString("No live objects tracked.\n");
+
+	report=QString("Live objects: %1 (%2 bytes)\n").arg(total_count).arg(total_bytes);
+
+	//Listing the types from the biggest to the smallest memory holder
+	QMapIterator<qint64, QString> itr(ranking);
+	itr.toBack();
+
+	while(itr.hasPrevious())
+	{
+		itr.previous();
+		report+=itr.value() + QString("\n");
+	}
+
+	return report;
+}
@@ -0,0 +1,79 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libcore
+\class ObjectCensus
+\brief Implements an opt-in census of the live model objects. While enabled, every object
+allocated through BaseObject::operator new is tracked together with its most derived size,
+so a snapshot can break the current object population down by type with approximate byte
+accounting. This answers, without a heap profiler, whether the memory of a big session is
+held by undo history copies, import intermediates or the model itself. Disabled by default:
+the allocation hot path pays only an atomic flag check.
+*/
+
+#ifndef OBJECT_CENSUS_H
+#define OBJECT_CENSUS_H
+
+#include "baseobject.h"
+#include <QMutex>
+#include <atomic>
+#include <unordered_map>
+
+class ObjectCensus {
+	public:
+		//! \brief Live object count and accumulated bytes of a single object type
+		struct TypeStats {
+			qint64 count=0, bytes=0;
+		};
+
+	private:
+		//! \brief Indicates that the live objects are being tracked
+		static std::atomic_bool enabled;
+
+		/*! \brief Live objects and their most derived sizes. Only the objects allocated while
+		 the census was enabled are present, so enabling it mid-session tracks the growth from
+		 that point on */
+		static std::unordered_map<void *, std::size_t> live_objs;
+
+		//! \brief Synchronizes the registrations, removals and snapshots
+		static QMutex census_mtx;
+
+	public:
+		//! \brief Enables/disables the tracking of the objects' lifecycles
+		static void setEnabled(bool value);
+
+		//! \brief Indicates whether the tracking is enabled
+		static bool isEnabled();
+
+		//! \brief Registers a just allocated object and its most derived size
+		static void registerObject(void *ptr, std::size_t size);
+
+		//! \brief Removes an object from the census. Objects allocated while the census was disabled are ignored
+		static void unregisterObject(void *ptr);
+
+		/*! \brief Returns the live counts and byte totals per object type. The type of each
+		 object is read at snapshot time, so objects still under construction are reported
+		 under the base type momentarily */
+		static std::map<ObjectType, TypeStats> snapshot();
+
+		//! \brief Returns a plain text report of the census sorted by accumulated bytes
+		static QString dump();
+};
+
+#endif
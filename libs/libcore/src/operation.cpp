@@ -17,6 +17,7 @@
 */
 
 #include "operation.h"
+#include "basegraphicobject.h"
 
 Operation::Operation()
 {
@@ -26,6 +27,24 @@ Operation::Operation()
 	object_idx=-1;
 	chain_type=NoChain;
 	op_type=NoOperation;
+	position_delta=false;
+	spill_offset=-1;
+	spill_length=0;
+	mem_size=0;
+	spilled=false;
+}
+
+bool Operation::isPositionDeltaStorable(BaseObject *object)
+{
+	ObjectType obj_type;
+
+	if(!object)
+		return false;
+
+	obj_type=object->getObjectType();
+	return (BaseGraphicObject::isGraphicObject(obj_type) &&
+					obj_type!=ObjectType::Relationship &&
+					obj_type!=ObjectType::BaseRelationship);
 }
 
 QString Operation::generateOperationId()
@@ -87,6 +106,31 @@ void Operation::setXMLDefinition(const QString &xml_def)
 	xml_definition=xml_def;
 }
 
+void Operation::setPositionDelta(const QPointF &pos)
+{
+	old_position=pos;
+	position_delta=true;
+}
+
+void Operation::setSpillData(qint64 offset, qint64 length)
+{
+	spill_offset=offset;
+	spill_length=length;
+	spilled=true;
+}
+
+void Operation::clearSpillData()
+{
+	spill_offset=-1;
+	spill_length=0;
+	spilled=false;
+}
+
+void Operation::setMemorySize(qint64 size)
+{
+	mem_size=(size < 0 ? 0 : size);
+}
+
 int Operation::getObjectIndex()
 {
 	return object_idx;
@@ -127,6 +171,36 @@ QString Operation::getXMLDefinition()
 	return xml_definition;
 }
 
+QPointF Operation::getOldPosition()
+{
+	return old_position;
+}
+
+bool Operation::hasPositionDelta()
+{
+	return position_delta;
+}
+
+qint64 Operation::getSpillOffset()
+{
+	return spill_offset;
+}
+
+qint64 Operation::getSpillLength()
+{
+	return spill_length;
+}
+
+qint64 Operation::getMemorySize()
+{
+	return mem_size;
+}
+
+bool Operation::isSpilled()
+{
+	return spilled;
+}
+
 bool Operation::isOperationValid()
 {
 	return (operation_id==generateOperationId());
@@ -28,6 +28,7 @@
 #include "baseobject.h"
 #include "permission.h"
 #include <QString>
+#include <QPointF>
 
 class Operation {
 	private:
@@ -53,6 +54,29 @@ class Operation {
 		 indexes, sequences, constraints. */
 		QString xml_definition;
 
+		/*! \brief Previous position of the object when the operation is a move stored as a delta.
+		 Move operations over graphical objects don't need a full copy of the object on the pool,
+		 only the position prior to the movement, which drastically reduces the memory consumed
+		 by the undo/redo of position changes over large tables and views */
+		QPointF old_position;
+
+		//! \brief Indicates that the operation stores only a position delta instead of a full object copy
+		bool position_delta;
+
+		/*! \brief Offset and length of the serialized pool object on the operation list's spill file.
+		 When the memory budget of the history is exceeded the copies held by the oldest operations
+		 are serialized to disk and destroyed, being recreated on demand from these coordinates
+		 (see OperationList::rehydrateOperation) */
+		qint64 spill_offset,
+		spill_length,
+
+		/*! \brief Estimated in-memory size (in bytes) of the pool object copy, measured through its
+		 XML code. Used by the operation list to enforce the configured memory budget */
+		mem_size;
+
+		//! \brief Indicates that the pool object copy was serialized to the spill file
+		bool spilled;
+
 		//! \brief Operation type (Constants OBJECT_[MODIFIED | CREATED | REMOVED | MOVED]
 		unsigned op_type;
 
@@ -88,6 +112,11 @@ class Operation {
 
 		Operation();
 
+		/*! \brief Returns whether move operations over the provided object can be stored as
+		 position deltas. Only graphical objects that aren't relationships are accepted since
+		 moving a relationship also changes label positions and line points */
+		static bool isPositionDeltaStorable(BaseObject *object);
+
 		void setObjectIndex(int idx);
 		void setChainType(unsigned type);
 		void setOperationType(unsigned type);
@@ -96,6 +125,15 @@ class Operation {
 		void setParentObject(BaseObject *object);
 		void setPermissions(const vector<Permission *> &perms);
 		void setXMLDefinition(const QString &xml_def);
+		void setPositionDelta(const QPointF &pos);
+
+		//! \brief Marks the operation as spilled storing the coordinates of the record on the spill file
+		void setSpillData(qint64 offset, qint64 length);
+
+		//! \brief Clears the spill mark (called when the pool object copy is recreated)
+		void clearSpillData();
+
+		void setMemorySize(qint64 size);
 
 		int getObjectIndex();
 		unsigned getChainType();
@@ -105,6 +143,12 @@ class Operation {
 		BaseObject *getParentObject();
 		vector<Permission *> getPermissions();
 		QString getXMLDefinition();
+		QPointF getOldPosition();
+		bool hasPositionDelta();
+		qint64 getSpillOffset();
+		qint64 getSpillLength();
+		qint64 getMemorySize();
+		bool isSpilled();
 		bool isOperationValid();
 };
 
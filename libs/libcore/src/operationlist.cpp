@@ -18,8 +18,11 @@
 
 #include "operationlist.h"
 #include "coreutilsns.h"
+#include "globalattributes.h"
+#include <QFile>
 
 unsigned OperationList::max_size=500;
+qint64 OperationList::max_mem_size=0;
 
 OperationList::OperationList(DatabaseModel *model)
 {
@@ -33,6 +36,12 @@ OperationList::OperationList(DatabaseModel *model)
 	current_index=0;
 	next_op_chain=Operation::NoChain;
 	ignore_chain=false;
+	reg_enabled=true;
+	chained_exec=false;
+	pending_rels_validation=false;
+	pool_mem_size=0;
+	spill_file_len=0;
+	spill_file_name=GlobalAttributes::getTemporaryFilePath(QString("op_history_%1.spill").arg(model->getObjectId()));
 	operations.reserve(max_size);
 }
 
@@ -102,6 +111,16 @@ void OperationList::ignoreOperationChain(bool value)
 	ignore_chain=value;
 }
 
+void OperationList::setRegisterEnabled(bool value)
+{
+	reg_enabled=value;
+}
+
+bool OperationList::isRegisterEnabled()
+{
+	return reg_enabled;
+}
+
 bool OperationList::isOperationChainStarted()
 {
 	return (next_op_chain==Operation::ChainStart ||
@@ -146,6 +165,144 @@ void OperationList::setMaximumSize(unsigned max)
 	max_size=max;
 }
 
+void OperationList::setMaximumMemorySize(qint64 max_bytes)
+{
+	max_mem_size=(max_bytes < 0 ? 0 : max_bytes);
+}
+
+qint64 OperationList::getMaximumMemorySize()
+{
+	return max_mem_size;
+}
+
+bool OperationList::isOperationSpillable(Operation *oper)
+{
+	ObjectType obj_type;
+
+	if(!oper || oper->isSpilled() || !oper->isOperationValid() ||
+			oper->getOperationType()!=Operation::ObjectModified || !oper->getPoolObject())
+		return false;
+
+	obj_type=oper->getPoolObject()->getObjectType();
+
+	/* Relationships are never spilled because recreating them from XML (see
+	 DatabaseModel::createRelationship) connects them to the model instead of
+	 producing a detached copy */
+	return (obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship);
+}
+
+void OperationList::enforceMemoryBudget()
+{
+	if(max_mem_size <= 0 || pool_mem_size <= max_mem_size)
+		return;
+
+	/* Only operations already applied on the model (below the current index) are spilled.
+	 Their copies store the object states prior to the operations, which is exactly what
+	 the XML written on the spill file reproduces on rehydration */
+	for(int idx=0; idx < current_index && pool_mem_size > max_mem_size; idx++)
+	{
+		if(operations[idx]->getMemorySize() > 0 && isOperationSpillable(operations[idx]))
+			spillOperation(operations[idx]);
+	}
+}
+
+void OperationList::spillOperation(Operation *oper)
+{
+	BaseObject *pool_obj=oper->getPoolObject();
+
+	try
+	{
+		QByteArray buf=pool_obj->getCodeDefinition(SchemaParser::XmlDefinition).toUtf8();
+		QFile spill_file(spill_file_name);
+		vector<BaseObject *>::iterator itr;
+
+		if(!spill_file.open(QFile::WriteOnly | QFile::Append))
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(spill_file_name),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		oper->setSpillData(spill_file_len, buf.size());
+
+		//Truncating the file back to the previous length if the record couldn't be fully written
+		if(spill_file.write(buf)!=buf.size())
+		{
+			spill_file.resize(spill_file_len);
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(spill_file_name),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
+
+		spill_file.close();
+		spill_file_len+=buf.size();
+
+		//Destroying the resident copy. It is recreated from the spill file on demand
+		itr=std::find(object_pool.begin(), object_pool.end(), pool_obj);
+
+		if(itr!=object_pool.end())
+			object_pool.erase(itr);
+
+		oper->setPoolObject(nullptr);
+		pool_mem_size-=oper->getMemorySize();
+
+		if(pool_mem_size < 0)
+			pool_mem_size=0;
+
+		delete pool_obj;
+	}
+	catch(Exception &)
+	{
+		//Failing to spill is not critical, the copy simply stays resident
+		oper->clearSpillData();
+	}
+}
+
+void OperationList::rehydrateOperation(Operation *oper)
+{
+	BaseObject *object=nullptr;
+	QFile spill_file(spill_file_name);
+	QByteArray buf;
+
+	if(!oper->isSpilled())
+		return;
+
+	try
+	{
+		if(!spill_file.open(QFile::ReadOnly))
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(spill_file_name),
+											ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		spill_file.seek(oper->getSpillOffset());
+		buf=spill_file.read(oper->getSpillLength());
+		spill_file.close();
+
+		xmlparser->restartParser();
+		xmlparser->loadXMLBuffer(QString::fromUtf8(buf));
+		object=model->createObject(oper->getOriginalObject()->getObjectType());
+
+		if(!object)
+			throw Exception(ErrorCode::AsgNotAllocattedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		//Putting the recreated copy back on the pool so the operation can be normally executed
+		object_pool.push_back(object);
+		oper->setPoolObject(object);
+		oper->clearSpillData();
+		pool_mem_size+=oper->getMemorySize();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(ErrorCode::UndoRedoOperationInvalidObject,__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+}
+
+void OperationList::discountPoolMemory(Operation *oper)
+{
+	if(oper->isSpilled())
+		return;
+
+	pool_mem_size-=oper->getMemorySize();
+
+	if(pool_mem_size < 0)
+		pool_mem_size=0;
+}
+
 void OperationList::addToPool(BaseObject *object, unsigned op_type)
 {
 	ObjectType obj_type;
@@ -159,9 +316,11 @@ void OperationList::addToPool(BaseObject *object, unsigned op_type)
 
 		obj_type=object->getObjectType();
 
-		//Stores a copy of the object if its about to be moved or modified
+		/* Stores a copy of the object if its about to be moved or modified. Move operations
+		 over graphical objects are stored as position deltas (see registerObject) so for
+		 them the original object goes to the pool avoiding an expensive deep copy */
 		if(op_type==Operation::ObjectModified ||
-				op_type==Operation::ObjectMoved)
+				(op_type==Operation::ObjectMoved && !Operation::isPositionDeltaStorable(object)))
 		{
 			BaseObject *copy_obj=nullptr;
 
@@ -264,6 +423,14 @@ void OperationList::removeOperations()
 
 	current_index=0;
 	unallocated_objs.clear();
+	pool_mem_size=0;
+
+	//Dropping the spill file since all the spilled operations were destroyed
+	if(spill_file_len > 0)
+	{
+		QFile::remove(spill_file_name);
+		spill_file_len=0;
+	}
 }
 
 void OperationList::validateOperations()
@@ -278,10 +445,13 @@ void OperationList::validateOperations()
 	{
 		oper=(*itr);
 
-		//Case the object isn't on the pool
-		if(!isObjectOnPool((*itr)->getPoolObject()) ||
-				!oper->isOperationValid())
+		//Case the object isn't on the pool (spilled operations have no resident copy by design)
+		if(!oper->isSpilled() &&
+				(!isObjectOnPool(oper->getPoolObject()) ||
+				 !oper->isOperationValid()))
 		{
+			discountPoolMemory(oper);
+
 			//Remove the operation
 			operations.erase(itr);
 			delete oper;
@@ -345,6 +515,10 @@ int OperationList::registerObject(BaseObject *object, unsigned op_type, int obje
 	tab_obj=dynamic_cast<TableObject *>(object);
 	int obj_idx=-1;
 
+	//When the registration is disabled (viewer mode) no operation is stored
+	if(!reg_enabled)
+		return -1;
+
 	try
 	{
 		//Raises an error if the user tries to register an operation with null object
@@ -398,6 +572,11 @@ int OperationList::registerObject(BaseObject *object, unsigned op_type, int obje
 		//Assigns the pool object to the operation
 		operation->setPoolObject(object_pool.back());
 
+		/* For move operations over graphical objects (except relationships) only the previous
+		 position is stored on the operation (delta) instead of a full copy of the object */
+		if(op_type==Operation::ObjectMoved && Operation::isPositionDeltaStorable(object))
+			operation->setPositionDelta(dynamic_cast<BaseGraphicObject *>(object)->getPosition());
+
 		//Stores the object's permission befor its removal
 		if(op_type==Operation::ObjectRemoved)
 		{
@@ -483,6 +662,24 @@ int OperationList::registerObject(BaseObject *object, unsigned op_type, int obje
 		operations.push_back(operation);
 		current_index=operations.size();
 
+		/* When a memory budget is configured the estimated size of the copy is measured through
+		 its XML code so the oldest modification operations can be spilled to disk once the
+		 budget is exceeded */
+		if(max_mem_size > 0 && isOperationSpillable(operation))
+		{
+			try
+			{
+				operation->setMemorySize(operation->getPoolObject()->getCodeDefinition(SchemaParser::XmlDefinition).toUtf8().size());
+				pool_mem_size+=operation->getMemorySize();
+				enforceMemoryBudget();
+			}
+			catch(Exception &)
+			{
+				//The copy simply stays resident when its size can't be measured
+				operation->setMemorySize(0);
+			}
+		}
+
 		//Registering a log entry for the object modification in database model's change log
 		model->addChangelogEntry(object, op_type, parent_obj);
 
@@ -513,7 +710,9 @@ void OperationList::getOperationData(unsigned oper_idx, unsigned &oper_type, QSt
 
 	if(operation->isOperationValid())
 	{
-		pool_obj=operation->getPoolObject();
+		/* For spilled operations the name/type are taken from the original (live) object, avoiding
+		 the cost of rehydrating the pool copy just for displaying purposes */
+		pool_obj=(operation->isSpilled() ? operation->getOriginalObject() : operation->getPoolObject());
 		obj_type=pool_obj->getObjectType();
 		obj_name=pool_obj->getName(true);
 
@@ -592,7 +791,7 @@ void OperationList::undoOperation()
 			the execution several operations at once */
 			if(!ignore_chain && !chain_active &&
 					operation->getChainType()!=Operation::NoChain)
-				chain_active=true;
+				chain_active=chained_exec=true;
 
 			/* If the chaining is active and the current operation is not part of
 			chain, aborts execution of the operation */
@@ -622,6 +821,8 @@ void OperationList::undoOperation()
 		while(!ignore_chain && isUndoAvailable() &&
 			  operation->getChainType()!=Operation::NoChain);
 
+		finishChainedExecution(error);
+
 		if(error.getErrorCode()!=ErrorCode::Custom)
 			throw Exception(ErrorCode::UndoRedoOperationInvalidObject,__PRETTY_FUNCTION__,__FILE__,__LINE__, &error);
 	}
@@ -648,7 +849,7 @@ void OperationList::redoOperation()
 			the execution several operations at once */
 			if(!ignore_chain && !chain_active &&
 					operation->getChainType()!=Operation::NoChain)
-				chain_active=true;
+				chain_active=chained_exec=true;
 
 			/* If the chaining is active and the current operation is not part of
 			chain or it is at the start of chain, aborts execution of the operation */
@@ -677,13 +878,47 @@ void OperationList::redoOperation()
 		while(!ignore_chain && isRedoAvailable() &&
 			  operation->getChainType()!=Operation::NoChain);
 
+		finishChainedExecution(error);
+
 		if(error.getErrorCode()!=ErrorCode::Custom)
 			throw Exception(ErrorCode::UndoRedoOperationInvalidObject,__PRETTY_FUNCTION__,__FILE__,__LINE__, &error);
 	}
 }
 
+void OperationList::finishChainedExecution(Exception &error)
+{
+	if(!chained_exec)
+		return;
+
+	chained_exec=false;
+
+	/* Performs the relationship revalidation postponed by the operations executed in chain.
+	 This way the model-wide validation (the most expensive step of a composite undo/redo)
+	 runs only once no matter the amount of operations in the chain */
+	if(pending_rels_validation)
+	{
+		pending_rels_validation=false;
+
+		try
+		{
+			model->storeSpecialObjectsXML();
+			model->disconnectRelationships();
+			model->validateRelationships();
+		}
+		catch(Exception &e)
+		{
+			if(error.getErrorCode()==ErrorCode::Custom)
+				error=e;
+		}
+	}
+}
+
 void OperationList::executeOperation(Operation *oper, bool redo)
 {
+	//Recreating the pool copy of spilled operations before executing them
+	if(oper && oper->isSpilled())
+		rehydrateOperation(oper);
+
 	if(oper && oper->isOperationValid())
 	{
 		BaseObject *orig_obj=nullptr, *bkp_obj=nullptr,
@@ -716,8 +951,9 @@ void OperationList::executeOperation(Operation *oper, bool redo)
 		}
 
 		/* If the XML definition of object is set indicates that it is referencing a column
-			included by relationship (special object) */
-		if(!xml_def.isEmpty() &&
+			included by relationship (special object). Operations stored as position deltas
+			don't touch any reference so the object needn't be recreated from XML */
+		if(!xml_def.isEmpty() && !oper->hasPositionDelta() &&
 				((op_type==Operation::ObjectRemoved && !redo) ||
 				 (op_type==Operation::ObjectCreated && redo) ||
 				 (op_type==Operation::ObjectModified ||
@@ -743,9 +979,21 @@ void OperationList::executeOperation(Operation *oper, bool redo)
 				aux_obj=model->createGenericSQL();
 		}
 
+		/* Move operations stored as position deltas restore the previous position directly
+			on the live object. The current position is stored back on the operation so the
+			movement can be redone through the same swap */
+		if(op_type==Operation::ObjectMoved && oper->hasPositionDelta())
+		{
+			BaseGraphicObject *graph_obj=dynamic_cast<BaseGraphicObject *>(object);
+			QPointF aux_pos=graph_obj->getPosition();
+
+			graph_obj->setPosition(oper->getOldPosition());
+			oper->setPositionDelta(aux_pos);
+		}
+
 		/* If the operation is a modified/moved object, the object copy
 			stored in the pool will be restored */
-		if(op_type==Operation::ObjectModified || op_type==Operation::ObjectMoved)
+		else if(op_type==Operation::ObjectModified || op_type==Operation::ObjectMoved)
 		{
 			if(obj_type==ObjectType::Relationship)
 			{
@@ -847,7 +1095,14 @@ void OperationList::executeOperation(Operation *oper, bool redo)
 				if(object->getObjectType()==ObjectType::Column ||
 						object->getObjectType()==ObjectType::Constraint)
 				{
-					model->validateRelationships(dynamic_cast<TableObject *>(object), dynamic_cast<Table *>(parent_tab));
+					/* In chained executions the model-wide revalidation is postponed to the end of the chain,
+					otherwise undoing/redoing a large composite action would revalidate the relationships once
+					per operation (see finishChainedExecution()) */
+					if(chained_exec)
+						pending_rels_validation=(pending_rels_validation ||
+																		 model->isRelValidationRequired(dynamic_cast<TableObject *>(object), dynamic_cast<Table *>(parent_tab)));
+					else
+						model->validateRelationships(dynamic_cast<TableObject *>(object), dynamic_cast<Table *>(parent_tab));
 
 					if(object->getObjectType()==ObjectType::Constraint &&
 						 dynamic_cast<Constraint *>(object)->getConstraintType()==ConstraintType::ForeignKey)
@@ -887,7 +1142,11 @@ void OperationList::executeOperation(Operation *oper, bool redo)
 			{
 				parent_rel->setCodeInvalidated(true);
 				parent_rel->forceInvalidate();
-				model->validateRelationships();
+
+				if(chained_exec)
+					pending_rels_validation=true;
+				else
+					model->validateRelationships();
 			}
 		}
 
@@ -904,10 +1163,21 @@ void OperationList::executeOperation(Operation *oper, bool redo)
 			//Case the object is a view is necessary to update the table-view relationships on the model
 			if(obj_type==ObjectType::View && op_type==Operation::ObjectModified)
 				model->updateViewRelationships(dynamic_cast<View *>(graph_obj));
-			else if((obj_type==ObjectType::Relationship ||
-							(PhysicalTable::isPhysicalTable(obj_type) && model->getRelationship(dynamic_cast<BaseTable *>(object), nullptr))) &&
-							op_type==Operation::ObjectModified)
+
+			/* Relationship restorations disconnect all the relationships beforehand, so the revalidation
+			can't be postponed even in chained executions otherwise the remaining operations of the chain
+			would be executed over a disconnected model */
+			else if(obj_type==ObjectType::Relationship && op_type==Operation::ObjectModified)
 				model->validateRelationships();
+			else if(PhysicalTable::isPhysicalTable(obj_type) &&
+							model->getRelationship(dynamic_cast<BaseTable *>(object), nullptr) &&
+							op_type==Operation::ObjectModified)
+			{
+				if(chained_exec)
+					pending_rels_validation=true;
+				else
+					model->validateRelationships();
+			}
 
 			//If a object had its schema restored is necessary to update the envolved schemas
 			if(BaseTable::isBaseTable(obj_type) &&
@@ -976,6 +1246,7 @@ void OperationList::removeLastOperation()
 
 			//Removes the object related to the operation from the pool
 			removeFromPool(oper_idx);
+			discountPoolMemory(oper);
 
 			/* Stop condition for removing the operation:
 			 1) The operation is not chained with others, or
@@ -38,6 +38,20 @@ class OperationList: public QObject {
 		//! \brief Inidcates that operation chaining is ignored temporarily
 		bool ignore_chain;
 
+		/*! \brief Indicates that the registration of operations is enabled. When disabled (viewer mode)
+		 registerObject() becomes a no-op and no object copies are stored in the pool */
+		bool reg_enabled;
+
+		/*! \brief Indicates that a chained undo/redo execution is in progress. In this mode
+		 executeOperation() postpones the model-wide relationship revalidation normally triggered
+		 by the individual operations (see pending_rels_validation) */
+		bool chained_exec;
+
+		/*! \brief Set during a chained undo/redo execution when at least one of the executed operations
+		 demands the relationships to be revalidated. The postponed revalidation is performed by
+		 undoOperation() / redoOperation() once right after the last operation of the chain */
+		bool pending_rels_validation;
+
 		XmlParser *xmlparser;
 
 		//! \brief List of objects that were removed / modified on the model
@@ -61,6 +75,22 @@ class OperationList: public QObject {
 		//! \brief Maximum number of stored operations (global)
 		static unsigned max_size;
 
+		/*! \brief Memory budget (in bytes) for the object copies held by the pool (global). When
+		 exceeded the copies of the oldest modification operations are serialized to the spill
+		 file and destroyed, being recreated on demand during deep undo. Zero (the default)
+		 disables the spilling */
+		static qint64 max_mem_size;
+
+		//! \brief Estimated memory consumed by the resident (not spilled) pool object copies
+		qint64 pool_mem_size;
+
+		/*! \brief Current length of the spill file. Records are only appended (rehydrated records
+		 leave holes behind), the file being dropped when the history is cleared */
+		qint64 spill_file_len;
+
+		//! \brief Path to the file holding the serialized copies of the spilled operations
+		QString spill_file_name;
+
 		/*! \brief Stores the type of chain to the next operation to be stored
 		 in the list. This attribute is used in conjunction with the chaining
 		 initialization / finalization methods. */
@@ -93,6 +123,32 @@ class OperationList: public QObject {
 		//! \brief Returns the chain size from the current element
 		unsigned getChainSize();
 
+		/*! \brief Finishes a chained undo/redo execution performing, only once, the relationship
+		 revalidation postponed by the executed operations. Validation failures are stored in the
+		 passed exception when no previous error was registered by the caller */
+		void finishChainedExecution(Exception &error);
+
+		/*! \brief Returns whether the copy held by the operation can be spilled to disk. Only copies
+		 created for modification operations are eligible since creation/removal operations hold the
+		 original object which may be reinserted on the model. Relationships are refused as well
+		 because recreating them from XML would connect them to the model instead of producing a
+		 detached copy */
+		bool isOperationSpillable(Operation *oper);
+
+		/*! \brief Serializes the copies held by the oldest spillable operations to the spill file
+		 until the resident copies fit the configured memory budget */
+		void enforceMemoryBudget();
+
+		//! \brief Serializes the copy held by the operation to the spill file destroying the copy afterwards
+		void spillOperation(Operation *oper);
+
+		/*! \brief Recreates the pool copy of a spilled operation from the spill file putting it back on
+		 the pool. Called right before the operation is executed (undo/redo) */
+		void rehydrateOperation(Operation *oper);
+
+		//! \brief Discounts the copy held by the operation from the resident memory estimative
+		void discountPoolMemory(Operation *oper);
+
 	public:
 		OperationList(DatabaseModel *model);
 		virtual ~OperationList();
@@ -138,6 +194,13 @@ class OperationList: public QObject {
 		//! \brief Sets the maximum size for the list
 		static void setMaximumSize(unsigned max);
 
+		/*! \brief Sets the memory budget (in bytes) for the object copies held by the pool. Values
+		 equal to or less than zero disable the disk spilling of the history */
+		static void setMaximumMemorySize(qint64 max_bytes);
+
+		//! \brief Gets the memory budget configured for the object copies held by the pool
+		static qint64 getMaximumMemorySize();
+
 		/*! \brief Registers in the list of operations that the passed object suffered some kind
 		 of modification (modified, removed, inserted, moved) in addition the method stores
 		 its original content.
@@ -149,6 +212,14 @@ class OperationList: public QObject {
 	 In case of success this method returns an integer indicating the last registered operation ID */
 		int registerObject(BaseObject *object, unsigned op_type, int object_idx=-1, BaseObject *parent_obj=nullptr);
 
+		/*! \brief Toggles the registration of operations. Disabling it turns registerObject() into a no-op,
+		 avoiding the allocation of object copies for sessions that will never undo/redo (e.g. models
+		 opened in viewer mode) */
+		void setRegisterEnabled(bool value);
+
+		//! \brief Returns if the registration of operations is enabled
+		bool isRegisterEnabled();
+
 		//! \brief Gets the maximum size for the operation list
 		unsigned getMaximumSize();
 
@@ -22,6 +22,12 @@
 
 vector<UserTypeConfig> PgSqlType::user_types;
 
+QHash<QString, unsigned> PgSqlType::type_name_cache;
+QMutex PgSqlType::type_name_cache_mtx;
+
+QCache<QString, PgSqlType> PgSqlType::parse_cache(1000);
+QMutex PgSqlType::parse_cache_mtx;
+
 template<>
 QStringList PgSqlType::TemplateType<PgSqlType>::type_names =
 {
@@ -78,7 +84,10 @@ QStringList PgSqlType::TemplateType<PgSqlType>::type_names =
 
 PgSqlType::PgSqlType()
 {
-	type_idx = type_names.indexOf("smallint");
+	//Resolving the default type only once since the built-in type list never changes
+	static const unsigned smallint_id = static_cast<unsigned>(type_names.indexOf("smallint"));
+
+	type_idx = smallint_id;
 	reset(true);
 }
 
@@ -127,6 +136,15 @@ PgSqlType::PgSqlType(unsigned type_id, unsigned dimension, unsigned length, int
 
 PgSqlType PgSqlType::parseString(const QString &str)
 {
+	{
+		QMutexLocker locker(&parse_cache_mtx);
+		PgSqlType *cached_type=parse_cache.object(str);
+
+		//Reusing the previously parsed descriptor for the raw string, avoiding the re-tokenization
+		if(cached_type)
+			return *cached_type;
+	}
+
 	QString type_str=str.toLower().simplified(), sptype, interv;
 	bool with_tz=false;
 	unsigned dim=0, srid=0;
@@ -240,6 +258,14 @@ PgSqlType PgSqlType::parseString(const QString &str)
 		else if(!sptype.isEmpty())
 			type.setSpatialType(SpatialType(sptype, srid));
 
+		/* Only descriptors of built-in types are cached. Ids of user defined types shift as
+		 types are registered/removed so their descriptors can't be safely reused */
+		if(!type.isUserType())
+		{
+			QMutexLocker locker(&parse_cache_mtx);
+			parse_cache.insert(str, new PgSqlType(type));
+		}
+
 		return type;
 	}
 	catch(Exception &e)
@@ -611,12 +637,26 @@ void PgSqlType::removeUserTypes(void *pmodel)
 
 unsigned PgSqlType::getBaseTypeIndex(const QString &type_name)
 {
-	QString aux_name=type_name;
+	QString aux_name;
+	unsigned type_id=Null;
+	QMutexLocker locker(&type_name_cache_mtx);
+	QHash<QString, unsigned>::const_iterator itr=type_name_cache.constFind(type_name);
 
+	//Reusing the previously resolved id for the name, avoiding the normalization and the list scan
+	if(itr!=type_name_cache.constEnd())
+		return itr.value();
+
+	aux_name=type_name;
 	aux_name.remove(QString("[]"));
 	aux_name.remove(QRegExp(QString("( )(with)(out)?(.)*")));
 	aux_name=aux_name.trimmed();
-	return getType(aux_name, type_names);
+
+	/* Unresolved names are cached as well (Null): they can only denote user defined types,
+	 which are never present in the built-in type list */
+	type_id=getType(aux_name, type_names);
+	type_name_cache.insert(type_name, type_id);
+
+	return type_id;
 }
 
 unsigned PgSqlType::getUserTypeIndex(const QString &type_name, void *ptype, void *pmodel)
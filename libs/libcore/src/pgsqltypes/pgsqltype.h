@@ -30,6 +30,9 @@
 #include "intervaltype.h"
 #include "spatialtype.h"
 #include "templatetype.h"
+#include <QHash>
+#include <QCache>
+#include <QMutex>
 
 class PgSqlType: public TemplateType<PgSqlType>{
 	private:
@@ -48,6 +51,25 @@ class PgSqlType: public TemplateType<PgSqlType>{
 		//! \brief Configuration for user defined types
 		static vector<UserTypeConfig> user_types;
 
+		/*! \brief Maps type names, exactly as provided by the callers (prior to any normalization),
+		 to the resolved built-in type ids. Since the built-in type list is immutable the cache is
+		 append-only, turning the repeated linear scans over the type list performed during model
+		 loading and database import into single hash lookups */
+		static QHash<QString, unsigned> type_name_cache;
+
+		//! \brief Protects the type name cache against concurrent accesses
+		static QMutex type_name_cache_mtx;
+
+		/*! \brief LRU cache of descriptors produced by parseString(), keyed by the raw textual type
+		 specification. Only descriptors resolving to built-in types are cached since their ids never
+		 change, while the ids of user defined types shift as they are registered/removed. The
+		 database import produces the same handful of type strings a huge number of times, so cache
+		 hits skip the re-tokenization of dimension/length/precision/interval/spatial qualifiers */
+		static QCache<QString, PgSqlType> parse_cache;
+
+		//! \brief Protects the parse cache against concurrent accesses
+		static QMutex parse_cache_mtx;
+
 		//! \brief Dimension of the type if it's configured as array
 		unsigned dimension,
 
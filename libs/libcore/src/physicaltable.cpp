@@ -56,6 +56,35 @@ void PhysicalTable::destroyObjects()
 
 	ancestor_tables.clear();
 	partition_tables.clear();
+	invalidateChildNamesIndexes();
+}
+
+void PhysicalTable::rebuildChildNamesIndex(ObjectType obj_type)
+{
+	vector<TableObject *> *obj_list=getObjectList(obj_type);
+	QHash<QString, int> &name_idx=child_name_idx[obj_type];
+	QString name;
+
+	name_idx.clear();
+
+	if(!obj_list)
+		return;
+
+	for(int idx=0; idx < static_cast<int>(obj_list->size()); idx++)
+	{
+		name=obj_list->at(idx)->getName();
+
+		if(!name_idx.contains(name))
+			name_idx.insert(name, idx);
+	}
+
+	child_name_idx_valid[obj_type]=true;
+}
+
+void PhysicalTable::invalidateChildNamesIndexes()
+{
+	for(auto &itr : child_name_idx_valid)
+		itr.second=false;
 }
 
 void PhysicalTable::setName(const QString &name)
@@ -449,14 +478,30 @@ void PhysicalTable::addObject(BaseObject *obj, int obj_idx)
 
 				//Adds the object to the table
 				if(obj_idx < 0 || obj_idx >= static_cast<int>(obj_list->size()))
+				{
+					/* Appending to the list keeps the positions of the other children unchanged,
+					 * so an up-to-date name lookup index just receives the new entry */
 					obj_list->push_back(tab_obj);
+
+					if(child_name_idx_valid[obj_type])
+						child_name_idx[obj_type].insert(tab_obj->getName(), obj_list->size() - 1);
+				}
 				else
 				{
 					//If there is a object index specified inserts the object at the position
 					if(obj_list->size() > 0)
+					{
+						//Inserting at an arbitrary position shifts the list, outdating the name index
 						obj_list->insert((obj_list->begin() + obj_idx), tab_obj);
+						child_name_idx_valid[obj_type]=false;
+					}
 					else
+					{
 						obj_list->push_back(tab_obj);
+
+						if(child_name_idx_valid[obj_type])
+							child_name_idx[obj_type].insert(tab_obj->getName(), obj_list->size() - 1);
+					}
 				}
 
 				if(obj_type==ObjectType::Column || obj_type==ObjectType::Constraint)
@@ -723,6 +768,9 @@ void PhysicalTable::removeObject(unsigned obj_idx, ObjectType obj_type)
 			tab_obj->setParentTable(nullptr);
 			obj_list->erase(itr);
 
+			//The removal shifts the positions of the remaining children, outdating the name index
+			child_name_idx_valid[obj_type]=false;
+
 			if(constr && constr->getConstraintType()==ConstraintType::PrimaryKey)
 				dynamic_cast<Constraint *>(tab_obj)->setColumnsNotNull(false);
 		}
@@ -760,6 +808,7 @@ void PhysicalTable::removeObject(unsigned obj_idx, ObjectType obj_type)
 
 			column->setParentTable(nullptr);
 			columns.erase(itr);
+			child_name_idx_valid[obj_type]=false;
 		}
 	}
 
@@ -914,25 +963,41 @@ BaseObject *PhysicalTable::getObject(const QString &name, ObjectType obj_type, i
 
 	if(TableObject::isTableObject(obj_type) && obj_list)
 	{
-		vector<TableObject *>::iterator itr, itr_end;
-		QString aux_name=name;
+		/* Lookups by unformatted name (the common case) are served by the per type name lookup
+		 * indexes. Formatted (quoted) names still fall back to the linear comparison since the
+		 * indexes are keyed by raw names */
+		if(!format)
+		{
+			if(!child_name_idx_valid[obj_type])
+				rebuildChildNamesIndex(obj_type);
 
-		itr=obj_list->begin();
-		itr_end=obj_list->end();
+			obj_idx=child_name_idx[obj_type].value(name, -1);
 
-		while(itr!=itr_end)
-		{
-			found=((*itr)->getName(format)==aux_name);
-			if(!found) itr++;
-			else break;
+			if(obj_idx >= 0)
+				object=obj_list->at(obj_idx);
 		}
-
-		if(found)
+		else
 		{
-			obj_idx=(itr-obj_list->begin());
-			object=(*itr);
+			vector<TableObject *>::iterator itr, itr_end;
+			QString aux_name=name;
+
+			itr=obj_list->begin();
+			itr_end=obj_list->end();
+
+			while(itr!=itr_end)
+			{
+				found=((*itr)->getName(format)==aux_name);
+				if(!found) itr++;
+				else break;
+			}
+
+			if(found)
+			{
+				obj_idx=(itr-obj_list->begin());
+				object=(*itr);
+			}
+			else obj_idx=-1;
 		}
-		else obj_idx=-1;
 	}
 	else if(isPhysicalTable(obj_type))
 	{
@@ -1283,6 +1348,9 @@ void PhysicalTable::restoreRelObjectsIndexes(ObjectType obj_type)
 			list->push_back(obj);
 		}
 
+		//The reordering changes the children positions, outdating the name lookup index
+		child_name_idx_valid[obj_type]=false;
+
 		/* Checking if the object names used are equal to the map size. If not, indicates that
 		 * one o more objects on the map doesn't exists anymore on the table thus there is
 		 * the need to updated the object index map */
@@ -1515,6 +1583,7 @@ void PhysicalTable::swapObjectsIndexes(ObjectType obj_type, unsigned idx1, unsig
 			if(obj_type!=ObjectType::Column && obj_type!=ObjectType::Constraint)
 				BaseObject::swapObjectsIds(aux_obj, aux_obj1, false);
 
+			child_name_idx_valid[obj_type]=false;
 			setCodeInvalidated(true);
 		}
 	}
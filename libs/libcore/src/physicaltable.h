@@ -25,6 +25,7 @@
 #define PHYSICAL_TABLE_H
 
 #include <QStringList>
+#include <QHash>
 #include "basegraphicobject.h"
 #include "basetable.h"
 #include "column.h"
@@ -76,6 +77,21 @@ class PhysicalTable: public BaseTable {
 		//! \brief Stores the relationship added column / constraints indexes
 		map<QString, unsigned> col_indexes,	constr_indexes;
 
+		/*! \brief Child name lookup indexes (unformatted name -> position in the related list) used
+		 to avoid linear scans in getObject(). Import, relationship propagation and diff look children
+		 up by name in tight loops, which gets painful on wide tables. The indexes are built lazily
+		 per child type (see rebuildChildNamesIndex()) and kept in sync by addObject()/removeObject();
+		 renames of children expire them through invalidateChildNamesIndexes() */
+		map<ObjectType, QHash<QString, int>> child_name_idx;
+
+		//! \brief Child object types whose name lookup index is currently up-to-date
+		map<ObjectType, bool> child_name_idx_valid;
+
+		/*! \brief Rebuilds the child name lookup index of the specified type from the related object
+		 list. In case of duplicated names the first object in the list prevails, reproducing the
+		 behavior of the former linear scan */
+		void rebuildChildNamesIndex(ObjectType obj_type);
+
 		//! \brief The partitioning mode/type used by the table
 		PartitioningType partitioning_type;
 
@@ -175,6 +191,9 @@ class PhysicalTable: public BaseTable {
 		//! \brief Removes a object from table through its name and type
 		void removeObject(const QString &name, ObjectType obj_type);
 
+		//! \brief Invalidates all the child name lookup indexes (see BaseTable::invalidateChildNamesIndexes())
+		virtual void invalidateChildNamesIndexes(void);
+
 		//! \brief Removes the specified object from table
 		void removeObject(BaseObject *obj);
 
@@ -23,6 +23,7 @@ Reference::Reference()
 	this->table=nullptr;
 	this->column=nullptr;
 	this->is_def_expr=false;
+	this->cached_code_epoch=0;
 }
 
 Reference::Reference(PhysicalTable *table, Column *column, const QString &tab_alias, const QString &col_alias)
@@ -45,6 +46,7 @@ Reference::Reference(PhysicalTable *table, Column *column, const QString &tab_al
 	this->alias=tab_alias;
 	this->column_alias=col_alias;
 	this->is_def_expr=false;
+	this->cached_code_epoch=0;
 }
 
 Reference::Reference(const QString &expression, const QString &expr_alias)
@@ -61,12 +63,20 @@ Reference::Reference(const QString &expression, const QString &expr_alias)
 	alias=expr_alias;
 	this->expression=expression;
 	this->is_def_expr=false;
+	this->cached_code_epoch=0;
+}
+
+void Reference::invalidateCodes()
+{
+	cached_sql_code.clear();
+	cached_xml_code.clear();
 }
 
 void Reference::setDefinitionExpression(bool value)
 {
 	is_def_expr = value;
 	if(!value) clearReferencedTables();
+	invalidateCodes();
 }
 
 void Reference::addReferencedTable(PhysicalTable *ref_table)
@@ -75,7 +85,10 @@ void Reference::addReferencedTable(PhysicalTable *ref_table)
 		return;
 
 	if(std::find(ref_tables.begin(), ref_tables.end(), ref_table) == ref_tables.end())
+	{
 		ref_tables.push_back(ref_table);
+		invalidateCodes();
+	}
 }
 
 int Reference::getReferencedTableIndex(PhysicalTable *ref_table)
@@ -92,6 +105,7 @@ int Reference::getReferencedTableIndex(PhysicalTable *ref_table)
 void Reference::clearReferencedTables()
 {
 	ref_tables.clear();
+	invalidateCodes();
 }
 
 vector<PhysicalTable *> Reference::getReferencedTables()
@@ -134,6 +148,7 @@ void Reference::addColumn(const QString &name, PgSqlType type, const QString &al
 	}
 
 	columns.push_back(SimpleColumn(name, *type, alias));
+	invalidateCodes();
 }
 
 void Reference::addColumn(Column *col)
@@ -147,6 +162,7 @@ void Reference::addColumn(Column *col)
 void Reference::removeColumns()
 {
 	columns.clear();
+	invalidateCodes();
 }
 
 vector<SimpleColumn> Reference::getColumns()
@@ -192,6 +208,9 @@ void Reference::setReferenceAlias(const QString &alias)
 	if(alias.size() > BaseObject::ObjectNameMaxLength)
 		throw Exception(ErrorCode::AsgLongNameObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	if(ref_alias != alias)
+		invalidateCodes();
+
 	ref_alias = alias;
 }
 
@@ -205,6 +224,17 @@ QString Reference::getSQLDefinition(unsigned sql_type)
 	QString sql_def, tab_name;
 	unsigned refer_type;
 
+	/* An epoch mismatch means some object was renamed since the snippets were memoized,
+	 * possibly changing the referenced table/column names, so the caches are dropped */
+	if(cached_code_epoch!=BaseObject::getSignatureChangeCount())
+	{
+		invalidateCodes();
+		cached_code_epoch=BaseObject::getSignatureChangeCount();
+	}
+
+	if(cached_sql_code.count(sql_type))
+		return cached_sql_code[sql_type];
+
 	refer_type=getReferenceType();
 
 	//Case the reference is between the SELECT-FROM keywords
@@ -290,6 +320,7 @@ QString Reference::getSQLDefinition(unsigned sql_type)
 	}
 
 	sql_def=QString("   ") + sql_def;
+	cached_sql_code[sql_type]=sql_def;
 	return sql_def;
 }
 
@@ -300,6 +331,16 @@ QString Reference::getXMLDefinition()
 	Column col_aux;
 	QStringList ref_tab_names;
 
+	//See getSQLDefinition() for details about the epoch based cache expiration
+	if(cached_code_epoch!=BaseObject::getSignatureChangeCount())
+	{
+		invalidateCodes();
+		cached_code_epoch=BaseObject::getSignatureChangeCount();
+	}
+
+	if(!cached_xml_code.isEmpty())
+		return cached_xml_code;
+
 	attribs[Attributes::Table]="";
 	attribs[Attributes::Column]="";
 
@@ -333,7 +374,8 @@ QString Reference::getXMLDefinition()
 		}
 	}
 
-	return schparser.getCodeDefinition(Attributes::Reference, attribs, SchemaParser::XmlDefinition);
+	cached_xml_code=schparser.getCodeDefinition(Attributes::Reference, attribs, SchemaParser::XmlDefinition);
+	return cached_xml_code;
 }
 
 bool Reference::operator == (Reference &refer)
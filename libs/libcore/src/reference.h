@@ -63,6 +63,19 @@ class Reference {
 		 * when is_def_expr is set. These tables are used to hint the user which tables the view is using. */
 		vector<PhysicalTable *> ref_tables;
 
+		/*! \brief Memoizes the code snippets returned by getSQLDefinition() (indexed by the SqlRefer???
+		 constant) and getXMLDefinition(). The view code generation renders every reference each time the
+		 view's code is requested, so unchanged references are served as plain string copies */
+		map<unsigned, QString> cached_sql_code;
+		QString cached_xml_code;
+
+		/*! \brief Value of BaseObject::getSignatureChangeCount() when the snippets were cached. A mismatch
+		 denotes renames elsewhere in the model that may have changed the referenced table/column names */
+		unsigned cached_code_epoch;
+
+		//! \brief Drops the memoized code snippets. Called whenever some attribute of the reference changes
+		void invalidateCodes();
+
 	public:
 		//! \brief Constants used to define the reference type
 		static constexpr unsigned ReferColumn=0, //! \brief The reference is based on a table column
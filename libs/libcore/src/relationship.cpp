@@ -168,25 +168,12 @@ Relationship::Relationship(unsigned rel_type, PhysicalTable *src_tab,
 			tab_name_relnn=this->obj_name;
 			if(tab_name_relnn.size() > BaseObject::ObjectNameMaxLength)
 				tab_name_relnn.resize(BaseObject::ObjectNameMaxLength);
-
-			setNamePattern(PkPattern, GenTabToken + SuffixSeparator + QString("pk"));
-			setNamePattern(SrcFkPattern, SrcTabToken + SuffixSeparator + QString("fk"));
-			setNamePattern(DstFkPattern, DstTabToken + SuffixSeparator + QString("fk"));
-			setNamePattern(UqPattern, GenTabToken + SuffixSeparator + QString("uq"));
-			setNamePattern(SrcColPattern, SrcColToken + SuffixSeparator + SrcTabToken);
-			setNamePattern(DstColPattern, SrcColToken + SuffixSeparator + DstTabToken);
-			setNamePattern(PkColPattern, QString("id"));
-		}
-		else if(rel_type==RelationshipDep || rel_type==RelationshipGen)
-			setNamePattern(PkPattern, DstTabToken + SuffixSeparator + QString("pk"));
-		else
-		{
-			setNamePattern(PkPattern, DstTabToken + SuffixSeparator + QString("pk"));
-			setNamePattern(SrcFkPattern, SrcTabToken + SuffixSeparator + QString("fk"));
-			setNamePattern(UqPattern, DstTabToken + SuffixSeparator + QString("uq"));
-			setNamePattern(SrcColPattern, SrcColToken + SuffixSeparator + SrcTabToken);
 		}
 
+		/* The default name patterns aren't stored per instance: they are resolved against the
+		 shared immutable maps returned by getDefaultNamePatterns(). Only patterns customized
+		 through setNamePattern() create entries in name_patterns */
+
 		rejected_col_count=0;
 		setIdentifier(identifier);
 	}
@@ -196,6 +183,59 @@ Relationship::Relationship(unsigned rel_type, PhysicalTable *src_tab,
 	}
 }
 
+const map<unsigned, QString> &Relationship::getDefaultNamePatterns(unsigned rel_type)
+{
+	/* The default patterns depend only on the relationship type, so they are shared as
+	 immutable maps between all the relationship instances instead of being copied into
+	 each one. Models holding thousands of fk relationships with untouched patterns pay
+	 for these strings only once */
+	if(rel_type==RelationshipNn)
+	{
+		static const map<unsigned, QString> nn_patterns={
+			{ PkPattern, GenTabToken + SuffixSeparator + QString("pk") },
+			{ SrcFkPattern, SrcTabToken + SuffixSeparator + QString("fk") },
+			{ DstFkPattern, DstTabToken + SuffixSeparator + QString("fk") },
+			{ UqPattern, GenTabToken + SuffixSeparator + QString("uq") },
+			{ SrcColPattern, SrcColToken + SuffixSeparator + SrcTabToken },
+			{ DstColPattern, SrcColToken + SuffixSeparator + DstTabToken },
+			{ PkColPattern, QString("id") } };
+
+		return nn_patterns;
+	}
+	else if(rel_type==RelationshipDep || rel_type==RelationshipGen)
+	{
+		static const map<unsigned, QString> dep_gen_patterns={
+			{ PkPattern, DstTabToken + SuffixSeparator + QString("pk") } };
+
+		return dep_gen_patterns;
+	}
+	else
+	{
+		static const map<unsigned, QString> rel_patterns={
+			{ PkPattern, DstTabToken + SuffixSeparator + QString("pk") },
+			{ SrcFkPattern, SrcTabToken + SuffixSeparator + QString("fk") },
+			{ UqPattern, DstTabToken + SuffixSeparator + QString("uq") },
+			{ SrcColPattern, SrcColToken + SuffixSeparator + SrcTabToken } };
+
+		return rel_patterns;
+	}
+}
+
+const QString &Relationship::getPatternValue(unsigned pat_id)
+{
+	static const QString empty_pattern;
+	map<unsigned, QString>::const_iterator itr=name_patterns.find(pat_id);
+
+	if(itr!=name_patterns.end())
+		return itr->second;
+
+	const map<unsigned, QString> &def_patterns=getDefaultNamePatterns(rel_type);
+	itr=def_patterns.find(pat_id);
+
+	//Pattern ids without a default for the relationship type resolve to an empty pattern
+	return (itr!=def_patterns.end() ? itr->second : empty_pattern);
+}
+
 void Relationship::setNamePattern(unsigned pat_id, const QString &pattern)
 {
 	if(!pattern.isEmpty())
@@ -215,7 +255,18 @@ void Relationship::setNamePattern(unsigned pat_id, const QString &pattern)
 			throw Exception(Exception::getErrorMessage(ErrorCode::AsgInvalidNamePattern)
 							.arg(this->getName()),__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-		name_patterns[pat_id]=pattern;
+		/* Patterns equal to the shared default of the relationship type aren't stored,
+		 keeping the per-instance map restricted to real customizations. This also keeps
+		 the deduplication when a model is reloaded, since loading re-applies every
+		 pattern written to the xml code */
+		const map<unsigned, QString> &def_patterns=getDefaultNamePatterns(rel_type);
+		map<unsigned, QString>::const_iterator itr=def_patterns.find(pat_id);
+
+		if(itr!=def_patterns.end() && itr->second==pattern)
+			name_patterns.erase(pat_id);
+		else
+			name_patterns[pat_id]=pattern;
+
 		this->invalidated=true;
 	}
 }
@@ -225,14 +276,14 @@ QString Relationship::getNamePattern(unsigned pat_id)
 	if(pat_id > PkColPattern)
 		throw Exception(ErrorCode::RefInvalidNamePatternId,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-	return name_patterns[pat_id];
+	return getPatternValue(pat_id);
 }
 
 QString Relationship::generateObjectName(unsigned pat_id, Column *id_col, bool use_alias)
 {
 	QString name, aux_name;
 
-	name=name_patterns[pat_id];
+	name=getPatternValue(pat_id);
 	name.replace(GenTabToken, (rel_type==RelationshipNn ? tab_name_relnn : ""));
 
 	if(rel_type==RelationshipNn)
@@ -585,6 +636,11 @@ void Relationship::addObject(TableObject *tab_obj, int obj_idx)
 	}
 }
 
+Relationship::~Relationship()
+{
+	destroyPreviousGenColumns();
+}
+
 void Relationship::destroyObjects()
 {
 	while(!rel_constraints.empty())
@@ -598,6 +654,8 @@ void Relationship::destroyObjects()
 		delete rel_attributes.back();
 		rel_attributes.pop_back();
 	}
+
+	destroyPreviousGenColumns();
 }
 
 void Relationship::removeObject(unsigned obj_id, ObjectType obj_type)
@@ -897,6 +955,38 @@ void Relationship::addConstraints(PhysicalTable *recv_tab)
 	}
 }
 
+Column *Relationship::getPreviousGenColumn(const QString &name)
+{
+	vector<Column *>::iterator itr, itr_end;
+	Column *column=nullptr;
+
+	itr=prev_gen_columns.begin();
+	itr_end=prev_gen_columns.end();
+
+	while(itr!=itr_end)
+	{
+		if((*itr)->getName()==name)
+		{
+			column=(*itr);
+			prev_gen_columns.erase(itr);
+			break;
+		}
+
+		itr++;
+	}
+
+	return column;
+}
+
+void Relationship::destroyPreviousGenColumns()
+{
+	while(!prev_gen_columns.empty())
+	{
+		delete prev_gen_columns.back();
+		prev_gen_columns.pop_back();
+	}
+}
+
 void Relationship::addColumnsRelGenPart()
 {
 	PhysicalTable *src_tab=nullptr, *dst_tab=nullptr,
@@ -1052,8 +1142,13 @@ void Relationship::addColumnsRelGenPart()
 				//In case there is no column duplicity
 				if(!duplic)
 				{
+					/* Reuses, whenever possible, the column instance generated on a previous
+					 connection (matched by name) instead of allocating a brand new copy */
+					column=getPreviousGenColumn(dst_col->getName());
+
 					//Creates a new column making the initial configurations
-					column=new Column;
+					if(!column)
+						column=new Column;
 
 					(*column)=(*dst_col);
 
@@ -1105,6 +1200,10 @@ void Relationship::addColumnsRelGenPart()
 				src_tab->addColumn((*itr));
 				itr++;
 			}
+
+			/* Columns generated previously but not reused by this connection don't exist
+			 anymore on the reference table so they are destroyed */
+			destroyPreviousGenColumns();
 		}
 		else
 		{
@@ -2300,7 +2399,12 @@ void Relationship::disconnectRelationship(bool rem_tab_objs)
 				table->removeColumn(column->getName());
 				itr++;
 
-				delete column;
+				/* Columns propagated by inheritance/copy/partition relationships are kept
+				 alive to be reused on the next connection (see addColumnsRelGenPart) */
+				if(rel_type==RelationshipGen || rel_type==RelationshipDep || rel_type==RelationshipPart)
+					prev_gen_columns.push_back(column);
+				else
+					delete column;
 			}
 
 			gen_columns.clear();
@@ -2659,13 +2763,13 @@ QString Relationship::getCodeDefinition(unsigned def_type)
 		attributes[Attributes::RelationshipDep]=(rel_type==RelationshipDep ? Attributes::True : "");
 		attributes[Attributes::RelationshipPart]=(rel_type==RelationshipPart ? Attributes::True : "");
 
-		attributes[Attributes::SrcColPattern]=name_patterns[SrcColPattern];
-		attributes[Attributes::DstColPattern]=name_patterns[DstColPattern];
-		attributes[Attributes::PkPattern]=name_patterns[PkPattern];
-		attributes[Attributes::UqPattern]=name_patterns[UqPattern];
-		attributes[Attributes::SrcFkPattern]=name_patterns[SrcFkPattern];
-		attributes[Attributes::DstFkPattern]=name_patterns[DstFkPattern];
-		attributes[Attributes::PkColPattern]=name_patterns[PkColPattern];
+		attributes[Attributes::SrcColPattern]=getPatternValue(SrcColPattern);
+		attributes[Attributes::DstColPattern]=getPatternValue(DstColPattern);
+		attributes[Attributes::PkPattern]=getPatternValue(PkPattern);
+		attributes[Attributes::UqPattern]=getPatternValue(UqPattern);
+		attributes[Attributes::SrcFkPattern]=getPatternValue(SrcFkPattern);
+		attributes[Attributes::DstFkPattern]=getPatternValue(DstFkPattern);
+		attributes[Attributes::PkColPattern]=getPatternValue(PkColPattern);
 
 		attributes[Attributes::PartitionBoundExpr]=part_bounding_expr;
 
@@ -2735,6 +2839,7 @@ void Relationship::operator = (Relationship &rel)
 	this->table_relnn=nullptr;
 	this->fk_rel1n=pk_relident=pk_special=nullptr;
 	this->gen_columns.clear();
+	this->prev_gen_columns.clear();
 	this->copy_options=rel.copy_options;
 	this->name_patterns=rel.name_patterns;
 	this->upd_action=rel.upd_action;
@@ -152,9 +152,26 @@ class Relationship: public BaseRelationship {
 			and finally this map is cleared */
 		map<unsigned, QString> prev_ref_col_names;
 
-		//! \brief This map stores the name patterns for objects generated by relationship
+		/*! \brief Columns generated by inheritance/copy/partition relationships on a previous
+			connection, kept alive across disconnections so they can be reused on the next one
+			(copy-on-write fashion). Reusing the instances avoids reallocating and recopying the
+			whole propagated column set on every validation round and keeps the column pointers
+			stable between rounds on deep hierarchies */
+		vector<Column *> prev_gen_columns;
+
+		/*! \brief Stores only the customized name patterns for objects generated by the relationship.
+		 Patterns not present here are resolved against the shared immutable defaults of the
+		 relationship type (see getDefaultNamePatterns()), so the thousands of relationships of a
+		 model with unmodified patterns don't pay per-instance copies of identical descriptors */
 		map<unsigned, QString> name_patterns;
 
+		//! \brief Returns the shared immutable default name patterns for the given relationship type
+		static const map<unsigned, QString> &getDefaultNamePatterns(unsigned rel_type);
+
+		/*! \brief Returns the effective value of a name pattern: the customized entry when present,
+		 otherwise the shared default of the relationship type (empty if the type doesn't define it) */
+		const QString &getPatternValue(unsigned pat_id);
+
 		//! \brief Relationship attributes (used as columns on the receiver table)
 		vector<TableObject *> rel_attributes;
 
@@ -229,6 +246,14 @@ class Relationship: public BaseRelationship {
 		 to check duplicate names and incompatible types of columns */
 		void addColumnsRelGenPart();
 
+		/*! \brief Returns the column generated on a previous connection whose name matches the
+		 provided one, removing it from the reusable column list. Returns nullptr when there is
+		 no reusable column with that name */
+		Column *getPreviousGenColumn(const QString &name);
+
+		//! \brief Destroys the columns generated on a previous connection that weren't reused
+		void destroyPreviousGenColumns();
+
 		/*! \brief Copy constraints from the parent table to the child. Currently, only
 		check constraints are copied only if the NO INHERIT attribute is not set and
 		there are no conflicting constraints (name or expression) on the child table */
@@ -323,6 +348,8 @@ class Relationship: public BaseRelationship {
 					 ActionType fk_upd_act=ActionType::Null,
 					 CopyOptions copy_op = CopyOptions(0,0));
 
+		virtual ~Relationship();
+
 		//! \brief  Connects the relationship making the configuration according to its type
 		void connectRelationship();
 
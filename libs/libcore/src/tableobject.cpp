@@ -25,6 +25,21 @@ TableObject::TableObject()
 	add_by_linking=add_by_generalization=add_by_copy=false;
 }
 
+void TableObject::setName(const QString &name)
+{
+	/* Renaming a child attached to a table expires the child name lookup indexes kept by
+	 * the parent, otherwise further name lookups could be served from stale entries. The
+	 * global signature change counter is bumped as well since codes generated from the
+	 * child's name (e.g. view references) rely on it to expire their own caches */
+	if(parent_table && this->obj_name!=name)
+	{
+		parent_table->invalidateChildNamesIndexes();
+		signature_change_count++;
+	}
+
+	BaseObject::setName(name);
+}
+
 void TableObject::setParentTable(BaseTable *table)
 {
 	parent_table=table;
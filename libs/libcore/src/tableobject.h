@@ -67,6 +67,10 @@ class TableObject: public BaseObject {
 	public:
 		TableObject();
 
+		/*! \brief Defines the object's name. Renaming a table child also expires the child name
+		 lookup indexes kept by the parent table (see PhysicalTable::getObject()) */
+		virtual void setName(const QString &name);
+
 		//! \brief Defines the parent table for the object
 		virtual void setParentTable(BaseTable *table);
 
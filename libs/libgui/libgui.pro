@@ -79,6 +79,7 @@ src/tools/metadatahandlingform.cpp \
 src/tools/modelexporthelper.cpp \
 src/tools/modelsdiffhelper.cpp \
 src/tools/sqlexecutionwidget.cpp \
+src/tools/sqlhistorystore.cpp \
 src/tools/validationinfo.cpp \
 src/tools/modelvalidationhelper.cpp \
 src/tools/swapobjectsidswidget.cpp \
@@ -195,6 +196,7 @@ src/tools/metadatahandlingform.h \
 src/tools/modelexporthelper.h \
 src/tools/modelsdiffhelper.h \
 src/tools/sqlexecutionwidget.h \
+src/tools/sqlhistorystore.h \
 src/tools/validationinfo.h \
 src/tools/modelvalidationhelper.h \
 src/tools/swapobjectsidswidget.h \
@@ -453,11 +453,11 @@ void TableWidget::listObjects(ObjectType obj_type)
 		tab->removeRows();
 		count = table->getObjectCount(obj_type);
 
+		//Creating all rows in a single batch instead of row-by-row to speed up the population of large tables
+		tab->addRows(count);
+
 		for(idx = 0; idx < count; idx++)
-		{
-			tab->addRow();
 			showObjectData(dynamic_cast<TableObject*>(table->getObject(idx, obj_type)), idx);
-		}
 
 		tab->clearSelection();
 		tab->blockSignals(false);
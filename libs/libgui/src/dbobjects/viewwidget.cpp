@@ -424,11 +424,10 @@ void ViewWidget::listObjects(ObjectType obj_type)
 		tab->removeRows();
 
 		count=view->getObjectCount(obj_type);
+		tab->addRows(count);
+
 		for(i=0; i < count; i++)
-		{
-			tab->addRow();
 			showObjectData(dynamic_cast<TableObject*>(view->getObject(i, obj_type)), i);
-		}
 		tab->clearSelection();
 		tab->blockSignals(false);
 	}
@@ -313,6 +313,23 @@ namespace GuiUtilsNs {
 		return getIconPath(BaseObject::getSchemaName(obj_type));
 	}
 
+	QIcon getCachedIcon(const QString &icon)
+	{
+		//Process-wide icon cache indexed by the icon name (see getIconPath)
+		static map<QString, QIcon> icon_cache;
+		auto itr=icon_cache.find(icon);
+
+		if(itr==icon_cache.end())
+			itr=icon_cache.insert({ icon, QIcon(getIconPath(icon)) }).first;
+
+		return itr->second;
+	}
+
+	QIcon getCachedIcon(ObjectType obj_type)
+	{
+		return getCachedIcon(BaseObject::getSchemaName(obj_type));
+	}
+
 	void resizeDialog(QWidget *widget)
 	{
 		QSize min_size=widget->minimumSize();
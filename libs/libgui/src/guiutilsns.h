@@ -29,6 +29,7 @@
 #include <QListWidget>
 #include <QTableWidget>
 #include <QPixmap>
+#include <QIcon>
 #include "baseobject.h"
 #include "widgets/numberedtexteditor.h"
 
@@ -81,6 +82,15 @@ namespace GuiUtilsNs {
 	//! \brief Returns the path, in the icon resource, to the icon of the provided object type
 	extern QString getIconPath(ObjectType obj_type);
 
+	/*! \brief Returns a process-wide shared icon for the provided icon name. The icon is decoded
+	from the resources only once and the returned QIcon additionally caches its rasterizations per
+	size and device pixel ratio, so heavy per-item usages (object tree, finder results, output
+	trees) don't decode nor rescale the same image over and over */
+	extern QIcon getCachedIcon(const QString &icon);
+
+	//! \brief Returns a process-wide shared icon for the provided object type
+	extern QIcon getCachedIcon(ObjectType obj_type);
+
 	//! \brief Resizes the provided dialog considering font dpi changes as well screen size
 	extern void resizeDialog(QWidget *dialog);
 
@@ -21,6 +21,8 @@
 #include "tools/bugreportform.h"
 #include "tools/metadatahandlingform.h"
 #include "tools/sqlexecutionwidget.h"
+#include "taskscheduler.h"
+#include <QtConcurrent/QtConcurrent>
 
 bool MainWindow::confirm_validation=true;
 int MainWindow::GeneralActionsCount=0;
@@ -37,6 +39,7 @@ MainWindow::MainWindow(QWidget *parent, Qt::WindowFlags flags) : QMainWindow(par
 	QGridLayout *grid=nullptr;
 
 	pending_op=NoPendingOp;
+	dock_wgts_update_pending=false;
 	central_wgt=nullptr;
 
 	layers_cfg_wgt = new LayersConfigWidget(this);
@@ -212,6 +215,7 @@ MainWindow::MainWindow(QWidget *parent, Qt::WindowFlags flags) : QMainWindow(par
 	connect(action_normal_zoom,SIGNAL(triggered(bool)),this,SLOT(applyZoom()));
 
 	connect(action_load_model,SIGNAL(triggered(bool)),this,SLOT(loadModel()));
+	connect(action_open_viewer,SIGNAL(triggered(bool)),this,SLOT(loadModelAsViewer()));
 	connect(action_save_model,SIGNAL(triggered(bool)),this,SLOT(saveModel()));
 	connect(action_save_as,SIGNAL(triggered(bool)),this,SLOT(saveModel()));
 	connect(action_save_all,SIGNAL(triggered(bool)),this,SLOT(saveAllModels()));
@@ -355,6 +359,21 @@ MainWindow::MainWindow(QWidget *parent, Qt::WindowFlags flags) : QMainWindow(par
 
 	connect(&tmpmodel_save_timer, SIGNAL(timeout()), this, SLOT(saveTemporaryModels()));
 
+	//Loads the session models queued for lazy loading while the application stays idle
+	idle_load_timer.setInterval(500);
+	connect(&idle_load_timer, SIGNAL(timeout()), this, SLOT(loadPendingModelOnIdle()));
+
+	/* Keeps the warm pooled connections alive (and weeds out the dead ones) so SQL tabs and
+	 * data grids opened against a recently used server skip the connect/auth round-trip.
+	 * The keepalive round-trips run on a worker thread since they may block over slow links */
+	pool_keepalive_timer.setInterval(240000);
+	connect(&pool_keepalive_timer, &QTimer::timeout, [](){
+		QtConcurrent::run(&TaskScheduler::getThreadPool(), [](){
+			Connection::refreshConnectionPool();
+		});
+	});
+	pool_keepalive_timer.start();
+
 	models_tbw_parent->resize(QSize(models_tbw_parent->maximumWidth(), models_tbw_parent->height()));
 
 	//Forcing the splitter that handles the bottom widgets to resize its children to their minimum size
@@ -602,12 +621,23 @@ void MainWindow::restoreLastSession()
 		{
 			qApp->setOverrideCursor(Qt::WaitCursor);
 
+			/* The tabs of all session files are created right away but only the focused model
+			 * is loaded immediately, making the window usable without waiting for the whole
+			 * session. The background models are loaded upon the activation of their tabs or
+			 * progressively while the application stays idle (see loadPendingModelOnIdle) */
 			while(!prev_session_files.isEmpty())
 			{
-				this->addModel(prev_session_files.front());
+				this->addPendingModel(prev_session_files.front());
 				prev_session_files.pop_front();
 			}
 
+			/* Making the last tab the focused one. The pending model bound to it is
+			 * loaded by the lazy loading hook placed in setCurrentModel() */
+			setCurrentModel();
+
+			if(!pending_model_files.empty())
+				idle_load_timer.start();
+
 			action_restore_session->setEnabled(false);
 			central_wgt->last_session_tb->setEnabled(false);
 			qApp->restoreOverrideCursor();
@@ -791,8 +821,6 @@ void MainWindow::closeEvent(QCloseEvent *event)
 
 			conf_wgt->saveConfiguration();
 			restoration_form->removeTemporaryFiles();
-
-			SQLExecutionWidget::saveSQLHistory();
 			qApp->quit();
 		}
 	}
@@ -842,7 +870,7 @@ void MainWindow::saveTemporaryModels()
 				bg_saving_pb->setValue(((i+1)/static_cast<double>(count)) * 100);
 
 				if(model->isModified())
-					model->getDatabaseModel()->saveModel(model->getTempFilename(), SchemaParser::XmlDefinition);
+					model->saveTemporaryModel();
 			}
 
 			bg_saving_pb->setValue(100);
@@ -922,7 +950,7 @@ void MainWindow::clearRecentModelsMenu()
 	updateRecentModelsMenu();
 }
 
-void MainWindow::addModel(const QString &filename)
+void MainWindow::addModel(const QString &filename, bool viewer_mode)
 {
 #ifdef DEMO_VERSION
 #warning "DEMO VERSION: database model creation limit."
@@ -976,8 +1004,11 @@ void MainWindow::addModel(const QString &filename)
 				model_tab->db_model->setInvalidated(false);
 				model_tab->restoreLastCanvasPosition();
 
-				//Making a copy of the loaded database model file as the first version of the temp. model
-				QFile::copy(filename, model_tab->getTempFilename());
+				if(viewer_mode)
+					model_tab->setViewerMode(true);
+				else
+					//Making a copy of the loaded database model file as the first version of the temp. model
+					QFile::copy(filename, model_tab->getTempFilename());
 			}
 			catch(Exception &e)
 			{
@@ -1020,6 +1051,129 @@ void MainWindow::addModel(const QString &filename)
 	}
 }
 
+void MainWindow::addPendingModel(const QString &filename)
+{
+	try
+	{
+		ModelWidget *model_tab=nullptr;
+		bool start_timers=(models_tbw->count() == 0);
+
+		model_tab=new ModelWidget;
+		model_tab->setObjectName(QString("model_%1").arg(models_tbw->count()));
+
+		/* The tab is named after the model file since the database name is known
+		 * only when the pending model is effectively loaded */
+		models_tbw->blockSignals(true);
+		models_tbw->setUpdatesEnabled(false);
+		models_tbw->addTab(model_tab, QFileInfo(filename).completeBaseName());
+		models_tbw->setTabToolTip(models_tbw->count()-1, filename);
+		models_tbw->setCurrentIndex(models_tbw->count()-1);
+		models_tbw->blockSignals(false);
+		models_tbw->currentWidget()->layout()->setContentsMargins(3,3,0,3);
+
+		/* The system objects are created without the public schema since that one
+		 * comes from the model file when the pending model is effectively loaded */
+		model_tab->db_model->createSystemObjects(false);
+
+		pending_model_files[model_tab]=filename;
+
+		model_nav_wgt->addModel(model_tab);
+		model_nav_wgt->updateModelText(models_tbw->count()-1, QFileInfo(filename).completeBaseName(), filename);
+		models_tbw->setUpdatesEnabled(true);
+		models_tbw->setVisible(true);
+
+		if(start_timers)
+		{
+			if(model_save_timer.interval() > 0)
+				model_save_timer.start();
+
+			tmpmodel_save_timer.start();
+		}
+
+		model_tab->setModified(false);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+bool MainWindow::loadPendingModel(ModelWidget *model_tab)
+{
+	auto itr=pending_model_files.find(model_tab);
+
+	if(itr==pending_model_files.end())
+		return false;
+
+	QString filename=itr->second;
+	Schema *public_sch=nullptr;
+	int tab_idx=models_tbw->indexOf(model_tab);
+
+	//Removing the entry beforehand so a loading failure doesn't leave the tab flagged as pending
+	pending_model_files.erase(itr);
+
+	if(pending_model_files.empty())
+		idle_load_timer.stop();
+
+	try
+	{
+		qApp->setOverrideCursor(Qt::WaitCursor);
+		model_tab->loadModel(filename);
+
+		//Get the "public" schema and set as system object
+		public_sch=dynamic_cast<Schema *>(model_tab->db_model->getObject(QString("public"), ObjectType::Schema));
+		if(public_sch)	public_sch->setSystemObject(true);
+
+		model_tab->db_model->setInvalidated(false);
+		model_tab->restoreLastCanvasPosition();
+
+		//Making a copy of the loaded database model file as the first version of the temp. model
+		QFile::copy(filename, model_tab->getTempFilename());
+
+		models_tbw->setTabText(tab_idx, model_tab->db_model->getName());
+		model_nav_wgt->updateModelText(tab_idx, model_tab->db_model->getName(), filename);
+		model_tab->setModified(false);
+
+		if(model_tab==current_model)
+			action_save_model->setEnabled(false);
+
+		qApp->restoreOverrideCursor();
+	}
+	catch(Exception &e)
+	{
+		qApp->restoreOverrideCursor();
+
+		//Removing the tab since it holds a partially loaded model
+		model_nav_wgt->removeModel(tab_idx);
+		models_tbw->removeTab(tab_idx);
+		model_tab->setParent(nullptr);
+
+		//Destroy the temp file generated by allocating a new model widget
+		restoration_form->removeTemporaryModel(model_tab->getTempFilename());
+
+		Messagebox msg_box;
+		msg_box.show(e);
+	}
+
+	return true;
+}
+
+void MainWindow::loadPendingModelOnIdle()
+{
+	if(pending_model_files.empty())
+	{
+		idle_load_timer.stop();
+		return;
+	}
+
+	/* The background loading is postponed while the user interacts with a modal dialog
+	 * or holds a mouse button pressed, so it doesn't disturb the current activity */
+	if(qApp->activeModalWidget() || qApp->mouseButtons()!=Qt::NoButton)
+		return;
+
+	loadPendingModel(pending_model_files.begin()->first);
+}
+
 void MainWindow::addModel(ModelWidget *model_wgt)
 {
 	try
@@ -1098,6 +1252,13 @@ void MainWindow::setCurrentModel()
 
 	models_tbw->setCurrentIndex(model_nav_wgt->getCurrentIndex());
 	current_model=dynamic_cast<ModelWidget *>(models_tbw->currentWidget());
+
+	/* Session models queued for lazy loading are effectively loaded upon the first
+	 * activation of their tabs. On a loading failure the tab is closed, so the
+	 * current model reference is reevaluated */
+	if(current_model && loadPendingModel(current_model))
+		current_model=dynamic_cast<ModelWidget *>(models_tbw->currentWidget());
+
 	action_arrange_objects->setEnabled(current_model != nullptr);
 
 	QFile::remove(GlobalAttributes::getTemporaryFilePath(GlobalAttributes::LastModelFile));
@@ -1322,6 +1483,7 @@ void MainWindow::closeModel(int model_id)
 		{
 			model_nav_wgt->removeModel(model_id);
 			model_tree_states.erase(model);
+			pending_model_files.erase(model);
 
 			disconnect(model, nullptr, nullptr, nullptr);
 			disconnect(action_alin_objs_grade, nullptr, this, nullptr);
@@ -1487,7 +1649,7 @@ void MainWindow::saveModel(ModelWidget *model)
 
 					file_dlg.setDefaultSuffix(QString("dbm"));
 					file_dlg.setWindowTitle(tr("Save '%1' as...").arg(model->db_model->getName()));
-					file_dlg.setNameFilter(tr("Database model (*.dbm);;All files (*.*)"));
+					file_dlg.setNameFilter(tr("Database model (*.dbm);;Compressed database model (*.dbmz);;All files (*.*)"));
 					file_dlg.setFileMode(QFileDialog::AnyFile);
 					file_dlg.setAcceptMode(QFileDialog::AcceptSave);
 					file_dlg.setModal(true);
@@ -1711,7 +1873,7 @@ void MainWindow::loadModel()
 
 	try
 	{
-		file_dlg.setNameFilter(tr("Database model (*.dbm);;All files (*.*)"));
+		file_dlg.setNameFilter(tr("Database model (*.dbm *.dbmz);;All files (*.*)"));
 		file_dlg.setWindowIcon(QPixmap(GuiUtilsNs::getIconPath("pgsqlModeler48x48")));
 		file_dlg.setWindowTitle(tr("Load model"));
 		file_dlg.setFileMode(QFileDialog::ExistingFiles);
@@ -1727,12 +1889,34 @@ void MainWindow::loadModel()
 	}
 }
 
+void MainWindow::loadModelAsViewer()
+{
+	QFileDialog file_dlg;
+
+	try
+	{
+		file_dlg.setNameFilter(tr("Database model (*.dbm *.dbmz);;All files (*.*)"));
+		file_dlg.setWindowIcon(QPixmap(GuiUtilsNs::getIconPath("pgsqlModeler48x48")));
+		file_dlg.setWindowTitle(tr("Open model in viewer mode"));
+		file_dlg.setFileMode(QFileDialog::ExistingFiles);
+		file_dlg.setAcceptMode(QFileDialog::AcceptOpen);
+
+		if(file_dlg.exec()==QFileDialog::Accepted)
+			loadModels(file_dlg.selectedFiles(), true);
+	}
+	catch(Exception &e)
+	{
+		Messagebox msg_box;
+		msg_box.show(e);
+	}
+}
+
 void MainWindow::loadModel(const QString &filename)
 {
 	loadModels({ filename });
 }
 
-void MainWindow::loadModels(const QStringList &list)
+void MainWindow::loadModels(const QStringList &list, bool viewer_mode)
 {
 	int i=0;
 
@@ -1742,7 +1926,7 @@ void MainWindow::loadModels(const QStringList &list)
 
 		for(i=0; i < list.count(); i++)
 		{
-			addModel(list[i]);
+			addModel(list[i], viewer_mode);
 			recent_models.push_front(list[i]);
 		}
 
@@ -1783,10 +1967,11 @@ void MainWindow::__updateToolsState()
 
 void MainWindow::updateToolsState(bool model_closed)
 {
-	bool enabled=(!model_closed && current_model);
+	bool enabled=(!model_closed && current_model),
+			viewer_mode=(current_model && current_model->isViewerMode());
 
 	action_print->setEnabled(enabled);
-	action_save_as->setEnabled(enabled);
+	action_save_as->setEnabled(enabled && !viewer_mode);
 	action_save_model->setEnabled(!model_closed && current_model && current_model->isModified());
 	action_save_all->setEnabled(enabled);
 	action_export->setEnabled(enabled);
@@ -1818,6 +2003,19 @@ void MainWindow::updateToolsState(bool model_closed)
 
 void MainWindow::updateDockWidgets()
 {
+	/* The modification/creation/removal signals fired per object during bulk operations
+	 * (paste, multi-delete, undo/redo) all land here, so the expensive rebuild of the dock
+	 * widgets is deferred to a single flush executed when the event loop regains control */
+	if(dock_wgts_update_pending)
+		return;
+
+	dock_wgts_update_pending=true;
+	QTimer::singleShot(0, this, SLOT(flushDockWidgetsUpdate()));
+}
+
+void MainWindow::flushDockWidgetsUpdate()
+{
+	dock_wgts_update_pending=false;
 	oper_list_wgt->updateOperationList();
 	model_objs_wgt->updateObjectsView();
 
@@ -75,8 +75,21 @@ class MainWindow: public QMainWindow, public Ui::MainWindow {
 
 		unsigned pending_op;
 
+		/*! \brief Indicates that a dock widgets update is already scheduled for the next event
+		loop turn, absorbing the repeated requests of a burst (see updateDockWidgets()) */
+		bool dock_wgts_update_pending;
+
 		//! \brief Timer used for auto saving the model and temporary model.
-		QTimer model_save_timer,	tmpmodel_save_timer;
+		QTimer model_save_timer,	tmpmodel_save_timer,
+
+		/*! \brief Timer used to progressively load the session models queued for lazy
+		loading (see addPendingModel) while the application stays idle */
+		idle_load_timer,
+
+		/*! \brief Timer used to periodically health-check the warm server connections parked
+		on the pool so opening a new SQL tab or data grid against a recently used server
+		reuses a live descriptor instead of paying a full connect/auth round-trip */
+		pool_keepalive_timer;
 
 		AboutWidget *about_wgt;
 
@@ -130,6 +143,12 @@ class MainWindow: public QMainWindow, public Ui::MainWindow {
 		//! \brief Stores the model objects tree state for each opened model
 		map<ModelWidget *, vector<BaseObject *> > model_tree_states;
 
+		/*! \brief Stores the model files queued for lazy loading during the session restoration,
+		keyed by the tab (model widget) created to receive each one. The focused model is loaded
+		right away while the background ones are loaded upon the activation of their tabs or
+		progressively while the application is idle (see idle_load_timer) */
+		map<ModelWidget *, QString> pending_model_files;
+
 		//! \brief Stores the defaul window title
 		QString window_title;
 
@@ -189,21 +208,33 @@ class MainWindow: public QMainWindow, public Ui::MainWindow {
 		MainWindow(QWidget *parent = nullptr, Qt::WindowFlags flags = Qt::Widget);
 		virtual ~MainWindow();
 
-		//! \brief Loads a set of models from string list
-		void loadModels(const QStringList &list);
+		/*! \brief Loads a set of models from string list. When 'viewer_mode' is true the models
+		are opened in viewer (read-only) mode */
+		void loadModels(const QStringList &list, bool viewer_mode=false);
 
 		//! \brief Indicates if model must be validated before save, diff or export
 		static void setConfirmValidation(bool value);
 
 	public slots:
 		/*! \brief Creates a new empty model inside the main window. If the parameter 'filename' is specified,
-		creates the model loading it from a file */
-		void addModel(const QString &filename="");
+		creates the model loading it from a file. When 'viewer_mode' is true the loaded model is put in
+		read-only mode (see ModelWidget::setViewerMode) */
+		void addModel(const QString &filename="", bool viewer_mode=false);
 
 		/*! \brief Creates a new model inside the main window using the specified model widget. The method will raise
 		an error is the widget isn't allocated or already has a parent */
 		void addModel(ModelWidget *model_wgt);
 
+		/*! \brief Creates an empty model tab bound to the provided filename without loading the file.
+		The model is effectively loaded by loadPendingModel() when the tab gets activated or while
+		the application is idle. Used by the session restoration to make the window usable right away */
+		void addPendingModel(const QString &filename);
+
+		/*! \brief Loads the model file bound to the provided tab by addPendingModel(). Returns true when
+		the tab was a pending one, whether the loading succeeded or not. On failure the tab is closed and
+		the error is presented to the user */
+		bool loadPendingModel(ModelWidget *model_tab);
+
 		//! \brief Closes the currently focused model. If the 'model_id' is specified the model at given index is closed
 		void closeModel(int model_id=-1);
 
@@ -234,15 +265,26 @@ class MainWindow: public QMainWindow, public Ui::MainWindow {
 		void updateToolsState(bool model_closed=false);
 		void __updateToolsState();
 
-		//! \brief Updates the operation list and model objects dockwidgets
+		/*! \brief Schedules an update of the operation list and model objects dockwidgets. The
+		per-object signals emitted by bulk operations arrive in bursts, so the requests are
+		coalesced: the first one schedules a single flush on the next event loop turn and the
+		remaining ones are absorbed by the pending flag (see flushDockWidgetsUpdate()) */
 		void updateDockWidgets();
 
+		//! \brief Performs the dock widgets update scheduled by updateDockWidgets()
+		void flushDockWidgetsUpdate();
+
 		//! \brief Updates the reference to the current model when changing the tab focus
 		void setCurrentModel();
 
 		//! \brief Loads a model from a file via file dialog
 		void loadModel();
 
+		/*! \brief Loads a model from a file via file dialog putting it in viewer (read-only) mode.
+		Since the undo/redo history and the editing structures are disabled this is the cheapest
+		way to open a model just for reading */
+		void loadModelAsViewer();
+
 		//! \brief Loads a model from a specified filename
 		void loadModel(const QString &filename);
 
@@ -294,6 +336,10 @@ class MainWindow: public QMainWindow, public Ui::MainWindow {
 		//! \brief Save the temp files for all opened models
 		void saveTemporaryModels();
 
+		/*! \brief Loads one of the models queued for lazy loading by the session restoration
+		whenever the application becomes idle (see idle_load_timer) */
+		void loadPendingModelOnIdle();
+
 		//! \brief Opens the pgModeler Wiki in a web browser window
 		void openSupport();
 
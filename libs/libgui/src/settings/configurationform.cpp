@@ -17,6 +17,7 @@
 */
 
 #include "configurationform.h"
+#include "performancecounters.h"
 
 ConfigurationForm::ConfigurationForm(QWidget *parent, Qt::WindowFlags f) : QDialog(parent, f)
 {
@@ -115,6 +116,11 @@ void ConfigurationForm::loadConfiguration()
 		try
 		{
 			config_wgt = qobject_cast<BaseConfigWidget *>(confs_stw->widget(i));
+
+			/* Timing each configuration widget individually (plugin scan included) so the
+			 * startup phase breakdown (see --startup-timings) can point to the section that
+			 * slowed the configuration loading down */
+			PerformanceCounters::ScopedTimer perf_timer(QString("Startup: %1").arg(config_wgt->metaObject()->className()));
 			config_wgt->loadConfiguration();
 		}
 		catch(Exception &e)
@@ -19,6 +19,9 @@
 #include "connectionsconfigwidget.h"
 #include "guiutilsns.h"
 #include "baseform.h"
+#include "taskscheduler.h"
+#include <QtConcurrent/QtConcurrent>
+#include <QThread>
 
 vector<Connection *> ConnectionsConfigWidget::connections;
 map<QString, attribs_map> ConnectionsConfigWidget::config_params;
@@ -410,8 +413,38 @@ void ConnectionsConfigWidget::testConnection()
 	try
 	{
 		this->configureConnection(&conn);
-		conn.connect();
-		srv_info=conn.getServerInfo();
+
+		/* The connection is established on a worker thread while the event loop keeps
+		spinning, so an unreachable host doesn't freeze the UI for the whole timeout */
+		QString error_msg;
+		QFuture<void> future=QtConcurrent::run(&TaskScheduler::getThreadPool(), [&conn, &srv_info, &error_msg](){
+			try
+			{
+				conn.connect();
+				srv_info=conn.getServerInfo();
+				conn.close();
+			}
+			catch(Exception &e)
+			{
+				error_msg=e.getErrorMessage();
+			}
+		});
+
+		qApp->setOverrideCursor(Qt::WaitCursor);
+		test_tb->setEnabled(false);
+
+		while(!future.isFinished())
+		{
+			QApplication::processEvents();
+			QThread::msleep(20);
+		}
+
+		test_tb->setEnabled(true);
+		qApp->restoreOverrideCursor();
+
+		if(!error_msg.isEmpty())
+			throw Exception(error_msg, ErrorCode::ConnectionNotStablished, __PRETTY_FUNCTION__,__FILE__,__LINE__);
+
 		msg_box.show(tr("Success"),
 					 GuiUtilsNs::formatMessage(tr("Connection successfully established!\n\nServer details:\n\nPID: `%1'\nProtocol: `%2'\nVersion: `%3'"))
 					 .arg(srv_info[Connection::ServerPid])
@@ -1018,6 +1018,12 @@ void DatabaseExplorerWidget::listObjects()
 		bool quick_refresh=(act ? act->data().toBool() : true);
 
 		configureImportHelper();
+
+		/* The full refresh drops the whole catalog snapshot so every branch is re-queried, while the
+		 * quick refresh keeps it, restoring the previously expanded branches without server round trips */
+		if(!quick_refresh)
+			import_helper.invalidateCachedQueries();
+
 		objects_trw->blockSignals(true);
 
 		saveTreeState();
@@ -1067,6 +1073,11 @@ void DatabaseExplorerWidget::configureImportHelper()
 																 show_ext_objs->isChecked(),
 																 false, false, false, false, false);
 
+	/* The catalog listings are served from a local snapshot so re-expanding branches (e.g. after a
+	 * quick refresh restores the tree state) doesn't pay a server round trip per node. Explicit
+	 * refreshes invalidate the affected branches (see listObjects() / updateItem()) */
+	import_helper.setCachedQueriesEnabled(true);
+
 	catalog.closeConnection();
 	catalog.setQueryFilter(Catalog::ListAllObjects);
 	catalog.setConnection(connection);
@@ -1530,6 +1541,9 @@ void DatabaseExplorerWidget::updateItem(QTreeWidgetItem *item, bool restore_tree
 
 			configureImportHelper();
 
+			//Updating an item is an explicit refresh, so the snapshot of the affected branch is dropped
+			import_helper.invalidateCachedQueries(sch_name, tab_name);
+
 			//Updates the group type only
 			if(obj_id==0 || (!BaseTable::isBaseTable(obj_type) && obj_type!=ObjectType::Schema))
 				gen_items=DatabaseImportForm::updateObjectsTree(import_helper, objects_trw, { obj_type }, false, false, root, sch_name, tab_name);
@@ -23,6 +23,8 @@
 #include "guiutilsns.h"
 #include "coreutilsns.h"
 #include "defaultlanguages.h"
+#include "taskscheduler.h"
+#include <QtConcurrent/QtConcurrent>
 
 bool DatabaseImportForm::low_verbosity = false;
 
@@ -185,7 +187,7 @@ void DatabaseImportForm::listFilteredObjects(DatabaseImportHelper &import_hlp, Q
 			item = new QTableWidgetItem;
 			obj_type = static_cast<ObjectType>(attr[Attributes::ObjectType].toUInt());
 			item->setText(BaseObject::getTypeName(obj_type));
-			item->setIcon(QIcon(GuiUtilsNs::getIconPath(obj_type)));
+			item->setIcon(GuiUtilsNs::getCachedIcon(obj_type));
 			item->setData(Qt::UserRole, enum_cast(obj_type));
 			flt_objects_tbw->setItem(row, 1, item);
 
@@ -204,7 +206,7 @@ void DatabaseImportForm::listFilteredObjects(DatabaseImportHelper &import_hlp, Q
 			item = new QTableWidgetItem;
 			obj_type = BaseObject::getObjectType(attr[Attributes::ParentType]);
 			item->setText(BaseObject::getTypeName(obj_type));
-			item->setIcon(QIcon(GuiUtilsNs::getIconPath(obj_type)));
+			item->setIcon(GuiUtilsNs::getCachedIcon(obj_type));
 			flt_objects_tbw->setItem(row, 4, item);
 
 			row++;
@@ -494,7 +496,46 @@ Do you really want to proceed?"),
 				filtered_objs_tbw->clearContents();
 				filtered_objs_tbw->setRowCount(0);
 				db_objects_stw->setCurrentIndex(0);
+
+				/* The whole object listing is retrieved on a worker thread through a few batched
+				 * catalog queries while the event loop keeps spinning, so the UI stays responsive.
+				 * The tree population below is then entirely served from the listing snapshot
+				 * instead of querying the catalog once per schema/table */
+				QString error_msg;
+				import_helper->setCachedQueriesEnabled(true);
+
+				QFuture<void> future=QtConcurrent::run(&TaskScheduler::getThreadPool(), [&](){
+					try
+					{
+						import_helper->prefetchObjectListings();
+					}
+					catch(Exception &e)
+					{
+						error_msg=e.getErrorMessage();
+					}
+				});
+
+				qApp->setOverrideCursor(Qt::WaitCursor);
+				database_gb->setEnabled(false);
+				options_tbw->setEnabled(false);
+
+				while(!future.isFinished())
+				{
+					QApplication::processEvents();
+					QThread::msleep(20);
+				}
+
+				database_gb->setEnabled(true);
+				options_tbw->setEnabled(true);
+				qApp->restoreOverrideCursor();
+
+				if(!error_msg.isEmpty())
+					throw Exception(error_msg, ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
 				DatabaseImportForm::listObjects(*import_helper, db_objects_tw, true, true, false);
+
+				//Dropping the snapshot so a further listing reflects the current server state
+				import_helper->setCachedQueriesEnabled(false);
 				objs_parent_wgt->setEnabled(db_objects_tw->topLevelItemCount() > 0);
 			}
 		}
@@ -505,6 +546,7 @@ Do you really want to proceed?"),
 	}
 	catch(Exception &e)
 	{
+		import_helper->setCachedQueriesEnabled(false);
 		import_btn->setEnabled(false);
 		objs_parent_wgt->setEnabled(false);
 		buttons_wgt->setEnabled(false);
@@ -615,6 +657,9 @@ void DatabaseImportForm::filterObjects(QTreeWidget *tree_wgt, const QString &pat
 		items = tree_wgt->findItems(pattern, Qt::MatchStartsWith | Qt::MatchRecursive, search_column);
 
 	tree_wgt->blockSignals(true);
+
+	//Suspending the repainting while the visibility of the items is changed
+	tree_wgt->setUpdatesEnabled(false);
 	tree_wgt->collapseAll();
 	tree_wgt->clearSelection();
 
@@ -665,6 +710,7 @@ void DatabaseImportForm::filterObjects(QTreeWidget *tree_wgt, const QString &pat
 		}
 	}
 
+	tree_wgt->setUpdatesEnabled(true);
 	tree_wgt->blockSignals(false);
 }
 
@@ -710,6 +756,19 @@ void DatabaseImportForm::handleImportFinished(Exception e)
 	model_wgt->rearrangeSchemasInGrid();
 	model_wgt->getDatabaseModel()->setInvalidated(false);
 
+	//Displaying the per phase statistics collected during the import
+	QTreeWidgetItem *stats_item=GuiUtilsNs::createOutputTreeItem(output_trw, tr("Import statistics (per phase):"),
+																															 QPixmap(GuiUtilsNs::getIconPath("info")), nullptr, false);
+
+	for(auto &stats : import_helper->getImportStats())
+	{
+		GuiUtilsNs::createOutputTreeItem(output_trw,
+																		 tr("%1: wall %2 ms, cpu %3 ms, %4 query(ies)")
+																		 .arg(stats.phase).arg(stats.wall_time)
+																		 .arg(stats.cpu_time).arg(stats.query_count),
+																		 QPixmap(), stats_item, false);
+	}
+
 	ico_lbl->setPixmap(QPixmap(GuiUtilsNs::getIconPath("info")));
 	finishImport(tr("Importing process sucessfuly ended!"));
 
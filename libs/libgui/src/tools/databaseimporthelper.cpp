@@ -22,15 +22,57 @@
 #include "qtcompat/splitbehaviorcompat.h"
 #include "utilsns.h"
 #include "coreutilsns.h"
+#include "tracelogger.h"
+#include "profilerhooks.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QtConcurrent/QtConcurrent>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <deque>
 
 const QString DatabaseImportHelper::UnkownObjectOidXml("\t<!--[ unknown object OID=%1 ]-->\n");
+unsigned DatabaseImportHelper::parallel_conns=1;
+bool DatabaseImportHelper::catalog_cache_enabled=false;
+const QByteArray DatabaseImportHelper::CatalogCacheMagic("pgmodeler-catalog-cache");
+const quint32 DatabaseImportHelper::CatalogCacheVersion=1;
+const QByteArray DatabaseImportHelper::DeltaSnapshotMagic("pgmodeler-delta-snapshot");
+const quint32 DatabaseImportHelper::DeltaSnapshotVersion=1;
+
+void DatabaseImportHelper::setCatalogCacheEnabled(bool value)
+{
+	catalog_cache_enabled=value;
+}
+
+bool DatabaseImportHelper::isCatalogCacheEnabled()
+{
+	return catalog_cache_enabled;
+}
+
+void DatabaseImportHelper::setParallelRetrieval(unsigned conn_count)
+{
+	if(conn_count==0)
+		conn_count=1;
+	else if(conn_count > MaxParallelConns)
+		conn_count=MaxParallelConns;
+
+	parallel_conns=conn_count;
+}
+
+unsigned DatabaseImportHelper::getParallelRetrieval()
+{
+	return parallel_conns;
+}
 
 DatabaseImportHelper::DatabaseImportHelper(QObject *parent) : QObject(parent)
 {
 	random_device rand_seed;
 	rand_num_engine.seed(rand_seed());
 
-	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=rand_rel_colors=update_fk_rels=false;
+	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=rand_rel_colors=update_fk_rels=delta_mode=skip_tab_children=resumable=pending_import=objs_retrieved=use_cached_queries=false;
 	auto_resolve_deps=true;
 	import_filter=Catalog::ListAllObjects | Catalog::ExclExtensionObjs | Catalog::ExclSystemObjs;
 	xmlparser=nullptr;
@@ -80,6 +122,14 @@ void DatabaseImportHelper::setSelectedOIDs(DatabaseModel *db_model, const map<Ob
 	column_oids.insert(col_oids.begin(), col_oids.end());
 
 	//Fills the creation order vector with the selected OIDs
+	rebuildCreationOrder();
+
+	user_objs.clear();
+	system_objs.clear();
+}
+
+void DatabaseImportHelper::rebuildCreationOrder()
+{
 	creation_order.clear();
 
 	for(auto &itr : object_oids)
@@ -87,9 +137,6 @@ void DatabaseImportHelper::setSelectedOIDs(DatabaseModel *db_model, const map<Ob
 
 	//Sort the creation order vector to create the object in the correct sequence
 	std::sort(creation_order.begin(), creation_order.end());
-
-	user_objs.clear();
-	system_objs.clear();
 }
 
 void DatabaseImportHelper::setImportOptions(bool import_sys_objs, bool import_ext_objs, bool auto_resolve_deps, bool ignore_errors, bool debug_mode, bool rand_rel_colors, bool update_rels)
@@ -114,6 +161,116 @@ void DatabaseImportHelper::setImportOptions(bool import_sys_objs, bool import_ex
 		import_filter=Catalog::ListAllObjects | Catalog::ExclBuiltinArrayTypes | Catalog::ExclExtensionObjs | Catalog::ExclSystemObjs;
 }
 
+ProgressChannel &DatabaseImportHelper::getProgressChannel()
+{
+	return progress_chn;
+}
+
+void DatabaseImportHelper::setDeltaMode(bool value)
+{
+	delta_mode=value;
+}
+
+void DatabaseImportHelper::setSkipTableChildren(bool value)
+{
+	skip_tab_children=value;
+}
+
+void DatabaseImportHelper::setResumableImport(bool value)
+{
+	resumable=value;
+}
+
+bool DatabaseImportHelper::canResumeImport()
+{
+	return pending_import;
+}
+
+void DatabaseImportHelper::resumeImport()
+{
+	if(!pending_import || !dbmodel)
+		throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	try
+	{
+		//Reestablishing the connection to the server before continuing the pending steps
+		connection.connect();
+		catalog.setConnection(connection);
+
+		pending_import=false;
+		importDatabase();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+BaseObject *DatabaseImportHelper::getModelObject(const QString &name, ObjectType obj_type)
+{
+	QString key=QString("%1:%2").arg(enum_cast(obj_type)).arg(name);
+	BaseObject *object=model_objs_cache.value(key, nullptr);
+
+	if(object)
+		return object;
+
+	object=dbmodel->getObject(name, obj_type);
+
+	//Only successful lookups are cached since the object may be created later in the import
+	if(object)
+		model_objs_cache.insert(key, object);
+
+	return object;
+}
+
+void DatabaseImportHelper::startPhase(const QString &phase)
+{
+	curr_phase=phase;
+	phase_cpu_mark=std::clock();
+	phase_qry_mark=Connection::getExecutedCmdCount();
+	phase_timer.start();
+}
+
+void DatabaseImportHelper::endPhase()
+{
+	PhaseStats stats;
+
+	if(curr_phase.isEmpty())
+		return;
+
+	stats.phase=curr_phase;
+	stats.wall_time=phase_timer.elapsed();
+	stats.cpu_time=((std::clock() - phase_cpu_mark) * 1000) / CLOCKS_PER_SEC;
+	stats.query_count=Connection::getExecutedCmdCount() - phase_qry_mark;
+	import_stats.push_back(stats);
+	curr_phase.clear();
+}
+
+vector<DatabaseImportHelper::PhaseStats> DatabaseImportHelper::getImportStats()
+{
+	return import_stats;
+}
+
+QString DatabaseImportHelper::getImportStatsAsJson()
+{
+	QJsonArray phases;
+	QJsonObject root, phase;
+
+	for(auto &stats : import_stats)
+	{
+		phase[QString("phase")]=stats.phase;
+		phase[QString("wall-time-ms")]=stats.wall_time;
+		phase[QString("cpu-time-ms")]=stats.cpu_time;
+		phase[QString("query-count")]=static_cast<qint64>(stats.query_count);
+		phases.append(phase);
+	}
+
+	root[QString("database")]=getCurrentDatabase();
+	root[QString("phases")]=phases;
+
+	return QString(QJsonDocument(root).toJson(QJsonDocument::Indented));
+}
+
 unsigned DatabaseImportHelper::getLastSystemOID()
 {
 	return catalog.getLastSysObjectOID();
@@ -146,8 +303,24 @@ vector<attribs_map> DatabaseImportHelper::getObjects(vector<ObjectType> obj_type
 {
 	try
 	{
+		QString cache_key;
+		vector<attribs_map> objects;
+
+		if(use_cached_queries)
+		{
+			cache_key=getListingCacheKey(obj_types, schema, table, extra_attribs);
+
+			if(cached_listings.count(cache_key))
+				return cached_listings[cache_key];
+		}
+
 		catalog.setQueryFilter(import_filter);
-		return catalog.getObjectsNames(obj_types, schema, table, extra_attribs);
+		objects=catalog.getObjectsNames(obj_types, schema, table, extra_attribs);
+
+		if(use_cached_queries)
+			cached_listings[cache_key]=objects;
+
+		return objects;
 	}
 	catch(Exception &e)
 	{
@@ -155,6 +328,109 @@ vector<attribs_map> DatabaseImportHelper::getObjects(vector<ObjectType> obj_type
 	}
 }
 
+QString DatabaseImportHelper::getListingCacheKey(const vector<ObjectType> &obj_types, const QString &schema, const QString &table, const attribs_map &extra_attribs)
+{
+	QStringList key_parts;
+
+	key_parts.append(QString::number(import_filter));
+
+	for(auto &type : obj_types)
+		key_parts.append(QString::number(enum_cast(type)));
+
+	for(auto &attr : extra_attribs)
+		key_parts.append(attr.first + QChar('=') + attr.second);
+
+	/* The line break is used as field separator since it can't appear in object
+	 * identifiers, making the schema/table portions extractable on invalidation */
+	return key_parts.join(QString(",")) + QChar('\n') + schema + QChar('\n') + table;
+}
+
+void DatabaseImportHelper::prefetchObjectListings()
+{
+	try
+	{
+		attribs_map extra_attribs={{Attributes::FilterTableTypes, Attributes::True}};
+		vector<ObjectType> sch_child_types=BaseObject::getChildObjectTypes(ObjectType::Schema);
+		map<QString, vector<attribs_map>> sch_listings;
+		map<ObjectType, vector<QStringList>> tab_parents;
+		ObjectType obj_type;
+
+		if(!use_cached_queries)
+			return;
+
+		catalog.setQueryFilter(import_filter);
+
+		/* Cluster level pass: the schemas found here seed the per schema listings below
+		 * so even schemas without children end up served from the snapshot */
+		for(auto &attribs : getObjects(BaseObject::getChildObjectTypes(ObjectType::Database), "", "", extra_attribs))
+		{
+			if(static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt())==ObjectType::Schema)
+				sch_listings[attribs[Attributes::Name]]={};
+		}
+
+		/* Schema level pass: all the schema scoped objects of the database are enumerated in a
+		 * single round-trip and partitioned by the parent schema returned by the list queries */
+		for(auto &attribs : catalog.getObjectsNames(sch_child_types, "", "", extra_attribs))
+		{
+			obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
+
+			if(BaseTable::isBaseTable(obj_type))
+				tab_parents[obj_type].push_back({ attribs[Attributes::Parent], attribs[Attributes::Name] });
+
+			sch_listings[attribs[Attributes::Parent]].push_back(std::move(attribs));
+		}
+
+		for(auto &itr : sch_listings)
+			cached_listings[getListingCacheKey(sch_child_types, itr.first, "", extra_attribs)]=std::move(itr.second);
+
+		/* Table level pass: the children of all tables of the same kind are retrieved through
+		 * batched queries and demultiplexed into one snapshot entry per table. Tables without
+		 * children also get their (empty) entry so no catalog query is issued for them later */
+		for(auto &itr : tab_parents)
+		{
+			vector<ObjectType> child_types=BaseObject::getChildObjectTypes(itr.first);
+			map<int, vector<attribs_map>> tab_listings=catalog.getObjectsNames(child_types, itr.second, extra_attribs);
+
+			for(unsigned idx=0; idx < itr.second.size(); idx++)
+				cached_listings[getListingCacheKey(child_types, itr.second[idx].at(0), itr.second[idx].at(1), extra_attribs)]=std::move(tab_listings[idx]);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void DatabaseImportHelper::setCachedQueriesEnabled(bool value)
+{
+	use_cached_queries=value;
+
+	if(!value)
+		cached_listings.clear();
+}
+
+void DatabaseImportHelper::invalidateCachedQueries(const QString &schema, const QString &table)
+{
+	QStringList key_parts;
+
+	if(schema.isEmpty() && table.isEmpty())
+	{
+		cached_listings.clear();
+		return;
+	}
+
+	for(auto itr=cached_listings.begin(); itr!=cached_listings.end();)
+	{
+		key_parts=itr->first.split(QChar('\n'));
+
+		if(key_parts.size()==3 && key_parts[1]==schema &&
+				(table.isEmpty() || key_parts[2]==table))
+			itr=cached_listings.erase(itr);
+		else
+			itr++;
+	}
+}
+
 void DatabaseImportHelper::swapSequencesTablesIds()
 {
 	BaseObject *table=nullptr, *sequence=nullptr;
@@ -164,14 +440,273 @@ void DatabaseImportHelper::swapSequencesTablesIds()
 	itr=seq_tab_swap.begin();
 	while(itr!=seq_tab_swap.end())
 	{
-		sequence=dbmodel->getObject(getObjectName(itr->first), ObjectType::Sequence);
-		table=dbmodel->getObject(getObjectName(itr->second), ObjectType::Table);
+		sequence=getModelObject(getObjectName(itr->first), ObjectType::Sequence);
+		table=getModelObject(getObjectName(itr->second), ObjectType::Table);
 		if(sequence && table)
 			BaseObject::swapObjectsIds(sequence, table, false);
 		itr++;
 	}
 }
 
+QString DatabaseImportHelper::getServerFingerprintId()
+{
+	QString srv_addr=connection.getConnectionParam(Connection::ParamServerFqdn);
+
+	if(srv_addr.isEmpty())
+		srv_addr=connection.getConnectionParam(Connection::ParamServerIp);
+
+	QByteArray conn_id=QString("%1:%2:%3")
+										 .arg(srv_addr)
+										 .arg(connection.getConnectionParam(Connection::ParamPort))
+										 .arg(connection.getConnectionParam(Connection::ParamDbName)).toUtf8();
+
+	return QString(QCryptographicHash::hash(conn_id, QCryptographicHash::Sha256).toHex().left(16));
+}
+
+QString DatabaseImportHelper::getCatalogCacheFilePath()
+{
+	return GlobalAttributes::getConfigurationsDir() + GlobalAttributes::DirSeparator +
+				 QString("catalog-%1%2").arg(getServerFingerprintId()).arg(GlobalAttributes::ModelCacheExt);
+}
+
+QString DatabaseImportHelper::getDeltaSnapshotFilePath()
+{
+	return GlobalAttributes::getConfigurationsDir() + GlobalAttributes::DirSeparator +
+				 QString("delta-%1%2").arg(getServerFingerprintId()).arg(GlobalAttributes::ModelCacheExt);
+}
+
+bool DatabaseImportHelper::loadCatalogCache()
+{
+	QFile cache_file(getCatalogCacheFilePath());
+	QByteArray magic, data;
+	QString pgm_version, server_version;
+	quint32 version=0, last_sys_oid=0, lang_cnt=0;
+
+	if(!cache_file.open(QFile::ReadOnly))
+		return false;
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	stream >> magic >> version >> pgm_version >> server_version >> last_sys_oid >> lang_cnt;
+
+	/* Languages are the only objects retrieved by retrieveSystemObjects() that users can create,
+	 * so their amount is part of the fingerprint in order to invalidate the cache when a language
+	 * is created or dropped on the database */
+	catalog.setQueryFilter(Catalog::ListAllObjects);
+
+	if(stream.status()!=QDataStream::Ok ||
+			magic!=CatalogCacheMagic || version!=CatalogCacheVersion ||
+			pgm_version!=GlobalAttributes::PgModelerVersion ||
+			server_version!=connection.getPgSQLVersion() ||
+			last_sys_oid!=catalog.getLastSysObjectOID() ||
+			lang_cnt!=catalog.getObjectCount(ObjectType::Language))
+		return false;
+
+	stream >> data;
+	data=qUncompress(data);
+
+	if(data.isEmpty())
+		return false;
+
+	QDataStream buf_stream(data);
+	buf_stream.setVersion(QDataStream::Qt_5_0);
+
+	for(auto &obj_map : { &system_objs, &types })
+	{
+		quint32 obj_cnt=0, attr_cnt=0, oid=0;
+		QString attr, value;
+
+		buf_stream >> obj_cnt;
+
+		for(quint32 i=0; i < obj_cnt; i++)
+		{
+			attribs_map attribs;
+
+			buf_stream >> oid >> attr_cnt;
+
+			for(quint32 j=0; j < attr_cnt; j++)
+			{
+				buf_stream >> attr >> value;
+				attribs[attr]=value;
+			}
+
+			(*obj_map)[oid]=attribs;
+		}
+	}
+
+	if(buf_stream.status()!=QDataStream::Ok)
+	{
+		system_objs.clear();
+		types.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void DatabaseImportHelper::saveCatalogCache()
+{
+	QFile cache_file(getCatalogCacheFilePath());
+	QByteArray data;
+
+	/* The cache is a best-effort optimization so failures when writing it
+	 * must never abort the import that is in progress */
+	if(!cache_file.open(QFile::WriteOnly))
+		return;
+
+	QDataStream buf_stream(&data, QIODevice::WriteOnly);
+	buf_stream.setVersion(QDataStream::Qt_5_0);
+
+	for(auto &obj_map : { &system_objs, &types })
+	{
+		buf_stream << static_cast<quint32>(obj_map->size());
+
+		for(auto &obj_itr : *obj_map)
+		{
+			buf_stream << static_cast<quint32>(obj_itr.first)
+								 << static_cast<quint32>(obj_itr.second.size());
+
+			for(auto &attr_itr : obj_itr.second)
+				buf_stream << attr_itr.first << attr_itr.second;
+		}
+	}
+
+	catalog.setQueryFilter(Catalog::ListAllObjects);
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	stream << CatalogCacheMagic << CatalogCacheVersion
+				 << GlobalAttributes::PgModelerVersion
+				 << connection.getPgSQLVersion()
+				 << static_cast<quint32>(catalog.getLastSysObjectOID())
+				 << static_cast<quint32>(catalog.getObjectCount(ObjectType::Language))
+				 << qCompress(data);
+}
+
+bool DatabaseImportHelper::filterUnchangedObjects()
+{
+	QFile snapshot_file(getDeltaSnapshotFilePath());
+	QByteArray magic;
+	QString pgm_version, server_version;
+	quint32 version=0, obj_cnt=0, oid=0, xmin=0;
+	map<unsigned, unsigned> prev_xmins;
+	unsigned filtered_cnt=0;
+
+	delta_xmins.clear();
+
+	if(!snapshot_file.open(QFile::ReadOnly))
+		return false;
+
+	QDataStream stream(&snapshot_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	stream >> magic >> version >> pgm_version >> server_version >> obj_cnt;
+
+	if(stream.status()!=QDataStream::Ok ||
+			magic!=DeltaSnapshotMagic || version!=DeltaSnapshotVersion ||
+			pgm_version!=GlobalAttributes::PgModelerVersion ||
+			server_version!=connection.getPgSQLVersion())
+		return false;
+
+	for(quint32 i=0; i < obj_cnt; i++)
+	{
+		stream >> oid >> xmin;
+		prev_xmins[oid]=xmin;
+	}
+
+	if(stream.status()!=QDataStream::Ok)
+		return false;
+
+	try
+	{
+		/* The watermarks are captured before the retrieval starts so the snapshot saved
+		 * at the end of the import reflects the server state at filtering time */
+		delta_xmins=catalog.getObjectsXmins();
+	}
+	catch(Exception &)
+	{
+		/* Older servers may lack some of the sampled catalogs (e.g. pg_policy prior to 9.5).
+		 * In that case the delta filtering is silently skipped and a full import takes place */
+		return false;
+	}
+
+	emit s_progressUpdated(1, tr("Detecting unchanged objects since the last import..."), ObjectType::BaseObject);
+
+	map<ObjectType, vector<unsigned>>::iterator itr=object_oids.begin();
+
+	while(itr!=object_oids.end())
+	{
+		/* Empty oid vectors mean "all objects of the type" in getObjectsAttributes(),
+		 * so they can't be reduced without changing the selection semantics */
+		if(itr->second.empty())
+		{
+			itr++;
+			continue;
+		}
+
+		itr->second.erase(std::remove_if(itr->second.begin(), itr->second.end(),
+																		 [&](unsigned obj_oid){
+			map<unsigned, unsigned>::iterator prev_itr=prev_xmins.find(obj_oid),
+					curr_itr=delta_xmins.find(obj_oid);
+
+			if(prev_itr==prev_xmins.end() || curr_itr==delta_xmins.end() ||
+					prev_itr->second!=curr_itr->second)
+				return false;
+
+			filtered_cnt++;
+			column_oids.erase(obj_oid);
+			return true;
+		}), itr->second.end());
+
+		if(itr->second.empty())
+			itr=object_oids.erase(itr);
+		else
+			itr++;
+	}
+
+	//Rebuilding the creation order since the oid selection may have shrunk
+	rebuildCreationOrder();
+
+	emit s_progressUpdated(2, tr("Skipping `%1' unchanged object(s)...").arg(filtered_cnt), ObjectType::BaseObject);
+
+	return true;
+}
+
+void DatabaseImportHelper::saveDeltaSnapshot()
+{
+	if(delta_xmins.empty())
+	{
+		try
+		{
+			delta_xmins=catalog.getObjectsXmins();
+		}
+		catch(Exception &)
+		{
+			//The snapshot is a best-effort optimization so retrieval failures are ignored
+			return;
+		}
+	}
+
+	QFile snapshot_file(getDeltaSnapshotFilePath());
+
+	if(!snapshot_file.open(QFile::WriteOnly))
+		return;
+
+	QDataStream stream(&snapshot_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+
+	stream << DeltaSnapshotMagic << DeltaSnapshotVersion
+				 << GlobalAttributes::PgModelerVersion
+				 << connection.getPgSQLVersion()
+				 << static_cast<quint32>(delta_xmins.size());
+
+	for(auto &xmin_itr : delta_xmins)
+		stream << static_cast<quint32>(xmin_itr.first)
+					 << static_cast<quint32>(xmin_itr.second);
+}
+
 void DatabaseImportHelper::retrieveSystemObjects()
 {
 	int progress=0;
@@ -182,6 +717,12 @@ void DatabaseImportHelper::retrieveSystemObjects()
 																ObjectType::Language, ObjectType::Type };
 	unsigned i = 0, oid = 0, cnt = sys_objs.size();
 
+	if(catalog_cache_enabled && loadCatalogCache())
+	{
+		emit s_progressUpdated(10, tr("System objects metadata loaded from the catalog cache..."), ObjectType::BaseObject);
+		return;
+	}
+
 	for(i=0; i < cnt && !import_canceled; i++)
 	{
 		emit s_progressUpdated(progress,
@@ -219,62 +760,250 @@ void DatabaseImportHelper::retrieveSystemObjects()
 
 		progress=(i/static_cast<double>(cnt))*10;
 	}
+
+	/* Refreshing the on-disk catalog cache so a further import against the same
+	 * (unchanged) database can skip the system catalog scan performed above */
+	if(catalog_cache_enabled && !import_canceled)
+		saveCatalogCache();
 }
 
 void DatabaseImportHelper::retrieveUserObjects()
 {
 	int progress=0;
-	map<ObjectType, vector<unsigned>>::iterator oid_itr=object_oids.begin();
-	vector<attribs_map>::iterator itr;
-	vector<attribs_map> objects;
 	unsigned i=0, oid=0;
-	map<unsigned, vector<unsigned>>::iterator col_itr;
-	QStringList names;
 
-	i=0;
 	catalog.setQueryFilter(import_filter);
 
-	//Retrieving selected database level objects and table children objects (except columns)
-	while(oid_itr!=object_oids.end() && !import_canceled)
+	if(parallel_conns > 1 && object_oids.size() > 1)
 	{
-		emit s_progressUpdated(progress,
-								 tr("Retrieving objects... `%1'").arg(BaseObject::getTypeName(oid_itr->first)),
-							   oid_itr->first);
+		retrieveUserObjectsParallel();
+		progress=90;
+	}
+	else
+	{
+		/* The retrieval is streamed: a producer thread decodes the catalog tuples and pushes them
+		 * into a bounded queue while this thread pops them into the attribute maps. This way the
+		 * complete set of objects of a type is never materialized at once and the memory spent on
+		 * tuples in flight is capped by MaxQueuedObjAttribs */
+		std::deque<attribs_map> attribs_queue;
+		QMutex queue_mtx;
+		QWaitCondition queue_not_full, queue_not_empty;
+		ObjectType curr_type=ObjectType::BaseObject, obj_type;
+		attribs_map attribs;
+		Exception error;
+		bool retrieval_done=false, has_error=false;
+		vector<PhaseStats> retr_stats;
+
+		QFuture<void> producer=QtConcurrent::run([&](){
+			try
+			{
+				/* The producer operates over a copy of the catalog which owns a dedicated connection
+				 * (borrowed from the connection pool when the pooling is enabled) */
+				Catalog aux_catalog=catalog;
+				aux_catalog.setQueryFilter(import_filter);
+				PhaseStats stats;
+				QElapsedTimer type_timer;
+				std::clock_t cpu_mark;
+				quint64 qry_mark;
+
+				for(auto &oid_itr : object_oids)
+				{
+					if(import_canceled)
+						break;
 
-		objects=catalog.getObjectsAttributes(oid_itr->first, "", "", oid_itr->second);
-		itr=objects.begin();
+					cpu_mark=std::clock();
+					qry_mark=Connection::getExecutedCmdCount();
+					type_timer.start();
 
-		while(itr!=objects.end() && !import_canceled)
+					aux_catalog.getObjectsAttributes(oid_itr.first, "", "", oid_itr.second,
+					[&](attribs_map &&tuple){
+						QMutexLocker locker(&queue_mtx);
+
+						while(attribs_queue.size() >= MaxQueuedObjAttribs && !import_canceled)
+							queue_not_full.wait(&queue_mtx);
+
+						//On canceled imports the tuples are discarded so the resultset is drained quickly
+						if(!import_canceled)
+						{
+							attribs_queue.push_back(std::move(tuple));
+							queue_not_empty.wakeOne();
+						}
+					});
+
+					/* Registering per type retrieval statistics. The wall time also covers the moments
+					 * the producer was blocked waiting for room on the queue (client bound consumption) */
+					stats.phase=QString("retrieval:%1").arg(BaseObject::getSchemaName(oid_itr.first));
+					stats.wall_time=type_timer.elapsed();
+					stats.cpu_time=((std::clock() - cpu_mark) * 1000) / CLOCKS_PER_SEC;
+					stats.query_count=Connection::getExecutedCmdCount() - qry_mark;
+					retr_stats.push_back(stats);
+				}
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&queue_mtx);
+				error=Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+				has_error=true;
+			}
+
+			QMutexLocker locker(&queue_mtx);
+			retrieval_done=true;
+			queue_not_empty.wakeOne();
+		});
+
+		while(true)
 		{
-			oid=itr->at(Attributes::Oid).toUInt();
-			user_objs[oid]=(*itr);
-			itr++;
+			{
+				QMutexLocker locker(&queue_mtx);
+
+				while(attribs_queue.empty() && !retrieval_done)
+					queue_not_empty.wait(&queue_mtx);
+
+				if(attribs_queue.empty())
+					break;
+
+				attribs=std::move(attribs_queue.front());
+				attribs_queue.pop_front();
+				queue_not_full.wakeOne();
+			}
+
+			obj_type=static_cast<ObjectType>(attribs.at(Attributes::ObjectType).toUInt());
+
+			if(obj_type!=curr_type)
+			{
+				curr_type=obj_type;
+				emit s_progressUpdated(progress,
+										 tr("Retrieving objects... `%1'").arg(BaseObject::getTypeName(curr_type)),
+										 curr_type);
+				progress=(i/static_cast<double>(object_oids.size()))*100;
+				i++;
+			}
+
+			if(!import_canceled)
+			{
+				oid=attribs.at(Attributes::Oid).toUInt();
+				user_objs[oid]=std::move(attribs);
+			}
 		}
 
-		objects.clear();
-		progress=(i/static_cast<double>(object_oids.size()))*100;
-		oid_itr++; i++;
+		producer.waitForFinished();
+		import_stats.insert(import_stats.end(), retr_stats.begin(), retr_stats.end());
+
+		if(has_error)
+			throw Exception(error.getErrorMessage(), error.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &error);
 	}
 
 	//Retrieving all selected table columns
-	i=0;
-	col_itr=column_oids.begin();
-	while(col_itr!=column_oids.end())
+	if(!column_oids.empty() && !import_canceled)
 	{
-		names=getObjectName(QString::number(col_itr->first)).split(".");
+		vector<unsigned> tab_oids;
+		map<unsigned, vector<attribs_map>> tab_cols;
+		unsigned col_oid=0;
+
+		for(auto &itr : column_oids)
+			tab_oids.push_back(itr.first);
 
 		emit s_progressUpdated(progress,
-								 tr("Retrieving columns of table `%1.%2', oid `%3'...").arg(names[0]).arg(names[1]).arg(col_itr->first),
+								 tr("Retrieving columns of %1 table(s)...").arg(tab_oids.size()),
 							   ObjectType::Column);
 
-		if(names.size() > 1)
-			retrieveTableColumns(names[0], names[1], col_itr->second);
+		/* The columns of all selected tables are retrieved in a single set-returning catalog
+		 * round trip and demultiplexed per table, instead of one catalog query per table */
+		tab_cols=catalog.getColumnsAttributes(tab_oids);
+
+		for(auto &itr : tab_cols)
+		{
+			vector<unsigned> &col_ids=column_oids[itr.first];
+
+			for(auto &col : itr.second)
+			{
+				col_oid=col.at(Attributes::Oid).toUInt();
+
+				//Discarding the columns that are not in the selected set of the table
+				if(!col_ids.empty() &&
+						std::find(col_ids.begin(), col_ids.end(), col_oid)==col_ids.end())
+					continue;
 
-		progress=(i/static_cast<double>(column_oids.size()))*100;
-		col_itr++; i++;
+				columns[itr.first][col_oid]=std::move(col);
+			}
+		}
 	}
 }
 
+void DatabaseImportHelper::retrieveUserObjectsParallel()
+{
+	QThreadPool thread_pool;
+	QList<QFuture<vector<attribs_map>>> futures;
+	vector<ObjectType> obj_types;
+	QMutex error_mtx;
+	Exception error;
+	bool has_error=false;
+	int progress=0;
+	unsigned i=0, oid=0;
+
+	thread_pool.setMaxThreadCount(parallel_conns);
+
+	emit s_progressUpdated(progress,
+							 tr("Retrieving objects using %1 parallel connections...").arg(parallel_conns),
+						   ObjectType::BaseObject);
+
+	/* Each object type is dispatched as a separated work item so the attributes of distinct
+	 * types are fetched through distinct connections simultaneously */
+	for(auto &oid_itr : object_oids)
+	{
+		ObjectType obj_type=oid_itr.first;
+		vector<unsigned> filter_oids=oid_itr.second;
+
+		obj_types.push_back(obj_type);
+		futures.append(QtConcurrent::run(&thread_pool,
+		[this, obj_type, filter_oids, &error, &has_error, &error_mtx]() -> vector<attribs_map> {
+			try
+			{
+				/* The worker operates over a copy of the catalog which owns a dedicated connection
+				 * (borrowed from the connection pool when the pooling is enabled) */
+				Catalog aux_catalog=catalog;
+				aux_catalog.setQueryFilter(import_filter);
+				return aux_catalog.getObjectsAttributes(obj_type, "", "", filter_oids);
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&error_mtx);
+
+				//Only the first error is propagated to the caller
+				if(!has_error)
+				{
+					error=Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+					has_error=true;
+				}
+
+				return vector<attribs_map>();
+			}
+		}));
+	}
+
+	/* The results are merged following the dispatching order so the parallel retrieval
+	 * fills the user_objs map exactly like the serial one */
+	for(i=0; i < static_cast<unsigned>(futures.size()); i++)
+	{
+		for(auto &attribs : futures[i].result())
+		{
+			if(import_canceled)
+				break;
+
+			oid=attribs.at(Attributes::Oid).toUInt();
+			user_objs[oid]=std::move(attribs);
+		}
+
+		progress=(i/static_cast<double>(futures.size()))*100;
+		emit s_progressUpdated(progress,
+								 tr("Retrieving objects... `%1'").arg(BaseObject::getTypeName(obj_types[i])),
+							   obj_types[i]);
+	}
+
+	if(has_error)
+		throw Exception(error.getErrorMessage(), error.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &error);
+}
+
 void DatabaseImportHelper::retrieveTableColumns(const QString &sch_name, const QString &tab_name, vector<unsigned> col_ids)
 {
 	try
@@ -299,6 +1028,7 @@ void DatabaseImportHelper::retrieveTableColumns(const QString &sch_name, const Q
 
 void DatabaseImportHelper::createObjects()
 {
+	ProfilerHooks::Phase prof_phase("import-create-objects");
 	int progress=0;
 	attribs_map attribs;
 	ObjectType obj_type;
@@ -307,8 +1037,11 @@ void DatabaseImportHelper::createObjects()
 	vector<unsigned>::iterator itr, itr_end;
 	vector<Exception> aux_errors;
 	map<unsigned, attribs_map>::iterator itr_objs, itr_objs_end;
+	map<ObjectType, PhaseStats> create_stats;
+	QElapsedTimer obj_timer;
+	std::clock_t cpu_mark;
+	quint64 qry_mark;
 
-	created_objs.reserve(creation_order.size());
 	itr_objs = user_objs.begin();
 	itr_objs_end = user_objs.end();
 
@@ -326,13 +1059,27 @@ void DatabaseImportHelper::createObjects()
 				 in order to be created later */
 			if(obj_type != ObjectType::Constraint)
 			{
-				emit s_progressUpdated(progress, tr("Creating object `%1' (%2), oid `%3'...")
-															.arg(attribs[Attributes::Name])
-															.arg(BaseObject::getTypeName(obj_type))
-															.arg(attribs[Attributes::Oid]),
-															obj_type);
+				/* The progress report is coalesced: the message formatting and the queued emission
+				 * happen only when the percentage advances, otherwise the reporting plumbing itself
+				 * becomes measurable at thousands of created objects per second */
+				if(progress_chn.reportProgress(progress, enum_cast(obj_type)))
+					emit s_progressUpdated(progress, tr("Creating object `%1' (%2), oid `%3'...")
+																.arg(attribs[Attributes::Name])
+																.arg(BaseObject::getTypeName(obj_type))
+																.arg(attribs[Attributes::Oid]),
+																obj_type);
+
+				cpu_mark=std::clock();
+				qry_mark=Connection::getExecutedCmdCount();
+				obj_timer.start();
 
 				createObject(attribs);
+
+				//Accumulating the per type creation statistics
+				PhaseStats &stats=create_stats[obj_type];
+				stats.wall_time+=obj_timer.elapsed();
+				stats.cpu_time+=((std::clock() - cpu_mark) * 1000) / CLOCKS_PER_SEC;
+				stats.query_count+=Connection::getExecutedCmdCount() - qry_mark;
 			}
 			else
 				constraints.push_back(attribs);
@@ -346,6 +1093,12 @@ void DatabaseImportHelper::createObjects()
 		progress=(i/static_cast<double>(creation_order.size())) * 100;
 	}
 
+	for(auto &itr_st : create_stats)
+	{
+		itr_st.second.phase=QString("creation:%1").arg(BaseObject::getSchemaName(itr_st.first));
+		import_stats.push_back(itr_st.second);
+	}
+
 	#ifdef DEMO_VERSION
 		#warning "DEMO VERSION: disabling object recreation in reverse engineering."
 	#else
@@ -375,12 +1128,13 @@ void DatabaseImportHelper::createObjects()
 				obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
 				itr++;
 
-				emit s_progressUpdated(progress,
-										 tr("Trying to recreate object `%1' (%2), oid `%3'...")
-										.arg(attribs[Attributes::Name])
-										.arg(BaseObject::getTypeName(obj_type))
-										.arg(attribs[Attributes::Oid]),
-						obj_type);
+				if(progress_chn.reportProgress(progress, enum_cast(obj_type)))
+					emit s_progressUpdated(progress,
+											 tr("Trying to recreate object `%1' (%2), oid `%3'...")
+											.arg(attribs[Attributes::Name])
+											.arg(BaseObject::getTypeName(obj_type))
+											.arg(attribs[Attributes::Oid]),
+							obj_type);
 
 				try
 				{
@@ -444,11 +1198,12 @@ void DatabaseImportHelper::createConstraints()
 					(attribs[Attributes::Type]==Attributes::CkConstr &&
 					 attribs[Attributes::Inherited]!=Attributes::True))
 			{
-				emit s_progressUpdated(progress,
-										 tr("Creating object `%1' (%2)...")
-										 .arg(attribs[Attributes::Name])
-						.arg(BaseObject::getTypeName(ObjectType::Constraint)),
-						ObjectType::Constraint);
+				if(progress_chn.reportProgress(progress, enum_cast(ObjectType::Constraint)))
+					emit s_progressUpdated(progress,
+											 tr("Creating object `%1' (%2)...")
+											 .arg(attribs[Attributes::Name])
+							.arg(BaseObject::getTypeName(ObjectType::Constraint)),
+							ObjectType::Constraint);
 
 				createObject(attribs);
 			}
@@ -471,8 +1226,9 @@ void DatabaseImportHelper::createPermissions()
 
 	try
 	{
-		unsigned i=0, progress=0;
-		vector<unsigned>::iterator itr, itr_obj=obj_perms.begin();
+		unsigned i=0, progress=0, total=obj_perms.size();
+		vector<unsigned>::iterator itr;
+		std::set<unsigned>::iterator itr_obj=obj_perms.begin();
 		map<unsigned, vector<unsigned>>::iterator itr_cols=col_perms.begin();
 		QString msg=tr("Creating permissions for object `%1' (%2)...");
 		ObjectType obj_type;
@@ -482,14 +1238,19 @@ void DatabaseImportHelper::createPermissions()
 		{
 			attribs = getObjectAttributes(*itr_obj);
 			obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
-			emit s_progressUpdated(progress,
-														 msg.arg(getObjectName(attribs[Attributes::Oid]))
-														.arg(BaseObject::getTypeName(obj_type)), ObjectType::Permission);
+
+			if(progress_chn.reportProgress(progress, enum_cast(ObjectType::Permission)))
+				emit s_progressUpdated(progress,
+															 msg.arg(getObjectName(attribs[Attributes::Oid]))
+															.arg(BaseObject::getTypeName(obj_type)), ObjectType::Permission);
 
 			createPermission(attribs);
-			itr_obj++;
 
-			progress=((i++)/static_cast<double>(obj_perms.size())) * 100;
+			/* Consuming the entry once the permission is created so a resumed
+			 * import doesn't recreate the permissions already in the model */
+			itr_obj=obj_perms.erase(itr_obj);
+
+			progress=((i++)/static_cast<double>(total)) * 100;
 		}
 
 		if(!import_canceled)
@@ -497,6 +1258,7 @@ void DatabaseImportHelper::createPermissions()
 
 		//Create the column level permission
 		i=0;
+		total=col_perms.size();
 		while(itr_cols!=col_perms.end() && !import_canceled)
 		{
 			itr=col_perms[itr_cols->first].begin();
@@ -505,16 +1267,19 @@ void DatabaseImportHelper::createPermissions()
 			{
 				attribs=columns[itr_cols->first][*itr];
 				obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
-				emit s_progressUpdated(progress,
-									   msg.arg(getObjectName(attribs[Attributes::Oid]))
-						.arg(BaseObject::getTypeName(obj_type)), ObjectType::Permission);
+
+				if(progress_chn.reportProgress(progress, enum_cast(ObjectType::Permission)))
+					emit s_progressUpdated(progress,
+										   msg.arg(getObjectName(attribs[Attributes::Oid]))
+							.arg(BaseObject::getTypeName(obj_type)), ObjectType::Permission);
 
 				createPermission(attribs);
 				itr++;
 			}
 
-			itr_cols++;
-			progress=((i++)/static_cast<double>(col_perms.size())) * 100;
+			//Consuming the table entry once all of its columns permissions were created
+			itr_cols=col_perms.erase(itr_cols);
+			progress=((i++)/static_cast<double>(total)) * 100;
 		}
 	}
 	catch(Exception &e)
@@ -562,33 +1327,114 @@ void DatabaseImportHelper::updateFKRelationships()
 	}
 }
 
+void DatabaseImportHelper::retrieveObjects()
+{
+	try
+	{
+		if(!dbmodel)
+			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		/* The whole retrieval is skipped when the attributes were already fetched, either by a
+		 * previous call to this method or by a failed attempt being resumed (see resumeImport()) */
+		if(objs_retrieved)
+			return;
+
+		import_stats.clear();
+
+		/* In delta mode objects whose catalog entries didn't change since the previous
+		 * import are removed from the selection before the retrieval starts */
+		if(delta_mode)
+		{
+			startPhase(QString("delta-filtering"));
+			filterUnchangedObjects();
+			endPhase();
+		}
+
+		/* In skeleton mode the table children objects are dropped from the selection so only
+		 * the tables themselves (and the database level objects) are retrieved and created */
+		if(skip_tab_children)
+		{
+			for(auto obj_type : { ObjectType::Column, ObjectType::Constraint, ObjectType::Trigger,
+														ObjectType::Rule, ObjectType::Index, ObjectType::Policy })
+				object_oids.erase(obj_type);
+
+			column_oids.clear();
+			rebuildCreationOrder();
+		}
+
+		startPhase(QString("sys-objs-retrieval"));
+		retrieveSystemObjects();
+		endPhase();
+
+		startPhase(QString("user-objs-retrieval"));
+		retrieveUserObjects();
+		endPhase();
+
+		if(!import_canceled)
+			objs_retrieved=true;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 void DatabaseImportHelper::importDatabase()
 {
+	TraceLogger::Span trace_span("DatabaseImportHelper::importDatabase");
+
 	try
 	{
 		if(!dbmodel)
 			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		progress_chn.reset();
 		dbmodel->setLoadingModel(true);
+
+		/* The retrieval (and the statistics reset) is performed only when not already done by a direct
+		 * call to retrieveObjects() or by a previous failed attempt that is now being resumed, in which
+		 * cases the statistics of the earlier run are kept so the retrieval phases stay accounted */
+		retrieveObjects();
+
 		dbmodel->setObjectListsCapacity(creation_order.size());
 
-		retrieveSystemObjects();
-		retrieveUserObjects();
+		startPhase(QString("objects-creation"));
 		createObjects();
+		endPhase();
+
+		startPhase(QString("table-inheritances"));
 		createTableInheritances();
+		endPhase();
+
+		startPhase(QString("table-partitionings"));
 		createTablePartitionings();
+		endPhase();
+
+		startPhase(QString("constraints-creation"));
 		createConstraints();
+		endPhase();
+
 		destroyDetachedColumns();
+
+		startPhase(QString("permissions-creation"));
 		createPermissions();
+		endPhase();
 
 		if(update_fk_rels)
+		{
+			startPhase(QString("fk-rels-update"));
 			updateFKRelationships();
+			endPhase();
+		}
 
 		if(!inherited_cols.empty())
 		{
 			emit s_progressUpdated(100, tr("Validating relationships..."), ObjectType::Relationship);
 			dbmodel->setLoadingModel(false);
+
+			startPhase(QString("rels-validation"));
 			dbmodel->validateRelationships();
+			endPhase();
 		}
 
 		if(!import_canceled)
@@ -596,6 +1442,10 @@ void DatabaseImportHelper::importDatabase()
 			swapSequencesTablesIds();
 			assignSequencesToColumns();
 
+			//Persisting the watermarks so the next delta import can skip the unchanged objects
+			if(delta_mode)
+				saveDeltaSnapshot();
+
 			if(!errors.empty())
 			{
 				QString log_name;
@@ -656,7 +1506,18 @@ void DatabaseImportHelper::importDatabase()
 	}
 	catch(Exception &e)
 	{
-		resetImportParameters();
+		/* When the resumable mode is enabled the import state is preserved so the user
+		 * can continue the operation via resumeImport() after fixing the cause of the
+		 * failure (e.g. reestablishing the connection to the server) */
+		if(resumable && !import_canceled)
+		{
+			pending_import=true;
+			connection.close();
+			catalog.closeConnection();
+			Connection::setPrintSQL(false);
+		}
+		else
+			resetImportParameters();
 
 		/* When running in a separated thread (other than the main application thread)
 		redirects the error in form of signal */
@@ -695,7 +1556,7 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 
 	try
 	{
-		if(!import_canceled && std::find(created_objs.begin(), created_objs.end(), oid)==created_objs.end())
+		if(!import_canceled && created_objs.count(oid)==0)
 		{
 			if(TableObject::isTableObject(obj_type))
 				attribs[Attributes::DeclInTable]="";
@@ -718,11 +1579,10 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 			}
 
 			/* Due to the object recreation mechanism there are some situations when pgModeler fails to recreate
-			them due to the duplication of permissions. So, to avoid this problem we need to check if the OID of the
-			object was previously registered in the vector of permissions to be created */
-			if(!attribs[Attributes::Permission].isEmpty() &&
-				 std::find(obj_perms.begin(), obj_perms.end(), oid)==obj_perms.end())
-				obj_perms.push_back(oid);
+			them due to the duplication of permissions. The set of oids guarantees that the object is registered
+			only once in the permissions to be created */
+			if(!attribs[Attributes::Permission].isEmpty())
+				obj_perms.insert(oid);
 
 			if(debug_mode)
 			{
@@ -774,7 +1634,7 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 
 			/* Register that the object was successfully created in order to avoid
 			 * creating it again on the recursive object creation. (see getDependencyObject()) */
-			created_objs.push_back(oid);
+			created_objs.insert(oid);
 		}
 	}
 	catch(Exception &e)
@@ -782,7 +1642,7 @@ void DatabaseImportHelper::createObject(attribs_map &attribs)
 		/* We just ignore the object duplication error and just mark the
 		 * related object's attribs so it'll not be processed again */
 		if(e.getErrorCode() == ErrorCode::AsgDuplicatedObject)
-			created_objs.push_back(oid);
+			created_objs.insert(oid);
 		else
 		{
 			throw Exception(Exception::getErrorMessage(ErrorCode::ObjectNotImported)
@@ -855,7 +1715,7 @@ QString DatabaseImportHelper::getDependencyObject(const QString &oid, ObjectType
 				/* If the attributes of the dependency exists but it was not created on the model yet,
 					 pgModeler will create it and it's dependencies recursively */
 				if(recursive_dep_res && !TableObject::isTableObject(obj_type) &&
-						obj_type!=ObjectType::Database && dbmodel->getObjectIndex(obj_attr[Attributes::Name], obj_type) < 0)
+						obj_type!=ObjectType::Database && !getModelObject(obj_attr[Attributes::Name], obj_type))
 					createObject(obj_attr);
 
 				if(use_signature)
@@ -936,6 +1796,12 @@ void DatabaseImportHelper::resetImportParameters()
 	inherited_cols.clear();
 	imported_tables.clear();
 	created_objs.clear();
+	delta_xmins.clear();
+	obj_names_cache.clear();
+	obj_signatures_cache.clear();
+	model_objs_cache.clear();
+	pending_import=false;
+	objs_retrieved=false;
 }
 
 QString DatabaseImportHelper::dumpObjectAttributes(attribs_map &attribs)
@@ -1679,7 +2545,7 @@ void DatabaseImportHelper::createType(attribs_map &attribs)
 				{
 					type_attrib.setName(values[0].remove('"'));
 					type_attrib.setType(PgSqlType::parseString(values[1].remove('\\')));
-					type_attrib.setCollation(dbmodel->getObject(getObjectName(values[2].remove('"')),	ObjectType::Collation));
+					type_attrib.setCollation(getModelObject(getObjectName(values[2].remove('"')), ObjectType::Collation));
 					attribs[Attributes::TypeAttribute]+=type_attrib.getCodeDefinition(SchemaParser::XmlDefinition);
 				}
 			}
@@ -1767,7 +2633,7 @@ void DatabaseImportHelper::createTable(attribs_map &attribs)
 			attribs[Attributes::PartitionedTable] =
 					getDependencyObject(attribs[Attributes::PartitionedTable], ObjectType::Table, true, auto_resolve_deps, false);
 
-			partitioned_tab = dbmodel->getTable(attribs[Attributes::PartitionedTable]);
+			partitioned_tab = dynamic_cast<Table *>(getModelObject(attribs[Attributes::PartitionedTable], ObjectType::Table));
 			table->setPartionedTable(partitioned_tab);
 
 			if(!partitioned_tab)
@@ -1815,7 +2681,7 @@ void DatabaseImportHelper::createTable(attribs_map &attribs)
 				if(i < collations.size() && collations[i] != QString("0"))
 				{
 					coll_name = getDependencyObject(collations[i], ObjectType::Collation, false, true, false);
-					coll = dynamic_cast<Collation *>(dbmodel->getObject(coll_name, ObjectType::Collation));
+					coll = dynamic_cast<Collation *>(getModelObject(coll_name, ObjectType::Collation));
 
 					//Even if the collation exists we'll ignore it when it is the "pg_catalog.default"
 					if(coll && (!coll->isSystemObject() ||
@@ -1827,7 +2693,7 @@ void DatabaseImportHelper::createTable(attribs_map &attribs)
 				if(i < opclasses.size() && opclasses[i] != QString("0"))
 				{
 					opc_name = getDependencyObject(opclasses[i], ObjectType::OpClass, true, true, false);
-					opclass = dynamic_cast<OperatorClass *>(dbmodel->getObject(opc_name, ObjectType::OpClass));
+					opclass = dynamic_cast<OperatorClass *>(getModelObject(opc_name, ObjectType::OpClass));
 
 					if(opclass)
 						part_key.setOperatorClass(opclass);
@@ -1923,11 +2789,11 @@ void DatabaseImportHelper::createView(attribs_map &attribs)
 		// Configuring the reference tables
 		for(auto &tab_oid : Catalog::parseArrayValues(attribs[Attributes::RefTables]))
 		{
-			ref_tab = dbmodel->getTable(getDependencyObject(tab_oid, ObjectType::Table, true, true, false));
+			ref_tab = dynamic_cast<Table *>(getModelObject(getDependencyObject(tab_oid, ObjectType::Table, true, true, false), ObjectType::Table));
 
 			// If we couldn't get a table from tab_oid we try to get a foreign table
 			if(!ref_tab)
-				ref_tab = dbmodel->getForeignTable(getDependencyObject(tab_oid, ObjectType::ForeignTable, true, true, false));
+				ref_tab = dynamic_cast<ForeignTable *>(getModelObject(getDependencyObject(tab_oid, ObjectType::ForeignTable, true, true, false), ObjectType::ForeignTable));
 
 			ref.addReferencedTable(ref_tab);
 		}
@@ -2020,12 +2886,12 @@ void DatabaseImportHelper::createIndex(attribs_map &attribs)
 
 		attribs[Attributes::Factor]=QString("90");
 		tab_name=getDependencyObject(attribs[Attributes::Table], ObjectType::Table, true, auto_resolve_deps, false);
-		parent_tab=dynamic_cast<BaseTable *>(dbmodel->getObject(tab_name, ObjectType::Table));
+		parent_tab=dynamic_cast<BaseTable *>(getModelObject(tab_name, ObjectType::Table));
 
 		if(!parent_tab)
 		{
 			tab_name=getDependencyObject(attribs[Attributes::Table], ObjectType::View, true, auto_resolve_deps, false);
-			parent_tab=dynamic_cast<BaseTable *>(dbmodel->getObject(tab_name, ObjectType::View));
+			parent_tab=dynamic_cast<BaseTable *>(getModelObject(tab_name, ObjectType::View));
 
 			if(!parent_tab)
 				throw Exception(Exception::getErrorMessage(ErrorCode::RefObjectInexistsModel)
@@ -2060,7 +2926,7 @@ void DatabaseImportHelper::createIndex(attribs_map &attribs)
 			if(i < collations.size() && collations[i]!=QString("0"))
 			{
 				coll_name=getDependencyObject(collations[i], ObjectType::Collation, false, true, false);
-				coll=dynamic_cast<Collation *>(dbmodel->getObject(coll_name, ObjectType::Collation));
+				coll=dynamic_cast<Collation *>(getModelObject(coll_name, ObjectType::Collation));
 
 				//Even if the collation exists we'll ignore it when it is the "pg_catalog.default"
 				if(coll && (!coll->isSystemObject() ||
@@ -2071,7 +2937,7 @@ void DatabaseImportHelper::createIndex(attribs_map &attribs)
 			if(i < opclasses.size() && opclasses[i]!=QString("0"))
 			{
 				opc_name=getDependencyObject(opclasses[i], ObjectType::OpClass, true, true, false);
-				opclass=dynamic_cast<OperatorClass *>(dbmodel->getObject(opc_name, ObjectType::OpClass));
+				opclass=dynamic_cast<OperatorClass *>(getModelObject(opc_name, ObjectType::OpClass));
 
 				if(opclass)
 					elem.setOperatorClass(opclass);
@@ -2122,7 +2988,7 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 				attribs[Attributes::Factor]=factor[0].remove(QString("fillfactor="));
 
 			attribs[attribs[Attributes::Type]]=Attributes::True;
-			table=dynamic_cast<PhysicalTable *>(dbmodel->getObject(tab_name, tab_type));
+			table=dynamic_cast<PhysicalTable *>(getModelObject(tab_name, tab_type));
 
 			if(attribs[Attributes::Type]==Attributes::ExConstr)
 			{
@@ -2164,7 +3030,7 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 					if(i < opclasses.size() && opclasses[i]!=QString("0"))
 					{
 						opc_name=getDependencyObject(opclasses[i], ObjectType::OpClass, true, true, false);
-						opclass=dynamic_cast<OperatorClass *>(dbmodel->getObject(opc_name, ObjectType::OpClass));
+						opclass=dynamic_cast<OperatorClass *>(getModelObject(opc_name, ObjectType::OpClass));
 
 						if(opclass)
 							elem.setOperatorClass(opclass);
@@ -2173,7 +3039,7 @@ void DatabaseImportHelper::createConstraint(attribs_map &attribs)
 					if(i < opers.size() && opers[i]!=QString("0"))
 					{
 						op_name=getDependencyObject(opers[i], ObjectType::Operator, true, true, false);
-						oper=dynamic_cast<Operator *>(dbmodel->getObject(op_name, ObjectType::Operator));
+						oper=dynamic_cast<Operator *>(getModelObject(op_name, ObjectType::Operator));
 
 						if(oper)
 							elem.setOperator(oper);
@@ -2359,7 +3225,7 @@ void DatabaseImportHelper::createForeignTable(attribs_map &attribs)
 			attribs[Attributes::PartitionedTable] =
 					getDependencyObject(attribs[Attributes::PartitionedTable], ObjectType::Table, true, auto_resolve_deps, false);
 
-			partitioned_tab = dbmodel->getTable(attribs[Attributes::PartitionedTable]);
+			partitioned_tab = dynamic_cast<Table *>(getModelObject(attribs[Attributes::PartitionedTable], ObjectType::Table));
 			ftable->setPartionedTable(partitioned_tab);
 
 			if(!partitioned_tab)
@@ -2431,7 +3297,7 @@ void DatabaseImportHelper::createPermission(attribs_map &attribs)
 				else
 				{
 					sig = getObjectName(attribs[Attributes::Oid], true);
-					object = dbmodel->getObject(getObjectName(attribs[Attributes::Oid], true), obj_type);
+					object = getModelObject(getObjectName(attribs[Attributes::Oid], true), obj_type);
 				}
 			}
 			else
@@ -2452,13 +3318,13 @@ void DatabaseImportHelper::createPermission(attribs_map &attribs)
 
 			if(!privs.empty() || gop_privs.empty())
 			{
-				role=dynamic_cast<Role *>(dbmodel->getObject(role_name, ObjectType::Role));
+				role=dynamic_cast<Role *>(getModelObject(role_name, ObjectType::Role));
 
 				if(auto_resolve_deps && !role_name.isEmpty() && !role)
 				{
 					QString oid = catalog.getObjectOID(role_name, ObjectType::Role);
 					getDependencyObject(oid, ObjectType::Role);
-					role=dynamic_cast<Role *>(dbmodel->getObject(role_name, ObjectType::Role));
+					role=dynamic_cast<Role *>(getModelObject(role_name, ObjectType::Role));
 				}
 
 				/* If the role doesn't exists and there is a name defined, throws an error because
@@ -2631,8 +3497,8 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, vector<unsigned>
 	if(tab_oid == 0)
 		return;
 
-	//Retrieving columns if they were not retrieved yet
-	if(columns[attribs[Attributes::Oid].toUInt()].empty() && auto_resolve_deps)
+	//Retrieving columns if they were not retrieved yet (never done when importing skeleton tables)
+	if(columns[attribs[Attributes::Oid].toUInt()].empty() && auto_resolve_deps && !skip_tab_children)
 	{
 		QString sch_name;
 		sch_name = getDependencyObject(attribs[Attributes::SchemaOid], ObjectType::Schema, true, auto_resolve_deps, false);
@@ -2765,7 +3631,7 @@ void DatabaseImportHelper::createColumns(attribs_map &attribs, vector<unsigned>
 		if(auto_resolve_deps && !itr->second[Attributes::Collation].isEmpty())
 			getDependencyObject(itr->second[Attributes::Collation], ObjectType::Collation);
 
-		col.setCollation(dbmodel->getObject(getObjectName(itr->second[Attributes::Collation]),ObjectType::Collation));
+		col.setCollation(getModelObject(getObjectName(itr->second[Attributes::Collation]), ObjectType::Collation));
 		attribs[Attributes::Columns]+=col.getCodeDefinition(SchemaParser::XmlDefinition);
 		itr++;
 		col_idx++;
@@ -2879,7 +3745,7 @@ void DatabaseImportHelper::__createTableInheritances()
 		{
 			//Get the child table resolving it's name from the oid
 			QString tab_name = getObjectName(user_objs[oid][Attributes::Oid]);
-			child_tab=dynamic_cast<PhysicalTable *>(dbmodel->getObject(tab_name, tab_type));
+			child_tab=dynamic_cast<PhysicalTable *>(getModelObject(tab_name, tab_type));
 
 			while(!inh_list.isEmpty())
 			{
@@ -2894,7 +3760,7 @@ void DatabaseImportHelper::__createTableInheritances()
 				}
 
 				tab_type = static_cast<ObjectType>(tab_attribs[Attributes::ObjectType].toUInt());
-				parent_tab=dynamic_cast<PhysicalTable *>(dbmodel->getObject(getObjectName(inh_list.front()), tab_type));
+				parent_tab=dynamic_cast<PhysicalTable *>(getModelObject(getObjectName(inh_list.front()), tab_type));
 
 				try
 				{
@@ -2954,6 +3820,14 @@ QString DatabaseImportHelper::getObjectName(const QString &oid, bool signature_f
 		return "";
 	else
 	{
+		/* Names and signatures don't change during an import, so once resolved they are cached to
+		 * avoid recomputing schema prefixes and function/operator signatures on every reference */
+		std::map<unsigned, QString> &names_cache=(signature_form ? obj_signatures_cache : obj_names_cache);
+		std::map<unsigned, QString>::iterator cache_itr=names_cache.find(obj_oid);
+
+		if(cache_itr!=names_cache.end())
+			return cache_itr->second;
+
 		attribs_map obj_attr = getObjectAttributes(obj_oid);
 
 		if(obj_attr.empty())
@@ -3025,6 +3899,7 @@ QString DatabaseImportHelper::getObjectName(const QString &oid, bool signature_f
 					obj_name+=QString("(") + params.join(',') + QString(")");
 			}
 
+			names_cache[obj_oid]=obj_name;
 			return obj_name;
 		}
 	}
@@ -29,9 +29,33 @@
 #include <QThread>
 #include "catalog.h"
 #include "widgets/modelwidget.h"
+#include "progresschannel.h"
+#include <QElapsedTimer>
+#include <QHash>
 #include <random>
+#include <set>
+#include <ctime>
 
 class DatabaseImportHelper: public QObject {
+	public:
+		//! \brief Maximum amount of connections accepted by the parallel retrieval mode
+		static constexpr unsigned MaxParallelConns=16;
+
+		/*! \brief Stores the timings and query count measured for a single import phase.
+		Comparing the wall time, client cpu time and query count of a phase tells whether
+		it is network/server bound (high wall time, low cpu, many queries) or client
+		bound (wall time close to cpu time) (see getImportStats()) */
+		struct PhaseStats {
+			//! \brief Phase identifier (e.g. user-objs-retrieval, creation:table)
+			QString phase;
+
+			//! \brief Wall clock and client cpu times of the phase (milliseconds)
+			qint64 wall_time=0, cpu_time=0;
+
+			//! \brief Amount of queries executed in the server during the phase
+			quint64 query_count=0;
+		};
+
 	private:
 		Q_OBJECT
 		
@@ -39,14 +63,43 @@ class DatabaseImportHelper: public QObject {
 		default_random_engine rand_num_engine;
 		
 		static const QString UnkownObjectOidXml;
-		
+
+		//! \brief Indicates if the persistent catalog cache is enabled (see setCatalogCacheEnabled())
+		static bool catalog_cache_enabled;
+
+		//! \brief Magic bytes used to identify catalog cache files
+		static const QByteArray CatalogCacheMagic;
+
+		//! \brief Current version of the catalog cache file format
+		static const quint32 CatalogCacheVersion;
+
+		//! \brief Magic bytes used to identify delta snapshot files (see setDeltaMode())
+		static const QByteArray DeltaSnapshotMagic;
+
+		//! \brief Current version of the delta snapshot file format
+		static const quint32 DeltaSnapshotVersion;
+
+		/*! \brief Amount of connections used to retrieve the user objects attributes in parallel.
+		Values below 2 keep the retrieval serial over a single connection (see setParallelRetrieval()) */
+		static unsigned parallel_conns;
+
+		/*! \brief Maximum amount of object attribute sets held by the streaming retrieval queue.
+		The producer thread blocks when the queue is full so the memory spent on tuples not yet
+		merged into the attribute maps stays bounded (see retrieveUserObjects()) */
+		static constexpr unsigned MaxQueuedObjAttribs=4096;
+
 		/*! \brief File handle to log the import process. This file is opened for writing only when
 		the 'ignore_errors' is true */
 		QFile import_log;
 		
 		//! \brief Stores the errors generated during the import
 		vector<Exception> errors;
-		
+
+		/*! \brief Coalescing channel through which the hot per-object loops report progress. The
+		queued s_progressUpdated emission happens only when the coalesced percentage advances, so
+		the reporting traffic stays bounded no matter the object throughput (see also hasNews()) */
+		ProgressChannel progress_chn;
+
 		//! \brief Instance of catalog class to query system catalogs
 		Catalog catalog;
 		
@@ -78,7 +131,70 @@ class DatabaseImportHelper: public QObject {
 		rand_rel_colors,
 		
 		//! \brief Indicates to the importer that the relationship update step must be executed
-		update_fk_rels;
+		update_fk_rels,
+
+		/*! \brief Indicates that the import must run in delta mode, skipping the objects whose
+		catalog entries didn't change since the last import of the same database (see setDeltaMode()) */
+		delta_mode,
+
+		/*! \brief Indicates that the table children objects must be left out of the import, producing
+		lightweight skeleton tables (see setSkipTableChildren()) */
+		skip_tab_children,
+
+		/*! \brief Indicates that the import state must be kept upon failures so the operation can be
+		resumed from where it stopped instead of restarting from scratch (see setResumableImport()) */
+		resumable,
+
+		//! \brief Indicates that a failed import kept its state and is waiting to be resumed
+		pending_import,
+
+		/*! \brief Indicates that the objects' attributes were already retrieved from the catalog,
+		avoiding a full refetch when a pending import is resumed */
+		objs_retrieved,
+
+		/*! \brief Indicates that the listings returned by getObjects() must be kept in a local
+		snapshot cache, serving repeated requests without re-querying the catalog
+		(see setCachedQueriesEnabled()) */
+		use_cached_queries;
+
+		/*! \brief Snapshot cache of the listings returned by getObjects(), keyed by the signature of
+		the request (query filter, types, extra attribs, schema and table). Only used when
+		use_cached_queries is true */
+		std::map<QString, std::vector<attribs_map>> cached_listings;
+
+		/*! \brief Builds the signature under which a getObjects() listing is stored in the
+		snapshot cache (see cached_listings) */
+		QString getListingCacheKey(const vector<ObjectType> &obj_types, const QString &schema, const QString &table, const attribs_map &extra_attribs);
+
+		/*! \brief Stores the oid -> xmin watermarks read when the delta filtering took place so the
+		snapshot saved at the end of the import reflects the server state at retrieval time */
+		std::map<unsigned, unsigned> delta_xmins;
+
+		/*! \brief Caches the names (and signatures) of the objects resolved by getObjectName(), keyed by
+		oid. Avoids recomputing schema prefixes and function/operator signatures, which involves parsing
+		type arrays, on every dependency reference */
+		std::map<unsigned, QString> obj_names_cache, obj_signatures_cache;
+
+		/*! \brief Caches the objects already found in the destination model, keyed by type + name.
+		Avoids the linear DatabaseModel::getObject() scans performed on every dependency resolution,
+		which made the resolution cost grow quadratically with the model size. Must not be used for
+		object types that can be removed during the import (e.g. columns, base relationships) */
+		QHash<QString, BaseObject *> model_objs_cache;
+
+		//! \brief Stores the per phase statistics collected by the last import (see getImportStats())
+		vector<PhaseStats> import_stats;
+
+		//! \brief Measures the wall clock time of the phase being currently instrumented
+		QElapsedTimer phase_timer;
+
+		//! \brief Client cpu clock mark taken when the current phase started
+		std::clock_t phase_cpu_mark=0;
+
+		//! \brief Executed commands counter snapshot taken when the current phase started
+		quint64 phase_qry_mark=0;
+
+		//! \brief Identifier of the phase being currently instrumented
+		QString curr_phase;
 		
 		//! \brief Stores the selected objects oids to be imported
 		map<ObjectType, vector<unsigned>> object_oids;
@@ -102,14 +218,16 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Stores all constraints attributes
 		vector<attribs_map> constraints;
 
-		//! \brief Stores the OIDs of the objects successfully created
-		vector<unsigned> created_objs;
+		/*! \brief Stores the OIDs of the objects successfully created. An ordered set is used here since
+		this container is queried once per created object (see createObject), which made the previous
+		linear scans dominate the creation time on huge databases */
+		std::set<unsigned> created_objs;
 
 		//! \brief Stores all selected columns attributes
 		map<unsigned, map<unsigned, attribs_map>> columns;
 		
 		//! \brief Stores the oids of all objects that has permissions to be created
-		vector<unsigned> obj_perms;
+		std::set<unsigned> obj_perms;
 		
 		//! \brief Stores the oids of all columns that has permissions to be created
 		map<unsigned, vector<unsigned>> col_perms;
@@ -225,6 +343,51 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Return a string containing all attributes and their values in a formatted way
 		QString dumpObjectAttributes(attribs_map &attribs);
 
+		/*! \brief Returns a short hash derived from the connection parameters (host, port and database)
+		used to name the per-database auxiliary files (catalog cache and delta snapshot) */
+		QString getServerFingerprintId();
+
+		/*! \brief Returns the path to the catalog cache file related to the current server/database.
+		The file name is derived from the connection parameters so each server/database pair owns its own cache file */
+		QString getCatalogCacheFilePath();
+
+		//! \brief Returns the path to the delta snapshot file related to the current server/database
+		QString getDeltaSnapshotFilePath();
+
+		/*! \brief Removes from the current oid selection the objects whose catalog entries didn't change
+		since the snapshot saved by the previous delta import, rebuilding the creation order accordingly.
+		Returns true when the filtering took place. Missing, stale or incompatible snapshots make the
+		method return false leaving the selection untouched (full import) */
+		bool filterUnchangedObjects();
+
+		/*! \brief Writes the oid -> xmin watermarks of the current database to the delta snapshot file
+		so the next delta import can detect the unchanged objects */
+		void saveDeltaSnapshot();
+
+		//! \brief Refills the creation order vector from the currently selected oids
+		void rebuildCreationOrder();
+
+		/*! \brief Tries to fill the system_objs and types maps from the on-disk catalog cache, returning true on success.
+		Stale, truncated or version-incompatible cache files are silently ignored and false is returned so the
+		caller falls back to the full catalog scan */
+		bool loadCatalogCache();
+
+		/*! \brief Writes the system_objs and types maps to the on-disk catalog cache together with the
+		fingerprint of the server/database they were retrieved from */
+		void saveCatalogCache();
+
+		/*! \brief Returns the object of the specified type and name present in the destination model,
+		going through the lookup cache first and registering cache misses that are found by the
+		linear model scan. Returns nullptr when the object doesn't exist in the model yet */
+		BaseObject *getModelObject(const QString &name, ObjectType obj_type);
+
+		/*! \brief Starts the instrumentation of an import phase, taking the wall clock, cpu clock
+		and executed commands marks used by endPhase() to compute the phase statistics */
+		void startPhase(const QString &phase);
+
+		//! \brief Finishes the instrumentation of the current phase, appending its statistics to import_stats
+		void endPhase();
+
 	public:
 		DatabaseImportHelper(QObject *parent = nullptr);
 		
@@ -243,7 +406,69 @@ class DatabaseImportHelper: public QObject {
 		
 		//! \brief Configures the import parameters
 		void setImportOptions(bool import_sys_objs, bool import_ext_objs, bool auto_resolve_deps, bool ignore_errors, bool debug_mode, bool rand_rel_colors, bool update_fk_rels);
-		
+
+		/*! \brief Returns the coalescing progress channel of the helper. Consumers may sample it from
+		a UI timer (see ProgressChannel::hasNews()) for updates finer than the coalesced signals */
+		ProgressChannel &getProgressChannel();
+
+		/*! \brief Enables the persistent catalog cache. When enabled, the system objects metadata retrieved during
+		an import is saved to disk keyed by the server identity (host, port, database, server version and catalog
+		watermarks) so a subsequent import against an unchanged database skips the full system catalog scan */
+		static void setCatalogCacheEnabled(bool value);
+
+		//! \brief Returns true when the persistent catalog cache is enabled
+		static bool isCatalogCacheEnabled();
+
+		/*! \brief Defines the amount of connections used to retrieve the user objects attributes in parallel.
+		Each worker connection fetches the attributes of a distinct object type so the server can process the
+		catalog queries simultaneously. Values below 2 disable the parallel mode and values above the maximum
+		supported (16) are clamped */
+		static void setParallelRetrieval(unsigned conn_count);
+
+		//! \brief Returns the amount of connections used by the parallel retrieval mode
+		static unsigned getParallelRetrieval();
+
+		/*! \brief Enables the delta import mode. In this mode the helper compares the xmin watermarks of the
+		catalog entries against the snapshot saved by the previous import of the same database and removes the
+		unchanged objects from the selection, so only new or modified objects are retrieved and created. When no
+		valid snapshot exists a full import is performed and the snapshot is (re)created at the end. Since there
+		is no mapping between catalog oids and model objects, dropped objects are not detected in this mode */
+		void setDeltaMode(bool value);
+
+		/*! \brief When enabled, the table children objects (columns, constraints, triggers, rules, indexes
+		and policies) are left out of the import so tables are created as lightweight skeletons. This makes
+		imports meant only for browsing huge databases considerably faster. The children of the tables of
+		interest can be brought into the model later by a new import scoped to them via object filters */
+		void setSkipTableChildren(bool value);
+
+		/*! \brief When enabled, a failure during the import (e.g. a dropped connection) doesn't discard the
+		work done so far: the retrieved attributes, the already created objects and the pending permissions
+		are kept in memory so the operation can be continued through resumeImport(), reusing the objects
+		already present in the model instead of restarting from scratch */
+		void setResumableImport(bool value);
+
+		//! \brief Returns true when a failed import kept its state and can be continued via resumeImport()
+		bool canResumeImport();
+
+		/*! \brief Continues a previously failed import from where it stopped. The connection to the server
+		is reestablished and only the steps not yet finished are executed. This method raises an exception
+		when there is no pending import to be resumed */
+		void resumeImport();
+
+		/*! \brief Runs only the attribute retrieval steps of the import, leaving the model untouched.
+		A subsequent call to importDatabase() skips the retrieval (the same mechanism used by resumeImport())
+		and goes straight to the object creation. Since the retrieval only fills the helper's internal
+		attribute maps it is safe to run this method for several helpers concurrently, which is not
+		the case for the creation steps that manipulate globally shared state */
+		void retrieveObjects();
+
+		/*! \brief Returns the per phase statistics (wall/cpu timings and query counts)
+		collected by the last import operation */
+		vector<PhaseStats> getImportStats();
+
+		//! \brief Returns the statistics collected by the last import operation formatted as JSON
+		QString getImportStatsAsJson();
+
 		//! \brief Returns the last system OID value for the current database
 		unsigned getLastSystemOID();
 		
@@ -273,8 +498,30 @@ class DatabaseImportHelper: public QObject {
 				before assign the connection to this class. */
 		vector<attribs_map> getObjects(vector<ObjectType> obj_type, const QString &schema="", const QString &table="", attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Enables the snapshot cache for getObjects() listings. While enabled, repeated listings of
+		the same branch (types/schema/table) are served locally instead of re-querying the catalog, which is
+		convenient for interactive browsing over high latency connections (see DatabaseExplorerWidget).
+		Disabling the cache also drops its contents */
+		void setCachedQueriesEnabled(bool value);
+
+		/*! \brief Drops the cached getObjects() listings. When schema (and optionally table) is specified
+		only the entries related to that branch are dropped, otherwise the whole cache is emptied */
+		void invalidateCachedQueries(const QString &schema="", const QString &table="");
+
+		/*! \brief Warms up the snapshot cache with the listings of the whole database hierarchy using
+		a few batched catalog queries instead of one query per schema/table. This method is meant to be
+		called from a worker thread so the subsequent per node getObjects() requests, performed while
+		a tree or grid is being populated on the GUI thread, are all served locally. Requires the
+		snapshot cache to be previously enabled (see setCachedQueriesEnabled()) */
+		void prefetchObjectListings();
+
 		void retrieveSystemObjects();
 		void retrieveUserObjects();
+
+		/*! \brief Retrieves the user objects attributes sharding the work by object type over a pool
+		of parallel connections (see setParallelRetrieval()). The results are merged in the same order
+		produced by the serial retrieval */
+		void retrieveUserObjectsParallel();
 		void retrieveTableColumns(const QString &sch_name, const QString &tab_name, vector<unsigned> col_ids={});
 		void createObjects();
 		void createConstraints();
@@ -54,6 +54,8 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	}
 
 	table_oid=0;
+	page_limit=0;
+	more_rows_avail=keyset_paging=false;
 	GuiUtilsNs::configureWidgetFont(hint_lbl, GuiUtilsNs::MediumFontFactor);
 	GuiUtilsNs::configureWidgetFont(warning_lbl, GuiUtilsNs::MediumFontFactor);
 
@@ -159,6 +161,13 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	connect(table_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(listColumns()));
 	connect(table_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(retrieveData()));
 	connect(refresh_tb, SIGNAL(clicked()), this, SLOT(retrieveData()));
+
+	connect(results_tbw->verticalScrollBar(), &QScrollBar::valueChanged, this, [this](int value){
+		//Fetching the next result page when the grid is scrolled to the bottom
+		if(value==results_tbw->verticalScrollBar()->maximum())
+			fetchMoreRows();
+	});
+
 	connect(add_ord_col_tb, SIGNAL(clicked()), this, SLOT(addSortColumnToList()));
 	connect(ord_columns_lst, SIGNAL(itemDoubleClicked(QListWidgetItem*)), this, SLOT(removeSortColumnFromList()));
 	connect(ord_columns_lst, SIGNAL(itemPressed(QListWidgetItem*)), this, SLOT(changeOrderMode(QListWidgetItem*)));
@@ -376,7 +385,6 @@ void DataManipulationForm::retrieveData()
 
 		QString query=QString("SELECT * FROM \"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
 				prev_tab_name;
-		ResultSet res;
 		unsigned limit=limit_spb->value();
 		ObjectType obj_type = static_cast<ObjectType>(table_cmb->currentData(Qt::UserRole).toUInt());
 		vector<int> curr_hidden_cols;
@@ -397,22 +405,44 @@ void DataManipulationForm::retrieveData()
 		if(!filter_txt->toPlainText().trimmed().isEmpty())
 			query+=QString(" WHERE ") + filter_txt->toPlainText();
 
+		/* The pk columns are retrieved before the query is assembled because the pagination
+		 * below relies on them to build a deterministic ordering / keyset continuation */
+		retrievePKColumns(schema_cmb->currentText(), table_cmb->currentText());
+
+		page_query_base=query;
+		page_ord_clause.clear();
+		page_limit=limit;
+		keyset_paging=false;
+
 		//Building the order by clause
 		if(ord_columns_lst->count() > 0)
 		{
 			QStringList ord_cols, col;
 
-			query+=QString("\n ORDER BY ");
-
 			for(int idx=0; idx < ord_columns_lst->count(); idx++)
 			{
 				col=ord_columns_lst->item(idx)->text().split(" ");
 				ord_cols.push_back(QString("\"") + col[0] + QString("\" ") + col[1]);
 			}
 
-			query+=ord_cols.join(QString(", "));
+			page_ord_clause=QString("\n ORDER BY ") + ord_cols.join(QString(", "));
+		}
+		else if(limit > 0 && !pk_col_names.isEmpty())
+		{
+			QStringList ord_cols;
+
+			/* When a limit is set and the user didn't define an explicit ordering we order by the
+			 * pk so the pages fetched on demand (see fetchMoreRows) are deterministic, which also
+			 * enables the keyset continuation instead of the limit/offset one */
+			for(auto &col : pk_col_names)
+				ord_cols.push_back(QString("\"") + col + QString("\""));
+
+			page_ord_clause=QString("\n ORDER BY ") + ord_cols.join(QString(", "));
+			keyset_paging=true;
 		}
 
+		query+=page_ord_clause;
+
 		//Building the limit clause
 		if(limit > 0)
 			query+=QString(" LIMIT %1").arg(limit);
@@ -421,11 +451,19 @@ void DataManipulationForm::retrieveData()
 
 		catalog.setConnection(conn_cat);
 		conn_sql.connect();
-		conn_sql.executeDMLCommand(query, res);
 
-		retrievePKColumns(schema_cmb->currentText(), table_cmb->currentText());
+		/* Dispatching the query in single-row mode: the rows are streamed into the grid as they
+		 * arrive (see the streaming variant of fillResultsTable) instead of being fully
+		 * materialized in memory, while the server already processes the query during the
+		 * fk columns retrieval below */
+		conn_sql.sendDMLCommand(query, true);
+
 		retrieveFKColumns(schema_cmb->currentText(), table_cmb->currentText());
-		SQLExecutionWidget::fillResultsTable(catalog, res, results_tbw, true);
+		SQLExecutionWidget::fillResultsTable(catalog, conn_sql, results_tbw, true);
+
+		/* If the amount of retrieved rows reached the limit the server may hold more of them,
+		 * in this case the next pages are fetched on demand as the grid is scrolled */
+		more_rows_avail=(limit > 0 && static_cast<unsigned>(results_tbw->rowCount()) >= limit);
 
 		export_tb->setEnabled(results_tbw->rowCount() > 0);
 		result_info_wgt->setVisible(results_tbw->rowCount() > 0);
@@ -508,6 +546,91 @@ void DataManipulationForm::retrieveData()
 	}
 }
 
+void DataManipulationForm::fetchMoreRows()
+{
+	if(!more_rows_avail || table_cmb->currentIndex() <= 0)
+		return;
+
+	Catalog catalog;
+	Connection conn_sql=Connection(tmpl_conn_params),
+			conn_cat=Connection(tmpl_conn_params);
+
+	try
+	{
+		QString query=page_query_base;
+		int prev_rows=results_tbw->rowCount();
+		bool keyset_built=false;
+
+		/* Avoiding reentrant fetches triggered by the scrollbar range changes
+		 * while the incoming page is appended to the grid */
+		more_rows_avail=false;
+
+		if(keyset_paging && prev_rows > 0)
+		{
+			QStringList cols, vals;
+			QTableWidgetItem *item=nullptr;
+			int col_idx=-1;
+			QString value;
+
+			/* Keyset continuation: the next page starts right after the last fetched row by
+			 * comparing the pk columns (row-wise) against the values held by the last row of
+			 * the grid, avoiding the increasingly expensive offset scans on large tables */
+			for(auto &col : pk_col_names)
+			{
+				col_idx=col_names.indexOf(col);
+				item=(col_idx >= 0 ? results_tbw->item(prev_rows - 1, col_idx) : nullptr);
+
+				if(!item)
+					break;
+
+				value=item->text();
+				cols.push_back(QString("\"") + col + QString("\""));
+				vals.push_back(QString("'") + value.replace(QChar('\''), QString("''")) + QString("'"));
+			}
+
+			if(cols.size()==pk_col_names.size())
+			{
+				query+=QString(page_query_base.contains(QString(" WHERE ")) ? " AND " : " WHERE ") +
+							 QString("(%1) > (%2)").arg(cols.join(QString(", "))).arg(vals.join(QString(", ")));
+				keyset_built=true;
+			}
+		}
+
+		query+=page_ord_clause;
+		query+=QString(" LIMIT %1").arg(page_limit);
+
+		//Falling back to offset pagination when the keyset continuation can't be built
+		if(!keyset_built)
+			query+=QString(" OFFSET %1").arg(prev_rows);
+
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+
+		catalog.setConnection(conn_cat);
+		conn_sql.connect();
+		conn_sql.sendDMLCommand(query, true);
+		SQLExecutionWidget::fillResultsTable(catalog, conn_sql, results_tbw, true, true);
+
+		more_rows_avail=(static_cast<unsigned>(results_tbw->rowCount() - prev_rows) >= page_limit);
+
+		result_info_lbl->setText(QString("<em>[%1]</em> ").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))) +
+								 tr("Rows returned: <strong>%1</strong>&nbsp;&nbsp;&nbsp;").arg(results_tbw->rowCount()) +
+								 tr("<em>(Limit: <strong>%1</strong>)</em>").arg(limit_spb->value()==0 ? tr("none") : QString::number(limit_spb->value())));
+
+		conn_sql.close();
+		catalog.closeConnection();
+
+		QApplication::restoreOverrideCursor();
+	}
+	catch(Exception &e)
+	{
+		QApplication::restoreOverrideCursor();
+		conn_sql.close();
+		catalog.closeConnection();
+		Messagebox msg_box;
+		msg_box.show(e);
+	}
+}
+
 void DataManipulationForm::disableControlButtons()
 {
 	refresh_tb->setEnabled(schema_cmb->currentIndex() > 0 && table_cmb->currentIndex() > 0);
@@ -1352,6 +1475,7 @@ void DataManipulationForm::saveChanges()
 	{
 		QString cmd;
 		Messagebox msg_box;
+		vector<int> copy_rows;
 
 		msg_box.show(tr("<strong>WARNING:</strong> Once commited its not possible to undo the changes! Proceed with saving?"),
 					 Messagebox::AlertIcon,
@@ -1363,16 +1487,67 @@ void DataManipulationForm::saveChanges()
 			//Forcing the cell editor to be closed by selecting an unexistent cell and clearing the selection
 			results_tbw->setCurrentCell(-1,-1, QItemSelectionModel::Clear);
 
+			/* Selecting the insertion rows that can be streamed through the COPY protocol. Small batches
+			 * keep using one INSERT per row since the copy setup cost wouldn't pay off for them */
+			for(unsigned idx=0; idx < changed_rows.size(); idx++)
+			{
+				if(results_tbw->verticalHeaderItem(changed_rows[idx])->data(Qt::UserRole).toUInt()==OpInsert &&
+						isCopyableRow(changed_rows[idx]))
+					copy_rows.push_back(changed_rows[idx]);
+			}
+
+			if(copy_rows.size() < static_cast<unsigned>(BulkCopyMinRows))
+				copy_rows.clear();
+
+			vector<bool> is_copy_row(results_tbw->rowCount(), false);
+
+			for(int cpy_row : copy_rows)
+				is_copy_row[cpy_row]=true;
+
 			conn.connect();
 			conn.executeDDLCommand(QString("START TRANSACTION"));
 
 			for(unsigned idx=0; idx < changed_rows.size(); idx++)
 			{
 				row=changed_rows[idx];
+
+				//Rows handled by the COPY bulk path are skipped here
+				if(is_copy_row[row])
+					continue;
+
 				cmd=getDMLCommand(row);
 				conn.executeDDLCommand(cmd);
 			}
 
+			//Streaming the selected insertions through a single COPY command
+			if(!copy_rows.empty())
+			{
+				QStringList col_list;
+				size_t cpy_idx=0;
+
+				//bytea columns are ignored (same criteria as getDMLCommand)
+				for(int col=0; col < results_tbw->columnCount(); col++)
+				{
+					if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
+						col_list.push_back(QString("\"%1\"").arg(results_tbw->horizontalHeaderItem(col)->text()));
+				}
+
+				conn.executeCopyFrom(QString("COPY \"%1\".\"%2\" (%3) FROM STDIN")
+														 .arg(schema_cmb->currentText())
+														 .arg(table_cmb->currentText())
+														 .arg(col_list.join(QString(", "))),
+														 [&]() -> QByteArray {
+					if(cpy_idx >= copy_rows.size())
+						return QByteArray();
+
+					/* Keeping track of the row being streamed so a copy failure highlights
+					 * a row near the offending one on the grid (the exact row is reported
+					 * in the error message raised by the server) */
+					row=copy_rows[cpy_idx];
+					return getCopyBuffer(copy_rows[cpy_idx++]);
+				});
+			}
+
 			conn.executeDDLCommand(QString("COMMIT"));
 			conn.close();
 
@@ -1522,6 +1697,71 @@ QString DataManipulationForm::getDMLCommand(int row)
 	return fmt_cmd;
 }
 
+bool DataManipulationForm::isCopyableRow(int row)
+{
+	QTableWidgetItem *item=nullptr;
+	QString value;
+
+	if(row < 0 || row >= results_tbw->rowCount())
+		return false;
+
+	for(int col=0; col < results_tbw->columnCount(); col++)
+	{
+		//bytea columns are ignored (same criteria as getDMLCommand)
+		if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)==QString("bytea"))
+			continue;
+
+		item=results_tbw->item(row, col);
+		value=item->text();
+
+		/* Empty values are saved as DEFAULT and unescaped values as raw expressions,
+		 * both can only be expressed through INSERT commands. Malformed unescaped
+		 * values are also rejected here so the INSERT path raises the proper error */
+		if(value.isEmpty() ||
+				value.startsWith(UtilsNs::UnescValueStart) ||
+				value.endsWith(UtilsNs::UnescValueEnd))
+			return false;
+	}
+
+	return true;
+}
+
+QByteArray DataManipulationForm::getCopyBuffer(int row)
+{
+	QStringList values;
+	QString value;
+
+	if(row < 0 || row >= results_tbw->rowCount())
+		return QByteArray();
+
+	for(int col=0; col < results_tbw->columnCount(); col++)
+	{
+		//bytea columns are ignored (same criteria as getDMLCommand)
+		if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)==QString("bytea"))
+			continue;
+
+		value=results_tbw->item(row, col)->text();
+
+		if(value==SQLExecutionWidget::ColumnNullValue)
+			value=QString("\\N");
+		else
+		{
+			value.replace(QString("\\") + UtilsNs::UnescValueStart, UtilsNs::UnescValueStart);
+			value.replace(QString("\\") + UtilsNs::UnescValueEnd, UtilsNs::UnescValueEnd);
+
+			//Escaping the characters that are special in the COPY text format
+			value.replace(QString("\\"), QString("\\\\"));
+			value.replace(QString("\t"), QString("\\t"));
+			value.replace(QString("\n"), QString("\\n"));
+			value.replace(QString("\r"), QString("\\r"));
+		}
+
+		values.push_back(value);
+	}
+
+	return (values.join(QString("\t")) + QString("\n")).toUtf8();
+}
+
 void DataManipulationForm::resizeEvent(QResizeEvent *event)
 {
 	Qt::ToolButtonStyle style = Qt::ToolButtonIconOnly;
@@ -44,6 +44,10 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		//! \brief Default row colors for each operation type
 		static const QColor RowColors[3];
 
+		/*! \brief Minimum amount of insertion rows needed for saveChanges() to stream them through
+		 the COPY protocol instead of executing one INSERT command per row */
+		static constexpr int BulkCopyMinRows=100;
+
 		CsvLoadWidget *csv_load_wgt;
 
 		SyntaxHighlighter *filter_hl;
@@ -69,6 +73,22 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		/*! \brief Stores the current opened table's oid. This attribute is filled only the table has an primary
 		and it is used to retrieve all foreign keys that references the current table */
 		unsigned table_oid;
+
+		/*! \brief Stores the base query (select + where clause) and the order by clause used by the last
+		data retrieval. Both are reused by fetchMoreRows() to fetch the subsequent result pages */
+		QString page_query_base,
+
+		page_ord_clause;
+
+		//! \brief Amount of rows fetched per page (the limit configured at the last data retrieval)
+		unsigned page_limit;
+
+		//! \brief Indicates that the server may hold more rows beyond the ones currently in the grid
+		bool more_rows_avail,
+
+		/*! \brief Indicates that the next pages are fetched through keyset continuation (comparing the pk
+		columns against the values of the last fetched row) instead of the costlier limit/offset scan */
+		keyset_paging;
 		
 		//! \brief Stores the ids of changed rows. These ids are handled on saveChanges() method
 		vector<int> changed_rows;
@@ -98,6 +118,15 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		
 		//! \brief Generates a DML command for the row depending on the it's operation type
 		QString getDMLCommand(int row);
+
+		/*! \brief Returns true when the row is an insertion whose values can be streamed through COPY,
+		 meaning that all of its cells hold literal values. Rows carrying DEFAULT values (empty cells)
+		 or unescaped expressions (see UtilsNs::UnescValueStart) can only be saved via INSERT commands */
+		bool isCopyableRow(int row);
+
+		/*! \brief Formats the row as a line of the COPY text format: tab separated values with the
+		 special characters escaped (see Connection::executeCopyFrom) */
+		QByteArray getCopyBuffer(int row);
 		
 		//! \brief Remove the rows marked as OP_INSERT which ids are specified on the parameter vector
 		void removeNewRows(vector<int> ins_rows);
@@ -139,6 +168,10 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		
 		//! \brief Retrieve the data for the current table filtering the data as configured on the advanced tab
 		void retrieveData();
+
+		/*! \brief Fetches the next page of rows of the last retrieval, appending them to the grid. Triggered
+		when the results grid is scrolled to the bottom and more rows may be available on the server */
+		void fetchMoreRows();
 		
 		//! \brief Disable the buttons used to handle data
 		void disableControlButtons();
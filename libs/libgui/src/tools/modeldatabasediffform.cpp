@@ -21,8 +21,10 @@
 #include "databaseimportform.h"
 #include "guiutilsns.h"
 #include <QTemporaryFile>
+#include <QtConcurrent/QtConcurrent>
 #include "qtcompat/qlabelcompat.h"
 #include "utilsns.h"
+#include "taskscheduler.h"
 
 bool ModelDatabaseDiffForm::low_verbosity = false;
 map<QString, attribs_map> ModelDatabaseDiffForm::config_params;
@@ -61,6 +63,7 @@ ModelDatabaseDiffForm::ModelDatabaseDiffForm(QWidget *parent, Qt::WindowFlags fl
 		store_in_file_grid->addWidget(file_sel, 0, 1);
 
 		is_adding_new_preset=false;
+		src_snapshot_pending=false;
 		imported_model=loaded_model=source_model=nullptr;
 		src_import_helper=import_helper=nullptr;
 		diff_helper=nullptr;
@@ -74,6 +77,9 @@ ModelDatabaseDiffForm::ModelDatabaseDiffForm(QWidget *parent, Qt::WindowFlags fl
 		sqlcode_hl=new SyntaxHighlighter(sqlcode_txt);
 		sqlcode_hl->loadConfiguration(GlobalAttributes::getSQLHighlightConfPath());
 
+		diff_output_tmr.setInterval(DiffOutputFlushInterval);
+		connect(&diff_output_tmr, SIGNAL(timeout()), this, SLOT(flushDiffOutput()));
+
 		pgsql_ver_cmb->addItems(PgSqlVersions::AllVersions);
 		GuiUtilsNs::configureWidgetFont(message_lbl, GuiUtilsNs::MediumFontFactor);
 
@@ -297,8 +303,13 @@ void ModelDatabaseDiffForm::createThread(unsigned thread_id)
 		diff_helper=new ModelsDiffHelper;
 		diff_helper->moveToThread(diff_thread);
 
+		/* The diff code is streamed to the preview widget as the script sections are resolved,
+		 * avoiding the assembly of a single giant string for huge scripts */
+		diff_helper->setStreamingMode(true);
+
 		connect(diff_thread, SIGNAL(started()), diff_helper, SLOT(diffModels()));
 		connect(diff_helper, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString,ObjectType)));
+		connect(diff_helper, SIGNAL(s_diffCodeGenerated(QString)), this, SLOT(appendDiffCode(QString)));
 		connect(diff_helper, SIGNAL(s_diffFinished()), this, SLOT(handleDiffFinished()));
 		connect(diff_helper, SIGNAL(s_diffAborted(Exception)), this, SLOT(captureThreadError(Exception)));
 		connect(diff_helper, SIGNAL(s_objectsDiffInfoGenerated(ObjectsDiffInfo)), this, SLOT(updateDiffInfo(ObjectsDiffInfo)), Qt::BlockingQueuedConnection);
@@ -365,16 +376,41 @@ void ModelDatabaseDiffForm::destroyThread(unsigned thread_id)
 
 void ModelDatabaseDiffForm::destroyModel()
 {
-	if(imported_model)
-		delete imported_model;
+	DatabaseModel *imp_model=imported_model, *src_model=nullptr;
+
+	/* Any source model distinct from the loaded one is owned by the form: either the
+	 * representation of the source database or the snapshot copy of the loaded model */
+	if(source_model && source_model != loaded_model)
+	{
+		src_model=source_model;
+		source_model=nullptr;
+	}
 
-	if(source_model && source_model != loaded_model && src_database_rb->isChecked())
+	if(src_snapshot_pending)
 	{
-		delete source_model;
-		source_model = nullptr;
+		/* A snapshot copy that was never consumed by the diff (the operation was canceled or
+		 * failed before the comparison step) is reaped and destroyed off the UI thread */
+		QFuture<DatabaseModel *> snap_future=src_snapshot_future;
+
+		src_snapshot_pending=false;
+		model_dtor_sync.addFuture(QtConcurrent::run([snap_future]() mutable {
+			snap_future.waitForFinished();
+			delete snap_future.result();
+		}));
 	}
 
 	imported_model=nullptr;
+
+	if(!imp_model && !src_model)
+		return;
+
+	/* The imported model can hold hundreds of thousands of objects after big imports and
+	 * deleting it freezes the UI for several seconds, so the teardown of the detached
+	 * instances happens on a background worker */
+	model_dtor_sync.addFuture(QtConcurrent::run([imp_model, src_model](){
+		delete imp_model;
+		delete src_model;
+	}));
 }
 
 void ModelDatabaseDiffForm::clearOutput()
@@ -496,7 +532,26 @@ void ModelDatabaseDiffForm::generateDiff()
 
 	if(src_model_rb->isChecked())
 	{
-		source_model = loaded_model;
+		/* Instead of handing the widget's model straight to the diff thread the comparison consumes
+		 * an isolated copy of it, so the user keeps editing the model while the diff runs. The model
+		 * is locked only during the snapshot capture; the heavier materialization of the copy happens
+		 * concurrently with the database import below */
+		QString snapshot_buf=loaded_model->captureSnapshot();
+
+		src_snapshot_error.clear();
+		src_snapshot_pending=true;
+		src_snapshot_future=QtConcurrent::run(&TaskScheduler::getThreadPool(), [this, snapshot_buf]() -> DatabaseModel * {
+			try
+			{
+				return DatabaseModel::materializeSnapshot(snapshot_buf);
+			}
+			catch(Exception &e)
+			{
+				src_snapshot_error=e.getErrorMessage();
+				return nullptr;
+			}
+		});
+
 		total_steps=3;
 	}
 	else
@@ -612,6 +667,25 @@ void ModelDatabaseDiffForm::importDatabase(unsigned thread_id)
 
 void ModelDatabaseDiffForm::diffModels()
 {
+	if(src_snapshot_pending)
+	{
+		src_snapshot_future.waitForFinished();
+		src_snapshot_pending=false;
+		source_model=src_snapshot_future.result();
+
+		if(!source_model)
+		{
+			/* If the snapshot copy could not be materialized the comparison falls back to consuming
+			 * the loaded model directly (the previous behavior), which is still correct but keeps the
+			 * model locked against edits while the diff runs */
+			GuiUtilsNs::createOutputTreeItem(output_trw,
+																			 tr("Failed to materialize the snapshot of the model <strong>%1</strong>: %2 The comparison will use the loaded model directly.")
+																			 .arg(loaded_model->getName()).arg(src_snapshot_error),
+																			 QPixmap(GuiUtilsNs::getIconPath("alert")), nullptr, false);
+			source_model=loaded_model;
+		}
+	}
+
 	createThread(DiffThread);
 
 	step_lbl->setText(tr("Step %1/%2: Comparing <strong>%3</strong> and <strong>%4</strong>...")
@@ -629,6 +703,15 @@ void ModelDatabaseDiffForm::diffModels()
 
 	diff_item=GuiUtilsNs::createOutputTreeItem(output_trw, step_lbl->text(), QtCompat::pixmap(step_ico_lbl), nullptr);
 
+	//Clearing the code preview since it is filled incrementally as the diff code is streamed
+	sqlcode_txt->clear();
+	pending_diff_code.clear();
+	pending_diff_infos.clear();
+
+	//Reattaching the highlighter in case a previous huge diff detached it (see flushDiffOutput())
+	if(!sqlcode_hl->document())
+		sqlcode_hl->setDocument(sqlcode_txt->document());
+
 	diff_helper->setDiffOption(ModelsDiffHelper::OptKeepClusterObjs, keep_cluster_objs_chk->isChecked());
 	diff_helper->setDiffOption(ModelsDiffHelper::OptCascadeMode, cascade_mode_chk->isChecked());
 	diff_helper->setDiffOption(ModelsDiffHelper::OptForceRecreation, force_recreation_chk->isChecked());
@@ -830,6 +913,9 @@ void ModelDatabaseDiffForm::cancelOperation(bool cancel_by_user)
 		export_thread->quit();
 	}
 
+	diff_output_tmr.stop();
+	flushDiffOutput();
+
 	resetButtons();
 	process_paused=false;
 	close_btn->setEnabled(true);
@@ -872,10 +958,64 @@ void ModelDatabaseDiffForm::handleImportFinished(Exception e)
 	}
 }
 
+void ModelDatabaseDiffForm::appendDiffCode(QString code)
+{
+	/* The streamed chunk is only buffered here, flushDiffOutput() materializes the accumulated
+	 * code in the preview in batches so large scripts don't freeze the GUI with one insertion
+	 * (and rehighlight) per generated command */
+	pending_diff_code+=code;
+
+	if(!diff_output_tmr.isActive())
+		diff_output_tmr.start();
+}
+
+void ModelDatabaseDiffForm::flushDiffOutput()
+{
+	if(!pending_diff_infos.empty())
+	{
+		map<unsigned, QToolButton *> buttons={ {ObjectsDiffInfo::CreateObject, create_tb},
+																					 {ObjectsDiffInfo::DropObject,   drop_tb},
+																					 {ObjectsDiffInfo::AlterObject,  alter_tb},
+																					 {ObjectsDiffInfo::IgnoreObject, ignore_tb} };
+		QTreeWidgetItem *item=nullptr;
+
+		output_trw->setUpdatesEnabled(false);
+
+		for(auto &diff_info : pending_diff_infos)
+		{
+			item=GuiUtilsNs::createOutputTreeItem(output_trw, diff_info.msg, QPixmap(diff_info.icon), diff_item);
+			item->setData(0, Qt::UserRole, diff_info.diff_type);
+			item->setHidden(!buttons[diff_info.diff_type]->isChecked());
+		}
+
+		pending_diff_infos.clear();
+		output_trw->setUpdatesEnabled(true);
+		output_trw->scrollToBottom();
+	}
+
+	if(!pending_diff_code.isEmpty())
+	{
+		QTextCursor cursor(sqlcode_txt->document());
+		cursor.movePosition(QTextCursor::End);
+		cursor.insertText(pending_diff_code);
+		pending_diff_code.clear();
+
+		//Huge previews are kept unhighlighted, see MaxHighlightedDiffSize
+		if(sqlcode_hl->document() && sqlcode_txt->document()->characterCount() > MaxHighlightedDiffSize)
+			sqlcode_hl->setDocument(nullptr);
+	}
+}
+
 void ModelDatabaseDiffForm::handleDiffFinished()
 {
 	curr_step++;
-	sqlcode_txt->setPlainText(diff_helper->getDiffDefinition());
+
+	diff_output_tmr.stop();
+	flushDiffOutput();
+
+	//In streaming mode the code preview is filled incrementally by appendDiffCode()
+	if(!diff_helper->isStreamingModeEnabled())
+		sqlcode_txt->setPlainText(diff_helper->getDiffDefinition());
 
 #ifdef DEMO_VERSION
 #warning "DEMO VERSION: SQL code preview truncated."
@@ -1011,21 +1151,21 @@ void ModelDatabaseDiffForm::updateDiffInfo(ObjectsDiffInfo diff_info)
 
 	unsigned diff_type=diff_info.getDiffType();
 	QToolButton *btn=buttons[diff_type];
-	QTreeWidgetItem *item=nullptr;
 
 	if(!low_verbosity)
 	{
-		item=GuiUtilsNs::createOutputTreeItem(output_trw,
-												 GuiUtilsNs::formatMessage(diff_info.getInfoMessage()),
-												 QPixmap(GuiUtilsNs::getIconPath(diff_info.getObject()->getSchemaName())), diff_item);
-		item->setData(0, Qt::UserRole, diff_info.getDiffType());
+		/* The entry is only buffered and materialized later by flushDiffOutput() in batches,
+		 * inserting one tree item per generated info would freeze the GUI in large diffs */
+		pending_diff_infos.push_back({GuiUtilsNs::formatMessage(diff_info.getInfoMessage()),
+																	GuiUtilsNs::getIconPath(diff_info.getObject()->getSchemaName()),
+																	diff_type});
+
+		if(!diff_output_tmr.isActive())
+			diff_output_tmr.start();
 	}
 
 	if(diff_helper)
 		btn->setText(QString::number(diff_helper->getDiffTypeCount(diff_type)));
-
-	if(item)
-		item->setHidden(!btn->isChecked());
 }
 
 void ModelDatabaseDiffForm::loadConfiguration()
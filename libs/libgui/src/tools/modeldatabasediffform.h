@@ -36,6 +36,8 @@
 #include "widgets/fileselectorwidget.h"
 #include "widgets/objectsfilterwidget.h"
 #include <QThread>
+#include <QTimer>
+#include <QFutureSynchronizer>
 
 class ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelDatabaseDiffForm {
 	private:
@@ -49,6 +51,19 @@ class ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelDatabaseDi
 
 		QEventLoop event_loop;
 
+		/*! \brief Holds the pending background destructions of the compared models (see destroyModel()).
+		Its destructor waits for the pending teardowns when the form itself is destroyed */
+		QFutureSynchronizer<void> model_dtor_sync;
+
+		/*! \brief Holds the source model copy being materialized from the snapshot of the loaded model
+		(see generateDiff()). The related flag indicates a copy not yet consumed by diffModels() */
+		QFuture<DatabaseModel *> src_snapshot_future;
+
+		bool src_snapshot_pending;
+
+		//! \brief Holds the error message of a failed snapshot materialization
+		QString src_snapshot_error;
+
 		bool is_adding_new_preset;
 
 		NumberedTextEditor *sqlcode_txt;
@@ -101,6 +116,23 @@ class ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelDatabaseDi
 
 		bool process_paused;
 
+		/*! \brief Lightweight copy of a diff info entry waiting to be materialized in the output tree.
+		 * Only the formatted message and the icon path are kept so the entry doesn't need to reference
+		 * the (possibly temporary) object after the diff helper discards it */
+		struct PendingDiffInfo {
+			QString msg, icon;
+			unsigned diff_type;
+		};
+
+		//! \brief Diff info entries buffered by updateDiffInfo() and flushed in batches (see flushDiffOutput())
+		vector<PendingDiffInfo> pending_diff_infos;
+
+		//! \brief Diff code chunks buffered by appendDiffCode() and flushed in batches (see flushDiffOutput())
+		QString pending_diff_code;
+
+		//! \brief Periodically materializes the buffered diff output in the tree/preview widgets
+		QTimer diff_output_tmr;
+
 		void closeEvent(QCloseEvent *event);
 		void showEvent(QShowEvent *);
 
@@ -128,6 +160,14 @@ class ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelDatabaseDi
 		DiffThread=2,
 		ExportThread=3;
 
+		//! \brief Interval (ms) between the batched flushes of the diff output (see flushDiffOutput())
+		static constexpr int DiffOutputFlushInterval=300;
+
+		/*! \brief Preview size (in characters) above which the syntax highlighting is detached from the
+		 * code preview. QPlainTextEdit lays out only the visible blocks but the highlighter still processes
+		 * every inserted one, which dominates the cost of displaying huge scripts */
+		static constexpr int MaxHighlightedDiffSize=4 * 1024 * 1024;
+
 		//! \brief Applies the loaded configurations to the form. In this widget only list the loaded presets
 		virtual void applyConfiguration();
 
@@ -170,6 +210,8 @@ class ModelDatabaseDiffForm: public BaseConfigWidget, public Ui::ModelDatabaseDi
 		void updateDiffInfo(ObjectsDiffInfo diff_info);
 		void captureThreadError(Exception e);
 		void handleImportFinished(Exception e);
+		void appendDiffCode(QString code);
+		void flushDiffOutput();
 		void handleDiffFinished();
 		void handleExportFinished();
 		void handleErrorIgnored(QString err_code, QString err_msg, QString cmd);
@@ -27,6 +27,9 @@ ModelExportForm::ModelExportForm(QWidget *parent, Qt::WindowFlags f) : QDialog(p
 {
 	model=nullptr;
 	viewp=nullptr;
+	last_obj_type=ObjectType::BaseObject;
+	slowest_obj_ms=0;
+	processed_objs=0;
 	setupUi(this);
 
 	sql_file_sel = new FileSelectorWidget(this);
@@ -161,10 +164,35 @@ void ModelExportForm::handleErrorIgnored(QString err_code, QString err_msg, QStr
 void ModelExportForm::updateProgress(int progress, QString msg, ObjectType obj_type, QString cmd, bool is_code_gen)
 {
 	QTreeWidgetItem *item=nullptr;
-	QString text=GuiUtilsNs::formatMessage(msg);
+	QString text=GuiUtilsNs::formatMessage(msg), lbl_text;
 	QPixmap ico;
 
-	progress_lbl->setText(text);
+	/* Any new progress message indicates that the previously reported object was processed,
+	 * so its wall time is accumulated in the per type histogram */
+	accumulateObjectTiming();
+
+	if(obj_type!=ObjectType::BaseObject && !is_code_gen)
+	{
+		last_obj_type=obj_type;
+		last_obj_msg=text;
+		obj_elapsed_tmr.restart();
+	}
+
+	lbl_text=text;
+
+	//Appending the live throughput / remaining time estimation to the progress label
+	if(progress > 0 && progress < 100 && total_elapsed_tmr.isValid() && processed_objs > 0)
+	{
+		qint64 elapsed_ms=total_elapsed_tmr.elapsed();
+
+		if(elapsed_ms > 0)
+			lbl_text+=tr(" (elapsed: %1, %2 obj/s, remaining: ~%3)")
+								.arg(formatDuration(elapsed_ms))
+								.arg(processed_objs * 1000.0 / elapsed_ms, 0, 'f', 1)
+								.arg(formatDuration((elapsed_ms * (100 - progress)) / progress));
+	}
+
+	progress_lbl->setText(lbl_text);
 	progress_pb->setValue(progress);
 
 	if(obj_type!=ObjectType::BaseObject)
@@ -191,6 +219,7 @@ void ModelExportForm::exportModel()
 	try
 	{
 		output_trw->clear();
+		resetTimingStats();
 		settings_tbw->setTabEnabled(1, true);
 		settings_tbw->setCurrentIndex(1);
 		enableExportModes(false);
@@ -321,11 +350,89 @@ void ModelExportForm::handleExportFinished()
 	GuiUtilsNs::createOutputTreeItem(output_trw, msg, ico);
 }
 
+QString ModelExportForm::formatDuration(qint64 msecs)
+{
+	if(msecs < 1000)
+		return QString("%1ms").arg(msecs);
+
+	if(msecs < 60000)
+		return QString("%1s").arg(msecs / 1000.0, 0, 'f', 1);
+
+	return QString("%1m%2s").arg(msecs / 60000).arg((msecs % 60000) / 1000);
+}
+
+void ModelExportForm::resetTimingStats()
+{
+	obj_type_timings.clear();
+	last_obj_type=ObjectType::BaseObject;
+	last_obj_msg.clear();
+	slowest_obj_msg.clear();
+	slowest_obj_ms=0;
+	processed_objs=0;
+	total_elapsed_tmr.start();
+	obj_elapsed_tmr.start();
+}
+
+void ModelExportForm::accumulateObjectTiming()
+{
+	qint64 elapsed=0;
+
+	if(last_obj_type==ObjectType::BaseObject)
+		return;
+
+	elapsed=obj_elapsed_tmr.restart();
+	QPair<qint64, unsigned> &timing=obj_type_timings[last_obj_type];
+
+	timing.first+=elapsed;
+	timing.second++;
+	processed_objs++;
+
+	if(elapsed > slowest_obj_ms)
+	{
+		slowest_obj_ms=elapsed;
+		slowest_obj_msg=last_obj_msg;
+	}
+
+	last_obj_type=ObjectType::BaseObject;
+}
+
+void ModelExportForm::dumpTimingHistogram()
+{
+	QTreeWidgetItem *root=nullptr;
+
+	//Closing the timing of the last reported object before dumping the histogram
+	accumulateObjectTiming();
+
+	if(obj_type_timings.empty())
+		return;
+
+	root=GuiUtilsNs::createOutputTreeItem(output_trw, tr("Processing time per object type:"),
+																				QPixmap(GuiUtilsNs::getIconPath("info")), nullptr, false);
+
+	for(auto &itr : obj_type_timings)
+	{
+		GuiUtilsNs::createOutputTreeItem(output_trw,
+																		 tr("%1: %2 object(s), total: %3, average: %4")
+																		 .arg(BaseObject::getTypeName(itr.first))
+																		 .arg(itr.second.second)
+																		 .arg(formatDuration(itr.second.first))
+																		 .arg(formatDuration(itr.second.first / itr.second.second)),
+																		 QPixmap(GuiUtilsNs::getIconPath(itr.first)), root, false);
+	}
+
+	if(slowest_obj_ms > 0)
+		GuiUtilsNs::createOutputTreeItem(output_trw,
+																		 tr("Slowest step: %1 (%2)").arg(slowest_obj_msg).arg(formatDuration(slowest_obj_ms)),
+																		 QPixmap(GuiUtilsNs::getIconPath("alert")), root, false);
+}
+
 void ModelExportForm::finishExport(const QString &msg)
 {
 	if(export_thread->isRunning())
 		export_thread->quit();
 
+	dumpTimingHistogram();
+
 	enableExportModes(true);
 
 	cancel_btn->setEnabled(false);
@@ -31,6 +31,7 @@
 #include "modelexporthelper.h"
 #include "utils/htmlitemdelegate.h"
 #include "widgets/fileselectorwidget.h"
+#include <QElapsedTimer>
 
 class ModelExportForm: public QDialog, public Ui::ModelExportForm {
 	private:
@@ -59,6 +60,40 @@ class ModelExportForm: public QDialog, public Ui::ModelExportForm {
 		*img_file_sel,
 		*dict_file_sel;
 
+		//! \brief Measures the total elapsed time of the current export (used by the ETA estimation)
+		QElapsedTimer total_elapsed_tmr,
+
+		//! \brief Measures the wall time spent processing the object currently reported by the helper
+		obj_elapsed_tmr;
+
+		//! \brief Accumulated wall time (in milliseconds) and object count per object type for the current export
+		map<ObjectType, QPair<qint64, unsigned>> obj_type_timings;
+
+		//! \brief Type of the last object reported through the export progress (BaseObject when none is pending)
+		ObjectType last_obj_type;
+
+		//! \brief Message related to the last reported object and to the slowest step observed so far
+		QString last_obj_msg, slowest_obj_msg;
+
+		//! \brief Wall time of the slowest observed step (in milliseconds)
+		qint64 slowest_obj_ms;
+
+		//! \brief Amount of objects already processed in the current export
+		unsigned processed_objs;
+
+		//! \brief Formats an amount of milliseconds as a short human readable duration
+		static QString formatDuration(qint64 msecs);
+
+		//! \brief Resets the timing statistics before starting a new export
+		void resetTimingStats();
+
+		/*! \brief Closes the timing of the last reported object, accumulating its wall time in the
+		per type histogram. Any new progress message indicates the previous object was processed */
+		void accumulateObjectTiming();
+
+		//! \brief Dumps the per object type timing histogram collected during the export to the output tree
+		void dumpTimingHistogram();
+
 		void finishExport(const QString &msg);
 		void enableExportModes(bool value);
 		void closeEvent(QCloseEvent *event);
@@ -1,11 +1,89 @@
 #include "modelexporthelper.h"
+#include "tracelogger.h"
+#include "taskscheduler.h"
 #include <QSvgGenerator>
+#include <QFutureSynchronizer>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QtConcurrent/QtConcurrent>
+#include <atomic>
+
+bool ModelExportHelper::pipelined_export=false;
+
+bool ModelExportHelper::txn_batch_export=false;
+
+unsigned ModelExportHelper::txn_batch_size=ModelExportHelper::DefaultTxnBatchSize;
+
+bool ModelExportHelper::preserve_partial_export=false;
+
+unsigned ModelExportHelper::export_conns=1;
+
+bool ModelExportHelper::precheck_existing_objs=false;
 
 ModelExportHelper::ModelExportHelper(QObject *parent) : QObject(parent)
 {
 	resetExportParams();
 }
 
+void ModelExportHelper::setPipelinedExport(bool value)
+{
+	pipelined_export=value;
+}
+
+bool ModelExportHelper::isPipelinedExport()
+{
+	return pipelined_export;
+}
+
+ProgressChannel &ModelExportHelper::getProgressChannel()
+{
+	return progress_chn;
+}
+
+void ModelExportHelper::setTransactionBatchExport(bool value, unsigned batch_size)
+{
+	txn_batch_export=value;
+	txn_batch_size=(batch_size == 0 ? 1 : batch_size);
+}
+
+bool ModelExportHelper::isTransactionBatchExport()
+{
+	return txn_batch_export;
+}
+
+void ModelExportHelper::setPreservePartialExport(bool value)
+{
+	preserve_partial_export=value;
+}
+
+bool ModelExportHelper::isPreservePartialExport()
+{
+	return preserve_partial_export;
+}
+
+void ModelExportHelper::setParallelExportConnections(unsigned value)
+{
+	if(value == 0)
+		value=1;
+
+	export_conns=(value > MaxExportConns ? MaxExportConns : value);
+}
+
+unsigned ModelExportHelper::getParallelExportConnections()
+{
+	return export_conns;
+}
+
+void ModelExportHelper::setPrecheckExistingObjects(bool value)
+{
+	precheck_existing_objs=value;
+}
+
+bool ModelExportHelper::isPrecheckExistingObjects()
+{
+	return precheck_existing_objs;
+}
+
 void ModelExportHelper::resetExportParams()
 {
 	sql_gen_progress=progress=0;
@@ -33,34 +111,32 @@ void ModelExportHelper::abortExport(Exception &e)
 
 void ModelExportHelper::handleSQLError(Exception &e, const QString &sql_cmd, bool ignore_dup)
 {
-	//Ignoring the error if it is in the ignored list
-	if(ignored_errors.indexOf(e.getExtraInfo()) >= 0 ||
+	//Ignoring the error if it is in the ignored set
+	if(ignored_errors.contains(e.getExtraInfo()) ||
 			(ignore_dup && isDuplicationError(e.getExtraInfo())))
 		emit s_errorIgnored(e.getExtraInfo(), e.getErrorMessage(), sql_cmd);
-	//Raises an excpetion if the error returned by the database is not listed in the ignored list of errors
-	else if(ignored_errors.indexOf(e.getExtraInfo()) < 0)
-		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
+	//Raises an excpetion if the error returned by the database is not listed in the ignored set of errors
 	else
-		errors.push_back(e);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e, sql_cmd);
 }
 
 void ModelExportHelper::setIgnoredErrors(const QStringList &err_codes)
 {
 	QRegExp valid_code = QRegExp("([a-z]|[A-Z]|[0-9])+");
-	QStringList error_codes=err_codes;
 
 	ignored_errors.clear();
-	error_codes.removeDuplicates();
 
-	for(QString code : error_codes)
+	for(QString code : err_codes)
 	{
 		if(valid_code.exactMatch(code))
-			ignored_errors.push_back(code);
+			ignored_errors.insert(code);
 	}
 }
 
 void ModelExportHelper::exportToSQL(DatabaseModel *db_model, const QString &filename, const QString &pgsql_ver, bool split)
 {
+	TraceLogger::Span trace_span("ModelExportHelper::exportToSQL");
+
 	if(!db_model)
 		throw Exception(ErrorCode::AsgNotAllocattedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
@@ -69,6 +145,7 @@ void ModelExportHelper::exportToSQL(DatabaseModel *db_model, const QString &file
 	try
 	{
 		progress=sql_gen_progress=0;
+		progress_chn.reset();
 		BaseObject::setPgSQLVersion(pgsql_ver);
 		emit s_progressUpdated(progress,
 													 tr("Generating SQL code for PostgreSQL `%1'").arg(BaseObject::getPgSQLVersion()),
@@ -107,7 +184,6 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 
 	try
 	{
-		QPixmap pix;
 		bool shw_grd, shw_dlm, align_objs;
 		QGraphicsView *view=nullptr;
 		QRect retv;
@@ -189,9 +265,16 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 		QPainter painter;
 		vector<QRectF>::iterator itr=pages.begin(), itr_end=pages.end();
 
+		/* The pages are rendered sequentially since the graphics scene can't be painted by
+		 * multiple threads, but the png encoding/writing of each page, the heavier step for
+		 * big images, runs in worker threads overlapped with the rendering of the next pages */
+		QFutureSynchronizer<void> save_sync;
+		QStringList failed_files;
+		QMutex failed_mtx;
+
 		while(itr!=itr_end && !export_canceled)
 		{
-			//Convert the objects bounding rect to viewport coordinates to correctly draw them onto pixmap
+			//Convert the objects bounding rect to viewport coordinates to correctly draw them onto image
 			pol=view->mapFromScene(*itr);
 			itr++;
 
@@ -201,12 +284,13 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 			retv.setBottomRight(pol.at(2));
 			retv.setBottomLeft(pol.at(3));
 
-			//Creates the output pixmap
-			pix=QPixmap(retv.size());
-			pix.fill();
+			/* Creates the output image. A QImage is used instead of a QPixmap because it can be
+			 * safely encoded/saved outside the gui thread */
+			QImage img(retv.size(), QImage::Format_RGB32);
+			img.fill(Qt::white);
 
 			//Setting optimizations on the painter
-			painter.begin(&pix);
+			painter.begin(&img);
 			painter.setRenderHint(QPainter::Antialiasing, true);
 			painter.setRenderHint(QPainter::TextAntialiasing, true);
 			painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
@@ -214,29 +298,36 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 			emit s_progressUpdated((page_idx/static_cast<double>(pages.size())) * 90,
 														 tr("Rendering objects to page %1/%2.").arg(page_idx).arg(pages.size()), ObjectType::BaseObject);
 
-			//Render the entire viewport onto the pixmap
-			view->render(&painter, QRectF(QPointF(0,0), pix.size()), retv);
+			//Render the entire viewport onto the image
+			view->render(&painter, QRectF(QPointF(0,0), img.size()), retv);
 			painter.end();
 
 			if(page_by_page)
 				file=tmpl_filename.arg(page_idx++);
 
-			//If the pixmap is not saved raises an error
-			if(!pix.save(file))
-			{
-				//Restoring the scene settings before throw error
-				ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
-				scene->update();
+			QString out_file=file;
 
-				throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(file),
-												ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-			}
+			save_sync.addFuture(QtConcurrent::run(&TaskScheduler::getThreadPool(), [img, out_file, &failed_files, &failed_mtx](){
+				if(!img.save(out_file))
+				{
+					QMutexLocker locker(&failed_mtx);
+					failed_files.append(out_file);
+				}
+			}));
 		}
 
+		//Waits for the pages still being written by the worker threads
+		save_sync.waitForFinished();
+
 		//Restoring the scene settings
 		ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
 		scene->update();
 
+		//If some image was not saved raises an error
+		if(!failed_files.isEmpty())
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(failed_files.first()),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
 		if(!export_canceled)
 		{
 			emit s_progressUpdated(100, tr("Output image `%1' successfully written.").arg(filename), ObjectType::BaseObject);
@@ -280,10 +371,27 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 	svg_gen.setTitle(tr("SVG representation of database model"));
 	svg_gen.setDescription(tr("SVG file generated by pgModeler"));
 
+	/* Temporarily disabling the cached rendering of the items so they are written
+	 * to the file as vector elements instead of embedded bitmaps */
+	QList<QGraphicsItem *> cached_items;
+
+	for(auto &item : scene->items())
+	{
+		if(item->cacheMode() != QGraphicsItem::NoCache)
+		{
+			cached_items.append(item);
+			item->setCacheMode(QGraphicsItem::NoCache);
+		}
+	}
+
 	QPainter *painter=new QPainter(&svg_gen);
 	scene->render(painter, QRectF(0, 0, scene_rect.size().width(), scene_rect.size().height()), scene_rect);
 	delete painter;
 
+	//Restoring the cached rendering of the items
+	for(auto &item : cached_items)
+		item->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
 	//Restoring the scene settings
 	ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
 	scene->update();
@@ -326,8 +434,9 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 
 void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool drop_objs, bool simulate, bool use_tmp_names)
 {
+	TraceLogger::Span trace_span("ModelExportHelper::exportToDBMS");
 	int type_id = 0, pos = -1;
-	QString  version, sql_cmd, buf, sql_cmd_comment;
+	QString  version, sql_cmd, sql_cmd_comment;
 	Connection new_db_conn;
 	unsigned i, count;
 	ObjectType types[]={ObjectType::Role, ObjectType::Tablespace};
@@ -353,6 +462,7 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 		export_canceled=false;
 		db_created=false;
 		progress=sql_gen_progress=0;
+		progress_chn.reset();
 		created_objs[ObjectType::Role]=created_objs[ObjectType::Tablespace]=-1;
 		errors.clear();
 
@@ -404,7 +514,7 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 		}
 
 		if(!ignored_errors.isEmpty())
-			emit s_progressUpdated(progress, tr("Ignoring the following error code(s): `%1'.").arg(ignored_errors.join(", ")));
+			emit s_progressUpdated(progress, tr("Ignoring the following error code(s): `%1'.").arg(QStringList(ignored_errors.values()).join(", ")));
 
 		if(drop_db)
 		{
@@ -527,10 +637,85 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 			//Creating the other object types
 			emit s_progressUpdated(progress, tr("Generating SQL for `%1' objects...").arg(db_model->getObjectCount()));
 
-			//Exporting the database model definition using the opened connection
-			buf=db_model->getCodeDefinition(SchemaParser::SqlDefinition, false);
 			progress=40;
-			exportBufferToDBMS(buf, new_db_conn, drop_objs);
+
+			/* The model SQL is generated in chunks by a producer thread and consumed by the command
+			 * executor as the chunks arrive, so the export holds only a few object definitions in
+			 * memory instead of the whole script and the code generation overlaps the execution */
+			QMutex chunk_mtx;
+			QWaitCondition chunk_avail, chunk_consumed;
+			QStringList chunk_queue;
+			bool gen_finished=false, consumer_done=false, gen_failed=false;
+			Exception gen_error;
+			static constexpr int MaxQueuedChunks=32;
+
+			QFuture<void> gen_future=QtConcurrent::run(&TaskScheduler::getThreadPool(), [&](){
+				try
+				{
+					db_model->getSQLDefinitionStreamed([&](const QString &chunk){
+						QMutexLocker locker(&chunk_mtx);
+
+						while(chunk_queue.size() >= MaxQueuedChunks && !consumer_done)
+							chunk_consumed.wait(&chunk_mtx);
+
+						if(consumer_done)
+							return;
+
+						chunk_queue.append(chunk);
+						chunk_avail.wakeOne();
+					});
+				}
+				catch(Exception &e)
+				{
+					QMutexLocker locker(&chunk_mtx);
+					gen_error=Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+					gen_failed=true;
+				}
+
+				QMutexLocker locker(&chunk_mtx);
+				gen_finished=true;
+				chunk_avail.wakeOne();
+			});
+
+			try
+			{
+				exportBufferToDBMS([&]() -> QString {
+					QMutexLocker locker(&chunk_mtx);
+
+					while(chunk_queue.isEmpty() && !gen_finished)
+						chunk_avail.wait(&chunk_mtx);
+
+					if(chunk_queue.isEmpty())
+						return QString();
+
+					QString chunk=chunk_queue.takeFirst();
+					chunk_consumed.wakeOne();
+					return chunk;
+				}, new_db_conn, drop_objs, 0);
+			}
+			catch(Exception &e)
+			{
+				//Unblocking the producer and waiting for it before propagating the error
+				{
+					QMutexLocker locker(&chunk_mtx);
+					consumer_done=true;
+					chunk_consumed.wakeAll();
+				}
+
+				gen_future.waitForFinished();
+				throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			}
+
+			{
+				QMutexLocker locker(&chunk_mtx);
+				consumer_done=true;
+				chunk_consumed.wakeAll();
+			}
+
+			gen_future.waitForFinished();
+
+			if(gen_failed)
+				throw Exception(gen_error.getErrorMessage(), gen_error.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &gen_error);
 		}
 
 		disconnect(db_model, nullptr, this, nullptr);
@@ -542,8 +727,9 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 		new_db_conn.close();
 
 		/* If the process was a simulation or even canceled undo the export
-		removing the created objects */
-		if(simulate || export_canceled)
+		removing the created objects. Cancellations preserve the created objects
+		when the partial export preservation is enabled */
+		if(simulate || (export_canceled && !preserve_partial_export))
 			undoDBMSExport(db_model, conn, use_tmp_names);
 
 		conn.close();
@@ -565,8 +751,11 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 			//Closes the new opened connection
 			new_db_conn.close();
 
-			//Undo the export removing the created objects
-			undoDBMSExport(db_model, conn, use_tmp_names);
+			/* Undo the export removing the created objects. When the partial export preservation
+			 * is enabled (and the process isn't a simulation) the completed work is kept so the
+			 * operator can fix the cause of the failure and resume the export */
+			if(simulate || !preserve_partial_export)
+				undoDBMSExport(db_model, conn, use_tmp_names);
 		}
 		catch(Exception &){}
 
@@ -721,9 +910,7 @@ void ModelExportHelper::undoDBMSExport(DatabaseModel *db_model, Connection &conn
 void ModelExportHelper::generateTempObjectNames(DatabaseModel *db_model)
 {
 	QString tmp_name, old_name;
-	QTextStream stream(&tmp_name);
-	QDateTime dt=QDateTime::currentDateTime();
-	QCryptographicHash hash(QCryptographicHash::Md5);
+	unsigned name_cnt=0;
 	map<ObjectType, QString> obj_suffixes={ { ObjectType::Database, QString("db_") },
 											{ ObjectType::Role, QString("rl_")},
 											{ ObjectType::Tablespace, QString("tb_")} };
@@ -744,16 +931,17 @@ void ModelExportHelper::generateTempObjectNames(DatabaseModel *db_model)
 	}
 
 
+	/* The temporary names are derived from a reserved prefix, the run timestamp and a per-run
+	 * monotonic counter. The prefix/timestamp pair avoids clashes with the objects existing on
+	 * the server while the counter makes each name unique within the run, so the generation is
+	 * O(1) per object without any hashing or name scanning */
+	QString name_prefix=QString("pgm_tmp_%1_").arg(QDateTime::currentDateTime().toTime_t(), 0, 16);
+
 	for(auto &obj : orig_obj_names)
 	{
-		stream << reinterpret_cast<unsigned *>(obj.first) << QString("_") << dt.toTime_t();
-
-		//Generates an unique name for the object through md5 hash
-		hash.addData(QByteArray(tmp_name.toStdString().c_str()));
-		tmp_name=obj_suffixes[obj.first->getObjectType()] + hash.result().toHex();
-
 		old_name=obj.first->getName();
-		obj.first->setName(tmp_name.mid(0,15));
+		tmp_name=obj_suffixes[obj.first->getObjectType()] + name_prefix + QString::number(name_cnt++, 16);
+		obj.first->setName(tmp_name);
 		tmp_name.clear();
 
 		emit s_progressUpdated(progress, tr("Renaming `%1' (%2) to `%3'")
@@ -791,24 +979,227 @@ bool ModelExportHelper::isDuplicationError(const QString &error_code)
 
 	 Reference:
 	  http://www.postgresql.org/docs/current/static/errcodes-appendix.html*/
-	static QStringList err_codes = {QString("42P04"), QString("42723"), QString("42P06"),
-									QString("42P07"), QString("42710"), QString("42701"),
-									QString("42P16")};
+	static QSet<QString> err_codes = {QString("42P04"), QString("42723"), QString("42P06"),
+									  QString("42P07"), QString("42710"), QString("42701"),
+									  QString("42P16")};
 
 	return err_codes.contains(error_code);
 }
 
+void ModelExportHelper::flushPipelinedCommands(Connection &conn, QStringList &cmds)
+{
+	int exec_cnt=0;
+
+	try
+	{
+		conn.executePipelinedCommands(cmds, exec_cnt);
+		cmds.clear();
+	}
+	catch(Exception &)
+	{
+		/* When a command of the batch fails the server rolls back the whole batch (it runs in a
+		 * single implicit transaction), so the commands without persisted effects are re-executed
+		 * one by one. This way each failure goes through the regular per-command error handling
+		 * (ignored/duplication errors) keeping the pipelined export semantically equivalent to
+		 * the traditional one */
+		for(int idx=exec_cnt; idx < cmds.size() && !export_canceled; idx++)
+		{
+			try
+			{
+				conn.executeDDLCommand(cmds[idx]);
+			}
+			catch(Exception &e)
+			{
+				handleSQLError(e, cmds[idx], ignore_dup);
+			}
+		}
+
+		cmds.clear();
+	}
+}
+
+void ModelExportHelper::runCommandsInTransaction(Connection &conn, QStringList &cmds)
+{
+	QString svpt=QString("pgmodeler_export_svpt");
+
+	try
+	{
+		conn.executeDDLCommand(QString("BEGIN"));
+
+		for(auto &cmd : cmds)
+		{
+			if(export_canceled) break;
+
+			try
+			{
+				conn.executeDDLCommand(QString("SAVEPOINT %1").arg(svpt));
+				conn.executeDDLCommand(cmd);
+				conn.executeDDLCommand(QString("RELEASE SAVEPOINT %1").arg(svpt));
+			}
+			catch(Exception &e)
+			{
+				/* The failed command is undone by returning to the savepoint so the transaction stays
+				 * usable, then the error goes through the regular per-command handling. A non-ignorable
+				 * error raised by handleSQLError() discards the whole group below */
+				conn.executeDDLCommand(QString("ROLLBACK TO SAVEPOINT %1").arg(svpt));
+				handleSQLError(e, cmd, ignore_dup);
+			}
+		}
+
+		conn.executeDDLCommand(QString("COMMIT"));
+		cmds.clear();
+	}
+	catch(Exception &e)
+	{
+		//Discarding the current transaction before propagating the error
+		try { conn.executeDDLCommand(QString("ROLLBACK")); }
+		catch(Exception &){}
+
+		cmds.clear();
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void ModelExportHelper::runCommandsInParallel(Connection &conn, QStringList &cmds, const QStringList &session_cmds)
+{
+	unsigned thread_cnt=std::min(static_cast<unsigned>(cmds.size()), export_conns);
+	std::atomic<int> cmd_idx(0);
+	QMutex err_mtx;
+	vector<QPair<Exception, QString>> cmd_errors;
+	QFutureSynchronizer<void> synchronizer;
+
+	emit s_progressUpdated(progress, tr("Creating %1 independent object(s) using %2 connection(s)...")
+												 .arg(cmds.size()).arg(thread_cnt), ObjectType::Index);
+
+	for(unsigned i=0; i < thread_cnt; i++)
+	{
+		synchronizer.addFuture(QtConcurrent::run(&TaskScheduler::getThreadPool(), [&](){
+			Connection worker_conn=conn;
+			int idx=0;
+
+			try
+			{
+				worker_conn.connect();
+
+				//Replaying the session level commands so the workers see the same settings (e.g. search_path)
+				for(auto &session_cmd : session_cmds)
+					worker_conn.executeDDLCommand(session_cmd);
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&err_mtx);
+				cmd_errors.push_back({ e, QString() });
+				return;
+			}
+
+			while(!export_canceled && (idx=cmd_idx++) < cmds.size())
+			{
+				try
+				{
+					worker_conn.executeDDLCommand(cmds[idx]);
+				}
+				catch(Exception &e)
+				{
+					QMutexLocker locker(&err_mtx);
+					cmd_errors.push_back({ e, cmds[idx] });
+				}
+			}
+
+			worker_conn.close();
+		}));
+	}
+
+	synchronizer.waitForFinished();
+	cmds.clear();
+
+	//The collected errors go through the regular per-command handling on the calling thread
+	for(auto &cmd_error : cmd_errors)
+		handleSQLError(cmd_error.first, cmd_error.second, ignore_dup);
+}
+
+void ModelExportHelper::retrieveExistingObjects(Connection &conn)
+{
+	try
+	{
+		ResultSet res;
+
+		/* Single catalog query returning one "[SQL keyword] [name]" row per object. The keywords and
+		 * name formats (schema qualified, except for indexes and cluster level objects) match the ones
+		 * extracted from the CREATE commands by exportBufferToDBMS(). Table children (columns and
+		 * constraints added via ALTER TABLE) and composite types are not listed, their creation still
+		 * relies on the duplication error handling */
+		QString query=QString(
+					"SELECT 'SCHEMA ' || nspname FROM pg_catalog.pg_namespace "
+					"UNION ALL "
+					"SELECT CASE c.relkind "
+					"WHEN 'v' THEN 'VIEW ' WHEN 'm' THEN 'VIEW ' "
+					"WHEN 'S' THEN 'SEQUENCE ' "
+					"WHEN 'f' THEN 'FOREIGN TABLE ' "
+					"WHEN 'i' THEN 'INDEX ' WHEN 'I' THEN 'INDEX ' "
+					"ELSE 'TABLE ' END || "
+					"CASE WHEN c.relkind IN ('i','I') THEN c.relname "
+					"ELSE n.nspname || '.' || c.relname END "
+					"FROM pg_catalog.pg_class c "
+					"JOIN pg_catalog.pg_namespace n ON n.oid = c.relnamespace "
+					"WHERE c.relkind IN ('r','p','f','v','m','S','i','I') "
+					"UNION ALL "
+					"SELECT CASE WHEN t.typtype = 'd' THEN 'DOMAIN ' ELSE 'TYPE ' END || "
+					"n.nspname || '.' || t.typname "
+					"FROM pg_catalog.pg_type t "
+					"JOIN pg_catalog.pg_namespace n ON n.oid = t.typnamespace "
+					"WHERE t.typtype IN ('d','b','e','r','m') AND t.typrelid = 0 AND t.typname NOT LIKE '\\_%' "
+					"UNION ALL "
+					"SELECT 'EXTENSION ' || extname FROM pg_catalog.pg_extension "
+					"UNION ALL "
+					"SELECT 'ROLE ' || rolname FROM pg_catalog.pg_roles");
+
+		existing_objs.clear();
+		conn.executeDMLCommand(query, res);
+
+		if(res.accessTuple(ResultSet::FirstTuple))
+		{
+			do
+			{
+				existing_objs.insert(QString(res.getColumnValue(0)));
+			}
+			while(res.accessTuple(ResultSet::NextTuple));
+		}
+
+		emit s_progressUpdated(progress, tr("Existence pre-checking: %1 object(s) found in the destination database.").arg(existing_objs.size()));
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &conn, bool drop_objs)
+{
+	bool consumed=false;
+
+	//The single buffer version is just a chunk-fed execution whose source yields the whole script at once
+	exportBufferToDBMS([&]() -> QString {
+		if(consumed)
+			return QString();
+
+		consumed=true;
+		return buffer;
+	}, conn, drop_objs, buffer.size());
+}
+
+void ModelExportHelper::exportBufferToDBMS(const std::function<QString()> &chunk_fn, Connection &conn, bool drop_objs, unsigned total_size)
 {
 	Connection aux_conn;
-	QString sql_buf=buffer, sql_cmd, aux_cmd, lin, msg,
+	QString sql_buf=chunk_fn(), next_buf=chunk_fn(), sql_cmd, aux_cmd, lin, msg,
 			obj_name, obj_tp_name, tab_name, orig_conn_db_name,
 			alter_tab=QString("ALTER TABLE");
 	vector<QString> db_sql_cmds;
+	QStringList pipeline_cmds, txn_cmds, parallel_cmds, session_cmds;
 	QTextStream ts;
 	ObjectType obj_type=ObjectType::BaseObject;
-	bool ddl_tk_found=false, is_create=false, is_drop=false;
-	unsigned aux_prog=0, curr_size=0, buf_size=sql_buf.size(),
+	bool ddl_tk_found=false, is_create=false, is_drop=false, skip_cmd=false;
+	unsigned aux_prog=0, curr_size=0,
+			buf_size=(total_size > 0 ? total_size : sql_buf.size() + next_buf.size()),
 			factor=(db_name.isEmpty() ? 70 : 90);
 	int pos=0, pos1=0, comm_cnt=0;
 
@@ -843,8 +1234,25 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 		conn.connect();
 	}
 
-	while(!ts.atEnd() && !export_canceled)
+	/* With the existence pre-checking enabled the identification of the objects present in the
+	 * destination database is retrieved upfront, so the creation of pre-existing objects is skipped
+	 * without paying a server round-trip plus an ignored duplication error for each of them */
+	if(precheck_existing_objs && ignore_dup && !export_canceled)
+		retrieveExistingObjects(conn);
+
+	while((!ts.atEnd() || !next_buf.isEmpty()) && !export_canceled)
 	{
+		//Refilling the parsing buffer with the next chunk of the source
+		if(ts.atEnd())
+		{
+			sql_buf=next_buf;
+			next_buf=chunk_fn();
+			ts.setString(&sql_buf);
+
+			if(total_size==0)
+				buf_size+=next_buf.size();
+		}
+
 		try
 		{
 			//Cleanup single line comments
@@ -879,7 +1287,7 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 			}
 
 			//If the ddl end token is found
-			if(ddl_tk_found || (!sql_cmd.isEmpty() && ts.atEnd()))
+			if(ddl_tk_found || (!sql_cmd.isEmpty() && ts.atEnd() && next_buf.isEmpty()))
 			{
 				//Checking if the command is a column or constraint creation via ALTER TABLE
 				aux_cmd=sql_cmd;
@@ -914,12 +1322,18 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 					//Creating a fully qualified name for the object (schema.table.name)
 					obj_name=tab_name + QString(".") + obj_name;
 
-					if(is_drop)
-						msg=tr("Dropping object `%1' (%2)").arg(obj_name).arg(BaseObject::getTypeName(obj_type));
-					else
-						msg=tr("Creating object `%1' (%2)").arg(obj_name).arg(BaseObject::getTypeName(obj_type));
+					/* The progress channel coalesces the per-command notifications so at most one
+					event (and one message formatting) per percentage point reaches the UI */
+					if(progress_chn.reportProgress(aux_prog, enum_cast(obj_type)))
+					{
+						if(is_drop)
+							msg=tr("Dropping object `%1' (%2)").arg(obj_name).arg(BaseObject::getTypeName(obj_type));
+						else
+							msg=tr("Creating object `%1' (%2)").arg(obj_name).arg(BaseObject::getTypeName(obj_type));
+
+						emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
+					}
 
-					emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
 					is_drop=false;
 				}
 				//Check if the regex matches the sql command
@@ -1031,25 +1445,82 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 								msg=tr("Running auxiliary `%1' command...").arg(aux_cmd_type);
 							}
 
+							/* With the existence pre-checking enabled, creation commands whose object is
+							 * already present in the destination database are skipped (see below) */
+							if(precheck_existing_objs && ignore_dup && is_create && obj_tp != ObjectType::BaseObject)
+								skip_cmd=existing_objs.contains(BaseObject::getSQLName(obj_tp) + QString(" ") + obj_name);
+
 							break;
 						}
 					}
 
-					emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
+					if(progress_chn.reportProgress(aux_prog, enum_cast(obj_type)))
+						emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
+
 					is_create=is_drop=false;
 					msg.clear();
 				}
 				else if(!sql_cmd.trimmed().isEmpty())
 				{
 					//General commands like grant, revoke or set aren't explicitly shown
-					emit s_progressUpdated(aux_prog, tr("Running auxiliary command."), ObjectType::BaseObject, sql_cmd);
+					if(progress_chn.reportProgress(aux_prog, enum_cast(ObjectType::BaseObject)))
+						emit s_progressUpdated(aux_prog, tr("Running auxiliary command."), ObjectType::BaseObject, sql_cmd);
 				}
 
 				//Executes the extracted SQL command
 				if(!sql_cmd.isEmpty() && !export_canceled)
 				{
-					if(obj_type != ObjectType::Database)
-						conn.executeDDLCommand(sql_cmd);
+					if(skip_cmd)
+					{
+						//The object already exists in the destination database so its creation is skipped
+						emit s_errorIgnored(QString("42710"),
+																tr("Object `%1' (%2) already exists in the destination database, command skipped.")
+																.arg(obj_name).arg(BaseObject::getTypeName(obj_type)), sql_cmd);
+					}
+					else if(obj_type != ObjectType::Database)
+					{
+						//Session level settings must also be applied to the parallel worker connections
+						if(export_conns > 1 && sql_cmd.trimmed().startsWith(QString("SET ")))
+							session_cmds.append(sql_cmd);
+
+						/* Index builds only take locks that don't conflict with each other so they are mutually
+						 * independent. When the parallel export is enabled they are deferred and dispatched
+						 * concurrently to the pooled connections once the rest of the buffer was processed */
+						if(export_conns > 1 && obj_type==ObjectType::Index && sql_cmd.trimmed().startsWith(QString("CREATE")))
+							parallel_cmds.append(sql_cmd);
+						else if(pipelined_export)
+						{
+							/* In pipelined mode the command is only queued. The accumulated batch is sent
+							 * to the server in a single round-trip when it reaches the configured size */
+							pipeline_cmds.append(sql_cmd);
+
+							if(pipeline_cmds.size() >= PipelineBatchSize)
+								flushPipelinedCommands(conn, pipeline_cmds);
+						}
+						else if(txn_batch_export)
+						{
+							/* Statements that can't run inside a transaction block (e.g. CREATE INDEX CONCURRENTLY)
+							 * force the execution of the pending group and are run in autocommit as usual */
+							if(sql_cmd.contains(QString("CONCURRENTLY")))
+							{
+								if(!txn_cmds.isEmpty())
+									runCommandsInTransaction(conn, txn_cmds);
+
+								conn.executeDDLCommand(sql_cmd);
+							}
+							else
+							{
+								/* In transaction batched mode the command is only queued. The accumulated group is
+								 * executed in a single explicit transaction when it reaches the configured size */
+								txn_cmds.append(sql_cmd);
+
+								if(static_cast<unsigned>(txn_cmds.size()) >= txn_batch_size)
+									runCommandsInTransaction(conn, txn_cmds);
+							}
+						}
+						else
+							conn.executeDDLCommand(sql_cmd);
+					}
 					else
 						//If it's a database level command (e.g. ALTER DATABASE ... RENAME TO ...)
 						db_sql_cmds.push_back(sql_cmd);
@@ -1057,10 +1528,23 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 
 				sql_cmd.clear();
 				ddl_tk_found=false;
+				skip_cmd=false;
 			}
 
+			//Executing the remaining commands of the pipelined batch before the buffer ends
+			if(ts.atEnd() && next_buf.isEmpty() && !pipeline_cmds.isEmpty() && !export_canceled)
+				flushPipelinedCommands(conn, pipeline_cmds);
+
+			//Executing the remaining commands of the transaction batched group before the buffer ends
+			if(ts.atEnd() && next_buf.isEmpty() && !txn_cmds.isEmpty() && !export_canceled)
+				runCommandsInTransaction(conn, txn_cmds);
+
+			//Creating the deferred independent objects through the parallel connections
+			if(ts.atEnd() && next_buf.isEmpty() && !parallel_cmds.isEmpty() && !export_canceled)
+				runCommandsInParallel(conn, parallel_cmds, session_cmds);
+
 			//Executing the pending database level commands
-			if(ts.atEnd() && !db_sql_cmds.empty() && !export_canceled)
+			if(ts.atEnd() && next_buf.isEmpty() && !db_sql_cmds.empty() && !export_canceled)
 			{
 				conn.close();
 				aux_conn=conn;
@@ -1078,6 +1562,7 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 			if(ddl_tk_found) ddl_tk_found=false;
 			handleSQLError(e, sql_cmd, ignore_dup);
 			sql_cmd.clear();
+			skip_cmd=false;
 		}
 	}
 }
@@ -1091,7 +1576,10 @@ void ModelExportHelper::updateProgress(int prog, QString object_id, unsigned obj
 	if(aux_prog > 100)
 		aux_prog=100;
 
-	emit s_progressUpdated(aux_prog, object_id, static_cast<ObjectType>(obj_type), "", sender() == db_model);
+	/* This slot is hit once per object during the SQL generation (via Qt::DirectConnection),
+	so the forwarded emission is coalesced through the progress channel */
+	if(progress_chn.reportProgress(aux_prog, obj_type))
+		emit s_progressUpdated(aux_prog, object_id, static_cast<ObjectType>(obj_type), "", sender() == db_model);
 }
 
 void ModelExportHelper::setExportToDBMSParams(DatabaseModel *db_model, Connection *conn, const QString &pgsql_ver, bool ignore_dup, bool drop_db, bool drop_objs, bool simulate, bool use_rand_names)
@@ -1166,6 +1654,7 @@ void ModelExportHelper::exportToDBMS()
 		{
 			try
 			{
+				progress_chn.reset();
 				exportBufferToDBMS(sql_buffer, *connection);
 
 				if(export_canceled)
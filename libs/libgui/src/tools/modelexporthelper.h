@@ -27,11 +27,48 @@
 
 #include "widgets/modelwidget.h"
 #include "connection.h"
+#include "progresschannel.h"
+#include <functional>
+#include <QSet>
 
 class ModelExportHelper: public QObject {
 	private:
 		Q_OBJECT
 
+		//! \brief Indicates if the DDL commands are sent to the server in pipelined batches (see setPipelinedExport())
+		static bool pipelined_export;
+
+		//! \brief Maximum amount of commands queued on the server before the batch results are reaped
+		static constexpr int PipelineBatchSize=100;
+
+		//! \brief Indicates if the DDL commands are executed in explicit transactions (see setTransactionBatchExport())
+		static bool txn_batch_export;
+
+		//! \brief Amount of commands grouped per transaction when the transaction batched mode is enabled
+		static unsigned txn_batch_size;
+
+		//! \brief Default amount of commands grouped per transaction in transaction batched exports
+		static constexpr unsigned DefaultTxnBatchSize=100;
+
+		/*! \brief Indicates if the objects created before a mid-export failure/cancellation must be
+		preserved instead of undone (see setPreservePartialExport()) */
+		static bool preserve_partial_export;
+
+		//! \brief Amount of connections used to create independent objects in parallel (see setParallelExportConnections())
+		static unsigned export_conns;
+
+		//! \brief Maximum amount of connections accepted by setParallelExportConnections()
+		static constexpr unsigned MaxExportConns=16;
+
+		/*! \brief Indicates if the existence of the objects must be checked upfront through a single
+		catalog query instead of relying on duplication errors (see setPrecheckExistingObjects()) */
+		static bool precheck_existing_objs;
+
+		/*! \brief Lock-free coalescing channel that tracks the progress of the current export.
+		The hot per-command signal emissions are gated on this channel so at most one event
+		per percentage point is delivered (see reportProgress()) */
+		ProgressChannel progress_chn;
+
 		//! \brief  Stores the total progress
 		int progress,
 
@@ -88,8 +125,12 @@ class ModelExportHelper: public QObject {
 
 		QString sql_buffer, db_name;
 
-		//! \brief List of ignored error codes
-		QStringList ignored_errors;
+		//! \brief Set of ignored error codes
+		QSet<QString> ignored_errors;
+
+		/*! \brief Keys in the form "[SQL keyword] [name]" of the objects existing in the destination
+		database, retrieved by retrieveExistingObjects() when the existence pre-checking is enabled */
+		QSet<QString> existing_objs;
 
 		vector<Exception> errors;
 
@@ -147,6 +188,34 @@ class ModelExportHelper: public QObject {
 		3) abort the export by immediatelly redirecting the error to the user */
 		void handleSQLError(Exception &e, const QString &sql_cmd, bool ignore_dup);
 
+		/*! \brief Executes the accumulated batch of commands through Connection::executePipelinedCommands().
+		When a command of the batch fails, the commands whose effects were rolled back are re-executed
+		one by one so the regular per-command error handling (ignored/duplication errors) is applied
+		to each failure */
+		void flushPipelinedCommands(Connection &conn, QStringList &cmds);
+
+		/*! \brief Executes the accumulated group of commands inside a single explicit transaction.
+		Each command runs under a savepoint: when it fails the transaction is rolled back to that
+		savepoint and the error goes through the regular per-command handling (handleSQLError()),
+		preserving the effects of the other commands of the group */
+		void runCommandsInTransaction(Connection &conn, QStringList &cmds);
+
+		/*! \brief Executes the deferred commands concurrently using the configured amount of connections.
+		Each worker opens its own copy of conn and replays the session commands (e.g. SET search_path)
+		executed so far before consuming the shared work queue. Errors are collected and forwarded to the
+		regular per-command handling (handleSQLError()) on the calling thread */
+		void runCommandsInParallel(Connection &conn, QStringList &cmds, const QStringList &session_cmds);
+
+		/*! \brief Retrieves, in a single catalog query, the identification of the objects existing in the
+		database pointed by conn, filling the set used by exportBufferToDBMS() to skip the creation of
+		pre-existing objects when the existence pre-checking is enabled */
+		void retrieveExistingObjects(Connection &conn);
+
+		/*! \brief Chunk-fed version of exportBufferToDBMS(). The SQL source is pulled through successive
+		calls to chunk_fn — an empty string indicates the end of the source — so the whole script never
+		needs to be materialized in memory. total_size, when known, is used to compute the progress */
+		void exportBufferToDBMS(const std::function<QString()> &chunk_fn, Connection &conn, bool drop_objs, unsigned total_size);
+
 	public:
 		ModelExportHelper(QObject *parent = nullptr);
 
@@ -156,6 +225,59 @@ class ModelExportHelper: public QObject {
 		Error catalog is available at: postgresql.org/docs/current/static/errcodes-appendix.html */
 		void setIgnoredErrors(const QStringList &err_codes);
 
+		/*! \brief Enables the pipelined execution mode for DBMS exports. When enabled the DDL commands
+		are queued on the server in batches instead of paying a synchronous round-trip each, which
+		speeds up exports over high latency links */
+		static void setPipelinedExport(bool value);
+
+		//! \brief Returns true when the pipelined execution mode is enabled
+		static bool isPipelinedExport();
+
+		/*! \brief Returns the progress channel of the helper. UI code may sample it from a
+		timer (see ProgressChannel::hasNews()) instead of relying on the queued signals */
+		ProgressChannel &getProgressChannel();
+
+		/*! \brief Enables the transaction batched execution mode for DBMS exports. When enabled, groups of
+		batch_size DDL commands are wrapped in a single explicit transaction, paying one commit (and one
+		WAL flush on the server) per group instead of per command. Each command runs under a savepoint so
+		an individual failure is undone and handled by the regular error handling without discarding the
+		rest of the group */
+		static void setTransactionBatchExport(bool value, unsigned batch_size = DefaultTxnBatchSize);
+
+		//! \brief Returns true when the transaction batched execution mode is enabled
+		static bool isTransactionBatchExport();
+
+		/*! \brief When enabled, the objects created before a mid-export failure or cancellation are kept
+		on the server instead of being removed by undoDBMSExport(). Combined with the transaction batched
+		mode (where a failed statement discards only its own group) this allows the operator to fix the
+		cause and re-run the export reusing the completed work (e.g. together with the ignore duplication
+		option) instead of restarting from scratch. Simulations (model validation) always undo their
+		changes regardless of this option */
+		static void setPreservePartialExport(bool value);
+
+		//! \brief Returns true when the partial export preservation is enabled
+		static bool isPreservePartialExport();
+
+		/*! \brief Defines the amount of connections used by DBMS exports to create independent objects
+		in parallel. The dependency order of the export buffer is respected for all but the statements
+		known to be mutually independent — currently index builds, whose locks don't conflict with each
+		other — which are deferred and dispatched concurrently to the pooled connections. Values below 2
+		disable the parallel dispatching and the value is capped to MaxExportConns */
+		static void setParallelExportConnections(unsigned value);
+
+		//! \brief Returns the amount of connections used to create independent objects in parallel
+		static unsigned getParallelExportConnections();
+
+		/*! \brief When enabled together with the ignore duplication option, DBMS exports retrieve the
+		identification of the objects existing in the destination database in a single catalog query and
+		silently skip the creation of the pre-existing ones, instead of paying a server round-trip plus an
+		ignored duplication error for each. Creation commands whose object can't be identified from the
+		SQL (e.g. table children added via ALTER TABLE) still rely on the duplication error handling */
+		static void setPrecheckExistingObjects(bool value);
+
+		//! \brief Returns true when the existence pre-checking is enabled
+		static bool isPrecheckExistingObjects();
+
 		//! \brief Exports the model to a named SQL file. The PostgreSQL version syntax must be specified.
 		void exportToSQL(DatabaseModel *db_model, const QString &filename, const QString &pgsql_ver, bool split);
 
@@ -18,10 +18,24 @@
 
 #include "modelsdiffhelper.h"
 #include <QThread>
+#include <QtConcurrent/QtConcurrent>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QSet>
+#include <atomic>
 #include "utilsns.h"
+#include "tracelogger.h"
+#include "profilerhooks.h"
+#include "taskscheduler.h"
 #include <QDate>
 #include "catalog.h"
 
+unsigned ModelsDiffHelper::diff_threads=1;
+bool ModelsDiffHelper::fp_cache_enabled=false;
+bool ModelsDiffHelper::direct_fp_compare=false;
+const QByteArray ModelsDiffHelper::FpCacheMagic("pgmodeler-diff-fp-cache");
+const quint32 ModelsDiffHelper::FpCacheVersion=1;
+
 const QStringList ModelsDiffHelper::TableObjsIgnoredAttribs = { Attributes::Alias };
 
 const QStringList ModelsDiffHelper::ObjectsIgnoredAttribs = {
@@ -41,8 +55,12 @@ const QStringList ModelsDiffHelper::RolesIgnoredTags = {
 ModelsDiffHelper::ModelsDiffHelper()
 {
 	diff_canceled=false;
+	diffs_detected=false;
+	streaming_mode=false;
+	compare_mode=CompareFull;
 	pgsql_version=PgSqlVersions::DefaulVersion;
 	source_model=imported_model=nullptr;
+	output_device=nullptr;
 	resetDiffCounter();
 
 	diff_opts[OptKeepClusterObjs]=true;
@@ -61,6 +79,80 @@ ModelsDiffHelper::~ModelsDiffHelper()
 	destroyTempObjects();
 }
 
+void ModelsDiffHelper::setDiffThreads(unsigned thread_count)
+{
+	if(thread_count==0)
+		thread_count=1;
+	else if(thread_count > MaxDiffThreads)
+		thread_count=MaxDiffThreads;
+
+	diff_threads=thread_count;
+}
+
+unsigned ModelsDiffHelper::getDiffThreads()
+{
+	return diff_threads;
+}
+
+ProgressChannel &ModelsDiffHelper::getProgressChannel()
+{
+	return progress_chn;
+}
+
+void ModelsDiffHelper::setFingerprintCacheEnabled(bool value)
+{
+	fp_cache_enabled=value;
+}
+
+bool ModelsDiffHelper::isFingerprintCacheEnabled()
+{
+	return fp_cache_enabled;
+}
+
+void ModelsDiffHelper::setDirectFingerprintComparison(bool value)
+{
+	direct_fp_compare=value;
+}
+
+void ModelsDiffHelper::setStreamingMode(bool value)
+{
+	streaming_mode=value;
+}
+
+bool ModelsDiffHelper::isStreamingModeEnabled()
+{
+	return streaming_mode;
+}
+
+void ModelsDiffHelper::setOutputDevice(QIODevice *device)
+{
+	output_device=device;
+}
+
+void ModelsDiffHelper::writeDiffCode(const QString &code)
+{
+	if(code.isEmpty())
+		return;
+
+	if(output_device)
+		output_device->write(code.toUtf8());
+
+	emit s_diffCodeGenerated(code);
+}
+
+void ModelsDiffHelper::setCompareMode(unsigned mode)
+{
+	if(mode > CompareCountOnly)
+		throw Exception(ErrorCode::RefElementInvalidIndex,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	compare_mode=mode;
+}
+
+bool ModelsDiffHelper::hasDifferences()
+{
+	return diffs_detected;
+}
+
 void ModelsDiffHelper::setDiffOption(unsigned opt_id, bool value)
 {
 	if(opt_id > OptDropMissingColsConstr)
@@ -228,21 +320,51 @@ unsigned ModelsDiffHelper::getDiffTypeCount(unsigned diff_type)
 
 void ModelsDiffHelper::diffModels()
 {
+	TraceLogger::Span trace_span("ModelsDiffHelper::diffModels");
+	ProfilerHooks::Phase prof_phase("diff-models");
+
 	try
 	{
+		bool early_exited=false;
+
 		if(!source_model || !imported_model)
 			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		progress_chn.reset();
+		diffs_detected=false;
+
+		/* Indexing the many-to-many relationship generated tables of both models up front
+		so they can be paired via hash lookups during the comparisons below */
+		buildRelNNTablesIndexes();
+
+		if(fp_cache_enabled)
+			loadFingerprintCache();
+
 		//First, we need to detect the objects to be dropped
 		diffModels(ObjectsDiffInfo::DropObject);
 		//Second, we will check the objects to be created or modified
 		diffModels(ObjectsDiffInfo::CreateObject);
 
-		if(diff_canceled)
+		early_exited=(compare_mode==CompareFirstDiff && diffs_detected);
+
+		if(diff_canceled && !early_exited)
 			emit s_diffCanceled();
 		else
 		{
-			processDiffInfos();
+			//The first-difference interruption reuses the cancel flag, so it is cleared here
+			if(early_exited)
+				diff_canceled=false;
+
+			/* The fingerprint cache only persists complete comparisons since an early-exited
+			run would overwrite it with the few pairs compared before the interruption */
+			if(fp_cache_enabled && !early_exited)
+				saveFingerprintCache();
+
+			if(compare_mode==CompareFull)
+				processDiffInfos();
+			else
+				emit s_progressUpdated(100, diffs_detected ? tr("Differences detected.") : tr("No differences detected."));
+
 			emit s_diffFinished();
 		}
 	}
@@ -251,7 +373,7 @@ void ModelsDiffHelper::diffModels()
 		emit s_diffAborted(Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, e.getExtraInfo()));
 	}
 
-	destroyTempObjects();
+	destroyTempObjectsDetached();
 	resetDiffCounter();
 }
 
@@ -266,20 +388,40 @@ void ModelsDiffHelper::diffColsInheritance(PhysicalTable *parent_tab, PhysicalTa
 		return;
 
 	Column *child_col = nullptr;
+	QSet<QString> child_col_names;
 
-	for(auto &parent_col : *parent_tab->getObjectList(ObjectType::Column))
+	/* On the first visit to the parent table its comparable columns are selected a single time
+	 * for the whole run, so parents shared by hundreds of partitions are not re-walked per child.
+	 * The SQL-disabled columns are ignored on that first visit (generateDiffInfo() already
+	 * discards the duplicated infos the removed re-visits used to produce) */
+	if(!inh_cols_cache.contains(parent_tab))
 	{
-		child_col = dynamic_cast<Column *>(child_tab->getColumn(parent_col->getName()));
+		vector<Column *> inh_cols;
 
-		//Ignoring columns with sql disabled
-		if(parent_col->isSQLDisabled())
-			generateDiffInfo(ObjectsDiffInfo::IgnoreObject, parent_col);
-		else if(!child_col)
+		for(auto &parent_col : *parent_tab->getObjectList(ObjectType::Column))
+		{
+			//Ignoring columns with sql disabled
+			if(parent_col->isSQLDisabled())
+				generateDiffInfo(ObjectsDiffInfo::IgnoreObject, parent_col);
+			else
+				inh_cols.push_back(dynamic_cast<Column *>(parent_col));
+		}
+
+		inh_cols_cache[parent_tab]=inh_cols;
+	}
+
+	//Indexing the child column names so each parent column is checked via a hash lookup
+	for(auto &col : *child_tab->getObjectList(ObjectType::Column))
+		child_col_names.insert(col->getName());
+
+	for(auto &parent_col : inh_cols_cache[parent_tab])
+	{
+		if(!child_col_names.contains(parent_col->getName()))
 		{
 			/* Creating a column that has as parent table the child_tab
 			 * This way the proper ALTER...ADD COLUM can be generated */
 			child_col = new Column;
-			*child_col = *dynamic_cast<Column *>(parent_col);
+			*child_col = *parent_col;
 			child_col->setParentTable(child_tab);
 			child_col->setDeclaredInTable(false);
 			tmp_objects.push_back(child_col);
@@ -298,6 +440,7 @@ void ModelsDiffHelper::diffTables(PhysicalTable *src_table, PhysicalTable *imp_t
 	Constraint *constr=nullptr;
 	PhysicalTable *ref_tab=nullptr, *comp_tab=nullptr;
 	BaseObject *aux_obj=nullptr;
+	QHash<QString, TableObject *> comp_objs;
 
 	if(diff_type==ObjectsDiffInfo::DropObject)
 	{
@@ -317,10 +460,17 @@ void ModelsDiffHelper::diffTables(PhysicalTable *src_table, PhysicalTable *imp_t
 	{
 		tab_objs=ref_tab->getObjectList(types[i]);
 
+		/* Indexing the compared table children by name so the objects below are
+		paired via hash lookups instead of a linear scan per object */
+		comp_objs.clear();
+
+		for(auto &cmp_obj : *comp_tab->getObjectList(types[i]))
+			comp_objs.insert(cmp_obj->getName(), cmp_obj);
+
 		for(auto &tab_obj : *tab_objs)
 		{
 			//Get the object from the compared table
-			aux_obj=comp_tab->getObject(tab_obj->getName(), tab_obj->getObjectType());
+			aux_obj=comp_objs.value(tab_obj->getName(), nullptr);
 			constr=dynamic_cast<Constraint *>(tab_obj);
 
 			//Ignoring object with sql disabled or check constraints added by generalizations
@@ -342,7 +492,8 @@ void ModelsDiffHelper::diffTables(PhysicalTable *src_table, PhysicalTable *imp_t
 						 (constr && constr->getConstraintType()!=ConstraintType::ForeignKey)))
 				{
 					//If there are some differences on the XML code of the objects
-					if(tab_obj->isCodeDiffersFrom(aux_obj, TableObjsIgnoredAttribs))
+					if((!direct_fp_compare || getObjectFingerprint(tab_obj)!=getObjectFingerprint(aux_obj)) &&
+							tab_obj->isCodeDiffersFrom(aux_obj, TableObjsIgnoredAttribs))
 						generateDiffInfo(ObjectsDiffInfo::AlterObject, tab_obj, aux_obj);
 
 				}
@@ -365,6 +516,118 @@ void ModelsDiffHelper::diffTables(PhysicalTable *src_table, PhysicalTable *imp_t
 	}
 }
 
+void ModelsDiffHelper::precompareObjects(const map<unsigned, BaseObject *> &obj_order, DatabaseModel *aux_model,
+																				 map<BaseObject *, std::pair<BaseObject *, bool>> &results)
+{
+	vector<BaseObject *> objects;
+	QList<QFuture<void>> futures;
+	QMutex result_mtx, error_mtx;
+	std::atomic<size_t> next_idx{0};
+	Exception error;
+	bool has_error=false;
+	ObjectType obj_type;
+
+	//Selecting the objects that reach the generic comparison in diffModels()
+	for(auto &obj_itr : obj_order)
+	{
+		obj_type=obj_itr.second->getObjectType();
+
+		if(obj_type==ObjectType::BaseRelationship || obj_type==ObjectType::Database ||
+			 obj_type==ObjectType::Permission || obj_type==ObjectType::Relationship ||
+			 TableObject::isTableObject(obj_type) ||
+			 obj_itr.second->isSystemObject() || obj_itr.second->isSQLDisabled())
+			continue;
+
+		objects.push_back(obj_itr.second);
+	}
+
+	/* The xml code of the compared objects embeds the reduced form of the objects they
+	 * reference (schema, owner, tablespace, functions and so on), whose caches are shared
+	 * among all the referencing objects. Those definitions are generated serially here so
+	 * the workers only read already populated caches instead of racing to write them,
+	 * mirroring the discipline of DatabaseModel::generateCodeInParallel() */
+	vector<ObjectType> shared_types={ ObjectType::Schema, ObjectType::Tablespace, ObjectType::Role,
+																		ObjectType::Collation, ObjectType::Language, ObjectType::Function,
+																		ObjectType::Operator, ObjectType::OpClass, ObjectType::OpFamily,
+																		ObjectType::ForeignDataWrapper, ObjectType::ForeignServer, ObjectType::Tag };
+
+	for(auto &model : vector<DatabaseModel *>{ source_model, imported_model })
+	{
+		for(auto &type : shared_types)
+		{
+			for(auto &object : *model->getObjectList(type))
+				object->getCodeDefinition(SchemaParser::XmlDefinition, true);
+		}
+	}
+
+	/* Honoring the concurrent read contract (see DatabaseModel::lockForConcurrentRead()):
+	 * the lazily built signature indexes of both models are materialized upfront — otherwise
+	 * the workers' getObject() calls would trigger concurrent index rebuilds, a mutation —
+	 * and the shared read locks are held for the whole lifetime of the workers */
+	source_model->prepareForConcurrentReads();
+	imported_model->prepareForConcurrentReads();
+	source_model->lockForConcurrentRead();
+	imported_model->lockForConcurrentRead();
+
+	/* The workers pull objects from a shared index and compare each one against its counterpart
+	 * in aux_model. Each pair of objects is touched by a single worker, so the per object code
+	 * caches filled during the comparison are never accessed concurrently. The workers run on
+	 * the shared scheduler pool so a diff doesn't oversubscribe the machine when other helpers
+	 * are active */
+	for(unsigned th=0; th < diff_threads; th++)
+	{
+		futures.append(QtConcurrent::run(&TaskScheduler::getThreadPool(),
+		[this, &objects, &next_idx, aux_model, &results, &result_mtx, &error, &has_error, &error_mtx](){
+			size_t idx=0;
+			BaseObject *object=nullptr, *aux_object=nullptr;
+			ObjectType obj_type;
+			bool differs=false;
+
+			try
+			{
+				while((idx=next_idx++) < objects.size() && !diff_canceled)
+				{
+					object=objects[idx];
+					obj_type=object->getObjectType();
+					differs=false;
+
+					aux_object=aux_model->getObject(object->getSignature(), obj_type);
+
+					//Special case for many-to-many relationships
+					if(obj_type==ObjectType::Table && !aux_object)
+						aux_object=getRelNNTable(object->getSignature(), aux_model);
+
+					if(aux_object)
+						differs=compareObjects(object, aux_object);
+
+					QMutexLocker locker(&result_mtx);
+					results[object]=std::make_pair(aux_object, differs);
+				}
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&error_mtx);
+
+				//Only the first error is propagated to the caller
+				if(!has_error)
+				{
+					error=Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+					has_error=true;
+				}
+			}
+		}));
+	}
+
+	for(auto &future : futures)
+		future.waitForFinished();
+
+	source_model->unlockConcurrentRead();
+	imported_model->unlockConcurrentRead();
+
+	if(has_error)
+		throw Exception(error.getErrorMessage(), error.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &error);
+}
+
 void ModelsDiffHelper::diffModels(unsigned diff_type)
 {
 	if(diff_canceled)
@@ -373,6 +636,8 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 	try
 	{
 		map<unsigned, BaseObject *> obj_order;
+		map<BaseObject *, std::pair<BaseObject *, bool>> precomp_diffs;
+		map<BaseObject *, std::pair<BaseObject *, bool>>::iterator pre_itr;
 		BaseObject *object=nullptr, *aux_object=nullptr;
 		ObjectType obj_type;
 		QString obj_name;
@@ -403,6 +668,12 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 			prog=50;
 		}
 
+		/* When the parallel comparison is enabled the expensive checks (ALTER definition and XML code
+		 * equality) are precomputed by a thread pool. The sequential walk below then consumes the
+		 * precomputed results, keeping the diff info generation order identical to the serial mode */
+		if(diff_threads > 1 && diff_type==ObjectsDiffInfo::CreateObject && !diff_canceled)
+			precompareObjects(obj_order, aux_model, precomp_diffs);
+
 		for(auto &obj_itr : obj_order)
 		{
 			object=obj_itr.second;
@@ -418,9 +689,13 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 					((diff_type==ObjectsDiffInfo::DropObject && (!diff_opts[OptKeepClusterObjs] || (diff_opts[OptKeepClusterObjs] && obj_type!=ObjectType::Role && obj_type!=ObjectType::Tablespace))) ||
 					 (diff_type!=ObjectsDiffInfo::DropObject)))
 			{
-				emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
-															 tr("Processing object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
-															 object->getObjectType());
+				/* The report is coalesced: the message formatting and the queued emission happen
+				 * only when the percentage advances, keeping the reporting traffic bounded at
+				 * thousands of compared objects per second */
+				if(progress_chn.reportProgress(prog + ((idx/static_cast<double>(obj_order.size())) * factor), enum_cast(obj_type)))
+					emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
+																 tr("Processing object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
+																 object->getObjectType());
 
 				//Processing objects that are not database, table child object (they are processed further)
 				if(obj_type!=ObjectType::Database && !TableObject::isTableObject(obj_type))
@@ -478,27 +753,28 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 					}
 					else if(obj_type!=ObjectType::Permission)
 					{
-						//Get the object from the database
 						obj_name=object->getSignature();
-						aux_object=aux_model->getObject(obj_name, obj_type);
+						pre_itr=precomp_diffs.find(object);
 
-						//Special case for many-to-many relationships
-						if(obj_type==ObjectType::Table && !aux_object)
-							aux_object=getRelNNTable(obj_name, aux_model);
+						//Reusing the counterpart already resolved by the parallel comparison
+						if(pre_itr!=precomp_diffs.end())
+							aux_object=pre_itr->second.first;
+						else
+						{
+							//Get the object from the database
+							aux_object=aux_model->getObject(obj_name, obj_type);
+
+							//Special case for many-to-many relationships
+							if(obj_type==ObjectType::Table && !aux_object)
+								aux_object=getRelNNTable(obj_name, aux_model);
+						}
 
 						if(diff_type != ObjectsDiffInfo::DropObject && aux_object)
 						{
-							/* Try to get a diff from the retrieve object and the current object,
-							 * comparing only basic attributes like schema, tablespace and owner
-							 * this is why the BaseObject::getAlterDefinition is called */
-							objs_differs=!aux_object->BaseObject::getAlterDefinition(object).isEmpty();
-
-							//If the objects does not differ, try to compare their XML definition
-							if(!objs_differs)
-							{
-								xml_differs = object->isCodeDiffersFrom(aux_object,	ObjectsIgnoredAttribs,
-																												obj_type != ObjectType::Role ? ObjectsIgnoredTags : RolesIgnoredTags);
-							}
+							if(pre_itr!=precomp_diffs.end())
+								objs_differs=pre_itr->second.second;
+							else
+								objs_differs=compareObjects(object, aux_object);
 
 							//If a difference was detected between the objects
 							if(objs_differs || xml_differs)
@@ -544,9 +820,11 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 			else
 			{
 				generateDiffInfo(ObjectsDiffInfo::IgnoreObject, object);
-				emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
-									   tr("Skipping object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
-									   object->getObjectType());
+
+				if(progress_chn.reportProgress(prog + ((idx/static_cast<double>(obj_order.size())) * factor), enum_cast(obj_type)))
+					emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
+										   tr("Skipping object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
+										   object->getObjectType());
 
 				if(diff_canceled)
 					break;
@@ -607,28 +885,196 @@ void ModelsDiffHelper::diffTableObject(TableObject *tab_obj, unsigned diff_type)
 		else
 			generateDiffInfo(ObjectsDiffInfo::IgnoreObject, tab_obj);
 	}
-	else if(diff_type!=ObjectsDiffInfo::DropObject && tab_obj->isCodeDiffersFrom(aux_tab_obj, TableObjsIgnoredAttribs))
+	else if(diff_type!=ObjectsDiffInfo::DropObject && compareObjects(tab_obj, aux_tab_obj))
 		generateDiffInfo(ObjectsDiffInfo::AlterObject, tab_obj, aux_tab_obj);
 }
 
-BaseObject *ModelsDiffHelper::getRelNNTable(const QString &obj_name, DatabaseModel *model)
+QByteArray ModelsDiffHelper::getObjectFingerprint(BaseObject *object)
+{
+	/* The XML definition covers all the attributes participating in the comparison (the ones
+	 * hashed by the ALTER definition included), so fingerprints unchanged on both sides imply
+	 * that the pair of objects compares exactly as it did on the previous run */
+	return QCryptographicHash::hash(object->getCodeDefinition(SchemaParser::XmlDefinition).simplified().toUtf8(),
+																	QCryptographicHash::Sha256);
+}
+
+QString ModelsDiffHelper::getFingerprintCacheFilePath()
 {
-	vector<BaseObject *> *rels=model->getObjectList(ObjectType::Relationship);
+	QByteArray models_id=QString("%1:%2")
+											 .arg(source_model->getName())
+											 .arg(imported_model->getName()).toUtf8();
+
+	return GlobalAttributes::getConfigurationsDir() + GlobalAttributes::DirSeparator +
+				 QString("diff-fp-%1%2")
+				 .arg(QString(QCryptographicHash::hash(models_id, QCryptographicHash::Sha256).toHex().left(16)))
+				 .arg(GlobalAttributes::ModelCacheExt);
+}
+
+void ModelsDiffHelper::loadFingerprintCache()
+{
+	QFile cache_file(getFingerprintCacheFilePath());
+	QByteArray magic, data, src_fp, imp_fp;
+	QString pgm_version, pg_version, key;
+	quint32 version=0, entry_cnt=0;
+
+	loaded_fps.clear();
+
+	if(!cache_file.open(QFile::ReadOnly))
+		return;
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream >> magic >> version >> pgm_version >> pg_version;
+
+	/* Fingerprints computed by another version of pgModeler or for another target PostgreSQL
+	 * version are discarded since the code they hash may be generated differently */
+	if(stream.status()!=QDataStream::Ok ||
+			magic!=FpCacheMagic || version!=FpCacheVersion ||
+			pgm_version!=GlobalAttributes::PgModelerVersion ||
+			pg_version!=pgsql_version)
+		return;
+
+	stream >> data;
+	data=qUncompress(data);
+
+	if(data.isEmpty())
+		return;
+
+	QDataStream buf_stream(data);
+	buf_stream.setVersion(QDataStream::Qt_5_0);
+	buf_stream >> entry_cnt;
+
+	for(quint32 i=0; i < entry_cnt; i++)
+	{
+		buf_stream >> key >> src_fp >> imp_fp;
+		loaded_fps[key]=qMakePair(src_fp, imp_fp);
+	}
+
+	if(buf_stream.status()!=QDataStream::Ok)
+		loaded_fps.clear();
+}
+
+void ModelsDiffHelper::saveFingerprintCache()
+{
+	QFile cache_file(getFingerprintCacheFilePath());
+	QByteArray data;
+
+	/* The cache is a best-effort optimization so failures when writing it
+	 * must never abort the diff that is in progress */
+	if(!cache_file.open(QFile::WriteOnly))
+		return;
+
+	QDataStream buf_stream(&data, QIODevice::WriteOnly);
+	buf_stream.setVersion(QDataStream::Qt_5_0);
+	buf_stream << static_cast<quint32>(matched_fps.size());
+
+	for(auto itr=matched_fps.constBegin(); itr!=matched_fps.constEnd(); itr++)
+		buf_stream << itr.key() << itr.value().first << itr.value().second;
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << FpCacheMagic << FpCacheVersion
+				 << GlobalAttributes::PgModelerVersion
+				 << pgsql_version
+				 << qCompress(data);
+}
+
+bool ModelsDiffHelper::compareObjects(BaseObject *object, BaseObject *aux_object)
+{
+	ObjectType obj_type=object->getObjectType();
+	QString fp_key;
+	QByteArray obj_fp, aux_fp;
+	bool differs=false;
+
+	try
+	{
+		if(direct_fp_compare)
+		{
+			obj_fp=getObjectFingerprint(object);
+			aux_fp=getObjectFingerprint(aux_object);
+
+			/* In a model-to-model comparison matching fingerprints mean definitions generated
+			 * from identical XML contents, so the pair can't produce any difference */
+			if(obj_fp==aux_fp)
+				return false;
+		}
+
+		if(fp_cache_enabled)
+		{
+			fp_key=QString("%1:%2").arg(enum_cast(obj_type)).arg(object->getSignature());
+
+			if(obj_fp.isEmpty())
+			{
+				obj_fp=getObjectFingerprint(object);
+				aux_fp=getObjectFingerprint(aux_object);
+			}
+
+			auto itr=loaded_fps.constFind(fp_key);
+
+			/* When both fingerprints match the pair persisted by the previous run the deep
+			 * comparison is skipped since that run already proved the objects to be equal */
+			if(itr!=loaded_fps.constEnd() && itr.value().first==obj_fp && itr.value().second==aux_fp)
+			{
+				QMutexLocker locker(&fp_cache_mtx);
+				matched_fps[fp_key]=qMakePair(obj_fp, aux_fp);
+				return false;
+			}
+		}
+
+		if(TableObject::isTableObject(obj_type))
+			differs=object->isCodeDiffersFrom(aux_object, TableObjsIgnoredAttribs);
+		else
+		{
+			/* Try to get a diff from the retrieved object and the current object,
+			 * comparing only basic attributes like schema, tablespace and owner
+			 * this is why the BaseObject::getAlterDefinition is called */
+			differs=!aux_object->BaseObject::getAlterDefinition(object).isEmpty();
+
+			//If the objects does not differ, try to compare their XML definition
+			if(!differs)
+				differs=object->isCodeDiffersFrom(aux_object, ObjectsIgnoredAttribs,
+																					obj_type != ObjectType::Role ? ObjectsIgnoredTags : RolesIgnoredTags);
+		}
+
+		if(fp_cache_enabled && !differs)
+		{
+			QMutexLocker locker(&fp_cache_mtx);
+			matched_fps[fp_key]=qMakePair(obj_fp, aux_fp);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
+	}
+
+	return differs;
+}
+
+void ModelsDiffHelper::buildRelNNTablesIndexes()
+{
+	DatabaseModel *models[2]={ source_model, imported_model };
+	QHash<QString, BaseObject *> *nn_tabs_idxs[2]={ &src_nn_tabs_idx, &imp_nn_tabs_idx };
 	Relationship *rel=nullptr;
-	BaseObject *tab=nullptr;
 
-	for(auto &obj : *rels)
+	for(unsigned i=0; i < 2; i++)
 	{
-		rel=dynamic_cast<Relationship *>(obj);
-		if(rel->getRelationshipType()==BaseRelationship::RelationshipNn &&
-				rel->getGeneratedTable() && rel->getGeneratedTable()->getSignature()==obj_name)
+		nn_tabs_idxs[i]->clear();
+		nn_tabs_idxs[i]->reserve(models[i]->getObjectCount(ObjectType::Relationship));
+
+		for(auto &object : *models[i]->getObjectList(ObjectType::Relationship))
 		{
-			tab=rel->getGeneratedTable();
-			break;
+			rel=dynamic_cast<Relationship *>(object);
+
+			if(rel->getRelationshipType()==BaseRelationship::RelationshipNn && rel->getGeneratedTable())
+				nn_tabs_idxs[i]->insert(rel->getGeneratedTable()->getSignature(), rel->getGeneratedTable());
 		}
 	}
+}
 
-	return tab;
+BaseObject *ModelsDiffHelper::getRelNNTable(const QString &obj_name, DatabaseModel *model)
+{
+	const QHash<QString, BaseObject *> &nn_tabs_idx=(model==source_model ? src_nn_tabs_idx : imp_nn_tabs_idx);
+	return nn_tabs_idx.value(obj_name, nullptr);
 }
 
 void ModelsDiffHelper::generateDiffInfo(unsigned diff_type, BaseObject *object, BaseObject *old_object)
@@ -762,6 +1208,18 @@ void ModelsDiffHelper::generateDiffInfo(unsigned diff_type, BaseObject *object,
 					}
 				}
 			}
+
+			if(diffs_counter[ObjectsDiffInfo::CreateObject] > 0 ||
+					diffs_counter[ObjectsDiffInfo::DropObject] > 0 ||
+					diffs_counter[ObjectsDiffInfo::AlterObject] > 0)
+			{
+				diffs_detected=true;
+
+				/* In the first-difference mode the comparison is interrupted right away
+				 * reusing the cancelation flag honored by all the comparison loops */
+				if(compare_mode==CompareFirstDiff)
+					diff_canceled=true;
+			}
 		}
 	}
 	catch(Exception &e)
@@ -792,6 +1250,7 @@ bool ModelsDiffHelper::isDiffInfoExists(unsigned diff_type, BaseObject *object,
 
 void ModelsDiffHelper::processDiffInfos()
 {
+	ProfilerHooks::Phase prof_phase("process-diff-infos");
 	BaseObject *object=nullptr;
 	Relationship *rel=nullptr;
 	map<unsigned, QString> drop_objs, create_objs, alter_objs, truncate_tabs, create_fks, create_constrs;
@@ -808,7 +1267,7 @@ void ModelsDiffHelper::processDiffInfos()
 	Constraint *constr=nullptr;
 	Column *col=nullptr, *aux_col=nullptr;
 	PhysicalTable *parent_tab=nullptr;
-	bool skip_obj=false;
+	bool skip_obj=false, code_streamed=false;
 	QStringList sch_names;
 
 	try
@@ -837,6 +1296,11 @@ void ModelsDiffHelper::processDiffInfos()
 
 		for(ObjectsDiffInfo diff : diff_infos)
 		{
+			/* Cooperative cancellation: reacting between infos keeps the latency bounded by a
+			 * single object's processing instead of the whole remaining list */
+			if(diff_canceled)
+				break;
+
 			diff_type=diff.getDiffType();
 			object=diff.getObject();
 			obj_type=object->getObjectType();
@@ -844,10 +1308,13 @@ void ModelsDiffHelper::processDiffInfos()
 			constr=dynamic_cast<Constraint *>(object);
 			col=dynamic_cast<Column *>(object);
 
-			emit s_progressUpdated((idx++/static_cast<double>(diff_infos.size())) * 100,
-								   tr("Processing `%1' info for object `%2' (%3)...")
-								   .arg(diff.getDiffTypeString()).arg(object->getSignature()).arg(object->getTypeName()),
-								   obj_type);
+			if(progress_chn.reportProgress((idx/static_cast<double>(diff_infos.size())) * 100, enum_cast(obj_type)))
+				emit s_progressUpdated((idx/static_cast<double>(diff_infos.size())) * 100,
+									   tr("Processing `%1' info for object `%2' (%3)...")
+									   .arg(diff.getDiffTypeString()).arg(object->getSignature()).arg(object->getTypeName()),
+									   obj_type);
+
+			idx++;
 
 			/* Preliminary verification for check constraints: there is the need to
 		 check if the constraint is added by generalization or if this is not the case
@@ -1044,41 +1511,133 @@ void ModelsDiffHelper::processDiffInfos()
 			attribs[Attributes::Function]=(has_diffs && source_model->getObjectCount(ObjectType::Function)!=0 ? Attributes::True : "");
 			attribs[Attributes::SearchPath]=(has_diffs ? sch_names.join(',') : "");
 
-			ritr=drop_objs.rbegin();
-			ritr_end=drop_objs.rend();
-
-			attribs[Attributes::DropCmds]+=no_inherit_def;
+			schparser.setPgSQLVersion(pgsql_version);
 
-			while(ritr!=ritr_end)
+			if(streaming_mode)
 			{
-				attribs[Attributes::DropCmds]+=ritr->second;
-				ritr++;
+				/* In streaming mode unique markers take the place of the command sections when the
+				 * diff template is rendered. The resulting wrapper code is then split at the markers
+				 * and the commands of each section are written one by one to the sink, so the whole
+				 * script is never materialized in a single buffer */
+				QString wrapper, marker_fmt=QString("\x1f<%1>\x1f"),
+						markers[7]={ marker_fmt.arg(Attributes::UnsetPerms), marker_fmt.arg(Attributes::DropCmds),
+												 marker_fmt.arg(Attributes::CreateCmds), marker_fmt.arg(Attributes::AlterCmds),
+												 marker_fmt.arg(Attributes::ConstrDefs), marker_fmt.arg(Attributes::FkDefs),
+												 marker_fmt.arg(Attributes::SetPerms) };
+				int start=0, pos=-1;
+
+				if(!unset_perms.isEmpty())
+					attribs[Attributes::UnsetPerms]=markers[0];
+
+				if(!no_inherit_def.isEmpty() || !drop_objs.empty() || !col_drop_def.isEmpty())
+					attribs[Attributes::DropCmds]=markers[1];
+
+				if(!create_objs.empty() || !inherit_def.isEmpty())
+					attribs[Attributes::CreateCmds]=markers[2];
+
+				if(!alter_objs.empty())
+					attribs[Attributes::AlterCmds]=markers[3];
+
+				if(!create_constrs.empty())
+					attribs[Attributes::ConstrDefs]=markers[4];
+
+				if(!create_fks.empty())
+					attribs[Attributes::FkDefs]=markers[5];
+
+				if(!set_perms.isEmpty())
+					attribs[Attributes::SetPerms]=markers[6];
+
+				wrapper=schparser.getCodeDefinition(GlobalAttributes::getSchemaFilePath(GlobalAttributes::AlterSchemaDir, Attributes::Diff),
+																						attribs);
+
+				//The markers are consumed following the order in which the sections appear in the template
+				for(unsigned i=0; i < 7; i++)
+				{
+					pos=wrapper.indexOf(markers[i], start);
+
+					if(pos < 0)
+						continue;
+
+					writeDiffCode(wrapper.mid(start, pos - start));
+					start=pos + markers[i].length();
+
+					if(i==0)
+						writeDiffCode(unset_perms);
+					else if(i==1)
+					{
+						writeDiffCode(no_inherit_def);
+
+						for(ritr=drop_objs.rbegin(), ritr_end=drop_objs.rend(); ritr!=ritr_end; ritr++)
+							writeDiffCode(ritr->second);
+
+						writeDiffCode(col_drop_def);
+					}
+					else if(i==2)
+					{
+						for(auto &itr : create_objs)
+							writeDiffCode(itr.second);
+
+						writeDiffCode(inherit_def);
+					}
+					else if(i==3)
+					{
+						for(auto &itr : alter_objs)
+							writeDiffCode(itr.second);
+					}
+					else if(i==4)
+					{
+						for(auto &itr : create_constrs)
+							writeDiffCode(itr.second);
+					}
+					else if(i==5)
+					{
+						for(auto &itr : create_fks)
+							writeDiffCode(itr.second);
+					}
+					else
+						writeDiffCode(set_perms);
+				}
+
+				writeDiffCode(wrapper.mid(start));
+				code_streamed=true;
 			}
+			else
+			{
+				ritr=drop_objs.rbegin();
+				ritr_end=drop_objs.rend();
 
-			attribs[Attributes::DropCmds]+=col_drop_def;
+				attribs[Attributes::DropCmds]+=no_inherit_def;
 
+				while(ritr!=ritr_end)
+				{
+					attribs[Attributes::DropCmds]+=ritr->second;
+					ritr++;
+				}
 
-			for(auto &itr : create_objs)
-				attribs[Attributes::CreateCmds]+=itr.second;
+				attribs[Attributes::DropCmds]+=col_drop_def;
 
-			attribs[Attributes::CreateCmds]+=inherit_def;
 
-			for(auto &itr : create_constrs)
-				attribs[Attributes::ConstrDefs]+=itr.second;
+				for(auto &itr : create_objs)
+					attribs[Attributes::CreateCmds]+=itr.second;
 
-			for(auto &itr : create_fks)
-				attribs[Attributes::FkDefs]+=itr.second;
+				attribs[Attributes::CreateCmds]+=inherit_def;
 
-			for(auto &itr : alter_objs)
-				attribs[Attributes::AlterCmds]+=itr.second;
+				for(auto &itr : create_constrs)
+					attribs[Attributes::ConstrDefs]+=itr.second;
 
-			//Generating the whole diff buffer
-			schparser.setPgSQLVersion(pgsql_version);
-			diff_def=schparser.getCodeDefinition(GlobalAttributes::getSchemaFilePath(GlobalAttributes::AlterSchemaDir, Attributes::Diff),
-																					 attribs);
+				for(auto &itr : create_fks)
+					attribs[Attributes::FkDefs]+=itr.second;
+
+				for(auto &itr : alter_objs)
+					attribs[Attributes::AlterCmds]+=itr.second;
+
+				//Generating the whole diff buffer
+				diff_def=schparser.getCodeDefinition(GlobalAttributes::getSchemaFilePath(GlobalAttributes::AlterSchemaDir, Attributes::Diff),
+																						 attribs);
+			}
 		}
 
-		if(diff_def.isEmpty())
+		if(diff_def.isEmpty() && !code_streamed)
 			emit s_progressUpdated(100, tr("No differences detected."));
 		else
 			emit s_progressUpdated(100, tr("Preparing diff code..."));
@@ -1102,8 +1661,14 @@ QString ModelsDiffHelper::getCodeDefinition(BaseObject *object, bool drop_cmd)
 	try
 	{
 		TableObject *tab_obj=dynamic_cast<TableObject *>(object);
+		QHash<BaseObject *, QString> &defs_cache=(drop_cmd ? drop_defs_cache : create_defs_cache);
+		auto cache_itr=defs_cache.constFind(object);
 		QString cmd;
 
+		//Reusing the code generated previously for the object on this same run
+		if(cache_itr!=defs_cache.constEnd())
+			return cache_itr.value();
+
 		/* For columns and constraints it is needed to force the generation of
 	   ALTER commands on the parent table */
 		if(tab_obj && (tab_obj->getObjectType()==ObjectType::Column || tab_obj->getObjectType()==ObjectType::Constraint))
@@ -1129,6 +1694,7 @@ QString ModelsDiffHelper::getCodeDefinition(BaseObject *object, bool drop_cmd)
 				cmd=object->getCodeDefinition(SchemaParser::SqlDefinition);
 		}
 
+		defs_cache.insert(object, cmd);
 		return cmd;
 	}
 	catch(Exception &e)
@@ -1149,6 +1715,31 @@ void ModelsDiffHelper::destroyTempObjects()
 	}
 
 	diff_infos.clear();
+	src_nn_tabs_idx.clear();
+	imp_nn_tabs_idx.clear();
+	loaded_fps.clear();
+	matched_fps.clear();
+	drop_defs_cache.clear();
+	create_defs_cache.clear();
+	inh_cols_cache.clear();
+}
+
+void ModelsDiffHelper::destroyTempObjectsDetached()
+{
+	vector<BaseObject *> tmp_objs;
+
+	/* The ownership of the temporary objects is transferred to the worker below, so a further
+	 * (synchronous) destroyTempObjects() call only clears the remaining per-run state */
+	tmp_objs.swap(tmp_objects);
+	destroyTempObjects();
+
+	if(tmp_objs.empty())
+		return;
+
+	TaskScheduler::run([tmp_objs](){
+		for(auto &tmp_obj : tmp_objs)
+			delete tmp_obj;
+	}, TaskScheduler::LowPriority);
 }
 
 void ModelsDiffHelper::recreateObject(BaseObject *object, vector<BaseObject *> &drop_objs, vector<BaseObject *> &create_objs)
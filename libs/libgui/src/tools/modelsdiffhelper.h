@@ -26,13 +26,33 @@
 #define MODELS_DIFF_HELPER_H
 
 #include <QObject>
+#include <QMutex>
+#include <QIODevice>
 #include "databasemodel.h"
 #include "objectsdiffinfo.h"
+#include "progresschannel.h"
 
 class ModelsDiffHelper: public QObject {
 	private:
 		Q_OBJECT
 
+		/*! \brief Amount of threads used to precompute the object comparisons. Values below 2
+		keep the whole comparison serial (see setDiffThreads()) */
+		static unsigned diff_threads;
+
+		//! \brief Indicates that the persistent fingerprint cache is enabled (see setFingerprintCacheEnabled())
+		static bool fp_cache_enabled;
+
+		/*! \brief Indicates that pairs of objects exposing identical content fingerprints must be
+		considered equal without any deep comparison (see setDirectFingerprintComparison()) */
+		static bool direct_fp_compare;
+
+		//! \brief Magic bytes that identify a fingerprint cache file
+		static const QByteArray FpCacheMagic;
+
+		//! \brief Current version of the fingerprint cache file format
+		static const quint32 FpCacheVersion;
+
 		//! \brief List of attributes ignored when comparing XML code of table children objects
 		static const QStringList TableObjsIgnoredAttribs,
 
@@ -51,9 +71,21 @@ class ModelsDiffHelper: public QObject {
 		//! \brief PostgreSQL version used to generate the diff
 		pgsql_version;
 
+		//! \brief Defines how far the diff process goes (see Compare??? constants)
+		unsigned compare_mode;
+
+		/*! \brief Lock-free coalescing channel that tracks the progress of the current diff.
+		The hot per-object signal emissions are gated on this channel so at most one event
+		per percentage point is delivered (see reportProgress()) */
+		ProgressChannel progress_chn;
+
 		//! \brief Indicates if the diff was cancelled by user
 		bool diff_canceled,
 
+		/*! \brief Indicates that at least one difference (create, drop or alter) was detected
+		by the current/last run (see hasDifferences()) */
+		diffs_detected,
+
 		//!brief Diff options. See OPT_??? constants
 		diff_opts[10];
 
@@ -75,6 +107,38 @@ class ModelsDiffHelper: public QObject {
 		//! \brief Stores all objects filtered by the partial diff filters
 		map<unsigned, BaseObject *> filtered_objs;
 
+		/*! \brief Hash indexes mapping the signatures of tables generated by many-to-many relationships
+		to the tables themselves on the source and imported models. They avoid a linear scan over the
+		relationship lists on every call to getRelNNTable() (see buildRelNNTablesIndexes()) */
+		QHash<QString, BaseObject *> src_nn_tabs_idx, imp_nn_tabs_idx;
+
+		/*! \brief Object fingerprints loaded from the previous diff run. Entries exist only for
+		pairs of objects that were deeply compared and proved to be equal on that run */
+		QHash<QString, QPair<QByteArray, QByteArray>> loaded_fps,
+
+		//! \brief Fingerprints of the pairs of objects found equal on the current run, persisted at its end
+		matched_fps;
+
+		//! \brief Serializes the access to matched_fps when the parallel comparison mode is active
+		QMutex fp_cache_mtx;
+
+		/*! \brief Caches, for each parent table visited by diffColsInheritance(), the columns that
+		effectively participate in the comparison, so each parent's column set is processed once
+		per run no matter how many children or partitions inherit from it */
+		QHash<PhysicalTable *, vector<Column *>> inh_cols_cache;
+
+		/*! \brief Memoizes the SQL code produced by getCodeDefinition() during a diff. The same object
+		can have its code requested several times across the drop/create/alter passes and the schema
+		template evaluation is expensive, so it runs at most once per object and command kind */
+		QHash<BaseObject *, QString> drop_defs_cache, create_defs_cache;
+
+		/*! \brief Indicates that the diff code must be streamed in ordered chunks as the sections
+		of the script are resolved instead of being accumulated in diff_def (see setStreamingMode()) */
+		bool streaming_mode;
+
+		//! \brief Optional device to which the diff code chunks are written in streaming mode
+		QIODevice *output_device;
+
 		/*! note The parameter diff_type in any methods below is one of the values in
 		ObjectsDiffInfo::CreateObject|AlterObject|DropObject */
 
@@ -117,9 +181,63 @@ class ModelsDiffHelper: public QObject {
 		//! \brief Destroy the temporary objects and clears the diff info list
 		void destroyTempObjects();
 
+		/*! \brief Releases the temporary objects on a detached worker thread so the caller (and,
+		indirectly, the UI waiting for the diff thread) is not blocked by the teardown of huge
+		diffs. The per-run caches and diff info list are cleared synchronously */
+		void destroyTempObjectsDetached();
+
+		/*! \brief Builds the hash indexes that map the signatures of the tables generated by
+		many-to-many relationships on both models. Called once per diff, before any comparison,
+		so getRelNNTable() can resolve the tables via a single hash lookup */
+		void buildRelNNTablesIndexes();
+
 		BaseObject *getRelNNTable(const QString &obj_name, DatabaseModel *model);
 
+		/*! \brief Performs the deep comparison (ALTER definition and XML code equality) between an
+		object and its counterpart in the other model. When the fingerprint cache is enabled the
+		comparison is skipped for pairs whose fingerprints match the ones persisted by the previous
+		run, and the fingerprints of pairs proved equal are recorded for the next one */
+		bool compareObjects(BaseObject *object, BaseObject *aux_object);
+
+		//! \brief Returns the fingerprint (a hash of the XML code) of the provided object
+		QByteArray getObjectFingerprint(BaseObject *object);
+
+		//! \brief Returns the path to the fingerprint cache file of the current pair of models
+		QString getFingerprintCacheFilePath();
+
+		/*! \brief Loads the fingerprints persisted by the previous run. Stale, truncated or
+		version-incompatible cache files are silently ignored */
+		void loadFingerprintCache();
+
+		//! \brief Persists the fingerprints of the pairs of objects found equal on the current run
+		void saveFingerprintCache();
+
+		/*! \brief Writes a chunk of diff code to the output device (when one is set) and notifies
+		it through the s_diffCodeGenerated() signal. Empty chunks are ignored */
+		void writeDiffCode(const QString &code);
+
+		/*! \brief Precomputes, using a thread pool, the expensive comparisons (ALTER definition and
+		XML code equality) between the eligible objects of obj_order and their counterparts in aux_model.
+		The results map holds, for each compared object, its counterpart (nullptr when absent) and a flag
+		indicating that the objects differ. Comparing is read-only over the two frozen models and each
+		worker touches a disjoint pair of objects, so the per object code caches are never shared */
+		void precompareObjects(const map<unsigned, BaseObject *> &obj_order, DatabaseModel *aux_model,
+													 map<BaseObject *, std::pair<BaseObject *, bool>> &results);
+
 	public:
+		//! \brief Maximum amount of threads accepted by the parallel comparison mode
+		static constexpr unsigned MaxDiffThreads=16;
+
+		//! \brief Performs the full comparison and generates the diff script (default mode)
+		static constexpr unsigned CompareFull=0,
+
+		//! \brief Interrupts the comparison at the first detected difference (see hasDifferences())
+		CompareFirstDiff=1,
+
+		/*! \brief Performs the whole comparison, registering the diff infos and counters, but
+		skips the SQL generation step completely */
+		CompareCountOnly=2;
+
 		static constexpr unsigned OptKeepClusterObjs=0,
 
 		//! \brief Indicates if any DROP/TRUNCATE generated must be in cascade mode
@@ -177,6 +295,58 @@ class ModelsDiffHelper: public QObject {
 		 * perform partial diffs between a database model and a database. */
 		static QStringList getRelationshipFilters(const vector<BaseObject *> &objects, bool use_signature);
 
+		/*! \brief Defines the amount of threads used to precompute the object comparisons. Values
+		below 2 (the default) keep the whole comparison serial. The diff info generation itself is
+		always sequential since the infos generated for an object may depend on the ones generated
+		for previously visited objects */
+		static void setDiffThreads(unsigned thread_count);
+
+		//! \brief Returns the amount of threads used by the parallel comparison mode
+		static unsigned getDiffThreads();
+
+		/*! \brief Returns the progress channel of the helper. UI code may sample it from a
+		timer (see ProgressChannel::hasNews()) instead of relying on the queued signals */
+		ProgressChannel &getProgressChannel();
+
+		/*! \brief Enables the persistent fingerprint cache. When enabled, each diff persists a
+		content fingerprint of every pair of objects proved equal and further diffs of the same
+		pair of models skip the deep comparison of the objects whose fingerprints are unchanged
+		on both sides. This greatly speeds up repeated diffs over mostly unchanged databases */
+		static void setFingerprintCacheEnabled(bool value);
+
+		//! \brief Returns true when the persistent fingerprint cache is enabled
+		static bool isFingerprintCacheEnabled();
+
+		/*! \brief Enables the direct fingerprint comparison mode. In this mode a pair of objects
+		whose content fingerprints match is immediately considered equal, pruning it from the deep
+		comparison. Differently from the persistent cache above, no previous diff run is required:
+		matching fingerprints mean definitions generated from identical XML contents, which is the
+		case when both sides of the diff are models loaded from files (see PgModelerCliApp) */
+		static void setDirectFingerprintComparison(bool value);
+
+		/*! \brief Toggles the streaming mode. When enabled the diff script is not accumulated in
+		the internal buffer anymore (getDiffDefinition() returns an empty string), instead each
+		chunk of code is emitted through s_diffCodeGenerated() as soon as its section is resolved,
+		keeping the memory usage flat even for huge scripts. The chunks concatenated in emission
+		order form the complete script */
+		void setStreamingMode(bool value);
+
+		//! \brief Returns true when the streaming mode is enabled
+		bool isStreamingModeEnabled();
+
+		/*! \brief Defines an optional device (e.g. an open file) to which the diff code chunks are
+		written in streaming mode. The device must be opened for writing by the caller */
+		void setOutputDevice(QIODevice *device);
+
+		/*! \brief Defines how far the diff process goes (see Compare??? constants). The modes other
+		than CompareFull produce no SQL code; they only feed the diff info signals and counters and
+		the hasDifferences() flag, which is all a drift detection probe needs */
+		void setCompareMode(unsigned mode);
+
+		/*! \brief Returns true when the current/last diff detected at least one difference
+		(create, drop or alter). The flag persists until a new diff is started */
+		bool hasDifferences();
+
 		//! \brief Toggles a diff option throught the OPT_xxx constants
 		void setDiffOption(unsigned opt_id, bool value);
 
@@ -189,7 +359,8 @@ class ModelsDiffHelper: public QObject {
 		//! \brief Reset all the diff info counters in order to restart the diff process
 		void resetDiffCounter();
 
-		//! \brief Returns the diff containing all the SQL commands needed to synchronize the model and database
+		/*! \brief Returns the diff containing all the SQL commands needed to synchronize the model and database.
+		In streaming mode an empty string is returned since the code is emitted through s_diffCodeGenerated() */
 		QString getDiffDefinition();
 
 	public slots:
@@ -211,6 +382,10 @@ class ModelsDiffHelper: public QObject {
 
 		//! \brief This signal is emitted when a diff info is generated
 		void s_objectsDiffInfoGenerated(ObjectsDiffInfo diff_info);
+
+		/*! \brief This signal is emitted in streaming mode for each chunk of diff code generated.
+		The chunks concatenated in emission order form the complete diff script */
+		void s_diffCodeGenerated(QString code);
 };
 
 #endif
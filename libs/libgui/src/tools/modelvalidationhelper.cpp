@@ -17,13 +17,33 @@
 */
 
 #include "modelvalidationhelper.h"
+#include <QtConcurrent/QtConcurrent>
+#include <atomic>
+#include <algorithm>
+
+unsigned ModelValidationHelper::validation_threads=std::min(static_cast<unsigned>(QThread::idealThreadCount()), ModelValidationHelper::MaxValidationThreads);
+
+void ModelValidationHelper::setValidationThreads(unsigned thread_count)
+{
+	if(thread_count==0)
+		thread_count=1;
+	else if(thread_count > MaxValidationThreads)
+		thread_count=MaxValidationThreads;
+
+	validation_threads=thread_count;
+}
+
+unsigned ModelValidationHelper::getValidationThreads()
+{
+	return validation_threads;
+}
 
 ModelValidationHelper::ModelValidationHelper()
 {
 	warn_count=error_count=progress=0;
 	db_model=nullptr;
 	conn=nullptr;
-	valid_canceled=fix_mode=use_tmp_names=false;
+	valid_canceled=fix_mode=use_tmp_names=full_pass_done=quiet_pass=false;
 
 	export_thread=new QThread;
 	export_helper.moveToThread(export_thread);
@@ -59,7 +79,183 @@ void ModelValidationHelper::generateValidationInfo(unsigned val_type, BaseObject
 			inv_rels.push_back(object);
 
 		//Emit the signal containing the info
-		emit s_validationInfoGenerated(info);
+		if(!quiet_pass)
+			emit s_validationInfoGenerated(info);
+	}
+}
+
+void ModelValidationHelper::registerChangedObject(BaseObject *object)
+{
+	if(object && std::find(changed_objs.begin(), changed_objs.end(), object)==changed_objs.end())
+		changed_objs.push_back(object);
+}
+
+void ModelValidationHelper::checkBrokenReferences(BaseObject *object, vector<PendingValidationInfo> &pend_infos)
+{
+	try
+	{
+		ObjectType obj_type=object->getObjectType();
+		vector<BaseObject *> refs, refs_aux;
+		BaseObject *refer_obj=nullptr;
+		TableObject *tab_obj=nullptr;
+		PhysicalTable *table=nullptr, *ref_tab=nullptr, *recv_tab=nullptr;
+		Constraint *constr=nullptr;
+		Column *col=nullptr;
+		Relationship *rel=nullptr;
+
+		/* Special validation case: For generalization and copy relationships validates the ids of participant tables.
+			 Reference table cannot own an id greater thant receiver table */
+		if(obj_type==ObjectType::Relationship)
+		{
+			rel=dynamic_cast<Relationship *>(object);
+			if(rel->getRelationshipType()==Relationship::RelationshipGen ||
+					rel->getRelationshipType()==Relationship::RelationshipDep ||
+				 rel->getRelationshipType()==Relationship::RelationshipPart)
+			{
+				recv_tab=rel->getReceiverTable();
+				ref_tab=rel->getReferenceTable();
+
+				if(ref_tab->getObjectId() > recv_tab->getObjectId())
+				{
+					object=ref_tab;
+					refs_aux.push_back(recv_tab);
+				}
+			}
+		}
+		else
+		{
+			db_model->getObjectReferences(object, refs);
+
+			while(!refs.empty() && !valid_canceled)
+			{
+				//Checking if the referrer object is a table object. In this case its parent table is considered
+				tab_obj=dynamic_cast<TableObject *>(refs.back());
+				constr=dynamic_cast<Constraint *>(tab_obj);
+				col=dynamic_cast<Column *>(tab_obj);
+
+				/*
+				 * If the current referrer object has an id less than reference object's id
+				 * then it will be pushed into the list of invalid references.
+				 * There's an exception which is that foreign keys are completely discarded from any validation
+				 * since they are always created at end of code definition being free of any reference breaking.
+				 */
+				if(object != refs.back() &&
+					 (
+						 ((col || (constr && constr->getConstraintType() != ConstraintType::ForeignKey)) &&
+							(tab_obj->getParentTable()->getObjectId() <= object->getObjectId())) ||
+						 (!constr && !col && refs.back()->getObjectId() <= object->getObjectId()))
+					 )
+				{
+					if(col || constr)
+						refer_obj=tab_obj->getParentTable();
+					else
+						refer_obj=refs.back();
+
+					refs_aux.push_back(refer_obj);
+				}
+
+				refs.pop_back();
+			}
+
+			/* Validating a special object. The validation made here is to check if the special object
+			 * (constraint/index/trigger/view) references a column added by a relationship and
+			 *  that relationship is being created after the creation of the special object */
+			if(BaseTable::isBaseTable(obj_type) || obj_type == ObjectType::GenericSql)
+			{
+				vector<ObjectType> tab_aux_types={ ObjectType::Constraint, ObjectType::Trigger, ObjectType::Index };
+				vector<TableObject *> *tab_objs;
+				vector<Column *> ref_cols;
+				vector<BaseObject *> rels;
+				BaseObject *rel=nullptr;
+				View *view=nullptr;
+				GenericSQL *gen_sql=nullptr;
+				Constraint *constr=nullptr;
+
+				table=dynamic_cast<PhysicalTable *>(object);
+				view=dynamic_cast<View *>(object);
+				gen_sql = dynamic_cast<GenericSQL *>(object);
+
+				if(table)
+				{
+					/* Checking the table children objects if they references some columns added by relationship.
+					 * If so, the id of the relationships are swapped with the child object if the first is created
+					 * after the latter. */
+					for(auto &obj_tp : tab_aux_types)
+					{
+						tab_objs = table->getObjectList(obj_tp);
+						if(!tab_objs) continue;
+
+						for(auto &tab_obj : (*tab_objs))
+						{
+							ref_cols.clear();
+							rels.clear();
+
+							if(!tab_obj->isAddedByRelationship())
+							{
+								if(obj_tp==ObjectType::Constraint)
+								{
+									constr=dynamic_cast<Constraint *>(tab_obj);
+
+									if(constr->getConstraintType()!=ConstraintType::PrimaryKey)
+										ref_cols=constr->getRelationshipAddedColumns();
+								}
+								else if(obj_tp==ObjectType::Trigger)
+									ref_cols=dynamic_cast<Trigger *>(tab_obj)->getRelationshipAddedColumns();
+								else
+									ref_cols=dynamic_cast<Index *>(tab_obj)->getRelationshipAddedColumns();
+							}
+
+							//Getting the relationships that owns the columns
+							for(auto &ref_col : ref_cols)
+							{
+								rel=ref_col->getParentRelationship();
+								if(rel->getObjectId() > tab_obj->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
+									rels.push_back(rel);
+							}
+
+							pend_infos.push_back({ValidationInfo::SpObjBrokenReference, tab_obj, rels});
+						}
+					}
+				}
+				else if(view)
+				{
+					ref_cols=view->getRelationshipAddedColumns();
+
+					//Getting the relationships that owns the columns
+					for(auto &ref_col : ref_cols)
+					{
+						rel=ref_col->getParentRelationship();
+						if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
+							rels.push_back(rel);
+					}
+
+					pend_infos.push_back({ValidationInfo::SpObjBrokenReference, object, rels});
+				}
+				else
+				{
+					Column *col = nullptr;
+
+					for(auto &ref_obj : gen_sql->getReferencedObjects())
+					{
+						col = dynamic_cast<Column *>(ref_obj);
+						if(!col || !col->isAddedByRelationship()) continue;
+
+						rel = col->getParentRelationship();
+
+						if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel) == rels.end())
+							rels.push_back(rel);
+					}
+
+					pend_infos.push_back({ValidationInfo::SpObjBrokenReference, object, rels});
+				}
+			}
+		}
+
+		pend_infos.push_back({ValidationInfo::BrokenReference, object, refs_aux});
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
@@ -97,11 +293,13 @@ void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 						{
 							BaseObject::swapObjectsIds(info_obj, obj, true);
 							aux_obj=info_obj;
+							registerChangedObject(obj);
 							emit s_objectIdChanged(obj);
 						}
 						else if(tab_obj && tab_obj->getParentTable()==info_obj)
 						{
 							BaseObject::updateObjectId(tab_obj);
+							registerChangedObject(tab_obj);
 							emit s_objectIdChanged(tab_obj);
 						}
 					}
@@ -114,6 +312,7 @@ void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 							if(rel->getObjectId() < aux_obj->getObjectId())
 							{
 								BaseObject::updateObjectId(rel);
+								registerChangedObject(rel);
 								emit s_objectIdChanged(rel);
 							}
 						}
@@ -129,6 +328,7 @@ void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 				BaseObject::updateObjectId(info_obj);
 			}
 
+			registerChangedObject(info_obj);
 			emit s_objectIdChanged(info_obj);
 		}
 		//Resolving no unique name by renaming the constraints/indexes
@@ -200,6 +400,7 @@ void  ModelValidationHelper::resolveConflict(ValidationInfo &info)
 			extension->setSchema(db_model->getSchema("public"));
 			extension->setComment("PostGIS geometry, geography, and raster spatial types and functions");
 			db_model->addExtension(extension);
+			registerChangedObject(extension);
 		}
 	}
 	catch(Exception &e)
@@ -240,8 +441,10 @@ void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection
 
 	fix_mode=false;
 	valid_canceled=false;
+	full_pass_done=false;
 	val_infos.clear();
 	inv_rels.clear();
+	changed_objs.clear();
 	this->db_model=model;
 	this->conn=conn;
 	this->pgsql_ver=pgsql_ver;
@@ -274,198 +477,178 @@ void ModelValidationHelper::validateModel()
 				aux_types = { ObjectType::Table, ObjectType::ForeignTable, ObjectType::View },
 				tab_obj_types = { ObjectType::Constraint, ObjectType::Index };
 
-		ObjectType	obj_type;
 		unsigned i = 0, i1 = 0, cnt = 0, aux_cnt = 0,	count = 0, count1 = 0;
-		BaseObject *object=nullptr, *refer_obj=nullptr;
-		vector<BaseObject *> refs, refs_aux, *obj_list=nullptr, aux_tables;
+		BaseObject *object=nullptr;
+		vector<BaseObject *> refs, *obj_list=nullptr, aux_tables;
 		vector<BaseObject *>::iterator itr;
 		TableObject *tab_obj=nullptr;
-		PhysicalTable *table=nullptr, *ref_tab=nullptr, *recv_tab=nullptr;
+		PhysicalTable *table=nullptr;
 		BaseTable *base_tab = nullptr;
 		Constraint *constr=nullptr;
 		Column *col=nullptr;
-		Relationship *rel=nullptr;
 		map<QString, vector<BaseObject *> > dup_objects;
 		map<QString, vector<BaseObject *> >::iterator mitr;
 		QString name, signal_msg=QString("`%1' (%2)");
 		bool postgis_exists = db_model->getObjectIndex(QString("postgis"), ObjectType::Extension) >= 0;
 
+		/* An incremental pass happens only in fix mode, when the objects modified by the previously
+		 * applied fixes are known. In this case only those objects and the ones they depend on or
+		 * reference are submitted to the broken references detection, since the remaining objects
+		 * were considered valid by the last complete pass and had no ids changed since then */
+		bool incr_validation=fix_mode && full_pass_done && !changed_objs.empty();
+		vector<BaseObject *> aff_objs;
+
 		warn_count=error_count=progress=0;
 		val_infos.clear();
 		valid_canceled=false;
 
+		/* The flag is raised back only when this pass runs to completion, so a canceled or
+		 * aborted pass always forces the next one to revalidate the whole model */
+		full_pass_done=false;
+
+		if(incr_validation)
+		{
+			vector<BaseObject *> dep_objs, ref_objs;
+
+			for(auto &chg_obj : changed_objs)
+			{
+				dep_objs.clear();
+				db_model->getObjectDependecies(chg_obj, dep_objs);
+				db_model->getObjectReferences(chg_obj, ref_objs);
+				dep_objs.insert(dep_objs.end(), ref_objs.begin(), ref_objs.end());
+
+				for(auto &obj : dep_objs)
+				{
+					if(std::find(aff_objs.begin(), aff_objs.end(), obj)==aff_objs.end())
+						aff_objs.push_back(obj);
+				}
+			}
+
+			changed_objs.clear();
+		}
+
 		aux_cnt = aux_types.size();
 		count = types.size();
 		count1 = tab_obj_types.size();
 
 		/* Step 1: Validating broken references. This situation happens when a object references another
 		 which id is smaller than the id of the first one. */
-		for(i=0; i < count && !valid_canceled; i++)
+		map<BaseObject *, vector<PendingValidationInfo>> pend_infos_map;
+		vector<PendingValidationInfo> pend_infos;
+
+		/* The broken references analysis is read-only over the model, so, when more than one
+		 * validation thread is configured, it is precomputed by a thread pool. The resulting infos
+		 * are merged below following the original object traversal order, keeping the emission order
+		 * of the validation signals the same as in the serial validation */
+		if(validation_threads > 1)
 		{
-			obj_list=db_model->getObjectList(types[i]);
-			itr=obj_list->begin();
-
-			while(itr!=obj_list->end() && !valid_canceled)
+			/* The model is partitioned into per-schema shards plus a shared boundary set
+			 * (see DatabaseModel::partitionBySchema()). Each worker takes a whole shard at a
+			 * time, so the objects of a schema are analyzed by the same thread (keeping their
+			 * dependency closures warm in its cache) and the results of a shard are merged
+			 * under the mutex once instead of per object. Models with mostly independent
+			 * schemas scale near-linearly with the configured thread count */
+			vector<vector<BaseObject *>> shards;
+			vector<BaseObject *> boundary_objs;
+			QThreadPool thread_pool;
+			QList<QFuture<void>> futures;
+			QMutex result_mtx, error_mtx;
+			std::atomic<size_t> next_shard{0};
+			Exception error;
+			bool has_error=false;
+
+			db_model->partitionBySchema(shards, boundary_objs);
+			shards.push_back(boundary_objs);
+
+			//Keeping on the shards only the objects this validation step really scans
+			for(auto &shard : shards)
 			{
-				object=(*itr);
-				obj_type=object->getObjectType();
-				refs_aux.clear();
-				itr++;
+				shard.erase(std::remove_if(shard.begin(), shard.end(),
+				[&](BaseObject *obj){
+					return std::find(types.begin(), types.end(), obj->getObjectType())==types.end() ||
+								 obj->isSystemObject() ||
+								 (incr_validation && std::find(aff_objs.begin(), aff_objs.end(), obj)==aff_objs.end());
+				}), shard.end());
+			}
 
-				//Excluding the validation of system objects (created automatically)
-				if(!object->isSystemObject())
-				{
-					emit s_objectProcessed(signal_msg.arg(object->getName()).arg(object->getTypeName()), object->getObjectType());
+			thread_pool.setMaxThreadCount(validation_threads);
 
-					/* Special validation case: For generalization and copy relationships validates the ids of participant tables.
-						 Reference table cannot own an id greater thant receiver table */
-					if(obj_type==ObjectType::Relationship)
+			for(unsigned th=0; th < validation_threads; th++)
+			{
+				futures.append(QtConcurrent::run(&thread_pool,
+				[this, &shards, &next_shard, &pend_infos_map, &result_mtx, &error, &has_error, &error_mtx](){
+					size_t shard_idx=0;
+					vector<PendingValidationInfo> infos;
+					map<BaseObject *, vector<PendingValidationInfo>> shard_infos;
+
+					try
 					{
-						rel=dynamic_cast<Relationship *>(object);
-						if(rel->getRelationshipType()==Relationship::RelationshipGen ||
-								rel->getRelationshipType()==Relationship::RelationshipDep ||
-							 rel->getRelationshipType()==Relationship::RelationshipPart)
+						while((shard_idx=next_shard++) < shards.size() && !valid_canceled)
 						{
-							recv_tab=rel->getReceiverTable();
-							ref_tab=rel->getReferenceTable();
+							shard_infos.clear();
 
-							if(ref_tab->getObjectId() > recv_tab->getObjectId())
+							for(auto &object : shards[shard_idx])
 							{
-								object=ref_tab;
-								refs_aux.push_back(recv_tab);
+								if(valid_canceled)
+									break;
+
+								infos.clear();
+								checkBrokenReferences(object, infos);
+								shard_infos[object]=infos;
 							}
+
+							QMutexLocker locker(&result_mtx);
+							pend_infos_map.insert(shard_infos.begin(), shard_infos.end());
 						}
 					}
-					else
+					catch(Exception &e)
 					{
-						db_model->getObjectReferences(object, refs);
+						QMutexLocker locker(&error_mtx);
 
-						while(!refs.empty() && !valid_canceled)
+						//Only the first error is propagated to the caller
+						if(!has_error)
 						{
-							//Checking if the referrer object is a table object. In this case its parent table is considered
-							tab_obj=dynamic_cast<TableObject *>(refs.back());
-							constr=dynamic_cast<Constraint *>(tab_obj);
-							col=dynamic_cast<Column *>(tab_obj);
-
-							/*
-							 * If the current referrer object has an id less than reference object's id
-							 * then it will be pushed into the list of invalid references.
-							 * There's an exception which is that foreign keys are completely discarded from any validation
-							 * since they are always created at end of code definition being free of any reference breaking.
-							 */
-							if(object != refs.back() &&
-								 (
-									 ((col || (constr && constr->getConstraintType() != ConstraintType::ForeignKey)) &&
-										(tab_obj->getParentTable()->getObjectId() <= object->getObjectId())) ||
-									 (!constr && !col && refs.back()->getObjectId() <= object->getObjectId()))
-								 )
-							{
-								if(col || constr)
-									refer_obj=tab_obj->getParentTable();
-								else
-									refer_obj=refs.back();
-
-								refs_aux.push_back(refer_obj);
-							}
-
-							refs.pop_back();
+							error=Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+							has_error=true;
 						}
+					}
+				}));
+			}
 
-						/* Validating a special object. The validation made here is to check if the special object
-						 * (constraint/index/trigger/view) references a column added by a relationship and
-						 *  that relationship is being created after the creation of the special object */
-						if(BaseTable::isBaseTable(obj_type) || obj_type == ObjectType::GenericSql)
-						{
-							vector<ObjectType> tab_aux_types={ ObjectType::Constraint, ObjectType::Trigger, ObjectType::Index };
-							vector<TableObject *> *tab_objs;
-							vector<Column *> ref_cols;
-							vector<BaseObject *> rels;
-							BaseObject *rel=nullptr;
-							View *view=nullptr;
-							GenericSQL *gen_sql=nullptr;
-							Constraint *constr=nullptr;
-
-							table=dynamic_cast<PhysicalTable *>(object);
-							view=dynamic_cast<View *>(object);
-							gen_sql = dynamic_cast<GenericSQL *>(object);
-
-							if(table)
-							{
-								/* Checking the table children objects if they references some columns added by relationship.
-								 * If so, the id of the relationships are swapped with the child object if the first is created
-								 * after the latter. */
-								for(auto &obj_tp : tab_aux_types)
-								{
-									tab_objs = table->getObjectList(obj_tp);
-									if(!tab_objs) continue;
-
-									for(auto &tab_obj : (*tab_objs))
-									{
-										ref_cols.clear();
-										rels.clear();
-
-										if(!tab_obj->isAddedByRelationship())
-										{
-											if(obj_tp==ObjectType::Constraint)
-											{
-												constr=dynamic_cast<Constraint *>(tab_obj);
-
-												if(constr->getConstraintType()!=ConstraintType::PrimaryKey)
-													ref_cols=constr->getRelationshipAddedColumns();
-											}
-											else if(obj_tp==ObjectType::Trigger)
-												ref_cols=dynamic_cast<Trigger *>(tab_obj)->getRelationshipAddedColumns();
-											else
-												ref_cols=dynamic_cast<Index *>(tab_obj)->getRelationshipAddedColumns();
-										}
-
-										//Getting the relationships that owns the columns
-										for(auto &ref_col : ref_cols)
-										{
-											rel=ref_col->getParentRelationship();
-											if(rel->getObjectId() > tab_obj->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
-												rels.push_back(rel);
-										}
-
-										generateValidationInfo(ValidationInfo::SpObjBrokenReference, tab_obj, rels);
-									}
-								}
-							}
-							else if(view)
-							{
-								ref_cols=view->getRelationshipAddedColumns();
+			for(auto &future : futures)
+				future.waitForFinished();
 
-								//Getting the relationships that owns the columns
-								for(auto &ref_col : ref_cols)
-								{
-									rel=ref_col->getParentRelationship();
-									if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
-										rels.push_back(rel);
-								}
-
-								generateValidationInfo(ValidationInfo::SpObjBrokenReference, object, rels);
-							}
-							else
-							{
-								Column *col = nullptr;
+			if(has_error)
+				throw error;
+		}
 
-								for(auto &ref_obj : gen_sql->getReferencedObjects())
-								{
-									col = dynamic_cast<Column *>(ref_obj);
-									if(!col || !col->isAddedByRelationship()) continue;
+		for(i=0; i < count && !valid_canceled; i++)
+		{
+			obj_list=db_model->getObjectList(types[i]);
+			itr=obj_list->begin();
 
-									rel = col->getParentRelationship();
+			while(itr!=obj_list->end() && !valid_canceled)
+			{
+				object=(*itr);
+				itr++;
 
-									if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel) == rels.end())
-										rels.push_back(rel);
-								}
+				/* Excluding the validation of system objects (created automatically) and, on
+				 * incremental passes, of the objects not affected by the applied fixes */
+				if(!object->isSystemObject() &&
+					 (!incr_validation || std::find(aff_objs.begin(), aff_objs.end(), object)!=aff_objs.end()))
+				{
+					emit s_objectProcessed(signal_msg.arg(object->getName()).arg(object->getTypeName()), object->getObjectType());
 
-								generateValidationInfo(ValidationInfo::SpObjBrokenReference, object, rels);
-							}
-						}
+					if(validation_threads > 1)
+						pend_infos=pend_infos_map[object];
+					else
+					{
+						pend_infos.clear();
+						checkBrokenReferences(object, pend_infos);
 					}
 
-					generateValidationInfo(ValidationInfo::BrokenReference, object, refs_aux);
+					for(auto &pend_info : pend_infos)
+						generateValidationInfo(pend_info.val_type, pend_info.object, pend_info.refs);
 				}
 			}
 
@@ -604,6 +787,8 @@ void ModelValidationHelper::validateModel()
 			}
 		}
 
+		full_pass_done=!valid_canceled;
+
 		if(!valid_canceled && !fix_mode)
 		{
 			//Step 3 (optional): Validating the SQL code onto a local DBMS.
@@ -664,8 +849,26 @@ void ModelValidationHelper::applyFixes()
 
 			emit s_fixApplied();
 
+			/* The revalidations between the fix rounds are executed silently: the infos generated
+			 * by an intermediate pass are immediately consumed by the next round, so emitting them
+			 * would only make the GUI repeatedly fill and clear the validation output. The infos
+			 * pending at the end of the session are emitted below in a single shot */
 			if(!valid_canceled && !found_broken_rels)
+			{
+				quiet_pass=true;
 				validateModel();
+				quiet_pass=false;
+			}
+		}
+
+		/* Emitting the infos left by the last silent pass (e.g. when a broken relationship
+		 * interrupted the fix session) so the GUI reflects the final validation state */
+		for(auto &info : val_infos)
+		{
+			if(valid_canceled)
+				break;
+
+			emit s_validationInfoGenerated(info);
 		}
 
 		if(!valid_canceled && (found_broken_rels || val_infos.empty()))
@@ -35,6 +35,17 @@ class ModelValidationHelper: public QObject {
 	private:
 		Q_OBJECT
 
+		/*! \brief Amount of threads used to run the broken references detection in parallel.
+		See setValidationThreads() */
+		static unsigned validation_threads;
+
+		//! \brief Auxiliary structure that holds a validation info detected by a worker thread before being merged
+		struct PendingValidationInfo {
+			unsigned val_type;
+			BaseObject *object;
+			vector<BaseObject *> refs;
+		};
+
 		//! \brief Reference database model
 		DatabaseModel *db_model;
 
@@ -61,7 +72,12 @@ class ModelValidationHelper: public QObject {
 		//! \brief Indicates if the validation is on fix mode.
 		fix_mode,
 
-		use_tmp_names;
+		use_tmp_names,
+
+		/*! \brief When true the validation infos generated by validateModel() are not emitted through
+		s_validationInfoGenerated(). This is used by applyFixes() to run the intermediate passes of a
+		fix session silently, updating the GUI only when the session reaches its final state */
+		quiet_pass;
 
 		/*! \brief Stores the validation infos generated during validation steps.
 		This vector is read when applying fixes */
@@ -70,12 +86,40 @@ class ModelValidationHelper: public QObject {
 		//! \brief Stores the analyzed relationship marked as invalidated
 		vector<BaseObject *> inv_rels;
 
+		/*! \brief Stores the objects modified by the fixes applied since the last validation pass.
+		When the last pass was completely executed, the next one triggered in fix mode revalidates
+		only these objects and the ones they reference (see validateModel()) */
+		vector<BaseObject *> changed_objs;
+
+		//! \brief Indicates that the last broken references detection pass was completely executed
+		bool full_pass_done;
+
 		void generateValidationInfo(unsigned val_type, BaseObject *object, vector<BaseObject *> refs);
 
+		/*! \brief Performs, for a single object, the broken references analysis executed by the first
+		step of validateModel(), appending the detected issues to pend_infos instead of generating
+		validation infos directly. The analysis is read-only over the model, so it can be safely
+		executed by several threads as long as each object is handled by a single worker */
+		void checkBrokenReferences(BaseObject *object, vector<PendingValidationInfo> &pend_infos);
+
+		/*! \brief Registers an object modified by the conflict resolution so the next validation pass
+		triggered in fix mode revalidates only the affected objects instead of the whole model */
+		void registerChangedObject(BaseObject *object);
+
 	public:
+		//! \brief Maximum amount of threads accepted by the parallel validation
+		static constexpr unsigned MaxValidationThreads=16;
+
 		ModelValidationHelper();
 		virtual ~ModelValidationHelper();
 
+		/*! \brief Defines the amount of threads used to detect broken references in parallel.
+		Zero is treated as one (serial validation) and values above MaxValidationThreads are truncated.
+		By default the amount of threads is the one reported by QThread::idealThreadCount() */
+		static void setValidationThreads(unsigned thread_count);
+
+		static unsigned getValidationThreads();
+
 		/*! \brief Validates the specified model. If a connection is specifies executes the
 		SQL validation directly on DBMS */
 		void setValidationParams(DatabaseModel *model, Connection *conn=nullptr, const QString &pgsql_ver="", bool use_tmp_names=false);
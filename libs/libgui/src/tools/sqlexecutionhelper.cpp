@@ -21,7 +21,6 @@
 SQLExecutionHelper::SQLExecutionHelper() : QObject(nullptr)
 {
 	cancelled = false;
-	result_model = nullptr;
 }
 
 void SQLExecutionHelper::setConnection(Connection conn)
@@ -34,11 +33,6 @@ void SQLExecutionHelper::setCommand(const QString &cmd)
 	command = cmd;
 }
 
-ResultSetModel *SQLExecutionHelper::getResultSetModel()
-{
-	return result_model;
-}
-
 bool SQLExecutionHelper::isCancelled()
 {
 	return cancelled;
@@ -56,9 +50,11 @@ void SQLExecutionHelper::executeCommand()
 		ResultSet res;
 		Catalog catalog;
 		Connection aux_conn = Connection(connection.getConnectionParams());
+		int rows_affected = 0, fetched_rows = 0, buff_rows = 0, col = 0, col_cnt = 0;
+		QStringList buffer;
+		bool res_started = false;
 
 		catalog.setConnection(aux_conn);
-		result_model = nullptr;
 		cancelled = false;
 
 		if(!connection.isStablished())
@@ -70,13 +66,90 @@ void SQLExecutionHelper::executeCommand()
 			connection.setSQLExecutionTimout(3600);
 		}
 
-		connection.executeDMLCommand(command, res);
-		notices = connection.getNotices();
+		/* Dispatching the command in single-row mode so huge resultsets are consumed
+		 * incrementally instead of being fully materialized by libpq before the first
+		 * row can be accessed */
+		connection.sendDMLCommand(command, true);
+
+		while(connection.getNextAsyncResult(res))
+		{
+			rows_affected += res.getTupleCount();
+
+			//Commands that return no tuples (INSERT, DELETE, CREATE, ...) produce no result model
+			if(res.isEmpty())
+				continue;
+
+			/* Upon the arrival of the first row the columns description is notified so the receiver
+			 * can set up the (still empty) result model that'll receive the batches of rows below */
+			if(!res_started)
+			{
+				vector<unsigned> type_ids;
+				vector<unsigned>::iterator end;
+				vector<attribs_map> types;
+				map<unsigned, QString> type_names_map;
+				QStringList col_names, type_names;
+				unsigned orig_filter = catalog.getQueryFilter();
+
+				col_cnt = res.getColumnCount();
+
+				for(col = 0; col < col_cnt; col++)
+				{
+					col_names.append(res.getColumnName(col));
+					type_ids.push_back(res.getColumnTypeId(col));
+				}
 
-		if(!res.isEmpty())
-			result_model = new ResultSetModel(res, catalog);
+				catalog.setQueryFilter(Catalog::ListAllObjects);
+				std::sort(type_ids.begin(), type_ids.end());
+				end = std::unique(type_ids.begin(), type_ids.end());
+				type_ids.erase(end, type_ids.end());
 
-		emit s_executionFinished(res.getTupleCount());
+				types = catalog.getObjectsAttributes(ObjectType::Type, "", "", type_ids);
+
+				for(auto &tp : types)
+					type_names_map[tp[Attributes::Oid].toUInt()] = tp[Attributes::Name];
+
+				for(col = 0; col < col_cnt; col++)
+					type_names.append(type_names_map[res.getColumnTypeId(col)]);
+
+				catalog.setQueryFilter(orig_filter);
+				emit s_resultSetStarted(col_names, type_names);
+				res_started = true;
+			}
+
+			if(res.accessTuple(ResultSet::FirstTuple))
+			{
+				do
+				{
+					for(col = 0; col < col_cnt; col++)
+					{
+						if(col >= res.getColumnCount())
+							buffer.append("");
+						else if(res.isColumnBinaryFormat(col))
+							buffer.append(tr("[binary data]"));
+						else
+							buffer.append(res.getColumnValue(col));
+					}
+
+					fetched_rows++;
+					buff_rows++;
+
+					if(buff_rows >= RowsFetchBatchSize)
+					{
+						emit s_rowsFetched(buffer, fetched_rows);
+						buffer.clear();
+						buff_rows = 0;
+					}
+				}
+				while(res.accessTuple(ResultSet::NextTuple));
+			}
+		}
+
+		//Flushing the remaining rows that didn't complete a batch
+		if(!buffer.isEmpty())
+			emit s_rowsFetched(buffer, fetched_rows);
+
+		notices = connection.getNotices();
+		emit s_executionFinished(rows_affected);
 	}
 	catch(Exception &e)
 	{
@@ -28,18 +28,20 @@
 #include <QObject>
 #include <QTableWidget>
 #include "connection.h"
-#include "utils/resultsetmodel.h"
+#include "catalog.h"
 
 class SQLExecutionHelper : public QObject {
 	private:
 		Q_OBJECT
 
+		/*! \brief Amount of rows accumulated before a batch is emitted through s_rowsFetched().
+		The batching avoids flooding the main thread with one queued signal per streamed row */
+		static constexpr int RowsFetchBatchSize=1000;
+
 		Connection connection;
 
 		QString command;
 
-		ResultSetModel *result_model;
-
 		bool cancelled;
 
 		int affected_rows;
@@ -53,9 +55,6 @@ class SQLExecutionHelper : public QObject {
 
 		void setCommand(const QString &cmd);
 
-		//! \brief Returns the result set model created in the execution. This object is not deleted after the execution.
-		ResultSetModel *getResultSetModel();
-
 		bool isCancelled();
 
 		//! \brief Returns the notices generated by the execution
@@ -68,6 +67,14 @@ class SQLExecutionHelper : public QObject {
 	signals:
 		void s_executionFinished(int rows_affected);
 		void s_executionAborted(Exception e);
+
+		/*! \brief Emitted upon the arrival of the first resultset row carrying the columns description
+		(names and type names) so the receiver can set up an empty result model to be filled in batches */
+		void s_resultSetStarted(QStringList col_names, QStringList type_names);
+
+		/*! \brief Emitted whenever a batch of rows is fetched from the server. The values are packed
+		row by row (one entry per column) and total_rows holds the amount of rows fetched so far */
+		void s_rowsFetched(QStringList values, int total_rows);
 };
 
 #endif
@@ -25,8 +25,8 @@
 #include "datamanipulationform.h"
 #include "qtcompat/qplaintexteditcompat.h"
 #include "utilsns.h"
-
-map<QString, QString> SQLExecutionWidget::cmd_history;
+#include "sqlhistorystore.h"
+#include <QInputDialog>
 
 int SQLExecutionWidget::cmd_history_max_len = 1000;
 const QString SQLExecutionWidget::ColumnNullValue("␀");
@@ -35,6 +35,8 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 {
 	setupUi(this);
 
+	last_hist_id=0;
+
 	sql_cmd_txt=GuiUtilsNs::createNumberedTextEditor(sql_cmd_wgt);
 	cmd_history_txt=GuiUtilsNs::createNumberedTextEditor(cmd_history_parent);
 	cmd_history_txt->setCustomContextMenuEnabled(false);
@@ -164,6 +166,8 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 
 	connect(&sql_exec_thread, SIGNAL(started()), &sql_exec_hlp, SLOT(executeCommand()));
 	connect(&sql_exec_hlp, SIGNAL(s_executionFinished(int)), this, SLOT(finishExecution(int)));
+	connect(&sql_exec_hlp, SIGNAL(s_resultSetStarted(QStringList,QStringList)), this, SLOT(configureResultsGrid(QStringList,QStringList)));
+	connect(&sql_exec_hlp, SIGNAL(s_rowsFetched(QStringList,int)), this, SLOT(appendFetchedRows(QStringList,int)));
 	connect(&sql_exec_hlp, SIGNAL(s_executionAborted(Exception)), &sql_exec_thread, SLOT(quit()));
 	connect(&sql_exec_hlp, SIGNAL(s_executionAborted(Exception)), this, SLOT(handleExecutionAborted(Exception)));
 	connect(stop_tb, SIGNAL(clicked(bool)), &sql_exec_hlp, SLOT(cancelCommand()), Qt::DirectConnection);
@@ -198,12 +202,17 @@ bool SQLExecutionWidget::eventFilter(QObject *object, QEvent *event)
 	}
 	else if(event->type() == QEvent::Show && object == output_tbw->widget(2))
 	{
-		if(cmd_history_txt->toPlainText().count(QChar('\n')) !=
-			 cmd_history[sql_cmd_conn.getConnectionId(true,true)].count(QChar('\n')))
+		/* The history pane is (re)filled lazily, only when the newest stored entry differs
+		 * from the newest displayed one. Only the most recent page of the history is loaded,
+		 * the remaining entries stay in the storage */
+		qint64 latest_id=SQLHistoryStore::getLatestId(sql_cmd_conn.getConnectionId(true,true));
+
+		if(last_hist_id != latest_id)
 		{
 			cmd_history_txt->clear();
-			cmd_history_txt->appendPlainText(cmd_history[sql_cmd_conn.getConnectionId(true,true)]);
+			cmd_history_txt->appendPlainText(SQLHistoryStore::getRecentCommands(sql_cmd_conn.getConnectionId(true,true)));
 			cmd_history_txt->updateLineNumbers();
+			last_hist_id=latest_id;
 		}
 
 		return true;
@@ -313,16 +322,26 @@ void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTab
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
-			results_tbw->setRowCount(res.getTupleCount());
+			int tup_cnt=res.getTupleCount();
+			QStringList values;
+			bool binary_col=false;
 
-			do
+			results_tbw->setRowCount(tup_cnt);
+
+			/* The grid is filled column by column so the values of each column are extracted
+			 * from the resultset in a single bulk pass (see ResultSet::getColumnValues) */
+			for(col=0; col < col_cnt; col++)
 			{
-				//Fills the current row with the values of current tuple
-				for(col=0; col < col_cnt; col++)
+				binary_col=res.isColumnBinaryFormat(col);
+
+				if(!binary_col)
+					res.getColumnValues(col, values);
+
+				for(row=0; row < tup_cnt; row++)
 				{
 					item=new QTableWidgetItem;
 
-					if(res.isColumnBinaryFormat(col))
+					if(binary_col)
 					{
 						//Binary columns can't be edited by user
 						item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
@@ -330,22 +349,149 @@ void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTab
 					}
 					else
 					{
-						item->setText(res.getColumnValue(col));
+						item->setText(values[row]);
 
 						/* When storing column values in the QTableWidget items we need distinguish empty from null values
 						 * Since it may affect the generation of SQL like delete when the field value is used somehow (see DataManipulationForm::getDMLCommand) */
 						if(store_data)
-							item->setData(Qt::UserRole, res.isColumnValueNull(col) ? ColumnNullValue : item->text());
+							item->setData(Qt::UserRole, values[row].isNull() ? ColumnNullValue : values[row]);
 					}
 
 					results_tbw->setItem(row, col, item);
 				}
+			}
 
-				//Configure the vertical header to show the current tuple id
+			//Configure the vertical header to show the tuple ids
+			for(row=0; row < tup_cnt; row++)
 				results_tbw->setVerticalHeaderItem(row, new QTableWidgetItem(QString::number(row + 1)));
-				row++;
+		}
+
+		results_tbw->setUpdatesEnabled(true);
+		results_tbw->blockSignals(false);
+		results_tbw->resizeColumnsToContents();
+		results_tbw->resizeRowsToContents();
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void SQLExecutionWidget::fillResultsTable(Catalog &catalog, Connection &conn, QTableWidget *results_tbw, bool store_data, bool append)
+{
+	if(!results_tbw)
+		throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	try
+	{
+		int col=0, row=0, col_cnt=results_tbw->columnCount();
+		bool columns_configured=(append && col_cnt > 0);
+		QTableWidgetItem *item=nullptr;
+		ResultSet res;
+
+		if(!append)
+			results_tbw->setRowCount(0);
+		results_tbw->verticalHeader()->setVisible(true);
+		results_tbw->setSortingEnabled(false);
+		results_tbw->blockSignals(true);
+		results_tbw->setUpdatesEnabled(false);
+
+		while(conn.getNextAsyncResult(res))
+		{
+			if(res.isEmpty())
+				continue;
+
+			/* The grid columns are configured once, upon the arrival of the first partial
+			resultset, since all of them share the same resultset description */
+			if(!columns_configured)
+			{
+				vector<unsigned> type_ids;
+				vector<unsigned>::iterator end;
+				vector<attribs_map> types;
+				map<unsigned, QString> type_names;
+				unsigned orig_filter=catalog.getQueryFilter();
+
+				col_cnt=res.getColumnCount();
+				results_tbw->setColumnCount(col_cnt);
+
+				//Configuring the grid columns with the names of retrived table columns
+				for(col=0; col < col_cnt; col++)
+				{
+					type_ids.push_back(res.getColumnTypeId(col));
+					item=new QTableWidgetItem(res.getColumnName(col));
+					item->setTextAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+					results_tbw->setHorizontalHeaderItem(col, item);
+				}
+
+				//Retrieving the data type names for each column
+				catalog.setQueryFilter(Catalog::ListAllObjects);
+				std::sort(type_ids.begin(), type_ids.end());
+				end=std::unique(type_ids.begin(), type_ids.end());
+				type_ids.erase(end, type_ids.end());
+
+				types=catalog.getObjectsAttributes(ObjectType::Type, "", "", type_ids);
+
+				for(auto &tp : types)
+					type_names[tp[Attributes::Oid].toUInt()]=tp[Attributes::Name];
+
+				catalog.setQueryFilter(orig_filter);
+
+				//Assinging the type names as tooltip on header items
+				for(col=0; col < col_cnt; col++)
+				{
+					item=results_tbw->horizontalHeaderItem(col);
+					item->setToolTip(type_names[res.getColumnTypeId(col)]);
+					item->setData(Qt::UserRole, type_names[res.getColumnTypeId(col)]);
+				}
+
+				columns_configured=true;
+			}
+
+			if(res.accessTuple(ResultSet::FirstTuple))
+			{
+				int base_row=results_tbw->rowCount(), tup_cnt=res.getTupleCount();
+				QStringList values;
+				bool binary_col=false;
+
+				results_tbw->setRowCount(base_row + tup_cnt);
+
+				/* The rows of the current partial resultset are filled column by column so the
+				 * values of each column are extracted in a single bulk pass (see ResultSet::getColumnValues) */
+				for(col=0; col < col_cnt; col++)
+				{
+					binary_col=res.isColumnBinaryFormat(col);
+
+					if(!binary_col)
+						res.getColumnValues(col, values);
+
+					for(row=0; row < tup_cnt; row++)
+					{
+						item=new QTableWidgetItem;
+
+						if(binary_col)
+						{
+							//Binary columns can't be edited by user
+							item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+							item->setText(tr("[binary data]"));
+						}
+						else
+						{
+							item->setText(values[row]);
+
+							/* When storing column values in the QTableWidget items we need distinguish empty from null values
+							 * Since it may affect the generation of SQL like delete when the field value is used somehow (see DataManipulationForm::getDMLCommand) */
+							if(store_data)
+								item->setData(Qt::UserRole, values[row].isNull() ? ColumnNullValue : values[row]);
+						}
+
+						results_tbw->setItem(base_row + row, col, item);
+					}
+				}
+
+				//Configure the vertical header to show the tuple ids
+				for(row=0; row < tup_cnt; row++)
+					results_tbw->setVerticalHeaderItem(base_row + row, new QTableWidgetItem(QString::number(base_row + row + 1)));
 			}
-			while(res.accessTuple(ResultSet::NextTuple));
 		}
 
 		results_tbw->setUpdatesEnabled(true);
@@ -355,6 +501,8 @@ void SQLExecutionWidget::fillResultsTable(Catalog &catalog, ResultSet &res, QTab
 	}
 	catch(Exception &e)
 	{
+		results_tbw->setUpdatesEnabled(true);
+		results_tbw->blockSignals(false);
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
@@ -399,33 +547,13 @@ void SQLExecutionWidget::finishExecution(int rows_affected)
 	else
 	{
 		bool empty = false;
-		ResultSetModel *res_model = sql_exec_hlp.getResultSetModel();
+		ResultSetModel *res_model = dynamic_cast<ResultSetModel *>(results_tbw->model());
 
 		end_exec=QDateTime::currentDateTime().toMSecsSinceEpoch();
 		total_exec = end_exec - start_exec;
 
 		results_tbw->setSortingEnabled(false);
-		results_tbw->blockSignals(true);
-		results_tbw->setUpdatesEnabled(false);
-
-		destroyResultModel();
-
-		results_tbw->setModel(res_model);
 		results_tbw->resizeColumnsToContents();
-		results_tbw->setUpdatesEnabled(true);
-		results_tbw->blockSignals(false);
-
-		filter_edt->blockSignals(true);
-		filter_edt->clear();
-		filter_edt->blockSignals(false);
-
-		columns_cmb->blockSignals(true);
-		columns_cmb->clear();
-
-		for(int col = 0; res_model && col < res_model->columnCount(QModelIndex()); col++)
-			columns_cmb->addItem(res_model->headerData(col, Qt::Horizontal, Qt::DisplayRole).toString());
-
-		columns_cmb->blockSignals(false);
 
 		addToSQLHistory(sql_cmd_txt->toPlainText(), rows_affected);
 
@@ -470,6 +598,45 @@ void SQLExecutionWidget::finishExecution(int rows_affected)
 	sql_exec_thread.quit();
 }
 
+void SQLExecutionWidget::configureResultsGrid(QStringList col_names, QStringList type_names)
+{
+	/* The model is created empty in the main thread and attached right away to the grid, thus the
+	 * batches of rows streamed by the execution helper (see appendFetchedRows) show up while the
+	 * command still runs instead of only after the whole resultset is fetched */
+	ResultSetModel *res_model = new ResultSetModel(col_names, type_names);
+
+	destroyResultModel();
+	results_tbw->setSortingEnabled(false);
+	results_tbw->setModel(res_model);
+
+	filter_edt->blockSignals(true);
+	filter_edt->clear();
+	filter_edt->blockSignals(false);
+
+	columns_cmb->blockSignals(true);
+	columns_cmb->clear();
+	columns_cmb->addItems(col_names);
+	columns_cmb->blockSignals(false);
+
+	output_tbw->setTabEnabled(0, true);
+	output_tbw->setTabText(0, tr("Results"));
+	results_parent->setVisible(true);
+	output_tbw->setCurrentIndex(0);
+}
+
+void SQLExecutionWidget::appendFetchedRows(QStringList values, int total_rows)
+{
+	ResultSetModel *res_model = dynamic_cast<ResultSetModel *>(results_tbw->model());
+
+	if(!res_model)
+		return;
+
+	res_model->appendRows(values);
+
+	//Keeping the user informed about the amount of rows retrieved so far
+	output_tbw->setTabText(0, tr("Results (%1)").arg(total_rows));
+}
+
 void SQLExecutionWidget::filterResults()
 {
 	QModelIndexList list;
@@ -532,37 +699,11 @@ void SQLExecutionWidget::addToSQLHistory(const QString &cmd, unsigned rows, cons
 		if(!fmt_cmd.trimmed().endsWith(Attributes::DdlEndToken))
 			fmt_cmd += Attributes::DdlEndToken + QChar('\n');
 
-		SQLExecutionWidget::validateSQLHistoryLength(sql_cmd_conn.getConnectionId(true,true), fmt_cmd, cmd_history_txt);
-	}
-}
-
-void SQLExecutionWidget::validateSQLHistoryLength(const QString &conn_id, const QString &fmt_cmd, NumberedTextEditor *cmd_history_txt)
-{
-	QString cmds;
-	int ln_count = 0;
-
-	cmds = cmd_history[conn_id];
-	ln_count = cmds.count(QChar('\n'));
-	ln_count += fmt_cmd.count(QChar('\n'));
-
-	if(ln_count > cmd_history_max_len)
-	{
-		QStringList buffer = cmds.split(QChar('\n'));
-		cmds = buffer.mid(buffer.size()/2).join(QChar('\n'));
-		cmds = cmds.mid(cmds.indexOf(Attributes::DdlEndToken) + Attributes::DdlEndToken.length());
-		cmd_history[conn_id] = cmds.trimmed();
-
-		if(cmd_history_txt)
-		{
-			cmd_history_txt->clear();
-			cmd_history_txt->appendPlainText(cmds);
-		}
-	}
-
-	cmd_history[conn_id].append(fmt_cmd);
-
-	if(cmd_history_txt)
+		/* The entry is persisted right away so nothing is lost on a crash,
+		 * the displayed pane is just kept in sync by appending the same chunk */
+		last_hist_id=SQLHistoryStore::addCommand(sql_cmd_conn.getConnectionId(true,true), fmt_cmd);
 		cmd_history_txt->appendPlainText(fmt_cmd);
+	}
 }
 
 void SQLExecutionWidget::switchToExecutionMode(bool value)
@@ -618,6 +759,11 @@ void SQLExecutionWidget::runSQLCommand()
 		cmd.replace(QChar::ParagraphSeparator, '\n');
 
 	msgoutput_lst->clear();
+
+	/* The previous result model is discarded beforehand since the one related to the
+	 * command being run is created/filled while the execution happens (see configureResultsGrid) */
+	destroyResultModel();
+
 	sql_exec_hlp.setCommand(cmd);
 	start_exec=QDateTime::currentDateTime().toMSecsSinceEpoch();
 	sql_exec_thread.start();
@@ -899,73 +1045,11 @@ void SQLExecutionWidget::configureSnippets()
 	code_compl_wgt->configureCompletion(nullptr, sql_cmd_hl);
 }
 
-void SQLExecutionWidget::saveSQLHistory()
-{
-	try
-	{
-		SchemaParser schparser;
-		attribs_map attribs;
-		QString commands;
-
-		for(auto hist : cmd_history)
-		{
-			attribs[Attributes::Connection] = hist.first;
-			attribs[Attributes::Commands] = hist.second;
-			schparser.ignoreEmptyAttributes(true);
-			commands += schparser.getCodeDefinition(GlobalAttributes::getTmplConfigurationFilePath(GlobalAttributes::SchemasDir,
-																																														 Attributes::Commands +
-																																														 GlobalAttributes::SchemaExt), attribs);
-		}
-
-		schparser.loadFile(GlobalAttributes::getTmplConfigurationFilePath(GlobalAttributes::SchemasDir,
-																																			GlobalAttributes::SQLHistoryConf +
-																																			GlobalAttributes::SchemaExt));
-
-		attribs.clear();
-		attribs[Attributes::Commands] = commands;
-
-		UtilsNs::saveFile(GlobalAttributes::getConfigurationFilePath(GlobalAttributes::SQLHistoryConf),
-											schparser.getCodeDefinition(attribs).toUtf8());
-	}
-	catch(Exception &e)
-	{
-		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
-	}
-}
-
 void SQLExecutionWidget::loadSQLHistory()
 {
 	try
 	{
-		XmlParser xmlparser;
-		attribs_map attribs;
-
-		xmlparser.setDTDFile(GlobalAttributes::getTmplConfigurationFilePath(GlobalAttributes::ObjectDTDDir,
-																																				GlobalAttributes::SQLHistoryConf +
-																																				GlobalAttributes::ObjectDTDExt),
-												 GlobalAttributes::SQLHistoryConf);
-
-		xmlparser.loadXMLFile(GlobalAttributes::getConfigurationFilePath(GlobalAttributes::SQLHistoryConf));
-
-		cmd_history.clear();
-
-		if(xmlparser.accessElement(XmlParser::ChildElement))
-		{
-			do
-			{
-				if(xmlparser.getElementName() == Attributes::Commands)
-				{
-					xmlparser.getElementAttributes(attribs);
-					xmlparser.savePosition();
-
-					if(xmlparser.accessElement(XmlParser::ChildElement))
-						cmd_history[attribs[Attributes::Connection]].append(xmlparser.getElementContent());
-
-					xmlparser.restorePosition();
-				}
-			}
-			while(xmlparser.accessElement(XmlParser::NextElement));
-		}
+		SQLHistoryStore::open();
 	}
 	catch(Exception &e)
 	{
@@ -981,10 +1065,7 @@ void SQLExecutionWidget::destroySQLHistory()
 								Messagebox::ConfirmIcon, Messagebox::YesNoButtons);
 
 	if(msg_box.result() == QDialog::Accepted)
-	{
-		QFile::remove(GlobalAttributes::getConfigurationFilePath(GlobalAttributes::SQLHistoryConf));
-		SQLExecutionWidget::cmd_history.clear();
-	}
+		SQLHistoryStore::destroy();
 }
 
 void SQLExecutionWidget::setSQLHistoryMaxLength(int len)
@@ -993,6 +1074,7 @@ void SQLExecutionWidget::setSQLHistoryMaxLength(int len)
 		len = 1000;
 
 	SQLExecutionWidget::cmd_history_max_len = len;
+	SQLHistoryStore::setMaxEntries(len);
 }
 
 int SQLExecutionWidget::getSQLHistoryMaxLength()
@@ -1021,7 +1103,7 @@ void SQLExecutionWidget::showHistoryContextMenu()
 {
 	QMenu *ctx_menu=cmd_history_txt->createStandardContextMenu();
 	QAction *action_clear = new QAction(QPixmap(GuiUtilsNs::getIconPath("cleartext")), tr("Clear history"), ctx_menu),
-			*action_save = new QAction(QPixmap(GuiUtilsNs::getIconPath("save")), tr("Save history"), ctx_menu),
+			*action_search = new QAction(QPixmap(GuiUtilsNs::getIconPath("findtext")), tr("Search entire history"), ctx_menu),
 			*action_reload = new QAction(QPixmap(GuiUtilsNs::getIconPath("refresh")), tr("Reload history"), ctx_menu),
 			*action_toggle_find = nullptr,
 			*exec_act = nullptr;
@@ -1033,8 +1115,8 @@ void SQLExecutionWidget::showHistoryContextMenu()
 
 	ctx_menu->addSeparator();
 	ctx_menu->addAction(action_toggle_find);
+	ctx_menu->addAction(action_search);
 	ctx_menu->addAction(action_reload);
-	ctx_menu->addAction(action_save);
 	ctx_menu->addSeparator();
 	ctx_menu->addAction(action_clear);
 
@@ -1049,18 +1131,34 @@ void SQLExecutionWidget::showHistoryContextMenu()
 
 		if(msg_box.result() == QDialog::Accepted)
 		{
+			SQLHistoryStore::clearCommands(sql_cmd_conn.getConnectionId(true,true));
+			cmd_history_txt->clear();
+			last_hist_id=0;
+		}
+	}
+	else if(exec_act == action_search)
+	{
+		bool accepted = false;
+		QString pattern = QInputDialog::getText(this, tr("Search entire history"),
+																						tr("Search for:"), QLineEdit::Normal, "", &accepted);
+
+		if(accepted && !pattern.isEmpty())
+		{
+			/* The search runs over the whole stored history, including entries beyond
+			 * the page currently displayed. Invalidating last_hist_id forces the pane
+			 * to be refilled with the recent entries the next time it is shown */
 			cmd_history_txt->clear();
-			cmd_history[sql_cmd_conn.getConnectionId(true,true)].clear();
+			cmd_history_txt->appendPlainText(SQLHistoryStore::searchCommands(sql_cmd_conn.getConnectionId(true,true), pattern));
+			cmd_history_hl->rehighlight();
+			last_hist_id=-1;
 		}
 	}
-	else if(exec_act == action_save)
-		SQLExecutionWidget::saveSQLHistory();
 	else if(exec_act == action_reload)
 	{
-		SQLExecutionWidget::loadSQLHistory();
 		cmd_history_txt->clear();
-		cmd_history_txt->appendPlainText(cmd_history[sql_cmd_conn.getConnectionId(true,true)]);
+		cmd_history_txt->appendPlainText(SQLHistoryStore::getRecentCommands(sql_cmd_conn.getConnectionId(true,true)));
 		cmd_history_hl->rehighlight();
+		last_hist_id=SQLHistoryStore::getLatestId(sql_cmd_conn.getConnectionId(true,true));
 	}
 	else if(exec_act == action_toggle_find)
 		find_history_parent->setVisible(!find_history_parent->isVisible());
@@ -40,10 +40,13 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 	private:
 		Q_OBJECT
 
-		static map<QString, QString> cmd_history;
-
 		static int cmd_history_max_len;
 
+		/*! \brief Id of the newest history entry currently displayed in the history pane.
+		Compared against SQLHistoryStore::getLatestId() to refill the pane only when the
+		stored history effectively changed */
+		qint64 last_hist_id;
+
 		qint64 start_exec, end_exec, total_exec;
 
 		SchemaParser schparser;
@@ -83,8 +86,6 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 		//! \brief Stores the command on the sql command history
 		void addToSQLHistory(const QString &cmd, unsigned rows=0, const QString &error="");
 
-		static void validateSQLHistoryLength(const QString &conn_id, const QString &fmt_cmd = "", NumberedTextEditor *cmd_history_txt = nullptr);
-
 		void switchToExecutionMode(bool value);
 
 		void destroyResultModel();
@@ -115,6 +116,13 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 				The parameter store_data will make each item store the text as its data */
 		static void fillResultsTable(Catalog &catalog, ResultSet &res, QTableWidget *results_tbw, bool store_data=false);
 
+		/*! \brief Streaming variant of fillResultsTable(): consumes the partial resultsets of a command
+		previously dispatched on the connection in single-row mode (see Connection::sendDMLCommand),
+		appending the rows to the grid as they arrive instead of requiring the whole resultset in memory.
+		When the append parameter is true the current grid contents/columns are preserved and the incoming
+		rows are appended after the existing ones (used by the on demand pagination of DataManipulationForm) */
+		static void fillResultsTable(Catalog &catalog, Connection &conn, QTableWidget *results_tbw, bool store_data=false, bool append=false);
+
 		//! \brief Copy to clipboard (in csv format) the current selected items on results grid
 		static void copySelection(QTableView *results_tbw, bool use_popup=true, bool csv_is_default = false);
 
@@ -130,10 +138,9 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 		//! \brief Exports the results to csv file
 		static void exportResults(QTableView *results_tbw);
 
-		//! \brief Save the history of all connections open in the SQL Execution to the sql-history.conf
-		static void saveSQLHistory();
-
-		//! \brief Load the history from the file sql-history.conf
+		/*! \brief Opens the SQL history storage, importing the legacy sql-history.conf file when
+		present. The history itself is persisted incrementally as the commands are executed
+		(see SQLHistoryStore) */
 		static void loadSQLHistory();
 
 		static void destroySQLHistory();
@@ -172,6 +179,13 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 
 		void finishExecution(int rows_affected = 0);
 
+		/*! \brief Creates an empty result model with the provided columns description attaching it to the
+		results grid. The model is filled in batches (see appendFetchedRows) while the command runs */
+		void configureResultsGrid(QStringList col_names, QStringList type_names);
+
+		//! \brief Appends a batch of streamed rows to the result model keeping the retrieved rows count updated
+		void appendFetchedRows(QStringList values, int total_rows);
+
 		void filterResults();
 
 		friend class SQLToolWidget;
@@ -0,0 +1,233 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "sqlhistorystore.h"
+#include "exception.h"
+#include "globalattributes.h"
+#include "attributes.h"
+#include "xmlparser.h"
+#include "qtcompat/splitbehaviorcompat.h"
+#include <QtSql/QSqlQuery>
+#include <QtSql/QSqlError>
+#include <QFile>
+
+const QString SQLHistoryStore::DbConnectionName("sql-history-store");
+int SQLHistoryStore::max_entries=1000;
+
+QSqlDatabase SQLHistoryStore::getDatabase()
+{
+	if(QSqlDatabase::contains(DbConnectionName))
+		return QSqlDatabase::database(DbConnectionName);
+
+	QSqlDatabase db=QSqlDatabase::addDatabase(QString("QSQLITE"), DbConnectionName);
+
+	db.setDatabaseName(GlobalAttributes::getConfigurationsDir() +
+										 GlobalAttributes::DirSeparator +
+										 GlobalAttributes::SQLHistoryConf + QString(".db"));
+
+	if(!db.open())
+		throw Exception(QObject::tr("Could not open the SQL history storage: %1").arg(db.lastError().text()),
+										ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	QSqlQuery qry(db);
+
+	qry.exec(QString("CREATE TABLE IF NOT EXISTS command_history( \
+										id INTEGER PRIMARY KEY, \
+										connection TEXT NOT NULL, \
+										command TEXT NOT NULL)"));
+
+	/* The (connection, id) index backs both the per-connection tail paging
+	 * and the trimming of entries exceeding the configured limit */
+	qry.exec(QString("CREATE INDEX IF NOT EXISTS idx_cmd_history_conn \
+										ON command_history(connection, id)"));
+
+	return db;
+}
+
+void SQLHistoryStore::open()
+{
+	getDatabase();
+	importLegacyHistory();
+}
+
+void SQLHistoryStore::setMaxEntries(int max)
+{
+	if(max > 0)
+		max_entries=max;
+}
+
+void SQLHistoryStore::importLegacyHistory()
+{
+	QString conf_file=GlobalAttributes::getConfigurationFilePath(GlobalAttributes::SQLHistoryConf);
+
+	if(!QFile::exists(conf_file))
+		return;
+
+	try
+	{
+		XmlParser xmlparser;
+		attribs_map attribs;
+
+		xmlparser.setDTDFile(GlobalAttributes::getTmplConfigurationFilePath(GlobalAttributes::ObjectDTDDir,
+																																				GlobalAttributes::SQLHistoryConf +
+																																				GlobalAttributes::ObjectDTDExt),
+												 GlobalAttributes::SQLHistoryConf);
+
+		xmlparser.loadXMLFile(conf_file);
+
+		if(xmlparser.accessElement(XmlParser::ChildElement))
+		{
+			do
+			{
+				if(xmlparser.getElementName() == Attributes::Commands)
+				{
+					xmlparser.getElementAttributes(attribs);
+					xmlparser.savePosition();
+
+					if(xmlparser.accessElement(XmlParser::ChildElement))
+					{
+						/* The legacy file stores the whole history of a connection as a single text blob.
+						 * Splitting it at the DDL end tokens recovers one entry per executed command */
+						QString cmds=xmlparser.getElementContent();
+
+						for(auto &cmd : cmds.split(Attributes::DdlEndToken, QtCompat::SkipEmptyParts))
+						{
+							if(!cmd.trimmed().isEmpty())
+								addCommand(attribs[Attributes::Connection], cmd.trimmed() + QChar('\n') + Attributes::DdlEndToken + QChar('\n'));
+						}
+					}
+
+					xmlparser.restorePosition();
+				}
+			}
+			while(xmlparser.accessElement(XmlParser::NextElement));
+		}
+
+		//Renaming the legacy file so the import doesn't run again on the next startup
+		QFile::rename(conf_file, conf_file + QString(".imported"));
+	}
+	catch(Exception &e)
+	{
+		/* An unreadable legacy file doesn't prevent the storage usage, the file is
+		 * kept in place so the user can recover it manually */
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+qint64 SQLHistoryStore::addCommand(const QString &conn_id, const QString &fmt_cmd)
+{
+	QSqlDatabase db=getDatabase();
+	QSqlQuery qry(db);
+
+	qry.prepare(QString("INSERT INTO command_history(connection, command) VALUES(:conn, :cmd)"));
+	qry.bindValue(QString(":conn"), conn_id);
+	qry.bindValue(QString(":cmd"), fmt_cmd);
+
+	if(!qry.exec())
+		throw Exception(QObject::tr("Could not register the command in the SQL history storage: %1").arg(qry.lastError().text()),
+										ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	qint64 new_id=qry.lastInsertId().toLongLong();
+
+	//Discarding the oldest entries that exceed the configured per-connection limit
+	qry.prepare(QString("DELETE FROM command_history WHERE connection = :conn AND id <= :max_id"));
+	qry.bindValue(QString(":conn"), conn_id);
+	qry.bindValue(QString(":max_id"), new_id - max_entries);
+	qry.exec();
+
+	return new_id;
+}
+
+QString SQLHistoryStore::getRecentCommands(const QString &conn_id)
+{
+	QSqlDatabase db=getDatabase();
+	QSqlQuery qry(db);
+	QStringList cmds;
+
+	qry.prepare(QString("SELECT command FROM command_history \
+											WHERE connection = :conn ORDER BY id DESC LIMIT :limit"));
+	qry.bindValue(QString(":conn"), conn_id);
+	qry.bindValue(QString(":limit"), max_entries);
+	qry.exec();
+
+	while(qry.next())
+		cmds.prepend(qry.value(0).toString());
+
+	return cmds.join(QChar('\n'));
+}
+
+qint64 SQLHistoryStore::getLatestId(const QString &conn_id)
+{
+	QSqlDatabase db=getDatabase();
+	QSqlQuery qry(db);
+
+	qry.prepare(QString("SELECT max(id) FROM command_history WHERE connection = :conn"));
+	qry.bindValue(QString(":conn"), conn_id);
+	qry.exec();
+
+	if(qry.next())
+		return qry.value(0).toLongLong();
+
+	return 0;
+}
+
+QString SQLHistoryStore::searchCommands(const QString &conn_id, const QString &pattern)
+{
+	QSqlDatabase db=getDatabase();
+	QSqlQuery qry(db);
+	QStringList cmds;
+
+	qry.prepare(QString("SELECT command FROM command_history \
+											WHERE connection = :conn AND command LIKE :pattern ORDER BY id"));
+	qry.bindValue(QString(":conn"), conn_id);
+	qry.bindValue(QString(":pattern"), QString("%%1%").arg(pattern));
+	qry.exec();
+
+	while(qry.next())
+		cmds.append(qry.value(0).toString());
+
+	return cmds.join(QChar('\n'));
+}
+
+void SQLHistoryStore::clearCommands(const QString &conn_id)
+{
+	QSqlDatabase db=getDatabase();
+	QSqlQuery qry(db);
+
+	qry.prepare(QString("DELETE FROM command_history WHERE connection = :conn"));
+	qry.bindValue(QString(":conn"), conn_id);
+	qry.exec();
+}
+
+void SQLHistoryStore::destroy()
+{
+	QString db_file;
+
+	if(QSqlDatabase::contains(DbConnectionName))
+	{
+		db_file=QSqlDatabase::database(DbConnectionName, false).databaseName();
+		QSqlDatabase::database(DbConnectionName, false).close();
+		QSqlDatabase::removeDatabase(DbConnectionName);
+	}
+	else
+		db_file=GlobalAttributes::getConfigurationsDir() +
+						GlobalAttributes::DirSeparator +
+						GlobalAttributes::SQLHistoryConf + QString(".db");
+
+	QFile::remove(db_file);
+}
@@ -0,0 +1,84 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libgui
+\class SQLHistoryStore
+\brief Implements the SQLite backed storage of the SQL commands history used by SQLExecutionWidget.
+The commands are appended incrementally as they are executed and read back in pages (most recent
+entries first), replacing the legacy sql-history.conf file which had to be loaded and saved wholesale.
+*/
+
+#ifndef SQL_HISTORY_STORE_H
+#define SQL_HISTORY_STORE_H
+
+#include <QtSql/QSqlDatabase>
+#include <QString>
+
+class SQLHistoryStore {
+	private:
+		//! \brief Name under which the storage connection is registered in QSqlDatabase
+		static const QString DbConnectionName;
+
+		//! \brief Maximum amount of history entries kept per connection (see addCommand())
+		static int max_entries;
+
+		/*! \brief Returns the storage handle, opening/creating the database and its
+		schema upon the first use */
+		static QSqlDatabase getDatabase();
+
+		/*! \brief Imports the contents of the legacy sql-history.conf file, when present,
+		renaming it afterwards so the import happens only once */
+		static void importLegacyHistory();
+
+	public:
+		//! \brief Opens the storage, creating it when needed, and imports the legacy history file
+		static void open();
+
+		/*! \brief Defines the maximum amount of history entries kept per connection.
+		Older entries exceeding the limit are discarded as new commands are appended */
+		static void setMaxEntries(int max);
+
+		/*! \brief Appends a formatted command chunk to the history of the specified connection,
+		discarding the oldest entries that exceed the configured limit. Returns the id assigned
+		to the new entry */
+		static qint64 addCommand(const QString &conn_id, const QString &fmt_cmd);
+
+		/*! \brief Returns the concatenation of the most recent history entries of the specified
+		connection, in chronological order, limited to the configured maximum. Older entries
+		stay on disk and are never loaded in memory */
+		static QString getRecentCommands(const QString &conn_id);
+
+		/*! \brief Returns the id of the newest history entry of the specified connection or zero
+		when the history is empty. Being an indexed lookup, this is the cheap way to detect that
+		the displayed history is outdated */
+		static qint64 getLatestId(const QString &conn_id);
+
+		/*! \brief Returns the concatenation of the history entries of the specified connection
+		containing the provided text. The search runs entirely in the storage engine so even
+		histories too big to be displayed can be searched */
+		static QString searchCommands(const QString &conn_id, const QString &pattern);
+
+		//! \brief Wipes out the history entries of the specified connection
+		static void clearCommands(const QString &conn_id);
+
+		//! \brief Closes the storage and removes the database file, wiping out the entire history
+		static void destroy();
+};
+
+#endif
@@ -132,6 +132,53 @@ void SwapObjectsIdsWidget::fillCreationOrderGrid()
 		filterObjects();
 }
 
+bool SwapObjectsIdsWidget::updateRowsAfterSwap(BaseObject *src_obj, BaseObject *dst_obj)
+{
+	int src_row=-1, dst_row=-1;
+	BaseObject *row_obj=nullptr;
+
+	for(int row=0; row < objects_tbw->rowCount() && (src_row < 0 || dst_row < 0); row++)
+	{
+		row_obj=reinterpret_cast<BaseObject *>(objects_tbw->item(row, 0)->data(Qt::UserRole).value<void *>());
+
+		if(row_obj==src_obj)
+			src_row=row;
+		else if(row_obj==dst_obj)
+			dst_row=row;
+	}
+
+	if(src_row < 0 || dst_row < 0)
+		return false;
+
+	objects_tbw->setUpdatesEnabled(false);
+
+	//Exchanging the whole rows so the grid keeps reflecting the creation order
+	for(int col=0; col < objects_tbw->columnCount(); col++)
+	{
+		QTableWidgetItem *src_item=objects_tbw->takeItem(src_row, col),
+				*dst_item=objects_tbw->takeItem(dst_row, col);
+
+		objects_tbw->setItem(src_row, col, dst_item);
+		objects_tbw->setItem(dst_row, col, src_item);
+	}
+
+	//Refreshing the id column since the objects carry their newly assigned ids now
+	if(objects_tbw->columnCount() > 2)
+	{
+		objects_tbw->item(src_row, 2)->setText(QString::number(dst_obj->getObjectId()));
+		objects_tbw->item(dst_row, 2)->setText(QString::number(src_obj->getObjectId()));
+	}
+
+	/* The hidden flags come from the filtering thus belong to the objects, so they
+	 * follow the rows' contents */
+	bool src_hidden=objects_tbw->isRowHidden(src_row);
+	objects_tbw->setRowHidden(src_row, objects_tbw->isRowHidden(dst_row));
+	objects_tbw->setRowHidden(dst_row, src_hidden);
+
+	objects_tbw->setUpdatesEnabled(true);
+	return true;
+}
+
 bool SwapObjectsIdsWidget::eventFilter(QObject *object, QEvent *event)
 {
 	if(object == objects_tbw && event->type() == QEvent::KeyPress)
@@ -269,7 +316,14 @@ void SwapObjectsIdsWidget::swapObjectsIds()
 		}
 
 		model->setInvalidated(true);
-		fillCreationOrderGrid();
+
+		/* Swapping ids only exchanges the positions of the two objects in the creation order,
+		 * so the grid is patched in place instead of recomputing the whole order per swap.
+		 * Relationship swaps still refill the grid since the revalidation above may reassign
+		 * the ids of other objects as a side effect */
+		if(src_obj->getObjectType()==ObjectType::Relationship ||
+			 !updateRowsAfterSwap(src_obj, dst_obj))
+			fillCreationOrderGrid();
 
 		src_id_lbl->setText(IdLabel.arg(src_object_sel->getSelectedObject()->getObjectId()));
 		dst_id_lbl->setText(IdLabel.arg(dst_object_sel->getSelectedObject()->getObjectId()));
@@ -43,6 +43,13 @@ class SwapObjectsIdsWidget: public QWidget, public Ui::SwapObjectsIdsWidget {
 		ObjectSelectorWidget *src_object_sel, *dst_object_sel;
 
 		void fillCreationOrderGrid();
+
+		/*! \brief Incrementally updates the creation order grid after a swap. Since swapping ids only
+		exchanges the positions of the two objects in the creation order, their rows are exchanged in
+		place instead of recomputing the whole order and refilling the grid. Returns false when any of
+		the objects isn't present in the grid, in which case the caller must perform a full refill */
+		bool updateRowsAfterSwap(BaseObject *src_obj, BaseObject *dst_obj);
+
 		bool eventFilter(QObject *object, QEvent *event);
 
 	public:
@@ -76,6 +76,15 @@ ResultSetModel::ResultSetModel(ResultSet &res, Catalog &catalog, QObject *parent
 	}
 }
 
+ResultSetModel::ResultSetModel(const QStringList &col_names, const QStringList &type_names, QObject *parent) : QAbstractTableModel(parent)
+{
+	col_count = col_names.size();
+	row_count = 0;
+	header_data = col_names;
+	tooltip_data = type_names;
+	insertColumns(0, col_count);
+}
+
 int ResultSetModel::rowCount(const QModelIndex &) const
 {
 	return row_count;
@@ -172,6 +181,19 @@ void ResultSetModel::append(ResultSet &res)
 	}
 }
 
+void ResultSetModel::appendRows(const QStringList &values)
+{
+	int rows_cnt = (col_count > 0 ? values.size() / col_count : 0);
+
+	if(rows_cnt <= 0)
+		return;
+
+	beginInsertRows(QModelIndex(), row_count, row_count + rows_cnt - 1);
+	item_data.append(values);
+	row_count += rows_cnt;
+	endInsertRows();
+}
+
 bool ResultSetModel::isEmpty()
 {
 	return (row_count <= 0);
@@ -41,6 +41,11 @@ class ResultSetModel: public QAbstractTableModel {
 
 	public:
 		ResultSetModel(ResultSet &res, Catalog &catalog, QObject *parent = 0);
+
+		/*! \brief Creates an empty model holding only the columns description (names and type names as tooltips).
+		The rows are inserted afterwards through appendRows() as they arrive from the server */
+		ResultSetModel(const QStringList &col_names, const QStringList &type_names, QObject *parent = 0);
+
 		virtual int rowCount(const QModelIndex & = QModelIndex()) const;
 		virtual int columnCount(const QModelIndex &) const;
 		virtual QModelIndex index(int row, int column, const QModelIndex &parent) const;
@@ -49,6 +54,12 @@ class ResultSetModel: public QAbstractTableModel {
 		virtual QVariant headerData(int section, Qt::Orientation orientation, int role) const;
 		virtual Qt::ItemFlags flags(const QModelIndex &) const;
 		void append(ResultSet &res);
+
+		/*! \brief Appends a batch of cell values (row by row, col_count values per row) to the model.
+		Differently from append(), this method notifies any attached view about the insertion, thus it
+		can be safely called while the model is being displayed */
+		void appendRows(const QStringList &values);
+
 		bool isEmpty();
 };
 
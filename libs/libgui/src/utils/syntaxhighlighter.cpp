@@ -23,6 +23,7 @@
 
 QFont SyntaxHighlighter::default_font = QFont(QString("Source Code Pro"), 10);
 const QString SyntaxHighlighter::UnformattedGroup = QString("__unformatted__");
+map<QString, SyntaxHighlighter::HighlightConf> SyntaxHighlighter::conf_cache;
 
 SyntaxHighlighter::SyntaxHighlighter(QPlainTextEdit *parent, bool single_line_mode, bool use_custom_tab_width) : QSyntaxHighlighter(parent)
 {
@@ -375,15 +376,38 @@ QString SyntaxHighlighter::identifyWordGroup(const QString &word, const QChar &l
 bool SyntaxHighlighter::isWordMatchGroup(const QString &word, const QString &group, bool use_final_expr, const QChar &lookahead_chr, int &match_idx, int &match_len)
 {
 	vector<QRegExp> *vet_expr=nullptr;
+	const QSet<QString> *fixed_set=nullptr;
 	bool match=false, part_match=partial_match[group];
 
 	if(use_final_expr && final_exprs.count(group))
 		vet_expr=&final_exprs[group];
 	else
+	{
 		vet_expr=&initial_exprs[group];
 
+		if(!part_match && fixed_words.count(group))
+			fixed_set=&fixed_words[group];
+	}
+
+	/* Trying to match the word against the group's fixed words index first. Groups holding
+	 * hundreds of fixed patterns (e.g. SQL keywords) are resolved in this single lookup
+	 * instead of having the word compared against each pattern individually */
+	if(fixed_set &&
+		 fixed_set->contains(fixed_words_cs[group]==Qt::CaseSensitive ? word : word.toLower()))
+	{
+		match_idx=0;
+		match_len=word.length();
+
+		if(lookahead_char.count(group)==0 || lookahead_chr==lookahead_char.at(group))
+			return true;
+	}
+
 	for(auto &expr : *vet_expr)
 	{
+		//Fixed string expressions are already covered by the index lookup above
+		if(fixed_set && expr.patternSyntax()==QRegExp::FixedString)
+			continue;
+
 		if(part_match)
 		{
 			match_idx=word.indexOf(expr);
@@ -424,6 +448,8 @@ void SyntaxHighlighter::clearConfiguration()
 	final_exprs.clear();
 	formats.clear();
 	partial_match.clear();
+	fixed_words.clear();
+	fixed_words_cs.clear();
 	groups_order.clear();
 	word_separators.clear();
 	word_delimiters.clear();
@@ -449,7 +475,35 @@ void SyntaxHighlighter::loadConfiguration(const QString &filename)
 
 		try
 		{
+			QDateTime last_mod=QFileInfo(filename).lastModified();
+			auto itr_cache=conf_cache.find(filename);
+
 			clearConfiguration();
+
+			/* Reuses the previously parsed configuration when the file wasn't modified since it was
+			 * cached. Lots of highlighter instances load the same few configuration files, so the
+			 * xml parsing cost is paid only once per file */
+			if(itr_cache!=conf_cache.end() && itr_cache->second.last_modified==last_mod)
+			{
+				HighlightConf &conf=itr_cache->second;
+
+				initial_exprs=conf.initial_exprs;
+				final_exprs=conf.final_exprs;
+				formats=conf.formats;
+				this->partial_match=conf.partial_match;
+				fixed_words=conf.fixed_words;
+				fixed_words_cs=conf.fixed_words_cs;
+				lookahead_char=conf.lookahead_char;
+				groups_order=conf.groups_order;
+				word_separators=conf.word_separators;
+				word_delimiters=conf.word_delimiters;
+				ignored_chars=conf.ignored_chars;
+				completion_trigger=conf.completion_trigger;
+				capt_nearby_separators=conf.capt_nearby_separators;
+				conf_loaded=true;
+				return;
+			}
+
 			xmlparser.restartParser();
 			xmlparser.setDTDFile(GlobalAttributes::getTmplConfigurationFilePath(GlobalAttributes::ObjectDTDDir,
 																																					GlobalAttributes::CodeHighlightConf +
@@ -613,7 +667,18 @@ void SyntaxHighlighter::loadConfiguration(const QString &filename)
 										if(expr_type.isEmpty() ||
 												expr_type==Attributes::SimpleExp ||
 												expr_type==Attributes::InitialExp)
+										{
 											initial_exprs[group].push_back(regexp);
+
+											/* Fixed string patterns are additionally indexed in a hash so words can be
+											 * matched against the group in a single lookup instead of being compared
+											 * against each pattern individually */
+											if(regexp.patternSyntax()==QRegExp::FixedString && !partial_match)
+											{
+												fixed_words[group].insert(chr_sensitive ? regexp.pattern() : regexp.pattern().toLower());
+												fixed_words_cs[group]=(chr_sensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+											}
+										}
 										else
 											final_exprs[group].push_back(regexp);
 									}
@@ -653,6 +718,24 @@ void SyntaxHighlighter::loadConfiguration(const QString &filename)
 			}
 
 			conf_loaded=true;
+
+			//Caching the parsed configuration so the next instances loading the same file reuse it
+			HighlightConf conf;
+			conf.initial_exprs=initial_exprs;
+			conf.final_exprs=final_exprs;
+			conf.formats=formats;
+			conf.partial_match=this->partial_match;
+			conf.fixed_words=fixed_words;
+			conf.fixed_words_cs=fixed_words_cs;
+			conf.lookahead_char=lookahead_char;
+			conf.groups_order=groups_order;
+			conf.word_separators=word_separators;
+			conf.word_delimiters=word_delimiters;
+			conf.ignored_chars=ignored_chars;
+			conf.completion_trigger=completion_trigger;
+			conf.capt_nearby_separators=capt_nearby_separators;
+			conf.last_modified=last_mod;
+			conf_cache[filename]=conf;
 		}
 		catch(Exception &e)
 		{
@@ -71,12 +71,43 @@ class SyntaxHighlighter: public QSyntaxHighlighter {
 		//! \brief Stores the groups related to partial matching
 		map<QString, bool> partial_match;
 
+		/*! \brief Stores, per group, the fixed string (non regexp) initial expressions indexed in a hash.
+		Groups holding hundreds of fixed patterns (e.g. SQL keywords) are matched through a single
+		lookup in this index instead of being compared pattern by pattern (see isWordMatchGroup()) */
+		map<QString, QSet<QString>> fixed_words;
+
+		//! \brief Stores the case sensitivity used to index/lookup the fixed words of each group
+		map<QString, Qt::CaseSensitivity> fixed_words_cs;
+
 		//! \brief Stores the char used to break the highlight for a group. This char is not highlighted itself.
 		map<QString, QChar> lookahead_char;
 
 		//! \brief Stores the order in which the groups must be applied
 		vector<QString> groups_order;
 
+		//! \brief Bundles a parsed highlight configuration so it can be shared among instances
+		struct HighlightConf {
+			map<QString, vector<QRegExp> > initial_exprs, final_exprs;
+			map<QString, QTextCharFormat> formats;
+			map<QString, bool> partial_match;
+			map<QString, QSet<QString>> fixed_words;
+			map<QString, Qt::CaseSensitivity> fixed_words_cs;
+			map<QString, QChar> lookahead_char;
+			vector<QString> groups_order;
+			QString word_separators, word_delimiters, ignored_chars;
+			QChar completion_trigger;
+			bool capt_nearby_separators;
+
+			//! \brief Modification date of the configuration file when it was parsed
+			QDateTime last_modified;
+		};
+
+		/*! \brief Stores the parsed highlight configurations indexed by file name. Since lots of
+		highlighter instances load the same few configuration files, the xml parsing is performed
+		only once per file and the parsed results are reused by the other instances. An entry is
+		invalidated when the modification date of its file changes */
+		static map<QString, HighlightConf> conf_cache;
+
 		//! \brief Indicates if the configuration is loaded or not
 		bool conf_loaded,
 
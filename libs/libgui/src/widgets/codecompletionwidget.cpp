@@ -55,6 +55,7 @@ CodeCompletionWidget::CodeCompletionWidget(QPlainTextEdit *code_field_txt, bool
 	auto_triggered=false;
 
 	db_model=nullptr;
+	obj_index_dirty=false;
 	setQualifyingLevel(nullptr);
 
 	connect(name_list, SIGNAL(itemDoubleClicked(QListWidgetItem*)), this, SLOT(selectItem()));
@@ -200,6 +201,26 @@ void CodeCompletionWidget::configureCompletion(DatabaseModel *db_model, SyntaxHi
 	word.clear();
 	setQualifyingLevel(nullptr);
 	auto_triggered=false;
+
+	if(this->db_model != db_model)
+	{
+		if(this->db_model)
+			disconnect(this->db_model, nullptr, this, nullptr);
+
+		/* The object index is rebuilt lazily on the next completion trigger and kept in sync
+		 * with the model through the object addition/removal signals */
+		if(db_model)
+		{
+			connect(db_model, &DatabaseModel::s_objectAdded, this, [this](){ obj_index_dirty=true; });
+			connect(db_model, &DatabaseModel::s_objectRemoved, this, [this](){ obj_index_dirty=true; });
+		}
+
+		obj_index.clear();
+	}
+
+	/* The index is always marked to be rebuilt when the completion is (re)configured since
+	 * objects may have been renamed in the meantime, which isn't notified by the model */
+	obj_index_dirty=true;
 	this->db_model=db_model;
 
 	if(confs[Attributes::Configuration][Attributes::CodeCompletion]==Attributes::True)
@@ -337,6 +358,79 @@ void CodeCompletionWidget::setQualifyingLevel(BaseObject *obj)
 	}
 }
 
+void CodeCompletionWidget::rebuildObjectIndex()
+{
+	vector<ObjectType> types=BaseObject::getObjectTypes(false, { ObjectType::Textbox, ObjectType::Relationship, ObjectType::BaseRelationship });
+	vector<BaseObject *> objects, children;
+	vector<BaseObject *> *obj_list=nullptr;
+	QString name;
+
+	obj_index.clear();
+
+	if(!db_model)
+		return;
+
+	//Gathering the objects that live directly in the model
+	for(auto &type : types)
+	{
+		if(type==ObjectType::Database)
+			objects.push_back(db_model);
+		else if(!TableObject::isTableObject(type))
+		{
+			obj_list=db_model->getObjectList(type);
+
+			if(obj_list)
+				objects.insert(objects.end(), obj_list->begin(), obj_list->end());
+		}
+	}
+
+	//Gathering the children of tables, foreign tables and views
+	for(auto type : { ObjectType::Table, ObjectType::ForeignTable, ObjectType::View })
+	{
+		for(auto &tab : *db_model->getObjectList(type))
+		{
+			children=dynamic_cast<BaseTable *>(tab)->getObjects();
+			objects.insert(objects.end(), children.begin(), children.end());
+		}
+	}
+
+	for(auto &object : objects)
+	{
+		//Formatting the indexed name according to the object type (see populateNameList())
+		if(object->getObjectType()==ObjectType::Function)
+		{
+			dynamic_cast<Function *>(object)->createSignature(false);
+			name=dynamic_cast<Function *>(object)->getSignature();
+		}
+		else if(object->getObjectType()==ObjectType::Operator)
+			name=dynamic_cast<Operator *>(object)->getSignature(false);
+		else
+			name=object->getName(false, false);
+
+		obj_index.insert(name.toLower(), object);
+	}
+
+	obj_index_dirty=false;
+}
+
+vector<BaseObject *> CodeCompletionWidget::findObjectsByPrefix(const QString &prefix)
+{
+	vector<BaseObject *> objects;
+	QString key=prefix.toLower();
+
+	key.remove('"');
+
+	if(obj_index_dirty)
+		rebuildObjectIndex();
+
+	/* Since the index is sorted by name all the objects matching the prefix lie in a
+	 * contiguous range starting at the first key greater or equal to the prefix */
+	for(auto itr=obj_index.lowerBound(key); itr!=obj_index.end() && itr.key().startsWith(key); itr++)
+		objects.push_back(itr.value());
+
+	return objects;
+}
+
 void CodeCompletionWidget::updateList()
 {
 	QListWidgetItem *item=nullptr;
@@ -390,8 +484,15 @@ void CodeCompletionWidget::updateList()
 	{
 		//Negative qualifying level means that user called the completion before a space (empty word)
 		if(qualifying_level < 0)
-			//The default behavior for this is to search all the objects on the model
-			objects=db_model->findObjects(pattern, types, false, !auto_triggered, auto_triggered);
+		{
+			/* The default behavior for this is to list all the objects on the model matching
+			 * the typed prefix. The search is resolved through the sorted name index instead
+			 * of scanning the whole object list on every keystroke */
+			if(!auto_triggered)
+				objects=findObjectsByPrefix(word.simplified());
+			else
+				objects=db_model->findObjects(pattern, types, false, !auto_triggered, auto_triggered);
+		}
 		else
 		{
 			QString left_word;
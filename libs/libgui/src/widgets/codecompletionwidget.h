@@ -88,9 +88,25 @@ class CodeCompletionWidget: public QWidget
 		vector<BaseObject *> sel_objects;
 		
 		map<QString, QPixmap> custom_items;
-		
+
 		attribs_map custom_items_tips;
-		
+
+		/*! \brief Sorted index over the model objects' names used to resolve the prefix searches
+		performed on each keystroke through binary searches instead of scanning the whole model.
+		The keys are the lowercased names (signatures for functions/operators) and the values
+		the objects themselves */
+		QMultiMap<QString, BaseObject *> obj_index;
+
+		/*! \brief Indicates that the object index must be rebuilt before the next prefix search.
+		The flag is set whenever objects are added to/removed from the model */
+		bool obj_index_dirty;
+
+		//! \brief Rebuilds the object index (see obj_index) from the current database model
+		void rebuildObjectIndex();
+
+		//! \brief Returns the model objects whose names start with the provided prefix
+		vector<BaseObject *> findObjectsByPrefix(const QString &prefix);
+
 		//! \brief Puts the selected object name on the current cursor position.
 		void insertObjectName(BaseObject *obj);
 		
@@ -46,8 +46,9 @@ ModelObjectsWidget::ModelObjectsWidget(bool simplified_view, QWidget *parent) :
 	connect(objectslist_tbw, SIGNAL(itemPressed(QTableWidgetItem*)), this, SLOT(showObjectMenu()));
 	connect(objectstree_tw,SIGNAL(itemSelectionChanged()),this, SLOT(selectObject()));
 	connect(objectslist_tbw,SIGNAL(itemSelectionChanged()),this, SLOT(selectObject()));
-	connect(expand_all_tb, SIGNAL(clicked()), objectstree_tw, SLOT(expandAll()));
+	connect(expand_all_tb, SIGNAL(clicked()), this, SLOT(expandAll()));
 	connect(collapse_all_tb, SIGNAL(clicked()), this, SLOT(collapseAll()));
+	connect(objectstree_tw, SIGNAL(itemExpanded(QTreeWidgetItem*)), this, SLOT(populateChildGroup(QTreeWidgetItem*)));
 
 	if(!simplified_view)
 	{
@@ -80,7 +81,13 @@ ModelObjectsWidget::ModelObjectsWidget(bool simplified_view, QWidget *parent) :
 
 	connect(tree_view_tb,SIGNAL(clicked()),this,SLOT(changeObjectsView()));
 	connect(list_view_tb,SIGNAL(clicked()),this,SLOT(changeObjectsView()));
-	connect(filter_edt, SIGNAL(textChanged(QString)), this, SLOT(filterObjects()));
+
+	/* The typed pattern is debounced so fast typing triggers a single filtering
+	 * once the user pauses instead of a full items scan per keystroke */
+	filter_timer.setSingleShot(true);
+	filter_timer.setInterval(300);
+	connect(&filter_timer, SIGNAL(timeout()), this, SLOT(filterObjects()));
+	connect(filter_edt, &QLineEdit::textChanged, this, [this](){ filter_timer.start(); });
 	connect(by_id_chk, SIGNAL(toggled(bool)), this, SLOT(filterObjects()));
 }
 
@@ -184,7 +191,7 @@ void ModelObjectsWidget::selectObject()
 				obj_type != ObjectType::Column && obj_type != ObjectType::Constraint && obj_type != ObjectType::Rule &&
 				obj_type != ObjectType::Index && obj_type != ObjectType::Trigger && obj_type != ObjectType::Permission)
 		{
-			QAction act(QPixmap(GuiUtilsNs::getIconPath(obj_type)),
+			QAction act(GuiUtilsNs::getCachedIcon(obj_type),
 									tr("New") + QString(" ") + BaseObject::getTypeName(obj_type), nullptr);
 			QMenu popup;
 
@@ -348,7 +355,7 @@ QTreeWidgetItem *ModelObjectsWidget::createItemForObject(BaseObject *object, QTr
 			str_aux=QString("_%1").arg(TableObjectView::TextExclude);
 	}
 
-	item->setIcon(0, QPixmap(GuiUtilsNs::getIconPath(BaseObject::getSchemaName(obj_type) + str_aux)));
+	item->setIcon(0, GuiUtilsNs::getCachedIcon(BaseObject::getSchemaName(obj_type) + str_aux));
 
 	return item;
 }
@@ -447,6 +454,11 @@ void ModelObjectsWidget::filterObjects()
 {
 	if(tree_view_tb->isChecked())
 	{
+		/* The filtering acts upon existing tree items so the groups still pending population
+		 * must be populated beforehand in order to make all the objects reachable by the pattern */
+		if(!filter_edt->text().isEmpty())
+			populateAllChildGroups();
+
 		DatabaseImportForm::filterObjects(objectstree_tw, filter_edt->text(), (by_id_chk->isChecked() ? 1 : 0), simplified_view);
 	}
 	else
@@ -454,6 +466,8 @@ void ModelObjectsWidget::filterObjects()
 		QList<QTableWidgetItem*> items=objectslist_tbw->findItems(filter_edt->text(), Qt::MatchStartsWith | Qt::MatchRecursive);
 
 		objectslist_tbw->blockSignals(true);
+		objectslist_tbw->setUpdatesEnabled(false);
+
 		for(int row=0; row < objectslist_tbw->rowCount(); row++)
 			objectslist_tbw->setRowHidden(row, true);
 
@@ -463,6 +477,7 @@ void ModelObjectsWidget::filterObjects()
 			items.pop_front();
 		}
 
+		objectslist_tbw->setUpdatesEnabled(true);
 		objectslist_tbw->blockSignals(false);
 	}
 }
@@ -503,12 +518,11 @@ void ModelObjectsWidget::updateSchemaTree(QTreeWidgetItem *root)
 	if(db_model && visible_objs_map[ObjectType::Schema])
 	{
 		BaseObject *schema=nullptr;
-		vector<BaseObject *> obj_list;
 		QFont font;
 		QTreeWidgetItem *item=nullptr, *item1=nullptr, *item2=nullptr, *item3=nullptr;
 		vector<ObjectType> types = BaseObject::getChildObjectTypes(ObjectType::Schema);
 		int count = 0, count2 = 0, i = 0;
-		QPixmap group_icon=QPixmap(GuiUtilsNs::getIconPath(QString(BaseObject::getSchemaName(ObjectType::Schema)) + QString("_grp")));
+		QIcon group_icon=GuiUtilsNs::getCachedIcon(QString(BaseObject::getSchemaName(ObjectType::Schema)) + QString("_grp"));
 
 		//Removing the ObjectType::Table and ObjectType::View types since they are handled separetedly
 		types.erase(std::find(types.begin(), types.end(), ObjectType::Table));
@@ -558,22 +572,10 @@ void ModelObjectsWidget::updateSchemaTree(QTreeWidgetItem *root)
 				{
 					if(visible_objs_map[type])
 					{
-						item3=new QTreeWidgetItem(item2);
-						item3->setIcon(0,QPixmap(GuiUtilsNs::getIconPath(BaseObject::getSchemaName(type) + QString("_grp"))));
-
 						//Get the objects that belongs to the current schema
-						obj_list=db_model->getObjects(type, schema);
-
-						count2=obj_list.size();
-						item3->setText(0, QString("%1 (%2)").arg(BaseObject::getTypeName(type)).arg(count2));
+						count2=db_model->getObjects(type, schema).size();
+						item3=createChildGroupItem(schema, type, count2, item2);
 						item3->setData(1, Qt::UserRole, QVariant(enum_cast(type)));
-
-						font=item3->font(0);
-						font.setItalic(true);
-						item3->setFont(0, font);
-
-						for(auto obj : obj_list)
-							createItemForObject(obj, item3);
 					}
 				}
 			}
@@ -591,10 +593,10 @@ void ModelObjectsWidget::updateTableTree(QTreeWidgetItem *root, BaseObject *sche
 	{
 		vector<BaseObject *> obj_list;
 		PhysicalTable *table=nullptr;
-		QTreeWidgetItem *item=nullptr, *item1=nullptr, *item2=nullptr;
+		QTreeWidgetItem *item=nullptr, *item1=nullptr;
 		QFont font;
 		vector<ObjectType> types = BaseObject::getChildObjectTypes(table_type);
-		QPixmap group_icon=QPixmap(GuiUtilsNs::getIconPath(BaseObject::getSchemaName(table_type) + QString("_grp")));
+		QIcon group_icon=GuiUtilsNs::getCachedIcon(BaseObject::getSchemaName(table_type) + QString("_grp"));
 
 		try
 		{
@@ -617,22 +619,12 @@ void ModelObjectsWidget::updateTableTree(QTreeWidgetItem *root, BaseObject *sche
 				table=dynamic_cast<PhysicalTable *>(obj);
 				item1=createItemForObject(table, item);
 
-				//Creating the group for the child objects (column, rules, triggers, indexes and constraints)
+				/* Creating the group for the child objects (column, rules, triggers, indexes and constraints).
+				 * The group children are created only when the group is expanded (see populateChildGroup) */
 				for(auto type : types)
 				{
 					if(visible_objs_map[type])
-					{
-						item2=new QTreeWidgetItem(item1);
-						item2->setIcon(0,QPixmap(GuiUtilsNs::getIconPath(BaseObject::getSchemaName(type) + QString("_grp"))));
-						font=item2->font(0);
-						font.setItalic(true);
-						item2->setFont(0, font);
-
-						item2->setText(0, QString("%1 (%2)").arg(BaseObject::getTypeName(type)).arg(table->getObjectCount(type)));
-
-						for(auto tab_obj : *table->getObjectList(type))
-							createItemForObject(tab_obj, item2);
-					}
+						createChildGroupItem(table, type, table->getObjectCount(type), item1);
 				}
 			}
 		}
@@ -647,14 +639,13 @@ void ModelObjectsWidget::updateViewTree(QTreeWidgetItem *root, BaseObject *schem
 {
 	if(db_model && visible_objs_map[ObjectType::View])
 	{
-		BaseObject *object=nullptr;
 		vector<BaseObject *> obj_list;
 		View *view=nullptr;
-		QTreeWidgetItem *item=nullptr, *item1=nullptr, *item2=nullptr;
+		QTreeWidgetItem *item=nullptr, *item1=nullptr;
 		QFont font;
 		vector<ObjectType> types = BaseObject::getChildObjectTypes(ObjectType::View);
-		int count = 0, count1 = 0, i = 0, i2 = 0;
-		QPixmap group_icon=QPixmap(GuiUtilsNs::getIconPath(QString(BaseObject::getSchemaName(ObjectType::View)) + QString("_grp")));
+		int count = 0, i = 0;
+		QIcon group_icon=GuiUtilsNs::getCachedIcon(QString(BaseObject::getSchemaName(ObjectType::View)) + QString("_grp"));
 
 		try
 		{
@@ -678,26 +669,12 @@ void ModelObjectsWidget::updateViewTree(QTreeWidgetItem *root, BaseObject *schem
 				view=dynamic_cast<View *>(obj_list[i]);
 				item1=createItemForObject(view, item);
 
-				//Creating the group for the child objects (rules, triggers)
+				/* Creating the group for the child objects (rules, triggers).
+				 * The group children are created only when the group is expanded (see populateChildGroup) */
 				for(auto &type : types)
 				{
 					if(visible_objs_map[type])
-					{
-						item2=new QTreeWidgetItem(item1);
-						item2->setIcon(0,QPixmap(GuiUtilsNs::getIconPath(BaseObject::getSchemaName(type) + QString("_grp"))));
-						font=item2->font(0);
-						font.setItalic(true);
-						item2->setFont(0, font);
-
-						count1 = view->getObjectCount(type);
-						item2->setText(0,BaseObject::getTypeName(type) + QString(" (%1)").arg(count1));
-
-						for(i2=0; i2 < count1; i2++)
-						{
-							object=view->getObject(i2, type);
-							createItemForObject(object, item2);
-						}
-					}
+						createChildGroupItem(view, type, view->getObjectCount(type), item1);
 				}
 			}
 		}
@@ -708,6 +685,96 @@ void ModelObjectsWidget::updateViewTree(QTreeWidgetItem *root, BaseObject *schem
 	}
 }
 
+QTreeWidgetItem *ModelObjectsWidget::createChildGroupItem(BaseObject *parent_obj, ObjectType child_type, unsigned child_count, QTreeWidgetItem *root)
+{
+	QTreeWidgetItem *item=new QTreeWidgetItem(root);
+	QFont font;
+
+	item->setIcon(0, GuiUtilsNs::getCachedIcon(BaseObject::getSchemaName(child_type) + QString("_grp")));
+	item->setText(0, QString("%1 (%2)").arg(BaseObject::getTypeName(child_type)).arg(child_count));
+
+	/* The parent object and the child type are stored in auxiliary roles so populateChildGroup()
+	 * can determine the children to be created when the group is expanded for the first time */
+	item->setData(0, Qt::UserRole + 1, generateItemValue(parent_obj));
+	item->setData(1, Qt::UserRole + 1, QVariant(enum_cast(child_type)));
+
+	font=item->font(0);
+	font.setItalic(true);
+	item->setFont(0, font);
+
+	//Forcing the expansion indicator so the (still empty) group can be expanded and populated
+	if(child_count > 0)
+		item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+
+	return item;
+}
+
+void ModelObjectsWidget::populateChildGroup(QTreeWidgetItem *item)
+{
+	BaseObject *parent_obj=nullptr;
+
+	if(!item || item->childCount() > 0)
+		return;
+
+	parent_obj=reinterpret_cast<BaseObject *>(item->data(0, Qt::UserRole + 1).value<void *>());
+
+	//Ordinary object items don't store a parent object reference, so there's nothing to populate
+	if(!parent_obj)
+		return;
+
+	try
+	{
+		ObjectType child_type=static_cast<ObjectType>(item->data(1, Qt::UserRole + 1).toUInt());
+		vector<BaseObject *> obj_list;
+		PhysicalTable *table=dynamic_cast<PhysicalTable *>(parent_obj);
+		View *view=dynamic_cast<View *>(parent_obj);
+		int count = 0, i = 0;
+
+		if(table)
+			obj_list=(*table->getObjectList(child_type));
+		else if(view)
+		{
+			count=view->getObjectCount(child_type);
+
+			for(i=0; i < count; i++)
+				obj_list.push_back(view->getObject(i, child_type));
+		}
+		//Groups at schema level hold the objects of the respective type owned by the schema
+		else if(db_model)
+			obj_list=db_model->getObjects(child_type, parent_obj);
+
+		objectstree_tw->setUpdatesEnabled(false);
+
+		for(auto obj : obj_list)
+			createItemForObject(obj, item);
+
+		objectstree_tw->setUpdatesEnabled(true);
+		item->setChildIndicatorPolicy(QTreeWidgetItem::DontShowIndicatorWhenChildless);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void ModelObjectsWidget::populateAllChildGroups()
+{
+	QTreeWidgetItemIterator itr(objectstree_tw);
+
+	while(*itr)
+	{
+		populateChildGroup(*itr);
+		++itr;
+	}
+}
+
+void ModelObjectsWidget::expandAll()
+{
+	//Populating the groups still pending so the expansion reveals all the objects
+	populateAllChildGroups();
+	objectstree_tw->expandAll();
+}
+
 void ModelObjectsWidget::updatePermissionTree(QTreeWidgetItem *root, BaseObject *object)
 {
 	try
@@ -720,7 +787,7 @@ void ModelObjectsWidget::updatePermissionTree(QTreeWidgetItem *root, BaseObject
 			QFont font=item->font(0);
 
 			db_model->getPermissions(object, perms);
-			item->setIcon(0,QPixmap(GuiUtilsNs::getIconPath("permission_grp")));
+			item->setIcon(0,GuiUtilsNs::getCachedIcon("permission_grp"));
 
 			font.setItalic(true);
 			item->setFont(0, font);
@@ -780,7 +847,7 @@ void ModelObjectsWidget::updateDatabaseTree()
 						item1=new QTreeWidgetItem(root);
 						str_aux=QString(BaseObject::getSchemaName(type));
 
-						item1->setIcon(0,QPixmap(GuiUtilsNs::getIconPath(str_aux + QString("_grp"))));
+						item1->setIcon(0,GuiUtilsNs::getCachedIcon(str_aux + QString("_grp")));
 						item1->setData(1, Qt::UserRole, QVariant(enum_cast(type)));
 
 						obj_list=(*db_model->getObjectList(type));
@@ -1065,6 +1132,36 @@ QTreeWidgetItem *ModelObjectsWidget::getTreeItem(BaseObject *object)
 			++itr;
 		}
 
+		if(!item)
+		{
+			/* The item may not exist yet if the object belongs to a group whose population is still
+			 * pending (see populateChildGroup). In this case we locate the related group under the
+			 * parent object's item, populate it and search the object among the created children */
+			TableObject *tab_obj=dynamic_cast<TableObject *>(object);
+			BaseObject *parent_obj=(tab_obj ? tab_obj->getParentTable() : object->getSchema());
+			QTreeWidgetItem *parent_item=(parent_obj ? getTreeItem(parent_obj) : nullptr), *group=nullptr;
+			int idx = 0, idx1 = 0;
+
+			for(idx=0; parent_item && idx < parent_item->childCount(); idx++)
+			{
+				group=parent_item->child(idx);
+
+				if(group->childCount()==0 && group->data(1, Qt::UserRole + 1).isValid() &&
+						static_cast<ObjectType>(group->data(1, Qt::UserRole + 1).toUInt())==object->getObjectType())
+				{
+					populateChildGroup(group);
+
+					for(idx1=0; idx1 < group->childCount(); idx1++)
+					{
+						aux_obj=reinterpret_cast<BaseObject *>(group->child(idx1)->data(0,Qt::UserRole).value<void *>());
+
+						if(aux_obj==object)
+							return group->child(idx1);
+					}
+				}
+			}
+		}
+
 		return item;
 	}
 	else
@@ -56,6 +56,10 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		object type visualization buttons */
 		QSettings widgets_conf;
 
+		/*! \brief Debounces the quick search input so the filtering runs only once after the user
+		stops typing instead of performing a full items scan per keystroke */
+		QTimer filter_timer;
+
 		//! \brief Reference model widget. This is the object used to populate the tree and list
 		ModelWidget *model_wgt;
 
@@ -87,6 +91,14 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		//! \brief Returns an item from the tree related to the specified object reference
 		QTreeWidgetItem *getTreeItem(BaseObject *object);
 
+		/*! \brief Creates a child object group item (e.g. Columns, Constraints) under 'root'. The leaf
+		items aren't created right away: the parent object and the child type are stored in the group
+		item and the children are created by populateChildGroup() upon the first expansion */
+		QTreeWidgetItem *createChildGroupItem(BaseObject *parent_obj, ObjectType child_type, unsigned child_count, QTreeWidgetItem *root);
+
+		//! \brief Creates the leaf items of all child group items whose population is still pending
+		void populateAllChildGroups();
+
 		//! \brief Generates a QVariant containing the passed object reference as data
 		QVariant generateItemValue(BaseObject *object);
 
@@ -134,6 +146,15 @@ class ModelObjectsWidget: public QWidget, public Ui::ModelObjectsWidget {
 		void showObjectMenu();
 		void editObject();
 		void collapseAll();
+
+		//! \brief Expands the whole tree populating beforehand the groups still pending population
+		void expandAll();
+
+		/*! \brief Creates the leaf items of a child group item upon its first expansion. This lazy
+		population avoids creating tree items for every single object of the model on each tree
+		update, which is costly on large models */
+		void populateChildGroup(QTreeWidgetItem *item);
+
 		void filterObjects();
 		void selectCreatedObject(BaseObject *obj);
 
@@ -39,6 +39,10 @@ ModelOverviewWidget::ModelOverviewWidget(QWidget *parent) : QWidget(parent, Qt::
 	vbox->setContentsMargins(0,0,0,0);
 	frame->setLayout(vbox);
 	label->setStyleSheet("QLabel#label{ border: 0px; }");
+
+	update_timer.setSingleShot(true);
+	update_timer.setInterval(RefreshInterval);
+	connect(&update_timer, SIGNAL(timeout()), this, SLOT(updateOverview()));
 }
 
 void ModelOverviewWidget::show(ModelWidget *model)
@@ -54,22 +58,22 @@ void ModelOverviewWidget::show(ModelWidget *model)
 
 	if(this->model)
 	{
-		connect(this->model, SIGNAL(s_objectCreated()), this, SLOT(updateOverview()));
-		connect(this->model, SIGNAL(s_objectRemoved()), this, SLOT(updateOverview()));
-		connect(this->model, SIGNAL(s_objectsMoved()), this, SLOT(updateOverview()));
-		connect(this->model, SIGNAL(s_objectModified()), this, SLOT(updateOverview()));
+		connect(this->model, SIGNAL(s_objectCreated()), this, SLOT(scheduleOverviewUpdate()));
+		connect(this->model, SIGNAL(s_objectRemoved()), this, SLOT(scheduleOverviewUpdate()));
+		connect(this->model, SIGNAL(s_objectsMoved()), this, SLOT(scheduleOverviewUpdate()));
+		connect(this->model, SIGNAL(s_objectModified()), this, SLOT(scheduleOverviewUpdate()));
 		connect(this->model, SIGNAL(s_zoomModified(double)), this, SLOT(updateZoomFactor(double)));
 
 		connect(this->model, SIGNAL(s_modelResized()), this, SLOT(resizeOverview()));
 		connect(this->model, SIGNAL(s_modelResized()), this, SLOT(resizeWindowFrame()));
-		connect(this->model, SIGNAL(s_modelResized()), this, SLOT(updateOverview()));
+		connect(this->model, SIGNAL(s_modelResized()), this, SLOT(scheduleOverviewUpdate()));
 
 		connect(this->model->viewport->horizontalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(resizeWindowFrame()));
 		connect(this->model->viewport->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(resizeWindowFrame()));
 
-		connect(this->model->scene, SIGNAL(selectionChanged()), this, SLOT(updateOverview()));
+		connect(this->model->scene, SIGNAL(selectionChanged()), this, SLOT(scheduleOverviewUpdate()));
 		connect(this->model->scene, SIGNAL(sceneRectChanged(QRectF)),this, SLOT(resizeOverview()));
-		connect(this->model->scene, SIGNAL(sceneRectChanged(QRectF)),this, SLOT(updateOverview()));
+		connect(this->model->scene, SIGNAL(sceneRectChanged(QRectF)),this, SLOT(scheduleOverviewUpdate()));
 
 		this->resizeOverview();
 		this->updateZoomFactor(this->model->getCurrentZoom());
@@ -121,6 +125,12 @@ void ModelOverviewWidget::updateOverview()
 	this->updateOverview(false);
 }
 
+void ModelOverviewWidget::scheduleOverviewUpdate()
+{
+	if(!update_timer.isActive())
+		update_timer.start();
+}
+
 void ModelOverviewWidget::updateOverview(bool force_update)
 {
 	if(this->model && (this->isVisible() || force_update))
@@ -129,8 +139,10 @@ void ModelOverviewWidget::updateOverview(bool force_update)
 
 		QApplication::setOverrideCursor(Qt::WaitCursor);
 
-		//Creates a pixmap with the size of the scene
-		pix=QPixmap(pixmap_size);
+		/* The snapshot is rendered directly at the displayed (downsampled) size. Rendering at the
+		 * scene original size and rescaling afterwards would rasterize every item at full resolution
+		 * and allocate a scene-sized pixmap just to throw both away */
+		pix=QPixmap(curr_size.toSize());
 
 		//Draw the scene onto the pixmap
 		QPainter p(&pix);
@@ -139,7 +151,7 @@ void ModelOverviewWidget::updateOverview(bool force_update)
 		{
 			label->setPixmap(QPixmap());
 			label->setText(tr("Failed to generate the overview image.\nThe requested size %1 x %2 was too big and there was not enough memory to allocate!")
-										 .arg(pixmap_size.width()).arg(pixmap_size.height()));
+										 .arg(curr_size.toSize().width()).arg(curr_size.toSize().height()));
 			frame->setEnabled(false);
 		}
 		else
@@ -149,9 +161,7 @@ void ModelOverviewWidget::updateOverview(bool force_update)
 			p.setRenderHints(QPainter::Antialiasing, false);
 			p.setRenderHints(QPainter::TextAntialiasing, false);
 			this->model->scene->render(&p, pix.rect(), scene_rect.toRect());
-
-			//Resizes the pixmap to the previous configured QSize
-			label->setPixmap(pix.scaled(curr_size.toSize(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+			label->setPixmap(pix);
 		}
 
 		label->resize(curr_size.toSize());
@@ -214,26 +224,16 @@ void ModelOverviewWidget::resizeOverview()
 
 			//Reduce the resize factor and recalculates the new size
 			if(max_val >= 16384)
-			{
 				curr_resize_factor=screen_rect.width()/static_cast<double>(max_val);
-				pixmap_size.setWidth(scene_rect.size().width() * (curr_resize_factor * 10));
-				pixmap_size.setHeight(scene_rect.size().height() * (curr_resize_factor * 10));
-			}
 			else
-			{
 				curr_resize_factor=ResizeFactor/2;
-				pixmap_size=scene_rect.size().toSize();
-			}
 
 			curr_size=scene_rect.size();
 			curr_size.setWidth(curr_size.width() * curr_resize_factor);
 			curr_size.setHeight(curr_size.height() * curr_resize_factor);
 		}
 		else
-		{
 			curr_resize_factor=ResizeFactor;
-			pixmap_size=scene_rect.size().toSize();
-		}
 
 		QSize size = curr_size.toSize();
 		bool show_scrollarea = false;
@@ -51,11 +51,17 @@ class ModelOverviewWidget: public QWidget, public Ui::ModelOverviewWidget {
 		//! \brief Current scene rectangle
 		QRectF scene_rect;
 
-		QSize pixmap_size;
+		/*! \brief Coalesces the scene change notifications so bursts of modifications (dragging,
+		multiple selection, batch operations) cause a single snapshot refresh per interval instead
+		of one full scene rendering per signal */
+		QTimer update_timer;
 
 		//! \brief Resize factor applied to overview widgets (default: 20% of the scene original size)
 		static constexpr double ResizeFactor=0.20;
 
+		//! \brief Minimum interval (in miliseconds) between two snapshot refreshes
+		static constexpr int RefreshInterval=300;
+
 		void mouseDoubleClickEvent(QMouseEvent *);
 		void mousePressEvent(QMouseEvent *event);
 		void mouseReleaseEvent(QMouseEvent *event);
@@ -75,6 +81,10 @@ class ModelOverviewWidget: public QWidget, public Ui::ModelOverviewWidget {
 		//! \brief Updates the overview (only if the widget is visible)
 		void updateOverview();
 
+		/*! \brief Schedules a snapshot refresh. Successive calls within the refresh interval are
+		coalesced into a single updateOverview() execution */
+		void scheduleOverviewUpdate();
+
 		//! \brief Resizes the frame that represents the visualization window
 		void resizeWindowFrame();
 
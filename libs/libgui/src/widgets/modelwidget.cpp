@@ -18,6 +18,8 @@
 
 #include "baseform.h"
 #include "modelwidget.h"
+#include "tracelogger.h"
+#include "profilerhooks.h"
 #include "sourcecodewidget.h"
 #include "dbobjects/databasewidget.h"
 #include "dbobjects/schemawidget.h"
@@ -64,12 +66,19 @@
 #include "dbobjects/transformwidget.h"
 #include "dbobjects/procedurewidget.h"
 #include "coreutilsns.h"
+#include "utilsns.h"
+#include "taskscheduler.h"
+#include <QOpenGLWidget>
+#include <QtConcurrent/QtConcurrent>
+#include <QFutureSynchronizer>
+#include <QPicture>
 
 vector<BaseObject *> ModelWidget::copied_objects;
 vector<BaseObject *> ModelWidget::cutted_objects;
 bool ModelWidget::cut_operation=false;
 bool ModelWidget::save_restore_pos=true;
 bool ModelWidget::disable_render_smooth=false;
+bool ModelWidget::hw_accel_viewport=false;
 bool ModelWidget::simple_obj_creation=true;
 ModelWidget *ModelWidget::src_model=nullptr;
 double ModelWidget::min_object_opacity=0.10;
@@ -96,7 +105,8 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 																																		 ObjectType::BaseRelationship});
 
 	current_zoom=1;
-	modified = panning_mode = false;
+	modified = panning_mode = viewer_mode = false;
+	mod_notif_count = tmp_saved_notif_count = 0;
 	new_obj_type=ObjectType::BaseObject;
 
 	//Generating a temporary file name for the model
@@ -150,7 +160,6 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	scene->installEventFilter(this);
 
 	viewport=new QGraphicsView(scene);
-	updateRenderHints();
 	viewport->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
 	/* Since we constantly work with objects (re)configuration which leads to bounding
@@ -165,6 +174,7 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	viewport->setCacheMode(QGraphicsView::CacheBackground);
 	viewport->centerOn(0,0);
 	viewport->setMouseTracking(true);
+	updateRenderHints();
 
 	grid=new QGridLayout;
 	grid->addWidget(protected_model_frm, 0,0,1,1);
@@ -553,6 +563,7 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	connect(scene, SIGNAL(s_childrenSelectionChanged()), new_obj_overlay_wgt, SLOT(hide()));
 	connect(scene, SIGNAL(s_objectsScenePressed(Qt::MouseButtons)), new_obj_overlay_wgt, SLOT(hide()));
 	connect(&popup_menu, SIGNAL(aboutToHide()), this, SLOT(updateObjectsLayers()));
+	connect(&model_save_watcher, SIGNAL(finished()), this, SLOT(handleModelSaveFinished()));
 
 	viewport->installEventFilter(this);
 	viewport->horizontalScrollBar()->installEventFilter(this);
@@ -561,6 +572,13 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 
 ModelWidget::~ModelWidget()
 {
+	/* Waits for a temporary model writing still in progress, otherwise the worker thread
+	 could recreate the file after the main window has already discarded it */
+	tmp_save_future.waitForFinished();
+
+	//Waits for a model file writing still in progress so no saving is ever lost on shutdown
+	model_save_future.waitForFinished();
+
 	/* If there are copied/cutted objects that belongs to the database model
 	 being destroyed, then the cut/copy operation are cancelled by emptying
 	 the lists, avoiding crashes when trying to paste them */
@@ -580,6 +598,10 @@ ModelWidget::~ModelWidget()
 	tags_menu.clear();
 	break_rel_menu.clear();
 
+	//Destroying the cached editing widgets since they are parentless when not displayed
+	for(auto &itr : editing_wgts_cache)
+		delete itr.second;
+
 	delete viewport;
 	delete scene;
 	delete op_list;
@@ -588,6 +610,9 @@ ModelWidget::~ModelWidget()
 
 void ModelWidget::setModified(bool value)
 {
+	if(value)
+		mod_notif_count++;
+
 	this->modified = value;
 	emit s_modelModified(value);
 }
@@ -834,6 +859,10 @@ void ModelWidget::applyZoom(double zoom)
 	else if(zoom > MaximumZoom)
 		zoom = MaximumZoom;
 
+	/* Adjusting the tables' level of detail before scaling the viewport so huge models
+	 * are rendered as simplified shapes at low zoom levels */
+	scene->setLevelOfDetailZoom(zoom);
+
 	viewport->resetTransform();
 	viewport->scale(zoom, zoom);
 	this->current_zoom=zoom;
@@ -1612,6 +1641,9 @@ void ModelWidget::convertRelationship1N()
 
 void ModelWidget::loadModel(const QString &filename)
 {
+	//The span covers the model parsing plus the scene population and adjustments
+	TraceLogger::Span trace_span("ModelWidget::loadModel");
+	ProfilerHooks::Phase prof_phase("scene-population");
 	TaskProgressWidget task_prog_wgt(this);
 
 	try
@@ -1621,7 +1653,12 @@ void ModelWidget::loadModel(const QString &filename)
 		task_prog_wgt.setWindowTitle(tr("Loading database model"));
 		task_prog_wgt.show();
 
-		db_model->loadModel(filename);		
+		/* Enabling the batch population mode so the scene postpones the layer rects updates
+		 * triggered by each graphical object insertion/reconfiguration during the load */
+		scene->setBatchPopulationEnabled(true);
+		db_model->loadModel(filename);
+		scene->setBatchPopulationEnabled(false);
+
 		this->filename=filename;
 		adjustSceneSize();
 		updateObjectsOpacity();
@@ -1633,6 +1670,7 @@ void ModelWidget::loadModel(const QString &filename)
 	}
 	catch(Exception &e)
 	{
+		scene->setBatchPopulationEnabled(false);
 		task_prog_wgt.close();
 		setModified(false);
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
@@ -1718,6 +1756,75 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 		pages=scene->getPagesForPrinting(paper_size, margins.size(), h_page_cnt, v_page_cnt);
 		page_size=printer->pageRect().size();
 
+		/* Temporarily disabling the cached rendering of the items so they are printed
+		 * as vector content instead of device resolution bitmaps */
+		QList<QGraphicsItem *> cached_items;
+
+		for(auto &item : scene->items())
+		{
+			if(item->cacheMode() != QGraphicsItem::NoCache)
+			{
+				cached_items.append(item);
+				item->setCacheMode(QGraphicsItem::NoCache);
+			}
+		}
+
+		/* For native printers, which rasterize the pages in the print engine anyway, the pages are
+		 * pre-rendered concurrently into per-page images from a frozen snapshot of the scene.
+		 * PDF output keeps the direct scene rendering below so the pages remain vector content */
+		bool parallel_raster=(printer->outputFormat()==QPrinter::NativeFormat &&
+													pages.size() > 1 && QThread::idealThreadCount() > 1);
+		vector<QImage> page_imgs;
+
+		if(parallel_raster)
+		{
+			QRectF total_rect=pages[0];
+			QPicture snapshot;
+			QPainter pic_painter;
+			QFutureSynchronizer<void> render_sync;
+
+			for(auto &pg_rect : pages)
+				total_rect=total_rect.united(pg_rect);
+
+			/* Freezes the scene into a vector snapshot with a single traversal of the items.
+			 * The scene itself can only be painted by the gui thread but the recorded snapshot
+			 * can be replayed by the worker threads */
+			pic_painter.begin(&snapshot);
+			scene->render(&pic_painter, QRectF(QPointF(0,0), total_rect.size()), total_rect);
+			pic_painter.end();
+
+			page_imgs.resize(pages.size());
+
+			for(unsigned pg=0; pg < static_cast<unsigned>(pages.size()); pg++)
+			{
+				render_sync.addFuture(QtConcurrent::run(&TaskScheduler::getThreadPool(), [&, pg](){
+					/* Each worker replays its own deep copy of the snapshot since the replay
+					 * isn't reentrant over the same QPicture instance */
+					QPicture pic;
+					pic.setData(snapshot.data(), snapshot.size());
+
+					QImage img(page_size, QImage::Format_RGB32);
+					img.fill(Qt::white);
+
+					/* Reproducing the mapping performed by QGraphicsScene::render() when the
+					 * source page rect is fit into the printer's page rect */
+					double scl=qMin(page_size.width() / pages[pg].width(),
+													page_size.height() / pages[pg].height());
+					QPainter img_painter(&img);
+
+					img_painter.setRenderHint(QPainter::Antialiasing);
+					img_painter.scale(scl, scl);
+					img_painter.translate(total_rect.topLeft() - pages[pg].topLeft());
+					img_painter.drawPicture(0, 0, pic);
+					img_painter.end();
+
+					page_imgs[pg]=img;
+				}));
+			}
+
+			render_sync.waitForFinished();
+		}
+
 		//Creates a painter to draw the model directly on the printer
 		QPainter painter(printer);
 		painter.setRenderHint(QPainter::Antialiasing);
@@ -1747,7 +1854,10 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 		for(page=0, h_pg_id=0, v_pg_id=0; page < page_cnt; page++)
 		{
 			//Render the current page on the printer
-			scene->render(&painter, QRect(), pages[page]);
+			if(parallel_raster)
+				painter.drawImage(QPointF(0,0), page_imgs[page]);
+			else
+				scene->render(&painter, QRect(), pages[page]);
 
 			//Print the current page number is this option is marked
 			if(print_page_nums)
@@ -1818,6 +1928,10 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 				printer->newPage();
 		}
 
+		//Restoring the cached rendering of the items
+		for(auto &item : cached_items)
+			item->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
+
 		//Restore the grid option backup
 		ObjectsScene::setGridOptions(show_grid, align_objs, show_delims);
 		scene->update();
@@ -1826,9 +1940,40 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 
 void ModelWidget::updateRenderHints()
 {
+	bool using_gl = (dynamic_cast<QOpenGLWidget *>(viewport->viewport()) != nullptr);
+
 	viewport->setRenderHint(QPainter::Antialiasing, !disable_render_smooth);
 	viewport->setRenderHint(QPainter::TextAntialiasing, !disable_render_smooth);
 	viewport->setRenderHint(QPainter::SmoothPixmapTransform, !disable_render_smooth);
+
+	//Replacing the viewport widget only when it doesn't match the configured rendering mode
+	if(hw_accel_viewport != using_gl)
+	{
+		if(hw_accel_viewport)
+		{
+			QOpenGLWidget *gl_widget=new QOpenGLWidget;
+			QSurfaceFormat fmt=QSurfaceFormat::defaultFormat();
+
+			//Enabling multisampling so the vector contents keep smooth edges when composited by the GPU
+			fmt.setSamples(disable_render_smooth ? 0 : 4);
+			gl_widget->setFormat(fmt);
+
+			/* Partial viewport updates aren't supported by the OpenGL backend, the whole
+			 * viewport is redrawn (composited by the GPU) on every update */
+			viewport->setViewport(gl_widget);
+			viewport->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+		}
+		else
+		{
+			viewport->setViewport(new QWidget);
+			viewport->setViewportUpdateMode(QGraphicsView::BoundingRectViewportUpdate);
+		}
+
+		/* The viewport replacement resets some properties of the previous widget
+		 * so the background caching and mouse tracking must be configured again */
+		viewport->setCacheMode(QGraphicsView::CacheBackground);
+		viewport->setMouseTracking(true);
+	}
 }
 
 void ModelWidget::update()
@@ -1855,10 +2000,11 @@ void ModelWidget::saveModel()
 
 void ModelWidget::saveModel(const QString &filename)
 {
+	//Viewer mode sessions never write back to the model file
+	if(viewer_mode)
+		return;
+
 	TaskProgressWidget task_prog_wgt(this);
-	QString bkpfile;
-	QTemporaryFile tmpfile;
-	bool exists = QFile::exists(filename);
 
 	try
 	{
@@ -1866,58 +2012,62 @@ void ModelWidget::saveModel(const QString &filename)
 		task_prog_wgt.setWindowTitle(tr("Saving database model"));
 		task_prog_wgt.show();
 
-		/* If the original file exists we need to make a back first to avoid
-		 * in order to recover it in case of failures */
-		if(exists)
-		{
-			// Generate a temporary backup file
-			tmpfile.setAutoRemove(false);
-			tmpfile.setFileTemplate(GlobalAttributes::getTemporaryFilePath(QString("%1_XXXXXX.dbk").arg(this->db_model->getName())));
-			tmpfile.open();
-			bkpfile = tmpfile.fileName();
-			tmpfile.close();
-			tmpfile.remove();
-
-			/* Copy the original database model file prior to the saving to store
-			 * its last state in a safe place (temporary storage of the tool ~/.config/pgmodeler by default */
-			QFile::copy(filename, bkpfile);
-
-			// Remove the original filename before create a new one in the same path
-			QFile::remove(filename);
-		}
+		//Waits for a previous model file writing eventually still in progress
+		model_save_future.waitForFinished();
 
 		saveLastCanvasPosition();
-		db_model->saveModel(filename, SchemaParser::XmlDefinition);
+
+		/* The xml definition works as a snapshot of the model: it is generated here in the GUI
+		 * thread (the model can't be read safely while being edited) while the disk writing, where
+		 * the multisecond stall and the corruption risk lived, happens on a worker thread through
+		 * an atomic replace (see DatabaseModel::writeModelBuffer()), unblocking the interface
+		 * right away. A crash mid-write leaves the previous file contents untouched */
+		QByteArray buffer=db_model->getCodeDefinition(SchemaParser::XmlDefinition).toUtf8();
+		QString file=filename;
+
 		this->filename=filename;
 
 		task_prog_wgt.close();
 		disconnect(db_model, nullptr, &task_prog_wgt, nullptr);
 		setModified(false);
 
-		/* Doing a final check to the file regarding its size.
-		 * If we have a zero-byte file something went wrong during the saving process (disk failure, thread errors, etc)
-		 * so we raise an error to the user and restore the backup file to its original path */
-		if(QFileInfo(filename).size() == 0)
-			throw Exception(Exception::getErrorMessage(ErrorCode::ModelFileInvalidSize).arg(filename).arg(bkpfile),
-											ErrorCode::ModelFileInvalidSize,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		model_save_error.clear();
+		model_save_future=QtConcurrent::run([this, file, buffer](){
+			try
+			{
+				DatabaseModel::writeModelBuffer(file, buffer);
+			}
+			catch(Exception &e)
+			{
+				model_save_error=e.getErrorMessage();
+			}
+		});
 
-		if(exists)
-			QFile::remove(bkpfile);
+		model_save_watcher.setFuture(model_save_future);
 	}
 	catch(Exception &e)
 	{
-		if(exists && QFile::exists(bkpfile))
-		{
-			QFile::remove(filename);
-			QFile::copy(bkpfile, filename);
-		}
-
 		task_prog_wgt.close();
 		disconnect(db_model, nullptr, &task_prog_wgt, nullptr);
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
 
+void ModelWidget::handleModelSaveFinished()
+{
+	if(model_save_error.isEmpty())
+		return;
+
+	/* The file writing failed after the interface already flagged the model as saved, so the
+	 * modified state is restored and the user is warned. The atomic replace guarantees the
+	 * file on disk still holds its previous contents */
+	setModified(true);
+
+	Messagebox msg_box;
+	msg_box.show(tr("Could not save the model file <strong>%1</strong>! The file was left untouched with its previous contents. Error: %2")
+							 .arg(filename).arg(model_save_error), Messagebox::ErrorIcon);
+}
+
 QString ModelWidget::getFilename()
 {
 	return this->filename;
@@ -1928,6 +2078,37 @@ QString ModelWidget::getTempFilename()
 	return this->tmp_filename;
 }
 
+void ModelWidget::saveTemporaryModel()
+{
+	//Skips the snapshot when the model didn't really change since the last saving
+	if(mod_notif_count == tmp_saved_notif_count)
+		return;
+
+	//Waits for a previous snapshot writing eventually still in progress
+	tmp_save_future.waitForFinished();
+
+	/* The xml code is generated here, in the GUI thread, since the model can't be read
+	 * safely while being edited. Only the buffer writing, which involves disk latency,
+	 * is handed to a worker thread. The atomic replace guarantees that the recovery
+	 * form never sees a partially written temporary file */
+	QByteArray buffer = db_model->getCodeDefinition(SchemaParser::XmlDefinition).toUtf8();
+	QString filename = tmp_filename;
+
+	tmp_saved_notif_count = mod_notif_count;
+
+	tmp_save_future = QtConcurrent::run([filename, buffer](){
+		try
+		{
+			UtilsNs::saveFileAtomic(filename, buffer);
+		}
+		catch(Exception &)
+		{
+			/* Failures are ignored since the temporary model saving is a best-effort
+			 * mechanism and a new attempt happens in the next saving interval */
+		}
+	});
+}
+
 int ModelWidget::openEditingForm(QWidget *widget, unsigned button_conf)
 {
 	BaseForm editing_form(this);
@@ -1952,13 +2133,35 @@ int ModelWidget::openEditingForm(QWidget *widget, unsigned button_conf)
 	res = editing_form.exec();
 	GeneralConfigWidget::saveWidgetGeometry(&editing_form, class_name);
 
+	/* Cached editing widgets are detached from the dialog before its destruction,
+	 * otherwise they'd be destroyed together, invalidating the cache entries */
+	for(auto &itr : editing_wgts_cache)
+	{
+		if(itr.second==widget)
+		{
+			widget->setParent(nullptr);
+			break;
+		}
+	}
+
 	return res;
 }
 
+template<class WidgetClass>
+WidgetClass *ModelWidget::getEditingWidget()
+{
+	QString class_name=WidgetClass::staticMetaObject.className();
+
+	if(!editing_wgts_cache.count(class_name))
+		editing_wgts_cache[class_name]=new WidgetClass;
+
+	return dynamic_cast<WidgetClass *>(editing_wgts_cache[class_name]);
+}
+
 template<class Class, class WidgetClass>
 int ModelWidget::openEditingForm(BaseObject *object)
 {
-	WidgetClass *object_wgt=new WidgetClass;
+	WidgetClass *object_wgt=getEditingWidget<WidgetClass>();
 	object_wgt->setAttributes(db_model, op_list, dynamic_cast<Class *>(object));
 	return openEditingForm(object_wgt);
 }
@@ -1966,7 +2169,7 @@ int ModelWidget::openEditingForm(BaseObject *object)
 template<class Class, class WidgetClass, class ParentClass>
 int ModelWidget::openEditingForm(BaseObject *object, BaseObject *parent_obj)
 {
-	WidgetClass *object_wgt=new WidgetClass;
+	WidgetClass *object_wgt=getEditingWidget<WidgetClass>();
 	object_wgt->setAttributes(db_model, op_list, dynamic_cast<ParentClass *>(parent_obj), dynamic_cast<Class *>(object));
 	return openEditingForm(object_wgt);
 }
@@ -1974,14 +2177,25 @@ int ModelWidget::openEditingForm(BaseObject *object, BaseObject *parent_obj)
 template<class Class, class WidgetClass, class ParentClass>
 int ModelWidget::openEditingForm(BaseObject *object, BaseObject *parent_obj, const QPointF &pos)
 {
-	WidgetClass *object_wgt=new WidgetClass;
+	WidgetClass *object_wgt=getEditingWidget<WidgetClass>();
 	object_wgt->setAttributes(db_model, op_list, dynamic_cast<ParentClass *>(parent_obj), dynamic_cast<Class *>(object), pos.x(), pos.y());
 	return openEditingForm(object_wgt);
 }
 
 int ModelWidget::openTableEditingForm(ObjectType tab_type, PhysicalTable *object, Schema *schema, const QPointF &pos)
 {
-	TableWidget *tab_wgt=new TableWidget(nullptr, tab_type);
+	/* TableWidget instances are cached per table type since the constructor
+	 * configures the form differently for tables and foreign tables */
+	QString wgt_key=QString("TableWidget.%1").arg(BaseObject::getSchemaName(tab_type));
+	TableWidget *tab_wgt=nullptr;
+
+	if(editing_wgts_cache.count(wgt_key))
+		tab_wgt=dynamic_cast<TableWidget *>(editing_wgts_cache[wgt_key]);
+	else
+	{
+		tab_wgt=new TableWidget(nullptr, tab_type);
+		editing_wgts_cache[wgt_key]=tab_wgt;
+	}
 
 	if(tab_type == ObjectType::Table)
 		tab_wgt->setAttributes(db_model, op_list, schema, dynamic_cast<Table *>(object), pos.x(), pos.y());
@@ -2099,7 +2313,7 @@ void ModelWidget::showObjectForm(ObjectType obj_type, BaseObject *object, BaseOb
 		}
 		else if(obj_type==ObjectType::BaseRelationship || obj_type==ObjectType::Relationship)
 		{
-			RelationshipWidget *relationship_wgt=new RelationshipWidget;
+			RelationshipWidget *relationship_wgt=getEditingWidget<RelationshipWidget>();
 
 			if(!object && rel_type > 0 &&
 					selected_objects.size() > 0 &&
@@ -2118,12 +2332,14 @@ void ModelWidget::showObjectForm(ObjectType obj_type, BaseObject *object, BaseOb
 		}
 		else if(obj_type==ObjectType::Textbox)
 		{
-			TextboxWidget *textbox_wgt=new TextboxWidget;
+			TextboxWidget *textbox_wgt=getEditingWidget<TextboxWidget>();
 			textbox_wgt->setAttributes(db_model, op_list, dynamic_cast<Textbox *>(object), obj_pos.x(), obj_pos.y());
 			res=openEditingForm(textbox_wgt);
 		}
 		else if(obj_type==ObjectType::Permission)
 		{
+			/* The permission widget isn't cached/reused since its setAttributes()
+			 * creates connections that would be duplicated at each usage */
 			PermissionWidget *permission_wgt=new PermissionWidget;
 			Permission *perm=dynamic_cast<Permission *>(object);
 			permission_wgt->setAttributes(db_model, nullptr, (perm ? perm->getObject() : object));
@@ -2131,7 +2347,7 @@ void ModelWidget::showObjectForm(ObjectType obj_type, BaseObject *object, BaseOb
 		}
 		else if(obj_type==ObjectType::GenericSql)
 		{
-			GenericSQLWidget *genericsql_wgt=new GenericSQLWidget;
+			GenericSQLWidget *genericsql_wgt=getEditingWidget<GenericSQLWidget>();
 			genericsql_wgt->setAttributes(db_model, op_list, dynamic_cast<GenericSQL *>(object));
 			res=openEditingForm(genericsql_wgt);
 		}
@@ -2147,7 +2363,7 @@ void ModelWidget::showObjectForm(ObjectType obj_type, BaseObject *object, BaseOb
 			res=openEditingForm<Procedure, ProcedureWidget, Schema>(object, sel_schema);
 		else
 		{
-			DatabaseWidget *database_wgt=new DatabaseWidget;
+			DatabaseWidget *database_wgt=getEditingWidget<DatabaseWidget>();
 			database_wgt->setAttributes(db_model);
 			res=openEditingForm(database_wgt);
 		}
@@ -2820,14 +3036,31 @@ void ModelWidget::pasteObjects(bool duplicate_mode)
 
 	/* The third step is get the XML code definition of the copied objects, is
 	with the xml code that the copied object are created and inserted on the model */
+
+	/* Pre-generating, using all the CPU cores, the code of the top-level copied objects so the
+	 * serial loop below mostly reads the populated caches. Objects pasted into a table/view
+	 * (table children) are excluded since their code depends on a temporary parent table swap,
+	 * and tables duplicated in the same model too because their code comes from a special
+	 * variant that includes the relationship-added children */
+	map<unsigned, BaseObject *> pregen_objs;
+
+	for(auto &obj : copied_objects)
+	{
+		obj->setCodeInvalidated(true);
+
+		if(!dynamic_cast<TableObject *>(obj) && !(duplicate_mode && dynamic_cast<Table *>(obj)))
+			pregen_objs[obj->getObjectId()]=obj;
+	}
+
+	if(pregen_objs.size() > 1)
+		db_model->generateCodeInParallel(pregen_objs, SchemaParser::XmlDefinition);
+
 	itr=copied_objects.begin();
 	itr_end=copied_objects.end();
 	pos=0;
 	while(itr!=itr_end)
 	{
 		object=(*itr);
-		object->setCodeInvalidated(true);
-
 		tab_obj=dynamic_cast<TableObject *>(object);
 		itr++;
 
@@ -4379,10 +4612,14 @@ void ModelWidget::configureDatabaseActions()
 	popup_menu.addSeparator();
 	popup_menu.addAction(action_source_code);
 
-	if(db_model->isProtected())
-		popup_menu.addAction(action_unprotect);
-	else
-		popup_menu.addAction(action_protect);
+	//In viewer mode the protection can't be toggled otherwise the model would become editable
+	if(!viewer_mode)
+	{
+		if(db_model->isProtected())
+			popup_menu.addAction(action_unprotect);
+		else
+			popup_menu.addAction(action_protect);
+	}
 
 	if(scene->items().count() > 1)
 		popup_menu.addAction(action_select_all);
@@ -4562,6 +4799,25 @@ bool ModelWidget::isModified()
 	return modified;
 }
 
+void ModelWidget::setViewerMode(bool value)
+{
+	viewer_mode=value;
+
+	/* Operations stop being recorded so no object copies are allocated for a session
+	 * that will never undo/redo anything */
+	op_list->setRegisterEnabled(!value);
+
+	/* Protecting the whole model reuses all the existing gates that reject editing
+	 * operations over protected objects */
+	db_model->setProtected(value);
+	protected_model_frm->setVisible(db_model->isProtected());
+}
+
+bool ModelWidget::isViewerMode()
+{
+	return viewer_mode;
+}
+
 DatabaseModel *ModelWidget::getDatabaseModel()
 {
 	return db_model;
@@ -4592,6 +4848,11 @@ void ModelWidget::setRenderSmoothnessDisabled(bool value)
 	ModelWidget::disable_render_smooth=value;
 }
 
+void ModelWidget::setHardwareAcceleratedViewport(bool value)
+{
+	ModelWidget::hw_accel_viewport=value;
+}
+
 void ModelWidget::setSimplifiedObjectCreation(bool value)
 {
 	ModelWidget::simple_obj_creation=value;
@@ -5521,6 +5782,10 @@ void ModelWidget::updateMagnifierArea()
 
 void ModelWidget::showMagnifierArea(bool show)
 {
+	/* Since the magnifier renders the scene at 100% zoom the tables' full level of
+	 * detail is restored while it is visible */
+	scene->setLevelOfDetailZoom(show ? 1 : current_zoom);
+
 	if(show)
 	{
 		updateMagnifierArea();
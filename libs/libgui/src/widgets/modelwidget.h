@@ -51,11 +51,35 @@ class ModelWidget: public QWidget {
 		//! \brief Current zoom aplied to the scene
 		double current_zoom;
 
+		/*! \brief Counts the modification notifications (see setModified). It is used to detect
+		if the model really changed between two temporary model savings */
+		unsigned mod_notif_count,
+
+		//! \brief Stores the modification notification count of the last temporary model saving
+		tmp_saved_notif_count;
+
+		//! \brief Holds the temporary model writing in progress on a worker thread (see saveTemporaryModel)
+		QFuture<void> tmp_save_future,
+
+		//! \brief Holds the model file writing in progress on a worker thread (see saveModel)
+		model_save_future;
+
+		//! \brief Notifies the widget when the background model file writing finishes (see handleModelSaveFinished)
+		QFutureWatcher<void> model_save_watcher;
+
+		/*! \brief Holds the error message of a failed background model file writing. It is written by the
+		worker thread and read by handleModelSaveFinished() only after the future finishes */
+		QString model_save_error;
+
 		//! \brief Indicates if the model was modified by some operation
 		bool modified,
 
 		//! \brief Indicates if the panning mode was activated via event filter (see eventFilter())
-		panning_mode;
+		panning_mode,
+
+		/*! \brief Indicates that the model was opened for reading only (see setViewerMode). In this mode
+		the undo/redo history is disabled and all editing operations are blocked */
+		viewer_mode;
 
 		/*! \brief Indicates if the cut operation is currently activated. This flag modifies
 		the way the methods copyObjects() and removeObject() works. */
@@ -67,7 +91,11 @@ class ModelWidget: public QWidget {
 		//! \brief Indicates that graphical objects like table, view and textboxes can be created without click canvas (direclty from their editing form)
 		simple_obj_creation,
 
-		disable_render_smooth;
+		disable_render_smooth,
+
+		/*! \brief Indicates that the canvas viewport must be backed by an OpenGL widget so the rendering
+		is composited by the GPU (see setHardwareAcceleratedViewport()) */
+		hw_accel_viewport;
 
 		//! \brief Indicates if the minimum object opacity used when appliyng fade out to objects
 		static double min_object_opacity;
@@ -171,6 +199,16 @@ class ModelWidget: public QWidget {
 		//! \brief This timer controls the interval the zoom label is visible
 		QTimer zoom_info_timer;
 
+		/*! \brief Stores single reusable instances of the object editing widgets. The instances are
+		constructed upon the first usage (see getEditingWidget) and destroyed together with the model
+		widget, so the construction cost of the heavier forms is paid only once per type */
+		map<QString, QWidget *> editing_wgts_cache;
+
+		/*! \brief Returns the single instance of the provided editing widget class, constructing it
+		upon the first call. The returned widget is reconfigured via setAttributes() before each usage */
+		template<class WidgetClass>
+		WidgetClass *getEditingWidget();
+
 		//! \brief Opens a editing form for objects at database level
 		template<class Class, class WidgetClass>
 		int openEditingForm(BaseObject *object);
@@ -365,6 +403,15 @@ class ModelWidget: public QWidget {
 		//! \brief Returns if the model is modified or not
 		bool isModified();
 
+		/*! \brief Puts the model in viewer (read-only) mode. The operation history stops being recorded,
+		the whole model is protected so the editing actions are rejected, and saving is disabled. This
+		makes opening a model just for reading considerably cheaper since no undo/redo copies are ever
+		allocated. Must be called right after loadModel() */
+		void setViewerMode(bool value);
+
+		//! \brief Returns if the model was opened in viewer (read-only) mode
+		bool isViewerMode();
+
 		//! \brief Returns the reference database model
 		DatabaseModel *getDatabaseModel();
 
@@ -383,6 +430,11 @@ class ModelWidget: public QWidget {
 		//! \brief Defines if any instance of the class must disable rendering smoothness improving performance
 		static void setRenderSmoothnessDisabled(bool value);
 
+		/*! \brief Enables the OpenGL backed canvas viewport for all instances of the class. GPU compositing
+		greatly improves the panning/zooming frame rate on high resolution (4K/scaled) displays. The mode is
+		applied to already created viewports on the next call to updateRenderHints() */
+		static void setHardwareAcceleratedViewport(bool value);
+
 		//! \brief Defines if any instance of the class must simiplify the graphical object's creation
 		static void setSimplifiedObjectCreation(bool value);
 
@@ -562,10 +614,20 @@ class ModelWidget: public QWidget {
 		 * so the correct info is written into the xml code of the model file */
 		void updateModelLayersInfo();
 
+		/*! \brief Handles the finishing of a background model file writing started by saveModel(),
+		warning the user and restoring the modified state when the writing failed */
+		void handleModelSaveFinished();
+
 	public slots:
 		void loadModel(const QString &filename);
 		void saveModel(const QString &filename);
 		void saveModel();
+
+		/*! \brief Saves the temporary model file (the one recovered by ModelRestorationForm) if the
+		model really changed since the last call. The xml code is generated in the calling (GUI) thread
+		since the model can't be read safely while being edited, but the file writing is performed by a
+		worker thread that atomically replaces the destination file */
+		void saveTemporaryModel();
 		void printModel(QPrinter *printer, bool print_grid, bool print_page_nums);
 		void update();
 
@@ -408,7 +408,7 @@ void ObjectFinderWidget::updateObjectTable(QTableWidget *tab_wgt, vector<BaseObj
 			fnt=tab_item->font();
 
 			tab_item->setText(objs[i]->getName());
-			tab_item->setIcon(QPixmap(GuiUtilsNs::getIconPath(BaseObject::getSchemaName(objs[i]->getObjectType()) + str_aux)));
+			tab_item->setIcon(GuiUtilsNs::getCachedIcon(BaseObject::getSchemaName(objs[i]->getObjectType()) + str_aux));
 			if(new_row) tab_wgt->setItem(lin_idx, 0, tab_item);
 			if(checkable_items)	tab_item->setCheckState(Qt::Checked);
 
@@ -483,7 +483,7 @@ void ObjectFinderWidget::updateObjectTable(QTableWidget *tab_wgt, vector<BaseObj
 					}
 
 					tab_item->setFont(fnt);
-					tab_item->setIcon(QPixmap(GuiUtilsNs::getIconPath(parent_obj->getObjectType())));
+					tab_item->setIcon(GuiUtilsNs::getCachedIcon(parent_obj->getObjectType()));
 				}
 			}
 
@@ -532,7 +532,7 @@ void ObjectFinderWidget::updateObjectTypeList(QListWidget *list_wgt)
 {
 	vector<ObjectType> types=BaseObject::getObjectTypes();
 	QListWidgetItem *item=nullptr;
-	QPixmap icon;
+	QIcon icon;
 	QString str_aux;
 
 	if(list_wgt)
@@ -549,7 +549,7 @@ void ObjectFinderWidget::updateObjectTypeList(QListWidget *list_wgt)
 			else
 				str_aux=QString(BaseObject::getSchemaName(types[type_id]));
 
-			icon=QPixmap(GuiUtilsNs::getIconPath(str_aux));
+			icon=GuiUtilsNs::getCachedIcon(str_aux);
 
 			item->setText(BaseObject::getTypeName(types[type_id]));
 			item->setIcon(icon);
@@ -225,7 +225,10 @@ void ObjectRenameWidget::applyRenaming()
 			if(revalidate_rels)
 				model->validateRelationships();
 
-			model->setCodesInvalidated();
+			/* Invalidating the code of only the renamed objects and their dependents
+			 * instead of forcing the regeneration of the whole model */
+			for(itr = sel_objs_map.rbegin(); itr != sel_objs_map.rend(); itr++)
+				model->setCodesInvalidated(itr->second);
 			accept();
 		}
 	}
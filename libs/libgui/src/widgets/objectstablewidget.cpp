@@ -348,20 +348,60 @@ void ObjectsTableWidget::addRow(unsigned lin_idx)
 
 	for(col_idx=0; col_idx < col_cont; col_idx++)
 	{
-		item=new QTableWidgetItem;		
+		item=new QTableWidgetItem;
 		table_tbw->setItem(lin_idx,col_idx,item);
 	}
 
-	item=table_tbw->item(lin_idx,0);
-	item->setSelected(true);
-	table_tbw->setCurrentItem(item);
+	/* The row selection is updated only when the signals aren't blocked. Forms that populate
+	 * the grid programmatically block the signals beforehand, so we avoid touching the selection
+	 * (and repainting the viewport) once per inserted row */
+	if(!signalsBlocked())
+	{
+		item=table_tbw->item(lin_idx,0);
+		item->setSelected(true);
+		table_tbw->setCurrentItem(item);
+	}
+}
+
+void ObjectsTableWidget::addRows(unsigned count)
+{
+	QTableWidgetItem *item=nullptr;
+	unsigned lin_idx, col_idx,
+			row_cnt=table_tbw->rowCount(),
+			col_cnt=table_tbw->columnCount();
+
+	if(count == 0)
+		return;
+
+	table_tbw->setUpdatesEnabled(false);
+	table_tbw->setRowCount(row_cnt + count);
+
+	for(lin_idx=row_cnt; lin_idx < row_cnt + count; lin_idx++)
+	{
+		item=new QTableWidgetItem;
+		item->setText(QString("%1").arg(lin_idx+1));
+		table_tbw->setVerticalHeaderItem(lin_idx,item);
+
+		for(col_idx=0; col_idx < col_cnt; col_idx++)
+		{
+			item=new QTableWidgetItem;
+			table_tbw->setItem(lin_idx,col_idx,item);
+		}
+	}
+
+	table_tbw->resizeRowsToContents();
+	table_tbw->setUpdatesEnabled(true);
+	setButtonsEnabled();
 }
 
 void ObjectsTableWidget::addRow()
 {
 	this->addRow(table_tbw->rowCount());
 	setButtonsEnabled();
-	table_tbw->resizeRowsToContents();
+
+	//In bulk population (signals blocked) the rows are resized in a single pass afterwards
+	if(!signalsBlocked())
+		table_tbw->resizeRowsToContents();
 
 	emit s_rowAdded(table_tbw->rowCount()-1);
 }
@@ -114,9 +114,15 @@ class ObjectsTableWidget: public QWidget, public Ui::ObjectsTableWidget {
 		//! \brief Adds a new column at the specified index
 		void addColumn(unsigned col_idx);
 
-		//! \brief Adds a new row at the specified index
+		/*! \brief Adds a new row at the specified index. When the widget's signals are blocked the row
+		selection isn't updated, avoiding per-row selection/viewport updates during bulk population */
 		void addRow(unsigned lin_idx);
 
+		/*! \brief Appends the specified amount of empty rows at once in a single batch. This method is way faster
+		than calling addRow() repeatedly when populating the grid with a large amount of rows since the
+		viewport updates and row resizings are performed only once after all rows are created */
+		void addRows(unsigned count);
+
 		//! \brief Returns the row index currently selected
 		int getSelectedRow();
 
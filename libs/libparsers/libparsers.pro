@@ -7,10 +7,13 @@ windows: DESTDIR = $$PWD
 HEADERS += src/schemaparser.h \
 	   src/xmlparser.h \
 	   src/attribsmap.h \
+	   src/smallvector.h \
+	   src/codecachestore.h \
 	    src/attributes.h
 
 SOURCES += src/schemaparser.cpp \
 	   src/xmlparser.cpp \
+	   src/codecachestore.cpp \
     src/attributes.cpp
 
 unix|windows: LIBS += $$LIBUTILS_LIB $$XML_LIB
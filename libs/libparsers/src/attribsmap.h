@@ -20,7 +20,9 @@
 \ingroup libparsers
 \typedef attribs_map
 \brief This typedef is used to replace maps with the signature map<QString,QString> commonly used
-to store objects attributes and used by SchemaParser, XMLParser and several other classes
+to store objects attributes and used by SchemaParser, XMLParser and several other classes.
+The map nodes are allocated through the pooled allocator (see MemoryPool) because these maps are
+created and destroyed in huge volumes together with the model objects that carry them
 */
 
 #ifndef ATTRIBSMAP_H
@@ -28,5 +30,6 @@ to store objects attributes and used by SchemaParser, XMLParser and several othe
 
 #include <map>
 #include <QString>
-using attribs_map = std::map<QString, QString>;
+#include "memorypool.h"
+using attribs_map = std::map<QString, QString, std::less<QString>, PooledAllocator<std::pair<const QString, QString>>>;
 #endif
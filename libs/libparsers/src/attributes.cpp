@@ -607,6 +607,7 @@ namespace Attributes {
 	TableExtBody("table-ext-body"),
 	TableName("table-name"),
 	TableObject("table-obj"),
+	TableOids("table-oids"),
 	TableSchemaName("table-schema-name"),
 	Tablespace("tablespace"),
 	TableTitle("table-title"),
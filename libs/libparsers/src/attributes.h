@@ -624,6 +624,7 @@ namespace Attributes {
 	TableExtBody,
 	TableName,
 	TableObject,
+	TableOids,
 	TableSchemaName,
 	Tablespace,
 	TableTitle,
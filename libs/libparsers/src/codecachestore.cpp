@@ -0,0 +1,241 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "codecachestore.h"
+#include "globalattributes.h"
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <algorithm>
+
+const QByteArray CodeCacheStore::CacheMagic("pgmodeler-code-cache");
+const quint32 CodeCacheStore::CacheVersion=1;
+const qint64 CodeCacheStore::MaxSize=32 * 1024 * 1024;
+
+bool CodeCacheStore::enabled=false;
+bool CodeCacheStore::loaded=false;
+bool CodeCacheStore::dirty=false;
+QHash<QByteArray, CodeCacheStore::Entry> CodeCacheStore::entries;
+QHash<QString, qint64> CodeCacheStore::file_stamps;
+qint64 CodeCacheStore::usage_seq=0;
+qint64 CodeCacheStore::total_size=0;
+QMutex CodeCacheStore::mtx;
+
+void CodeCacheStore::setEnabled(bool value)
+{
+	static bool save_registered=false;
+
+	enabled=value;
+
+	/* The entries gathered along the process lifetime are flushed to disk a single
+	 * time, right before the application object is destroyed */
+	if(enabled && !save_registered)
+	{
+		qAddPostRoutine(CodeCacheStore::saveCache);
+		save_registered=true;
+	}
+}
+
+bool CodeCacheStore::isEnabled()
+{
+	return enabled;
+}
+
+QString CodeCacheStore::getCacheFilePath()
+{
+	return GlobalAttributes::getConfigurationsDir() +
+				 GlobalAttributes::DirSeparator +
+				 QString("code-cache") + GlobalAttributes::ModelCacheExt;
+}
+
+QByteArray CodeCacheStore::makeKey(const QString &filename, const attribs_map &attribs)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha256);
+	qint64 file_stamp=0;
+
+	/* The stamps hash is shared by the parallel code generation workers so its
+	 * lookup/insertion must happen under the same mutex lookup()/store() take */
+	{
+		QMutexLocker locker(&mtx);
+		auto itr=file_stamps.find(filename);
+
+		if(itr==file_stamps.end())
+			itr=file_stamps.insert(filename, QFileInfo(filename).lastModified().toMSecsSinceEpoch());
+
+		file_stamp=itr.value();
+	}
+
+	/* The application version and the modification timestamp of the schema file take part
+	 * in the key so entries produced by another version of pgModeler or by an outdated
+	 * copy of the template are never fetched */
+	hash.addData(GlobalAttributes::PgModelerVersion.toUtf8());
+	hash.addData("\1");
+	hash.addData(filename.toUtf8());
+	hash.addData("\1");
+	hash.addData(QByteArray::number(file_stamp));
+
+	for(auto &attrib : attribs)
+	{
+		hash.addData("\1");
+		hash.addData(attrib.first.toUtf8());
+		hash.addData("\2");
+		hash.addData(attrib.second.toUtf8());
+	}
+
+	return hash.result();
+}
+
+bool CodeCacheStore::lookup(const QByteArray &key, QString &code)
+{
+	QMutexLocker locker(&mtx);
+
+	if(!loaded)
+		loadCache();
+
+	auto itr=entries.find(key);
+
+	if(itr==entries.end())
+		return false;
+
+	itr->last_used=++usage_seq;
+	code=itr->code;
+	return true;
+}
+
+void CodeCacheStore::store(const QByteArray &key, const QString &code)
+{
+	QMutexLocker locker(&mtx);
+
+	if(!loaded)
+		loadCache();
+
+	if(entries.contains(key))
+		return;
+
+	entries.insert(key, { code, ++usage_seq });
+	total_size+=code.size();
+	dirty=true;
+}
+
+void CodeCacheStore::loadCache()
+{
+	QFile cache_file(getCacheFilePath());
+	QByteArray magic, data, key;
+	QString pgm_version, code;
+	quint32 version=0, entry_cnt=0;
+	qint64 last_used=0;
+
+	loaded=true;
+
+	if(!cache_file.open(QFile::ReadOnly))
+		return;
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream >> magic >> version >> pgm_version;
+
+	/* Code cached by another version of pgModeler is discarded since the same
+	 * evaluation may produce a different definition */
+	if(stream.status()!=QDataStream::Ok ||
+			magic!=CacheMagic || version!=CacheVersion ||
+			pgm_version!=GlobalAttributes::PgModelerVersion)
+		return;
+
+	stream >> data;
+	data=qUncompress(data);
+
+	if(data.isEmpty())
+		return;
+
+	QDataStream buf_stream(data);
+	buf_stream.setVersion(QDataStream::Qt_5_0);
+	buf_stream >> entry_cnt;
+
+	for(quint32 i=0; i < entry_cnt; i++)
+	{
+		buf_stream >> key >> code >> last_used;
+		entries.insert(key, { code, last_used });
+		total_size+=code.size();
+		usage_seq=std::max(usage_seq, last_used);
+	}
+
+	if(buf_stream.status()!=QDataStream::Ok)
+	{
+		entries.clear();
+		total_size=0;
+	}
+}
+
+void CodeCacheStore::evictEntries()
+{
+	if(total_size <= MaxSize)
+		return;
+
+	std::vector<std::pair<qint64, QByteArray>> ordered_keys;
+	ordered_keys.reserve(entries.size());
+
+	for(auto itr=entries.constBegin(); itr!=entries.constEnd(); itr++)
+		ordered_keys.push_back(std::make_pair(itr.value().last_used, itr.key()));
+
+	std::sort(ordered_keys.begin(), ordered_keys.end());
+
+	for(auto &ord_key : ordered_keys)
+	{
+		if(total_size <= MaxSize)
+			break;
+
+		total_size-=entries[ord_key.second].code.size();
+		entries.remove(ord_key.second);
+		dirty=true;
+	}
+}
+
+void CodeCacheStore::saveCache()
+{
+	QMutexLocker locker(&mtx);
+
+	if(!dirty)
+		return;
+
+	evictEntries();
+
+	QFile cache_file(getCacheFilePath());
+	QByteArray data;
+
+	/* The cache is a best-effort optimization so failures when writing
+	 * it must never disturb the application shutdown */
+	if(!cache_file.open(QFile::WriteOnly))
+		return;
+
+	QDataStream buf_stream(&data, QIODevice::WriteOnly);
+	buf_stream.setVersion(QDataStream::Qt_5_0);
+	buf_stream << static_cast<quint32>(entries.size());
+
+	for(auto itr=entries.constBegin(); itr!=entries.constEnd(); itr++)
+		buf_stream << itr.key() << itr.value().code << itr.value().last_used;
+
+	QDataStream stream(&cache_file);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << CacheMagic << CacheVersion << GlobalAttributes::PgModelerVersion;
+	stream << qCompress(data);
+	cache_file.close();
+	dirty=false;
+}
@@ -0,0 +1,111 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libparsers
+\class CodeCacheStore
+\brief Implements a persistent LRU cache for the code produced by SchemaParser evaluations.
+Entries are keyed by a content hash of the schema file and the whole attributes map used in
+the evaluation, so regenerating the code of unchanged objects -- even from a fresh process --
+is a cache fetch instead of a template evaluation (see SchemaParser::getCodeDefinition()).
+*/
+
+#ifndef CODE_CACHE_STORE_H
+#define CODE_CACHE_STORE_H
+
+#include "attribsmap.h"
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+
+class CodeCacheStore {
+	private:
+		//! \brief A cached code definition together with its last usage stamp (see usage_seq)
+		struct Entry {
+			QString code;
+			qint64 last_used;
+		};
+
+		//! \brief Magic bytes that identify a code cache file
+		static const QByteArray CacheMagic;
+
+		//! \brief Current version of the code cache file format
+		static const quint32 CacheVersion;
+
+		//! \brief Indicates that the persistent cache is enabled (see setEnabled())
+		static bool enabled,
+
+		//! \brief Indicates that the cache file was already loaded in the current process
+		loaded,
+
+		//! \brief Indicates that the in-memory entries diverged from the persisted ones
+		dirty;
+
+		//! \brief In-memory image of the cache, keyed by the content hash of the evaluations
+		static QHash<QByteArray, Entry> entries;
+
+		/*! \brief Modification timestamps of the schema files already hashed, avoiding
+		one stat() call per evaluation (see makeKey()) */
+		static QHash<QString, qint64> file_stamps;
+
+		//! \brief Monotonic counter used to stamp the entries for the LRU eviction
+		static qint64 usage_seq,
+
+		//! \brief Total amount of bytes of cached code currently held
+		total_size;
+
+		//! \brief Maximum amount of bytes of cached code kept on eviction (see evictEntries())
+		static const qint64 MaxSize;
+
+		//! \brief Controls the concurrent access to the cache from parallel code generations
+		static QMutex mtx;
+
+		//! \brief Returns the path of the file in which the cache is persisted
+		static QString getCacheFilePath();
+
+		//! \brief Loads the persisted entries, discarding caches written by another version
+		static void loadCache();
+
+		//! \brief Discards the least recently used entries until the size budget is honored
+		static void evictEntries();
+
+	public:
+		/*! \brief Enables the persistent code cache. Upon the first activation the persisted
+		entries are loaded lazily and a save routine is registered to run at the process exit */
+		static void setEnabled(bool value);
+
+		//! \brief Returns true when the persistent code cache is enabled
+		static bool isEnabled();
+
+		/*! \brief Builds the lookup key of an evaluation: a hash covering the application version,
+		the schema file (path and modification timestamp) and the whole attributes map */
+		static QByteArray makeKey(const QString &filename, const attribs_map &attribs);
+
+		/*! \brief Retrieves the code associated to the provided key, returning false on a miss.
+		Hits refresh the usage stamp of the entry so it survives the LRU eviction longer */
+		static bool lookup(const QByteArray &key, QString &code);
+
+		//! \brief Stores the code produced by an evaluation under the provided key
+		static void store(const QByteArray &key, const QString &code);
+
+		/*! \brief Persists the in-memory entries, evicting the least recently used ones that
+		exceed the size budget. Automatically invoked at exit once the cache was enabled */
+		static void saveCache();
+};
+
+#endif
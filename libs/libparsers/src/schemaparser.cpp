@@ -18,7 +18,12 @@
 
 #include "schemaparser.h"
 #include "attributes.h"
+#include "smallvector.h"
 #include "utilsns.h"
+#include "performancecounters.h"
+#include "profilerhooks.h"
+#include "codecachestore.h"
+#include <QDirIterator>
 
 const char SchemaParser::CharComment='#';
 const char SchemaParser::CharLineEnd='\n';
@@ -65,15 +70,89 @@ const QString SchemaParser::TokenLtOper=QString("<");
 const QString SchemaParser::TokenGtEqOper=QString(">=");
 const QString SchemaParser::TokenLtEqOper=QString("<=");
 
-const QRegExp SchemaParser::AttribRegExp=QRegExp("^([a-z])([a-z]*|(\\d)*|(\\-)*|(_)*)+", Qt::CaseInsensitive);
+thread_local const QRegExp SchemaParser::AttribRegExp=QRegExp("^([a-z])([a-z]*|(\\d)*|(\\-)*|(_)*)+", Qt::CaseInsensitive);
+
+std::map<QString, std::shared_ptr<SchemaParser::CompiledBuffer>> SchemaParser::compiled_cache;
+QMutex SchemaParser::compiled_cache_mtx;
+
+QHash<QString, int> SchemaParser::attr_name_ids;
+QStringList SchemaParser::attr_names;
+QMutex SchemaParser::attr_names_mtx;
 
 SchemaParser::SchemaParser()
 {
 	line=column=comment_count=0;
+	attr_epoch=0;
 	ignore_unk_atribs=ignore_empty_atribs=false;
 	pgsql_version=PgSqlVersions::DefaulVersion;
 }
 
+int SchemaParser::internAttribName(const QString &name)
+{
+	QMutexLocker lock(&attr_names_mtx);
+	QHash<QString, int>::const_iterator itr=attr_name_ids.find(name);
+
+	if(itr!=attr_name_ids.end())
+		return itr.value();
+
+	int id=attr_names.size();
+	attr_names.append(name);
+	attr_name_ids.insert(name, id);
+
+	return id;
+}
+
+void SchemaParser::clearAttributes()
+{
+	attr_epoch++;
+
+	/* On the (unlikely) epoch counter wrap around the storage is really cleared,
+	 * otherwise entries stamped in older epochs could be wrongly seen as defined */
+	if(attr_epoch==0)
+	{
+		attr_values.clear();
+		attr_epochs.clear();
+		attr_epoch=1;
+	}
+}
+
+void SchemaParser::loadAttributes(const attribs_map &attribs)
+{
+	clearAttributes();
+
+	for(auto &itr : attribs)
+		setAttribValue(internAttribName(itr.first), itr.second);
+}
+
+bool SchemaParser::isAttribDefined(int attr_id)
+{
+	return attr_id >= 0 &&
+			attr_id < static_cast<int>(attr_epochs.size()) &&
+			attr_epochs[attr_id]==attr_epoch;
+}
+
+const QString &SchemaParser::getAttribValue(int attr_id)
+{
+	static const QString empty_value;
+
+	if(!isAttribDefined(attr_id))
+		return empty_value;
+
+	return attr_values[attr_id];
+}
+
+void SchemaParser::setAttribValue(int attr_id, const QString &value)
+{
+	if(attr_id >= static_cast<int>(attr_values.size()))
+	{
+		attr_values.resize(attr_id + 1);
+		attr_epochs.resize(attr_id + 1, 0);
+	}
+
+	attr_values[attr_id]=value;
+	attr_epochs[attr_id]=attr_epoch;
+}
+
 void SchemaParser::setPgSQLVersion(const QString &pgsql_ver)
 {
 	try
@@ -137,7 +216,8 @@ void SchemaParser::restartParser()
 	/* Clears the buffer and resets the counters for line,
 		column and amount of comments */
 	buffer.clear();
-	attributes.clear();
+	clearAttributes();
+	compiled_buf.reset();
 	line=column=comment_count=0;
 }
 
@@ -207,11 +287,84 @@ void SchemaParser::loadBuffer(const QString &buf)
 
 void SchemaParser::loadFile(const QString &filename)
 {
-	if(!filename.isEmpty())
+	if(filename.isEmpty())
+		return;
+
 	{
-		QString buf(UtilsNs::loadFile(filename));
-		loadBuffer(buf);
-		SchemaParser::filename=filename;
+		QMutexLocker locker(&compiled_cache_mtx);
+		auto itr=compiled_cache.find(filename);
+
+		//Reusing the compiled form of the file in case it was already loaded by any parser instance
+		if(itr!=compiled_cache.end())
+		{
+			restartParser();
+			compiled_buf=itr->second;
+			buffer=compiled_buf->buffer;
+			comment_count=compiled_buf->comment_count;
+			SchemaParser::filename=filename;
+			return;
+		}
+	}
+
+	/* Schema files are immutable runtime assets so they are loaded through the
+	 * process-wide file buffers cache avoiding repeated small-file reads */
+	QString buf(UtilsNs::loadCachedFile(filename));
+
+	loadBuffer(buf);
+	SchemaParser::filename=filename;
+
+	/* Compiles the buffer right away so the tokenized form of the file can be
+	 * shared between all parser instances through the compiled buffers cache */
+	compileBuffer();
+
+	QMutexLocker locker(&compiled_cache_mtx);
+	compiled_cache[filename]=compiled_buf;
+}
+
+void SchemaParser::clearCompiledCache()
+{
+	QMutexLocker locker(&compiled_cache_mtx);
+	compiled_cache.clear();
+}
+
+void SchemaParser::precompileSchemaFiles(const QString &root_dir)
+{
+	QStringList sch_files;
+	QDirIterator dir_itr(root_dir, { QString("*") + GlobalAttributes::SchemaExt },
+											 QDir::Files, QDirIterator::Subdirectories);
+
+	while(dir_itr.hasNext())
+		sch_files.append(dir_itr.next());
+
+	if(sch_files.isEmpty())
+		return;
+
+	/* The file list is pulled from a shared index by low priority workers so the precompilation
+	 * uses the idle cores without delaying operations the user triggers meanwhile. A first use of
+	 * a file not yet precompiled simply compiles it on the spot (loadFile() is thread safe) */
+	auto files=std::make_shared<QStringList>(std::move(sch_files));
+	auto next_idx=std::make_shared<std::atomic<int>>(0);
+	int worker_cnt=qMin(TaskScheduler::getMaxThreadCount(), files->size());
+
+	for(int th=0; th < worker_cnt; th++)
+	{
+		TaskScheduler::run([files, next_idx](){
+			int idx=0;
+			SchemaParser parser;
+
+			while((idx=(*next_idx)++) < files->size())
+			{
+				try
+				{
+					parser.loadFile(files->at(idx));
+				}
+				catch(Exception &)
+				{
+					/* Ignored: the faulty file is compiled again, with proper error reporting,
+					 * when some operation actually evaluates it */
+				}
+			}
+		}, TaskScheduler::LowPriority);
 	}
 }
 
@@ -441,25 +594,159 @@ bool SchemaParser::isSpecialCharacter(char chr)
 			chr==CharStartPlainText || chr==CharEndPlainText;
 }
 
-bool SchemaParser::evaluateComparisonExpr()
+void SchemaParser::compileBuffer()
+{
+	QString cond, meta, word;
+	bool in_if_expr=false, in_set_line=false;
+	int tk_line=0, tk_col=0;
+	char chr;
+
+	compiled_buf.reset(new CompiledBuffer);
+	compiled_buf->buffer=buffer;
+	compiled_buf->comment_count=comment_count;
+	line=column=0;
+
+	while(line < buffer.size())
+	{
+		chr=buffer[line][column].toLatin1();
+		tk_line=line;
+		tk_col=column;
+
+		/* The indirection character (@) is special only in %set instructions, anywhere
+		 * else it is handled as a common word character (see the default case below) */
+		if(in_set_line && chr==CharValueOf)
+		{
+			column++;
+			SchemaToken val_tk(SchemaToken::ValueOf, getAttribute(), tk_line, tk_col);
+			val_tk.attr_id=internAttribName(val_tk.value);
+			compiled_buf->tokens.push_back(val_tk);
+			continue;
+		}
+
+		/* Comparison expressions exist only between %if and %then, anywhere else the
+		 * parenthesis are handled as common word characters */
+		if(in_if_expr && chr==CharStartCompExpr)
+		{
+			compiled_buf->tokens.push_back(compileComparisonExpr());
+			continue;
+		}
+
+		switch(chr)
+		{
+			/* Line end tokens are generated only to delimit %set/%unset instructions since
+			 * line breaks outside plain texts are not part of the generated definition */
+			case CharLineEnd:
+				compiled_buf->tokens.push_back(SchemaToken(SchemaToken::LineEnd, "", tk_line, tk_col));
+				in_set_line=false;
+				line++;
+				column=0;
+			break;
+
+			case CharTabulation:
+			case CharSpace:
+				//The parser will ignore the spaces that are not within pure texts
+				while(buffer[line][column]==CharSpace ||
+							buffer[line][column]==CharTabulation) column++;
+			break;
+
+				//Metacharacter extraction
+			case CharStartMetachar:
+				meta=getMetaCharacter();
+
+				//Checks whether the metacharacter is part of the 'if' expression (this is an error)
+				if(in_if_expr)
+				{
+					throw Exception(Exception::getErrorMessage(ErrorCode::InvalidSyntax)
+									.arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
+									ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
+
+				//Metacharacters are translated at compile time and stored as plain texts
+				compiled_buf->tokens.push_back(SchemaToken(SchemaToken::PlainText, translateMetaCharacter(meta), tk_line, tk_col));
+			break;
+
+				//Attribute extraction
+			case CharStartAttribute:
+			case CharEndAttribute:
+			{
+				SchemaToken attr_tk(SchemaToken::Attribute, getAttribute(), tk_line, tk_col);
+				attr_tk.attr_id=internAttribName(attr_tk.value);
+				compiled_buf->tokens.push_back(attr_tk);
+			}
+			break;
+
+				//Conditional instruction extraction
+			case CharStartConditional:
+				cond=getConditional();
+
+				//Checks whether the extracted token is a valid conditional
+				if(cond!=TokenIf && cond!=TokenElse &&
+						cond!=TokenThen && cond!=TokenEnd &&
+						cond!=TokenOr && cond!=TokenNot &&
+						cond!=TokenAnd && cond!=TokenSet &&
+						cond!=TokenUnset)
+				{
+					throw Exception(Exception::getErrorMessage(ErrorCode::InvalidInstruction)
+									.arg(cond).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
+									ErrorCode::InvalidInstruction,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+				}
+
+				if(cond==TokenIf)
+					in_if_expr=true;
+				else if(cond==TokenThen)
+					in_if_expr=false;
+				else if(cond==TokenSet || cond==TokenUnset)
+					in_set_line=true;
+
+				compiled_buf->tokens.push_back(SchemaToken(SchemaToken::Conditional, cond, tk_line, tk_col));
+			break;
+
+				//Extraction of pure text or simple words
+			default:
+				if(chr==CharStartPlainText ||
+						chr==CharEndPlainText)
+					word=getPlainText();
+				else
+					word=getWord();
+
+				compiled_buf->tokens.push_back(SchemaToken(SchemaToken::PlainText, word, tk_line, tk_col));
+			break;
+		}
+	}
+
+	/* Estimating the size of the produced definitions (plain texts plus a rough guess per
+	 attribute reference) so the output string can be reserved in a single allocation */
+	for(auto &tok : compiled_buf->tokens)
+	{
+		if(tok.type==SchemaToken::PlainText)
+			compiled_buf->est_out_size += tok.value.size();
+		else if(tok.type==SchemaToken::Attribute)
+			compiled_buf->est_out_size += 32;
+	}
+
+	line=column=0;
+}
+
+SchemaParser::SchemaToken SchemaParser::compileComparisonExpr()
 {
 	QString curr_line, attrib, value, oper, valid_op_chrs="=!<>fi", extra_error_msg;
-	bool error=false, end_eval=false, expr_is_true=true;
+	bool error=false, end_extract=false;
 	static QStringList opers = { TokenEqOper, TokenNeOper, TokenGtOper,
 															 TokenLtOper, TokenGtEqOper, TokenLtEqOper };
+	SchemaToken token(SchemaToken::CompExpr, "", line, column);
 
 	try
 	{
 		curr_line=buffer[line];
 		column++;
 
-		while(!end_eval && !error)
+		while(!end_extract && !error)
 		{
 			ignoreBlankChars(curr_line);
 
 			/* If the scan reached the end of the line and the expression was not closed raises an syntax error
 		 Comparison expr must start and end in the same line */
-			if(curr_line[column]==CharLineEnd && !end_eval)
+			if(curr_line[column]==CharLineEnd && !end_extract)
 				error=true;
 
 			switch(curr_line[column].toLatin1())
@@ -505,40 +792,16 @@ bool SchemaParser::evaluateComparisonExpr()
 										.arg(oper).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
 										ErrorCode::InvalidOperatorInExpression,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 					}
-					else if(attributes.count(attrib)==0 && !ignore_unk_atribs)
-					{
-						throw Exception(Exception::getErrorMessage(ErrorCode::UnkownAttribute)
-										.arg(attrib).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
-										ErrorCode::UnkownAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
 					else
 					{
-						QVariant left_val, right_val;
+						/* Stores the expression elements in the resulting token. The expression
+						 * is evaluated only when the code definition is being generated (see evaluateCompExpr()) */
 						value.remove(CharValueDelim);
-
-						//Evaluating the attribute value against the one captured on the expression without casting
-						if(oper.endsWith('f'))
-						{
-							left_val = QVariant(attributes[attrib].toFloat());
-							right_val = QVariant(value.toFloat());
-							oper.remove('f');
-							expr_is_true = getExpressionResult<float>(oper, left_val, right_val);
-						}
-						else if(oper.endsWith('i'))
-						{
-							left_val = QVariant(attributes[attrib].toInt());
-							right_val = QVariant(value.toInt());
-							oper.remove('i');
-							expr_is_true = getExpressionResult<int>(oper, left_val, right_val);
-						}
-						else
-						{
-							left_val = QVariant(attributes[attrib]);
-							right_val = QVariant(value);
-							expr_is_true = getExpressionResult<QString>(oper, left_val, right_val);
-						}
-
-						end_eval=true;
+						token.cmp_attrib=attrib;
+						token.cmp_oper=oper;
+						token.cmp_value=value;
+						token.attr_id=internAttribName(attrib);
+						end_extract=true;
 					}
 				break;
 
@@ -568,7 +831,7 @@ bool SchemaParser::evaluateComparisonExpr()
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
 	}
 
-	if(error && !end_eval && extra_error_msg.isEmpty())
+	if(error && !end_extract && extra_error_msg.isEmpty())
 		extra_error_msg = QString(QT_TR_NOOP("Expected a valid comparison expression `%1 [attribute] [operator] [value] %2'.")).arg(CharStartCompExpr).arg(CharEndCompExpr);
 
 	if(error)
@@ -578,79 +841,126 @@ bool SchemaParser::evaluateComparisonExpr()
 						ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 	}
 
+	return token;
+}
+
+bool SchemaParser::evaluateCompExpr(const SchemaToken &token)
+{
+	QString oper=token.cmp_oper;
+	QVariant left_val, right_val;
+	bool expr_is_true=true;
+
+	if(!isAttribDefined(token.attr_id) && !ignore_unk_atribs)
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::UnkownAttribute)
+						.arg(token.cmp_attrib).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
+						ErrorCode::UnkownAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	//Evaluating the attribute value against the one captured on the expression with the proper casting
+	if(oper.endsWith('f'))
+	{
+		left_val = QVariant(getAttribValue(token.attr_id).toFloat());
+		right_val = QVariant(token.cmp_value.toFloat());
+		oper.remove('f');
+		expr_is_true = getExpressionResult<float>(oper, left_val, right_val);
+	}
+	else if(oper.endsWith('i'))
+	{
+		left_val = QVariant(getAttribValue(token.attr_id).toInt());
+		right_val = QVariant(token.cmp_value.toInt());
+		oper.remove('i');
+		expr_is_true = getExpressionResult<int>(oper, left_val, right_val);
+	}
+	else
+	{
+		left_val = QVariant(getAttribValue(token.attr_id));
+		right_val = QVariant(token.cmp_value);
+		expr_is_true = getExpressionResult<QString>(oper, left_val, right_val);
+	}
+
 	return expr_is_true;
 }
 
-void SchemaParser::defineAttribute()
+void SchemaParser::defineAttribute(const std::vector<SchemaToken> &tokens, unsigned &idx)
 {
-	QString curr_line, attrib, value, new_attrib;
+	QString attrib, value, new_attrib;
 	bool error=false, end_def=false, use_val_as_name=false;
+	int new_attrib_id=-1;
+	unsigned j=idx + 1;
 
 	try
 	{
-		curr_line=buffer[line];
-
-		while(!end_def && !error)
+		while(!end_def && !error && j < tokens.size())
 		{
-			ignoreBlankChars(curr_line);
+			const SchemaToken &tok=tokens[j];
+			line=tok.line;
+			column=tok.column;
 
-			switch(curr_line[column].toLatin1())
+			switch(tok.type)
 			{
-				case CharLineEnd:
+				case SchemaToken::LineEnd:
 					end_def=true;
+					idx=j;
 				break;
 
-				case CharValueOf:
-					if(!use_val_as_name)
+				case SchemaToken::ValueOf:
+					if(!use_val_as_name && new_attrib.isEmpty())
 					{
 						use_val_as_name=true;
-						column++;
-						new_attrib=getAttribute();
+						new_attrib=tok.value;
+						new_attrib_id=tok.attr_id;
 					}
 					else
 						error=true;
 				break;
 
-				case CharStartConditional:
+				//The %set construction must be the only instruction in the line
+				case SchemaToken::Conditional:
 					error=true;
 				break;
 
-				case CharStartAttribute:
+				case SchemaToken::Attribute:
 					if(new_attrib.isEmpty())
-						new_attrib=getAttribute();
+					{
+						new_attrib=tok.value;
+						new_attrib_id=tok.attr_id;
+					}
 					else
 					{
 						//Get the attribute in the middle of the value
-						attrib=getAttribute();
+						attrib=tok.value;
 
-						if(attributes.count(attrib)==0 && !ignore_unk_atribs)
+						if(!isAttribDefined(tok.attr_id) && !ignore_unk_atribs)
 						{
 							throw Exception(Exception::getErrorMessage(ErrorCode::UnkownAttribute)
 											.arg(attrib).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
 											ErrorCode::UnkownAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 						}
 
-						value+=attributes[attrib];
+						value+=getAttribValue(tok.attr_id);
 					}
 				break;
 
-				case CharStartPlainText:
-					value+=getPlainText();
-				break;
-
-				case CharStartMetachar:
-					value += translateMetaCharacter(getMetaCharacter());
+				case SchemaToken::PlainText:
+					value+=tok.value;
 				break;
 
 				default:
-					value+=getWord();
+					error=true;
 				break;
 			}
 
 			//If the attribute name was not extracted yet returns a error
 			if(new_attrib.isEmpty())
 				error=true;
+
+			j++;
 		}
+
+		//Case the instruction is the last one in the buffer and there's no line break after it
+		if(!end_def && !error)
+			idx=j - 1;
 	}
 	catch(Exception &e)
 	{
@@ -659,7 +969,7 @@ void SchemaParser::defineAttribute()
 
 	if(!error)
 	{
-		attrib=(use_val_as_name ? attributes[new_attrib] : new_attrib);
+		attrib=(use_val_as_name ? getAttribValue(new_attrib_id) : new_attrib);
 
 		//Checking if the attribute has a valid name
 		if(!AttribRegExp.exactMatch(attrib))
@@ -669,9 +979,9 @@ void SchemaParser::defineAttribute()
 							ErrorCode::InvalidAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		}
 
-		/* Creates the attribute in the attribute map of the schema, making the attribute
+		/* Creates the attribute in the flat attribute storage, making the attribute
 		 * available on the rest of the script being parsed */
-		attributes[attrib]=value;
+		setAttribValue(use_val_as_name ? internAttribName(attrib) : new_attrib_id, value);
 	}
 	else
 		throw Exception(Exception::getErrorMessage(ErrorCode::InvalidSyntax)
@@ -679,29 +989,31 @@ void SchemaParser::defineAttribute()
 						ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 }
 
-void SchemaParser::unsetAttribute()
+void SchemaParser::unsetAttribute(const std::vector<SchemaToken> &tokens, unsigned &idx)
 {
-	QString curr_line, attrib;
+	QString attrib;
 	bool end_def=false;
+	unsigned j=idx + 1;
 
 	try
 	{
-		curr_line=buffer[line];
-
-		while(!end_def)
+		while(!end_def && j < tokens.size())
 		{
-			ignoreBlankChars(curr_line);
+			const SchemaToken &tok=tokens[j];
+			line=tok.line;
+			column=tok.column;
 
-			switch(curr_line[column].toLatin1())
+			switch(tok.type)
 			{
-				case CharLineEnd:
+				case SchemaToken::LineEnd:
 					end_def=true;
+					idx=j;
 				break;
 
-				case CharStartAttribute:
-					attrib=getAttribute();
+				case SchemaToken::Attribute:
+					attrib=tok.value;
 
-					if(attributes.count(attrib)==0 && !ignore_unk_atribs)
+					if(!isAttribDefined(tok.attr_id) && !ignore_unk_atribs)
 					{
 						throw Exception(Exception::getErrorMessage(ErrorCode::UnkownAttribute)
 										.arg(attrib).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
@@ -714,7 +1026,7 @@ void SchemaParser::unsetAttribute()
 										ErrorCode::InvalidAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 					}
 
-					attributes[attrib]="";
+					setAttribValue(tok.attr_id, "");
 				break;
 
 				default:
@@ -722,46 +1034,44 @@ void SchemaParser::unsetAttribute()
 									.arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
 									ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 			}
+
+			j++;
 		}
+
+		//Case the instruction is the last one in the buffer and there's no line break after it
+		if(!end_def)
+			idx=j - 1;
 	}
 	catch(Exception &e)
 	{
 		throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__,&e);
 	}
 }
-bool SchemaParser::evaluateExpression()
+
+bool SchemaParser::evaluateExpression(const std::vector<SchemaToken> &tokens, unsigned &idx)
 {
-	QString current_line, cond, attrib, prev_cond;
+	QString cond, attrib, prev_cond;
 	bool error=false, end_eval=false, expr_is_true=true, attrib_true=true, comp_true=true;
-	unsigned attrib_count=0, and_or_count=0;
+	unsigned attrib_count=0, and_or_count=0, j=idx + 1;
 
 	try
 	{
-		current_line=buffer[line];
-
-		while(!end_eval && !error)
+		while(!end_eval && !error && j < tokens.size())
 		{
-			ignoreBlankChars(current_line);
+			const SchemaToken &tok=tokens[j];
+			line=tok.line;
+			column=tok.column;
 
-			if(current_line[column]==CharLineEnd)
+			switch(tok.type)
 			{
-				line++;
-				if(line < buffer.size())
-				{
-					current_line=buffer[line];
-					column=0;
-					ignoreBlankChars(current_line);
-				}
-				else if(!end_eval)
-					error=true;
-			}
+				//Expressions may span multiple lines so line ends are simply ignored
+				case SchemaToken::LineEnd:
+				break;
 
-			switch(current_line[column].toLatin1())
-			{
-				//Extract the next conditional token
-				case CharStartConditional:
+					//Extract the next conditional token
+				case SchemaToken::Conditional:
 					prev_cond=cond;
-					cond=getConditional();
+					cond=tok.value;
 
 					//Error 1: %if {a} %or %or %then
 					error=(cond==prev_cond ||
@@ -774,9 +1084,9 @@ bool SchemaParser::evaluateExpression()
 
 					if(cond==TokenThen)
 					{
-						/* Returns the parser to the token %then because additional
-						operations is done whe this token is found */
-						column-=cond.length()+1;
+						/* Leaves idx pointing to the token right before %then because additional
+						operations are done when that token is handled by the caller */
+						idx=j - 1;
 						end_eval=true;
 
 						//Error 1: %if {a} %not %then
@@ -790,11 +1100,11 @@ bool SchemaParser::evaluateExpression()
 						and_or_count++;
 				break;
 
-				case CharStartAttribute:
-					attrib=getAttribute();
+				case SchemaToken::Attribute:
+					attrib=tok.value;
 
 					//Raises an error if the attribute does is unknown
-					if(attributes.count(attrib)==0 && !ignore_unk_atribs)
+					if(!isAttribDefined(tok.attr_id) && !ignore_unk_atribs)
 					{
 						throw Exception(Exception::getErrorMessage(ErrorCode::UnkownAttribute)
 										.arg(attrib).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
@@ -814,7 +1124,7 @@ bool SchemaParser::evaluateExpression()
 					if(!error)
 					{
 						//Appliyng the NOT operator if found
-						attrib_true=(cond==TokenNot ? attributes[attrib].isEmpty() : !attributes[attrib].isEmpty());
+						attrib_true=(cond==TokenNot ? getAttribValue(tok.attr_id).isEmpty() : !getAttribValue(tok.attr_id).isEmpty());
 
 						//Executing the AND operation if the token is found
 						if(cond==TokenAnd || prev_cond==TokenAnd)
@@ -829,8 +1139,8 @@ bool SchemaParser::evaluateExpression()
 					}
 				break;
 
-				case CharStartCompExpr:
-					comp_true=evaluateComparisonExpr();
+				case SchemaToken::CompExpr:
+					comp_true=evaluateCompExpr(tok);
 
 					//Appliyng the NOT operator if found
 					if(cond==TokenNot) comp_true=!comp_true;
@@ -853,7 +1163,13 @@ bool SchemaParser::evaluateExpression()
 					error=true;
 				break;
 			}
+
+			j++;
 		}
+
+		//Reaching the end of the buffer before finding a %then token is a syntax error
+		if(!end_eval && !error)
+			error=true;
 	}
 	catch(Exception &e)
 	{
@@ -929,6 +1245,11 @@ QString SchemaParser::getCodeDefinition(const QString & obj_name, attribs_map &a
 	}
 }
 
+void SchemaParser::setCancelToken(const TaskScheduler::CancelToken &token)
+{
+	cancel_token=token;
+}
+
 void SchemaParser::ignoreUnkownAttributes(bool ignore)
 {
 	ignore_unk_atribs=ignore;
@@ -941,95 +1262,109 @@ void SchemaParser::ignoreEmptyAttributes(bool ignore)
 
 QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 {
+	PerformanceCounters::ScopedTimer perf_timer("SchemaParser::getCodeDefinition");
+	ProfilerHooks::Phase prof_phase("schema-evaluation");
 	QString object_def;
-	unsigned end_cnt, if_cnt;
-	int if_level, prev_if_level;
-	QString atrib, cond, prev_cond, word, meta;
+	unsigned end_cnt, if_cnt, idx;
+	int if_level, prev_if_level, marsh_attr_id;
+	QString atrib, cond, prev_cond, word;
 	bool error, if_expr;
-	char chr;
-	vector<bool> vet_expif, vet_tk_if, vet_tk_then, vet_tk_else;
-	map<int, vector<QString> > if_map, else_map;
-	vector<QString>::iterator itr, itr_end;
-	vector<int> vet_prev_level;
-	vector<QString> *vet_aux;
-
-	//In case the file was successfuly loaded
-	if(buffer.size() > 0)
+
+	/* The conditional stacks use inline storage sized for the typical nesting depth and section
+	 * length of the schema files, so evaluating a template normally performs no heap allocation
+	 * for them (see SmallVector) */
+	using WordList=SmallVector<QString, 16>;
+	SmallVector<bool, 8> vet_expif, vet_tk_if, vet_tk_then, vet_tk_else;
+	SmallVector<int, 8> vet_prev_level;
+
+	//Words extracted on the 'if' and 'else' sections of each 'if' level
+	SmallVector<WordList, 8> if_map, else_map;
+	const QString *itr=nullptr, *itr_end=nullptr;
+	WordList *vet_aux;
+	shared_ptr<CompiledBuffer> comp_buf;
+
+	/* Compiles the buffer on demand in case it was loaded through loadBuffer()
+	 * which doesn't tokenizes the buffer contents right away */
+	if(!compiled_buf && !buffer.isEmpty())
+		compileBuffer();
+
+	/* Holding a local reference to the compiled buffer since restartParser() (called at the end)
+	 * detaches the parser instance from it */
+	comp_buf=compiled_buf;
+
+	//In case the file was successfuly loaded/compiled
+	if(comp_buf && !comp_buf->tokens.empty())
 	{
 		//Init the control variables
-		attributes=attribs;
+		loadAttributes(attribs);
 		error=if_expr=false;
 		if_level=-1;
 		end_cnt=if_cnt=0;
+		object_def.reserve(comp_buf->est_out_size);
 
-		while(line < buffer.size())
+		for(idx=0; idx < comp_buf->tokens.size(); idx++)
 		{
-			chr=buffer[line][column].toLatin1();
-			switch(chr)
+			/* Cooperative cancellation with bounded latency: the token is polled once every 256
+			 * evaluated tokens. On cancel the evaluation is abandoned and the partial definition
+			 * returned so callers observing their own cancellation flags can discard it */
+			if((idx & 255)==0 && cancel_token.isCanceled())
 			{
-				/* Increments the number of rows causing the parser
-				to get the next line buffer for analysis */
-				case CharLineEnd:
-					line++;
-					column=0;
-				break;
+				restartParser();
+				ignore_unk_atribs=false;
+				ignore_empty_atribs=false;
+				return object_def;
+			}
 
-				case CharTabulation:
-				case CharSpace:
-					//The parser will ignore the spaces that are not within pure texts
-					while(buffer[line][column]==CharSpace ||
-								buffer[line][column]==CharTabulation) column++;
+			const SchemaToken &tok=comp_buf->tokens[idx];
+
+			/* Updating the position control attributes so error messages
+			 * still reference the original schema file lines */
+			line=tok.line;
+			column=tok.column;
+
+			switch(tok.type)
+			{
+				/* Line ends outside %set/%unset instructions are not part of the generated
+				definition (line breaks are produced by $br or multi-lined plain texts) */
+				case SchemaToken::LineEnd:
 				break;
 
-					//Metacharacter extraction
-				case CharStartMetachar:
-					meta=getMetaCharacter();
+					//Pure texts, words and translated metacharacters
+				case SchemaToken::PlainText:
+					word=tok.value;
 
-					//Checks whether the metacharacter is part of the  'if' expression (this is an error)
-					if(if_level>=0 && vet_tk_if[if_level] && !vet_tk_then[if_level])
-					{
-						throw Exception(Exception::getErrorMessage(ErrorCode::InvalidSyntax)
-										.arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
-										ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
-					else
+					//Case the parser is in 'if/else'
+					if(if_level>=0)
 					{
-						//Converting the metacharacter drawn to the character that represents this
-						//chr=translateMetaCharacter(meta);
-						//meta="";
-						//meta+=chr;
-						meta = translateMetaCharacter(meta);
-
-						//If the parser is inside an 'if / else' extracting tokens
-						if(if_level>=0)
+						/* In case the word/text be inside 'if' expression, the parser returns an error
+						 because only an attribute must be on the 'if' expression  */
+						if(vet_tk_if[if_level] && !vet_tk_then[if_level])
 						{
-							/* If the parser is in 'if' section,
-								 places the metacharacter on the word map of the current 'if' */
-							if(vet_tk_if[if_level] &&
-									vet_tk_then[if_level] &&
-									!vet_tk_else[if_level])
-								if_map[if_level].push_back(meta);
-
-							/* If the parser is in 'else' section,
-								 places the metacharacter on the word map of the current 'else'*/
-							else if(vet_tk_else[if_level])
-								else_map[if_level].push_back(meta);
+							throw Exception(Exception::getErrorMessage(ErrorCode::InvalidSyntax)
+											.arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
+											ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 						}
-						else
-							/* If the parsers is not in a 'if / else', puts the metacharacter
-								 in the definition sql */
-							object_def+=meta;
+						//Case the parser is in 'if' section
+						else if(vet_tk_if[if_level] &&
+								vet_tk_then[if_level] &&
+								!vet_tk_else[if_level])
+							//Inserts the word on the words map extracted on 'if' section
+							if_map[if_level].push_back(word);
+						else if(vet_tk_else[if_level])
+							//Inserts the word on the words map extracted on 'else' section
+							else_map[if_level].push_back(word);
 					}
-
+					else
+						//Case the parser is not in 'if/else' concatenates the word/text directly on the object definition
+						object_def+=word;
 				break;
 
-					//Attribute extraction
-				case CharStartAttribute:
-				case CharEndAttribute:
-					atrib=getAttribute();
+					//Attribute reference
+				case SchemaToken::Attribute:
+					atrib=tok.value;
 
 					//Checks if the attribute extracted belongs to the passed list of attributes
-					if(attributes.count(atrib)==0)
+					if(!isAttribDefined(tok.attr_id))
 					{
 						if(!ignore_unk_atribs)
 						{
@@ -1038,37 +1373,33 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 											ErrorCode::UnkownAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 						}
 						else
-							attributes[atrib]="";
+							setAttribValue(tok.attr_id, "");
 					}
 
 					//If the parser is inside an 'if / else' extracting tokens
 					if(if_level>=0)
 					{
-						//If the parser evaluated the 'if' conditional and is inside the current if block
-						if(!(!if_expr && vet_tk_if[if_level] && !vet_tk_then[if_level]))
-						{
-							word=atrib;
-							atrib="";
-							atrib+=CharStartAttribute;
-							atrib+=word;
-							atrib+=CharEndAttribute;
-
-							//If the parser is in the 'if' section
-							if(vet_tk_if[if_level] &&
-									vet_tk_then[if_level] &&
-									!vet_tk_else[if_level])
-								//Inserts the attribute value in the map of the words of current the 'if' section
-								if_map[if_level].push_back(atrib);
-							else if(vet_tk_else[if_level])
-								//Inserts the attribute value in the map of the words of current the 'else' section
-								else_map[if_level].push_back(atrib);
-						}
+						word=atrib;
+						atrib="";
+						atrib+=CharStartAttribute;
+						atrib+=word;
+						atrib+=CharEndAttribute;
+
+						//If the parser is in the 'if' section
+						if(vet_tk_if[if_level] &&
+								vet_tk_then[if_level] &&
+								!vet_tk_else[if_level])
+							//Inserts the attribute value in the map of the words of current the 'if' section
+							if_map[if_level].push_back(atrib);
+						else if(vet_tk_else[if_level])
+							//Inserts the attribute value in the map of the words of current the 'else' section
+							else_map[if_level].push_back(atrib);
 					}
 					else
 					{
 						/* If the attribute has no value set and parser must not ignore empty values
 						raises an exception */
-						if(attributes[atrib].isEmpty() && !ignore_empty_atribs)
+						if(getAttribValue(tok.attr_id).isEmpty() && !ignore_empty_atribs)
 						{
 							throw Exception(Exception::getErrorMessage(ErrorCode::UndefinedAttributeValue)
 											.arg(atrib).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
@@ -1077,27 +1408,16 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 
 						/* If the parser is not in an if / else, concatenates the value of the attribute
 							directly in definition in sql */
-						object_def+=attributes[atrib];
+						object_def+=getAttribValue(tok.attr_id);
 					}
 				break;
 
-					//Conditional instruction extraction
-				case CharStartConditional:
+					//Conditional instruction
+				case SchemaToken::Conditional:
 					prev_cond=cond;
-					cond=getConditional();
-
-					//Checks whether the extracted token is a valid conditional
-					if(cond!=TokenIf && cond!=TokenElse &&
-							cond!=TokenThen && cond!=TokenEnd &&
-							cond!=TokenOr && cond!=TokenNot &&
-							cond!=TokenAnd && cond!=TokenSet &&
-							cond!=TokenUnset)
-					{
-						throw Exception(Exception::getErrorMessage(ErrorCode::InvalidInstruction)
-										.arg(cond).arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
-										ErrorCode::InvalidInstruction,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-					}
-					else if(cond==TokenSet || cond==TokenUnset)
+					cond=tok.value;
+
+					if(cond==TokenSet || cond==TokenUnset)
 					{
 						bool extract=false;
 
@@ -1126,24 +1446,33 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 						if(extract)
 						{
 							if(cond==TokenSet)
-								defineAttribute();
+								defineAttribute(comp_buf->tokens, idx);
 							else
-								unsetAttribute();
+								unsetAttribute(comp_buf->tokens, idx);
 						}
 						else
 						{
-							ignoreBlankChars(buffer[line]);
-
 							/* When the %set instruction is ignored due to the fact of it being under a if expression evaluated as false
 							 * there's the need to create an empty representation of it in the set of attributes so in further expressions
 							 * evaluations the parser isn't broke by a unknow attribute exception */
-							atrib = getAttribute();
-							if(attributes.count(atrib) == 0)
-								attributes[atrib]="";
+							unsigned j=idx + 1;
+							bool registered=false;
+
+							while(j < comp_buf->tokens.size() && comp_buf->tokens[j].type!=SchemaToken::LineEnd)
+							{
+								if(!registered && comp_buf->tokens[j].type==SchemaToken::Attribute)
+								{
+									if(!isAttribDefined(comp_buf->tokens[j].attr_id))
+										setAttribValue(comp_buf->tokens[j].attr_id, "");
+
+									registered=true;
+								}
+
+								j++;
+							}
 
-							column=0;
-							line++;
-							atrib.clear();
+							//Skips the whole ignored instruction line
+							idx=j;
 						}
 					}
 					else
@@ -1153,7 +1482,7 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 						{
 							//Evaluates the if expression storing the result on the vector
 							if_expr=true;
-							vet_expif.push_back(evaluateExpression());
+							vet_expif.push_back(evaluateExpression(comp_buf->tokens, idx));
 
 							/* Inserts the value of the current 'if' level  in the previous 'if' levels vector.
 							 This vector is used to know which 'if' the parser was in before entering current if */
@@ -1165,6 +1494,10 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 							vet_tk_then.push_back(false);
 							vet_tk_else.push_back(false);
 
+							//Creates the word lists of the 'if' and 'else' sections of the new level
+							if_map.push_back(WordList());
+							else_map.push_back(WordList());
+
 							//Defines the current if level as the size of list 'if' tokens found  -1
 							if_level=(vet_tk_if.size()-1);
 
@@ -1211,7 +1544,7 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 
 							/* Initializes the iterators to scan
 								 the auxiliary vector if necessary */
-							itr=itr_end=if_map[0].end();
+							itr=itr_end=nullptr;
 
 							/* In case the expression of the current 'if' has the value true
 								 then the parser will scan the list of words on the 'if' part of the
@@ -1224,7 +1557,7 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 
 							/* If there is a 'else' part on the current 'if'
 								 then the parser will scan the list of words on the 'else' part */
-							else if(else_map.count(if_level)>0)
+							else if(!else_map[if_level].empty())
 							{
 								itr=else_map[if_level].begin();
 								itr_end=else_map[if_level].end();
@@ -1246,9 +1579,16 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 									//Check if the word is not an attribute
 									if(!word.isEmpty() && word.startsWith(CharStartAttribute) && word.endsWith(CharEndAttribute))
 									{
-										//If its an attribute, extracts the name between { } and checks if the same has empty value
+										/* If its an attribute, extracts the name between { } and checks if the same has empty value.
+										 * Just like the former map based lookup, undefined attributes referenced here are registered
+										 * with an empty value so further evaluations don't raise unknown attribute errors */
 										atrib=word.mid(1, word.size()-2);
-										word=attributes[atrib];
+										marsh_attr_id=internAttribName(atrib);
+
+										if(!isAttribDefined(marsh_attr_id))
+											setAttribValue(marsh_attr_id, "");
+
+										word=getAttribValue(marsh_attr_id);
 
 										/* If the attribute has no value set and parser must not ignore empty values
 										raises an exception */
@@ -1311,39 +1651,12 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 					}
 				break;
 
-					//Extraction of pure text or simple words
+					/* Comparison expressions and %set indirections are consumed by the expression/instruction
+					evaluators, finding one of them here denotes a malformed schema code */
 				default:
-					if(chr==CharStartPlainText ||
-							chr==CharEndPlainText)
-						word=getPlainText();
-					else
-						word=getWord();
-
-					//Case the parser is in 'if/else'
-					if(if_level>=0)
-					{
-						/* In case the word/text be inside 'if' expression, the parser returns an error
-						 because only an attribute must be on the 'if' expression  */
-						if(vet_tk_if[if_level] && !vet_tk_then[if_level])
-						{
-							throw Exception(Exception::getErrorMessage(ErrorCode::InvalidSyntax)
-											.arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
-											ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-						}
-						//Case the parser is in 'if' section
-						else if(vet_tk_if[if_level] &&
-								vet_tk_then[if_level] &&
-								!vet_tk_else[if_level])
-							//Inserts the word on the words map extracted on 'if' section
-							if_map[if_level].push_back(word);
-						else if(vet_tk_else[if_level])
-							//Inserts the word on the words map extracted on 'else' section
-							else_map[if_level].push_back(word);
-					}
-					else
-						//Case the parser is not in 'if/else' concatenates the word/text directly on the object definition
-						object_def+=word;
-				break;
+					throw Exception(Exception::getErrorMessage(ErrorCode::InvalidSyntax)
+									.arg(filename).arg(getCurrentLine()).arg(getCurrentColumn()),
+									ErrorCode::InvalidSyntax,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 			}
 		}
 
@@ -1367,8 +1680,31 @@ QString SchemaParser::getCodeDefinition(const QString &filename, attribs_map &at
 {
 	try
 	{
-		loadFile(filename);
 		attribs[Attributes::PgSqlVersion]=pgsql_version;
+
+		/* With the persistent code cache enabled the evaluation is skipped entirely when the
+		 * same schema file was already evaluated with the very same attributes, even by a
+		 * previous run of the application. The ignore flags are reset on a hit the same way
+		 * an evaluation would reset them since they are configured on a per-call basis */
+		if(CodeCacheStore::isEnabled())
+		{
+			QString code;
+			QByteArray cache_key=CodeCacheStore::makeKey(filename, attribs);
+
+			if(CodeCacheStore::lookup(cache_key, code))
+			{
+				ignore_unk_atribs=false;
+				ignore_empty_atribs=false;
+				return code;
+			}
+
+			loadFile(filename);
+			code=getCodeDefinition(attribs);
+			CodeCacheStore::store(cache_key, code);
+			return code;
+		}
+
+		loadFile(filename);
 		return getCodeDefinition(attribs);
 	}
 	catch(Exception &e)
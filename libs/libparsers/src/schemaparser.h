@@ -29,14 +29,110 @@
 #include "exception.h"
 #include <map>
 #include <vector>
+#include <memory>
 #include <QDir>
+#include <QHash>
+#include <QMutex>
 #include <QTextStream>
 #include "xmlparser.h"
 #include "attribsmap.h"
 #include "pgsqlversions.h"
+#include "taskscheduler.h"
 
 class SchemaParser {
 	private:
+		/*! \brief A single element extracted from a schema buffer during the compilation step
+		 (see compileBuffer()). Tokens store the position (line/column) where they were extracted
+		 so syntax/evaluation errors can still reference the original schema file */
+		struct SchemaToken {
+			enum TokenType {
+				PlainText,   //! \brief Pure texts, simple words and translated metacharacters
+				Attribute,   //! \brief A reference to an attribute: {name}
+				Conditional, //! \brief A conditional instruction: %if %then %else %end %or %and %not %set %unset
+				CompExpr,    //! \brief A comparison expression: ( {attribute} [operator] "value" )
+				ValueOf,     //! \brief The indirection @{name} used by %set instructions
+				LineEnd      //! \brief End of a buffer line (used to delimit %set / %unset instructions)
+			};
+
+			TokenType type;
+
+			//! \brief The token contents (text, attribute name or conditional instruction name)
+			QString value;
+
+			//! \brief Elements of a comparison expression (used only by CompExpr tokens)
+			QString cmp_attrib, cmp_oper, cmp_value;
+
+			/*! \brief Interned id of the attribute name referenced by Attribute/ValueOf tokens as
+			 well as by the attribute operand of CompExpr tokens (see internAttribName()) */
+			int attr_id = -1;
+
+			//! \brief Position in the loaded buffer from where the token was extracted
+			int line, column;
+
+			SchemaToken(TokenType tk_type, const QString &val, int lin, int col) :
+				type(tk_type), value(val), line(lin), column(col) {}
+		};
+
+		/*! \brief Stores the compiled (tokenized) form of a schema buffer. Instances of this
+		 struct are shared between parsers through the compiled buffers cache so each schema
+		 file is tokenized only once per process no matter how many times it is evaluated */
+		struct CompiledBuffer {
+			//! \brief Vectorial representation of the loaded file (preprocessed, without comments)
+			QStringList buffer;
+
+			//! \brief The sequence of tokens extracted from the buffer
+			std::vector<SchemaToken> tokens;
+
+			//! \brief Comment line amount extracted during the buffer preprocessing
+			int comment_count = 0;
+
+			/*! \brief Estimated size, in characters, of the definitions produced by this buffer.
+			 Used to reserve the output string upfront, avoiding reallocations while assembling
+			 large definitions */
+			int est_out_size = 0;
+		};
+
+		//! \brief The compiled form of the currently loaded buffer
+		std::shared_ptr<CompiledBuffer> compiled_buf;
+
+		//! \brief Process-wide cache of compiled schema files keyed by the absolute filename
+		static std::map<QString, std::shared_ptr<CompiledBuffer>> compiled_cache;
+
+		//! \brief Controls the concurrent access to the compiled buffers cache
+		static QMutex compiled_cache_mtx;
+
+		/*! \brief Interns an attribute name returning its numeric id. The attribute names used by the
+		 schema files form a closed set (the Attributes namespace) so the registry quickly converges
+		 and the evaluation indexes the flat attribute storage directly instead of paying tree node
+		 allocations and string comparisons on every lookup. The registry is process-wide, append-only
+		 and thread safe so compiled buffers can be shared between parsers */
+		static int internAttribName(const QString &name);
+
+		//! \brief Maps each interned attribute name to its numeric id
+		static QHash<QString, int> attr_name_ids;
+
+		//! \brief Stores the interned attribute names indexed by their ids
+		static QStringList attr_names;
+
+		//! \brief Controls the concurrent access to the attribute names registry
+		static QMutex attr_names_mtx;
+
+		/*! \brief Tokenizes the currently loaded buffer storing the result in compiled_buf.
+		 This method raises syntax errors that previously were raised only during the
+		 evaluation in getCodeDefinition() */
+		void compileBuffer();
+
+		/*! \brief Extracts a comparison expression from the buffer on the current position
+		 returning it in the form of a CompExpr token. The expression operands are validated
+		 during the compilation but only evaluated when the code definition is generated */
+		SchemaToken compileComparisonExpr();
+
+		//! \brief Evaluates a compiled comparison expression against the current attributes map
+		bool evaluateCompExpr(const SchemaToken &token);
+
+		//! \brief Cooperative cancellation token polled during the evaluation (see setCancelToken())
+		TaskScheduler::CancelToken cancel_token;
+
 		/*! \brief Indicates that the parser should ignore unknown
 		 attributes avoiding raising exceptions */
 		bool ignore_unk_atribs;
@@ -45,8 +141,10 @@ class SchemaParser {
 		 attributes avoiding raising exceptions */
 		bool ignore_empty_atribs;
 
-		//! \brief RegExp used to validate attribute names
-		static const QRegExp AttribRegExp;
+		/*! \brief RegExp used to validate attribute names. The instance is thread local because
+		 QRegExp matching mutates internal engine state (the class is reentrant, not thread safe)
+		 and the validations run concurrently on the code generation worker threads */
+		static thread_local const QRegExp AttribRegExp;
 
 		//! \brief Get an attribute name from the buffer on the current position
 		QString getAttribute();
@@ -69,23 +167,10 @@ class SchemaParser {
 		%if {a1} %or {a2} %and %not {a3} %then --> TRUE
 		%if {a1} %or %not {a3} %then --> TRUE
 		%if {a1} %and {a3} %then --> FALSE
-		*/
-		bool evaluateExpression();
-
-		/*! \brief Returns the result (true|false) of a comparison expression. A comparison expression
-		have the form: ( {attribute} [operator] "value" ), where:
 
-		(           --> Starts the expression
-		{attribute} --> Is the attribute to be compared to a value
-		[operator]  --> A valid comparison operator:
-						== (equal), != (not equal), < (less than), > (greater than)
-						<= (less or equal to), >= (greater or equal to)
-		)           --> Closes the expression
-
-		The parenthesis are mandatory otherwise the parser will not recognize the expression
-		and raise an exception. Multiple expressions combined with logical operators
-		%not %and %or in the same () are not supported. */
-		bool evaluateComparisonExpr();
+		The expression tokens are consumed from the compiled buffer starting right after the
+		%if token (idx). On success idx is left pointing to the token right before %then. */
+		bool evaluateExpression(const std::vector<SchemaToken> &tokens, unsigned &idx);
 
 		/*! \brief Creates a new attribute when finding:
 		1) %set  {attrib-name} [expr]  or
@@ -98,11 +183,15 @@ class SchemaParser {
 		may return error if the value used is an invalid name.
 
 		The %set construction must be the only one in the line otherwise the parser will return
-		errors if another instruction starting with % is found. */
-		void defineAttribute();
+		errors if another instruction starting with % is found.
+
+		The instruction tokens are consumed from the compiled buffer starting right after the
+		%set token (idx) until the line end. On success idx is left pointing to the LineEnd token. */
+		void defineAttribute(const std::vector<SchemaToken> &tokens, unsigned &idx);
 
-		//! \brief Clears the value of attributes when finding the instruction: %unset {attr1} {attr2}...
-		void unsetAttribute();
+		/*! \brief Clears the value of attributes when finding the instruction: %unset {attr1} {attr2}...
+		 The instruction tokens are consumed the same way as in defineAttribute() */
+		void unsetAttribute(const std::vector<SchemaToken> &tokens, unsigned &idx);
 
 		//! \brief Increments the column counter while blank chars (space and tabs) are found on the line
 		void ignoreBlankChars(const QString &line);
@@ -135,7 +224,32 @@ class SchemaParser {
 				  reference to the line on file that has syntax errors */
 		comment_count;
 
-		attribs_map attributes;
+		/*! \brief Flat attribute value storage indexed by the interned attribute name ids. Together
+		 with attr_epochs it replaces the former attribs_map member: an entry is considered defined
+		 for the current evaluation only when its epoch stamp matches attr_epoch, which allows
+		 invalidating the whole storage at once without deallocating it between evaluations */
+		std::vector<QString> attr_values;
+
+		//! \brief Epoch stamps indicating which entries of attr_values are currently set
+		std::vector<unsigned> attr_epochs;
+
+		//! \brief Current evaluation epoch (see clearAttributes())
+		unsigned attr_epoch;
+
+		//! \brief Invalidates all the entries of the flat attribute storage by starting a new epoch
+		void clearAttributes();
+
+		//! \brief Copies the provided attributes map into the flat attribute storage starting a new epoch
+		void loadAttributes(const attribs_map &attribs);
+
+		//! \brief Returns whether the attribute of the given id has a value set for the current evaluation
+		bool isAttribDefined(int attr_id);
+
+		//! \brief Returns the value of the attribute of the given id (empty when the attribute isn't defined)
+		const QString &getAttribValue(int attr_id);
+
+		//! \brief Defines the value of the attribute of the given id for the current evaluation
+		void setAttribValue(int attr_id, const QString &value);
 
 		//! \brief PostgreSQL version currently used by the parser
 		QString pgsql_version;
@@ -221,15 +335,34 @@ class SchemaParser {
 		 attributes map */
 		QString getCodeDefinition(const attribs_map &attribs);
 
-		//! \brief Loads the buffer with a string
+		//! \brief Loads the buffer with a string compiling it right away (see compileBuffer())
 		void loadBuffer(const QString &buf);
 
-		//! \brief Loads a schema file and inserts its line into the parser's buffer
+		/*! \brief Loads a schema file and inserts its line into the parser's buffer. Once a file
+		 is loaded its compiled form is stored in a process-wide cache so further loads of the
+		 same file skip both the disk access and the tokenization steps */
 		void loadFile(const QString &filename);
 
+		//! \brief Purges the compiled schema files cache forcing files to be reloaded/recompiled
+		static void clearCompiledCache();
+
+		/*! \brief Compiles ahead of time all schema files (*.sch) found under the provided root
+		 directory, populating the compiled buffers cache with low priority workers spread over the
+		 available cores. Called right after the application launch so the first export/diff of a
+		 session doesn't pay the tokenization of the whole template set serially. The method only
+		 schedules the work and returns immediately; compilation failures are silently ignored since
+		 the faulty file is compiled again (and properly reported) when some operation evaluates it */
+		static void precompileSchemaFiles(const QString &root_dir);
+
 		//! \brief Resets the parser in order to do new analysis
 		void restartParser();
 
+		/*! \brief Installs a cooperative cancellation token checked by getCodeDefinition() with
+		 bounded latency (once every 256 evaluated tokens). When the token is canceled the
+		 evaluation is abandoned and the partial definition is returned — callers observing their
+		 own cancellation flags are expected to discard it */
+		void setCancelToken(const TaskScheduler::CancelToken &token);
+
 		//! \brief Set if the parser must ignore unknown attributes avoiding exception throwing
 		void ignoreUnkownAttributes(bool ignore);
 
@@ -0,0 +1,149 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libparsers
+\class SmallVector
+\brief A sequential container with inline storage for the first N elements, falling back to the
+heap only when that capacity is exceeded. The schema evaluation uses it for the per-template
+conditional/attribute stacks, which stay small for the vast majority of the templates: with the
+inline capacity properly sized those stacks never touch the heap, cutting the allocation count
+of the hottest loop of the code generation. The storage is always contiguous, so the elements
+can be scanned through plain pointers no matter where they currently live.
+*/
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <array>
+#include <vector>
+
+template<typename T, unsigned N>
+class SmallVector {
+	private:
+		//! \brief Inline storage used while the element count doesn't exceed N
+		std::array<T, N> inline_buf;
+
+		//! \brief Heap storage used once the inline capacity is exceeded
+		std::vector<T> heap_buf;
+
+		//! \brief Current element count
+		unsigned count=0;
+
+		//! \brief Indicates that the elements currently live in the heap storage
+		bool spilled=false;
+
+	public:
+		T *begin()
+		{
+			return spilled ? heap_buf.data() : inline_buf.data();
+		}
+
+		T *end()
+		{
+			return begin() + count;
+		}
+
+		const T *begin() const
+		{
+			return spilled ? heap_buf.data() : inline_buf.data();
+		}
+
+		const T *end() const
+		{
+			return begin() + count;
+		}
+
+		unsigned size() const
+		{
+			return count;
+		}
+
+		bool empty() const
+		{
+			return count==0;
+		}
+
+		T &operator[](unsigned idx)
+		{
+			return begin()[idx];
+		}
+
+		const T &operator[](unsigned idx) const
+		{
+			return begin()[idx];
+		}
+
+		T &back()
+		{
+			return begin()[count - 1];
+		}
+
+		void push_back(const T &value)
+		{
+			if(!spilled && count < N)
+			{
+				inline_buf[count]=value;
+				count++;
+				return;
+			}
+
+			//Moving the inline elements to the heap once the inline capacity is exceeded
+			if(!spilled)
+			{
+				heap_buf.reserve(N * 2);
+				heap_buf.assign(inline_buf.begin(), inline_buf.begin() + count);
+				spilled=true;
+			}
+
+			heap_buf.push_back(value);
+			count++;
+		}
+
+		void pop_back()
+		{
+			if(count==0)
+				return;
+
+			count--;
+
+			if(spilled)
+				heap_buf.pop_back();
+			else
+				//Resetting the popped slot so it doesn't retain heavy element contents
+				inline_buf[count]=T();
+		}
+
+		/*! \brief Removes all the elements returning the container to the inline storage.
+		 The heap storage keeps its capacity so a new spill doesn't reallocate */
+		void clear()
+		{
+			if(spilled)
+				heap_buf.clear();
+			else
+			{
+				for(unsigned idx=0; idx < count; idx++)
+					inline_buf[idx]=T();
+			}
+
+			count=0;
+			spilled=false;
+		}
+};
+
+#endif
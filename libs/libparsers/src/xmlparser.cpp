@@ -18,9 +18,16 @@
 
 #include "xmlparser.h"
 #include <QUrl>
+#include <QFile>
+#include <libxml/parserInternals.h>
 #include "utilsns.h"
+#include "assetarchive.h"
+#include "globalattributes.h"
 
 int XmlParser::parser_instances = 0;
+xmlExternalEntityLoader XmlParser::def_entity_loader = nullptr;
+map<QString, QByteArray> XmlParser::dtd_cache;
+QMutex XmlParser::dtd_cache_mtx;
 const QString XmlParser::CharAmp("&amp;");
 const QString XmlParser::CharLt("&lt;");
 const QString XmlParser::CharGt("&gt;");
@@ -39,8 +46,15 @@ XmlParser::XmlParser()
 	curr_line = 0;
 
 	if(parser_instances == 0)
+	{
 		xmlInitParser();
 
+		/* Installing the custom entity loader that serves the dtd files from memory,
+		 * avoiding a disk read of the same few dtd assets at every document validation */
+		def_entity_loader = xmlGetExternalEntityLoader();
+		xmlSetExternalEntityLoader(loadEntityFromCache);
+	}
+
 	parser_instances++;
 }
 
@@ -51,11 +65,47 @@ XmlParser::~XmlParser()
 
 	if(parser_instances <= 0)
 	{
+		xmlSetExternalEntityLoader(def_entity_loader);
+		dtd_cache.clear();
 		xmlCleanupParser();
 		parser_instances = 0;
 	}
 }
 
+xmlParserInputPtr XmlParser::loadEntityFromCache(const char *url, const char *id, xmlParserCtxtPtr ctxt)
+{
+	QString url_str(url);
+
+	//Only the dtd files are cached, any other entity is handled by the original loader
+	if(!url_str.endsWith(GlobalAttributes::ObjectDTDExt))
+		return def_entity_loader(url, id, ctxt);
+
+	QMutexLocker locker(&dtd_cache_mtx);
+	auto itr = dtd_cache.find(url_str);
+
+	if(itr == dtd_cache.end())
+	{
+		QUrl file_url(url_str);
+		QString file_path = file_url.isLocalFile() ? file_url.toLocalFile() : url_str;
+		QFile input(file_path);
+		QByteArray buffer;
+
+		if(input.open(QFile::ReadOnly))
+			buffer = input.readAll();
+		/* When the dtd is absent on disk we try to serve it from a mounted asset archive,
+		 * falling back to the original loader if no archive covers the file either */
+		else if(!AssetArchive::lookupEntry(file_path, buffer))
+			return def_entity_loader(url, id, ctxt);
+
+		itr = dtd_cache.insert({ url_str, buffer }).first;
+	}
+
+	/* The input stream references the cached buffer directly. The cache entries are never
+	 * removed or modified while parser instances exist (the map nodes are stable), so the
+	 * reference stays valid after the lock is released */
+	return xmlNewStringInputStream(ctxt, reinterpret_cast<const xmlChar *>(itr->second.constData()));
+}
+
 void XmlParser::removeDTD()
 {
 	int pos1=-1, pos2=-1, pos3=-1, len;
@@ -544,3 +594,117 @@ QString XmlParser::convertCharsToXMLEntities(QString buf)
 
 	return fmt_buf;
 }
+
+/*! \brief Drives the streaming reading loop shared by XmlParser::streamXMLFile() and
+ XmlParser::streamXMLBuffer(). The total_size parameter is used to compute the reading
+ progress and src_ref identifies the document source on error messages */
+static void streamXMLReader(xmlTextReader *reader, qint64 total_size, const QString &src_ref,
+														const std::function<void(attribs_map &)> &root_handler,
+														const std::function<void(const QString &, const QString &, double)> &elem_handler)
+{
+	attribs_map root_attribs;
+	qint64 file_size=total_size;
+	int res=0, node_type=0;
+	bool root_found=false;
+	QString filename=src_ref;
+
+	try
+	{
+		res=xmlTextReaderRead(reader);
+
+		while(res==1)
+		{
+			node_type=xmlTextReaderNodeType(reader);
+
+			//Extracting the attributes of the root element (depth 0)
+			if(!root_found && node_type==XML_READER_TYPE_ELEMENT && xmlTextReaderDepth(reader)==0)
+			{
+				root_found=true;
+
+				while(xmlTextReaderMoveToNextAttribute(reader)==1)
+				{
+					root_attribs[QString(reinterpret_cast<const char *>(xmlTextReaderConstName(reader)))]=
+							QString::fromUtf8(reinterpret_cast<const char *>(xmlTextReaderConstValue(reader)));
+				}
+
+				//Returning the reader to the element itself after the attributes scan
+				xmlTextReaderMoveToElement(reader);
+
+				if(root_handler)
+					root_handler(root_attribs);
+
+				res=xmlTextReaderRead(reader);
+			}
+			//Handing each second level element subtree to the element handler
+			else if(node_type==XML_READER_TYPE_ELEMENT && xmlTextReaderDepth(reader)==1)
+			{
+				xmlChar *outer_xml=xmlTextReaderReadOuterXml(reader);
+				QString elem_name(reinterpret_cast<const char *>(xmlTextReaderConstName(reader))), elem_buf;
+				double progress=0;
+
+				if(outer_xml)
+				{
+					elem_buf=QString::fromUtf8(reinterpret_cast<const char *>(outer_xml));
+					xmlFree(outer_xml);
+				}
+
+				if(file_size > 0)
+					progress=(xmlTextReaderByteConsumed(reader)/static_cast<double>(file_size)) * 100;
+
+				if(elem_handler)
+					elem_handler(elem_buf, elem_name, progress > 100 ? 100 : progress);
+
+				//Skips the whole subtree positioning the reader on the next sibling element
+				res=xmlTextReaderNext(reader);
+			}
+			else
+				res=xmlTextReaderRead(reader);
+		}
+
+		//Negative results indicate a malformed document, in that case the last error is raised
+		if(res < 0)
+		{
+			xmlError *xml_error=xmlGetLastError();
+			QString msg=(xml_error ? QString(xml_error->message) : QT_TR_NOOP("unknown error"));
+			msg.replace("\n"," ");
+
+			throw Exception(Exception::getErrorMessage(ErrorCode::LibXMLError)
+											.arg(xml_error ? xml_error->line : 0).arg(xml_error ? xml_error->int2 : 0).arg(msg).arg(filename),
+											ErrorCode::LibXMLError,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+		}
+
+		xmlFreeTextReader(reader);
+	}
+	catch(Exception &e)
+	{
+		xmlFreeTextReader(reader);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void XmlParser::streamXMLFile(const QString &filename,
+															const std::function<void(attribs_map &)> &root_handler,
+															const std::function<void(const QString &, const QString &, double)> &elem_handler)
+{
+	xmlTextReader *reader=xmlReaderForFile(filename.toUtf8().data(), nullptr,
+																				 XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOENT | XML_PARSE_BIG_LINES);
+
+	if(!reader)
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(filename),
+										ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	streamXMLReader(reader, QFileInfo(filename).size(), filename, root_handler, elem_handler);
+}
+
+void XmlParser::streamXMLBuffer(const QByteArray &buffer,
+																const std::function<void(attribs_map &)> &root_handler,
+																const std::function<void(const QString &, const QString &, double)> &elem_handler)
+{
+	xmlTextReader *reader=xmlReaderForMemory(buffer.data(), buffer.size(), nullptr, nullptr,
+																					 XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOENT | XML_PARSE_BIG_LINES);
+
+	if(!reader)
+		throw Exception(ErrorCode::AsgEmptyXMLBuffer,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	streamXMLReader(reader, buffer.size(), QT_TR_NOOP("xml buffer"), root_handler, elem_handler);
+}
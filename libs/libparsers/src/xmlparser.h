@@ -28,10 +28,13 @@
 
 #include <libxml/parser.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 #include "schemaparser.h"
 #include "exception.h"
 #include <stack>
 #include <iostream>
+#include <functional>
+#include <QMutex>
 #include "attribsmap.h"
 
 class XmlParser {
@@ -41,6 +44,24 @@ class XmlParser {
 		 * Reference: http://xmlsoft.org/html/libxml-parser.html#xmlCleanupParser */
 		static int parser_instances;
 
+		//! \brief Stores the original external entity loader used by libxml2
+		static xmlExternalEntityLoader def_entity_loader;
+
+		/*! \brief Stores the contents of the dtd files already read, indexed by their urls. The dtd
+		 * assets don't change during a session, so each file is read from disk only once and all the
+		 * subsequent document validations are served from memory (see loadEntityFromCache) */
+		static map<QString, QByteArray> dtd_cache;
+
+		/*! \brief Controls the concurrent access to the dtd cache. The entity loader is a process
+		 * global libxml2 hook, so parsers running on worker threads all funnel through it */
+		static QMutex dtd_cache_mtx;
+
+		/*! \brief Custom external entity loader installed on libxml2 (see constructor). Serves the
+		 * dtd files requested during document validations from the in-memory cache, reading each one
+		 * from disk only upon the first request. Any other entity (or a dtd file that can't be read)
+		 * is handled by the original loader */
+		static xmlParserInputPtr loadEntityFromCache(const char *url, const char *id, xmlParserCtxtPtr ctxt);
+
 		/*! \brief Stores the name of the file that generated the xml buffer when
 		 loadXMLFile() method is called */
 		QString xml_doc_filename;
@@ -170,6 +191,22 @@ class XmlParser {
 		/*! \brief Converts any chars (operators) < > " to the respective XML entities.
 		 * This method will not convert chars between XML comments <!-- --> as well <![CDATA ]]> entity */
 		static QString convertCharsToXMLEntities(QString buf);
+
+		/*! \brief Reads an xml file in streaming fashion (SAX-like xmlTextReader) instead of building the
+		 whole document tree in memory. The attributes of the root element are handed to root_handler before
+		 any other callback. For each direct child element of the root, elem_handler receives the element's
+		 outer xml code, its tag name and the reading progress (0-100). Since only one element subtree is
+		 materialized at a time the memory usage stays proportional to the largest element instead of to the
+		 whole document. Note: the document is not validated against a DTD in this reading mode. */
+		static void streamXMLFile(const QString &filename,
+															const std::function<void(attribs_map &)> &root_handler,
+															const std::function<void(const QString &, const QString &, double)> &elem_handler);
+
+		/*! \brief Buffer based version of streamXMLFile(). Reads the document directly from the
+		 provided buffer instead of a file on disk, with the same callbacks and semantics */
+		static void streamXMLBuffer(const QByteArray &buffer,
+																const std::function<void(attribs_map &)> &root_handler,
+																const std::function<void(const QString &, const QString &, double)> &elem_handler);
 };
 
 #endif
@@ -15,6 +15,14 @@ HEADERS += src/exception.h \
 	src/qtcompat/qplaintexteditcompat.h \
 	src/qtcompat/qtextstreamcompat.h \
 	src/qtcompat/splitbehaviorcompat.h \
+	src/assetarchive.h \
+	src/memorypool.h \
+	src/performancecounters.h \
+	src/profilerhooks.h \
+	src/progresschannel.h \
+	src/stallwatchdog.h \
+	src/taskscheduler.h \
+	src/tracelogger.h \
 	src/utilsns.h
 
 SOURCES += src/exception.cpp \
@@ -26,6 +34,14 @@ SOURCES += src/exception.cpp \
 	src/qtcompat/qlinefcompat.cpp \
 	src/qtcompat/qplaintexteditcompat.cpp \
 	src/qtcompat/qtextstreamcompat.cpp \
+	src/assetarchive.cpp \
+	src/memorypool.cpp \
+	src/performancecounters.cpp \
+	src/profilerhooks.cpp \
+	src/progresschannel.cpp \
+	src/stallwatchdog.cpp \
+	src/taskscheduler.cpp \
+	src/tracelogger.cpp \
 	src/utilsns.cpp
 
 # Deployment settings
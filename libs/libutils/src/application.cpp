@@ -18,9 +18,11 @@
 #include "application.h"
 #include "globalattributes.h"
 #include "exception.h"
+#include "performancecounters.h"
 
 Application::Application(int &argc, char **argv) : QApplication(argc,argv)
 {
+	PerformanceCounters::ScopedTimer perf_timer("Startup: search path resolution");
 	GlobalAttributes::setSearchPath(this->applicationDirPath());
 }
 
@@ -0,0 +1,165 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "assetarchive.h"
+#include "utilsns.h"
+#include "exception.h"
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QDataStream>
+
+const QByteArray AssetArchive::ArchiveMagic("pgmodeler-assets");
+const QString AssetArchive::ArchiveExt(".pga");
+std::map<QString, std::unique_ptr<AssetArchive::MountedArchive>> AssetArchive::mounted_archives;
+QMutex AssetArchive::mount_mtx;
+
+void AssetArchive::packDirectory(const QString &dir_path, const QString &archive_path)
+{
+	QFileInfo fi(dir_path);
+
+	if(!fi.exists() || !fi.isDir())
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(dir_path),
+										ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	QString root_path=fi.absoluteFilePath();
+	QByteArray index, blobs, file_buf;
+	QDataStream index_stream(&index, QIODevice::WriteOnly);
+	quint32 entry_cnt=0;
+	QDirIterator dir_itr(root_path, QDir::Files, QDirIterator::Subdirectories);
+
+	index_stream.setVersion(QDataStream::Qt_5_0);
+
+	while(dir_itr.hasNext())
+	{
+		dir_itr.next();
+		file_buf=UtilsNs::loadFile(dir_itr.filePath());
+
+		/* Each index entry holds the path relative to the packed directory and the
+		 * offset/size of the file contents within the blob section */
+		index_stream << QDir(root_path).relativeFilePath(dir_itr.filePath())
+								 << static_cast<quint64>(blobs.size())
+								 << static_cast<quint64>(file_buf.size());
+
+		blobs.append(file_buf);
+		entry_cnt++;
+	}
+
+	QByteArray header, archive_buf;
+	QDataStream header_stream(&header, QIODevice::WriteOnly);
+
+	header_stream.setVersion(QDataStream::Qt_5_0);
+	header_stream << entry_cnt << static_cast<quint64>(index.size());
+
+	archive_buf.append(ArchiveMagic);
+	archive_buf.append(header);
+	archive_buf.append(index);
+	archive_buf.append(blobs);
+
+	UtilsNs::saveFileAtomic(archive_path, archive_buf);
+}
+
+bool AssetArchive::mountArchive(const QString &archive_path, const QString &root_dir)
+{
+	if(!QFileInfo::exists(archive_path))
+		return false;
+
+	QMutexLocker locker(&mount_mtx);
+	QString root_path=QFileInfo(root_dir).absoluteFilePath();
+
+	//Ignoring the mounting if the directory is already covered by an archive
+	if(mounted_archives.count(root_path))
+		return true;
+
+	std::unique_ptr<MountedArchive> archive(new MountedArchive);
+	uchar *mapped=nullptr;
+
+	archive->file.reset(new QFile(archive_path));
+	archive->file->open(QFile::ReadOnly);
+
+	if(!archive->file->isOpen())
+		return false;
+
+	mapped=archive->file->map(0, archive->file->size());
+
+	if(mapped)
+		/* Wrapping the memory-mapped region without copying it. The file handle is kept
+		 * open so the mapping stays valid while the archive is mounted */
+		archive->buffer=QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), archive->file->size());
+	else
+		//Falling back to an ordinary read when the file can't be memory-mapped
+		archive->buffer=archive->file->readAll();
+
+	if(!archive->buffer.startsWith(ArchiveMagic))
+		return false;
+
+	QDataStream header_stream(archive->buffer);
+	quint32 entry_cnt=0;
+	quint64 index_size=0, offset=0, size=0;
+	QString rel_path;
+
+	header_stream.setVersion(QDataStream::Qt_5_0);
+	header_stream.skipRawData(ArchiveMagic.size());
+	header_stream >> entry_cnt >> index_size;
+
+	for(quint32 i=0; i < entry_cnt && header_stream.status()==QDataStream::Ok; i++)
+	{
+		header_stream >> rel_path >> offset >> size;
+		archive->entries[rel_path]=std::make_pair(offset, size);
+	}
+
+	//Rejecting archives whose index can't be fully read
+	if(header_stream.status()!=QDataStream::Ok || archive->entries.size()!=entry_cnt)
+		return false;
+
+	archive->blobs_offset=ArchiveMagic.size() + sizeof(quint32) + sizeof(quint64) + index_size;
+	mounted_archives[root_path]=std::move(archive);
+
+	return true;
+}
+
+bool AssetArchive::lookupEntry(const QString &filepath, QByteArray &buffer)
+{
+	QMutexLocker locker(&mount_mtx);
+
+	if(mounted_archives.empty())
+		return false;
+
+	QString abs_path=QFileInfo(filepath).absoluteFilePath();
+
+	for(auto &itr : mounted_archives)
+	{
+		if(!abs_path.startsWith(itr.first + QChar('/')))
+			continue;
+
+		QString rel_path=abs_path.mid(itr.first.size() + 1);
+		auto entry=itr.second->entries.find(rel_path);
+
+		if(entry==itr.second->entries.end())
+			return false;
+
+		/* The returned buffer wraps the archive mapping without copying it. The mapping
+		 * stays valid for the whole process lifetime since archives are never unmounted */
+		buffer=QByteArray::fromRawData(itr.second->buffer.constData() +
+																	 itr.second->blobs_offset + entry->second.first,
+																	 entry->second.second);
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,90 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class AssetArchive
+\brief Implements a single-file indexed archive for the runtime assets (schema files, dtds,
+catalog queries and configuration templates). Instead of resolving hundreds of individual
+small files through the filesystem at startup, the whole asset tree is packed into one
+memory-mappable archive whose entries are served straight from the mapping. Files present
+on disk always take precedence over their archived counterparts, so user customizations
+overlay the factory assets transparently (see UtilsNs::loadCachedFile).
+*/
+
+#ifndef ASSET_ARCHIVE_H
+#define ASSET_ARCHIVE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <map>
+#include <memory>
+#include <vector>
+
+class AssetArchive {
+	private:
+		//! \brief Holds a mounted archive: the memory-mapped buffer and its entry index
+		struct MountedArchive {
+			//! \brief The file kept open so the memory-mapped buffer stays valid
+			std::unique_ptr<QFile> file;
+
+			//! \brief The whole archive contents (wrapping the mapping whenever possible)
+			QByteArray buffer;
+
+			//! \brief Entry index: relative path -> (offset within the blob section, size)
+			std::map<QString, std::pair<quint64, quint64>> entries;
+
+			//! \brief Offset of the blob section within the archive buffer
+			quint64 blobs_offset;
+		};
+
+		//! \brief Magic token that identifies asset archive files
+		static const QByteArray ArchiveMagic;
+
+		//! \brief Mounted archives keyed by the absolute path of the directory they overlay
+		static std::map<QString, std::unique_ptr<MountedArchive>> mounted_archives;
+
+		//! \brief Controls the concurrent access to the mounted archives registry
+		static QMutex mount_mtx;
+
+	public:
+		//! \brief Default extension for asset archive files
+		static const QString ArchiveExt;
+
+		/*! \brief Packs all the files under dir_path (recursively) into a single archive written
+		 to archive_path. The entry paths are stored relative to dir_path. Raises an exception
+		 when the directory can't be read or the archive can't be written */
+		static void packDirectory(const QString &dir_path, const QString &archive_path);
+
+		/*! \brief Mounts the provided archive over root_dir so lookupEntry() can serve the files
+		 that would otherwise live under that directory. The archive is memory-mapped once and
+		 kept open for the whole process lifetime. Returns false when the archive doesn't exist
+		 or doesn't carry a valid index, in which case the assets are read from the filesystem
+		 as usual */
+		static bool mountArchive(const QString &archive_path, const QString &root_dir);
+
+		/*! \brief Retrieves the contents of the archived entry matching the provided absolute
+		 file path, returning true on success. The buffer wraps the archive mapping without
+		 copying it. Returns false when no mounted archive covers the path or the entry is
+		 absent, leaving the buffer untouched */
+		static bool lookupEntry(const QString &filepath, QByteArray &buffer);
+};
+
+#endif
@@ -275,7 +275,9 @@ QString Exception::messages[Exception::ErrorCount][2]={
 	{"InvProcedureParamOutMode", QT_TR_NOOP("Parameters using `out' mode are not supported by procedures! Use `inout' instead.") },
 	{"ExportFailureDbSQLDisabled", QT_TR_NOOP("The SQL code of the database `%1' is disabled! The export process can't proceed. Please, enable the SQL code of the mentioned object and try again.")},
 	{"InvConfigParameterName", QT_TR_NOOP("Invalid configuration parameter `%1' assigned to the function `%2'!")},
-	{"EmptyConfigParameterValue", QT_TR_NOOP("Empty value assigned to the configuration parameter `%1' in the function `%2'!")}
+	{"EmptyConfigParameterValue", QT_TR_NOOP("Empty value assigned to the configuration parameter `%1' in the function `%2'!")},
+	{"AsyncCmdAlreadyDispatched", QT_TR_NOOP("Unable to dispatch a new asynchronous command while the result of a previous one is still pending on the connection!")},
+	{"OprNoPendingAsyncCmd", QT_TR_NOOP("Attempt to retrieve the result of an asynchronous command without dispatching one previously!")}
 };
 
 Exception::Exception()
@@ -291,10 +293,10 @@ Exception::Exception(const QString &msg, const QString &method, const QString &f
 
 Exception::Exception(ErrorCode error_code, const QString &method, const QString &file, int line, Exception *exception, const QString &extra_info)
 {
-	/* Because the Exception class is not derived from QObject the function tr() is inefficient to translate messages
-		so the translation method is called  directly from the application specifying the
-		context (Exception) in the ts file and the text to be translated */
-	configureException(QApplication::translate("Exception",messages[enum_cast(error_code)][ErrorMessage].toStdString().c_str(),"", -1),
+	/* The message translation is deferred to getErrorMessage(): exceptions raised in parsing and
+		catalog/import paths are frequently caught and swallowed or retried as part of the normal
+		control flow, so the translation cost is paid only when the message is actually read */
+	configureException(error_code==ErrorCode::Custom ? getErrorMessage(error_code) : QString(),
 						 error_code, method, file, line, extra_info);
 
 	if(exception) addException(*exception);
@@ -310,10 +312,8 @@ Exception::Exception(ErrorCode error_code, const QString &method, const QString
 {
 	vector<Exception>::iterator itr, itr_end;
 
-	/* Because the Exception class is not derived from QObject the function tr() is inefficient to translate messages
-		so the translation method is called  directly from the application specifying the
-		context (Exception) in the ts file and the text to be translated */
-	configureException(QApplication::translate("Exception",messages[enum_cast(error_code)][ErrorMessage].toStdString().c_str(),"",-1),
+	//The message translation is deferred to getErrorMessage() (see the single exception version of this constructor)
+	configureException(error_code==ErrorCode::Custom ? getErrorMessage(error_code) : QString(),
 						 error_code, method, file, line, extra_info);
 
 	itr=exceptions.begin();
@@ -365,6 +365,12 @@ void Exception::configureException(const QString &msg, ErrorCode error_code, con
 
 QString Exception::getErrorMessage()
 {
+	/* Exceptions created only from an error code carry an empty message, being translated and
+		memoized here on the first access. Copies made by addException()/getExceptionsList()
+		preserve the deferral since they also hold an empty message with the original code */
+	if(error_msg.isEmpty() && error_code!=ErrorCode::Custom)
+		error_msg=getErrorMessage(error_code);
+
 	return error_msg;
 }
 
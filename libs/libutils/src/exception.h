@@ -301,12 +301,14 @@ enum class ErrorCode: unsigned {
 	InvProcedureParamOutMode,
 	ExportFailureDbSQLDisabled,
 	InvConfigParameterName,
-	EmptyConfigParameterValue
+	EmptyConfigParameterValue,
+	AsyncCmdAlreadyDispatched,
+	OprNoPendingAsyncCmd
 };
 
 class Exception {
 	private:
-		static constexpr unsigned ErrorCount=257;
+		static constexpr unsigned ErrorCount=259;
 
 		/*! \brief Stores other exceptions before raise the 'this' exception.
 		 This structure can be used to simulate a stack trace to improve the debug */
@@ -321,7 +323,9 @@ class Exception {
 		//! \brief Error type related to the exception
 		ErrorCode error_code;
 
-		//! \brief Formated error message
+		/*! \brief Formated error message. For exceptions created only from an error code this
+						attribute stays empty until the first getErrorMessage() call, which translates
+						and memoizes the message on demand */
 		QString error_msg,
 		/*! \brief Holds the class name and method which was
 						triggered the exception. For this to be possible, at the time
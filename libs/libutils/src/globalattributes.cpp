@@ -17,6 +17,7 @@
 */
 
 #include "globalattributes.h"
+#include "assetarchive.h"
 #include <QDir>
 
 /** Base version number **/
@@ -55,6 +56,8 @@ const QString GlobalAttributes::CatalogSchemasDir("catalog");
 const QString GlobalAttributes::DataDictSchemaDir("datadict");
 const QString GlobalAttributes::AlterSchemaDir("alter");
 const QString GlobalAttributes::SchemaExt(".sch");
+const QString GlobalAttributes::ModelCacheExt(".cache");
+const QString GlobalAttributes::CompressedDbModelExt(".dbmz");
 const QString GlobalAttributes::ObjectDTDDir("dtd");
 const QString GlobalAttributes::ObjectDTDExt(".dtd");
 const QString GlobalAttributes::RootDTD("dbmodel");
@@ -248,4 +251,11 @@ void GlobalAttributes::setSearchPath(const QString &search_path)
 		PgModelerAppPath=getPathFromEnv("PGMODELER_PATH", QString("%1\\pgmodeler.exe").arg(BINDIR), QString("%1\\pgmodeler.exe").arg(search_path));
 		PgModelerSchemaEditorPath=getPathFromEnv("PGMODELER_SE_PATH", QString("%1/pgmodeler-se.exe").arg(BINDIR), QString("%1/pgmodeler-sc.exe").arg(search_path));
 	#endif
+
+	/* Mounting the indexed asset archives (when present) over the schemas and template
+	 * configuration directories. This way the runtime assets are served from a single
+	 * memory-mapped file instead of hundreds of individual small files, while any file
+	 * placed on those directories still overrides its archived counterpart */
+	AssetArchive::mountArchive(SchemasRootDir + AssetArchive::ArchiveExt, SchemasRootDir);
+	AssetArchive::mountArchive(TmplConfigurationDir + AssetArchive::ArchiveExt, TmplConfigurationDir);
 }
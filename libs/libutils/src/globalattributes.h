@@ -104,6 +104,8 @@ class GlobalAttributes {
 		DataDictSchemaDir,//! \brief Default name for the data dictionary schemas directory
 		AlterSchemaDir,   //! \brief Default name for the alter schemas directory
 		SchemaExt,        //! \brief Default extension for schema files
+		ModelCacheExt,    //! \brief Default extension for the binary cache sidecar of database model files
+		CompressedDbModelExt, //! \brief Default extension for compressed database model files
 		ObjectDTDDir,     //! \brief Default directory for dtd files
 		ObjectDTDExt,     //! \brief Default extension for dtd files
 		RootDTD,          //! \brief Root DTD of model xml files
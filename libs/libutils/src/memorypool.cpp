@@ -0,0 +1,85 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "memorypool.h"
+
+std::vector<MemoryPool::FreeBlock *> MemoryPool::free_lists(MemoryPool::MaxBlockSize / MemoryPool::BlockGranularity, nullptr);
+std::vector<std::unique_ptr<char[]>> MemoryPool::chunks;
+std::size_t MemoryPool::chunk_used=ChunkSize;
+QMutex MemoryPool::pool_mtx;
+
+std::size_t MemoryPool::sizeClass(std::size_t size)
+{
+	return (size - 1) / BlockGranularity;
+}
+
+void *MemoryPool::allocate(std::size_t size)
+{
+	if(size==0)
+		size=1;
+
+	//Requests too big for the pool are served by the global heap
+	if(size > MaxBlockSize)
+		return ::operator new(size);
+
+	QMutexLocker lock(&pool_mtx);
+	std::size_t cls=sizeClass(size), block_size=(cls + 1) * BlockGranularity;
+
+	//Reusing a previously released block of the same size class when available
+	if(free_lists[cls])
+	{
+		FreeBlock *block=free_lists[cls];
+		free_lists[cls]=block->next;
+		return block;
+	}
+
+	//Carving a new block from the current chunk, allocating a new chunk when exhausted
+	if(chunk_used + block_size > ChunkSize)
+	{
+		chunks.push_back(std::unique_ptr<char[]>(new char[ChunkSize]));
+		chunk_used=0;
+	}
+
+	void *block=chunks.back().get() + chunk_used;
+	chunk_used+=block_size;
+
+	return block;
+}
+
+void MemoryPool::deallocate(void *ptr, std::size_t size)
+{
+	if(!ptr)
+		return;
+
+	if(size==0)
+		size=1;
+
+	if(size > MaxBlockSize)
+	{
+		::operator delete(ptr);
+		return;
+	}
+
+	QMutexLocker lock(&pool_mtx);
+	std::size_t cls=sizeClass(size);
+
+	//Linking the released block on the head of its size class free list
+	FreeBlock *block=static_cast<FreeBlock *>(ptr);
+	block->next=free_lists[cls];
+	free_lists[cls]=block;
+}
@@ -0,0 +1,117 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class MemoryPool
+\brief Implements a simple thread safe pooled allocator for small objects. Memory is carved from
+large chunks and released objects are kept in per-size-class free lists for reuse, so creating
+and destroying tens of thousands of model objects doesn't translate into the same amount of
+individual heap allocations (see BaseObject::operator new).
+*/
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <QMutex>
+
+class MemoryPool {
+	private:
+		//! \brief A released block, linked to the next free block of the same size class
+		struct FreeBlock {
+			FreeBlock *next;
+		};
+
+		//! \brief Alignment/rounding unit of the size classes
+		static constexpr std::size_t BlockGranularity=16;
+
+		//! \brief Maximum block size served by the pool, bigger requests fall back to the global heap
+		static constexpr std::size_t MaxBlockSize=1024;
+
+		//! \brief Size of the chunks requested from the global heap when the free lists are exhausted
+		static constexpr std::size_t ChunkSize=262144;
+
+		//! \brief Heads of the free lists, one per size class
+		static std::vector<FreeBlock *> free_lists;
+
+		//! \brief Chunks carved so far. They are released only at process exit
+		static std::vector<std::unique_ptr<char[]>> chunks;
+
+		//! \brief Consumed amount of the most recently allocated chunk
+		static std::size_t chunk_used;
+
+		//! \brief Controls the concurrent access to the pool structures
+		static QMutex pool_mtx;
+
+		//! \brief Returns the index of the size class that serves blocks of the provided size
+		static std::size_t sizeClass(std::size_t size);
+
+	public:
+		/*! \brief Returns a block of at least the provided size. Requests bigger than MaxBlockSize
+		 are forwarded to the global operator new */
+		static void *allocate(std::size_t size);
+
+		/*! \brief Returns a block to the pool. The size must be the same one passed to allocate(),
+		 which is guaranteed by the sized operator delete of the pooled classes */
+		static void deallocate(void *ptr, std::size_t size);
+};
+
+/**
+\class PooledAllocator
+\brief STL compatible allocator that serves the containers' node allocations from the MemoryPool
+free lists. Used mainly by attribs_map (see attribsmap.h) since the attribute maps seeded by every
+model object constructor are, after the objects themselves, the biggest source of small heap
+allocations on import/validation. All instances share the pool, so allocators of any two
+specializations compare equal. */
+template<typename T>
+class PooledAllocator {
+	public:
+		using value_type = T;
+
+		PooledAllocator() = default;
+
+		template<typename U>
+		PooledAllocator(const PooledAllocator<U> &) {}
+
+		T *allocate(std::size_t n)
+		{
+			return static_cast<T *>(MemoryPool::allocate(n * sizeof(T)));
+		}
+
+		void deallocate(T *ptr, std::size_t n)
+		{
+			MemoryPool::deallocate(ptr, n * sizeof(T));
+		}
+};
+
+template<typename T, typename U>
+bool operator==(const PooledAllocator<T> &, const PooledAllocator<U> &)
+{
+	return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const PooledAllocator<T> &, const PooledAllocator<U> &)
+{
+	return false;
+}
+
+#endif
@@ -0,0 +1,167 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "performancecounters.h"
+#include <QMutexLocker>
+
+std::atomic_bool PerformanceCounters::enabled{false};
+std::vector<PerformanceCounters::ThreadBlock *> PerformanceCounters::blocks;
+QMutex PerformanceCounters::blocks_mtx;
+
+PerformanceCounters::ThreadBlock *PerformanceCounters::threadBlock()
+{
+	thread_local ThreadBlock *block=nullptr;
+
+	if(!block)
+	{
+		block=new ThreadBlock;
+		QMutexLocker locker(&blocks_mtx);
+		blocks.push_back(block);
+	}
+
+	return block;
+}
+
+void PerformanceCounters::setEnabled(bool value)
+{
+	enabled.store(value, std::memory_order_relaxed);
+}
+
+bool PerformanceCounters::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void PerformanceCounters::incrementCounter(const QString &counter, qint64 amount)
+{
+	if(!isEnabled())
+		return;
+
+	ThreadBlock *block=threadBlock();
+	std::map<QString, qint64>::iterator itr=block->counters.find(counter);
+
+	//The map structure is modified only on the first occurrence of the counter name
+	if(itr==block->counters.end())
+	{
+		QMutexLocker locker(&block->mtx);
+		itr=block->counters.insert({counter, 0}).first;
+	}
+
+	itr->second+=amount;
+}
+
+void PerformanceCounters::addTiming(const QString &timing, qint64 nsecs)
+{
+	if(!isEnabled())
+		return;
+
+	ThreadBlock *block=threadBlock();
+	std::map<QString, Timing>::iterator itr=block->timings.find(timing);
+
+	//The map structure is modified only on the first occurrence of the timing name
+	if(itr==block->timings.end())
+	{
+		QMutexLocker locker(&block->mtx);
+		itr=block->timings.insert({timing, Timing()}).first;
+	}
+
+	itr->second.total_nsecs+=nsecs;
+	itr->second.calls++;
+}
+
+std::map<QString, qint64> PerformanceCounters::getCounters()
+{
+	std::map<QString, qint64> aggregated;
+	QMutexLocker locker(&blocks_mtx);
+
+	for(auto &block : blocks)
+	{
+		QMutexLocker blk_locker(&block->mtx);
+
+		for(auto &itr : block->counters)
+			aggregated[itr.first]+=itr.second;
+	}
+
+	return aggregated;
+}
+
+std::map<QString, std::pair<qint64, qint64>> PerformanceCounters::getTimings()
+{
+	std::map<QString, std::pair<qint64, qint64>> aggregated;
+	QMutexLocker locker(&blocks_mtx);
+
+	for(auto &block : blocks)
+	{
+		QMutexLocker blk_locker(&block->mtx);
+
+		for(auto &itr : block->timings)
+		{
+			aggregated[itr.first].first+=itr.second.total_nsecs;
+			aggregated[itr.first].second+=itr.second.calls;
+		}
+	}
+
+	return aggregated;
+}
+
+void PerformanceCounters::reset()
+{
+	QMutexLocker locker(&blocks_mtx);
+
+	for(auto &block : blocks)
+	{
+		QMutexLocker blk_locker(&block->mtx);
+		block->counters.clear();
+		block->timings.clear();
+	}
+}
+
+QString PerformanceCounters::dump()
+{
+	std::map<QString, qint64> counters=getCounters();
+	std::map<QString, std::pair<qint64, qint64>> timings=getTimings();
+	QString report;
+
+	if(!counters.empty())
+	{
+		report+=QString("Counters:\n");
+
+		for(auto &itr : counters)
+			report+=QString("  %1: %2\n").arg(itr.first).arg(itr.second);
+	}
+
+	if(!timings.empty())
+	{
+		report+=QString("Timings:\n");
+
+		for(auto &itr : timings)
+		{
+			double total_ms=itr.second.first / 1000000.0;
+
+			report+=QString("  %1: calls=%2 total=%3 ms avg=%4 ms\n")
+							.arg(itr.first).arg(itr.second.second)
+							.arg(QString::number(total_ms, 'f', 2))
+							.arg(QString::number(itr.second.second > 0 ? total_ms / itr.second.second : 0, 'f', 4));
+		}
+	}
+
+	if(report.isEmpty())
+		report=QString("No performance counters recorded.\n");
+
+	return report;
+}
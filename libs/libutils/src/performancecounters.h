@@ -0,0 +1,122 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class PerformanceCounters
+\brief Implements a process-wide surface where the subsystems record diagnostic counters and
+timings. Each thread accumulates into its own block, so the hot paths update plain integers
+without touching any shared lock: a mutex is taken only when a thread records a name for the
+first time and when the blocks are aggregated into a report. The facility is disabled by
+default and every recording entry point bails out on a single atomic flag check, keeping the
+instrumentation cost negligible on production runs.
+*/
+
+#ifndef PERFORMANCE_COUNTERS_H
+#define PERFORMANCE_COUNTERS_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+#include <map>
+#include <vector>
+
+class PerformanceCounters {
+	private:
+		//! \brief Accumulated elapsed time and call count of a single timing
+		struct Timing {
+			qint64 total_nsecs=0, calls=0;
+		};
+
+		/*! \brief Accumulation block owned by a single thread. The block mutex synchronizes the
+		 map structure changes (first occurrence of a name) and the aggregation walks; updates to
+		 already existing entries are plain stores on stable map nodes, so the aggregation may
+		 observe slightly stale values, which is acceptable for diagnostic data */
+		struct ThreadBlock {
+			QMutex mtx;
+			std::map<QString, qint64> counters;
+			std::map<QString, Timing> timings;
+		};
+
+		//! \brief Indicates that the counters are being recorded
+		static std::atomic_bool enabled;
+
+		/*! \brief Blocks of all the threads that recorded something so far. The blocks are never
+		 destroyed so the totals of finished threads survive until the process exits */
+		static std::vector<ThreadBlock *> blocks;
+
+		//! \brief Synchronizes the block registration and the aggregation
+		static QMutex blocks_mtx;
+
+		//! \brief Returns the calling thread's block, registering a new one on the first use
+		static ThreadBlock *threadBlock();
+
+	public:
+		//! \brief Enables/disables the recording of counters and timings
+		static void setEnabled(bool value);
+
+		//! \brief Indicates whether the recording is enabled
+		static bool isEnabled();
+
+		//! \brief Adds the provided amount to a counter of the calling thread
+		static void incrementCounter(const QString &counter, qint64 amount=1);
+
+		//! \brief Adds an elapsed time, in nanoseconds, to a timing of the calling thread
+		static void addTiming(const QString &timing, qint64 nsecs);
+
+		//! \brief Returns the counters of all the threads aggregated by name
+		static std::map<QString, qint64> getCounters();
+
+		//! \brief Returns the timings of all the threads aggregated by name
+		static std::map<QString, std::pair<qint64, qint64>> getTimings();
+
+		//! \brief Discards all the recorded counters and timings
+		static void reset();
+
+		/*! \brief Returns a plain text report holding all the aggregated counters and the
+		 timings with their call counts, total and average durations */
+		static QString dump();
+
+		/*! \brief Accumulates the elapsed lifetime of the instance, plus one call, into the
+		 named timing. Instances created while the recording is disabled don't even start the
+		 internal timer */
+		class ScopedTimer {
+			private:
+				QString timing;
+				QElapsedTimer timer;
+				bool active;
+
+			public:
+				ScopedTimer(const QString &timing) : timing(timing)
+				{
+					active=PerformanceCounters::isEnabled();
+
+					if(active)
+						timer.start();
+				}
+
+				~ScopedTimer()
+				{
+					if(active)
+						PerformanceCounters::addTiming(timing, timer.nsecsElapsed());
+				}
+		};
+};
+
+#endif
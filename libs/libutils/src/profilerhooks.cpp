@@ -0,0 +1,38 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "profilerhooks.h"
+
+/* The name of the phase being started/finished is stored in volatile globals: the stores
+ can't be elided by the optimizer, which keeps the hook calls (and their arguments) alive
+ in release builds, and the values can be inspected from a debugger or a probe attached
+ to the exported symbols. */
+static const char * volatile current_phase_begin=nullptr;
+static const char * volatile current_phase_end=nullptr;
+
+extern "C" {
+	Q_NEVER_INLINE void pgmodeler_phase_begin(const char *phase)
+	{
+		current_phase_begin=phase;
+	}
+
+	Q_NEVER_INLINE void pgmodeler_phase_end(const char *phase)
+	{
+		current_phase_end=phase;
+	}
+}
@@ -0,0 +1,65 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class ProfilerHooks
+\brief Exported, never-inlined hook functions emitted around the product's hot phases
+(schema evaluation, import object creation, diff computation/application, scene population).
+External profilers can attach probes to the pgmodeler_phase_begin/pgmodeler_phase_end
+symbols (e.g. `perf probe`, uprobes, ETW function tracing) and attribute samples to product
+phases without needing debug symbols for the whole Qt stack. The hooks are plain volatile
+stores, cheap enough to stay enabled on release builds; the current phase name is also
+readable from a debugger through the symbols themselves.
+*/
+
+#ifndef PROFILER_HOOKS_H
+#define PROFILER_HOOKS_H
+
+#include <QtGlobal>
+
+extern "C" {
+	//! \brief Marks the start of a named product phase. Probe target for external profilers
+	Q_DECL_EXPORT void pgmodeler_phase_begin(const char *phase);
+
+	//! \brief Marks the end of a named product phase. Probe target for external profilers
+	Q_DECL_EXPORT void pgmodeler_phase_end(const char *phase);
+}
+
+class ProfilerHooks {
+	public:
+		/*! \brief Emits pgmodeler_phase_begin/pgmodeler_phase_end around the instance's
+		 lifetime. The phase name must be a string literal (the pointer is kept, not copied) */
+		class Phase {
+			private:
+				const char *name;
+
+			public:
+				Phase(const char *name) : name(name)
+				{
+					pgmodeler_phase_begin(name);
+				}
+
+				~Phase()
+				{
+					pgmodeler_phase_end(name);
+				}
+		};
+};
+
+#endif
@@ -0,0 +1,64 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "progresschannel.h"
+
+ProgressChannel::ProgressChannel()
+{
+	reset();
+}
+
+bool ProgressChannel::reportProgress(int prog, unsigned type)
+{
+	obj_type.store(type, std::memory_order_relaxed);
+	seq.fetch_add(1, std::memory_order_release);
+
+	/* The exchange both publishes the new value and detects, without any lock, whether
+	 * the coalesced percentage moved. Concurrent producers (e.g. the diff precomparison
+	 * workers) may interleave freely: at worst an extra event is reported, never a torn
+	 * or lost value */
+	return progress.exchange(prog, std::memory_order_relaxed)!=prog;
+}
+
+void ProgressChannel::reset()
+{
+	progress.store(-1, std::memory_order_relaxed);
+	obj_type.store(0, std::memory_order_relaxed);
+	seq.store(0, std::memory_order_relaxed);
+}
+
+int ProgressChannel::getProgress() const
+{
+	return progress.load(std::memory_order_relaxed);
+}
+
+unsigned ProgressChannel::getObjectType() const
+{
+	return obj_type.load(std::memory_order_relaxed);
+}
+
+bool ProgressChannel::hasNews(unsigned &last_seq) const
+{
+	unsigned cur_seq=seq.load(std::memory_order_acquire);
+
+	if(cur_seq==last_seq)
+		return false;
+
+	last_seq=cur_seq;
+	return true;
+}
@@ -0,0 +1,72 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class ProgressChannel
+\brief Coalescing, lock-free progress reporting channel used by the helper classes
+(import, export, diff). At rates of thousands of processed objects per second, emitting
+one queued signal per object floods the receiver's event loop and the emission overhead
+itself becomes measurable. The channel absorbs the per-object reports with a single
+atomic exchange and tells the producer when the coalesced percentage actually changed,
+so the message formatting and the signal emission happen at most once per percentage
+point. Consumers can also poll the atomic state from a UI timer (see hasNews()) instead
+of relying on the signals at all.
+*/
+
+#ifndef PROGRESS_CHANNEL_H
+#define PROGRESS_CHANNEL_H
+
+#include <atomic>
+
+class ProgressChannel {
+	private:
+		//! \brief Latest reported progress percentage
+		std::atomic<int> progress;
+
+		//! \brief Object type of the latest report (the enum_cast value of an ObjectType)
+		std::atomic<unsigned> obj_type;
+
+		//! \brief Bumped on every report so pollers can detect news without comparing values
+		std::atomic<unsigned> seq;
+
+	public:
+		ProgressChannel();
+
+		/*! \brief Registers a progress report, returning true only when the coalesced percentage
+		 changed since the previous report. Hot loops are expected to skip the message formatting
+		 and the signal emission entirely when false is returned, which caps the reporting traffic
+		 at one event per percentage point no matter the object throughput */
+		bool reportProgress(int prog, unsigned type);
+
+		//! \brief Restarts the channel at the beginning of an operation
+		void reset();
+
+		//! \brief Returns the latest reported progress percentage
+		int getProgress() const;
+
+		//! \brief Returns the object type of the latest report
+		unsigned getObjectType() const;
+
+		/*! \brief Returns true when there were reports after the sequence number held by the caller,
+		 updating it. Together with getProgress() this allows a UI timer to sample the channel at
+		 screen refresh rate instead of receiving one queued event per processed object */
+		bool hasNews(unsigned &last_seq) const;
+};
+
+#endif
@@ -0,0 +1,157 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "stallwatchdog.h"
+#include "tracelogger.h"
+#include "globalattributes.h"
+#include <QFile>
+#include <QMutexLocker>
+#include <QThread>
+#include <chrono>
+
+std::atomic_bool StallWatchdog::enabled{false};
+int StallWatchdog::threshold_ms=StallWatchdog::DefaultThreshold;
+QElapsedTimer StallWatchdog::uptime;
+std::atomic<qint64> StallWatchdog::last_beat{0};
+QTimer *StallWatchdog::heartbeat_timer=nullptr;
+std::thread StallWatchdog::monitor;
+Qt::HANDLE StallWatchdog::watched_thread_id=nullptr;
+std::vector<StallWatchdog::StallReport> StallWatchdog::reports;
+QMutex StallWatchdog::reports_mtx;
+
+void StallWatchdog::start(int threshold_ms)
+{
+	if(enabled.load(std::memory_order_relaxed))
+		return;
+
+	if(threshold_ms <= 0)
+		threshold_ms=DefaultThreshold;
+
+	StallWatchdog::threshold_ms=threshold_ms;
+	watched_thread_id=QThread::currentThreadId();
+	uptime.start();
+	last_beat.store(0, std::memory_order_relaxed);
+
+	/* The watchdog relies on the tracing span stacks to tell which subsystem was
+	 running when the event loop froze */
+	TraceLogger::setContextTrackingEnabled(true);
+
+	/* The heartbeat timer is created on the calling (main) thread so its timeouts
+	 are dispatched by the event loop being watched: while the loop is blocked the
+	 timestamp stops advancing */
+	heartbeat_timer=new QTimer;
+	QObject::connect(heartbeat_timer, &QTimer::timeout, [](){
+		last_beat.store(uptime.elapsed(), std::memory_order_relaxed);
+	});
+	heartbeat_timer->start(HeartbeatInterval);
+
+	enabled.store(true, std::memory_order_relaxed);
+	monitor=std::thread(StallWatchdog::monitorLoop);
+}
+
+void StallWatchdog::stop()
+{
+	if(!enabled.load(std::memory_order_relaxed))
+		return;
+
+	enabled.store(false, std::memory_order_relaxed);
+	monitor.join();
+
+	heartbeat_timer->stop();
+	delete heartbeat_timer;
+	heartbeat_timer=nullptr;
+
+	TraceLogger::setContextTrackingEnabled(false);
+}
+
+bool StallWatchdog::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+void StallWatchdog::monitorLoop()
+{
+	bool in_stall=false;
+	qint64 beat=0, stall_beat=0;
+	StallReport report;
+
+	while(enabled.load(std::memory_order_relaxed))
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(HeartbeatInterval));
+		beat=last_beat.load(std::memory_order_relaxed);
+
+		if(!in_stall && uptime.elapsed() - beat > threshold_ms)
+		{
+			/* The event loop missed the threshold: capture the main thread's context right
+			 away since the spans may already be gone once the loop recovers */
+			in_stall=true;
+			stall_beat=beat;
+			report.detected_at=QDateTime::currentDateTime();
+			report.duration_ms=0;
+			report.active_spans=TraceLogger::getActiveSpans(watched_thread_id);
+		}
+		else if(in_stall && beat != stall_beat)
+		{
+			/* A fresh heartbeat arrived: the loop recovered, so the stall lasted from the
+			 last beat before the freeze until the first one after it */
+			in_stall=false;
+			report.duration_ms=beat - stall_beat;
+			registerReport(report);
+		}
+	}
+
+	// Finalizing an ongoing stall when the watchdog is stopped mid-freeze
+	if(in_stall)
+	{
+		report.duration_ms=uptime.elapsed() - stall_beat;
+		registerReport(report);
+	}
+}
+
+void StallWatchdog::registerReport(const StallReport &report)
+{
+	QFile output(getReportFilePath());
+	QString lin=QString("[%1] Main thread stalled for %2 ms. Active operations: %3\n")
+							.arg(report.detected_at.toString(QString("yyyy-MM-dd hh:mm:ss")))
+							.arg(report.duration_ms)
+							.arg(report.active_spans.isEmpty() ?
+										 QString("(no instrumented operation running)") :
+										 report.active_spans.join(QString(" > ")));
+
+	{
+		QMutexLocker locker(&reports_mtx);
+		reports.push_back(report);
+	}
+
+	if(output.open(QFile::WriteOnly | QFile::Append))
+	{
+		output.write(lin.toUtf8());
+		output.close();
+	}
+}
+
+std::vector<StallWatchdog::StallReport> StallWatchdog::getReports()
+{
+	QMutexLocker locker(&reports_mtx);
+	return reports;
+}
+
+QString StallWatchdog::getReportFilePath()
+{
+	return GlobalAttributes::getTemporaryFilePath(QString("ui_stalls.log"));
+}
@@ -0,0 +1,118 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class StallWatchdog
+\brief Detects stalls of the main (GUI) thread. A heartbeat timer running on the main thread's
+event loop periodically updates a shared timestamp while a background thread watches it; when
+the heartbeat stops arriving for longer than the configured threshold the watchdog captures
+the main thread's current operation context (the active tracing spans, see TraceLogger) and,
+once the event loop recovers, appends a report with the stall duration and the frozen
+subsystem to a diagnostics file in the temporary directory. This turns vague "it froze"
+reports into actionable data on large models.
+*/
+
+#ifndef STALL_WATCHDOG_H
+#define STALL_WATCHDOG_H
+
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QMutex>
+#include <Qt>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+class StallWatchdog {
+	public:
+		//! \brief Stores the details of a single detected main thread stall
+		struct StallReport {
+			//! \brief Moment the stall was detected (threshold already elapsed at this point)
+			QDateTime detected_at;
+
+			//! \brief Total time, in milliseconds, the event loop stayed blocked
+			qint64 duration_ms=0;
+
+			//! \brief Main thread's active tracing spans at detection time, outermost first
+			QStringList active_spans;
+		};
+
+	private:
+		//! \brief Indicates that the watchdog is running
+		static std::atomic_bool enabled;
+
+		//! \brief Stall detection threshold, in milliseconds
+		static int threshold_ms;
+
+		//! \brief Monotonic clock shared between the heartbeat and the monitor thread
+		static QElapsedTimer uptime;
+
+		//! \brief Timestamp (uptime-relative, in milliseconds) of the last processed heartbeat
+		static std::atomic<qint64> last_beat;
+
+		//! \brief Timer living on the main thread that feeds the heartbeat
+		static QTimer *heartbeat_timer;
+
+		//! \brief Background thread that watches the heartbeat timestamp
+		static std::thread monitor;
+
+		//! \brief Id of the thread being watched (the one start() was called from)
+		static Qt::HANDLE watched_thread_id;
+
+		//! \brief Reports of the stalls detected since the watchdog was started
+		static std::vector<StallReport> reports;
+
+		//! \brief Synchronizes the accesses to the reports list
+		static QMutex reports_mtx;
+
+		//! \brief Monitor thread's main loop
+		static void monitorLoop();
+
+		//! \brief Stores a finalized report and appends it to the diagnostics file
+		static void registerReport(const StallReport &report);
+
+	public:
+		/*! \brief Starts the watchdog over the calling thread's event loop (must be called from
+		 the main thread). Stalls longer than threshold_ms milliseconds are reported. Does nothing
+		 if the watchdog is already running */
+		static void start(int threshold_ms=DefaultThreshold);
+
+		//! \brief Stops the watchdog, finalizing the report of a stall still in progress (if any)
+		static void stop();
+
+		//! \brief Indicates whether the watchdog is running
+		static bool isEnabled();
+
+		//! \brief Returns the reports of the stalls detected so far
+		static std::vector<StallReport> getReports();
+
+		//! \brief Returns the path of the file where the stall reports are appended
+		static QString getReportFilePath();
+
+		//! \brief Default stall detection threshold (milliseconds)
+		static constexpr int DefaultThreshold=2000;
+
+		//! \brief Interval between two heartbeats / monitor polls (milliseconds)
+		static constexpr int HeartbeatInterval=250;
+};
+
+#endif
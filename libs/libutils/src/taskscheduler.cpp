@@ -0,0 +1,68 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "taskscheduler.h"
+#include <QThread>
+#include <QRunnable>
+
+namespace {
+	//! \brief QRunnable wrapper executing an arbitrary function on the shared pool
+	class FunctionTask: public QRunnable {
+		private:
+			std::function<void()> task;
+
+		public:
+			FunctionTask(const std::function<void()> &task) : task(task)
+			{
+				setAutoDelete(true);
+			}
+
+			void run() override
+			{
+				task();
+			}
+	};
+}
+
+QThreadPool &TaskScheduler::getThreadPool()
+{
+	/* The pool is created on first use and never destroyed: destroying it during the static
+	 * teardown could join threads after Qt's own infrastructure is gone */
+	static QThreadPool *pool=[](){
+		QThreadPool *new_pool=new QThreadPool;
+		new_pool->setMaxThreadCount(QThread::idealThreadCount());
+		return new_pool;
+	}();
+
+	return *pool;
+}
+
+void TaskScheduler::run(const std::function<void()> &task, TaskPriority priority)
+{
+	getThreadPool().start(new FunctionTask(task), priority);
+}
+
+int TaskScheduler::getMaxThreadCount()
+{
+	return getThreadPool().maxThreadCount();
+}
+
+void TaskScheduler::setMaxThreadCount(int count)
+{
+	getThreadPool().setMaxThreadCount(count > 0 ? count : QThread::idealThreadCount());
+}
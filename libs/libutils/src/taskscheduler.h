@@ -0,0 +1,89 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class TaskScheduler
+\brief Central scheduler for the CPU bound work submitted by the helper classes (diff
+precomparison, parallel code generation, image saving, etc.). All helpers share a single
+thread pool sized to the machine's core count, so concurrent operations split the cores
+between them instead of each one allocating its own pool and oversubscribing the machine
+(or leaving cores idle) depending on which dialogs are open. Tasks can be submitted with a
+priority and may carry a CancelToken checked cooperatively by the workers. The helpers'
+dedicated QThreads remain as orchestration/event-loop threads only — the heavy lifting is
+what goes through the pool.
+*/
+
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <QThreadPool>
+#include <functional>
+#include <memory>
+#include <atomic>
+
+class TaskScheduler {
+	public:
+		/*! \brief Priorities of the tasks submitted through run(). Maintenance work (e.g.
+		 deferred object destruction) should use LowPriority so it never delays user-visible
+		 operations */
+		enum TaskPriority: int {
+			LowPriority=-1,
+			NormalPriority=0,
+			HighPriority=1
+		};
+
+		/*! \brief Copyable cancellation handle shared between a task submitter and its workers.
+		 Cancellation is cooperative: the workers must poll isCanceled() at convenient points */
+		class CancelToken {
+			private:
+				std::shared_ptr<std::atomic_bool> canceled;
+
+			public:
+				CancelToken() : canceled(std::make_shared<std::atomic_bool>(false)) {}
+
+				//! \brief Flags the token as canceled, being seen by every copy of it
+				void requestCancel()
+				{
+					canceled->store(true, std::memory_order_relaxed);
+				}
+
+				//! \brief Indicates whether the cancellation was requested
+				bool isCanceled() const
+				{
+					return canceled->load(std::memory_order_relaxed);
+				}
+		};
+
+		/*! \brief Returns the shared thread pool. Helpers needing a QFuture submit through
+		 QtConcurrent::run(&TaskScheduler::getThreadPool(), ...) so the work still lands on
+		 the shared pool */
+		static QThreadPool &getThreadPool();
+
+		//! \brief Submits a fire-and-forget task to the shared pool with the provided priority
+		static void run(const std::function<void()> &task, TaskPriority priority=NormalPriority);
+
+		//! \brief Returns the maximum amount of threads of the shared pool
+		static int getMaxThreadCount();
+
+		/*! \brief Overrides the maximum amount of threads of the shared pool. Values <= 0
+		 restore the default (the machine's ideal thread count) */
+		static void setMaxThreadCount(int count);
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "tracelogger.h"
+#include "exception.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <QCoreApplication>
+
+std::atomic_bool TraceLogger::enabled{false};
+QFile TraceLogger::trace_file;
+QElapsedTimer TraceLogger::epoch;
+bool TraceLogger::first_event=true;
+QMutex TraceLogger::write_mtx;
+std::atomic_bool TraceLogger::ctx_tracking{false};
+std::map<Qt::HANDLE, QStringList> TraceLogger::active_spans;
+QMutex TraceLogger::ctx_mtx;
+
+void TraceLogger::start(const QString &filename)
+{
+	QMutexLocker locker(&write_mtx);
+
+	if(enabled.load(std::memory_order_relaxed))
+		return;
+
+	trace_file.setFileName(filename);
+
+	if(!trace_file.open(QFile::WriteOnly | QFile::Truncate))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(filename),
+										ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	trace_file.write("[\n");
+	first_event=true;
+	epoch.start();
+	enabled.store(true, std::memory_order_relaxed);
+}
+
+void TraceLogger::stop()
+{
+	QMutexLocker locker(&write_mtx);
+
+	if(!enabled.load(std::memory_order_relaxed))
+		return;
+
+	enabled.store(false, std::memory_order_relaxed);
+	trace_file.write("\n]\n");
+	trace_file.close();
+}
+
+bool TraceLogger::isEnabled()
+{
+	return enabled.load(std::memory_order_relaxed);
+}
+
+qint64 TraceLogger::elapsed()
+{
+	return epoch.isValid() ? epoch.nsecsElapsed() : 0;
+}
+
+void TraceLogger::setContextTrackingEnabled(bool value)
+{
+	QMutexLocker locker(&ctx_mtx);
+
+	ctx_tracking.store(value, std::memory_order_relaxed);
+
+	if(!value)
+		active_spans.clear();
+}
+
+bool TraceLogger::isContextTrackingEnabled()
+{
+	return ctx_tracking.load(std::memory_order_relaxed);
+}
+
+void TraceLogger::pushSpan(const QString &name)
+{
+	QMutexLocker locker(&ctx_mtx);
+
+	if(!isContextTrackingEnabled())
+		return;
+
+	active_spans[QThread::currentThreadId()].append(name);
+}
+
+void TraceLogger::popSpan()
+{
+	QMutexLocker locker(&ctx_mtx);
+	auto itr=active_spans.find(QThread::currentThreadId());
+
+	/* The stack may be absent when the tracking was toggled while the span was alive,
+	 in which case there's nothing to unwind */
+	if(itr==active_spans.end() || itr->second.isEmpty())
+		return;
+
+	itr->second.removeLast();
+
+	if(itr->second.isEmpty())
+		active_spans.erase(itr);
+}
+
+QStringList TraceLogger::getActiveSpans(Qt::HANDLE thread_id)
+{
+	QMutexLocker locker(&ctx_mtx);
+	auto itr=active_spans.find(thread_id);
+
+	if(itr==active_spans.end())
+		return QStringList();
+
+	return itr->second;
+}
+
+void TraceLogger::logEvent(const QString &name, qint64 start_nsecs, qint64 dur_nsecs)
+{
+	if(!isEnabled())
+		return;
+
+	/* Timestamps and durations are stored in microseconds as expected by the
+	 Chrome tracing format */
+	QString event=QString("{\"name\":\"%1\",\"ph\":\"X\",\"ts\":%2,\"dur\":%3,\"pid\":%4,\"tid\":%5}")
+								.arg(QString(name).replace('"', QString("\\\"")))
+								.arg(start_nsecs / 1000)
+								.arg(dur_nsecs / 1000)
+								.arg(QCoreApplication::applicationPid())
+								.arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+
+	QMutexLocker locker(&write_mtx);
+
+	/* Rechecking the flag under the lock: the tracing may have been stopped (and the
+	 file closed) between the check above and the lock acquisition */
+	if(!isEnabled())
+		return;
+
+	if(!first_event)
+		trace_file.write(",\n");
+
+	trace_file.write(event.toUtf8());
+	first_event=false;
+}
@@ -0,0 +1,139 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class TraceLogger
+\brief Implements an opt-in structured tracing facility that records the duration of the
+instrumented operations (model loading, relationship validation, import/diff/export phases)
+as Chrome trace events. The resulting file can be opened in any trace viewer compatible with
+the Chrome tracing format (chrome://tracing, Perfetto, etc.) exposing where the time of a
+long operation was spent, including the thread each span ran on. The tracing is disabled by
+default and every instrumentation point bails out on a single atomic flag check.
+*/
+
+#ifndef TRACE_LOGGER_H
+#define TRACE_LOGGER_H
+
+#include <QString>
+#include <QStringList>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <Qt>
+#include <atomic>
+#include <map>
+
+class TraceLogger {
+	private:
+		//! \brief Indicates that the trace events are being recorded
+		static std::atomic_bool enabled;
+
+		//! \brief File where the trace events are appended
+		static QFile trace_file;
+
+		//! \brief Reference timer from which the events' timestamps are derived
+		static QElapsedTimer epoch;
+
+		//! \brief Indicates that no event was written yet (controls the record separators)
+		static bool first_event;
+
+		//! \brief Synchronizes the event writes coming from different threads
+		static QMutex write_mtx;
+
+		/*! \brief Indicates that the per-thread stacks of active spans are being maintained.
+		 Independent from the trace file recording so diagnostics facilities (e.g. the UI stall
+		 watchdog) can inspect the current operation context without writing a trace file */
+		static std::atomic_bool ctx_tracking;
+
+		//! \brief Stacks of currently active span names keyed by the owning thread's id
+		static std::map<Qt::HANDLE, QStringList> active_spans;
+
+		//! \brief Synchronizes the accesses to the active spans' stacks
+		static QMutex ctx_mtx;
+
+	public:
+		/*! \brief Starts the tracing, truncating/creating the provided file. Raises an exception
+		 if the file can't be open for writing */
+		static void start(const QString &filename);
+
+		//! \brief Stops the tracing, finishing the event array and closing the trace file
+		static void stop();
+
+		//! \brief Indicates whether the tracing is enabled
+		static bool isEnabled();
+
+		/*! \brief Writes a complete event ("ph":"X") with the provided name, start timestamp and
+		 duration (both in nanoseconds, relative to the tracing start) tagged with the calling
+		 thread id */
+		static void logEvent(const QString &name, qint64 start_nsecs, qint64 dur_nsecs);
+
+		//! \brief Returns the elapsed time, in nanoseconds, since the tracing started
+		static qint64 elapsed();
+
+		/*! \brief Enables/disables the maintenance of the per-thread active span stacks.
+		 Disabling discards any context recorded so far */
+		static void setContextTrackingEnabled(bool value);
+
+		//! \brief Indicates whether the active span stacks are being maintained
+		static bool isContextTrackingEnabled();
+
+		//! \brief Pushes a span name onto the calling thread's active span stack
+		static void pushSpan(const QString &name);
+
+		//! \brief Pops the most recent span name from the calling thread's active span stack
+		static void popSpan();
+
+		/*! \brief Returns a copy of the active span stack of the provided thread, outermost span
+		 first. Returns an empty list when the thread has no active spans or the context tracking
+		 is disabled */
+		static QStringList getActiveSpans(Qt::HANDLE thread_id);
+
+		/*! \brief Records the lifetime of the instance as a complete trace event. Spans created
+		 while the tracing is disabled don't write anything on destruction */
+		class Span {
+			private:
+				QString name;
+				qint64 start_nsecs;
+				bool active, tracked;
+
+			public:
+				Span(const QString &name) : name(name)
+				{
+					active=TraceLogger::isEnabled();
+					tracked=TraceLogger::isContextTrackingEnabled();
+
+					if(active)
+						start_nsecs=TraceLogger::elapsed();
+
+					if(tracked)
+						TraceLogger::pushSpan(name);
+				}
+
+				~Span()
+				{
+					if(active && TraceLogger::isEnabled())
+						TraceLogger::logEvent(name, start_nsecs, TraceLogger::elapsed() - start_nsecs);
+
+					if(tracked)
+						TraceLogger::popSpan();
+				}
+		};
+};
+
+#endif
@@ -17,16 +17,43 @@
 */
 
 #include "utilsns.h"
+#include "assetarchive.h"
 #include "exception.h"
 #include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QMutex>
+#include <map>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
 
 namespace UtilsNs {
+	//! \brief Immutable file buffers cache used by loadCachedFile() (keyed by the absolute file path)
+	static std::map<QString, QByteArray> file_buf_cache;
+
+	//! \brief Files kept open so their memory-mapped buffers stay valid during the whole process lifetime
+	static std::vector<std::unique_ptr<QFile>> mapped_files;
+
+	//! \brief Controls the concurrent access to the file buffers cache
+	static QMutex file_buf_cache_mtx;
+
 	void saveFile(const QString &filename, const QByteArray &buffer)
 	{
 		QFile output;
 
 		output.setFileName(filename);
-		output.open(QFile::WriteOnly);
+
+		/* The file is opened unbuffered since the whole buffer is written in a single call,
+		 * this way the bytes go straight to the operating system instead of being copied
+		 * into the QFile internal write buffer first */
+		output.open(QFile::WriteOnly | QFile::Unbuffered);
 
 		if(!output.isOpen())
 			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(output.fileName()),
@@ -36,6 +63,62 @@ namespace UtilsNs {
 		output.close();
 	}
 
+	void saveFileAtomic(const QString &filename, const QByteArray &buffer)
+	{
+		QSaveFile output;
+
+		output.setFileName(filename);
+		output.open(QFile::WriteOnly);
+
+		if(!output.isOpen())
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(output.fileName()),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		output.write(buffer);
+
+		/* The buffer is forced to the storage device before the atomic rename takes place, so
+		 * after a crash (or power loss) the destination file holds either its old or its new
+		 * contents, never a partially written one */
+		output.flush();
+
+#ifdef Q_OS_WIN
+		_commit(output.handle());
+#else
+		fsync(output.handle());
+#endif
+
+		//The destination file is replaced only if the whole buffer was successfully written
+		if(!output.commit())
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(output.fileName()),
+											ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	void syncFileSystem(const QString &path)
+	{
+#ifdef Q_OS_WIN
+		/* Windows has no filesystem-wide synchronization primitive reachable from user code,
+		 * so we only force the pending writes of the process itself to the operating system */
+		_flushall();
+#else
+		QFileInfo fi(path);
+		QString dir_path=fi.isDir() ? fi.absoluteFilePath() : fi.absolutePath();
+		int fd=::open(dir_path.toStdString().c_str(), O_RDONLY);
+
+		if(fd < 0)
+			return;
+
+#ifdef Q_OS_LINUX
+		//Flushes all the pending writes of the filesystem holding the directory in a single call
+		syncfs(fd);
+#else
+		//Makes at least the directory entries of the newly created files durable
+		fsync(fd);
+#endif
+
+		::close(fd);
+#endif
+	}
+
 	QByteArray loadFile(const QString &filename)
 	{
 		QFile input;
@@ -52,4 +135,58 @@ namespace UtilsNs {
 		 * The file descriptor will be closed in the destructor of QFile */
 		return input.readAll();
 	}
+
+	QByteArray loadCachedFile(const QString &filename)
+	{
+		QString abs_path=QFileInfo(filename).absoluteFilePath();
+		QMutexLocker locker(&file_buf_cache_mtx);
+		auto itr=file_buf_cache.find(abs_path);
+
+		//Returning the buffer right away if the file was loaded previously
+		if(itr!=file_buf_cache.end())
+			return itr->second;
+
+		/* Trying to serve the file from a mounted asset archive. Files present on disk
+		 * take precedence so user customizations overlay the archived (factory) assets */
+		QByteArray arch_buf;
+
+		if(!QFileInfo::exists(abs_path) && AssetArchive::lookupEntry(abs_path, arch_buf))
+		{
+			file_buf_cache[abs_path]=arch_buf;
+			return arch_buf;
+		}
+
+		std::unique_ptr<QFile> input(new QFile(filename));
+		QByteArray buffer;
+		uchar *mapped=nullptr;
+
+		input->open(QFile::ReadOnly);
+
+		if(!input->isOpen())
+			throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(input->fileName()),
+											ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		mapped=input->map(0, input->size());
+
+		if(mapped)
+		{
+			/* Wrapping the memory-mapped region without copying it. The file handle is
+			 * kept open so the mapping stays valid while the buffer is cached */
+			buffer=QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), input->size());
+			mapped_files.push_back(std::move(input));
+		}
+		else
+			//Falling back to an ordinary read when the file can't be memory-mapped
+			buffer=input->readAll();
+
+		file_buf_cache[abs_path]=buffer;
+		return buffer;
+	}
+
+	void clearFileCache()
+	{
+		QMutexLocker locker(&file_buf_cache_mtx);
+		file_buf_cache.clear();
+		mapped_files.clear();
+	}
 }
@@ -53,9 +53,34 @@ namespace UtilsNs {
 	 * Raises an exception in case of the file couldn,t be open */
 	extern void saveFile(const QString &filename, const QByteArray &buffer);
 
+	/*! \brief Writes the provided buffer to a temporary sibling file, forces it to the storage
+	 * device and then atomically replaces the destination, so neither concurrent readers nor a
+	 * crash mid-write can ever expose a partially written file.
+	 * Raises an exception in case of the file couldn't be open or committed */
+	extern void saveFileAtomic(const QString &filename, const QByteArray &buffer);
+
+	/*! \brief Forces the pending buffered writes of the filesystem holding the provided path to the
+	 * storage device in a single call. This is meant to be used as an end-of-run durability barrier
+	 * by the multi-file export routines, which write all of their files without any per-file flush
+	 * (see saveFile) and pay the synchronization cost only once. On platforms without a
+	 * filesystem-wide synchronization primitive the call degrades to flushing the process' own
+	 * pending writes. Failures are ignored since the files were already successfully written */
+	extern void syncFileSystem(const QString &path);
+
 	/*! \brief Read the contents of the file specified by its filename returning its contents.
 	 * Raises an exception in case of the file couldn,t be open */
 	extern QByteArray loadFile(const QString &filename);
+
+	/*! \brief Read the contents of the file specified by its filename storing the resulting buffer
+	 * in a process-wide cache keyed by the absolute file path so further loads of the same file don't
+	 * touch the disk again. The file is memory-mapped whenever the platform allows it, falling back to
+	 * an ordinary read otherwise. This function is meant for immutable runtime assets (schema files,
+	 * DTDs, catalog queries) that never change during the process lifetime, for user files use loadFile().
+	 * Raises an exception in case of the file couldn,t be open */
+	extern QByteArray loadCachedFile(const QString &filename);
+
+	//! \brief Purges the immutable file buffers cache used by loadCachedFile()
+	extern void clearFileCache();
 }
 
 #endif
@@ -1,7 +1,7 @@
 # This file contains the main variables settings to build pgModeler on all supported platforms.
 
 # General Qt settings
-QT += core widgets printsupport network svg
+QT += core widgets printsupport network svg concurrent sql
 CONFIG += ordered qt stl rtti exceptions warn_on c++14
 TEMPLATE = subdirs
 MOC_DIR = moc
@@ -0,0 +1,110 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup tests
+\namespace BenchmarkModel
+\brief Builds the synthesized database models used by the benchmark and performance regression
+targets. Keeping the builder (and the environment variable helper that sizes it) here ensures all
+the targets measure over the same model shape and that fixture changes reach all of them at once.
+*/
+
+#ifndef BENCHMARK_MODEL_H
+#define BENCHMARK_MODEL_H
+
+#include "databasemodel.h"
+#include "table.h"
+#include "column.h"
+#include "constraint.h"
+#include "relationship.h"
+
+namespace BenchmarkModel {
+	//! \brief Returns the value of an integer environment variable, falling back to def_value when unset or invalid
+	inline int envValue(const char *varname, int def_value)
+	{
+		bool ok=false;
+		int value=qEnvironmentVariableIntValue(varname, &ok);
+		return (ok && value > 0 ? value : def_value);
+	}
+
+	/*! \brief Populates the provided model with table_count tables of column_count columns each,
+	 plus a primary key per table and rel_count one-to-many relationships connecting evenly spaced
+	 table pairs (so the measured operations also exercise column/constraint propagation).
+	 When mixed_col_types is set the columns alternate between integer and varchar instead of being
+	 all integers; when grid_layout is set the tables receive grid positions so canvas operations
+	 cross populated regions */
+	inline void buildModel(DatabaseModel *model, const QString &db_name, int table_count,
+												 int column_count, int rel_count, bool mixed_col_types=false,
+												 bool grid_layout=false)
+	{
+		Schema *schema=nullptr;
+		Table *table=nullptr, *prev_table=nullptr;
+		Column *column=nullptr;
+		Constraint *pk=nullptr;
+		Relationship *rel=nullptr;
+
+		model->createSystemObjects(true);
+		model->setName(db_name);
+		schema=model->getSchema("public");
+
+		for(int tab_idx=0; tab_idx < table_count; tab_idx++)
+		{
+			table=new Table;
+			table->setName(QString("table_%1").arg(tab_idx));
+			table->setSchema(schema);
+
+			if(grid_layout)
+				table->setPosition(QPointF((tab_idx % 10) * 300, (tab_idx / 10) * 250));
+
+			for(int col_idx=0; col_idx < column_count; col_idx++)
+			{
+				column=new Column;
+				column->setName(QString("column_%1").arg(col_idx));
+
+				if(col_idx==0)
+					column->setType(PgSqlType("serial"));
+				else if(mixed_col_types)
+					column->setType(PgSqlType(col_idx % 2==0 ? "integer" : "varchar"));
+				else
+					column->setType(PgSqlType("integer"));
+
+				table->addColumn(column);
+			}
+
+			pk=new Constraint;
+			pk->setConstraintType(ConstraintType::PrimaryKey);
+			pk->setName(QString("table_%1_pk").arg(tab_idx));
+			pk->addColumn(table->getColumn(0), Constraint::SourceCols);
+			table->addConstraint(pk);
+
+			model->addTable(table);
+		}
+
+		for(int rel_idx=0; rel_idx < rel_count && rel_idx + 1 < table_count; rel_idx++)
+		{
+			prev_table=model->getTable(QString("public.table_%1").arg(rel_idx));
+			table=model->getTable(QString("public.table_%1").arg(rel_idx + 1));
+
+			rel=new Relationship(BaseRelationship::Relationship1n, prev_table, table);
+			rel->setName(QString("rel_%1").arg(rel_idx));
+			model->addRelationship(rel);
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,274 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include <QImage>
+#include <QPainter>
+#include "objectsscene.h"
+#include "baseobjectview.h"
+#include "tableview.h"
+#include "relationshipview.h"
+#include "databasemodel.h"
+#include "table.h"
+#include "qtcompat/qtextstreamcompat.h"
+#include "pgmodelerunittest.h"
+#include "benchmarkmodel.h"
+
+/* Benchmarks the canvas interactivity primitives (pan, zoom, selection, table move) against
+ * an ObjectsScene populated from a synthesized model and rendered offscreen into a QImage,
+ * so no window nor display server interaction skews the numbers (the suite also runs under
+ * QT_QPA_PLATFORM=offscreen). Besides the QBENCHMARK medians, each operation prints its
+ * frame statistics (frame count, min/avg/max frame time and the effective frame rate) so
+ * canvas regressions become measurable instead of anecdotal.
+ *
+ * The scene size is parameterized through the environment variables below:
+ *
+ * PGMODELER_CANVAS_TABLES  - amount of tables (default 60)
+ * PGMODELER_CANVAS_COLUMNS - amount of columns per table (default 8)
+ * PGMODELER_CANVAS_RELS    - amount of one-to-many relationships (default tables/3) */
+class CanvasBenchmark: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		static constexpr int ViewportWidth=1280,
+		ViewportHeight=1024,
+		PanSteps=25,
+		ZoomSteps=15;
+
+		int table_count, column_count, rel_count;
+		DatabaseModel *dbmodel;
+		ObjectsScene *scene;
+		QImage viewport;
+		QVector<qint64> frame_times;
+
+		void populateScene();
+
+		//! \brief Renders the provided scene region into the offscreen viewport, timing the frame
+		void renderFrame(const QRectF &src_rect);
+
+		//! \brief Prints the statistics of the frames rendered since the last call and resets them
+		void reportFrameStats(const QString &operation);
+
+	public:
+		CanvasBenchmark() : PgModelerUnitTest(SCHEMASDIR)
+		{
+			table_count=BenchmarkModel::envValue("PGMODELER_CANVAS_TABLES", 60);
+			column_count=BenchmarkModel::envValue("PGMODELER_CANVAS_COLUMNS", 8);
+			rel_count=BenchmarkModel::envValue("PGMODELER_CANVAS_RELS", table_count / 3);
+			dbmodel=nullptr;
+			scene=nullptr;
+			viewport=QImage(ViewportWidth, ViewportHeight, QImage::Format_ARGB32);
+		}
+
+	private slots:
+		void initTestCase();
+		void benchmarkPanning();
+		void benchmarkZooming();
+		void benchmarkSelection();
+		void benchmarkTableMove();
+		void cleanupTestCase();
+};
+
+void CanvasBenchmark::populateScene()
+{
+	Table *table=nullptr;
+	vector<BaseObject *> *rels=dbmodel->getObjectList(ObjectType::Relationship);
+
+	/* The table views must exist before the relationship ones since RelationshipView
+	 * anchors its lines on the participant tables' overlying views */
+	for(int tab_idx=0; tab_idx < table_count; tab_idx++)
+	{
+		table=dbmodel->getTable(QString("public.table_%1").arg(tab_idx));
+		scene->addItem(new TableView(table));
+	}
+
+	for(auto &rel : *rels)
+		scene->addItem(new RelationshipView(dynamic_cast<BaseRelationship *>(rel)));
+
+	scene->setSceneRect(scene->itemsBoundingRect().adjusted(-100, -100, 100, 100));
+}
+
+void CanvasBenchmark::renderFrame(const QRectF &src_rect)
+{
+	QElapsedTimer frame_timer;
+	QPainter painter(&viewport);
+
+	frame_timer.start();
+	viewport.fill(Qt::white);
+	scene->render(&painter, QRectF(0, 0, ViewportWidth, ViewportHeight), src_rect);
+	frame_times.append(frame_timer.nsecsElapsed());
+}
+
+void CanvasBenchmark::reportFrameStats(const QString &operation)
+{
+	QTextStream out(stdout);
+	qint64 min_ns=0, max_ns=0, total_ns=0;
+
+	if(frame_times.isEmpty())
+		return;
+
+	min_ns=max_ns=frame_times.first();
+
+	for(auto &frame_ns : frame_times)
+	{
+		min_ns=qMin(min_ns, frame_ns);
+		max_ns=qMax(max_ns, frame_ns);
+		total_ns+=frame_ns;
+	}
+
+	double avg_ms=(total_ns / static_cast<double>(frame_times.size())) / 1000000.0;
+
+	out << QString("%1: frames=%2 min=%3 ms avg=%4 ms max=%5 ms (%6 fps)")
+				 .arg(operation)
+				 .arg(frame_times.size())
+				 .arg(QString::number(min_ns / 1000000.0, 'f', 2))
+				 .arg(QString::number(avg_ms, 'f', 2))
+				 .arg(QString::number(max_ns / 1000000.0, 'f', 2))
+				 .arg(QString::number(avg_ms > 0 ? 1000.0 / avg_ms : 0, 'f', 1)) << QtCompat::endl;
+
+	frame_times.clear();
+}
+
+void CanvasBenchmark::initTestCase()
+{
+	try
+	{
+		/* The objects style configuration is optional here: when the config files aren't
+		 * deployed next to the test binary the views just fall back to default formats */
+		try
+		{
+			BaseObjectView::loadObjectsStyle();
+		}
+		catch(Exception &){}
+
+		/* The grid layout flag makes the shared builder lay the tables out in a grid
+		 * so panning actually crosses populated regions */
+		dbmodel=new DatabaseModel;
+		BenchmarkModel::buildModel(dbmodel, "canvas_benchmark_db", table_count, column_count, rel_count, false, true);
+
+		scene=new ObjectsScene;
+		populateScene();
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void CanvasBenchmark::benchmarkPanning()
+{
+	QRectF scn_rect=scene->sceneRect();
+	qreal max_offset=qMax(0.0, scn_rect.width() - ViewportWidth),
+			step=max_offset / PanSteps;
+
+	QBENCHMARK
+	{
+		for(int i=0; i <= PanSteps; i++)
+			renderFrame(QRectF(scn_rect.left() + (i * step), scn_rect.top(), ViewportWidth, ViewportHeight));
+	}
+
+	reportFrameStats("panning");
+}
+
+void CanvasBenchmark::benchmarkZooming()
+{
+	QRectF scn_rect=scene->sceneRect();
+	QPointF center=scn_rect.center();
+
+	QBENCHMARK
+	{
+		//Zoom factors from 0.3 to 3.0, mirroring the range offered by the model widget
+		for(int i=0; i < ZoomSteps; i++)
+		{
+			double factor=0.3 + ((3.0 - 0.3) * i) / (ZoomSteps - 1);
+			QSizeF src_size(ViewportWidth / factor, ViewportHeight / factor);
+
+			renderFrame(QRectF(center - QPointF(src_size.width() / 2, src_size.height() / 2), src_size));
+		}
+	}
+
+	reportFrameStats("zooming");
+}
+
+void CanvasBenchmark::benchmarkSelection()
+{
+	QRectF scn_rect=scene->sceneRect(),
+			sel_rect(scn_rect.topLeft(), QSizeF(scn_rect.width() / 2, scn_rect.height() / 2));
+
+	QBENCHMARK
+	{
+		//Simulating a rubber band selection over the upper-left quarter of the diagram
+		for(auto &item : scene->items(sel_rect, Qt::IntersectsItemShape))
+			item->setSelected(item->flags() & QGraphicsItem::ItemIsSelectable);
+
+		renderFrame(QRectF(scn_rect.topLeft(), QSizeF(ViewportWidth, ViewportHeight)));
+		scene->clearSelection();
+		renderFrame(QRectF(scn_rect.topLeft(), QSizeF(ViewportWidth, ViewportHeight)));
+	}
+
+	reportFrameStats("selection");
+}
+
+void CanvasBenchmark::benchmarkTableMove()
+{
+	QRectF scn_rect=scene->sceneRect();
+	Table *table=nullptr;
+	BaseObjectView *tab_view=nullptr;
+	QVector<BaseObjectView *> moved_views;
+
+	//Moving the first row of tables, which drags their relationship lines along
+	for(int tab_idx=0; tab_idx < 10 && tab_idx < table_count; tab_idx++)
+	{
+		table=dbmodel->getTable(QString("public.table_%1").arg(tab_idx));
+		tab_view=dynamic_cast<BaseObjectView *>(table->getOverlyingObject());
+
+		if(tab_view)
+			moved_views.append(tab_view);
+	}
+
+	QBENCHMARK
+	{
+		for(auto &view : moved_views)
+			view->moveBy(15, 10);
+
+		renderFrame(QRectF(scn_rect.topLeft(), QSizeF(ViewportWidth, ViewportHeight)));
+
+		for(auto &view : moved_views)
+			view->moveBy(-15, -10);
+
+		renderFrame(QRectF(scn_rect.topLeft(), QSizeF(ViewportWidth, ViewportHeight)));
+	}
+
+	reportFrameStats("table-move");
+}
+
+void CanvasBenchmark::cleanupTestCase()
+{
+	/* The scene (and the views it owns) must go away before the model objects
+	 * they are attached to */
+	delete scene;
+
+	if(dbmodel)
+	{
+		dbmodel->destroyObjects();
+		delete dbmodel;
+	}
+}
+
+QTEST_MAIN(CanvasBenchmark)
+#include "canvasbenchmark.moc"
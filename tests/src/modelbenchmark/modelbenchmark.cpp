@@ -0,0 +1,160 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "databasemodel.h"
+#include "qtcompat/qtextstreamcompat.h"
+#include "pgmodelerunittest.h"
+#include "benchmarkmodel.h"
+
+/* Benchmarks the most performance sensitive operations of DatabaseModel over a synthesized
+ * model. The model size is parameterized through the environment variables below so the
+ * same binary can exercise small and huge models:
+ *
+ * PGMODELER_BENCHMARK_TABLES  - amount of tables (default 50)
+ * PGMODELER_BENCHMARK_COLUMNS - amount of columns per table (default 20)
+ * PGMODELER_BENCHMARK_RELS    - amount of one-to-many relationships (default tables/10)
+ *
+ * The QBENCHMARK reporting (median of several iterations) makes runs comparable between
+ * releases so performance regressions can be detected before they ship. */
+class ModelBenchmark: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		int table_count, column_count, rel_count;
+		QString model_file;
+		DatabaseModel *dbmodel;
+
+	public:
+		ModelBenchmark() : PgModelerUnitTest(SCHEMASDIR)
+		{
+			table_count=BenchmarkModel::envValue("PGMODELER_BENCHMARK_TABLES", 50);
+			column_count=BenchmarkModel::envValue("PGMODELER_BENCHMARK_COLUMNS", 20);
+			rel_count=BenchmarkModel::envValue("PGMODELER_BENCHMARK_RELS", table_count / 10);
+			model_file=QDir::tempPath() + GlobalAttributes::DirSeparator + QString("pgmodeler_benchmark.dbm");
+			dbmodel=nullptr;
+		}
+
+	private slots:
+		void initTestCase();
+		void benchmarkLoadModel();
+		void benchmarkGetCodeDefinition();
+		void benchmarkSaveModel();
+		void benchmarkFindObjects();
+		void cleanupTestCase();
+};
+
+void ModelBenchmark::initTestCase()
+{
+	QTextStream out(stdout);
+
+	try
+	{
+		dbmodel=new DatabaseModel;
+		BenchmarkModel::buildModel(dbmodel, "benchmark_db", table_count, column_count, rel_count, true);
+		dbmodel->saveModel(model_file, SchemaParser::XmlDefinition);
+
+		out << QString("Benchmark model: %1 table(s), %2 column(s) per table, %3 relationship(s)")
+					 .arg(table_count).arg(column_count).arg(rel_count) << QtCompat::endl;
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ModelBenchmark::benchmarkLoadModel()
+{
+	try
+	{
+		QBENCHMARK
+		{
+			DatabaseModel model;
+			model.createSystemObjects(false);
+			model.loadModel(model_file);
+			model.destroyObjects();
+		}
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ModelBenchmark::benchmarkGetCodeDefinition()
+{
+	try
+	{
+		QBENCHMARK
+		{
+			//Invalidating the cached code so the whole SQL is regenerated on each iteration
+			dbmodel->setCodesInvalidated();
+			dbmodel->getCodeDefinition(SchemaParser::SqlDefinition);
+		}
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void ModelBenchmark::benchmarkSaveModel()
+{
+	QString output=QDir::tempPath() + GlobalAttributes::DirSeparator + QString("pgmodeler_benchmark_out.dbm");
+
+	try
+	{
+		QBENCHMARK
+		{
+			dbmodel->saveModel(output, SchemaParser::XmlDefinition);
+		}
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+
+	QFile::remove(output);
+}
+
+void ModelBenchmark::benchmarkFindObjects()
+{
+	vector<BaseObject *> objects;
+
+	QBENCHMARK
+	{
+		objects=dbmodel->findObjects("column_", { ObjectType::Table, ObjectType::Column },
+																 false, false, false);
+	}
+
+	QVERIFY(!objects.empty());
+}
+
+void ModelBenchmark::cleanupTestCase()
+{
+	if(dbmodel)
+	{
+		dbmodel->destroyObjects();
+		delete dbmodel;
+	}
+
+	QFile::remove(model_file);
+}
+
+QTEST_MAIN(ModelBenchmark)
+#include "modelbenchmark.moc"
@@ -0,0 +1,274 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <functional>
+#include "databasemodel.h"
+#include "utilsns.h"
+#include "benchmarkmodel.h"
+#include "qtcompat/qtextstreamcompat.h"
+#include "pgmodelerunittest.h"
+
+/* Performance regression gate. Each step is measured several times and the minimum wall time
+ * (the most noise resistant estimator: a machine can't run faster than its best case) is
+ * normalized by a machine factor derived from a fixed CPU bound calibration workload, making
+ * the numbers comparable between machine classes. The normalized results are checked against
+ * the checked-in baseline (perfbaseline.json next to this source) and the test fails when a
+ * step got slower than the allowed tolerance, so builds can be gated on "model load did not
+ * get N% slower" automatically.
+ *
+ * PGMODELER_PERF_TOLERANCE      - allowed slowdown fraction over the baseline (default 0.20)
+ * PGMODELER_PERF_REPETITIONS    - measurements per step (default 7)
+ * PGMODELER_PERF_WRITE_BASELINE - when set to 1 rewrites the baseline file with the measured
+ *                                 values instead of asserting against it */
+class PerfRegressionTest: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		static constexpr int TableCount=20, ColumnCount=10, RelCount=2,
+		SchemaEvalRounds=500;
+
+		QString model_file;
+		DatabaseModel *dbmodel;
+		QJsonObject baseline, measured_steps;
+
+		//! \brief Ratio between this machine's calibration time and the baseline's reference one
+		double machine_factor;
+
+		double tolerance;
+		int repetitions;
+		bool write_baseline;
+
+		qint64 calibrationWorkload();
+		qint64 measureStep(const std::function<void()> &step);
+		void checkStep(const QString &step_name, qint64 raw_nsecs);
+
+	public:
+		PerfRegressionTest() : PgModelerUnitTest(SCHEMASDIR)
+		{
+			bool ok=false;
+			QByteArray tol_env=qgetenv("PGMODELER_PERF_TOLERANCE");
+
+			tolerance=tol_env.toDouble(&ok);
+			if(!ok || tolerance <= 0) tolerance=0.20;
+
+			repetitions=qEnvironmentVariableIntValue("PGMODELER_PERF_REPETITIONS", &ok);
+			if(!ok || repetitions <= 0) repetitions=7;
+
+			write_baseline=(qEnvironmentVariableIntValue("PGMODELER_PERF_WRITE_BASELINE")==1);
+			model_file=QDir::tempPath() + GlobalAttributes::DirSeparator + QString("pgmodeler_perf_regression.dbm");
+			dbmodel=nullptr;
+			machine_factor=1.0;
+		}
+
+	private slots:
+		void initTestCase();
+		void modelLoadDidNotRegress();
+		void codeGenerationDidNotRegress();
+		void schemaEvaluationDidNotRegress();
+		void cleanupTestCase();
+};
+
+qint64 PerfRegressionTest::calibrationWorkload()
+{
+	/* Fixed CPU bound workload (string formatting + hashing) used to derive the machine
+	 * factor. It roughly exercises the same primitives the measured steps rely on */
+	QElapsedTimer timer;
+	volatile uint acc=0;
+
+	timer.start();
+
+	for(int i=0; i < 200000; i++)
+		acc+=qHash(QString("calibration_%1").arg(i));
+
+	return timer.nsecsElapsed();
+}
+
+qint64 PerfRegressionTest::measureStep(const std::function<void()> &step)
+{
+	QElapsedTimer timer;
+	qint64 best=-1, elapsed=0;
+
+	for(int rep=0; rep < repetitions; rep++)
+	{
+		timer.start();
+		step();
+		elapsed=timer.nsecsElapsed();
+
+		if(best < 0 || elapsed < best)
+			best=elapsed;
+	}
+
+	return best;
+}
+
+void PerfRegressionTest::checkStep(const QString &step_name, qint64 raw_nsecs)
+{
+	QTextStream out(stdout);
+	double normalized=raw_nsecs / machine_factor,
+			baseline_val=baseline["steps"].toObject()[step_name].toDouble();
+
+	out << QString("%1: raw=%2 ms normalized=%3 ms baseline=%4 ms")
+				 .arg(step_name)
+				 .arg(QString::number(raw_nsecs / 1000000.0, 'f', 2))
+				 .arg(QString::number(normalized / 1000000.0, 'f', 2))
+				 .arg(QString::number(baseline_val / 1000000.0, 'f', 2)) << QtCompat::endl;
+
+	measured_steps[step_name]=normalized;
+
+	if(write_baseline)
+		return;
+
+	if(baseline_val <= 0)
+		QSKIP("No baseline recorded for the step, skipping the comparison.");
+
+	if(normalized > baseline_val * (1.0 + tolerance))
+		QFAIL(QString("Step `%1' got %2% slower than the baseline (tolerance: %3%)!")
+					.arg(step_name)
+					.arg(QString::number(((normalized / baseline_val) - 1.0) * 100, 'f', 1))
+					.arg(QString::number(tolerance * 100, 'f', 0)).toStdString().c_str());
+}
+
+void PerfRegressionTest::initTestCase()
+{
+	try
+	{
+		QByteArray buf=UtilsNs::loadFile(PERF_BASELINE_FILE);
+		baseline=QJsonDocument::fromJson(buf).object();
+
+		double ref_calibration=baseline["calibration-ns"].toDouble();
+
+		/* The calibration itself takes the best of three rounds so a cold start doesn't
+		 * inflate the machine factor */
+		qint64 calibration=calibrationWorkload();
+
+		for(int i=0; i < 2; i++)
+			calibration=qMin(calibration, calibrationWorkload());
+
+		if(ref_calibration > 0)
+			machine_factor=calibration / ref_calibration;
+
+		if(machine_factor <= 0)
+			machine_factor=1.0;
+
+		dbmodel=new DatabaseModel;
+		BenchmarkModel::buildModel(dbmodel, "perf_regression_db", TableCount, ColumnCount, RelCount);
+		dbmodel->saveModel(model_file, SchemaParser::XmlDefinition);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PerfRegressionTest::modelLoadDidNotRegress()
+{
+	try
+	{
+		qint64 best=measureStep([this]()
+		{
+			DatabaseModel model;
+			model.createSystemObjects(false);
+			model.loadModel(model_file);
+			model.destroyObjects();
+		});
+
+		checkStep("model-load", best);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PerfRegressionTest::codeGenerationDidNotRegress()
+{
+	try
+	{
+		qint64 best=measureStep([this]()
+		{
+			dbmodel->setCodesInvalidated();
+			dbmodel->getCodeDefinition(SchemaParser::SqlDefinition);
+		});
+
+		checkStep("code-generation", best);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PerfRegressionTest::schemaEvaluationDidNotRegress()
+{
+	try
+	{
+		SchemaParser schparser;
+		attribs_map attribs;
+
+		schparser.ignoreEmptyAttributes(true);
+		schparser.ignoreUnkownAttributes(true);
+		schparser.loadBuffer(UtilsNs::loadFile(GlobalAttributes::getSchemaFilePath(GlobalAttributes::SQLSchemaDir, QString("table"))));
+
+		qint64 best=measureStep([&schparser, &attribs]()
+		{
+			for(int i=0; i < SchemaEvalRounds; i++)
+				schparser.getCodeDefinition(attribs);
+		});
+
+		checkStep("schema-evaluation", best);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PerfRegressionTest::cleanupTestCase()
+{
+	if(write_baseline)
+	{
+		QJsonObject new_baseline;
+
+		new_baseline["comment"]=baseline["comment"];
+		new_baseline["calibration-ns"]=baseline["calibration-ns"].toDouble() * machine_factor;
+		new_baseline["steps"]=measured_steps;
+
+		try
+		{
+			UtilsNs::saveFile(PERF_BASELINE_FILE, QJsonDocument(new_baseline).toJson());
+		}
+		catch(Exception &e)
+		{
+			QWARN(e.getErrorMessage().toStdString().c_str());
+		}
+	}
+
+	if(dbmodel)
+	{
+		dbmodel->destroyObjects();
+		delete dbmodel;
+	}
+
+	QFile::remove(model_file);
+}
+
+QTEST_MAIN(PerfRegressionTest)
+#include "perfregressiontest.moc"
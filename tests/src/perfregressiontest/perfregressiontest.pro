@@ -0,0 +1,6 @@
+include(../../tests.pri)
+SOURCES += perfregressiontest.cpp
+
+# Absolute path of the checked-in baseline so the test finds it no matter the build directory.
+# The baseline can be refreshed by running the test with PGMODELER_PERF_WRITE_BASELINE=1
+DEFINES += PERF_BASELINE_FILE=\\\"$$PWD/perfbaseline.json\\\"
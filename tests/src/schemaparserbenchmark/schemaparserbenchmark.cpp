@@ -0,0 +1,178 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2021 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "schemaparser.h"
+#include "utilsns.h"
+#include "pgmodelerunittest.h"
+
+/* Benchmarks the schema template engine, the hottest component shared by all the code
+ * generation paths. The measurements split the cost of the two stages of the engine
+ * (tokenization/compilation vs compiled buffer evaluation), capture the steady-state
+ * evaluation cost over every shipped .sch file and the overhead of building the
+ * attribute maps the callers seed on each getCodeDefinition() call. The QBENCHMARK
+ * reporting (median of several iterations) makes runs comparable between releases so
+ * template engine regressions can be detected before they ship. */
+class SchemaParserBenchmark: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		//! \brief Raw contents of the template used by the tokenization/evaluation split
+		QString sample_buffer;
+
+		//! \brief Parser holding the pre-compiled form of the sample template
+		SchemaParser eval_parser;
+
+		QStringList schemaFiles(const QString &folder, QString &path);
+
+	public:
+		SchemaParserBenchmark() : PgModelerUnitTest(SCHEMASDIR) {}
+
+	private slots:
+		void initTestCase();
+		void benchmarkTokenization();
+		void benchmarkEvaluation();
+		void benchmarkShippedSchemaFiles_data();
+		void benchmarkShippedSchemaFiles();
+		void benchmarkAttributeMapConstruction();
+};
+
+QStringList SchemaParserBenchmark::schemaFiles(const QString &folder, QString &path)
+{
+	QDir dir;
+
+	path = GlobalAttributes::getSchemasRootDir() + GlobalAttributes::DirSeparator + folder;
+	dir.setPath(path);
+
+	return dir.entryList({ "*.sch" }, QDir::Files | QDir::NoDotAndDotDot);
+}
+
+void SchemaParserBenchmark::initTestCase()
+{
+	/* The table template is used as the sample for the tokenization/evaluation split since
+	 * it is one of the biggest shipped templates and exercises conditionals, metacharacters
+	 * and attribute expansion */
+	QString filename = GlobalAttributes::getSchemaFilePath(GlobalAttributes::SQLSchemaDir, QString("table"));
+
+	try
+	{
+		sample_buffer = UtilsNs::loadFile(filename);
+		eval_parser.ignoreEmptyAttributes(true);
+		eval_parser.ignoreUnkownAttributes(true);
+		eval_parser.loadBuffer(sample_buffer);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void SchemaParserBenchmark::benchmarkTokenization()
+{
+	/* Measures only the buffer loading/compilation stage: loadBuffer() tokenizes the
+	 * contents right away and a fresh parser is used on each round so no compiled
+	 * form is reused */
+	QBENCHMARK
+	{
+		SchemaParser schparser;
+		schparser.loadBuffer(sample_buffer);
+	}
+}
+
+void SchemaParserBenchmark::benchmarkEvaluation()
+{
+	attribs_map attribs;
+
+	/* Measures only the evaluation stage: the parser holds the sample template already
+	 * compiled, so each round walks the compiled token stream without re-tokenizing */
+	QBENCHMARK
+	{
+		try
+		{
+			eval_parser.getCodeDefinition(attribs);
+		}
+		catch(Exception &e)
+		{
+			QFAIL(e.getExceptionsText().toStdString().c_str());
+		}
+	}
+}
+
+void SchemaParserBenchmark::benchmarkShippedSchemaFiles_data()
+{
+	QTest::addColumn<QString>("folder");
+
+	QTest::newRow("sql") << GlobalAttributes::SQLSchemaDir;
+	QTest::newRow("xml") << GlobalAttributes::XMLSchemaDir;
+	QTest::newRow("alter") << GlobalAttributes::AlterSchemaDir;
+	QTest::newRow("datadict") << GlobalAttributes::DataDictSchemaDir;
+	QTest::newRow("catalog") << GlobalAttributes::CatalogSchemasDir;
+}
+
+void SchemaParserBenchmark::benchmarkShippedSchemaFiles()
+{
+	QFETCH(QString, folder);
+
+	SchemaParser schparser;
+	attribs_map attribs;
+	QString path;
+	QStringList sch_files = schemaFiles(folder, path);
+
+	if(sch_files.isEmpty())
+		QSKIP("No schema files found for the folder.");
+
+	/* Each round evaluates every template of the folder once. The first round also pays
+	 * the compilation of the files, the subsequent ones reuse the process-wide compiled
+	 * cache reflecting the steady-state cost paid by model exports */
+	QBENCHMARK
+	{
+		for(auto &sch_file : sch_files)
+		{
+			try
+			{
+				schparser.ignoreEmptyAttributes(true);
+				schparser.ignoreUnkownAttributes(true);
+				schparser.getCodeDefinition(path + GlobalAttributes::DirSeparator + sch_file, attribs);
+			}
+			catch(Exception &){}
+		}
+	}
+}
+
+void SchemaParserBenchmark::benchmarkAttributeMapConstruction()
+{
+	QStringList attr_names;
+
+	/* The amount of attributes mirrors what the code generation of a typical table
+	 * seeds before calling the parser */
+	for(int i=0; i < 30; i++)
+		attr_names.append(QString("attribute-%1").arg(i));
+
+	/* Measures the overhead of building and discarding the attribute map passed to
+	 * every getCodeDefinition() call */
+	QBENCHMARK
+	{
+		attribs_map attribs;
+
+		for(auto &attr : attr_names)
+			attribs[attr] = attr;
+	}
+}
+
+QTEST_MAIN(SchemaParserBenchmark)
+#include "schemaparserbenchmark.moc"
@@ -16,4 +16,8 @@ src/fileselectortest \
 src/transformtest \
 src/xmlparsertest \
 src/proceduretest \
-src/basefunctiontest
+src/basefunctiontest \
+src/modelbenchmark \
+src/schemaparserbenchmark \
+src/perfregressiontest \
+src/canvasbenchmark